@@ -41,8 +41,8 @@ namespace bayeux {
     init_dtkernel_no_inhibit_qt_gui   = datatools::init_no_inhibit_qt_gui,
     bxinit_no_inhibit_urnquery        = datatools::init_no_inhibit_urnquery,
     init_dtkernel_no_inhibit_urnquery = datatools::init_no_inhibit_urnquery,
-    bxinit_reserved_11                = datatools::init_reserved_11,
-    init_dtkernel_reserved_11         = datatools::init_reserved_11,
+    bxinit_startup_profile            = datatools::init_startup_profile, //!< Activate the startup profiler
+    init_dtkernel_startup_profile     = datatools::init_startup_profile, //!< Activate the startup profiler
     bxinit_reserved_12                = datatools::init_reserved_12,
     init_dtkernel_reserved_12         = datatools::init_reserved_12,
     bxinit_reserved_13                = datatools::init_reserved_13,
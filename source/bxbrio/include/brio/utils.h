@@ -86,6 +86,13 @@ namespace brio {
 
   typedef std::map<std::string, store_info> store_info_dict_type;
 
+  /// Enable the concurrent use of distinct readers/writers from several threads
+  ///
+  /// This must be invoked before any reader or writer is used from a
+  /// secondary thread. Each reader or writer must still be used from
+  /// one thread at a time.
+  void enable_thread_safety();
+
 } // end of namespace brio
 
 #endif // BRIO_UTILS_H
@@ -17,6 +17,7 @@
 #pragma clang diagnostic ignored "-Wc++11-long-long"
 #endif
 #include <TTree.h>
+#include <TROOT.h>
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -166,4 +167,11 @@ namespace brio {
     return status;
   }
 
+  void enable_thread_safety()
+  {
+    // Protect the ROOT global state (file and class registries, streamers):
+    ROOT::EnableThreadSafety();
+    return;
+  }
+
 } // end of namespace brio
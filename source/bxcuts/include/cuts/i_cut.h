@@ -36,6 +36,7 @@
 #include <string>
 #include <typeinfo>
 #include <set>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -49,6 +50,7 @@
 
 // This project:
 #include <cuts/cut_tools.h>
+#include <cuts/selection_mask.h>
 
 namespace datatools {
   class properties;
@@ -115,6 +117,31 @@ namespace cuts {
       const std::type_info * _ti;      //! Reference of the referenced object's type
     };
 
+    //! \brief A non-owning view on a contiguous range of user data items of the same type
+    //!
+    //! The referenced data handle is shared by all the cuts of a tree and
+    //! is rebound in place to each item in turn by the default batch adapter.
+    struct user_data_batch {
+      const char * data = nullptr; //!< Address of the first item
+      std::size_t size = 0;        //!< Number of items
+      std::size_t stride = 0;      //!< Distance in bytes between two consecutive items
+      boost::shared_ptr<i_referenced_data> ref; //!< Shared handle to the current item
+      void (*bind)(i_referenced_data &, const void *) = nullptr; //!< Function binding the handle to an item
+
+      //! Return the address of an item
+      const void * item(std::size_t i_) const {
+        return data + i_ * stride;
+      }
+
+      //! Return a view on a sub-range of items
+      user_data_batch slice(std::size_t first_, std::size_t n_) const {
+        user_data_batch s(*this);
+        s.data = data + first_ * stride;
+        s.size = n_;
+        return s;
+      }
+    };
+
     //! Check if logging priority is at least at debug level
     bool is_debug() const;
 
@@ -286,6 +313,67 @@ namespace cuts {
     //! Function interface for the selection method @see process
     int operator()();
 
+    /** The batch cut processing method
+     *
+     * Bit i of the mask is set if item i of the batch is accepted.
+     * In batch mode, an entry for which the cut is inapplicable
+     * is reported as not selected.
+     */
+    void process_batch(const user_data_batch & batch_, selection_mask & mask_);
+
+    /** The batch cut processing method with applicability
+     *
+     * Bit i of the selection mask is set if item i of the batch is accepted.
+     * Bit i of the applicability mask is unset if the cut is inapplicable
+     * to item i, in which case the item is not selected.
+     */
+    void process_batch(const user_data_batch & batch_,
+                       selection_mask & mask_,
+                       selection_mask & applicable_);
+
+    //! Batch processing of an array of user data items
+    template<class T>
+    void process_batch(const T * items_, std::size_t n_, selection_mask & mask_)
+    {
+      selection_mask applicable;
+      process_batch(items_, n_, mask_, applicable);
+      return;
+    }
+
+    //! Batch processing of an array of user data items with applicability
+    template<class T>
+    void process_batch(const T * items_, std::size_t n_,
+                       selection_mask & mask_,
+                       selection_mask & applicable_)
+    {
+      user_data_batch batch;
+      batch.data = reinterpret_cast<const char *>(items_);
+      batch.size = n_;
+      batch.stride = sizeof(T);
+      batch.ref.reset(new referenced_data<T>);
+      batch.bind = &i_cut::_bind_batch_item_<T>;
+      process_batch(batch, mask_, applicable_);
+      return;
+    }
+
+    //! Batch processing of a vector of user data items
+    template<class T>
+    void process_batch(const std::vector<T> & items_, selection_mask & mask_)
+    {
+      process_batch(items_.data(), items_.size(), mask_);
+      return;
+    }
+
+    //! Batch processing of a vector of user data items with applicability
+    template<class T>
+    void process_batch(const std::vector<T> & items_,
+                       selection_mask & mask_,
+                       selection_mask & applicable_)
+    {
+      process_batch(items_.data(), items_.size(), mask_, applicable_);
+      return;
+    }
+
     //! The main termination method
     virtual void reset() = 0;
 
@@ -336,6 +424,32 @@ namespace cuts {
     //! The main selection method (pure virtual, invoked by the @see process method)
     virtual int _accept() = 0;
 
+    /** The batch selection method (invoked by the @see process_batch method)
+     *
+     * The default implementation applies the scalar selection method
+     * on each item of the batch. Composite cuts combine the masks
+     * of their daughter cuts.
+     *
+     * The applicability mask is initially set for all items. It must be
+     * unset for the items the cut is inapplicable to, as the scalar
+     * selection method would return SELECTION_INAPPLICABLE.
+     * The selection bits of these items are then unset by
+     * the @see process_batch method, even if a complemented
+     * combination of the daughter masks has set them.
+     */
+    virtual void _accept_batch(const user_data_batch & batch_,
+                               selection_mask & mask_,
+                               selection_mask & applicable_);
+
+    //! Batch processing of a cut restricted to the words of the batch with some bits set in a mask
+    //!
+    //! The bits of the output masks are unset for the skipped words.
+    static void _process_batch_where(i_cut & cut_,
+                                     const user_data_batch & batch_,
+                                     const selection_mask & todo_,
+                                     selection_mask & mask_,
+                                     selection_mask & applicable_);
+
     //! Set user data by shared pointer
     void _set_user_data(const boost::shared_ptr<i_referenced_data> & hd_);
 
@@ -386,6 +500,14 @@ namespace cuts {
 
   private:
 
+    //! Bind a batch handle to an item of a given type
+    template<class T>
+    static void _bind_batch_item_(i_referenced_data & rd_, const void * item_)
+    {
+      static_cast<referenced_data<T> &>(rd_).set(*static_cast<const T *>(item_));
+      return;
+    }
+
     // Status:
     bool _initialized_; //!< The initialization flag
 
@@ -41,6 +41,11 @@ namespace cuts {
     /// Selection
     int _accept() override;
 
+    /// Batch selection
+    void _accept_batch(const user_data_batch & batch_,
+                       selection_mask & mask_,
+                       selection_mask & applicable_) override;
+
   private:
 
     // Macro to automate the registration of the cut :
@@ -0,0 +1,137 @@
+//! \file cuts/selection_mask.h
+/* Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Selection bit mask for batch processing of cuts.
+ *
+ * History:
+ *
+ */
+
+#ifndef CUTS_SELECTION_MASK_H
+#define CUTS_SELECTION_MASK_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cuts {
+
+  //! \brief A bit mask with one bit per item processed in batch mode
+  //!
+  //! Bit i is set if item i is selected. Bits are packed in 64-bit words so that
+  //! composite cuts combine the selections of their daughter cuts word by word.
+  class selection_mask
+  {
+  public:
+
+    //! Type of a word of bits
+    typedef uint64_t word_type;
+
+    //! Number of bits per word
+    static const std::size_t WORD_BITS = 64;
+
+    //! Default constructor
+    selection_mask();
+
+    //! Constructor with a given number of bits
+    explicit selection_mask(std::size_t size_, bool value_ = false);
+
+    //! Set the number of bits and assign them a value
+    void assign(std::size_t size_, bool value_ = false);
+
+    //! Return the number of bits
+    std::size_t size() const;
+
+    //! Return the number of words
+    std::size_t get_number_of_words() const;
+
+    //! Return the word at a given index
+    word_type get_word(std::size_t iword_) const;
+
+    //! Return the mutable word at a given index
+    word_type & grab_word(std::size_t iword_);
+
+    //! Return the mask of the valid bits of the word at a given index
+    word_type get_valid_bits(std::size_t iword_) const;
+
+    //! Check if a bit is set
+    bool test(std::size_t i_) const;
+
+    //! Set/unset a bit
+    void set(std::size_t i_, bool value_ = true);
+
+    //! Set all bits
+    void set_all();
+
+    //! Unset all bits
+    void clear_all();
+
+    //! Flip all bits
+    void flip();
+
+    //! Return the number of set bits
+    std::size_t count() const;
+
+    //! Check if no bit is set
+    bool none() const;
+
+    //! Check if all bits are set
+    bool all() const;
+
+    //! Word-wise AND with another mask of the same size
+    selection_mask & operator&=(const selection_mask & other_);
+
+    //! Word-wise OR with another mask of the same size
+    selection_mask & operator|=(const selection_mask & other_);
+
+    //! Word-wise XOR with another mask of the same size
+    selection_mask & operator^=(const selection_mask & other_);
+
+    //! Word-wise AND NOT with another mask of the same size
+    selection_mask & and_not(const selection_mask & other_);
+
+    //! Check equality
+    bool operator==(const selection_mask & other_) const;
+
+  private:
+
+    //! Unset the unused bits of the last word
+    void _trim_();
+
+  private:
+
+    std::size_t _size_ = 0;         //!< Number of bits
+    std::vector<word_type> _words_; //!< Packed bits
+
+  };
+
+} // end of namespace cuts
+
+#endif // CUTS_SELECTION_MASK_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
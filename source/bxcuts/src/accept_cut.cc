@@ -50,4 +50,12 @@ namespace cuts {
     return;
   }
 
+  void accept_cut::_accept_batch(const user_data_batch & /* batch_ */,
+                                 selection_mask & mask_,
+                                 selection_mask & /* applicable_ */)
+  {
+    mask_.set_all();
+    return;
+  }
+
 } // end of namespace cuts
@@ -23,6 +23,7 @@
 #include <cuts/i_cut.h>
 
 // Standard library:
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 
@@ -467,6 +468,114 @@ namespace cuts {
     return this->process();
   }
 
+  void i_cut::process_batch(const user_data_batch & batch_, selection_mask & mask_)
+  {
+    selection_mask applicable;
+    process_batch(batch_, mask_, applicable);
+    return;
+  }
+
+  void i_cut::process_batch(const user_data_batch & batch_,
+                            selection_mask & mask_,
+                            selection_mask & applicable_)
+  {
+    DT_LOG_TRACE(_logging,
+                 "Entering: batch processing of the cut named '" << (has_name()? get_name() : "?") << "'");
+    DT_THROW_IF(!batch_.ref || batch_.bind == nullptr,
+                std::logic_error,
+                "Cut named '" << (has_name()? get_name() : "?") << "' processes an invalid batch of user data!");
+    mask_.assign(batch_.size, false);
+    applicable_.assign(batch_.size, true);
+    if (batch_.size == 0) {
+      return;
+    }
+    // The handle is shared with the daughter cuts only once per batch:
+    boost::shared_ptr<i_referenced_data> previous_user_data = _user_data_;
+    const bool rebind = (previous_user_data != batch_.ref);
+    if (rebind) {
+      batch_.bind(*batch_.ref, batch_.item(0));
+      _set_user_data(batch_.ref);
+    }
+    try {
+      _accept_batch(batch_, mask_, applicable_);
+    } catch (...) {
+      if (rebind) {
+        reset_user_data();
+      }
+      throw;
+    }
+    if (rebind) {
+      if (previous_user_data) {
+        _set_user_data(previous_user_data);
+      } else {
+        reset_user_data();
+      }
+    }
+    // Inapplicable entries are never selected, whatever the complemented
+    // combinations of masks made by composite cuts:
+    mask_ &= applicable_;
+    if (_activated_counters_) {
+      const std::size_t naccepted = mask_.count();
+      _number_of_accepted_entries_ += naccepted;
+      _number_of_rejected_entries_ += batch_.size - naccepted;
+    }
+    DT_LOG_TRACE(_logging, "Exiting.");
+    return;
+  }
+
+  void i_cut::_accept_batch(const user_data_batch & batch_,
+                            selection_mask & mask_,
+                            selection_mask & applicable_)
+  {
+    for (std::size_t i = 0; i < batch_.size; i++) {
+      batch_.bind(*batch_.ref, batch_.item(i));
+      _prepare_cut();
+      int status = _accept();
+      status = _finish_cut(status);
+      if (status == SELECTION_ACCEPTED) {
+        mask_.set(i);
+      } else if (status == SELECTION_INAPPLICABLE) {
+        applicable_.set(i, false);
+      }
+    }
+    return;
+  }
+
+  // static
+  void i_cut::_process_batch_where(i_cut & cut_,
+                                   const user_data_batch & batch_,
+                                   const selection_mask & todo_,
+                                   selection_mask & mask_,
+                                   selection_mask & applicable_)
+  {
+    mask_.assign(batch_.size, false);
+    applicable_.assign(batch_.size, false);
+    const std::size_t nwords = todo_.get_number_of_words();
+    selection_mask run_mask;
+    selection_mask run_applicable;
+    std::size_t iword = 0;
+    while (iword < nwords) {
+      if (todo_.get_word(iword) == 0) {
+        iword++;
+        continue;
+      }
+      // Process the run of consecutive words to be processed at once:
+      std::size_t jword = iword + 1;
+      while (jword < nwords && todo_.get_word(jword) != 0) {
+        jword++;
+      }
+      const std::size_t first = iword * selection_mask::WORD_BITS;
+      const std::size_t last = std::min(jword * selection_mask::WORD_BITS, batch_.size);
+      cut_.process_batch(batch_.slice(first, last - first), run_mask, run_applicable);
+      for (std::size_t k = 0; k < run_mask.get_number_of_words(); k++) {
+        mask_.grab_word(iword + k) = run_mask.get_word(k);
+        applicable_.grab_word(iword + k) = run_applicable.get_word(k);
+      }
+      iword = jword;
+    }
+    return;
+  }
+
   void i_cut::_reset()
   {
     reset_user_data();
@@ -56,4 +56,29 @@ namespace cuts {
     return status;
   }
 
+  void multi_and_cut::_accept_batch(const user_data_batch & batch_,
+                                    selection_mask & mask_,
+                                    selection_mask & applicable_)
+  {
+    DT_THROW_IF(_cuts.size() == 0,
+                std::logic_error,
+                "Missing cuts !");
+    cuts_col_type::iterator i = _cuts.begin();
+    i->grab().process_batch(batch_, mask_, applicable_);
+    // Next cuts are only applied on words with some entries accepted by all
+    // previous cuts, as the scalar selection stops at the first cut which
+    // does not accept an entry:
+    selection_mask mask_i;
+    selection_mask applicable_i;
+    selection_mask inapplicable;
+    for (++i; i != _cuts.end() && !mask_.none(); ++i) {
+      _process_batch_where(i->grab(), batch_, mask_, mask_i, applicable_i);
+      inapplicable = mask_;
+      inapplicable.and_not(applicable_i);
+      applicable_.and_not(inapplicable);
+      mask_ &= mask_i;
+    }
+    return;
+  }
+
 } // end of namespace cuts
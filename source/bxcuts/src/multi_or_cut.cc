@@ -60,4 +60,32 @@ namespace cuts {
     return status;
   }
 
+  void multi_or_cut::_accept_batch(const user_data_batch & batch_,
+                                   selection_mask & mask_,
+                                   selection_mask & applicable_)
+  {
+    DT_THROW_IF(_cuts.size() == 0,
+                std::logic_error,
+                "Missing cuts !");
+    cuts_col_type::iterator i = _cuts.begin();
+    i->grab().process_batch(batch_, mask_, applicable_);
+    // Next cuts are only applied on words with some entries rejected by all
+    // previous cuts, as the scalar selection stops at the first cut which
+    // accepts an entry or is inapplicable:
+    selection_mask todo;
+    selection_mask mask_i;
+    selection_mask applicable_i;
+    for (++i; i != _cuts.end(); ++i) {
+      todo = applicable_;
+      todo.and_not(mask_);
+      if (todo.none()) break;
+      _process_batch_where(i->grab(), batch_, todo, mask_i, applicable_i);
+      mask_i &= todo;
+      mask_ |= mask_i;
+      todo.and_not(applicable_i);
+      applicable_.and_not(todo);
+    }
+    return;
+  }
+
 } // end of namespace cuts
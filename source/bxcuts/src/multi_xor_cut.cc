@@ -70,4 +70,28 @@ namespace cuts {
     return status;
   }
 
+  void multi_xor_cut::_accept_batch(const user_data_batch & batch_,
+                                    selection_mask & mask_,
+                                    selection_mask & applicable_)
+  {
+    DT_THROW_IF(_cuts.size() == 0,
+                std::logic_error,
+                "Missing cuts !");
+    // Entries accepted by exactly one cut (mask) or by several cuts:
+    selection_mask many(batch_.size, false);
+    selection_mask mask_i;
+    selection_mask applicable_i;
+    selection_mask both;
+    for (cuts_col_type::iterator i = _cuts.begin(); i != _cuts.end(); ++i) {
+      i->grab().process_batch(batch_, mask_i, applicable_i);
+      applicable_ &= applicable_i;
+      both = mask_;
+      both &= mask_i;
+      many |= both;
+      mask_ |= mask_i;
+      mask_.and_not(many);
+    }
+    return;
+  }
+
 } // end of namespace cuts
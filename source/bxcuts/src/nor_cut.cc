@@ -44,4 +44,21 @@ namespace cuts {
     return (SELECTION_REJECTED);
   }
 
+  void nor_cut::_accept_batch(const user_data_batch & batch_,
+                              selection_mask & mask_,
+                              selection_mask & applicable_)
+  {
+    _handle_1.grab().process_batch(batch_, mask_, applicable_);
+    // The second cut is applied on all entries, because its inapplicability
+    // makes the NOR cut inapplicable as in scalar mode:
+    selection_mask mask_2;
+    selection_mask applicable_2;
+    _handle_2.grab().process_batch(batch_, mask_2, applicable_2);
+    applicable_ &= applicable_2;
+    mask_ |= mask_2;
+    // Inapplicable entries are unselected again by process_batch:
+    mask_.flip();
+    return;
+  }
+
 } // end of namespace cuts
@@ -109,4 +109,17 @@ namespace cuts {
     return;
   }
 
+  void not_cut::_accept_batch(const user_data_batch & batch_,
+                              selection_mask & mask_,
+                              selection_mask & applicable_)
+  {
+    DT_THROW_IF(! _handle,
+                std::logic_error,
+                "NOT cut '" << get_name() << "' has an invalid cut handle ! ");
+    _handle.grab().process_batch(batch_, mask_, applicable_);
+    // Inapplicable entries are unselected again by process_batch:
+    mask_.flip();
+    return;
+  }
+
 } // end of namespace cuts
@@ -54,4 +54,12 @@ namespace cuts {
     return;
   }
 
+  void reject_cut::_accept_batch(const user_data_batch & /* batch_ */,
+                                 selection_mask & mask_,
+                                 selection_mask & /* applicable_ */)
+  {
+    mask_.clear_all();
+    return;
+  }
+
 } // end of namespace cuts
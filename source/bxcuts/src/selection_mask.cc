@@ -0,0 +1,186 @@
+// selection_mask.cc
+
+// Ourselves:
+#include <cuts/selection_mask.h>
+
+// Standard library:
+#include <bitset>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace cuts {
+
+  // static
+  const std::size_t selection_mask::WORD_BITS;
+
+  selection_mask::selection_mask()
+  {
+    return;
+  }
+
+  selection_mask::selection_mask(std::size_t size_, bool value_)
+  {
+    assign(size_, value_);
+    return;
+  }
+
+  void selection_mask::assign(std::size_t size_, bool value_)
+  {
+    _size_ = size_;
+    _words_.assign((size_ + WORD_BITS - 1) / WORD_BITS, value_ ? ~word_type(0) : word_type(0));
+    _trim_();
+    return;
+  }
+
+  std::size_t selection_mask::size() const
+  {
+    return _size_;
+  }
+
+  std::size_t selection_mask::get_number_of_words() const
+  {
+    return _words_.size();
+  }
+
+  selection_mask::word_type selection_mask::get_word(std::size_t iword_) const
+  {
+    return _words_[iword_];
+  }
+
+  selection_mask::word_type & selection_mask::grab_word(std::size_t iword_)
+  {
+    return _words_[iword_];
+  }
+
+  selection_mask::word_type selection_mask::get_valid_bits(std::size_t iword_) const
+  {
+    const std::size_t nbits = _size_ - iword_ * WORD_BITS;
+    if (nbits >= WORD_BITS) return ~word_type(0);
+    return (word_type(1) << nbits) - 1;
+  }
+
+  bool selection_mask::test(std::size_t i_) const
+  {
+    DT_THROW_IF(i_ >= _size_, std::range_error, "Invalid bit index [" << i_ << "]!");
+    return (_words_[i_ / WORD_BITS] >> (i_ % WORD_BITS)) & 1;
+  }
+
+  void selection_mask::set(std::size_t i_, bool value_)
+  {
+    DT_THROW_IF(i_ >= _size_, std::range_error, "Invalid bit index [" << i_ << "]!");
+    const word_type bit = word_type(1) << (i_ % WORD_BITS);
+    if (value_) {
+      _words_[i_ / WORD_BITS] |= bit;
+    } else {
+      _words_[i_ / WORD_BITS] &= ~bit;
+    }
+    return;
+  }
+
+  void selection_mask::set_all()
+  {
+    assign(_size_, true);
+    return;
+  }
+
+  void selection_mask::clear_all()
+  {
+    assign(_size_, false);
+    return;
+  }
+
+  void selection_mask::flip()
+  {
+    for (word_type & w : _words_) {
+      w = ~w;
+    }
+    _trim_();
+    return;
+  }
+
+  std::size_t selection_mask::count() const
+  {
+    std::size_t n = 0;
+    for (word_type w : _words_) {
+      n += std::bitset<WORD_BITS>(w).count();
+    }
+    return n;
+  }
+
+  bool selection_mask::none() const
+  {
+    for (word_type w : _words_) {
+      if (w != 0) return false;
+    }
+    return true;
+  }
+
+  bool selection_mask::all() const
+  {
+    for (std::size_t iword = 0; iword < _words_.size(); iword++) {
+      if (_words_[iword] != get_valid_bits(iword)) return false;
+    }
+    return true;
+  }
+
+  selection_mask & selection_mask::operator&=(const selection_mask & other_)
+  {
+    DT_THROW_IF(other_._size_ != _size_, std::logic_error, "Unmatching mask sizes!");
+    for (std::size_t iword = 0; iword < _words_.size(); iword++) {
+      _words_[iword] &= other_._words_[iword];
+    }
+    return *this;
+  }
+
+  selection_mask & selection_mask::operator|=(const selection_mask & other_)
+  {
+    DT_THROW_IF(other_._size_ != _size_, std::logic_error, "Unmatching mask sizes!");
+    for (std::size_t iword = 0; iword < _words_.size(); iword++) {
+      _words_[iword] |= other_._words_[iword];
+    }
+    return *this;
+  }
+
+  selection_mask & selection_mask::operator^=(const selection_mask & other_)
+  {
+    DT_THROW_IF(other_._size_ != _size_, std::logic_error, "Unmatching mask sizes!");
+    for (std::size_t iword = 0; iword < _words_.size(); iword++) {
+      _words_[iword] ^= other_._words_[iword];
+    }
+    return *this;
+  }
+
+  selection_mask & selection_mask::and_not(const selection_mask & other_)
+  {
+    DT_THROW_IF(other_._size_ != _size_, std::logic_error, "Unmatching mask sizes!");
+    for (std::size_t iword = 0; iword < _words_.size(); iword++) {
+      _words_[iword] &= ~other_._words_[iword];
+    }
+    return *this;
+  }
+
+  bool selection_mask::operator==(const selection_mask & other_) const
+  {
+    return _size_ == other_._size_ && _words_ == other_._words_;
+  }
+
+  void selection_mask::_trim_()
+  {
+    if (!_words_.empty()) {
+      _words_.back() &= get_valid_bits(_words_.size() - 1);
+    }
+    return;
+  }
+
+} // end of namespace cuts
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -44,4 +44,17 @@ namespace cuts {
     return (SELECTION_REJECTED);
   }
 
+  void xor_cut::_accept_batch(const user_data_batch & batch_,
+                              selection_mask & mask_,
+                              selection_mask & applicable_)
+  {
+    _handle_1.grab().process_batch(batch_, mask_, applicable_);
+    selection_mask mask_2;
+    selection_mask applicable_2;
+    _handle_2.grab().process_batch(batch_, mask_2, applicable_2);
+    applicable_ &= applicable_2;
+    mask_ ^= mask_2;
+    return;
+  }
+
 } // end of namespace cuts
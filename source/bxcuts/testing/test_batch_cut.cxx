@@ -0,0 +1,316 @@
+// test_batch_cut.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/time_tools.h>
+
+// This project:
+#include <cuts/selection_mask.h>
+#include <cuts/and_cut.h>
+#include <cuts/or_cut.h>
+#include <cuts/xor_cut.h>
+#include <cuts/not_cut.h>
+#include <cuts/nand_cut.h>
+#include <cuts/nor_cut.h>
+#include <cuts/xnor_cut.h>
+#include <cuts/exclude_cut.h>
+#include <cuts/multi_and_cut.h>
+#include <cuts/multi_or_cut.h>
+#include <cuts/multi_xor_cut.h>
+#include <cuts/accept_cut.h>
+#include <cuts_test_data.h>
+
+// Additional registered test cuts :
+#include <cuts_test_range_cut.cc>
+
+namespace {
+
+  // A cut on the X coordinate which is inapplicable to black points:
+  class colored_x_cut : public cuts::i_cut
+  {
+  public:
+
+    colored_x_cut()
+    {
+      this->register_supported_user_data_type<cuts::test::data>();
+      return;
+    }
+
+    ~colored_x_cut() override
+    {
+      return;
+    }
+
+    void initialize(const datatools::properties & config_,
+                    datatools::service_manager & /* service_manager_ */,
+                    cuts::cut_handle_dict_type & /* cut_dict_ */) override
+    {
+      _common_initialize(config_);
+      _set_initialized(true);
+      return;
+    }
+
+    void reset() override
+    {
+      _set_initialized(false);
+      this->i_cut::_reset();
+      return;
+    }
+
+    std::string get_type_id() const override
+    {
+      return "colored_x_cut";
+    }
+
+  protected:
+
+    int _accept() override
+    {
+      const cuts::test::data & d = get_user_data<cuts::test::data>();
+      if (d.color == cuts::test::data::BLACK) return cuts::SELECTION_INAPPLICABLE;
+      if (d.x > 0.0) return cuts::SELECTION_ACCEPTED;
+      return cuts::SELECTION_REJECTED;
+    }
+
+  };
+
+  cuts::cut_handle_type make_range_cut(int mode_, double min_, double max_)
+  {
+    cuts::test::range_cut * rc = new cuts::test::range_cut;
+    rc->set_mode(mode_);
+    rc->set_range(min_, max_);
+    return cuts::cut_handle_type(rc);
+  }
+
+  // Compare the batch selection of a cut with its scalar selection:
+  void check_cut(const std::string & label_,
+                 cuts::i_cut & cut_,
+                 const std::vector<cuts::test::data> & points_)
+  {
+    datatools::computing_time scalar_ct;
+    std::vector<bool> scalar_selection(points_.size(), false);
+    std::vector<bool> scalar_applicable(points_.size(), false);
+    scalar_ct.start();
+    for (std::size_t i = 0; i < points_.size(); i++) {
+      cut_.set_user_data(points_[i]);
+      const int status = cut_.process();
+      scalar_selection[i] = (status == cuts::SELECTION_ACCEPTED);
+      scalar_applicable[i] = (status != cuts::SELECTION_INAPPLICABLE);
+    }
+    scalar_ct.stop();
+    cut_.reset_user_data();
+    cut_.reset_counters();
+
+    datatools::computing_time batch_ct;
+    cuts::selection_mask mask;
+    batch_ct.start();
+    cut_.process_batch(points_, mask);
+    batch_ct.stop();
+    cut_.reset_counters();
+    cuts::selection_mask mask2;
+    cuts::selection_mask applicable;
+    cut_.process_batch(points_, mask2, applicable);
+
+    DT_THROW_IF(mask.size() != points_.size(), std::logic_error, "Invalid mask size for '" << label_ << "'!");
+    DT_THROW_IF(!(mask2 == mask), std::logic_error, "Unstable batch selection for '" << label_ << "'!");
+    std::size_t naccepted = 0;
+    std::size_t ninapplicable = 0;
+    for (std::size_t i = 0; i < points_.size(); i++) {
+      DT_THROW_IF(mask.test(i) != scalar_selection[i], std::logic_error,
+                  "Batch and scalar selections differ for '" << label_ << "' at item #" << i << "!");
+      DT_THROW_IF(applicable.test(i) != scalar_applicable[i], std::logic_error,
+                  "Batch and scalar applicabilities differ for '" << label_ << "' at item #" << i << "!");
+      if (scalar_selection[i]) naccepted++;
+      if (!scalar_applicable[i]) ninapplicable++;
+    }
+    DT_THROW_IF(cut_.get_number_of_accepted_entries() != naccepted, std::logic_error,
+                "Invalid number of accepted entries for '" << label_ << "'!");
+    DT_THROW_IF(cut_.get_number_of_processed_entries() != points_.size(), std::logic_error,
+                "Invalid number of processed entries for '" << label_ << "'!");
+    std::clog << "Cut '" << label_ << "' : " << naccepted << "/" << points_.size() << " accepted, "
+              << ninapplicable << " inapplicable; "
+              << "scalar: " << scalar_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms, "
+              << "batch: " << batch_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+    return;
+  }
+
+}
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the batch processing of cuts!" << std::endl;
+
+    srand48(314159);
+    // An odd number of points to exercise the last partial word of the masks:
+    std::vector<cuts::test::data> points(100003);
+    for (cuts::test::data & d : points) {
+      d.x = -1.0 + 2.0 * drand48();
+      d.y = -1.0 + 2.0 * drand48();
+      d.z = -1.0 + 2.0 * drand48();
+      d.color = (int) (3.5 * drand48());
+    }
+    // A narrow range which rejects most entries, so that whole words are skipped:
+    cuts::cut_handle_type narrow_x = make_range_cut(cuts::test::range_cut::MODE_X, 0.10, 0.11);
+    cuts::cut_handle_type half_y = make_range_cut(cuts::test::range_cut::MODE_Y, 0.0, 1.0);
+    cuts::cut_handle_type half_z = make_range_cut(cuts::test::range_cut::MODE_Z, -1.0, 0.0);
+    cuts::cut_handle_type all(new cuts::accept_cut);
+
+    check_cut("x", narrow_x.grab(), points);
+
+    {
+      cuts::and_cut cut;
+      cut.set_cuts(narrow_x, half_y);
+      check_cut("x && y", cut, points);
+    }
+
+    {
+      cuts::or_cut cut;
+      cut.set_cuts(half_y, half_z);
+      check_cut("y || z", cut, points);
+    }
+
+    {
+      cuts::xor_cut cut;
+      cut.set_cuts(half_y, half_z);
+      check_cut("y ^ z", cut, points);
+    }
+
+    {
+      cuts::exclude_cut cut;
+      cut.set_cuts(half_y, narrow_x);
+      check_cut("y && !x", cut, points);
+    }
+
+    {
+      cuts::cut_handle_type or_yz(new cuts::or_cut);
+      dynamic_cast<cuts::or_cut &>(or_yz.grab()).set_cuts(half_y, half_z);
+      cuts::not_cut cut;
+      cut.set_cut(or_yz);
+      check_cut("!(y || z)", cut, points);
+    }
+
+    {
+      cuts::multi_and_cut cut;
+      cut.add_cut(all);
+      cut.add_cut(half_y);
+      cut.add_cut(narrow_x);
+      cut.add_cut(half_z);
+      check_cut("all && y && x && z", cut, points);
+    }
+
+    {
+      cuts::multi_or_cut cut;
+      cut.add_cut(narrow_x);
+      cut.add_cut(half_y);
+      cut.add_cut(half_z);
+      check_cut("x || y || z", cut, points);
+    }
+
+    {
+      cuts::multi_xor_cut cut;
+      cut.add_cut(narrow_x);
+      cut.add_cut(half_y);
+      cut.add_cut(half_z);
+      check_cut("one of x, y, z", cut, points);
+    }
+
+    // A cut inapplicable to black points, which must not be selected
+    // by the complemented combinations:
+    cuts::cut_handle_type colored_x(new colored_x_cut);
+    check_cut("colored x", colored_x.grab(), points);
+
+    {
+      cuts::not_cut cut;
+      cut.set_cut(colored_x);
+      check_cut("!colored x", cut, points);
+    }
+
+    {
+      cuts::and_cut cut;
+      cut.set_cuts(narrow_x, colored_x);
+      check_cut("x && colored x", cut, points);
+    }
+
+    {
+      cuts::or_cut cut;
+      cut.set_cuts(half_y, colored_x);
+      check_cut("y || colored x", cut, points);
+    }
+
+    {
+      cuts::nand_cut cut;
+      cut.set_cuts(narrow_x, colored_x);
+      check_cut("!(x && colored x)", cut, points);
+    }
+
+    {
+      cuts::nor_cut cut;
+      cut.set_cuts(half_y, colored_x);
+      check_cut("!(y || colored x)", cut, points);
+    }
+
+    {
+      cuts::xnor_cut cut;
+      cut.set_cuts(half_z, colored_x);
+      check_cut("!(z ^ colored x)", cut, points);
+    }
+
+    {
+      cuts::exclude_cut cut;
+      cut.set_cuts(half_y, colored_x);
+      check_cut("y && !colored x", cut, points);
+    }
+
+    {
+      cuts::cut_handle_type and_x(new cuts::and_cut);
+      dynamic_cast<cuts::and_cut &>(and_x.grab()).set_cuts(narrow_x, colored_x);
+      cuts::not_cut cut;
+      cut.set_cut(and_x);
+      check_cut("not (x && colored x)", cut, points);
+    }
+
+    {
+      cuts::multi_and_cut cut;
+      cut.add_cut(half_y);
+      cut.add_cut(colored_x);
+      cut.add_cut(half_z);
+      check_cut("y && colored x && z", cut, points);
+    }
+
+    {
+      cuts::multi_or_cut cut;
+      cut.add_cut(half_y);
+      cut.add_cut(colored_x);
+      cut.add_cut(narrow_x);
+      check_cut("y || colored x || x", cut, points);
+    }
+
+    {
+      cuts::multi_xor_cut cut;
+      cut.add_cut(half_y);
+      cut.add_cut(colored_x);
+      cut.add_cut(half_z);
+      check_cut("one of y, colored x, z", cut, points);
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
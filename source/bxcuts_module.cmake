@@ -47,6 +47,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/or_cut.h
   ${module_include_dir}/${module_name}/random_cut.h
   ${module_include_dir}/${module_name}/reject_cut.h
+  ${module_include_dir}/${module_name}/selection_mask.h
   ${module_include_dir}/${module_name}/xnor_cut.h
   ${module_include_dir}/${module_name}/xor_cut.h
   ${module_include_dir}/${module_name}/exclude_cut.h
@@ -73,6 +74,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/or_cut.cc
   ${module_source_dir}/random_cut.cc
   ${module_source_dir}/reject_cut.cc
+  ${module_source_dir}/selection_mask.cc
   ${module_source_dir}/xnor_cut.cc
   ${module_source_dir}/xor_cut.cc
   ${module_source_dir}/exclude_cut.cc
@@ -92,6 +94,7 @@ set(${module_name}_TEST_ENVIRONMENT "CUTS_TESTING_DIR=${module_test_dir}")
 set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_accept_cut.cxx
   ${module_test_dir}/test_and_cut.cxx
+  ${module_test_dir}/test_batch_cut.cxx
   ${module_test_dir}/test_cuts.cxx
   ${module_test_dir}/test_manager.cxx
   ${module_test_dir}/test_random_cut.cxx
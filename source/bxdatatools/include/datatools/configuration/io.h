@@ -126,6 +126,14 @@ namespace datatools {
     public:
       typedef std::map<std::string, std::size_t> statistics_type;
 
+      /// \brief Preprocessing statistics associated to a source file
+      struct file_statistics_type
+      {
+        std::size_t number_of_parameters = 0; //!< Number of preprocessed variant parameters
+        double      processing_time = 0.0;    //!< Cumulated preprocessing time (in seconds)
+      };
+      typedef std::map<std::string, file_statistics_type> file_statistics_dict_type;
+
       /// Default constructor
       variant_reporting();
 
@@ -153,6 +161,11 @@ namespace datatools {
       /// Increment the counter associated to a processed variant parameter
       void add(const std::string & path_, std::size_t increment_ = 1);
 
+      /// Cumulate the preprocessing statistics associated to a source file
+      void add_file_statistics(const std::string & source_,
+                               std::size_t number_of_parameters_,
+                               double processing_time_);
+
       /// Print
       void dump(std::ostream & out_ = std::cerr) const;
 
@@ -172,6 +185,7 @@ namespace datatools {
       logger::priority _logging_; //!< Logging priority
       const variant_repository * _repository_ = nullptr; //!< Variant configuration repository handle
       statistics_type _parameter_stats_; ///< Processing counters associated to variant parameters
+      file_statistics_dict_type _file_stats_; ///< Preprocessing statistics associated to source files
 
     };
 
@@ -242,6 +256,16 @@ namespace datatools {
       command::returned_info preprocess_parameter(const std::string & parameter_token_,
                                                   std::string & parameter_effective_token_) const;
 
+      /// Return the number of variant parameters preprocessed since the last report
+      std::size_t get_number_of_parameters() const;
+
+      /// Return the cumulated preprocessing time (in seconds) of variant parameters since the last report
+      double get_processing_time() const;
+
+      /// Report the preprocessing statistics of a source file to the repository reporting (if any)
+      /// and reset the statistics
+      void report_statistics(const std::string & source_) const;
+
       /*! Parse a string and check if a given configuration variant is activate
 
         @param variant_desc_    The string to be parsed
@@ -305,6 +329,8 @@ namespace datatools {
       logger::priority _logging_; //!< Logging priority
       bool _remove_quotes_ = false; //!< Flag to remove quotes around string parameters
       const variant_repository * _repository_ = nullptr; //!< Variant configuration repository handle
+      mutable std::size_t _number_of_parameters_ = 0; //!< Number of preprocessed variant parameters
+      mutable double _processing_time_ = 0.0; //!< Cumulated preprocessing time of variant parameters (in seconds)
 
     };
 
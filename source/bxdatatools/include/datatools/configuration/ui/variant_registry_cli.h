@@ -41,6 +41,7 @@ namespace datatools {
   namespace configuration {
 
     class variant_registry;
+    class variant_record;
 
     namespace ui {
 
@@ -73,6 +74,14 @@ namespace datatools {
         cmd_get_parameter_value(const std::string & param_path_,
                                 std::string & value_token_) const;
 
+        /// Get the value string of an active parameter record from a registry
+        static command::returned_info
+        get_parameter_record_value(const variant_registry & registry_,
+                                   const std::string & param_path_,
+                                   const variant_record & param_rec_,
+                                   std::string & value_token_,
+                                   const datatools::logger::priority logging_ = datatools::logger::PRIO_FATAL);
+
         /// Check if a variant is active
         command::returned_info
         cmd_is_active_variant(const std::string & variant_path_,
@@ -0,0 +1,132 @@
+/// \file datatools/configuration/variant_parameter_cache.h
+/* Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Cache of compiled variant parameter references.
+ *
+ */
+
+#ifndef DATATOOLS_CONFIGURATION_VARIANT_PARAMETER_CACHE_H
+#define DATATOOLS_CONFIGURATION_VARIANT_PARAMETER_CACHE_H
+
+// Standard library:
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Third party:
+// - Boost:
+#include <boost/noncopyable.hpp>
+
+// This project (Bayeux/datatools):
+#include <datatools/command_utils.h>
+
+namespace datatools {
+
+  namespace configuration {
+
+    class variant_record;
+    class variant_registry;
+    class variant_repository;
+
+    /// \brief Cache of the variant parameters referenced from a repository
+    ///
+    /// A variant parameter reference ("registry:path/to/parameter") is
+    /// compiled at first use into direct handles to its registry and
+    /// parameter record, which remain valid until the layout of the
+    /// variant records changes (see variant_record::get_layout_revision).
+    /// The value token of the parameter is memoized and recomputed only
+    /// after a change of the state of the variant records
+    /// (see variant_record::get_state_revision).
+    ///
+    /// The cache is thread-safe. Unresolved references are not cached.
+    class variant_parameter_cache
+      : private boost::noncopyable
+    {
+    public:
+
+      /// Constructor
+      explicit variant_parameter_cache(const variant_repository & repository_);
+
+      /// Destructor
+      ~variant_parameter_cache();
+
+      /// Return the value token of a variant parameter
+      ///
+      /// Returned error codes are the ones of
+      /// ui::variant_repository_cli::cmd_get_parameter.
+      command::returned_info resolve(const std::string & registry_name_,
+                                     const std::string & parameter_path_,
+                                     std::string & value_token_) const;
+
+      /// Return the number of compiled references
+      std::size_t get_number_of_entries() const;
+
+      /// Return the number of requests served from the memoized values
+      std::size_t get_number_of_hits() const;
+
+      /// Return the number of requests which needed a (re)computation of the value
+      std::size_t get_number_of_misses() const;
+
+      /// Clear the cache and its counters
+      void clear();
+
+      /// Print
+      void print(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+
+    private:
+
+      /// \brief Compiled reference to a variant parameter
+      struct entry_type
+      {
+        const variant_registry * registry = nullptr; //!< Handle to the registry
+        const variant_record * record = nullptr;     //!< Handle to the parameter record
+        bool value_set = false;                      //!< Memoized value flag
+        uint64_t state_revision = 0;                 //!< State revision of the memoized value
+        std::string value_token;                     //!< Memoized value token
+      };
+
+      /// Invalidate the compiled references if the layout of the variant records has changed
+      void _check_layout_() const;
+
+    private:
+
+      const variant_repository & _repository_;             //!< Handle to the repository
+      mutable std::mutex _mutex_;                          //!< Access lock
+      mutable uint64_t _layout_revision_ = 0;              //!< Layout revision of the compiled references
+      mutable std::map<std::string, entry_type> _entries_; //!< Compiled references
+      mutable std::size_t _hits_ = 0;                      //!< Number of memoized values served
+      mutable std::size_t _misses_ = 0;                    //!< Number of computed values
+
+    };
+
+  } // end of namespace configuration
+
+} // end of namespace datatools
+
+#endif // DATATOOLS_CONFIGURATION_VARIANT_PARAMETER_CACHE_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -74,6 +74,25 @@ namespace datatools {
       /// Array of pointers to daughter records
       typedef std::map<std::string, daughter_type> daughter_dict_type;
 
+      /// Return the revision number of the layout of all variant records
+      ///
+      /// The number is incremented at each construction or destruction
+      /// of a variant record and at each change of the registries
+      /// referenced by a repository.
+      static uint64_t get_layout_revision();
+
+      /// Return the revision number of the state of all variant records
+      ///
+      /// The number is incremented at each change of the value or of the
+      /// activation of any variant record, and at each layout change.
+      static uint64_t get_state_revision();
+
+      /// Notify a change of the layout of the variant records
+      static void notify_layout_change();
+
+      /// Notify a change of the state of the variant records
+      static void notify_state_change();
+
       /// Default constructor
       variant_record();
 
@@ -52,6 +52,7 @@ namespace datatools {
     class variant_registry_manager;
     class variant_reporting;
     class variant_record;
+    class variant_parameter_cache;
 
     /// \brief Variant repository
     class variant_repository : public datatools::enriched_base
@@ -340,6 +341,9 @@ namespace datatools {
       /// Access to the variant usage reporting (if any)
       variant_reporting & grab_reporting();
 
+      /// Return the cache of compiled variant parameter references
+      const variant_parameter_cache & get_parameter_cache() const;
+
       /// Update all registries and variant record status
       void update();
 
@@ -434,6 +438,7 @@ namespace datatools {
       std::vector<std::string> _unranked_;       //!< List of unranked configuration variant registries
       std::unique_ptr<variant_dependency_model> _dependency_model_; //!< Global model of dependencies
       variant_reporting * _reporting_ = nullptr; //!< Handle to a reporting object
+      std::unique_ptr<variant_parameter_cache> _parameter_cache_; //!< Cache of compiled variant parameter references
 
     };
 
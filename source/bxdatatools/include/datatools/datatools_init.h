@@ -26,7 +26,7 @@ namespace datatools {
     init_no_variant          = datatools::bit_mask::bit08,
     init_no_inhibit_qt_gui   = datatools::bit_mask::bit09,
     init_no_inhibit_urnquery = datatools::bit_mask::bit10, //!< Inhibit system URN query service
-    init_reserved_11         = datatools::bit_mask::bit11, //!< Reserved for future kernel initialization
+    init_startup_profile     = datatools::bit_mask::bit11, //!< Activate the startup profiler
     init_reserved_12         = datatools::bit_mask::bit12, //!< Reserved for future kernel initialization
     init_reserved_13         = datatools::bit_mask::bit13, //!< Reserved for future kernel initialization
     init_reserved_14         = datatools::bit_mask::bit14, //!< Reserved for future kernel initialization
@@ -40,7 +40,7 @@ namespace datatools {
 } // end of namespace datatools
 #endif // Bayeux_USE_EOS_ARCHIVES == 1
 
-// - EPA archive (version 6.0, candidate for official Boost/Serialization)
+// - EPA archive (version 6.1, candidate for official Boost/Serialization)
 #if Bayeux_USE_EPA_ARCHIVES == 1
 #include <boost/archive/portable_iarchive.hpp>
 #include <boost/archive/portable_oarchive.hpp>
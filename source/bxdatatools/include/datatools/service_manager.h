@@ -36,6 +36,11 @@
 #include <sstream>
 #include <typeinfo>
 #include <stdexcept>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 // Third Party:
 // - Boost:
@@ -52,6 +57,7 @@ namespace datatools {
 
   class properties;
   class multi_properties;
+  class dependency_graph;
 
   //! \brief Service management class
   class service_manager
@@ -127,6 +133,12 @@ namespace datatools {
     //! Check if the flag to force initialization of services at load is set
     bool is_force_initialization_at_load() const;
 
+    //! Set the number of threads used to initialize independent services (0: hardware concurrency)
+    void set_initialization_threads(unsigned int);
+
+    //! Return the number of threads used to initialize independent services
+    unsigned int get_initialization_threads() const;
+
     //! Check the initialization flag
     bool is_initialized() const;
 
@@ -246,6 +258,45 @@ namespace datatools {
     //! Return the bus of services known in the context of this manager
     const service_dict_type& get_bus_of_services(const bool update_ = false) const;
 
+    //! Build the graph of dependencies between the services locally hosted by this manager
+    //!
+    //! Vertices are service names, edges go from a depender service to its master service.
+    void build_dependency_graph(dependency_graph & dg_) const;
+
+    //! \brief Record of the initialization of a service by the @see initialize_services method
+    struct startup_record
+    {
+      std::string  name;           //!< Name of the service
+      std::string  id;             //!< Type identifier of the service
+      unsigned int level = 0;      //!< Depth of the service in the dependency graph
+      double       start = 0.0;    //!< Start time (in second) relative to the beginning of the initialization
+      double       duration = 0.0; //!< Initialization time (in second)
+      std::string  log;            //!< Messages logged during a concurrent initialization
+    };
+
+    //! Initialize all uninitialized services following their dependencies
+    //!
+    //! Services are initialized after their master services. Independent services
+    //! are initialized concurrently when several initialization threads are set.
+    //! A dependency cycle is an error.
+    //!
+    //! When services are initialized concurrently, the messages logged to the
+    //! standard log and error streams while a service is initialized are
+    //! buffered in its initialization record. They are printed to their own
+    //! stream once all services are initialized (or one has failed), in the
+    //! order of the initialization report, so that the output does not depend
+    //! on the scheduling of the threads. A sequential initialization prints
+    //! the messages directly.
+    void initialize_services();
+
+    //! Return the initialization records of the last call to @see initialize_services,
+    //! ordered by depth in the dependency graph, then by service name
+    const std::vector<startup_record> & get_startup_report() const;
+
+    //! Print the initialization records
+    void print_startup_report(std::ostream & out_ = std::clog,
+                              const std::string & indent_ = "") const;
+
     //! Basic print of embedded services
     void dump_services(std::ostream & out_ = std::clog,
                        const std::string& title_  = "",
@@ -313,6 +364,9 @@ namespace datatools {
     //! Set the factory preload flag
     void set_preload(bool preload_);
 
+    //! Fill the dependencies of a service from its configuration and its service object
+    void _fetch_service_dependencies_(service_entry & entry_);
+
   private:
 
     datatools::logger::priority _logging_priority_ = datatools::logger::PRIO_FATAL; //!< Logging priority threshold
@@ -322,6 +376,7 @@ namespace datatools {
     bool         _preload_ = false;     //!< Factory preload flag
     bool         _force_initialization_at_load_ = false; //!< Flag for triggering service initialization at load (rather than first use)
     bool         _allow_dynamic_services_ = false;       //!< Flag to allow dynamic services
+    unsigned int _initialization_threads_ = 1;           //!< Number of threads used to initialize services
 
     // 2012-04-09 FM : support for datatools::factory system :
     base_service::factory_register_type  _factory_register_;
@@ -331,6 +386,12 @@ namespace datatools {
 
     service_dict_type                    _service_bus_; //!< Bus of all services known from this manager
 
+    // Concurrent initialization of services:
+    std::mutex                           _init_mutex_;   //!< Lock on the initialization status of services
+    std::condition_variable              _init_cv_;      //!< Notification of the end of a service initialization
+    std::map<const service_entry *, std::thread::id> _initializing_; //!< Services being initialized and their thread
+    std::vector<startup_record>          _startup_report_; //!< Initialization records
+
     friend class service_entry;
   };
 
@@ -0,0 +1,189 @@
+//! \file    datatools/startup_profiler.h
+//! \brief   Tracer of the startup time of Bayeux based applications
+//! \details The startup profiler records hierarchical timed spans for
+//!          the initialization of the kernel and its system services,
+//!          the loading of plugin libraries, the reading of configuration
+//!          files and the initialization of services. It is disabled by
+//!          default and is activated through the datatools/Bayeux
+//!          initialization flags or the BAYEUX_STARTUP_PROFILE environment
+//!          variable. The recorded spans can be exported in the Chrome
+//!          trace event JSON format and summarized as text.
+//
+// This file is part of datatools.
+//
+// datatools is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// datatools is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with datatools.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef DATATOOLS_STARTUP_PROFILER_H
+#define DATATOOLS_STARTUP_PROFILER_H
+
+// Standard Library:
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Third Party:
+// - Boost:
+#include <boost/noncopyable.hpp>
+#include <boost/preprocessor/cat.hpp>
+
+namespace datatools {
+
+  /// \brief Recorder of the timed spans of the startup of an application
+  ///
+  /// Spans are nested per thread: a span opened while another span is
+  /// opened in the same thread is recorded as its child. Recording is
+  /// thread-safe. When the profiler is disabled, opening a span costs a
+  /// single atomic flag check (the name of the span is only copied when
+  /// the span is recorded).
+  ///
+  /// Spans are recorded until the profiler is disabled, by default at
+  /// datatools' termination. An application should disable the profiler
+  /// at the end of its own startup, so that the configuration files read
+  /// or the libraries loaded while processing are not recorded. The
+  /// recorded spans are still reported at datatools' termination.
+  ///
+  /// Environment:
+  ///  - BAYEUX_STARTUP_PROFILE : activate the profiler at datatools'
+  ///    initialization if set to a non empty value other than '0'
+  ///  - BAYEUX_STARTUP_PROFILE_FILE : name of the Chrome trace file
+  ///    written at datatools' termination (default: "bayeux_startup_trace.json")
+  class startup_profiler
+    : private boost::noncopyable
+  {
+  public:
+
+    /// \brief Record of a timed span
+    struct span_record
+    {
+      std::string category;         //!< Category of the span (kernel, config, plugin, service...)
+      std::string name;             //!< Name of the span
+      double      start = 0.0;      //!< Start time since the profiler epoch (microsecond)
+      double      duration = -1.0;  //!< Duration (microsecond, negative if the span is not closed)
+      unsigned int depth = 0;       //!< Nesting depth in its thread
+      int         parent = -1;      //!< Index of the parent span (-1 for a top level span)
+      unsigned int thread = 0;      //!< Rank of the thread in order of first appearance
+    };
+
+    /// \brief Scoped span (RAII)
+    class scope
+      : private boost::noncopyable
+    {
+    public:
+
+      /// Open a span if the profiler is enabled
+      scope(const char * category_, const std::string & name_);
+
+      /// Open a span if the profiler is enabled
+      scope(const char * category_, const char * name_);
+
+      /// Close the span
+      ~scope();
+
+    private:
+
+      int _index_ = -1; //!< Index of the recorded span
+    };
+
+    /// Default name of the Chrome trace file
+    static const std::string & default_trace_filename();
+
+    /// Access to the profiler singleton
+    static startup_profiler & instance();
+
+    /// Check if the profiler is enabled
+    bool is_enabled() const;
+
+    /// Enable the profiler
+    void enable();
+
+    /// Disable the profiler (recorded spans are kept)
+    void disable();
+
+    /// Enable the profiler from the BAYEUX_STARTUP_PROFILE environment variable
+    bool enable_from_env();
+
+    /// Set the name of the Chrome trace file written by the report
+    void set_trace_filename(const std::string &);
+
+    /// Return the name of the Chrome trace file written by the report
+    const std::string & get_trace_filename() const;
+
+    /// Open a span and return its index (-1 if the profiler is disabled)
+    int begin_span(const char * category_, const std::string & name_);
+
+    /// Open a span and return its index (-1 if the profiler is disabled)
+    int begin_span(const char * category_, const char * name_);
+
+    /// Close a span
+    void end_span(int index_);
+
+    /// Return the number of recorded spans
+    std::size_t get_number_of_spans() const;
+
+    /// Return a copy of the recorded spans, ordered by opening
+    std::vector<span_record> get_spans() const;
+
+    /// Discard all recorded spans (no span must be opened)
+    void clear();
+
+    /// Export the recorded spans in the Chrome trace event JSON format
+    void write_chrome_trace(std::ostream & out_) const;
+
+    /// Export the recorded spans in a Chrome trace file
+    void write_chrome_trace(const std::string & filename_) const;
+
+    /// Print a text summary of the recorded spans
+    void print_summary(std::ostream & out_ = std::clog,
+                       const std::string & indent_ = "") const;
+
+    /// Write the Chrome trace file and print the text summary, if any span was recorded
+    void report(std::ostream & out_ = std::clog);
+
+  private:
+
+    /// Default constructor
+    startup_profiler();
+
+    /// Return the elapsed time since the epoch (microsecond)
+    double _now_() const;
+
+  private:
+
+    std::atomic<bool>        _enabled_;        //!< Activation flag
+    std::chrono::steady_clock::time_point _epoch_; //!< Reference time
+    std::string              _trace_filename_; //!< Name of the Chrome trace file
+    mutable std::mutex       _mutex_;          //!< Protection of the records
+    std::vector<span_record> _spans_;          //!< Recorded spans
+    unsigned int             _nthreads_ = 0;   //!< Number of threads which recorded spans
+
+  };
+
+} // namespace datatools
+
+/// Record a timed span of the startup profiler until the end of the current scope
+#define DT_STARTUP_PROFILE_SCOPE(Category, Name)                        \
+  ::datatools::startup_profiler::scope BOOST_PP_CAT(_dt_startup_span_, __LINE__)(Category, Name)
+/**/
+
+#endif // DATATOOLS_STARTUP_PROFILER_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
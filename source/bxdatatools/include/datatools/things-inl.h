@@ -50,13 +50,13 @@ namespace datatools {
     const std::type_info& ti = typeid(T);
     datatools::i_serializable& cur = *found->second.handle;
     const std::type_info& tf = typeid(cur);
-    T tmp;
     DT_THROW_IF (ti != tf,
                  datatools::bad_things_cast,
-                 "Request type '" << ti.name() << "' ('" << tmp.get_serial_tag()
+                 "Request type '" << ti.name() << "' ('" << T().get_serial_tag()
                  << "') does not match the type '" << tf.name() << "' of the stored object named '"
                  << a_name << "' ('" << found->second.handle->get_serial_tag() << "') !");
     T* ptr = dynamic_cast<T*>(found->second.handle);
+    _unindex_slot_(found->second);
     found->second.handle = 0;
     _things_.erase(found);
     return ptr;
@@ -73,10 +73,9 @@ namespace datatools {
     const std::type_info& ti = typeid(T);
     datatools::i_serializable& cur = *found->second.handle;
     const std::type_info& tf = typeid(cur);
-    T tmp;
     DT_THROW_IF (ti != tf,
                  datatools::bad_things_cast,
-                 "Request type '" << ti.name() << tmp.get_serial_tag() << "') does not match the type '"
+                 "Request type '" << ti.name() << "' ('" << T().get_serial_tag() << "') does not match the type '"
                  << tf.name() << "' of the stored object named '" << a_name << "' ('"
                  << found->second.handle->get_serial_tag() << "') !");
     DT_THROW_IF (found->second.is_const(),
@@ -109,15 +108,75 @@ namespace datatools {
     const std::type_info& ti = typeid(T);
     datatools::i_serializable& cur = *found->second.handle;
     const std::type_info& tf = typeid(cur);
-    T tmp;
     DT_THROW_IF (ti != tf,
                  datatools::bad_things_cast,
-                 "Request type '" << ti.name() << "' ('" << tmp.get_serial_tag()
+                 "Request type '" << ti.name() << "' ('" << T().get_serial_tag()
                  << "') does not match the type '" << tf.name() << "' of the stored object named '" << a_name
                  << "' ('" << found->second.handle->get_serial_tag() << "') !");
     return *(dynamic_cast<const T*>(found->second.handle));
   }
 
+  inline
+  const things::slot_type * things::_find_slot_(std::size_t slot_,
+                                                const std::string & name_,
+                                                slot_type & tmp_) const
+  {
+    if (slot_ < _slots_.size() && _slots_[slot_].entry != nullptr) {
+      return &_slots_[slot_];
+    }
+    if (_unindexed_ == 0) {
+      // All stored banks are indexed:
+      return nullptr;
+    }
+    // Fallback for banks added before the registration of their slot:
+    return _lookup_slot_(name_, tmp_);
+  }
+
+
+  template<class T>
+  bool things::has(const bank_handle<T> & handle_) const
+  {
+    slot_type tmp;
+    return _find_slot_(handle_.get_slot(), handle_.get_name(), tmp) != nullptr;
+  }
+
+
+  template<class T>
+  const T& things::get(const bank_handle<T> & handle_) const
+  {
+    slot_type tmp;
+    const slot_type * s = _find_slot_(handle_.get_slot(), handle_.get_name(), tmp);
+    DT_THROW_IF (s == nullptr,
+                 std::logic_error,
+                 "No object named '" << handle_.get_name() << "' !");
+    DT_THROW_IF (*s->type != typeid(T),
+                 datatools::bad_things_cast,
+                 "Request type '" << typeid(T).name() << "' does not match the type '"
+                 << s->type->name() << "' of the stored object named '" << handle_.get_name() << "' !");
+    // The stored object is exactly of type T:
+    return *static_cast<const T*>(s->object);
+  }
+
+
+  template<class T>
+  T& things::grab(const bank_handle<T> & handle_)
+  {
+    slot_type tmp;
+    const slot_type * s = _find_slot_(handle_.get_slot(), handle_.get_name(), tmp);
+    DT_THROW_IF (s == nullptr,
+                 std::logic_error,
+                 "No stored object has name '" << handle_.get_name() << "' !");
+    DT_THROW_IF (*s->type != typeid(T),
+                 datatools::bad_things_cast,
+                 "Request type '" << typeid(T).name() << "' does not match the type '"
+                 << s->type->name() << "' of the stored object named '" << handle_.get_name() << "' !");
+    DT_THROW_IF (s->entry->is_const(),
+                 std::logic_error,
+                 "Object named '" << handle_.get_name() << "' is constant !");
+    // The stored object is exactly of type T:
+    return *static_cast<T*>(s->object);
+  }
+
 }  // end of namespace datatools
 
 #endif // DATATOOLS_THINGS_INL_H
@@ -36,6 +36,7 @@
 #define DATATOOLS_THINGS_H
 
 // Standard Library:
+#include <cstddef>
 #include <exception>
 #include <iostream>
 #include <map>
@@ -124,6 +125,7 @@ namespace datatools {
       std::string                 description;
       uint8_t                     flags;
       datatools::i_serializable * handle;
+      std::size_t                 slot; //!< Registered bank slot of the entry (not serialized)
 
       BOOST_SERIALIZATION_BASIC_DECLARATION ()
 
@@ -140,6 +142,73 @@ namespace datatools {
     /// Embedded dictionary of arbitrary serializable objects
     typedef std::map<std::string, entry_type> dict_type;
 
+    /// Invalid bank slot
+    static const std::size_t INVALID_BANK_SLOT = static_cast<std::size_t>(-1);
+
+    /// Register a bank name in the process-wide table of bank slots and return its slot (thread safe)
+    static std::size_t register_bank_slot(const std::string & name_);
+
+    //! \brief Precomputed access key to a bank of given name and type
+    /**
+     *  The bank name is registered once, typically at module initialization,
+     *  in a process-wide table of bank slots. Banks with a registered name are
+     *  indexed by their slot when they are added in a container, so that an
+     *  access through the handle does not need any lookup by name, and the
+     *  type check compares cached type ids without any instantiation of T.
+     *
+     *  @code
+     *  // At initialization:
+     *  datatools::things::bank_handle<datatools::properties> _info_handle_("Info");
+     *  // At processing:
+     *  const datatools::properties & info = data_record_.get(_info_handle_);
+     *  @endcode
+     */
+    template<class T>
+    class bank_handle
+    {
+    public:
+
+      /// Default constructor
+      bank_handle() {}
+
+      /// Constructor with the name of the bank
+      explicit bank_handle(const std::string & name_)
+      {
+        set_name(name_);
+      }
+
+      /// Set the name of the bank and register its slot
+      void set_name(const std::string & name_)
+      {
+        _name_ = name_;
+        _slot_ = things::register_bank_slot(name_);
+      }
+
+      /// Check validity
+      bool is_valid() const
+      {
+        return _slot_ != things::INVALID_BANK_SLOT;
+      }
+
+      /// Return the name of the bank
+      const std::string & get_name() const
+      {
+        return _name_;
+      }
+
+      /// Return the slot of the bank
+      std::size_t get_slot() const
+      {
+        return _slot_;
+      }
+
+    private:
+
+      std::string _name_; //!< Name of the bank
+      std::size_t _slot_ = things::INVALID_BANK_SLOT; //!< Slot of the bank
+
+    };
+
     /// Default constructor
     things();
 
@@ -188,6 +257,11 @@ namespace datatools {
     /// Clear the container
     void clear() override;
 
+    /// Exchange the contents (name, description and objects) with another container
+    ///
+    /// No stored object is copied nor reallocated.
+    void swap(things & other_);
+
     /// Return the number of objects stored in the container
     unsigned int size() const;
 
@@ -256,6 +330,18 @@ namespace datatools {
     template<class T>
     const T& get(const std::string & name_) const;
 
+    /// Check if the container stores an object for a given bank handle
+    template<class T>
+    bool has(const bank_handle<T> & handle_) const;
+
+    /// Return a reference to a non mutable object for a given bank handle
+    template<class T>
+    const T& get(const bank_handle<T> & handle_) const;
+
+    /// Return a reference to a mutable object for a given bank handle
+    template<class T>
+    T& grab(const bank_handle<T> & handle_);
+
     /// Return a reference to a non mutable stored object of given name
     const datatools::i_serializable &
     get_entry(const std::string & name_) const;
@@ -309,6 +395,29 @@ namespace datatools {
 
   private:
 
+    /// Cached access data of a bank with a registered slot
+    struct slot_type
+    {
+      entry_type * entry = nullptr;           //!< Entry in the dictionary
+      const std::type_info * type = nullptr;  //!< Type of the stored object
+      void * object = nullptr;                //!< Address of the most derived stored object
+    };
+
+    /// Index a new entry in its slot, if its name is registered
+    void _index_slot_(const std::string & name_, entry_type & entry_);
+
+    /// Remove an entry from the slots
+    void _unindex_slot_(entry_type & entry_);
+
+    /// Rebuild all slots from the dictionary
+    void _reindex_slots_();
+
+    /// Return the cached access data of a bank from its slot or, if not indexed, from its name
+    const slot_type * _find_slot_(std::size_t slot_, const std::string & name_, slot_type & tmp_) const;
+
+    /// Build the access data of a bank from its name
+    const slot_type * _lookup_slot_(const std::string & name_, slot_type & tmp_) const;
+
     /// Implementation for adding a object in the container with a given name
     void add_impl(const std::string & name_,
                   datatools::i_serializable * obj_,
@@ -321,6 +430,8 @@ namespace datatools {
     std::string _name_;        //!< The name of the container
     std::string _description_; //!< The description of the container
     dict_type   _things_;      //!< The internal dictionary of objects
+    std::vector<slot_type> _slots_; //!< Entries indexed by registered bank slot
+    std::size_t _unindexed_ = 0;    //!< Number of entries without slot
 
     //! Serialization interface
     DATATOOLS_SERIALIZATION_DECLARATION_ADVANCED(things)
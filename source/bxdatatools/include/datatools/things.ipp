@@ -51,6 +51,9 @@ namespace datatools {
     archive_ & boost::serialization::make_nvp("name",        _name_);
     archive_ & boost::serialization::make_nvp("description", _description_);
     archive_ & boost::serialization::make_nvp("things",      _things_);
+    if (Archive::is_loading::value) {
+      _reindex_slots_();
+    }
     return;
   }
 
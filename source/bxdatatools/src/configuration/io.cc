@@ -25,6 +25,7 @@
 // Standard library:
 #include <memory>
 #include <deque>
+#include <chrono>
 
 // Third party:
 // - Boost:
@@ -37,7 +38,7 @@
 #include <datatools/configuration/variant_record.h>
 #include <datatools/configuration/variant_registry.h>
 #include <datatools/configuration/variant_repository.h>
-#include <datatools/configuration/ui/variant_repository_cli.h>
+#include <datatools/configuration/variant_parameter_cache.h>
 #include <datatools/ioutils.h>
 #include <datatools/utils.h>
 #include <datatools/units.h>
@@ -509,7 +510,8 @@ namespace datatools {
     {
       out_ << "variant_reporting::dump: \n";
       out_ << "|-- " << "Repository : " << _repository_ << "\n";
-      out_ << "`-- " << "Counters   : " << _parameter_stats_.size() << "\n";
+      out_ << "|-- " << "Counters   : " << _parameter_stats_.size() << "\n";
+      out_ << "`-- " << "Files      : " << _file_stats_.size() << "\n";
       return;
     }
 
@@ -555,6 +557,7 @@ namespace datatools {
     void variant_reporting::reset_repository()
     {
       _parameter_stats_.clear();
+      _file_stats_.clear();
       _repository_ = nullptr;
       return;
     }
@@ -589,6 +592,7 @@ namespace datatools {
     void variant_reporting::reset()
     {
       _parameter_stats_.clear();
+      _file_stats_.clear();
       return;
     }
 
@@ -612,6 +616,15 @@ namespace datatools {
         }
         out_ << "\n";
       }
+      if (_file_stats_.size()) {
+        out_ << "[files]\n";
+        out_ << "# Preprocessing of variant parameters per source file:\n";
+        for (auto fstat : _file_stats_) {
+          out_ << fstat.first << " = " << fstat.second.number_of_parameters << " parameters in "
+               << fstat.second.processing_time * 1.e3 << " ms" << std::endl;
+        }
+        out_ << "\n";
+      }
       return;
     }
 
@@ -626,6 +639,16 @@ namespace datatools {
       return;
     }
 
+    void variant_reporting::add_file_statistics(const std::string & source_,
+                                                std::size_t number_of_parameters_,
+                                                double processing_time_)
+    {
+      file_statistics_type & fstat = _file_stats_[source_];
+      fstat.number_of_parameters += number_of_parameters_;
+      fstat.processing_time += processing_time_;
+      return;
+    }
+
     /* --------------------------------- */
 
     variant_preprocessor::variant_preprocessor(unsigned int flags_)
@@ -814,83 +837,89 @@ namespace datatools {
       return cri;
     }
 
+    std::size_t variant_preprocessor::get_number_of_parameters() const
+    {
+      return _number_of_parameters_;
+    }
+
+    double variant_preprocessor::get_processing_time() const
+    {
+      return _processing_time_;
+    }
+
+    void variant_preprocessor::report_statistics(const std::string & source_) const
+    {
+      if (_number_of_parameters_ > 0 && has_repository() && _repository_->has_reporting()) {
+        variant_repository & mutable_repository = const_cast<variant_repository&>(get_repository());
+        mutable_repository.grab_reporting().add_file_statistics(source_,
+                                                                _number_of_parameters_,
+                                                                _processing_time_);
+      }
+      _number_of_parameters_ = 0;
+      _processing_time_ = 0.0;
+      return;
+    }
+
     command::returned_info variant_preprocessor::preprocess_parameter(const std::string & parameter_token_,
                                                                       std::string & parameter_effective_token_) const
     {
       DT_LOG_TRACE_ENTERING(_logging_);
-      static const std::string variant_default_sep = "|";
-      // Working string:
-      std::string effective_property_value_str;
+      static const char variant_default_sep = '|';
+      static const char variant_registry_sep = ':';
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      _number_of_parameters_++;
       command::returned_info cri(command::CEC_SUCCESS);
       try {
         parameter_effective_token_.clear();
-        std::vector<std::string> variant_tokens;
-        boost::split(variant_tokens, parameter_token_, boost::is_any_of(variant_default_sep));
-        if (variant_tokens.size() == 0) {
-          DT_COMMAND_RETURNED_ERROR(cri, command::CEC_PARSING_FAILURE,
-                                    "Cannot parse variant parameter path from '" << parameter_token_ << "' !");
-          return cri;
-        }
-        std::string variant_path = variant_tokens[0];
+        // Parse '{registry}:{path}[|{default}[|...]]':
+        const std::size_t default_pos = parameter_token_.find(variant_default_sep);
+        const std::string variant_path = parameter_token_.substr(0, default_pos);
         bool        has_variant_def_value = false;
         std::string variant_def_value;
-        if (variant_tokens.size() > 1) {
-          variant_def_value = variant_tokens[1];
+        if (default_pos != std::string::npos) {
+          const std::size_t end_pos = parameter_token_.find(variant_default_sep, default_pos + 1);
+          variant_def_value = parameter_token_.substr(default_pos + 1,
+                                                      end_pos == std::string::npos ? std::string::npos : end_pos - default_pos - 1);
           has_variant_def_value = true;
         }
-        std::vector<std::string> variant_path_tokens;
-        boost::split(variant_path_tokens, variant_path, boost::is_any_of(":"));
-        if (variant_path_tokens.size() != 2) {
+        const std::size_t registry_pos = variant_path.find(variant_registry_sep);
+        if (registry_pos == std::string::npos
+            || variant_path.find(variant_registry_sep, registry_pos + 1) != std::string::npos) {
           DT_COMMAND_RETURNED_ERROR(cri, command::CEC_PARSING_FAILURE,
                                     "Cannot parse variant command token '" << parameter_token_ << "'!");
           DT_THROW(std::logic_error,
                    "Cannot parse variant command token '" << parameter_token_ << "'!");
         }
-        std::string variant_registry_name  = variant_path_tokens[0];
-        std::string variant_parameter_path = variant_path_tokens[1];
+        const std::string variant_registry_name  = variant_path.substr(0, registry_pos);
+        const std::string variant_parameter_path = variant_path.substr(registry_pos + 1);
         DT_LOG_TRACE(_logging_, "variant_registry_name  = '" << variant_registry_name << "'");
         DT_LOG_TRACE(_logging_, "variant_parameter_path = '" << variant_parameter_path << "'");
-        std::string variant_parameter_value;
         if (!repository_is_active()) {
           if (has_variant_def_value) {
             parameter_effective_token_ = variant_def_value;
-            return cri;
           } else {
             DT_COMMAND_RETURNED_ERROR(cri, command::CEC_CONTEXT_INVALID,
                                       "Inactive variant repository while processing '" << parameter_token_ << "'!");
-            return cri;
           }
+          _processing_time_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+          return cri;
         }
         DT_LOG_TRACE(_logging_, "repository is active");
-        // Search for registrated variant parameter in the associated variant repository:
+        // Search for registrated variant parameter in the associated variant repository,
+        // through the cache of compiled references and memoized values:
         const variant_repository & rep = get_repository();
-        ui::variant_repository_cli vrepCli(const_cast<variant_repository &>(rep));
-        vrepCli.set_logging(_logging_);
-        DT_LOG_TRACE(_logging_, "Invoking cmd_get_parameter...");
-        command::returned_info cri2 = vrepCli.cmd_get_parameter(variant_registry_name,
-                                                                variant_parameter_path,
-                                                                variant_parameter_value);
+        std::string variant_parameter_value;
+        command::returned_info cri2 = rep.get_parameter_cache().resolve(variant_registry_name,
+                                                                        variant_parameter_path,
+                                                                        variant_parameter_value);
         if (cri2.is_failure()) {
           cri = cri2;
+          _processing_time_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
           return cri;
         }
-        DT_LOG_TRACE(_logging_, "Success.");
-        effective_property_value_str = variant_parameter_value;
         DT_LOG_TRACE(_logging_, "Found value for variant parameter '" << variant_path << "' = '"
                      << variant_parameter_value << "'");
-
-        // if (! variant_parameter_found && cri.is_success()) {
-        //   // If no error before, we try to fallback to a default value:
-        //   if (!has_variant_def_value) {
-        //     DT_COMMAND_RETURNED_ERROR(cri, command::CEC_PARAMETER_UNSET_VALUE,
-        //                               "No available default value for variant parameter '" << variant_path << "' !");
-        //   } else {
-        //     effective_property_value_str = variant_def_value;
-        //     DT_LOG_TRACE(_logging_, "Use default value for variant parameter '" << variant_path << "' = '"
-        //                               << effective_property_value_str << "'");
-        //   }
-        // }
-        parameter_effective_token_ = effective_property_value_str;
+        parameter_effective_token_ = variant_parameter_value;
         // Reporting here...
         DT_LOG_TRACE(_logging_, "Reporting for variant_path = '" << variant_path << "'");
         if (_repository_->has_reporting()) {
@@ -911,6 +940,7 @@ namespace datatools {
       } catch (std::exception & error) {
         cri.set_error_message(error.what());
       }
+      _processing_time_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
       DT_LOG_TRACE_EXITING(_logging_);
       return cri;
     }
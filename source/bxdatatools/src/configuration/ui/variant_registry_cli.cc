@@ -107,56 +107,74 @@ namespace datatools {
                      << "in registry '" << _registry_.get_name() << "'!");
           }
           const variant_record & param_rec = _registry_.get_parameter_record(param_path_);
-          if (!param_rec.is_active()) {
+          cri = get_parameter_record_value(_registry_, param_path_, param_rec, value_token_, _logging_);
+        } catch (std::exception & x) {
+          DT_LOG_ERROR(_logging_, x.what());
+          cri.set_error_message(x.what());
+        }
+        return cri;
+      }
+
+      // static
+      datatools::command::returned_info
+      variant_registry_cli::get_parameter_record_value(const variant_registry & registry_,
+                                                       const std::string & param_path_,
+                                                       const variant_record & param_rec_,
+                                                       std::string & value_token_,
+                                                       const datatools::logger::priority logging_)
+      {
+        datatools::command::returned_info cri;
+        try {
+          if (!param_rec_.is_active()) {
             cri.set_error_code(command::CEC_PARAMETER_INVALID_CONTEXT);
             DT_THROW(std::logic_error,
                      "Parameter record '" << param_path_ << "' is not active "
-                     << "in registry '" << _registry_.get_name() << "'!");
+                     << "in registry '" << registry_.get_name() << "'!");
           }
-          if (param_rec.get_parameter_model().is_boolean()) {
+          if (param_rec_.get_parameter_model().is_boolean()) {
             std::ostringstream os;
             bool value = false;
-            cri = param_rec.get_boolean_value(value);
+            cri = param_rec_.get_boolean_value(value);
             if (cri.is_failure()) {
               DT_THROW(std::logic_error,
                        "Boolean parameter '" << param_path_ << "' has no available value"
-                       << "in registry '" << _registry_.get_name() << "'!");
+                       << "in registry '" << registry_.get_name() << "'!");
             }
             io::write_boolean(os, value);
             value_token_ = os.str();
-          } else if (param_rec.get_parameter_model().is_integer()) {
+          } else if (param_rec_.get_parameter_model().is_integer()) {
             std::ostringstream os;
             int value = 0;
-            cri = param_rec.get_integer_value(value);
+            cri = param_rec_.get_integer_value(value);
             if (cri.is_failure()) {
               DT_THROW(std::logic_error,
                        "Integer parameter '" << param_path_ << "' has no available value"
-                       << "in registry '" << _registry_.get_name() << "'!");
+                       << "in registry '" << registry_.get_name() << "'!");
             }
             io::write_integer(os, value);
             value_token_ = os.str();
-          } else if (param_rec.get_parameter_model().is_real()) {
+          } else if (param_rec_.get_parameter_model().is_real()) {
             std::ostringstream os;
             double value;
-            cri = param_rec.get_real_value(value);
+            cri = param_rec_.get_real_value(value);
             if (cri.is_failure()) {
               DT_THROW(std::logic_error,
                        "Real parameter '" << param_path_ << "' has no available value"
-                       << " in registry '" << _registry_.get_name() << "'!");
+                       << " in registry '" << registry_.get_name() << "'!");
             }
             io::write_real_number(os,
                                   value,
                                   15,
-                                  param_rec.get_parameter_model().get_real_preferred_unit(),
-                                  param_rec.get_parameter_model().get_real_unit_label()
+                                  param_rec_.get_parameter_model().get_real_preferred_unit(),
+                                  param_rec_.get_parameter_model().get_real_unit_label()
                                   );
             value_token_ = os.str();
             // value_token_ = "__REAL_VALUE__";
             // cri.set_error_message("Not implemented yet!");
-          } else if (param_rec.get_parameter_model().is_string()) {
+          } else if (param_rec_.get_parameter_model().is_string()) {
             std::ostringstream os;
             std::string value;
-            cri = param_rec.get_string_value(value);
+            cri = param_rec_.get_string_value(value);
             io::write_quoted_string(os, value);
             value_token_ = os.str();
             // value_token_ = "__STRING_VALUE__";
@@ -165,10 +183,10 @@ namespace datatools {
             cri.set_error_code(command::CEC_PARAMETER_INVALID_TYPE);
             DT_THROW(std::logic_error,
                      "Parameter '" << param_path_ << "' has no known type"
-                     << "in registry '" << _registry_.get_name() << "'!");
+                     << "in registry '" << registry_.get_name() << "'!");
           }
         } catch (std::exception & x) {
-          DT_LOG_ERROR(_logging_, x.what());
+          DT_LOG_ERROR(logging_, x.what());
           cri.set_error_message(x.what());
         }
         return cri;
@@ -0,0 +1,151 @@
+// datatools/configuration/variant_parameter_cache.cc
+/*
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Ourselves:
+#include <datatools/configuration/variant_parameter_cache.h>
+
+// This project:
+#include <datatools/exception.h>
+#include <datatools/configuration/variant_record.h>
+#include <datatools/configuration/variant_registry.h>
+#include <datatools/configuration/variant_repository.h>
+#include <datatools/configuration/ui/variant_registry_cli.h>
+#include <datatools/configuration/ui/variant_repository_cli.h>
+
+namespace datatools {
+
+  namespace configuration {
+
+    variant_parameter_cache::variant_parameter_cache(const variant_repository & repository_)
+      : _repository_(repository_)
+    {
+      _layout_revision_ = variant_record::get_layout_revision();
+      return;
+    }
+
+    variant_parameter_cache::~variant_parameter_cache()
+    {
+      return;
+    }
+
+    void variant_parameter_cache::_check_layout_() const
+    {
+      const uint64_t layout_revision = variant_record::get_layout_revision();
+      if (layout_revision != _layout_revision_) {
+        // Registries or records may have been destroyed:
+        _entries_.clear();
+        _layout_revision_ = layout_revision;
+      }
+      return;
+    }
+
+    command::returned_info
+    variant_parameter_cache::resolve(const std::string & registry_name_,
+                                     const std::string & parameter_path_,
+                                     std::string & value_token_) const
+    {
+      command::returned_info cri(command::CEC_SUCCESS);
+      const std::string key = registry_name_ + ':' + parameter_path_;
+      std::lock_guard<std::mutex> lock(_mutex_);
+      _check_layout_();
+      std::map<std::string, entry_type>::iterator found = _entries_.find(key);
+      if (found == _entries_.end()) {
+        // Compile the reference:
+        const variant_registry * reg = nullptr;
+        if (_repository_.has_registry(registry_name_)) {
+          reg = &_repository_.get_registry(registry_name_);
+        }
+        if (reg == nullptr || !reg->has_parameter_record(parameter_path_)) {
+          // Unresolved reference: use the generic interface for a consistent diagnostic
+          ui::variant_repository_cli repCli(const_cast<variant_repository&>(_repository_));
+          cri = repCli.cmd_get_parameter(registry_name_, parameter_path_, value_token_);
+          return cri;
+        }
+        entry_type new_entry;
+        new_entry.registry = reg;
+        new_entry.record = &reg->get_parameter_record(parameter_path_);
+        found = _entries_.insert(std::make_pair(key, new_entry)).first;
+      }
+      entry_type & e = found->second;
+      const uint64_t state_revision = variant_record::get_state_revision();
+      if (e.value_set && e.state_revision == state_revision) {
+        _hits_++;
+        value_token_ = e.value_token;
+        return cri;
+      }
+      _misses_++;
+      e.value_set = false;
+      std::string value_token;
+      cri = ui::variant_registry_cli::get_parameter_record_value(*e.registry,
+                                                                 parameter_path_,
+                                                                 *e.record,
+                                                                 value_token);
+      if (cri.is_failure()) {
+        return cri;
+      }
+      e.value_token = value_token;
+      e.state_revision = state_revision;
+      e.value_set = true;
+      value_token_ = value_token;
+      return cri;
+    }
+
+    std::size_t variant_parameter_cache::get_number_of_entries() const
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      _check_layout_();
+      return _entries_.size();
+    }
+
+    std::size_t variant_parameter_cache::get_number_of_hits() const
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      return _hits_;
+    }
+
+    std::size_t variant_parameter_cache::get_number_of_misses() const
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      return _misses_;
+    }
+
+    void variant_parameter_cache::clear()
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      _entries_.clear();
+      _hits_ = 0;
+      _misses_ = 0;
+      _layout_revision_ = variant_record::get_layout_revision();
+      return;
+    }
+
+    void variant_parameter_cache::print(std::ostream & out_, const std::string & indent_) const
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      _check_layout_();
+      out_ << indent_ << "Compiled variant parameters : " << _entries_.size() << std::endl;
+      out_ << indent_ << "Memoized values served      : " << _hits_ << std::endl;
+      out_ << indent_ << "Computed values             : " << _misses_ << std::endl;
+      return;
+    }
+
+  } // end of namespace configuration
+
+} // end of namespace datatools
@@ -22,6 +22,9 @@
 // Ourselves:
 #include <datatools/configuration/variant_record.h>
 
+// Standard library:
+#include <atomic>
+
 // Third party
 // - Boost:
 #include <boost/filesystem/path.hpp>
@@ -40,6 +43,51 @@ namespace datatools {
 
   namespace configuration {
 
+    namespace {
+
+      /// Revision number of the layout of the variant records
+      std::atomic<uint64_t> & _layout_revision()
+      {
+        static std::atomic<uint64_t> _rev(0);
+        return _rev;
+      }
+
+      /// Revision number of the state of the variant records
+      std::atomic<uint64_t> & _state_revision()
+      {
+        static std::atomic<uint64_t> _rev(0);
+        return _rev;
+      }
+
+    }
+
+    // static
+    uint64_t variant_record::get_layout_revision()
+    {
+      return _layout_revision().load();
+    }
+
+    // static
+    uint64_t variant_record::get_state_revision()
+    {
+      return _state_revision().load();
+    }
+
+    // static
+    void variant_record::notify_layout_change()
+    {
+      _layout_revision()++;
+      _state_revision()++;
+      return;
+    }
+
+    // static
+    void variant_record::notify_state_change()
+    {
+      _state_revision()++;
+      return;
+    }
+
     void variant_record::_fix_dependers_on_this_variant_()
     {
       datatools::logger::priority logging = _logging_;
@@ -508,11 +556,13 @@ namespace datatools {
       _integer_value_ = 0;
       datatools::invalidate(_real_value_);
       _string_value_.clear();
+      notify_layout_change();
       return;
     }
 
     variant_record::~variant_record()
     {
+      notify_layout_change();
       return;
     }
 
@@ -536,6 +586,7 @@ namespace datatools {
       _integer_value_ = 0;
       datatools::invalidate(_real_value_);
       _string_value_.clear();
+      notify_state_change();
       return;
     }
 
@@ -764,6 +815,7 @@ namespace datatools {
     {
       if (_active_ != active_) {
         _active_ = active_;
+        notify_state_change();
         if (!_active_) {
           DT_LOG_DEBUG(get_logging(), "Deactivation of variant record '" << get_path() << "'...");
         } else {
@@ -989,6 +1041,7 @@ namespace datatools {
         }
         _boolean_value_ = value_;
         _value_set_ = true;
+        notify_state_change();
         if (has_with_update()) _update_();
       } catch (std::exception & x) {
         cri.set_error_message(x.what());
@@ -1023,6 +1076,7 @@ namespace datatools {
         }
         _integer_value_ = value_;
         _value_set_ = true;
+        notify_state_change();
         if (has_with_update()) _update_();
       } catch (std::exception & x) {
         cri.set_error_message(x.what());
@@ -1059,6 +1113,7 @@ namespace datatools {
         }
         _real_value_ = value_;
         _value_set_ = true;
+        notify_state_change();
         if (has_with_update()) _update_();
       } catch (std::exception & x) {
         cri.set_error_message(x.what());
@@ -1131,6 +1186,7 @@ namespace datatools {
         }
         _string_value_ = value_;
         _value_set_ = true;
+        notify_state_change();
         if (has_with_update()) _update_();
       } catch (std::exception & x) {
         cri.set_error_message(x.what());
@@ -1152,6 +1208,7 @@ namespace datatools {
         // DT_THROW_IF(get_parameter_model().is_fixed(), std::logic_error,
         //           "Parameter record '" << _path_ << "' is fixed!");
         _value_set_ = false;
+        notify_state_change();
         if (has_with_update()) _update_();
       } catch (std::exception & x) {
         cri.set_error_message(x.what());
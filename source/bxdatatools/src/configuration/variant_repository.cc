@@ -36,6 +36,7 @@
 #include <datatools/configuration/variant_registry.h>
 #include <datatools/configuration/variant_registry_manager.h>
 #include <datatools/configuration/variant_record.h>
+#include <datatools/configuration/variant_parameter_cache.h>
 #include <datatools/configuration/parameter_model.h>
 #include <datatools/configuration/variant_model.h>
 #include <datatools/configuration/io.h>
@@ -91,6 +92,8 @@ namespace datatools {
           _embedded_manager_.reset();
         }
       }
+      // Compiled references to the parameters of this registry are obsolete:
+      variant_record::notify_layout_change();
       return;
     }
 
@@ -106,6 +109,7 @@ namespace datatools {
       DT_THROW_IF(reg_.is_mounted(), std::logic_error,
                   "Cannot mount a registry already mounted in another repository!");
       _external_registry_->set_parent_repository(*_parent_repository_, _name_);
+      variant_record::notify_layout_change();
       return;
     }
 
@@ -154,6 +158,7 @@ namespace datatools {
       }
       _rank_ = -1;
       _last_active_ = false;
+      variant_record::notify_layout_change();
       return;
     }
 
@@ -198,6 +203,7 @@ namespace datatools {
       _initialized_ = false;
       _locked_ = false;
       _reporting_ = nullptr;
+      _parameter_cache_.reset(new variant_parameter_cache(*this));
       return;
     }
 
@@ -422,6 +428,11 @@ namespace datatools {
       return *_reporting_;
     }
 
+    const variant_parameter_cache & variant_repository::get_parameter_cache() const
+    {
+      return *_parameter_cache_;
+    }
+
     bool variant_repository::has_dependency_model() const
     {
       return _dependency_model_.get() != nullptr;
@@ -16,6 +16,7 @@
 #include <datatools/datatools_config.h>
 #include <datatools/kernel.h>
 #include <datatools/logger.h> // for logger, etc
+#include <datatools/startup_profiler.h>
 
 namespace datatools {
 
@@ -24,6 +25,15 @@ namespace datatools {
     DT_LOG_TRACE_ENTERING(detail::sys::const_instance().get_logging());
     static bool _init = false;
     if (!_init) {
+      startup_profiler & profiler = startup_profiler::instance();
+      if (flags_ & datatools::init_startup_profile) {
+        profiler.enable();
+      }
+      if (profiler.enable_from_env()) {
+        DT_LOG_TRACE(detail::sys::const_instance().get_logging(),
+                     "The startup profiler is enabled.");
+      }
+      DT_STARTUP_PROFILE_SCOPE("kernel", "datatools initialization");
       bool do_kernel = true;
       if (flags_ & datatools::init_kernel_inhibit) {
         // Inhibit the kernel:
@@ -65,6 +75,10 @@ namespace datatools {
     DT_LOG_TRACE_ENTERING(detail::sys::const_instance().get_logging());
     static bool _terminate = false;
     if (!_terminate) {
+      // The profiler may have been disabled by the application at the end of its startup:
+      startup_profiler & profiler = startup_profiler::instance();
+      profiler.disable();
+      profiler.report(std::clog);
       if (datatools::kernel::is_instantiated()) {
         datatools::kernel & krnl = datatools::kernel::instance();
         if (krnl.is_initialized()) {
@@ -34,6 +34,7 @@
 #include <datatools/service_manager.h>
 #include <datatools/library_query_service.h>
 #include <datatools/urn_query_service.h>
+#include <datatools/startup_profiler.h>
 
 #if DATATOOLS_WITH_QT_GUI == 1
 #include <QStyleFactory>
@@ -627,6 +628,7 @@ namespace datatools {
 
   void kernel::_initialize_services_()
   {
+    DT_STARTUP_PROFILE_SCOPE("kernel", "system services");
     // System service manager:
     _services_.reset(new service_manager);
     _services_->set_name("bxDtKernServices");
@@ -649,6 +651,7 @@ namespace datatools {
 
   void kernel::_initialize_urn_query_service_()
   {
+    DT_STARTUP_PROFILE_SCOPE("service", "bxDtKernUrnQuery");
     datatools::urn_query_service & kUrnQuery =
       dynamic_cast<datatools::urn_query_service &>(_services_->load_no_init("bxDtKernUrnQuery",
                                                                             "datatools::urn_query_service"));
@@ -658,6 +661,7 @@ namespace datatools {
 
   void kernel::_initialize_library_query_service_()
   {
+    DT_STARTUP_PROFILE_SCOPE("service", "bxDtKernLibQuery");
     datatools::library_query_service & kLibInfo =
       dynamic_cast<datatools::library_query_service &>(_services_->load_no_init("bxDtKernLibQuery",
                                                                                 "datatools::library_query_service"));
@@ -748,6 +752,7 @@ namespace datatools {
   void kernel::_initialize_configuration_variant_repository_()
   {
     DT_LOG_TRACE_ENTERING(_logging_);
+    DT_STARTUP_PROFILE_SCOPE("variant", "kernel variant repository");
     DT_LOG_INFORMATION(_logging_, "Initializing kernel's configuration variant repository...");
     // Instantiate the kernel variant repository:
     if (this->_activate_variant_repository_) {
@@ -772,6 +777,7 @@ namespace datatools {
   void kernel::register_resource_paths()
   {
     DT_LOG_TRACE_ENTERING(_logging_);
+    DT_STARTUP_PROFILE_SCOPE("kernel", "resource paths registration");
     DT_LOG_INFORMATION(_logging_, "Registration of resource paths...");
 
     if (has_library_query()) {
@@ -891,6 +897,7 @@ namespace datatools {
   void kernel::register_configuration_variant_registries()
   {
     DT_LOG_TRACE_ENTERING(_logging_);
+    DT_STARTUP_PROFILE_SCOPE("variant", "variant registries registration");
     if (_variant_repository_) {
 
       bool rep_locked = false;
@@ -1176,7 +1183,10 @@ namespace datatools {
     }
 
     // Initialize internals:
-    _initialize_();
+    {
+      DT_STARTUP_PROFILE_SCOPE("kernel", "kernel initialization");
+      _initialize_();
+    }
 
     _initialized_ = true;
     // std::cerr << "************** DEVEL ************* prio2=" << _logging_ << "\n";
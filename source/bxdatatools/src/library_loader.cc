@@ -23,6 +23,7 @@
 #include <datatools/multi_properties.h>
 #include <datatools/exception.h>
 #include <datatools/logger.h>
+#include <datatools/startup_profiler.h>
 
 namespace datatools {
 
@@ -251,6 +252,8 @@ namespace datatools {
                            const std::string& filename_,
                            const std::string& full_lib_path_,
                            const std::string& version_) {
+    // Static registrations in the library (factories...) are run at opening:
+    DT_STARTUP_PROFILE_SCOPE("plugin", lib_name_);
     std::vector<std::string> lib_dir_tokens;
     boost::split(lib_dir_tokens, lib_name_, boost::is_any_of("@"));
     DT_THROW_IF(lib_dir_tokens.size() == 0, std::logic_error,
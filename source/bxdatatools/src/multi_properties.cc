@@ -20,6 +20,7 @@
 #include <datatools/configuration/variant_registry.h>
 #include <datatools/configuration/variant_repository.h>
 #include <datatools/configuration/io.h>
+#include <datatools/startup_profiler.h>
 
 // Support for serialization tag :
 DATATOOLS_SERIALIZATION_EXT_SERIAL_TAG_IMPLEMENTATION(::datatools::multi_properties,
@@ -703,6 +704,7 @@ namespace datatools {
 
   void multi_properties::config::read(const std::string & filename_, multi_properties & target_)
   {
+    DT_STARTUP_PROFILE_SCOPE("config", filename_);
     std::string filename = filename_;
     if (_resolve_path_) {
       DT_THROW_IF(!fetch_path_with_env(filename),
@@ -1577,6 +1579,9 @@ namespace datatools {
                      << "The input stream seems not to have the proper \"datatools::multi_properties\" format! "
                      << "Please check the input file/stream!");
     }
+    if (!_current_filename_.empty()) {
+      vpp.report_statistics(_current_filename_);
+    }
     return;
 
   } /* end of multi_properties::config::read */
@@ -29,6 +29,7 @@
 #include <datatools/configuration/variant_repository.h>
 #include <datatools/configuration/io.h>
 #include <datatools/file_include.h>
+#include <datatools/startup_profiler.h>
 
 // Support for serialization tag :
 DATATOOLS_SERIALIZATION_EXT_SERIAL_TAG_IMPLEMENTATION(::datatools::properties,
@@ -3141,6 +3142,7 @@ namespace datatools {
 
   void properties::config::read(const std::string & filename_, properties & props_)
   {
+    DT_STARTUP_PROFILE_SCOPE("config", filename_);
     std::string filename = filename_;
     if (_resolve_path_) {
       DT_THROW_IF(!fetch_path_with_env(filename),
@@ -4762,6 +4764,9 @@ namespace datatools {
                               _section_start_line_number_,
                               _current_line_number_,
                               "Unclosed variant conditional block '" << variant_if_blocks.back() << "'!");
+    if (!_current_filename_.empty()) {
+      vpp.report_statistics(_current_filename_);
+    }
     return;
   }
 
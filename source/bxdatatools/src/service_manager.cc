@@ -26,6 +26,12 @@
 #include <stdexcept>
 #include <sstream>
 #include <memory>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <streambuf>
 
 // This Project:
 #include <datatools/base_service.h>
@@ -35,9 +41,117 @@
 #include <datatools/multi_properties.h>
 #include <datatools/exception.h>
 #include <datatools/logger.h>
+#include <datatools/dependency_graph.h>
+#include <datatools/startup_profiler.h>
 
 namespace datatools {
 
+  namespace {
+
+    //! \brief Chunk of the startup log of a service written to a given stream
+    struct startup_log_chunk
+    {
+      std::ostream * stream; //!< Stream the text was written to
+      std::string    text;   //!< Captured text
+    };
+
+    //! Startup log of a service, in writing order
+    typedef std::vector<startup_log_chunk> startup_log_type;
+
+    //! Startup log of the service being initialized by the current thread, if any
+    thread_local startup_log_type * startup_log_target = nullptr;
+
+    //! \brief Stream buffer which captures the output of the threads initializing services
+    //!
+    //! The output of a thread with a startup log target is appended to this log,
+    //! tagged with its stream. The output of other threads is forwarded to the
+    //! original stream buffer.
+    class startup_log_buffer
+      : public std::streambuf
+    {
+    public:
+
+      startup_log_buffer(std::ostream & stream_, std::streambuf * fallback_)
+        : _stream_(&stream_)
+        , _fallback_(fallback_)
+      {
+        return;
+      }
+
+      std::streambuf * get_fallback() const
+      {
+        return _fallback_;
+      }
+
+    protected:
+
+      int_type overflow(int_type c_) override
+      {
+        if (traits_type::eq_int_type(c_, traits_type::eof())) {
+          return traits_type::not_eof(c_);
+        }
+        const char c = traits_type::to_char_type(c_);
+        return (xsputn(&c, 1) == 1) ? c_ : traits_type::eof();
+      }
+
+      std::streamsize xsputn(const char * s_, std::streamsize n_) override
+      {
+        if (startup_log_target != nullptr) {
+          if (startup_log_target->empty() || startup_log_target->back().stream != _stream_) {
+            startup_log_target->push_back(startup_log_chunk{_stream_, std::string()});
+          }
+          startup_log_target->back().text.append(s_, n_);
+          return n_;
+        }
+        std::lock_guard<std::mutex> lock(_mutex_);
+        return _fallback_->sputn(s_, n_);
+      }
+
+      int sync() override
+      {
+        if (startup_log_target != nullptr) {
+          return 0;
+        }
+        std::lock_guard<std::mutex> lock(_mutex_);
+        return _fallback_->pubsync();
+      }
+
+    private:
+
+      std::ostream *   _stream_;   //!< Captured stream
+      std::streambuf * _fallback_; //!< Original stream buffer
+      std::mutex       _mutex_;    //!< Lock on the original stream buffer
+
+    };
+
+    //! \brief Capture of the output of a standard stream in startup logs (scoped)
+    class startup_log_capture
+    {
+    public:
+
+      explicit startup_log_capture(std::ostream & stream_)
+        : _stream_(stream_)
+        , _buffer_(stream_, stream_.rdbuf())
+      {
+        _stream_.rdbuf(&_buffer_);
+        return;
+      }
+
+      ~startup_log_capture()
+      {
+        _stream_.rdbuf(_buffer_.get_fallback());
+        return;
+      }
+
+    private:
+
+      std::ostream &     _stream_; //!< Captured stream
+      startup_log_buffer _buffer_; //!< Capturing stream buffer
+
+    };
+
+  } // end of anonymous namespace
+
   //----------------------------------------------------------------------
   // Public Interface Definitions
   //
@@ -241,6 +355,7 @@ namespace datatools {
     service_entry& sentry = *found->second.get();
     // Copy the config container in the uninitialized service entry for further initialization:
     sentry.set_service_config(config);
+    _fetch_service_dependencies_(sentry);
     return;
   }
 
@@ -286,6 +401,7 @@ namespace datatools {
   void service_manager::initialize(const datatools::properties& config)
   {
     DT_THROW_IF(this->is_initialized(), std::logic_error, "Service manager is already initialized !");
+    DT_STARTUP_PROFILE_SCOPE("service_manager", _name_);
 
     datatools::logger::priority p
       = datatools::logger::extract_logging_configuration(config,
@@ -319,6 +435,13 @@ namespace datatools {
       }
     }
 
+    if (config.has_key("initialization.threads")) {
+      const int nthreads = config.fetch_integer("initialization.threads");
+      DT_THROW_IF(nthreads < 0, std::domain_error,
+                  "Invalid number of initialization threads (" << nthreads << ")!");
+      _initialization_threads_ = (unsigned int) nthreads;
+    }
+
     /*
     // Import services from another manager configuration :
     {
@@ -364,6 +487,11 @@ namespace datatools {
       }
     }
 
+    if (_force_initialization_at_load_) {
+      // Services loaded so far are initialized along their dependencies:
+      this->initialize_services();
+    }
+
     sync();
     _initialized_ = true;
     return;
@@ -407,6 +535,8 @@ namespace datatools {
     _factory_register_.reset();
     _allow_dynamic_services_ = false;
     _force_initialization_at_load_ = false;
+    _initialization_threads_ = 1;
+    _startup_report_.clear();
     _preload_ = true;
     DT_LOG_TRACE(get_logging_priority(),"Exiting.");
     return;
@@ -659,6 +789,273 @@ namespace datatools {
     return _allow_dynamic_services_;
   }
 
+  void service_manager::set_initialization_threads(unsigned int nthreads_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Service manager is already initialized!");
+    _initialization_threads_ = nthreads_;
+    return;
+  }
+
+  unsigned int service_manager::get_initialization_threads() const
+  {
+    return _initialization_threads_;
+  }
+
+  void service_manager::build_dependency_graph(dependency_graph & dg_) const
+  {
+    dg_.reset();
+    for (service_dict_type::const_iterator i = _local_services_.begin();
+         i != _local_services_.end();
+         ++i) {
+      dg_.add_vertex(i->first, "service");
+    }
+    for (service_dict_type::const_iterator i = _local_services_.begin();
+         i != _local_services_.end();
+         ++i) {
+      const service_entry & entry = *i->second.get();
+      for (service_dependency_dict_type::const_iterator j = entry.service_masters.begin();
+           j != entry.service_masters.end();
+           ++j) {
+        if (dg_.has_vertex(j->first)) {
+          dg_.add_out_edge(i->first, j->first, "dependency");
+        }
+      }
+    }
+    return;
+  }
+
+  void service_manager::initialize_services()
+  {
+    DT_LOG_TRACE_ENTERING(get_logging_priority());
+    _startup_report_.clear();
+
+    // Services to be initialized, ordered by name:
+    std::vector<service_entry *> entries;
+    std::map<std::string, std::size_t> indexes;
+    for (service_dict_type::iterator i = _local_services_.begin();
+         i != _local_services_.end();
+         ++i) {
+      service_entry & entry = *i->second.get();
+      if (entry.is_initialized()) continue;
+      indexes[i->first] = entries.size();
+      entries.push_back(&entry);
+    }
+    const std::size_t nentries = entries.size();
+    if (nentries == 0) {
+      DT_LOG_TRACE_EXITING(get_logging_priority());
+      return;
+    }
+
+    // Dependencies between the services to be initialized:
+    std::vector<std::vector<std::size_t> > dependers(nentries);
+    std::vector<std::size_t> npending(nentries, 0);
+    for (std::size_t i = 0; i < nentries; i++) {
+      const service_entry & entry = *entries[i];
+      for (service_dependency_dict_type::const_iterator j = entry.service_masters.begin();
+           j != entry.service_masters.end();
+           ++j) {
+        const std::string & master_name = j->first;
+        if (_local_services_.find(master_name) == _local_services_.end()) {
+          DT_THROW_IF(j->second.level == DEPENDENCY_STRICT, std::logic_error,
+                      "Service '" << entry.get_service_name() << "' depends on missing service '"
+                      << master_name << "'!");
+          continue;
+        }
+        std::map<std::string, std::size_t>::const_iterator found = indexes.find(master_name);
+        if (found == indexes.end()) {
+          // The master service is already initialized:
+          continue;
+        }
+        dependers[found->second].push_back(i);
+        npending[i]++;
+      }
+    }
+
+    // Topological order and depth of the services in the dependency graph:
+    std::vector<std::size_t> order;
+    std::vector<unsigned int> levels(nentries, 0);
+    {
+      std::vector<std::size_t> remaining = npending;
+      for (std::size_t i = 0; i < nentries; i++) {
+        if (remaining[i] == 0) order.push_back(i);
+      }
+      for (std::size_t k = 0; k < order.size(); k++) {
+        const std::size_t i = order[k];
+        for (std::size_t j : dependers[i]) {
+          levels[j] = std::max(levels[j], levels[i] + 1);
+          if (--remaining[j] == 0) order.push_back(j);
+        }
+      }
+      if (order.size() != nentries) {
+        std::ostringstream cycle_oss;
+        for (std::size_t i = 0; i < nentries; i++) {
+          if (remaining[i] == 0) continue;
+          if (!cycle_oss.str().empty()) cycle_oss << ", ";
+          cycle_oss << "'" << entries[i]->get_service_name() << "'";
+        }
+        DT_THROW(std::logic_error, "Dependency cycle between services " << cycle_oss.str() << "!");
+      }
+    }
+
+    unsigned int nthreads = _initialization_threads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    if (nthreads > nentries) {
+      nthreads = (unsigned int) nentries;
+    }
+    DT_LOG_DEBUG(get_logging_priority(),
+                 "Initializing " << nentries << " services with " << nthreads << " thread(s)...");
+
+    typedef std::chrono::steady_clock clock_type;
+    const clock_type::time_point startup_time = clock_type::now();
+    std::vector<startup_record> records(nentries);
+    for (std::size_t i = 0; i < nentries; i++) {
+      records[i].name = entries[i]->get_service_name();
+      records[i].id = entries[i]->get_service_id();
+      records[i].level = levels[i];
+    }
+    // The messages logged while a service is initialized concurrently are buffered in its log:
+    std::vector<startup_log_type> logs(nentries);
+    auto initialize_one = [&](std::size_t i_, startup_log_type * log_) {
+      const clock_type::time_point start_time = clock_type::now();
+      startup_log_target = log_;
+      try {
+        this->initialize_service(*entries[i_]);
+      } catch (...) {
+        startup_log_target = nullptr;
+        throw;
+      }
+      startup_log_target = nullptr;
+      const clock_type::time_point stop_time = clock_type::now();
+      records[i_].start = std::chrono::duration<double>(start_time - startup_time).count();
+      records[i_].duration = std::chrono::duration<double>(stop_time - start_time).count();
+    };
+
+    std::exception_ptr error;
+    if (nthreads <= 1) {
+      try {
+        for (std::size_t i : order) {
+          initialize_one(i, nullptr);
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+    } else {
+      startup_log_capture clog_capture(std::clog);
+      startup_log_capture cerr_capture(std::cerr);
+      // A service is scheduled as soon as all its master services are initialized:
+      std::mutex queue_mutex;
+      std::condition_variable queue_cv;
+      std::deque<std::size_t> ready;
+      std::size_t ndone = 0;
+      for (std::size_t i = 0; i < nentries; i++) {
+        if (npending[i] == 0) ready.push_back(i);
+      }
+      auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        while (true) {
+          while (ready.empty() && !error && ndone < nentries) {
+            queue_cv.wait(lock);
+          }
+          if (error || ndone == nentries) break;
+          const std::size_t i = ready.front();
+          ready.pop_front();
+          lock.unlock();
+          std::exception_ptr local_error;
+          try {
+            initialize_one(i, &logs[i]);
+          } catch (...) {
+            local_error = std::current_exception();
+          }
+          lock.lock();
+          if (local_error) {
+            if (!error) error = local_error;
+            queue_cv.notify_all();
+            break;
+          }
+          ndone++;
+          for (std::size_t j : dependers[i]) {
+            if (--npending[j] == 0) ready.push_back(j);
+          }
+          queue_cv.notify_all();
+        }
+      };
+      std::vector<std::thread> threads;
+      for (unsigned int ithread = 1; ithread < nthreads; ithread++) {
+        threads.push_back(std::thread(worker));
+      }
+      worker();
+      for (std::thread & t : threads) {
+        t.join();
+      }
+    }
+
+    // The report and the buffered messages do not depend on the scheduling of the threads:
+    std::vector<std::size_t> report_order(nentries);
+    for (std::size_t i = 0; i < nentries; i++) {
+      report_order[i] = i;
+    }
+    std::stable_sort(report_order.begin(), report_order.end(),
+                     [&records](std::size_t a_, std::size_t b_) {
+                       return records[a_].level < records[b_].level;
+                     });
+    std::vector<startup_record> sorted_records;
+    sorted_records.reserve(nentries);
+    for (std::size_t i : report_order) {
+      for (const startup_log_chunk & chunk : logs[i]) {
+        // Each message is printed to the stream it was written to:
+        chunk.stream->write(chunk.text.data(), chunk.text.size());
+        records[i].log += chunk.text;
+      }
+      sorted_records.push_back(records[i]);
+    }
+    records.swap(sorted_records);
+    std::clog << std::flush;
+    std::cerr << std::flush;
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    _startup_report_ = records;
+    for (const startup_record & record : _startup_report_) {
+      DT_LOG_DEBUG(get_logging_priority(),
+                   "Service '" << record.name << "' (level " << record.level << ") initialized in "
+                   << record.duration * 1e3 << " ms.");
+    }
+    DT_LOG_TRACE_EXITING(get_logging_priority());
+    return;
+  }
+
+  const std::vector<service_manager::startup_record> & service_manager::get_startup_report() const
+  {
+    return _startup_report_;
+  }
+
+  void service_manager::print_startup_report(std::ostream & out_,
+                                             const std::string & indent_) const
+  {
+    out_ << indent_ << "Service initialization report : ";
+    if (_startup_report_.size() == 0) {
+      out_ << "<none>";
+    }
+    out_ << std::endl;
+    for (std::size_t i = 0; i < _startup_report_.size(); i++) {
+      const startup_record & record = _startup_report_[i];
+      out_ << indent_;
+      if (i + 1 == _startup_report_.size()) {
+        out_ << i_tree_dumpable::last_tag;
+      } else {
+        out_ << i_tree_dumpable::tag;
+      }
+      out_ << "Service '" << record.name << "' "
+           << "(type '" << record.id << "', level " << record.level << ") : "
+           << "start=" << record.start * 1e3 << " ms "
+           << "duration=" << record.duration * 1e3 << " ms"
+           << std::endl;
+    }
+    return;
+  }
+
   void service_manager::tree_dump(std::ostream& out,
                                   const std::string& title,
                                   const std::string& a_indent,
@@ -698,6 +1095,11 @@ namespace datatools {
         << _allow_dynamic_services_
         << std::endl;
 
+    out << indent << i_tree_dumpable::tag
+        << "Initialization threads : "
+        << _initialization_threads_
+        << std::endl;
+
     out << indent << i_tree_dumpable::tag
         << "List of registered services : " << std::endl;
     {
@@ -803,23 +1205,19 @@ namespace datatools {
     }
     this->create_service(new_entry);
     if (config_ptr != nullptr) {
-      std::vector<std::string> strict_dependencies;
-      if (config_ptr->has_key("dependencies.strict")) {
-        config_ptr->fetch("dependencies.strict", strict_dependencies);
-      }
-      for (size_t i = 0; i < strict_dependencies.size(); ++i) {
-        // XXX the_service_entry.service_masters;
-      }
+      _fetch_service_dependencies_(new_entry);
       for (service_dependency_dict_type::const_iterator j
              = new_entry.service_masters.begin();
            j != new_entry.service_masters.end();
            ++j) {
         const std::string& master_service_name = j->first;
         DT_LOG_DEBUG(get_logging_priority(),
-                     "Master '"<< master_service_name << "!");
+                     "Master '"<< master_service_name << "'");
         continue;
       }
-      if (_force_initialization_at_load_) {
+      // Before the manager is initialized, the initialization of services is
+      // postponed in order to follow their dependencies (see initialize_services):
+      if (_force_initialization_at_load_ && is_initialized()) {
         this->initialize_service(new_entry);
       }
     }
@@ -882,17 +1280,51 @@ namespace datatools {
       this->create_service(entry);
     }
 
+    {
+      // Wait for the service being initialized by another thread, if any:
+      std::unique_lock<std::mutex> lock(_init_mutex_);
+      while (!entry.is_initialized()) {
+        std::map<const service_entry *, std::thread::id>::const_iterator found = _initializing_.find(&entry);
+        if (found == _initializing_.end()) break;
+        DT_THROW_IF(found->second == std::this_thread::get_id(), std::logic_error,
+                    "Circular dependency while initializing service '" << entry.get_service_name() << "'!");
+        _init_cv_.wait(lock);
+      }
+      if (entry.is_initialized()) {
+        return;
+      }
+      _initializing_[&entry] = std::this_thread::get_id();
+    }
+
     // If not initialized, do it :
-    if (!entry.is_initialized()) {
+    try {
+      // Master services are initialized first:
+      for (service_dependency_dict_type::const_iterator i = entry.service_masters.begin();
+           i != entry.service_masters.end();
+           ++i) {
+        service_dict_type::iterator found = _local_services_.find(i->first);
+        if (found != _local_services_.end()) {
+          this->initialize_service(*found->second.get());
+        }
+      }
       DT_LOG_DEBUG(get_logging_priority(),
                    "Initializing service named '"
                    << entry.get_service_name()
                    << "'...");
       base_service& the_service = entry.grab_service_handle().grab();
       // the_service.set_name(entry.get_service_name());
+      DT_STARTUP_PROFILE_SCOPE("service", entry.get_service_name());
       the_service.initialize(entry.get_service_config(), _local_services_);
-      entry.update_service_status(service_entry::STATUS_INITIALIZED);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(_init_mutex_);
+      _initializing_.erase(&entry);
+      _init_cv_.notify_all();
+      throw;
     }
+    std::lock_guard<std::mutex> lock(_init_mutex_);
+    entry.update_service_status(service_entry::STATUS_INITIALIZED);
+    _initializing_.erase(&entry);
+    _init_cv_.notify_all();
     return;
   }
 
@@ -948,6 +1380,30 @@ namespace datatools {
     return;
   }
 
+  void service_manager::_fetch_service_dependencies_(service_entry & entry_)
+  {
+    const datatools::properties & config = entry_.get_service_config();
+    if (config.has_key("dependencies.strict")) {
+      std::vector<std::string> strict_dependencies;
+      config.fetch("dependencies.strict", strict_dependencies);
+      for (const std::string & master_name : strict_dependencies) {
+        dependency_info_type & di = entry_.service_masters[master_name];
+        di.level = DEPENDENCY_STRICT;
+      }
+    }
+    if (entry_.is_created()) {
+      // Dependencies published by the service itself:
+      service_dependency_dict_type service_dependencies;
+      entry_.get_service_handle().get().fetch_dependencies(service_dependencies);
+      for (service_dependency_dict_type::const_iterator i = service_dependencies.begin();
+           i != service_dependencies.end();
+           ++i) {
+        entry_.service_masters.insert(*i);
+      }
+    }
+    return;
+  }
+
 }  // end of namespace datatools
 
 /***************
@@ -1055,6 +1511,32 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(::datatools::service_manager,ocd_)
       ;
   }
 
+  {
+    configuration_property_description & cpd = ocd_.add_configuration_property_info();
+    cpd.set_name_pattern("initialization.threads")
+      .set_terse_description("The number of threads used to initialize the services")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_mandatory(false)
+      .set_default_value_integer(1)
+      .set_long_description(
+                            "When the initialization of services at load is forced,   \n"
+                            "the services loaded by the manager are initialized at    \n"
+                            "the end of the manager initialization, after the master  \n"
+                            "services they depend on (see the ``dependencies.strict`` \n"
+                            "property of each service). Independent services are      \n"
+                            "initialized concurrently using this number of threads.   \n"
+                            "A value of 0 means the number of hardware threads.       \n"
+                            "A dependency cycle between services is an error.         \n"
+                            )
+      .add_example("Initialize independent services on 4 threads: ::        \n"
+                   "                                                         \n"
+                   "   force_initialization_at_load : boolean = true         \n"
+                   "   initialization.threads : integer = 4                  \n"
+                   "                                                         \n"
+                   )
+      ;
+  }
+
   ocd_.set_configuration_hints ("The configuration of a ``datatools::service_manager`` object  \n"
                                 "can use the ``datatools::properties`` format. The services    \n"
                                 "objects handled by the manager are themselves defined in a    \n"
@@ -0,0 +1,343 @@
+// startup_profiler.cc
+
+// Ourselves:
+#include <datatools/startup_profiler.h>
+
+// Standard Library:
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+
+// This Project:
+#include <datatools/exception.h>
+#include <datatools/logger.h>
+
+namespace datatools {
+
+  namespace {
+
+    /// Per-thread state of the profiler
+    struct thread_state
+    {
+      int rank = -1;              //!< Rank of the thread
+      std::vector<int> opened;    //!< Stack of the opened spans
+    };
+
+    thread_state & local_state()
+    {
+      static thread_local thread_state _ts;
+      return _ts;
+    }
+
+    void write_json_string(std::ostream & out_, const std::string & str_)
+    {
+      out_ << '"';
+      for (char c : str_) {
+        switch (c) {
+        case '"'  : out_ << "\\\""; break;
+        case '\\' : out_ << "\\\\"; break;
+        case '\n' : out_ << "\\n"; break;
+        case '\t' : out_ << "\\t"; break;
+        case '\r' : out_ << "\\r"; break;
+        default:
+          if ((unsigned char) c < 0x20) {
+            // Other control characters are written as \u00XX escape sequences,
+            // without altering the formatting state of the stream:
+            static const char hex_digits[] = "0123456789abcdef";
+            out_ << "\\u00" << hex_digits[((unsigned char) c) >> 4] << hex_digits[((unsigned char) c) & 0xF];
+          } else {
+            out_ << c;
+          }
+        }
+      }
+      out_ << '"';
+      return;
+    }
+
+  }
+
+  startup_profiler::scope::scope(const char * category_, const std::string & name_)
+  {
+    startup_profiler & sp = startup_profiler::instance();
+    if (sp.is_enabled()) {
+      _index_ = sp.begin_span(category_, name_);
+    }
+    return;
+  }
+
+  startup_profiler::scope::scope(const char * category_, const char * name_)
+  {
+    startup_profiler & sp = startup_profiler::instance();
+    if (sp.is_enabled()) {
+      _index_ = sp.begin_span(category_, name_);
+    }
+    return;
+  }
+
+  startup_profiler::scope::~scope()
+  {
+    if (_index_ >= 0) {
+      startup_profiler::instance().end_span(_index_);
+    }
+    return;
+  }
+
+  // static
+  const std::string & startup_profiler::default_trace_filename()
+  {
+    static const std::string _fn("bayeux_startup_trace.json");
+    return _fn;
+  }
+
+  // static
+  startup_profiler & startup_profiler::instance()
+  {
+    static std::unique_ptr<startup_profiler> _sp(new startup_profiler);
+    return *_sp;
+  }
+
+  startup_profiler::startup_profiler()
+    : _enabled_(false)
+  {
+    _epoch_ = std::chrono::steady_clock::now();
+    _trace_filename_ = default_trace_filename();
+    return;
+  }
+
+  bool startup_profiler::is_enabled() const
+  {
+    return _enabled_.load(std::memory_order_relaxed);
+  }
+
+  void startup_profiler::enable()
+  {
+    _enabled_.store(true);
+    return;
+  }
+
+  void startup_profiler::disable()
+  {
+    _enabled_.store(false);
+    return;
+  }
+
+  bool startup_profiler::enable_from_env()
+  {
+    const char * e = std::getenv("BAYEUX_STARTUP_PROFILE");
+    if (e != nullptr) {
+      const std::string value(e);
+      if (!value.empty() && value != "0") {
+        enable();
+      }
+    }
+    const char * f = std::getenv("BAYEUX_STARTUP_PROFILE_FILE");
+    if (f != nullptr && f[0] != '\0') {
+      set_trace_filename(f);
+    }
+    return is_enabled();
+  }
+
+  void startup_profiler::set_trace_filename(const std::string & filename_)
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    _trace_filename_ = filename_;
+    return;
+  }
+
+  const std::string & startup_profiler::get_trace_filename() const
+  {
+    return _trace_filename_;
+  }
+
+  double startup_profiler::_now_() const
+  {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _epoch_).count();
+  }
+
+  int startup_profiler::begin_span(const char * category_, const std::string & name_)
+  {
+    if (!is_enabled()) return -1;
+    thread_state & ts = local_state();
+    span_record rec;
+    rec.category = category_;
+    rec.name = name_;
+    rec.depth = ts.opened.size();
+    rec.parent = ts.opened.empty() ? -1 : ts.opened.back();
+    int index = -1;
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      if (ts.rank < 0) {
+        ts.rank = _nthreads_++;
+      }
+      rec.thread = ts.rank;
+      rec.start = _now_();
+      index = _spans_.size();
+      _spans_.push_back(rec);
+    }
+    ts.opened.push_back(index);
+    return index;
+  }
+
+  int startup_profiler::begin_span(const char * category_, const char * name_)
+  {
+    if (!is_enabled()) return -1;
+    return begin_span(category_, std::string(name_));
+  }
+
+  void startup_profiler::end_span(int index_)
+  {
+    const double stop = _now_();
+    thread_state & ts = local_state();
+    if (!ts.opened.empty() && ts.opened.back() == index_) {
+      ts.opened.pop_back();
+    }
+    std::lock_guard<std::mutex> lock(_mutex_);
+    // Spans may have been cleared in the meantime:
+    if (index_ >= 0 && index_ < (int) _spans_.size()) {
+      span_record & rec = _spans_[index_];
+      rec.duration = stop - rec.start;
+    }
+    return;
+  }
+
+  std::size_t startup_profiler::get_number_of_spans() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    return _spans_.size();
+  }
+
+  std::vector<startup_profiler::span_record> startup_profiler::get_spans() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    return _spans_;
+  }
+
+  void startup_profiler::clear()
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    _spans_.clear();
+    return;
+  }
+
+  void startup_profiler::write_chrome_trace(std::ostream & out_) const
+  {
+    const std::vector<span_record> spans = get_spans();
+    const double now = _now_();
+    const std::ios_base::fmtflags flags = out_.flags();
+    const std::streamsize precision = out_.precision();
+    out_ << "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < spans.size(); i++) {
+      const span_record & rec = spans[i];
+      const double duration = rec.duration >= 0.0 ? rec.duration : now - rec.start;
+      if (i > 0) out_ << ',';
+      out_ << "\n{\"name\":";
+      write_json_string(out_, rec.name);
+      out_ << ",\"cat\":";
+      write_json_string(out_, rec.category);
+      out_ << std::fixed << std::setprecision(3)
+           << ",\"ph\":\"X\",\"ts\":" << rec.start
+           << ",\"dur\":" << duration
+           << ",\"pid\":1,\"tid\":" << rec.thread << '}';
+    }
+    out_ << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    out_.flags(flags);
+    out_.precision(precision);
+    return;
+  }
+
+  void startup_profiler::write_chrome_trace(const std::string & filename_) const
+  {
+    std::ofstream fout(filename_.c_str());
+    DT_THROW_IF(!fout, std::runtime_error, "Cannot open startup trace file '" << filename_ << "'!");
+    write_chrome_trace(fout);
+    return;
+  }
+
+  void startup_profiler::print_summary(std::ostream & out_, const std::string & indent_) const
+  {
+    const std::vector<span_record> spans = get_spans();
+    const double now = _now_();
+    std::vector<double> durations(spans.size());
+    unsigned int nthreads = 0;
+    for (std::size_t i = 0; i < spans.size(); i++) {
+      durations[i] = spans[i].duration >= 0.0 ? spans[i].duration : now - spans[i].start;
+      nthreads = std::max(nthreads, spans[i].thread + 1);
+    }
+    const std::ios_base::fmtflags flags = out_.flags();
+    const std::streamsize precision = out_.precision();
+    out_ << indent_ << "Startup profile: " << spans.size() << " span(s)" << std::endl;
+    out_ << std::fixed << std::setprecision(3);
+    // Hierarchy of the spans, thread by thread:
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      bool first = true;
+      for (std::size_t i = 0; i < spans.size(); i++) {
+        const span_record & rec = spans[i];
+        if (rec.thread != ithread) continue;
+        if (first) {
+          out_ << indent_ << "Thread #" << ithread << " :" << std::endl;
+          first = false;
+        }
+        out_ << indent_ << "  " << std::setw(10) << durations[i] / 1000.0 << " ms";
+        if (rec.parent >= 0 && durations[rec.parent] > 0.0) {
+          out_ << " (" << std::setw(5) << std::setprecision(1)
+               << 100.0 * durations[i] / durations[rec.parent] << " %)"
+               << std::setprecision(3);
+        } else {
+          out_ << "          ";
+        }
+        out_ << ' ' << std::string(2 * rec.depth, ' ')
+             << '[' << rec.category << "] " << rec.name;
+        if (rec.duration < 0.0) out_ << " (not closed)";
+        out_ << std::endl;
+      }
+    }
+    // Totals per category, excluding the spans nested in a span of the same category:
+    std::map<std::string, std::pair<std::size_t, double> > totals;
+    for (std::size_t i = 0; i < spans.size(); i++) {
+      bool nested = false;
+      for (int p = spans[i].parent; p >= 0; p = spans[p].parent) {
+        if (spans[p].category == spans[i].category) {
+          nested = true;
+          break;
+        }
+      }
+      std::pair<std::size_t, double> & total = totals[spans[i].category];
+      total.first++;
+      if (!nested) total.second += durations[i];
+    }
+    if (!totals.empty()) {
+      out_ << indent_ << "Totals per category :" << std::endl;
+      for (const auto & t : totals) {
+        out_ << indent_ << "  " << std::setw(10) << t.second.second / 1000.0 << " ms"
+             << " [" << t.first << "] in " << t.second.first << " span(s)" << std::endl;
+      }
+    }
+    out_.flags(flags);
+    out_.precision(precision);
+    return;
+  }
+
+  void startup_profiler::report(std::ostream & out_)
+  {
+    if (get_number_of_spans() == 0) return;
+    std::string filename;
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      filename = _trace_filename_;
+    }
+    if (!filename.empty()) {
+      try {
+        write_chrome_trace(filename);
+        out_ << "Startup trace was written in '" << filename << "'." << std::endl;
+      } catch (std::exception & error) {
+        DT_LOG_ERROR(datatools::logger::PRIO_ERROR, error.what());
+      }
+    }
+    print_summary(out_);
+    return;
+  }
+
+} // namespace datatools
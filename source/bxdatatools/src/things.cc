@@ -22,6 +22,13 @@
 // Ourselves:
 #include <datatools/things.h>
 
+// Standard Library:
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
 // Third Party:
 #if DATATOOLS_WITH_REFLECTION == 1
 // - CAMP:
@@ -48,6 +55,129 @@ namespace datatools {
 
   DATATOOLS_SERIALIZATION_IMPLEMENTATION_ADVANCED(things,"datatools::things")
 
+  namespace {
+
+    //! Process-wide table of bank slots
+    //!
+    //! The table is published as an immutable snapshot through an atomic
+    //! pointer, so that lookups do not take any lock. A registration copies
+    //! the current table into a new snapshot. Registrations are rare, so the
+    //! previous snapshots are simply kept alive until the end of the process
+    //! for the readers which may still use them.
+    struct bank_slot_registry
+    {
+      typedef std::unordered_map<std::string, std::size_t> table_type;
+
+      std::mutex mutex; //!< Serialization of the registrations
+      std::vector<std::unique_ptr<const table_type> > tables; //!< Published snapshots
+      std::atomic<const table_type *> current{nullptr};       //!< Current snapshot
+
+      static bank_slot_registry & instance()
+      {
+        static bank_slot_registry _registry;
+        return _registry;
+      }
+
+      bool find(const std::string & name_, std::size_t & slot_) const
+      {
+        const table_type * table = current.load(std::memory_order_acquire);
+        if (table == nullptr) {
+          return false;
+        }
+        table_type::const_iterator found = table->find(name_);
+        if (found == table->end()) {
+          return false;
+        }
+        slot_ = found->second;
+        return true;
+      }
+
+      std::size_t add(const std::string & name_)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        const table_type * table = current.load(std::memory_order_relaxed);
+        if (table != nullptr) {
+          table_type::const_iterator found = table->find(name_);
+          if (found != table->end()) {
+            return found->second;
+          }
+        }
+        std::unique_ptr<table_type> next(table != nullptr ? new table_type(*table) : new table_type);
+        const std::size_t slot = next->size();
+        (*next)[name_] = slot;
+        tables.push_back(std::unique_ptr<const table_type>(next.release()));
+        current.store(tables.back().get(), std::memory_order_release);
+        return slot;
+      }
+    };
+
+  }
+
+  const std::size_t things::INVALID_BANK_SLOT;
+
+  // static
+  std::size_t things::register_bank_slot(const std::string & name_)
+  {
+    DT_THROW_IF(name_.empty(), std::logic_error, "Cannot register a bank with an empty name !");
+    return bank_slot_registry::instance().add(name_);
+  }
+
+  void things::_index_slot_(const std::string & name_, entry_type & entry_)
+  {
+    std::size_t slot = INVALID_BANK_SLOT;
+    if (! bank_slot_registry::instance().find(name_, slot)) {
+      entry_.slot = INVALID_BANK_SLOT;
+      _unindexed_++;
+      return;
+    }
+    if (slot >= _slots_.size()) {
+      _slots_.resize(slot + 1);
+    }
+    entry_.slot = slot;
+    slot_type & s = _slots_[slot];
+    s.entry = &entry_;
+    s.type = &typeid(*entry_.handle);
+    s.object = dynamic_cast<void *>(entry_.handle);
+    return;
+  }
+
+  void things::_unindex_slot_(entry_type & entry_)
+  {
+    if (entry_.slot != INVALID_BANK_SLOT) {
+      _slots_[entry_.slot] = slot_type();
+      entry_.slot = INVALID_BANK_SLOT;
+    } else if (_unindexed_ > 0) {
+      _unindexed_--;
+    }
+    return;
+  }
+
+  void things::_reindex_slots_()
+  {
+    for (slot_type & s : _slots_) {
+      s = slot_type();
+    }
+    _unindexed_ = 0;
+    for (dict_type::iterator i = _things_.begin(); i != _things_.end(); ++i) {
+      if (i->second.handle != 0) {
+        _index_slot_(i->first, i->second);
+      }
+    }
+    return;
+  }
+
+  const things::slot_type * things::_lookup_slot_(const std::string & name_, slot_type & tmp_) const
+  {
+    dict_type::const_iterator found = _things_.find(name_);
+    if (found == _things_.end() || found->second.handle == 0) {
+      return nullptr;
+    }
+    tmp_.entry = const_cast<entry_type *>(&found->second);
+    tmp_.type = &typeid(*found->second.handle);
+    tmp_.object = dynamic_cast<void *>(found->second.handle);
+    return &tmp_;
+  }
+
   //----------------------------------------------------------------------
   // bad_things_cast class
   //
@@ -80,6 +210,7 @@ namespace datatools {
     description = "";
     flags       = 0x0;
     handle      = 0;
+    slot        = INVALID_BANK_SLOT;
     return;
   }
 
@@ -382,9 +513,11 @@ namespace datatools {
     DT_THROW_IF (found != _things_.end(),
                  std::logic_error,
                  "An bank with name '" << a_name << "' is already stored !");
-    _things_[a_name].set_description(a_desc);
-    _things_[a_name].set_const(a_const);
-    _things_[a_name].handle = a_obj;
+    entry_type & new_entry = _things_[a_name];
+    new_entry.set_description(a_desc);
+    new_entry.set_const(a_const);
+    new_entry.handle = a_obj;
+    _index_slot_(a_name, new_entry);
     return;
   }
 
@@ -398,6 +531,7 @@ namespace datatools {
     DT_THROW_IF (found == _things_.end(),
                  std::logic_error,
                  "No bank named '" << a_name << "' !");
+    _unindex_slot_(found->second);
     if (found->second.handle != 0) {
       delete found->second.handle;
       found->second.handle = 0;
@@ -574,6 +708,20 @@ namespace datatools {
       }
     }
     _things_.clear();
+    for (slot_type & s : _slots_) {
+      s = slot_type();
+    }
+    _unindexed_ = 0;
+    return;
+  }
+
+  void things::swap(things & other_)
+  {
+    _name_.swap(other_._name_);
+    _description_.swap(other_._description_);
+    _things_.swap(other_._things_);
+    _slots_.swap(other_._slots_);
+    std::swap(_unindexed_, other_._unindexed_);
     return;
   }
 
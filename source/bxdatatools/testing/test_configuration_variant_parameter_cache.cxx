@@ -0,0 +1,148 @@
+/// \file datatools/test_configuration_variant_parameter_cache.cxx
+
+// Ourselves:
+#include <datatools/configuration/variant_parameter_cache.h>
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+#include <stdexcept>
+
+// This project:
+#include <datatools/datatools.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/clhep_units.h>
+#include <datatools/configuration/io.h>
+#include <datatools/configuration/variant_registry.h>
+#include <datatools/configuration/variant_repository.h>
+#include <datatools/configuration/ui/variant_repository_cli.h>
+
+namespace {
+
+  // Check that the preprocessor and the command line interface agree on the value of a parameter:
+  void check_parameter(const datatools::configuration::variant_preprocessor & vpp_,
+                       const datatools::configuration::variant_repository & vrep_,
+                       const std::string & registry_,
+                       const std::string & path_)
+  {
+    std::string expected;
+    datatools::configuration::ui::variant_repository_cli vrepCli(const_cast<datatools::configuration::variant_repository &>(vrep_));
+    datatools::command::returned_info ri = vrepCli.cmd_get_parameter(registry_, path_, expected);
+    std::string value;
+    datatools::command::returned_info ri2 = vpp_.preprocess_parameter(registry_ + ":" + path_, value);
+    DT_THROW_IF(ri.get_error_code() != ri2.get_error_code(), std::logic_error,
+                "Unmatching error codes for parameter '" << registry_ << ":" << path_ << "'!");
+    DT_THROW_IF(ri.is_success() && value != expected, std::logic_error,
+                "Unmatching value '" << value << "' for parameter '" << registry_ << ":" << path_
+                << "' (expected '" << expected << "')!");
+    std::clog << registry_ << ":" << path_ << " = "
+              << (ri2.is_success() ? value : "<" + ri2.get_error_message() + ">") << std::endl;
+    return;
+  }
+
+}
+
+int main(int argc_, char ** argv_)
+{
+  datatools::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'datatools::configuration::variant_parameter_cache'!" << std::endl;
+
+    datatools::configuration::variant_repository vrep;
+    vrep.set_name("my_experiment");
+    vrep.registration_embedded("${DATATOOLS_TESTING_DIR}/config/test_configuration_variant_registry_manager.conf",
+                               "geometry.VM",
+                               "geometry");
+    datatools::configuration::ui::variant_repository_cli vrepCli(vrep);
+    DT_THROW_IF(vrepCli.cmd_set_parameter("geometry", "has_detector_0", "true").is_failure(),
+                std::logic_error, "Cannot set parameter 'has_detector_0'!");
+    DT_THROW_IF(vrepCli.cmd_set_parameter("geometry", "has_detector_0/if_detector/thickness", "320.4 um").is_failure(),
+                std::logic_error, "Cannot set parameter 'has_detector_0/if_detector/thickness'!");
+
+    datatools::configuration::variant_reporting var_report;
+    vrep.set_reporting(var_report);
+
+    datatools::configuration::variant_preprocessor vpp;
+    vpp.set_repository(vrep);
+    const datatools::configuration::variant_parameter_cache & cache = vrep.get_parameter_cache();
+
+    check_parameter(vpp, vrep, "geometry", "has_detector_0");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0/if_detector/thickness");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0/if_detector/thickness");
+    DT_THROW_IF(cache.get_number_of_entries() != 2, std::logic_error, "Unexpected number of compiled references!");
+    DT_THROW_IF(cache.get_number_of_hits() != 1, std::logic_error, "Memoized value was not used!");
+
+    // A change of the variant parameters invalidates the memoized values:
+    DT_THROW_IF(vrepCli.cmd_set_parameter("geometry", "has_detector_0/if_detector/thickness", "1.5 mm").is_failure(),
+                std::logic_error, "Cannot set parameter 'has_detector_0/if_detector/thickness'!");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0/if_detector/thickness");
+    DT_THROW_IF(vrepCli.cmd_set_parameter("geometry", "has_detector_0", "false").is_failure(),
+                std::logic_error, "Cannot set parameter 'has_detector_0'!");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0/if_detector/thickness");
+    DT_THROW_IF(vrepCli.cmd_set_parameter("geometry", "has_detector_0", "true").is_failure(),
+                std::logic_error, "Cannot set parameter 'has_detector_0'!");
+    check_parameter(vpp, vrep, "geometry", "has_detector_0/if_detector/thickness");
+
+    // Unresolved references are reported the same way:
+    check_parameter(vpp, vrep, "geometry", "no_such_parameter");
+    check_parameter(vpp, vrep, "no_such_registry", "has_detector_0");
+
+    // Unregistration of the registry invalidates the compiled references:
+    {
+      datatools::configuration::variant_repository vrep2;
+      vrep2.registration_embedded("${DATATOOLS_TESTING_DIR}/config/test_configuration_variant_registry_manager.conf",
+                                  "geometry.VM",
+                                  "geometry");
+      datatools::configuration::variant_preprocessor vpp2;
+      vpp2.set_repository(vrep2);
+      check_parameter(vpp2, vrep2, "geometry", "has_detector_0");
+      vrep2.unregistration("geometry");
+      std::string value;
+      DT_THROW_IF(vpp2.preprocess_parameter("geometry:has_detector_0|true", value).is_failure() || value != "true",
+                  std::logic_error, "Default value was not used from an inactive repository!");
+      DT_THROW_IF(vrep2.get_parameter_cache().get_number_of_entries() != 0, std::logic_error,
+                  "Compiled references were not invalidated!");
+    }
+
+    // Timing:
+    const std::size_t nrefs = 100000;
+    datatools::computing_time cli_ct;
+    cli_ct.start();
+    for (std::size_t i = 0; i < nrefs; i++) {
+      std::string value;
+      vrepCli.cmd_get_parameter("geometry", "has_detector_0/if_detector/thickness", value);
+    }
+    cli_ct.stop();
+    vpp.report_statistics("test_configuration_variant_parameter_cache");
+    datatools::computing_time vpp_ct;
+    vpp_ct.start();
+    for (std::size_t i = 0; i < nrefs; i++) {
+      std::string value;
+      vpp.preprocess_parameter("geometry:has_detector_0/if_detector/thickness", value);
+    }
+    vpp_ct.stop();
+    DT_THROW_IF(vpp.get_number_of_parameters() != nrefs, std::logic_error,
+                "Unexpected number of preprocessed parameters!");
+    vpp.report_statistics("test_configuration_variant_parameter_cache.loop");
+    std::clog << "Uncached lookups : " << cli_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+    std::clog << "Cached lookups   : " << vpp_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+    cache.print(std::clog, "Cache: ");
+    var_report.print_report(std::clog);
+    vrep.reset_reporting();
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & error) {
+    DT_LOG_ERROR(datatools::logger::PRIO_ERROR, error.what());
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    DT_LOG_ERROR(datatools::logger::PRIO_ERROR, "Unexpected error !");
+    error_code = EXIT_FAILURE;
+  }
+  datatools::terminate();
+  return error_code;
+}
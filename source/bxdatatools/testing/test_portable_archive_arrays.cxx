@@ -0,0 +1,230 @@
+/* test_portable_archive_arrays.cxx */
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
+
+// This project:
+#include <datatools/archives_list.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/clhep_units.h>
+
+namespace {
+
+  /// A record with arrays of numbers
+  struct record
+  {
+    std::string name;
+    std::vector<double> values;
+    std::vector<int16_t> adc;
+    std::vector<int32_t> samples;
+    std::vector<uint64_t> ids;
+    std::vector<bool> flags;
+    float coefs[5];
+
+    template<class Archive>
+    void serialize(Archive & ar_, const unsigned int /* version_ */)
+    {
+      ar_ & boost::serialization::make_nvp("name", name);
+      ar_ & boost::serialization::make_nvp("values", values);
+      ar_ & boost::serialization::make_nvp("adc", adc);
+      ar_ & boost::serialization::make_nvp("samples", samples);
+      ar_ & boost::serialization::make_nvp("ids", ids);
+      ar_ & boost::serialization::make_nvp("flags", flags);
+      ar_ & boost::serialization::make_nvp("coefs", coefs);
+      return;
+    }
+
+    bool operator==(const record & r_) const
+    {
+      for (int i = 0; i < 5; i++) {
+        if (coefs[i] != r_.coefs[i]) return false;
+      }
+      return name == r_.name && values == r_.values && adc == r_.adc
+        && samples == r_.samples && ids == r_.ids && flags == r_.flags;
+    }
+  };
+
+  void make_record(record & r_, std::size_t n_)
+  {
+    r_.name = "record";
+    r_.values.resize(n_);
+    r_.adc.resize(n_);
+    r_.samples.resize(n_);
+    r_.ids.resize(n_ / 10);
+    r_.flags.resize(7);
+    for (std::size_t i = 0; i < n_; i++) {
+      r_.values[i] = std::sin(0.001 * i) * 1.e3 - 0.5;
+      r_.adc[i] = (int16_t) ((i % 4096) - 2048);
+      r_.samples[i] = (int32_t) (i * 37) - 100000;
+    }
+    for (std::size_t i = 0; i < r_.ids.size(); i++) {
+      r_.ids[i] = 0xFFFFFFFFFFFFull * i;
+    }
+    for (std::size_t i = 0; i < r_.flags.size(); i++) {
+      r_.flags[i] = (i % 3 == 0);
+    }
+    r_.values.push_back(-0.0);
+    r_.values.push_back(std::numeric_limits<double>::infinity());
+    for (int i = 0; i < 5; i++) r_.coefs[i] = 0.25f * i - 1.0f;
+    return;
+  }
+
+  /// Store and load a record, return the size of the archive
+  std::size_t round_trip(const record & in_, unsigned int flags_,
+                         double & save_time_, double & load_time_)
+  {
+    std::stringstream ss;
+    datatools::computing_time save_ct;
+    {
+      save_ct.start();
+      datatools::portable_oarchive oa(ss, flags_);
+      oa << in_;
+      save_ct.stop();
+      DT_THROW_IF(oa.has_array_blocks() == bool(flags_ & boost::archive::no_array_blocks),
+                  std::logic_error, "Unexpected array blocks mode!");
+    }
+    const std::string buffer = ss.str();
+    record out;
+    datatools::computing_time load_ct;
+    {
+      std::istringstream iss(buffer);
+      load_ct.start();
+      datatools::portable_iarchive ia(iss);
+      ia >> out;
+      load_ct.stop();
+      DT_THROW_IF(ia.has_array_blocks() == bool(flags_ & boost::archive::no_array_blocks),
+                  std::logic_error, "Unexpected array blocks mode!");
+    }
+    DT_THROW_IF(!(out == in_), std::logic_error, "Unmatching loaded record!");
+    DT_THROW_IF(out.values.size() > 1 && !std::signbit(out.values[out.values.size() - 2]),
+                std::logic_error, "Lost sign of -0.0!");
+    save_time_ = save_ct.get_last_elapsed_time();
+    load_time_ = load_ct.get_last_elapsed_time();
+    return buffer.size();
+  }
+
+}
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for arrays in portable binary archives." << std::endl;
+
+    record rec;
+    make_record(rec, 1000000);
+
+    double block_save = 0.0, block_load = 0.0;
+    const std::size_t block_size = round_trip(rec, 0, block_save, block_load);
+    double legacy_save = 0.0, legacy_load = 0.0;
+    const std::size_t legacy_size = round_trip(rec, boost::archive::no_array_blocks, legacy_save, legacy_load);
+
+    std::clog << "Array blocks : " << block_size << " bytes, save: "
+              << block_save / CLHEP::millisecond << " ms, load: "
+              << block_load / CLHEP::millisecond << " ms" << std::endl;
+    std::clog << "Legacy format : " << legacy_size << " bytes, save: "
+              << legacy_save / CLHEP::millisecond << " ms, load: "
+              << legacy_load / CLHEP::millisecond << " ms" << std::endl;
+
+    {
+      // Empty arrays:
+      record empty;
+      for (int i = 0; i < 5; i++) empty.coefs[i] = 0.0f;
+      double st, lt;
+      round_trip(empty, 0, st, lt);
+      round_trip(empty, boost::archive::no_array_blocks, st, lt);
+    }
+
+    {
+      // No infinite values in arrays with the no_infnan flag:
+      std::stringstream ss;
+      datatools::portable_oarchive oa(ss, boost::archive::no_infnan);
+      bool thrown = false;
+      try {
+        oa << rec.values;
+      } catch (boost::archive::portable_archive_exception & x) {
+        std::clog << "As expected: " << x.what() << std::endl;
+        thrown = true;
+      }
+      DT_THROW_IF(!thrown, std::logic_error, "Infinite value was stored with the no_infnan flag!");
+    }
+
+    {
+      // Mismatching size of the elements:
+      std::stringstream ss;
+      {
+        datatools::portable_oarchive oa(ss);
+        oa << rec.samples;
+      }
+      bool thrown = false;
+      try {
+        datatools::portable_iarchive ia(ss);
+        std::vector<int64_t> wide;
+        ia >> wide;
+      } catch (boost::archive::portable_archive_exception & x) {
+        std::clog << "As expected: " << x.what() << std::endl;
+        thrown = true;
+      }
+      DT_THROW_IF(!thrown, std::logic_error, "Array with unmatching element size was loaded!");
+    }
+
+    {
+      // The polymorphic oarchive stores arrays element by element:
+      record small;
+      make_record(small, 1000);
+      std::stringstream ss;
+      {
+        boost::archive::polymorphic_portable_oarchive oa(ss);
+        DT_THROW_IF(oa.has_array_blocks(), std::logic_error, "Polymorphic archive with array blocks!");
+        oa << small;
+      }
+      record out;
+      datatools::portable_iarchive ia(ss);
+      DT_THROW_IF(ia.has_array_blocks(), std::logic_error, "Polymorphic archive with array blocks!");
+      ia >> out;
+      DT_THROW_IF(!(out == small), std::logic_error, "Unmatching loaded record!");
+    }
+
+    {
+      // The polymorphic iarchive rejects arrays stored as blocks:
+      std::stringstream ss;
+      {
+        datatools::portable_oarchive oa(ss);
+        oa << rec.samples;
+      }
+      bool thrown = false;
+      try {
+        boost::archive::polymorphic_portable_iarchive ia(ss);
+      } catch (boost::archive::portable_archive_exception & x) {
+        std::clog << "As expected: " << x.what() << std::endl;
+        thrown = true;
+      }
+      DT_THROW_IF(!thrown, std::logic_error, "Array blocks were accepted by the polymorphic archive!");
+    }
+
+    std::clog << "The end." << std::endl;
+  }
+  catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -21,6 +21,8 @@
 #include <string>
 #include <list>
 #include <stdexcept>
+#include <chrono>
+#include <thread>
 
 // This Project:
 #include <datatools/ioutils.h>
@@ -128,11 +130,32 @@ bool test_service::is_initialized() const
 
 // Initialization hook :
 int test_service::initialize(const datatools::properties& a_config,
-                             datatools::service_dict_type& /*a_dictionnary*/)
+                             datatools::service_dict_type& a_dictionnary)
 {
   DT_THROW_IF(is_initialized(), std::logic_error, "Service is already initialized!");
   _common_initialize(a_config);
 
+  // Master services must have been initialized first:
+  if (a_config.has_key("dependencies.strict")) {
+    std::vector<std::string> masters;
+    a_config.fetch("dependencies.strict", masters);
+    for (const std::string & master : masters) {
+      datatools::service_dict_type::const_iterator found = a_dictionnary.find(master);
+      DT_THROW_IF(found == a_dictionnary.end() || !found->second->is_initialized(),
+                  std::logic_error,
+                  "Master service '" << master << "' of service '" << get_name() << "' is not initialized!");
+    }
+  }
+
+  // Simulate a long initialization:
+  if (a_config.has_key("startup_delay")) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(a_config.fetch_integer("startup_delay")));
+  }
+
+  if (a_config.has_key("startup_message")) {
+    std::clog << a_config.fetch_string("startup_message") << std::endl;
+  }
+
   DT_LOG_DEBUG(get_logging_priority(), "Initializing service '" << get_name() << "'...");
 
   if (label_.empty()) {
@@ -364,6 +387,62 @@ int main(int argc_, char ** argv_)
       SM.tree_dump(std::clog, "Service manager (terminated) : ", "");
     }
 
+    {
+      // Independent services are initialized concurrently:
+      datatools::service_manager SM("SM2", "A service manager with concurrent initialization");
+      if (debug) SM.set_logging_priority(datatools::logger::PRIO_DEBUG);
+      SM.set_force_initialization_at_load(true);
+      SM.set_initialization_threads(4);
+      datatools::multi_properties SM_services_config("name", "type");
+      for (const std::string name : {"geometry", "materials", "field", "histograms", "database"}) {
+        SM_services_config.add(name, "test_service");
+        SM_services_config.grab_section(name).store("startup_delay", 100);
+        SM_services_config.grab_section(name).store("startup_message", "Service '" + name + "' is started.");
+      }
+      std::vector<std::string> field_dependencies = {"geometry", "materials"};
+      SM_services_config.grab_section("field").store("dependencies.strict", field_dependencies);
+      SM.load(SM_services_config);
+      DT_THROW_IF(SM.is_initialized("geometry"), std::logic_error, "Service 'geometry' is already initialized!");
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      SM.initialize();
+      const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      SM.print_startup_report(std::clog);
+      std::clog << "Total initialization time : " << elapsed * 1e3 << " ms" << std::endl;
+      const std::vector<datatools::service_manager::startup_record> & report = SM.get_startup_report();
+      DT_THROW_IF(report.size() != 5, std::logic_error, "Invalid startup report!");
+      DT_THROW_IF(report.back().name != "field" || report.back().level != 1,
+                  std::logic_error, "Invalid level for service 'field'!");
+      for (const datatools::service_manager::startup_record & record : report) {
+        DT_THROW_IF(!SM.is_initialized(record.name), std::logic_error,
+                    "Service '" << record.name << "' is not initialized!");
+        // The messages of each service are buffered in its record:
+        DT_THROW_IF(record.log.find("Service '" + record.name + "' is started.\n") == std::string::npos,
+                    std::logic_error,
+                    "Missing startup message in the record of service '" << record.name << "'!");
+      }
+      SM.reset();
+    }
+
+    {
+      // A dependency cycle is detected:
+      datatools::service_manager SM("SM3", "A service manager with a dependency cycle");
+      SM.set_force_initialization_at_load(true);
+      datatools::multi_properties SM_services_config("name", "type");
+      SM_services_config.add("chicken", "test_service");
+      SM_services_config.grab_section("chicken").store("dependencies.strict", std::vector<std::string>(1, "egg"));
+      SM_services_config.add("egg", "test_service");
+      SM_services_config.grab_section("egg").store("dependencies.strict", std::vector<std::string>(1, "chicken"));
+      SM.load(SM_services_config);
+      bool cycle = false;
+      try {
+        SM.initialize();
+      } catch (std::exception & cycle_error) {
+        std::clog << "As expected: " << cycle_error.what() << std::endl;
+        cycle = true;
+      }
+      DT_THROW_IF(!cycle, std::logic_error, "Dependency cycle was not detected!");
+    }
+
   } catch (exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
     error_code = EXIT_FAILURE;
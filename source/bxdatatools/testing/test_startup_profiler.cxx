@@ -0,0 +1,120 @@
+// test_startup_profiler.cxx
+
+// Ourselves:
+#include <datatools/startup_profiler.h>
+
+// Standard Library:
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// This Project:
+#include <datatools/exception.h>
+
+namespace {
+
+  void sleep_ms(int ms_)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms_));
+    return;
+  }
+
+  void load_plugin(const std::string & name_)
+  {
+    DT_STARTUP_PROFILE_SCOPE("plugin", name_);
+    sleep_ms(5);
+    return;
+  }
+
+}
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'datatools::startup_profiler'!" << std::endl;
+    datatools::startup_profiler & sp = datatools::startup_profiler::instance();
+
+    // Nothing is recorded while the profiler is disabled:
+    {
+      DT_STARTUP_PROFILE_SCOPE("kernel", "ignored");
+    }
+    DT_THROW_IF(sp.get_number_of_spans() != 0, std::logic_error, "Unexpected span!");
+
+    sp.enable();
+    {
+      DT_STARTUP_PROFILE_SCOPE("kernel", "application \"startup\"");
+      {
+        DT_STARTUP_PROFILE_SCOPE("config", std::string("control\x01\b\f\x1f\tcharacters"));
+      }
+      {
+        DT_STARTUP_PROFILE_SCOPE("config", "setup.conf");
+        sleep_ms(2);
+      }
+      std::vector<std::thread> threads;
+      for (int i = 0; i < 2; i++) {
+        threads.push_back(std::thread(load_plugin, "libplugin" + std::to_string(i)));
+      }
+      for (std::thread & t : threads) {
+        t.join();
+      }
+      load_plugin("libmain");
+    }
+    sp.disable();
+    {
+      // Spans are no longer recorded at the end of the startup:
+      DT_STARTUP_PROFILE_SCOPE("config", "processing.conf");
+    }
+
+    const std::vector<datatools::startup_profiler::span_record> spans = sp.get_spans();
+    DT_THROW_IF(spans.size() != 6, std::logic_error, "Invalid number of spans!");
+    const datatools::startup_profiler::span_record & top = spans[0];
+    DT_THROW_IF(top.parent != -1 || top.depth != 0, std::logic_error, "Invalid top level span!");
+    unsigned int nchildren = 0;
+    for (std::size_t i = 1; i < spans.size(); i++) {
+      const datatools::startup_profiler::span_record & rec = spans[i];
+      DT_THROW_IF(rec.duration < 0.0, std::logic_error, "Span '" << rec.name << "' is not closed!");
+      DT_THROW_IF(rec.start < top.start || rec.start + rec.duration > top.start + top.duration,
+                  std::logic_error, "Span '" << rec.name << "' is not contained in the top level span!");
+      if (rec.thread == top.thread) {
+        // Spans of the main thread are nested in the top level span:
+        DT_THROW_IF(rec.parent != 0 || rec.depth != 1, std::logic_error, "Invalid nesting of span '" << rec.name << "'!");
+        nchildren++;
+      } else {
+        // Spans of other threads are top level spans of their threads:
+        DT_THROW_IF(rec.parent != -1 || rec.depth != 0, std::logic_error, "Invalid nesting of span '" << rec.name << "'!");
+      }
+    }
+    DT_THROW_IF(nchildren != 3, std::logic_error, "Invalid number of nested spans!");
+
+    std::ostringstream trace;
+    trace << std::setfill('*');
+    sp.write_chrome_trace(trace);
+    DT_THROW_IF(trace.str().find("\"name\":\"control\\u0001\\u0008\\u000c\\u001f\\tcharacters\"") == std::string::npos,
+                std::logic_error, "Invalid escaping of control characters in the Chrome trace!");
+    DT_THROW_IF(trace.fill() != '*', std::logic_error, "The Chrome trace alters the formatting of the stream!");
+    DT_THROW_IF(trace.str().find("\"name\":\"application \\\"startup\\\"\"") == std::string::npos,
+                std::logic_error, "Invalid Chrome trace!");
+    DT_THROW_IF(trace.str().find("\"cat\":\"plugin\"") == std::string::npos,
+                std::logic_error, "Invalid Chrome trace!");
+    std::clog << trace.str();
+    sp.print_summary(std::clog, "[info] ");
+
+    sp.clear();
+    DT_THROW_IF(sp.get_number_of_spans() != 0, std::logic_error, "Spans were not cleared!");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
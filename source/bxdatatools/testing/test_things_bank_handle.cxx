@@ -0,0 +1,160 @@
+// test_things_bank_handle.cxx
+
+// Standard Library:
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// This Project:
+#include <datatools/things.h>
+#include <datatools/properties.h>
+#include <datatools/multi_properties.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/clhep_units.h>
+
+void test_handles();
+void benchmark(int nevents_);
+
+int main (int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'datatools::things::bank_handle'!" << std::endl;
+
+    int nevents = 100000;
+    int iarg = 1;
+    while (iarg < argc_) {
+      std::string arg = argv_[iarg];
+      if (arg == "-n" || arg == "--number-of-events") {
+        nevents = std::stoi(argv_[++iarg]);
+      }
+      iarg++;
+    }
+
+    test_handles();
+    benchmark(nevents);
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what () << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
+
+void test_handles()
+{
+  // A bank added before the registration of its name:
+  datatools::things record;
+  record.add<datatools::properties>("Early").store("value", 1);
+
+  datatools::things::bank_handle<datatools::properties> header_handle("Header");
+  datatools::things::bank_handle<datatools::multi_properties> setup_handle("Setup");
+  datatools::things::bank_handle<datatools::properties> early_handle("Early");
+  datatools::things::bank_handle<datatools::properties> missing_handle("Missing");
+  DT_THROW_IF(!header_handle.is_valid(), std::logic_error, "Invalid handle!");
+  DT_THROW_IF(datatools::things::register_bank_slot("Header") != header_handle.get_slot(),
+              std::logic_error, "Bank slot is not unique!");
+
+  record.add<datatools::properties>("Header").store("run", 42);
+  record.add<datatools::multi_properties>("Setup", "", true);
+
+  DT_THROW_IF(!record.has(header_handle), std::logic_error, "Missing 'Header' bank!");
+  DT_THROW_IF(!record.has(early_handle), std::logic_error, "Missing 'Early' bank!");
+  DT_THROW_IF(record.has(missing_handle), std::logic_error, "Unexpected 'Missing' bank!");
+  DT_THROW_IF(&record.get(header_handle) != &record.get<datatools::properties>("Header"),
+              std::logic_error, "Handle and name accesses differ!");
+  DT_THROW_IF(record.get(header_handle).fetch_integer("run") != 42,
+              std::logic_error, "Invalid 'Header' bank!");
+  DT_THROW_IF(record.get(early_handle).fetch_integer("value") != 1,
+              std::logic_error, "Invalid 'Early' bank!");
+  record.grab(header_handle).store("event", 7);
+  DT_THROW_IF(record.get<datatools::properties>("Header").fetch_integer("event") != 7,
+              std::logic_error, "Invalid mutable access!");
+
+  // Type and constness checks:
+  bool caught = false;
+  try {
+    datatools::things::bank_handle<datatools::properties> wrong_type_handle("Setup");
+    record.get(wrong_type_handle);
+  } catch (datatools::bad_things_cast &) {
+    caught = true;
+  }
+  DT_THROW_IF(!caught, std::logic_error, "Type mismatch has not been detected!");
+  caught = false;
+  try {
+    record.grab(setup_handle);
+  } catch (std::logic_error &) {
+    caught = true;
+  }
+  DT_THROW_IF(!caught, std::logic_error, "Constness has not been checked!");
+
+  // Invalidation:
+  record.remove("Header");
+  DT_THROW_IF(record.has(header_handle), std::logic_error, "Removed bank is still accessible!");
+  datatools::things other;
+  other.add<datatools::properties>("Header");
+  record.swap(other);
+  DT_THROW_IF(!record.has(header_handle), std::logic_error, "Swapped bank is not accessible!");
+  DT_THROW_IF(!other.has(setup_handle), std::logic_error, "Swapped bank is not accessible!");
+  record.clear();
+  DT_THROW_IF(record.has(header_handle), std::logic_error, "Cleared bank is still accessible!");
+  std::clog << "Bank handles: ok" << std::endl;
+  return;
+}
+
+void benchmark(int nevents_)
+{
+  // Names of the banks, as stored by processing modules at initialization:
+  const std::vector<std::string> bank_names = {"Header", "SD", "CD", "TCD", "TTD", "PTD", "Trigger"};
+  const std::string setup_name = "Setup";
+  std::vector<datatools::things::bank_handle<datatools::properties> > handles;
+  for (const std::string & name : bank_names) {
+    handles.push_back(datatools::things::bank_handle<datatools::properties>(name));
+  }
+
+  datatools::things record;
+  datatools::computing_time by_name_ct;
+  datatools::computing_time by_handle_ct;
+  int64_t checksum_by_name = 0;
+  int64_t checksum_by_handle = 0;
+  for (int ievent = 0; ievent < nevents_; ievent++) {
+    record.clear();
+    record.add<datatools::multi_properties>(setup_name);
+    for (const std::string & name : bank_names) {
+      record.add<datatools::properties>(name).store("event", ievent);
+    }
+
+    by_name_ct.start();
+    for (const std::string & name : bank_names) {
+      checksum_by_name += record.get<datatools::properties>(name).size();
+    }
+    by_name_ct.stop();
+
+    by_handle_ct.start();
+    for (const datatools::things::bank_handle<datatools::properties> & h : handles) {
+      checksum_by_handle += record.get(h).size();
+    }
+    by_handle_ct.stop();
+  }
+  DT_THROW_IF(checksum_by_name != checksum_by_handle, std::logic_error,
+              "Handle and name accesses differ!");
+
+  std::clog << "Number of events           : " << nevents_ << std::endl;
+  std::clog << "Bank accesses per event    : " << handles.size() << std::endl;
+  std::clog << "Access by name   (string)  : " << by_name_ct.get_mean_time() / CLHEP::microsecond
+            << " us/event" << std::endl;
+  std::clog << "Access by handle (slot)    : " << by_handle_ct.get_mean_time() / CLHEP::microsecond
+            << " us/event" << std::endl;
+  if (by_handle_ct.get_mean_time() > 0.0) {
+    std::clog << "Speedup : " << by_name_ct.get_mean_time() / by_handle_ct.get_mean_time() << std::endl;
+  }
+  return;
+}
@@ -138,6 +138,7 @@ list(APPEND ${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/service_tools-inl.h
   ${module_include_dir}/${module_name}/smart_filename.h
   ${module_include_dir}/${module_name}/smart_ref.h
+  ${module_include_dir}/${module_name}/startup_profiler.h
   ${module_include_dir}/${module_name}/temporary_files.h
   ${module_include_dir}/${module_name}/things.h
   ${module_include_dir}/${module_name}/things.ipp
@@ -183,6 +184,7 @@ list(APPEND ${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/configuration/variant_record.h
   ${module_include_dir}/${module_name}/configuration/variant_registry.h
   ${module_include_dir}/${module_name}/configuration/variant_repository.h
+  ${module_include_dir}/${module_name}/configuration/variant_parameter_cache.h
   ${module_include_dir}/${module_name}/configuration/variant_service.h
   ${module_include_dir}/${module_name}/configuration/variant_dependency_utils.h
   ${module_include_dir}/${module_name}/configuration/variant_dependency_logic_parsing.h
@@ -299,6 +301,7 @@ ${module_source_dir}/resource.cc
 ${module_source_dir}/service_manager.cc
 ${module_source_dir}/service_tools.cc
 ${module_source_dir}/smart_filename.cc
+${module_source_dir}/startup_profiler.cc
 ${module_source_dir}/temporary_files.cc
 ${module_source_dir}/the_serializable.cc
 ${module_source_dir}/things.cc
@@ -336,6 +339,7 @@ ${module_source_dir}/configuration/variant_physical.cc
 ${module_source_dir}/configuration/variant_record.cc
 ${module_source_dir}/configuration/variant_registry.cc
 ${module_source_dir}/configuration/variant_repository.cc
+${module_source_dir}/configuration/variant_parameter_cache.cc
 ${module_source_dir}/configuration/variant_service.cc
 ${module_source_dir}/configuration/variant_object_info.cc
 ${module_source_dir}/configuration/variant_dependency_logic.cc
@@ -456,6 +460,7 @@ ${module_test_dir}/test_file_include.cxx
 ${module_test_dir}/test_reflection_0.cxx
 ${module_test_dir}/test_enriched_base.cxx
 ${module_test_dir}/test_binary_serialization.cxx
+${module_test_dir}/test_portable_archive_arrays.cxx
 ${module_test_dir}/test_cloneable_2.cxx
 ${module_test_dir}/test_cloneable.cxx
 ${module_test_dir}/test_data_serialization.cxx
@@ -505,12 +510,14 @@ ${module_test_dir}/test_shared_ptr_0.cxx
 ${module_test_dir}/test_shared_ptr_1.cxx
 ${module_test_dir}/test_smart_filename.cxx
 ${module_test_dir}/test_smart_ref.cxx
+${module_test_dir}/test_startup_profiler.cxx
 ${module_test_dir}/test_temp_file.cxx
 ${module_test_dir}/test_things_1.cxx
 ${module_test_dir}/test_things_2.cxx
 ${module_test_dir}/test_things_3.cxx
 ${module_test_dir}/test_things.cxx
 ${module_test_dir}/test_things_macros.cxx
+${module_test_dir}/test_things_bank_handle.cxx
 ${module_test_dir}/test_time_tools.cxx
 ${module_test_dir}/test_tmp.cxx
 ${module_test_dir}/test_tracer.cxx
@@ -537,6 +544,7 @@ ${module_test_dir}/test_configuration_variant_api_0.cxx
 ${module_test_dir}/test_configuration_variant_service.cxx
 ${module_test_dir}/test_configuration_variant_service_2.cxx
 ${module_test_dir}/test_configuration_variant_dependency.cxx
+${module_test_dir}/test_configuration_variant_parameter_cache.cxx
 ${module_test_dir}/test_configuration_parsers.cxx
 ${module_test_dir}/test_i_tree_dump.cxx
 )
@@ -37,6 +37,7 @@
 
 // This project:
 #include <dpp/base_module.h>
+#include <dpp/module_instrumentation.h>
 
 namespace dpp {
 
@@ -79,6 +80,12 @@ namespace dpp {
     /// Data record processing
     process_status process(::datatools::things & /* data_ */) override;
 
+    /// Return the instrumentation of the chained modules
+    const module_instrumentation & get_instrumentation() const;
+
+    /// Return the mutable instrumentation of the chained modules
+    module_instrumentation & grab_instrumentation();
+
     /// Smart print
     void tree_dump(std::ostream      & out_    = std::clog,
                            const std::string & title_  = "",
@@ -88,6 +95,7 @@ namespace dpp {
   protected:
 
     module_list_type _modules_;  //!< The list of data processing modules
+    module_instrumentation _instrumentation_; //!< Per-module statistics
 
     // Macro to automate the registration of the module :
     DPP_MODULE_REGISTRATION_INTERFACE(chain_module)
@@ -42,6 +42,9 @@
 #include <datatools/logger.h>
 #include <datatools/library_loader.h>
 
+// This project:
+#include <dpp/module_instrumentation.h>
+
 namespace dpp {
 
   /// \brief The set of configuration parameters for the data processing pipeline driver
@@ -80,6 +83,9 @@ namespace dpp {
     bool   slice_store_out;
     bool   save_stopped_data_records;
     bool   preserve_existing_files;
+    bool   async_output;                    ///< Flag to write output data records from a dedicated thread
+    bool        instrumentation;           ///< Flag to collect per-module statistics
+    std::string instrumentation_json_file; ///< JSON output file for per-module statistics
 
   };
 
@@ -115,6 +121,9 @@ namespace dpp {
     /// Reset
     void reset();
 
+    /// Return the instrumentation of the processing modules
+    const module_instrumentation & get_instrumentation() const;
+
   private:
 
     // Management:
@@ -131,6 +140,7 @@ namespace dpp {
     std::vector<dpp::base_module*>             _modules_;    ///< Array of data processing module handles
     std::unique_ptr<dpp::output_module>        _sink_;       ///< Output module
     std::unique_ptr<dpp::input_module>         _source_;     ///< Input module
+    module_instrumentation                     _instrumentation_; ///< Per-module statistics
 
   };
 
@@ -85,6 +85,9 @@ namespace dpp {
 
     void store_as_boost_file (const std::string & filename_) const;
 
+    /// Store the histograms in a binary histogram pool file (see mygsl::histogram_pool::store_binary)
+    void store_as_binary_file (const std::string & filename_) const;
+
     void store_as_root_file (const std::string & filename_) const;
 
     void tree_dump (std::ostream & out_         = std::clog,
@@ -108,6 +111,9 @@ namespace dpp {
 
     void _at_reset ();
 
+    /// Remove the private histograms (with a group starting with '__') before export
+    void _remove_private_histograms_ () const;
+
   private:
 
     bool                      _initialized_; /// Initialization flag
@@ -0,0 +1,228 @@
+/// \file dpp/module_instrumentation.h
+/* Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Per-module timing and data record statistics for data processing
+ *   pipelines.
+ *
+ */
+
+#ifndef DPP_MODULE_INSTRUMENTATION_H
+#define DPP_MODULE_INSTRUMENTATION_H 1
+
+// Standard library:
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/i_tree_dump.h>
+
+namespace datatools {
+  class properties;
+  class things;
+}
+
+namespace dpp {
+
+  /// \brief Collector of per-module processing statistics
+  /**
+   *  For each instrumented module, the collector records the number of calls
+   *  to the \a process method, the number of returned status codes of each
+   *  kind, the wall-clock and CPU times spent in the module (sum, min, max
+   *  and a histogram with logarithmic bins) and the variation of the number
+   *  of banks in the data record.
+   *
+   *  When the instrumentation is disabled, the only cost in the processing
+   *  loop is the test of the enabled flag.
+   *
+   *  Configuration:
+   *  @code
+   *  instrumentation.enabled   : boolean = true
+   *  instrumentation.json_file : string as path = "dpp_stats.json"
+   *  @endcode
+   */
+  class module_instrumentation
+    : public datatools::i_tree_dumpable
+  {
+  public:
+
+    /// Number of bins of the time histograms
+    static const std::size_t NUMBER_OF_TIME_BINS = 32;
+
+    /// Upper bound of the first bin of the time histograms (1 microsecond)
+    static const double FIRST_TIME_BIN_UPPER_BOUND;
+
+    typedef std::array<uint64_t, NUMBER_OF_TIME_BINS> time_histogram_type;
+
+    /// \brief Statistics of a single module
+    struct entry
+    {
+      /// Default constructor
+      entry();
+
+      /// Reset the statistics
+      void reset();
+
+      /// Record a call to the module
+      void record(double wall_time_, double cpu_time_, int status_, int bank_delta_);
+
+      /// Return the mean wall-clock time per call
+      double get_mean_wall_time() const;
+
+      /// Return the mean CPU time per call
+      double get_mean_cpu_time() const;
+
+      /// Return the mean variation of the number of banks per call
+      double get_mean_bank_delta() const;
+
+      /// Return the index of the histogram bin associated to a time
+      static std::size_t time_bin(double time_);
+
+      /// Return the lower bound of a histogram bin
+      static double time_bin_lower_bound(std::size_t bin_);
+
+      std::string label;            //!< Label of the module
+      uint64_t calls;               //!< Number of calls
+      uint64_t ok_count;            //!< Number of PROCESS_OK status
+      uint64_t error_count;         //!< Number of status with the PROCESS_ERROR bit
+      uint64_t stop_count;          //!< Number of status with the PROCESS_STOP bit
+      uint64_t fatal_count;         //!< Number of status with the PROCESS_FATAL bit
+      double wall_time_sum;         //!< Cumulated wall-clock time
+      double wall_time_min;         //!< Minimum wall-clock time
+      double wall_time_max;         //!< Maximum wall-clock time
+      double cpu_time_sum;          //!< Cumulated CPU time
+      double cpu_time_min;          //!< Minimum CPU time
+      double cpu_time_max;          //!< Maximum CPU time
+      time_histogram_type wall_time_histogram; //!< Histogram of wall-clock times
+      time_histogram_type cpu_time_histogram;  //!< Histogram of CPU times
+      int64_t bank_delta_sum;       //!< Cumulated variation of the number of banks
+      int bank_delta_min;           //!< Minimum variation of the number of banks
+      int bank_delta_max;           //!< Maximum variation of the number of banks
+    };
+
+    /// \brief Measurement of a single call to a module
+    class probe
+    {
+    public:
+
+      /// Start the measurement
+      void start(const datatools::things & data_);
+
+      /// Stop the measurement and record it in the statistics entry
+      void stop(entry & entry_, int status_, const datatools::things & data_) const;
+
+    private:
+
+      std::chrono::steady_clock::time_point _wall_start_; //!< Start wall-clock time
+      std::clock_t _cpu_start_ = 0; //!< Start CPU clock
+      unsigned int _banks_ = 0;     //!< Start number of banks
+
+    };
+
+    /// Default constructor
+    module_instrumentation();
+
+    /// Destructor
+    ~module_instrumentation() override;
+
+    /// Check if the instrumentation is enabled
+    bool is_enabled() const
+    {
+      return _enabled_;
+    }
+
+    /// Set the enabled flag
+    void set_enabled(bool);
+
+    /// Check if a JSON output file is set
+    bool has_json_file() const;
+
+    /// Set the JSON output file
+    void set_json_file(const std::string &);
+
+    /// Return the JSON output file
+    const std::string & get_json_file() const;
+
+    /// Configure from a set of properties
+    void configure(const datatools::properties & config_,
+                   const std::string & prefix_ = "instrumentation.");
+
+    /// Add a module entry and return its index
+    std::size_t add_entry(const std::string & label_);
+
+    /// Return the number of entries
+    std::size_t get_number_of_entries() const;
+
+    /// Return a statistics entry
+    const entry & get_entry(std::size_t index_) const;
+
+    /// Return a mutable statistics entry
+    entry & grab_entry(std::size_t index_);
+
+    /// Reset the statistics of all entries
+    void reset_statistics();
+
+    /// Remove all entries
+    void clear();
+
+    /// Print a human readable report
+    void print_report(std::ostream & out_,
+                      const std::string & title_ = "",
+                      const std::string & indent_ = "") const;
+
+    /// Export the statistics in JSON format
+    void export_json(std::ostream & out_) const;
+
+    /// Export the statistics in JSON format in the configured file
+    void store_json() const;
+
+    /// Print the report and store the JSON file if any, if some calls were recorded
+    void report(std::ostream & out_, const std::string & title_) const;
+
+    /// Smart print
+    void tree_dump(std::ostream & out_         = std::clog,
+                   const std::string & title_  = "",
+                   const std::string & indent_ = "",
+                   bool inherit_               = false) const override;
+
+  private:
+
+    bool _enabled_ = false;        //!< Enabled flag
+    std::string _json_file_;       //!< JSON output file
+    std::vector<entry> _entries_;  //!< Statistics per module
+
+  };
+
+} // end of namespace dpp
+
+#endif // DPP_MODULE_INSTRUMENTATION_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -32,6 +32,7 @@
 
 // Standard library:
 #include <memory>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
@@ -47,6 +48,25 @@ namespace dpp {
   class io_common;
 
   /// \brief A output data processing module for automated I/O operations
+  /**
+   *  In asynchronous mode, the serialization and writing of data records, as
+   *  well as the opening and closing of output files, are delegated to a
+   *  dedicated writer thread. Each processed data record is moved (not copied)
+   *  into a bounded queue, so that the data record passed to the \a process
+   *  method is left empty; the module must thus be the last one to use the
+   *  data record. The processing thread waits when the queue is full. Metadata
+   *  are collected by the processing thread when an output file is opened, as
+   *  in synchronous mode. An error met by the writer thread is reported by the
+   *  next call to the \a process method as a fatal error, or rethrown by the
+   *  \a reset method if no later data record was processed. ROOT thread
+   *  safety is enabled when some output files use the brio format.
+   *
+   *  Configuration:
+   *  @code
+   *  async.enabled        : boolean = true
+   *  async.queue_capacity : integer = 2
+   *  @endcode
+   */
   class output_module
     : public base_module
   {
@@ -92,6 +112,15 @@ namespace dpp {
     /// Set the flag for preserving existing output file (prevent from file overwriting)
     void set_preserve_existing_output(bool preserve_existing_output);
 
+    /// Set the asynchronous output mode and the capacity of the queue of pending data records
+    void set_async(bool async_, std::size_t queue_capacity_ = 2);
+
+    /// Check the asynchronous output mode
+    bool is_async() const;
+
+    /// Return the capacity of the queue of pending data records in asynchronous output mode
+    std::size_t get_async_queue_capacity() const;
+
     /// Check if an embedded metadata store exists
     bool has_metadata_store() const;
 
@@ -141,14 +170,31 @@ namespace dpp {
     /// Open output file
     base_module::process_status _open_sink_();
 
+    /// Collect metadata to be stored at the beginning of an output file, if any
+    void _collect_metadata_(std::vector<datatools::properties> & metadata_);
+
     /// Process metadata, if any
     void _store_metadata_();
 
+    /// Update counters after the storage of a data record and return true if the current file must be closed
+    bool _update_limits_();
+
+    /// Store a data record in asynchronous mode
+    process_status _store_async_(datatools::things & data_record_);
+
+    /// Stop the asynchronous writer, rethrow a writer error not reported yet
+    void _stop_async_();
+
   private:
 
+    struct async_writer;
+
     bool _preserve_existing_output_ = false; //!< Flag to preserve existing output files
+    bool _async_enabled_ = false; //!< Flag for asynchronous output
+    std::size_t _async_queue_capacity_ = 2; //!< Capacity of the queue of pending data records
     std::unique_ptr<io_common> _common_; //!< Common data structure
     i_data_sink * _sink_ = nullptr; //!< Abstract data writer
+    std::unique_ptr<async_writer> _async_; //!< Asynchronous writer
 
     // Macro to automate the registration of the module :
     DPP_MODULE_REGISTRATION_INTERFACE(output_module)
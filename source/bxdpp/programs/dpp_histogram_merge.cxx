@@ -0,0 +1,234 @@
+/** \file dpp_histogram_merge.cxx
+ *
+ * Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This file is part of Bayeux.
+ *
+ * Bayeux is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Bayeux is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bayeux. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  A program that merges the histogram pools produced by several
+ *  processing jobs (for example by the dpp::histogram_service).
+ *
+ */
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Boost:
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+// - Bayeux:
+#include <bayeux/bayeux.h>
+#include <bayeux/version.h>
+
+// - Bayeux/datatools:
+#include <datatools/logger.h>
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+#include <datatools/time_tools.h>
+#include <datatools/io_factory.h>
+#include <datatools/clhep_units.h>
+
+// - Bayeux/mygsl:
+#include <mygsl/histogram_pool.h>
+
+namespace bpo = boost::program_options;
+
+struct ui {
+
+  //! \brief Application configuration parameters
+  struct app_config_params {
+    //! Logging level
+    std::string                 logging_label = "fatal";
+    datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+    std::vector<std::string>    input_files;   //!< Input histogram pool files
+    std::string                 output_file;   //!< Output histogram pool file
+    unsigned int                nthreads = 0;  //!< Number of merging threads
+    bool                        force = false; //!< Overwrite an existing output file
+  };
+
+  /// Return the application name
+  static std::string app_name();
+
+  /// Print application usage (supported options and arguments)
+  static void app_print_usage(std::ostream & out_,
+                              const bpo::options_description & desc_);
+
+  /// Print application version
+  static void app_version(std::ostream & out_);
+
+  /// Build options
+  static void app_build_opts(boost::program_options::options_description & desc_,
+                             app_config_params & params_);
+
+};
+
+int main(int argc_, char ** argv_)
+{
+  bayeux::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  ui::app_config_params params;
+
+  try {
+    bpo::options_description optDesc("Options");
+    ui::app_build_opts(optDesc, params);
+
+    bpo::positional_options_description args;
+    args.add("input-file", -1);
+
+    bpo::variables_map vMap;
+    bpo::store(bpo::command_line_parser(argc_, argv_)
+               .options(optDesc)
+               .positional(args)
+               .run(), vMap);
+    bpo::notify(vMap);
+
+    if (vMap.count("help") && vMap["help"].as<bool>()) {
+      ui::app_print_usage(std::cout, optDesc);
+      error_code = -1;
+    }
+
+    if (vMap.count("version") && vMap["version"].as<bool>()) {
+      ui::app_version(std::cout);
+      error_code = -1;
+    }
+
+    if (error_code == EXIT_SUCCESS) {
+      if (vMap.count("logging")) {
+        params.logging_label = vMap["logging"].as<std::string>();
+        params.logging = datatools::logger::get_priority(params.logging_label);
+        DT_THROW_IF(params.logging == datatools::logger::PRIO_UNDEFINED, std::logic_error,
+                    "Invalid logging priority '" << params.logging_label << "' !");
+      }
+      DT_THROW_IF(params.input_files.empty(), std::logic_error, "Missing input files !");
+      DT_THROW_IF(params.output_file.empty(), std::logic_error, "Missing output file !");
+      for (size_t i = 0; i < params.input_files.size(); i++) {
+        datatools::fetch_path_with_env(params.input_files[i]);
+      }
+      std::string output_file = params.output_file;
+      datatools::fetch_path_with_env(output_file);
+      DT_THROW_IF(!params.force && boost::filesystem::exists(output_file), std::runtime_error,
+                  "Output file '" << output_file << "' already exists !");
+
+      // Merge the input histogram pools:
+      datatools::computing_time merge_ct;
+      merge_ct.start();
+      mygsl::histogram_pool pool;
+      pool.merge_files(params.input_files, params.nthreads);
+      merge_ct.stop();
+      DT_LOG_NOTICE(params.logging, "Merged " << params.input_files.size() << " files with "
+                    << pool.size() << " histograms in "
+                    << merge_ct.get_last_elapsed_time() / CLHEP::second << " s");
+      if (datatools::logger::is_debug(params.logging)) {
+        pool.tree_dump(std::clog, "Merged histogram pool: ", "[debug]: ");
+      }
+
+      // Store the merged histogram pool:
+      if (boost::filesystem::path(output_file).extension() == mygsl::histogram_pool::binary_file_extension()) {
+        pool.store_binary(output_file);
+      } else {
+        datatools::data_writer writer(output_file,
+                                      datatools::using_multi_archives,
+                                      datatools::no_append_mode);
+        writer.store(pool);
+      }
+      DT_LOG_NOTICE(params.logging, "Merged histograms stored in '" << output_file << "'");
+    }
+
+  } catch (const std::exception & x) {
+    DT_LOG_FATAL(params.logging, ui::app_name() << ": " << x.what ());
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    DT_LOG_FATAL(params.logging, ui::app_name() << ": " << "Unexpected error !");
+    error_code = EXIT_FAILURE;
+  }
+
+  bayeux::terminate();
+  return error_code;
+}
+
+// Definitions:
+
+std::string ui::app_name()
+{
+  return "bxdpp_histogram_merge";
+}
+
+void ui::app_version(std::ostream & out_)
+{
+  out_ << app_name() << " " << BAYEUX_LIB_VERSION << std::endl;
+  return;
+}
+
+void ui::app_print_usage(std::ostream & out_, const bpo::options_description & opts_)
+{
+  out_ << app_name() << " -- Merge histogram pool files" << std::endl;
+  out_ << "Usage : " << std::endl;
+  out_ << "  " << app_name() << " [options] [input files]" << std::endl;
+  out_ << opts_ << std::endl;
+  out_ << "Input files are binary histogram pool files (with extension '"
+       << mygsl::histogram_pool::binary_file_extension() << "')" << std::endl;
+  out_ << "or datatools Boost/archive files. Histograms with the same name" << std::endl;
+  out_ << "must share the same binning. The output format is deduced from" << std::endl;
+  out_ << "the extension of the output file." << std::endl;
+  out_ << std::endl;
+  out_ << "Example : " << std::endl;
+  out_ << std::endl;
+  out_ << "  $ " << app_name() << "  \\" << std::endl;
+  out_ << "          -j 4                  \\" << std::endl;
+  out_ << "          -o histos.hpool       \\" << std::endl;
+  out_ << "          histos_job*.hpool       " << std::endl;
+  out_ << std::endl;
+  return;
+}
+
+void ui::app_build_opts(boost::program_options::options_description & opts_,
+                        app_config_params & params_)
+{
+  opts_.add_options()
+    ("help,h", bpo::value<bool>()
+     ->zero_tokens()
+     ->default_value(false),
+     "produce help message.")
+    ("version", bpo::value<bool>()
+     ->zero_tokens()
+     ->default_value(false),
+     "print version number then exit.")
+    ("logging,P",
+     bpo::value<std::string>()->default_value("fatal"),
+     "set the logging priority.")
+    ("input-file,i",
+     bpo::value<std::vector<std::string> >(&params_.input_files),
+     "add an input histogram pool file.")
+    ("output-file,o",
+     bpo::value<std::string>(&params_.output_file),
+     "set the output histogram pool file.")
+    ("threads,j",
+     bpo::value<unsigned int>(&params_.nthreads)->default_value(0),
+     "set the number of merging threads (0: number of hardware threads).")
+    ("force,f",
+     bpo::value<bool>(&params_.force)->zero_tokens()->default_value(false),
+     "overwrite an existing output file.")
+    ;
+  return;
+}
@@ -378,6 +378,9 @@ void ui::app_build_driver_opts(boost::program_options::options_description & opt
     ("preserve-existing-files,x",
      bpo::value<bool>(&params_.preserve_existing_files)->zero_tokens()->default_value(false),
      "preserve existing files (recommended).")
+    ("async-output",
+     bpo::value<bool>(&params_.async_output)->zero_tokens()->default_value(false),
+     "write output data records from a dedicated thread.")
     ("max-records-per-output-file,O",
      bpo::value<int>(&params_.max_records_per_output_file)->default_value(0),
      "set the maximum number of data records per output file.")
@@ -393,6 +396,12 @@ void ui::app_build_driver_opts(boost::program_options::options_description & opt
     ("slice-store-out,T",
      bpo::value<bool>(&params_.slice_store_out)->zero_tokens()->default_value(false),
      "set the flag to store only the sliced data records.")
+    ("instrumentation,I",
+     bpo::value<bool>(&params_.instrumentation)->zero_tokens()->default_value(false),
+     "collect and report per-module timing and data record statistics.")
+    ("instrumentation-json-file",
+     bpo::value<std::string>(&params_.instrumentation_json_file),
+     "set the JSON file where per-module statistics are stored (implies --instrumentation).")
     ;
   return;
 }
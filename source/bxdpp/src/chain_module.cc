@@ -68,6 +68,7 @@ namespace dpp {
     e.label = a_label;
     e.handle = a_handle_module;
     _modules_.push_back (e);
+    _instrumentation_.add_entry (a_label);
     return;
   }
 
@@ -95,6 +96,9 @@ namespace dpp {
 
     _common_initialize(a_config);
 
+    // Optional per-module timing and data record statistics:
+    _instrumentation_.configure(a_config);
+
     std::vector<std::string> modules;
     if (a_config.has_key ("modules")) {
       a_config.fetch ("modules", modules);
@@ -127,7 +131,14 @@ namespace dpp {
     DT_THROW_IF(! is_initialized (),
                 std::logic_error,
                 "Chain module '" << get_name () << "' is not initialized !");
+    if (_instrumentation_.is_enabled ()) {
+      _instrumentation_.report (std::clog,
+                                "Instrumentation report for chain module '" + get_name () + "' : ");
+    }
     _modules_.clear ();
+    _instrumentation_.clear ();
+    _instrumentation_.set_enabled (false);
+    _instrumentation_.set_json_file ("");
     _set_initialized (false);
     return;
   }
@@ -144,9 +155,11 @@ namespace dpp {
     // Loop on the chain of processing modules :
     DT_LOG_DEBUG(_logging,
                  "Number of chained modules is " << _modules_.size());
+    const bool instrumented = _instrumentation_.is_enabled ();
+    std::size_t module_index = 0;
     for (module_list_type::iterator i = _modules_.begin ();
          i != _modules_.end ();
-         ++i) {
+         ++i, ++module_index) {
       module_entry & the_entry = *i;
       const std::string & module_name = the_entry.label;
       DT_LOG_DEBUG(_logging,"Processing chained module '" << module_name << "'...");
@@ -156,8 +169,15 @@ namespace dpp {
                   "Handle has no module '" << module_name << "' !");
       base_module & a_module = the_handle.grab ();
       a_module.reset_last_error_message ();
+      module_instrumentation::probe the_probe;
+      if (instrumented) {
+        the_probe.start (the_data_record);
+      }
       try {
         process_status status = a_module.process(the_data_record);
+        if (instrumented) {
+          the_probe.stop (_instrumentation_.grab_entry (module_index), status, the_data_record);
+        }
         DT_LOG_DEBUG(_logging,"Module='" << module_name << "' " << "status=" << status);
         if (status & PROCESS_FATAL || status & PROCESS_ERROR) {
           // Ask for the abortion of the full event record processing session
@@ -178,6 +198,9 @@ namespace dpp {
         //return status;
       }
       catch (std::exception & x) {
+        if (instrumented) {
+          the_probe.stop (_instrumentation_.grab_entry (module_index), PROCESS_FATAL, the_data_record);
+        }
         std::ostringstream errmsg;
         errmsg << "Module '" << module_name << "' failed to process event record; message is '"
                << x.what () << "'";
@@ -189,12 +212,24 @@ namespace dpp {
     return PROCESS_SUCCESS;
   }
 
+  const module_instrumentation & chain_module::get_instrumentation () const
+  {
+    return _instrumentation_;
+  }
+
+  module_instrumentation & chain_module::grab_instrumentation ()
+  {
+    return _instrumentation_;
+  }
+
   void chain_module::tree_dump (std::ostream & a_out ,
                                 const std::string & a_title,
                                 const std::string & a_indent,
                                 bool a_inherit) const
   {
     this->base_module::tree_dump (a_out, a_title, a_indent, true);
+    a_out << a_indent << datatools::i_tree_dumpable::tag
+          << "Instrumentation : " << (_instrumentation_.is_enabled () ? "<enabled>" : "<disabled>") << std::endl;
     a_out << a_indent << datatools::i_tree_dumpable::inherit_tag (a_inherit)
           << "Chained modules : " << std::endl;
     for (module_list_type::const_iterator i = _modules_.begin ();
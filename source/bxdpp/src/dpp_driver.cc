@@ -68,6 +68,9 @@ namespace dpp {
     slice_store_out = false;
     save_stopped_data_records = false;
     preserve_existing_files = false;
+    async_output = false;
+    instrumentation = false;
+    instrumentation_json_file.clear();
     return;
   }
 
@@ -123,8 +126,14 @@ namespace dpp {
          << std::boolalpha << slice_store_out << "" << std::endl;
     out_ << indent << datatools::i_tree_dumpable::tag << "save_stopped_data_records  : "
          << std::boolalpha << save_stopped_data_records << "" << std::endl;
-    out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_) << "preserve_existing_files  : "
+    out_ << indent << datatools::i_tree_dumpable::tag << "preserve_existing_files  : "
          << std::boolalpha << preserve_existing_files << "" << std::endl;
+    out_ << indent << datatools::i_tree_dumpable::tag << "async_output  : "
+         << std::boolalpha << async_output << "" << std::endl;
+    out_ << indent << datatools::i_tree_dumpable::tag << "instrumentation  : "
+         << std::boolalpha << instrumentation << "" << std::endl;
+    out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_) << "instrumentation_json_file  : '"
+         << instrumentation_json_file << "'" << std::endl;
     return;
   }
 
@@ -252,12 +261,16 @@ namespace dpp {
       DT_LOG_NOTICE(_logging_, "Found module named '" << module_name << "'");
       dpp::base_module & the_module =_module_mgr_->grab(module_name);
       _modules_.push_back(&the_module);
+      _instrumentation_.add_entry(module_name);
       DT_LOG_NOTICE(_logging_, "Added module : ");
       if (_logging_ >= datatools::logger::PRIO_NOTICE) {
         the_module.tree_dump(std::clog, "", "[notice]: ");
       }
     }
 
+    _instrumentation_.set_enabled(_params_.instrumentation || ! _params_.instrumentation_json_file.empty());
+    _instrumentation_.set_json_file(_params_.instrumentation_json_file);
+
     // Setup the data output sink :
     if (_params_.output_files.size() > 0) {
       _sink_.reset(new dpp::output_module(_logging_));
@@ -268,6 +281,9 @@ namespace dpp {
       if (_params_.preserve_existing_files) {
         sink_config.store_flag("preserve_existing_files");
       }
+      if (_params_.async_output) {
+        sink_config.store_boolean("async.enabled", true);
+      }
       sink_config.store("name", "data_output_sink");
       sink_config.store("files.mode", "list");
       sink_config.store("files.list.filenames", _params_.output_files);
@@ -354,6 +370,13 @@ namespace dpp {
       _source_.reset();
     }
 
+    if (_instrumentation_.is_enabled()) {
+      _instrumentation_.report(std::clog, "Instrumentation report for the processing modules : ");
+    }
+    _instrumentation_.clear();
+    _instrumentation_.set_enabled(false);
+    _instrumentation_.set_json_file("");
+
     if (_modules_.size()) {
       _modules_.clear();
     }
@@ -368,6 +391,11 @@ namespace dpp {
     return;
   }
 
+  const module_instrumentation & dpp_driver::get_instrumentation() const
+  {
+    return _instrumentation_;
+  }
+
   void dpp_driver::run()
   {
     int error_code = EXIT_SUCCESS;
@@ -384,6 +412,7 @@ namespace dpp {
     int record_counter = 0;
     int processed_counter = 0;
     int stored_counter = 0;
+    const bool instrumented = _instrumentation_.is_enabled();
     while (true) {
       bool do_break_record_loop = false;
       DT_LOG_DEBUG(logging, "Clear the working data record object...");
@@ -436,11 +465,19 @@ namespace dpp {
         processed_counter++;
         // Process the data record using the choosen processing module :
         DT_LOG_DEBUG(logging, "Processing the data record...");
+        std::size_t module_index = 0;
+        module_instrumentation::probe the_probe;
         try {
-          BOOST_FOREACH(dpp::base_module * active_module_ptr, _modules_) {
-            dpp::base_module & the_active_module = *active_module_ptr;
+          for (; module_index < _modules_.size(); module_index++) {
+            dpp::base_module & the_active_module = *_modules_[module_index];
             DT_LOG_DEBUG(logging, "Module name '" << the_active_module.get_name() << "'");
+            if (instrumented) {
+              the_probe.start(DR);
+            }
             processing_status = the_active_module.process(DR);
+            if (instrumented) {
+              the_probe.stop(_instrumentation_.grab_entry(module_index), processing_status, DR);
+            }
             DT_LOG_DEBUG(logging, "Processing status : " << processing_status);
             if (processing_status & dpp::base_module::PROCESS_FATAL) {
               // A fatal error has been met, we break the processing loop :
@@ -464,8 +501,11 @@ namespace dpp {
             if (do_break_record_loop) {
               break;
             }
-          } // BOOST_FOREACH
+          } // for loop on modules
         } catch (std::exception & x) {
+          if (instrumented && module_index < _modules_.size()) {
+            the_probe.stop(_instrumentation_.grab_entry(module_index), dpp::base_module::PROCESS_FATAL, DR);
+          }
           DT_LOG_ERROR(logging, "Caught exception " << x.what());
           throw x;
         }
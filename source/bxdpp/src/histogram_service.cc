@@ -158,6 +158,28 @@ namespace dpp {
   void histogram_service::store_as_boost_file(const std::string & filename_) const
   {
     DT_LOG_NOTICE(get_logging_priority(), "Exporting histograms to Boost file '" << filename_ << "'...");
+    _remove_private_histograms_();
+    std::string fn = filename_;
+    datatools::fetch_path_with_env(fn);
+    datatools::data_writer writer(fn,
+                                  datatools::using_multi_archives,
+                                  datatools::no_append_mode);
+    writer.store(_pool_);
+    return;
+  }
+
+  void histogram_service::store_as_binary_file(const std::string & filename_) const
+  {
+    DT_LOG_NOTICE(get_logging_priority(), "Exporting histograms to binary file '" << filename_ << "'...");
+    _remove_private_histograms_();
+    std::string fn = filename_;
+    datatools::fetch_path_with_env(fn);
+    _pool_.store_binary(fn);
+    return;
+  }
+
+  void histogram_service::_remove_private_histograms_() const
+  {
     DT_LOG_DEBUG(get_logging_priority(), "Cleaning histogram templates");
     std::vector<std::string> histo_names;
     _pool_.names(histo_names);
@@ -173,12 +195,6 @@ namespace dpp {
         pool->remove(hname);
       }
     }
-    std::string fn = filename_;
-    datatools::fetch_path_with_env(fn);
-    datatools::data_writer writer(fn,
-                                  datatools::using_multi_archives,
-                                  datatools::no_append_mode);
-    writer.store(_pool_);
     return;
   }
 
@@ -530,6 +546,8 @@ namespace dpp {
       boost::filesystem::path pth(fn);
       if(pth.extension() == ".root") {
         store_as_root_file(fn);
+      } else if(pth.extension() == mygsl::histogram_pool::binary_file_extension()) {
+        store_as_binary_file(fn);
       } else if(pth.extension() == ".brio") {
         DT_LOG_ERROR(get_logging_priority(),"BRIO format is not supported !");
       } else if(pth.extension() == ".trio") {
@@ -622,6 +640,8 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(::dpp::histogram_service,ocd_)
                             " * ROOT(with extension '.root')                               \n"
                             " * BRIO(with extension '.brio')                               \n"
                             " * TRIO(with extension '.trio')                               \n"
+                            " * mygsl binary histogram pool(with extension '.hpool'),      \n"
+                            "   mergeable with the 'bxdpp_histogram_merge' program         \n"
                             " * datatools Boost/archive :                                   \n"
                             "   - text  (with extension '.txt' or '.txt.gz')               \n"
                             "   - XML   (with extension '.xml' or '.xml.gz')               \n"
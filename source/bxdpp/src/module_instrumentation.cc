@@ -0,0 +1,448 @@
+/* module_instrumentation.cc
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Ourselves:
+#include <dpp/module_instrumentation.h>
+
+// Standard Library:
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// Third Party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/things.h>
+#include <datatools/utils.h>
+
+// This project:
+#include <dpp/base_module.h>
+
+namespace dpp {
+
+  const std::size_t module_instrumentation::NUMBER_OF_TIME_BINS;
+
+  const double module_instrumentation::FIRST_TIME_BIN_UPPER_BOUND = 1.0 * CLHEP::microsecond;
+
+  // static
+  std::size_t module_instrumentation::entry::time_bin(double time_)
+  {
+    // Bin 0 : [0, 1 us[, bin k : [2^(k-1), 2^k us[, last bin is an overflow bin:
+    if (!(time_ >= FIRST_TIME_BIN_UPPER_BOUND)) {
+      return 0;
+    }
+    int exponent = 0;
+    std::frexp(time_ / FIRST_TIME_BIN_UPPER_BOUND, &exponent);
+    std::size_t bin = (std::size_t) exponent;
+    if (bin >= NUMBER_OF_TIME_BINS) {
+      bin = NUMBER_OF_TIME_BINS - 1;
+    }
+    return bin;
+  }
+
+  // static
+  double module_instrumentation::entry::time_bin_lower_bound(std::size_t bin_)
+  {
+    if (bin_ == 0) {
+      return 0.0;
+    }
+    return std::ldexp(FIRST_TIME_BIN_UPPER_BOUND, (int) bin_ - 1);
+  }
+
+  module_instrumentation::entry::entry()
+  {
+    reset();
+    return;
+  }
+
+  void module_instrumentation::entry::reset()
+  {
+    calls = 0;
+    ok_count = 0;
+    error_count = 0;
+    stop_count = 0;
+    fatal_count = 0;
+    wall_time_sum = 0.0;
+    wall_time_min = std::numeric_limits<double>::infinity();
+    wall_time_max = 0.0;
+    cpu_time_sum = 0.0;
+    cpu_time_min = std::numeric_limits<double>::infinity();
+    cpu_time_max = 0.0;
+    wall_time_histogram.fill(0);
+    cpu_time_histogram.fill(0);
+    bank_delta_sum = 0;
+    bank_delta_min = std::numeric_limits<int>::max();
+    bank_delta_max = std::numeric_limits<int>::min();
+    return;
+  }
+
+  void module_instrumentation::entry::record(double wall_time_,
+                                             double cpu_time_,
+                                             int status_,
+                                             int bank_delta_)
+  {
+    calls++;
+    if (status_ == base_module::PROCESS_OK) {
+      ok_count++;
+    }
+    if (status_ & base_module::PROCESS_ERROR) {
+      error_count++;
+    }
+    if (status_ & base_module::PROCESS_STOP) {
+      stop_count++;
+    }
+    if (status_ & base_module::PROCESS_FATAL) {
+      fatal_count++;
+    }
+    wall_time_sum += wall_time_;
+    if (wall_time_ < wall_time_min) wall_time_min = wall_time_;
+    if (wall_time_ > wall_time_max) wall_time_max = wall_time_;
+    wall_time_histogram[time_bin(wall_time_)]++;
+    cpu_time_sum += cpu_time_;
+    if (cpu_time_ < cpu_time_min) cpu_time_min = cpu_time_;
+    if (cpu_time_ > cpu_time_max) cpu_time_max = cpu_time_;
+    cpu_time_histogram[time_bin(cpu_time_)]++;
+    bank_delta_sum += bank_delta_;
+    if (bank_delta_ < bank_delta_min) bank_delta_min = bank_delta_;
+    if (bank_delta_ > bank_delta_max) bank_delta_max = bank_delta_;
+    return;
+  }
+
+  double module_instrumentation::entry::get_mean_wall_time() const
+  {
+    return calls > 0 ? wall_time_sum / calls : 0.0;
+  }
+
+  double module_instrumentation::entry::get_mean_cpu_time() const
+  {
+    return calls > 0 ? cpu_time_sum / calls : 0.0;
+  }
+
+  double module_instrumentation::entry::get_mean_bank_delta() const
+  {
+    return calls > 0 ? (double) bank_delta_sum / calls : 0.0;
+  }
+
+  void module_instrumentation::probe::start(const datatools::things & data_)
+  {
+    _banks_ = data_.size();
+    _cpu_start_ = std::clock();
+    _wall_start_ = std::chrono::steady_clock::now();
+    return;
+  }
+
+  void module_instrumentation::probe::stop(entry & entry_,
+                                           int status_,
+                                           const datatools::things & data_) const
+  {
+    const std::chrono::steady_clock::time_point wall_stop = std::chrono::steady_clock::now();
+    const std::clock_t cpu_stop = std::clock();
+    const double wall_time
+      = std::chrono::duration<double>(wall_stop - _wall_start_).count() * CLHEP::second;
+    const double cpu_time
+      = (double) (cpu_stop - _cpu_start_) / CLOCKS_PER_SEC * CLHEP::second;
+    const int bank_delta = (int) data_.size() - (int) _banks_;
+    entry_.record(wall_time, cpu_time, status_, bank_delta);
+    return;
+  }
+
+  module_instrumentation::module_instrumentation()
+  {
+    return;
+  }
+
+  module_instrumentation::~module_instrumentation()
+  {
+    return;
+  }
+
+  void module_instrumentation::set_enabled(bool enabled_)
+  {
+    _enabled_ = enabled_;
+    return;
+  }
+
+  bool module_instrumentation::has_json_file() const
+  {
+    return !_json_file_.empty();
+  }
+
+  void module_instrumentation::set_json_file(const std::string & json_file_)
+  {
+    _json_file_ = json_file_;
+    return;
+  }
+
+  const std::string & module_instrumentation::get_json_file() const
+  {
+    return _json_file_;
+  }
+
+  void module_instrumentation::configure(const datatools::properties & config_,
+                                         const std::string & prefix_)
+  {
+    if (config_.has_key(prefix_ + "enabled")) {
+      set_enabled(config_.fetch_boolean(prefix_ + "enabled"));
+    }
+    if (config_.has_key(prefix_ + "json_file")) {
+      set_json_file(config_.fetch_path(prefix_ + "json_file"));
+    }
+    return;
+  }
+
+  std::size_t module_instrumentation::add_entry(const std::string & label_)
+  {
+    entry e;
+    e.label = label_;
+    _entries_.push_back(e);
+    return _entries_.size() - 1;
+  }
+
+  std::size_t module_instrumentation::get_number_of_entries() const
+  {
+    return _entries_.size();
+  }
+
+  const module_instrumentation::entry &
+  module_instrumentation::get_entry(std::size_t index_) const
+  {
+    DT_THROW_IF(index_ >= _entries_.size(), std::range_error,
+                "Invalid instrumentation entry index [" << index_ << "]!");
+    return _entries_[index_];
+  }
+
+  module_instrumentation::entry &
+  module_instrumentation::grab_entry(std::size_t index_)
+  {
+    DT_THROW_IF(index_ >= _entries_.size(), std::range_error,
+                "Invalid instrumentation entry index [" << index_ << "]!");
+    return _entries_[index_];
+  }
+
+  void module_instrumentation::reset_statistics()
+  {
+    for (entry & e : _entries_) {
+      e.reset();
+    }
+    return;
+  }
+
+  void module_instrumentation::clear()
+  {
+    _entries_.clear();
+    return;
+  }
+
+  void module_instrumentation::print_report(std::ostream & out_,
+                                            const std::string & title_,
+                                            const std::string & indent_) const
+  {
+    if (!title_.empty()) {
+      out_ << indent_ << title_ << std::endl;
+    }
+    const double ms = CLHEP::millisecond;
+    for (std::size_t i = 0; i < _entries_.size(); i++) {
+      const entry & e = _entries_[i];
+      const bool last = (i + 1 == _entries_.size());
+      std::ostringstream sub_indent;
+      sub_indent << indent_
+                 << (last ? datatools::i_tree_dumpable::last_skip_tag : datatools::i_tree_dumpable::skip_tag);
+      out_ << indent_
+           << (last ? datatools::i_tree_dumpable::last_tag : datatools::i_tree_dumpable::tag)
+           << "Module '" << e.label << "'" << std::endl;
+      out_ << sub_indent.str() << datatools::i_tree_dumpable::tag
+           << "Calls : " << e.calls
+           << " (ok=" << e.ok_count << ", error=" << e.error_count
+           << ", stop=" << e.stop_count << ", fatal=" << e.fatal_count << ")" << std::endl;
+      if (e.calls == 0) {
+        out_ << sub_indent.str() << datatools::i_tree_dumpable::last_tag
+             << "No recorded call" << std::endl;
+        continue;
+      }
+      out_ << sub_indent.str() << datatools::i_tree_dumpable::tag
+           << "Wall time : total=" << e.wall_time_sum / ms << " ms"
+           << " mean=" << e.get_mean_wall_time() / ms << " ms"
+           << " min=" << e.wall_time_min / ms << " ms"
+           << " max=" << e.wall_time_max / ms << " ms" << std::endl;
+      out_ << sub_indent.str() << datatools::i_tree_dumpable::tag
+           << "CPU time : total=" << e.cpu_time_sum / ms << " ms"
+           << " mean=" << e.get_mean_cpu_time() / ms << " ms"
+           << " min=" << e.cpu_time_min / ms << " ms"
+           << " max=" << e.cpu_time_max / ms << " ms" << std::endl;
+      out_ << sub_indent.str() << datatools::i_tree_dumpable::tag
+           << "Banks delta : mean=" << e.get_mean_bank_delta()
+           << " min=" << e.bank_delta_min
+           << " max=" << e.bank_delta_max << std::endl;
+      out_ << sub_indent.str() << datatools::i_tree_dumpable::last_tag
+           << "Wall time histogram :";
+      for (std::size_t ibin = 0; ibin < NUMBER_OF_TIME_BINS; ibin++) {
+        if (e.wall_time_histogram[ibin] == 0) continue;
+        out_ << " [" << entry::time_bin_lower_bound(ibin) / CLHEP::microsecond
+             << " us]=" << e.wall_time_histogram[ibin];
+      }
+      out_ << std::endl;
+    }
+    return;
+  }
+
+  namespace {
+
+    void json_histogram(std::ostream & out_,
+                        const module_instrumentation::time_histogram_type & histo_)
+    {
+      out_ << '[';
+      for (std::size_t ibin = 0; ibin < histo_.size(); ibin++) {
+        if (ibin > 0) out_ << ',';
+        out_ << histo_[ibin];
+      }
+      out_ << ']';
+      return;
+    }
+
+    void json_string(std::ostream & out_, const std::string & str_)
+    {
+      out_ << '"';
+      for (char c : str_) {
+        if (c == '"' || c == '\\') {
+          out_ << '\\' << c;
+        } else if ((unsigned char) c < 0x20) {
+          out_ << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c
+               << std::dec << std::setfill(' ');
+        } else {
+          out_ << c;
+        }
+      }
+      out_ << '"';
+      return;
+    }
+
+  }
+
+  void module_instrumentation::export_json(std::ostream & out_) const
+  {
+    const double s = CLHEP::second;
+    const std::streamsize saved_precision = out_.precision(9);
+    out_ << "{\n";
+    out_ << "  \"time_unit\": \"s\",\n";
+    out_ << "  \"time_bins\": [";
+    for (std::size_t ibin = 0; ibin < NUMBER_OF_TIME_BINS; ibin++) {
+      if (ibin > 0) out_ << ',';
+      out_ << entry::time_bin_lower_bound(ibin) / s;
+    }
+    out_ << "],\n";
+    out_ << "  \"modules\": [";
+    for (std::size_t i = 0; i < _entries_.size(); i++) {
+      const entry & e = _entries_[i];
+      const bool has_calls = e.calls > 0;
+      out_ << (i > 0 ? "," : "") << "\n    {\n";
+      out_ << "      \"label\": ";
+      json_string(out_, e.label);
+      out_ << ",\n";
+      out_ << "      \"calls\": " << e.calls << ",\n";
+      out_ << "      \"status\": {\"ok\": " << e.ok_count
+           << ", \"error\": " << e.error_count
+           << ", \"stop\": " << e.stop_count
+           << ", \"fatal\": " << e.fatal_count << "},\n";
+      out_ << "      \"wall_time\": {\"sum\": " << e.wall_time_sum / s
+           << ", \"min\": " << (has_calls ? e.wall_time_min / s : 0.0)
+           << ", \"max\": " << e.wall_time_max / s
+           << ", \"histogram\": ";
+      json_histogram(out_, e.wall_time_histogram);
+      out_ << "},\n";
+      out_ << "      \"cpu_time\": {\"sum\": " << e.cpu_time_sum / s
+           << ", \"min\": " << (has_calls ? e.cpu_time_min / s : 0.0)
+           << ", \"max\": " << e.cpu_time_max / s
+           << ", \"histogram\": ";
+      json_histogram(out_, e.cpu_time_histogram);
+      out_ << "},\n";
+      out_ << "      \"bank_delta\": {\"sum\": " << e.bank_delta_sum
+           << ", \"min\": " << (has_calls ? e.bank_delta_min : 0)
+           << ", \"max\": " << (has_calls ? e.bank_delta_max : 0) << "}\n";
+      out_ << "    }";
+    }
+    out_ << "\n  ]\n";
+    out_ << "}\n";
+    out_.precision(saved_precision);
+    return;
+  }
+
+  void module_instrumentation::store_json() const
+  {
+    DT_THROW_IF(!has_json_file(), std::logic_error, "No JSON output file is set!");
+    std::string json_path = _json_file_;
+    datatools::fetch_path_with_env(json_path);
+    std::ofstream fout(json_path.c_str());
+    DT_THROW_IF(!fout, std::runtime_error, "Cannot open JSON output file '" << json_path << "'!");
+    export_json(fout);
+    return;
+  }
+
+  void module_instrumentation::report(std::ostream & out_, const std::string & title_) const
+  {
+    uint64_t total_calls = 0;
+    for (const entry & e : _entries_) {
+      total_calls += e.calls;
+    }
+    if (total_calls == 0) {
+      return;
+    }
+    print_report(out_, title_);
+    if (has_json_file()) {
+      store_json();
+    }
+    return;
+  }
+
+  void module_instrumentation::tree_dump(std::ostream & out_,
+                                         const std::string & title_,
+                                         const std::string & indent_,
+                                         bool inherit_) const
+  {
+    if (!title_.empty()) {
+      out_ << indent_ << title_ << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "Enabled : " << std::boolalpha << _enabled_ << std::endl;
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "JSON file : ";
+    if (has_json_file()) {
+      out_ << "'" << _json_file_ << "'";
+    } else {
+      out_ << "<none>";
+    }
+    out_ << std::endl;
+    out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+         << "Entries : " << _entries_.size() << std::endl;
+    return;
+  }
+
+} // end of namespace dpp
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -22,12 +22,21 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/service_manager.h>
 #include <datatools/exception.h>
+#include <datatools/things.h>
+// - Bayeux/brio:
+#include <brio/utils.h>
 
 // This project:
 #include <dpp/output_module.h>
@@ -41,6 +50,267 @@ namespace dpp {
   // Registration instantiation macro :
   DPP_MODULE_REGISTRATION_IMPLEMENT(output_module, "dpp::output_module")
 
+  /// \brief Writer thread and bounded queue of output operations for the asynchronous mode
+  struct output_module::async_writer
+  {
+    /// \brief Output operation
+    struct job_type
+    {
+      enum kind_type {
+        JOB_OPEN   = 0, //!< Open a new output file and store metadata
+        JOB_RECORD = 1, //!< Store a data record
+        JOB_CLOSE  = 2  //!< Close the current output file
+      };
+      kind_type kind = JOB_RECORD;
+      std::string filename; //!< Output file (JOB_OPEN)
+      std::vector<datatools::properties> metadata; //!< Metadata (JOB_OPEN)
+      std::unique_ptr<datatools::things> record; //!< Data record (JOB_RECORD)
+    };
+
+    async_writer(std::size_t capacity_, bool preserve_, datatools::logger::priority logging_);
+
+    ~async_writer();
+
+    /// Queue the opening of a new output file
+    void push_open(const std::string & filename_, std::vector<datatools::properties> & metadata_);
+
+    /// Move a data record in the queue
+    void push_record(datatools::things & record_);
+
+    /// Queue the closing of the current output file
+    void push_close();
+
+    /// Process all pending operations and terminate the writer thread
+    void stop();
+
+    /// Check if the writer thread met an error
+    bool has_failed() const;
+
+    /// Return the error message from the writer thread
+    std::string get_error_message() const;
+
+    /// Return the error met by the writer thread
+    std::exception_ptr get_error() const;
+
+  private:
+
+    void _push_(job_type & job_);
+
+    void _run_();
+
+    void _execute_(job_type & job_);
+
+    void _close_sink_();
+
+  public:
+
+    bool file_open = false; //!< Output file status as seen from the processing thread
+    bool error_reported = false; //!< Flag set when the writer error has been reported by the processing thread
+
+  private:
+
+    std::size_t _capacity_;
+    bool _preserve_;
+    datatools::logger::priority _logging_;
+    i_data_sink * _sink_ = nullptr; //!< Data writer (owned by the writer thread)
+    mutable std::mutex _mutex_;
+    std::condition_variable _not_empty_;
+    std::condition_variable _not_full_;
+    std::deque<job_type> _queue_;
+    std::vector<std::unique_ptr<datatools::things> > _pool_; //!< Recycled data records
+    bool _stopping_ = false;
+    bool _failed_ = false;
+    std::string _error_message_;
+    std::exception_ptr _error_;
+    std::thread _thread_;
+
+  };
+
+  output_module::async_writer::async_writer(std::size_t capacity_,
+                                            bool preserve_,
+                                            datatools::logger::priority logging_)
+    : _capacity_(std::max<std::size_t>(capacity_, 1))
+    , _preserve_(preserve_)
+    , _logging_(logging_)
+  {
+    _thread_ = std::thread(&async_writer::_run_, this);
+    return;
+  }
+
+  output_module::async_writer::~async_writer()
+  {
+    stop();
+    return;
+  }
+
+  void output_module::async_writer::push_open(const std::string & filename_,
+                                              std::vector<datatools::properties> & metadata_)
+  {
+    job_type job;
+    job.kind = job_type::JOB_OPEN;
+    job.filename = filename_;
+    job.metadata.swap(metadata_);
+    _push_(job);
+    return;
+  }
+
+  void output_module::async_writer::push_record(datatools::things & record_)
+  {
+    job_type job;
+    job.kind = job_type::JOB_RECORD;
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      if (!_pool_.empty()) {
+        job.record = std::move(_pool_.back());
+        _pool_.pop_back();
+      }
+    }
+    if (!job.record) {
+      job.record.reset(new datatools::things);
+    }
+    job.record->swap(record_);
+    _push_(job);
+    return;
+  }
+
+  void output_module::async_writer::push_close()
+  {
+    job_type job;
+    job.kind = job_type::JOB_CLOSE;
+    _push_(job);
+    return;
+  }
+
+  void output_module::async_writer::_push_(job_type & job_)
+  {
+    std::unique_lock<std::mutex> lock(_mutex_);
+    // Back-pressure: wait for the writer thread to consume pending operations:
+    _not_full_.wait(lock, [this] { return _queue_.size() < _capacity_; });
+    _queue_.push_back(std::move(job_));
+    lock.unlock();
+    _not_empty_.notify_one();
+    return;
+  }
+
+  void output_module::async_writer::stop()
+  {
+    if (!_thread_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      _stopping_ = true;
+    }
+    _not_empty_.notify_one();
+    _thread_.join();
+    return;
+  }
+
+  bool output_module::async_writer::has_failed() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    return _failed_;
+  }
+
+  std::string output_module::async_writer::get_error_message() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    return _error_message_;
+  }
+
+  std::exception_ptr output_module::async_writer::get_error() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex_);
+    return _error_;
+  }
+
+  void output_module::async_writer::_run_()
+  {
+    while (true) {
+      job_type job;
+      bool failed = false;
+      {
+        std::unique_lock<std::mutex> lock(_mutex_);
+        _not_empty_.wait(lock, [this] { return !_queue_.empty() || _stopping_; });
+        if (_queue_.empty()) {
+          // Stop request and no more pending operation:
+          break;
+        }
+        job = std::move(_queue_.front());
+        _queue_.pop_front();
+        failed = _failed_;
+      }
+      _not_full_.notify_one();
+      if (!failed) {
+        try {
+          _execute_(job);
+        } catch (std::exception & error) {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          _failed_ = true;
+          _error_message_ = error.what();
+          _error_ = std::current_exception();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          _failed_ = true;
+          _error_message_ = "unexpected error";
+          _error_ = std::current_exception();
+        }
+      }
+      // Recycle the data record (its banks are released by the writer thread):
+      if (job.record) {
+        job.record->clear();
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _pool_.push_back(std::move(job.record));
+      }
+    }
+    try {
+      _close_sink_();
+    } catch (std::exception & error) {
+      std::lock_guard<std::mutex> lock(_mutex_);
+      if (!_failed_) {
+        _failed_ = true;
+        _error_message_ = error.what();
+        _error_ = std::current_exception();
+      }
+    }
+    return;
+  }
+
+  void output_module::async_writer::_execute_(job_type & job_)
+  {
+    if (job_.kind == job_type::JOB_OPEN) {
+      _close_sink_();
+      _sink_ = io_common::allocate_writer(job_.filename, _logging_);
+      DT_THROW_IF(_sink_ == nullptr, std::runtime_error,
+                  "Cannot allocate any data writer for file '" << job_.filename << "' !");
+      if (_preserve_) {
+        _sink_->set_preserve_existing_sink(true);
+      }
+      if (! _sink_->is_open()) _sink_->open();
+      for (const datatools::properties & md : job_.metadata) {
+        _sink_->store_metadata(md);
+      }
+    } else if (job_.kind == job_type::JOB_RECORD) {
+      DT_THROW_IF(_sink_ == nullptr, std::logic_error, "No available data sink ! This is a bug !");
+      DT_THROW_IF(! _sink_->store_next_record(*job_.record), std::runtime_error,
+                  "Cannot store the data record ! This is a bug !");
+    } else if (job_.kind == job_type::JOB_CLOSE) {
+      _close_sink_();
+    }
+    return;
+  }
+
+  void output_module::async_writer::_close_sink_()
+  {
+    if (_sink_ != nullptr) {
+      i_data_sink * sink = _sink_;
+      _sink_ = nullptr;
+      std::unique_ptr<i_data_sink> deleter(sink);
+      sink->reset();
+    }
+    return;
+  }
+
   // Implementation of the interface :
 
   void output_module::set_limits(int max_record_total_,
@@ -115,6 +385,28 @@ namespace dpp {
     return;
   }
 
+  void output_module::set_async(bool async_, std::size_t queue_capacity_)
+  {
+    DT_THROW_IF(is_initialized(),
+                std::logic_error,
+                "Output module '" << get_name() << "' is already initialized !");
+    DT_THROW_IF(queue_capacity_ < 1, std::domain_error,
+                "Invalid capacity of the queue of pending data records !");
+    _async_enabled_ = async_;
+    _async_queue_capacity_ = queue_capacity_;
+    return;
+  }
+
+  bool output_module::is_async() const
+  {
+    return _async_enabled_;
+  }
+
+  std::size_t output_module::get_async_queue_capacity() const
+  {
+    return _async_queue_capacity_;
+  }
+
   bool output_module::is_terminated() const
   {
     DT_THROW_IF(! is_initialized(),
@@ -126,6 +418,8 @@ namespace dpp {
   void output_module::_set_defaults()
   {
     _preserve_existing_output_ = false;
+    _async_enabled_ = false;
+    _async_queue_capacity_ = 2;
     _sink_   = nullptr;
     return;
   }
@@ -214,7 +508,13 @@ namespace dpp {
 
   output_module::~output_module()
   {
-    if (is_initialized()) output_module::reset();
+    if (is_initialized()) {
+      try {
+        output_module::reset();
+      } catch (std::exception & error) {
+        DT_LOG_ERROR(_logging, "Output module '" << get_name() << "' : " << error.what());
+      }
+    }
     return;
   }
 
@@ -235,11 +535,35 @@ namespace dpp {
       set_preserve_existing_output(true);
     }
 
+    if (a_config.has_key("async.enabled")) {
+      std::size_t queue_capacity = _async_queue_capacity_;
+      if (a_config.has_key("async.queue_capacity")) {
+        int qc = a_config.fetch_integer("async.queue_capacity");
+        DT_THROW_IF(qc < 1, std::domain_error,
+                    "Output module '" << get_name() << "' has an invalid 'async.queue_capacity' !");
+        queue_capacity = qc;
+      }
+      set_async(a_config.fetch_boolean("async.enabled"), queue_capacity);
+    }
+
     if (! _common_) {
       _grab_common();
     }
     _common_.get()->initialize(a_config, a_service_manager);
 
+    if (_async_enabled_) {
+      // The writer thread opens and writes the brio files:
+      for (std::size_t ifile = 0; ifile < get_common().get_filenames().size(); ifile++) {
+        if (io_common::guess_format_from_filename(get_common().get_filenames()[ifile]) == io_common::FORMAT_BRIO) {
+          brio::enable_thread_safety();
+          break;
+        }
+      }
+      _async_.reset(new async_writer(_async_queue_capacity_,
+                                     _preserve_existing_output_,
+                                     get_logging_priority()));
+    }
+
     this->_open_sink_();
 
     /*************************************
@@ -264,6 +588,15 @@ namespace dpp {
      *  revert to some defaults *
      ****************************/
 
+    std::exception_ptr async_error;
+    if (_async_) {
+      try {
+        _stop_async_();
+      } catch (...) {
+        async_error = std::current_exception();
+      }
+    }
+
     if (_sink_ != nullptr) {
       if (_sink_->is_open()) {
         _sink_->close();
@@ -280,6 +613,10 @@ namespace dpp {
      *  end of the reset step   *
      ****************************/
 
+    // Data records stored after the last reported error may have been lost:
+    if (async_error) {
+      std::rethrow_exception(async_error);
+    }
     return;
   }
 
@@ -290,12 +627,25 @@ namespace dpp {
                 std::logic_error,
                 "Output module '" << get_name() << "' is not initialized !");
     if (! is_terminated()) {
+      if (_async_) {
+        return _store_async_(a_data_record);
+      }
       return _store(a_data_record);
     }
     return PROCESS_OK;
   }
 
   void output_module::_store_metadata_()
+  {
+    std::vector<datatools::properties> metadata;
+    _collect_metadata_(metadata);
+    for (const datatools::properties & md : metadata) {
+      _sink_->store_metadata(md);
+    }
+    return;
+  }
+
+  void output_module::_collect_metadata_(std::vector<datatools::properties> & metadata_)
   {
     // First consider the external context service (if any) and its global metadata sections:
     if (get_common().has_context_service()) {
@@ -328,7 +678,7 @@ namespace dpp {
           ctx_props.store_string(io_common::context_key(), ctx_section_key);
           ctx_props.store_string(io_common::context_meta(), ctx_section_meta);
           ctx_props.store_integer(io_common::context_rank(), counter);
-          _sink_->store_metadata(ctx_props);
+          metadata_.push_back(ctx_props);
           counter++;
         }
       }
@@ -361,13 +711,30 @@ namespace dpp {
       props.store_string(io_common::metadata_key(), key);
       props.store_string(io_common::metadata_meta(), meta);
       props.store_integer(io_common::metadata_rank(), i);
-      _sink_->store_metadata(props);
+      metadata_.push_back(props);
     }
     return;
   }
 
   base_module::process_status output_module::_open_sink_()
   {
+    if (_async_) {
+      if (! _async_->file_open) {
+        _grab_common().set_file_index(get_common().get_file_index()+1);
+        if (get_common().get_file_index() >= (int) get_common().get_filenames().size()) {
+          _grab_common().set_terminated(true);
+          return PROCESS_FATAL;
+        }
+        std::string sink_label = get_common().get_filenames()[get_common().get_file_index()];
+        // Metadata are collected now and stored by the writer thread when it opens the file:
+        std::vector<datatools::properties> metadata;
+        _collect_metadata_(metadata);
+        _async_->push_open(sink_label, metadata);
+        _async_->file_open = true;
+        _grab_common().set_file_record_counter(0);
+      }
+      return PROCESS_OK;
+    }
     if (_sink_ == nullptr) {
       _grab_common().set_file_index(get_common().get_file_index()+1);
       if (get_common().get_file_index() >= (int) get_common().get_filenames().size()) {
@@ -448,6 +815,18 @@ namespace dpp {
       }
     }
 
+    if (_update_limits_()) {
+      if (_sink_ != nullptr) {
+        _sink_->reset();
+        delete _sink_;
+        _sink_ = nullptr;
+      }
+    }
+    return store_status;
+  }
+
+  bool output_module::_update_limits_()
+  {
     bool stop_file   = false;
     bool stop_output = false;
     if (get_common().get_max_record_total() > 0) {
@@ -466,11 +845,6 @@ namespace dpp {
       }
     }
     if (stop_file) {
-      if (_sink_ != nullptr) {
-        _sink_->reset();
-        delete _sink_;
-        _sink_ = nullptr;
-      }
       _grab_common().set_file_record_counter(0);
       if (get_common().get_max_files() > 0) {
         if ((get_common().get_file_index() + 1) >= get_common().get_max_files()) {
@@ -488,9 +862,54 @@ namespace dpp {
     if (stop_output) {
       _grab_common().set_terminated(true);
     }
+    return stop_file;
+  }
+
+  base_module::process_status output_module::_store_async_(datatools::things & a_event_record)
+  {
+    if (_async_->has_failed()) {
+      std::ostringstream errmsg;
+      errmsg << "Output module '" << get_name() << "' writer failed; message is '"
+             << _async_->get_error_message() << "'";
+      append_last_error_message(errmsg.str());
+      DT_LOG_ERROR(_logging, errmsg.str());
+      _async_->error_reported = true;
+      _grab_common().set_terminated(true);
+      return PROCESS_FATAL;
+    }
+    process_status store_status = _open_sink_();
+    if (store_status != PROCESS_OK) {
+      return store_status;
+    }
+    _async_->push_record(a_event_record);
+    _grab_common().set_file_record_counter(get_common().get_file_record_counter()+1);
+    _grab_common().set_record_counter(get_common().get_record_counter()+1);
+    if (_update_limits_()) {
+      _async_->push_close();
+      _async_->file_open = false;
+    }
     return store_status;
   }
 
+  void output_module::_stop_async_()
+  {
+    if (_async_->file_open) {
+      _async_->push_close();
+      _async_->file_open = false;
+    }
+    _async_->stop();
+    std::exception_ptr error;
+    if (_async_->has_failed() && ! _async_->error_reported) {
+      DT_LOG_ERROR(_logging, "Output module '" << get_name() << "' writer failed; message is '"
+                   << _async_->get_error_message() << "'");
+      error = _async_->get_error();
+    }
+    _async_.reset();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
 
   void output_module::tree_dump(std::ostream & a_out ,
                                 const std::string & a_title,
@@ -509,6 +928,13 @@ namespace dpp {
     a_out << indent << datatools::i_tree_dumpable::tag
           << "Preserve existing output : " << std::boolalpha << _preserve_existing_output_ << std::endl;
 
+    a_out << indent << datatools::i_tree_dumpable::tag
+          << "Asynchronous output : " << std::boolalpha << _async_enabled_;
+    if (_async_enabled_) {
+      a_out << " (queue capacity=" << _async_queue_capacity_ << ")";
+    }
+    a_out << std::endl;
+
     if (_common_) {
       a_out << indent << datatools::i_tree_dumpable::tag
             << "Common   : " << std::endl;
@@ -22,12 +22,15 @@
 #include <string>
 #include <list>
 #include <stdexcept>
+#include <sstream>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/ioutils.h>
 #include <datatools/properties.h>
 #include <datatools/things.h>
+#include <datatools/exception.h>
+#include <datatools/multi_properties.h>
 
 // This project:
 #include <dpp/input_module.h>
@@ -290,6 +293,102 @@ void test_io_2(bool debug, int max_events)
   return;
 }
 
+void test_io_async(bool debug)
+{
+  std::clog << datatools::io::notice
+            << "test_io_async: asynchronous 'output_module' example: " << std::endl;
+
+  const int nrecords = 64;
+  {
+    dpp::output_module output;
+    output.set_limits(nrecords, 30, 10);
+    output.set_incremental_output_files("${DPP_TMP_TEST_DIR}", "test_input_output_modules_async_", "txt", 10, 0, 1);
+    output.set_async(true, 2);
+    datatools::properties & run_md = output.grab_metadata_store().add_section("run", "dpp::test");
+    run_md.store("run_number", 42);
+    output.initialize_simple();
+    output.tree_dump (std::clog, "Async output module");
+
+    for (int irecord = 0; irecord < nrecords; irecord++) {
+      datatools::things ER;
+      datatools::properties & p = ER.add<datatools::properties> ("Info");
+      p.store ("event_number", irecord);
+      dpp::base_module::process_status status = output.process (ER);
+      DT_THROW_IF(status != dpp::base_module::PROCESS_OK, std::logic_error,
+                  "Async writer failed at record #" << irecord << " !");
+      DT_THROW_IF(! ER.empty(), std::logic_error,
+                  "Data record has not been moved to the async writer !");
+    }
+    DT_THROW_IF(! output.is_terminated(), std::logic_error, "Async output is not terminated !");
+    output.reset ();
+  }
+
+  // Read back the output files:
+  dpp::input_module input;
+  input.set_incremental_input_files("${DPP_TMP_TEST_DIR}", "test_input_output_modules_async_", "txt", 2, 0, 1);
+  input.initialize_simple();
+  int input_count = 0;
+  int metadata_count = 0;
+  while (! input.is_terminated ()) {
+    datatools::things ER;
+    dpp::base_module::process_status status = input.process (ER);
+    if (status != dpp::base_module::PROCESS_OK) {
+      break;
+    }
+    if (input.metadata_was_updated()) {
+      DT_THROW_IF(! input.get_metadata_store().has_section("run"), std::logic_error,
+                  "Missing metadata in output file !");
+      metadata_count++;
+    }
+    const datatools::properties & p = ER.get<datatools::properties> ("Info");
+    DT_THROW_IF(p.fetch_integer("event_number") != input_count, std::logic_error,
+                "Unexpected data record #" << input_count << " !");
+    if (debug) ER.tree_dump (std::clog, "Event record :", "DEBUG: ");
+    input_count++;
+  }
+  input.reset ();
+  std::clog << datatools::io::notice
+            << "test_io_async: Read back event records : " << input_count << std::endl;
+  std::clog << datatools::io::notice
+            << "test_io_async: Files with metadata     : " << metadata_count << std::endl;
+  DT_THROW_IF(input_count != nrecords, std::logic_error, "Missing data records !");
+  DT_THROW_IF(metadata_count != 3, std::logic_error, "Missing metadata !");
+
+  for (int ifile = 0; ifile < 3; ifile++) {
+    std::ostringstream fout_oss;
+    fout_oss << "${DPP_TMP_TEST_DIR}/test_input_output_modules_async_" << ifile << ".txt";
+    std::string fout = fout_oss.str();
+    datatools::fetch_path_with_env(fout);
+    unlink(fout.c_str());
+  }
+
+  {
+    // A writer error is reported either by process() or by reset():
+    dpp::output_module output;
+    output.set_single_output_file("${DPP_TMP_TEST_DIR}/no_such_directory/test_input_output_modules_async.txt");
+    output.set_async(true, 2);
+    output.initialize_simple();
+    bool reported = false;
+    for (int irecord = 0; irecord < 3 && ! reported; irecord++) {
+      datatools::things ER;
+      ER.add<datatools::properties> ("Info").store ("event_number", irecord);
+      if (output.process (ER) == dpp::base_module::PROCESS_FATAL) {
+        reported = true;
+      }
+    }
+    try {
+      output.reset ();
+    } catch (std::exception & error) {
+      std::clog << datatools::io::notice
+                << "test_io_async: Writer error at reset : " << error.what() << std::endl;
+      DT_THROW_IF(reported, std::logic_error, "Writer error reported twice !");
+      reported = true;
+    }
+    DT_THROW_IF(! reported, std::logic_error, "Writer error has not been reported !");
+  }
+  return;
+}
+
 void test_brio_1(bool /*debug*/)
 {
   int error_code = 0;
@@ -406,6 +505,8 @@ int main (int argc_, char ** argv_)
 
     test_io_2(debug, max_events);
 
+    test_io_async(debug);
+
     if (test_brio) {
       //test_brio_1(debug);
     }
@@ -0,0 +1,148 @@
+// test_module_instrumentation.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/things.h>
+
+// This project:
+#include <dpp/chain_module.h>
+#include <dpp/dummy_module.h>
+#include <dpp/module_instrumentation.h>
+
+/// A module which asks to stop the processing of every other data record
+class stopper_module : public dpp::base_module
+{
+public:
+
+  stopper_module() : dpp::base_module(datatools::logger::PRIO_FATAL), _counter_(0) {}
+
+  ~stopper_module() override
+  {
+    if (is_initialized()) reset();
+  }
+
+  void initialize(const datatools::properties & config_,
+                  datatools::service_manager &,
+                  dpp::module_handle_dict_type &) override
+  {
+    _common_initialize(config_);
+    _set_initialized(true);
+  }
+
+  void reset() override
+  {
+    _set_initialized(false);
+  }
+
+  process_status process(datatools::things &) override
+  {
+    return (_counter_++ % 2) ? PROCESS_STOP : PROCESS_OK;
+  }
+
+private:
+
+  int _counter_;
+
+};
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'dpp::module_instrumentation'!" << std::endl;
+
+    // Histogram binning:
+    DT_THROW_IF(dpp::module_instrumentation::entry::time_bin(0.0) != 0,
+                std::logic_error, "Invalid first time bin!");
+    for (std::size_t ibin = 1; ibin < dpp::module_instrumentation::NUMBER_OF_TIME_BINS; ibin++) {
+      const double t = dpp::module_instrumentation::entry::time_bin_lower_bound(ibin);
+      DT_THROW_IF(dpp::module_instrumentation::entry::time_bin(t) != ibin,
+                  std::logic_error, "Invalid time bin for lower bound of bin #" << ibin << "!");
+    }
+
+    datatools::properties GP_config;
+    GP_config.store("name", "GP");
+    GP_config.store("GP_label", "GP");
+    dpp::dummy_module * gp_module = new dpp::dummy_module;
+    gp_module->initialize_standalone(GP_config);
+
+    datatools::properties stopper_config;
+    stopper_config.store("name", "stopper");
+    stopper_module * stop_module = new stopper_module;
+    stop_module->initialize_standalone(stopper_config);
+
+    datatools::properties GP2_config;
+    GP2_config.store("name", "GP2");
+    GP2_config.store("GP_label", "GP2");
+    dpp::dummy_module * gp2_module = new dpp::dummy_module;
+    gp2_module->initialize_standalone(GP2_config);
+
+    dpp::chain_module chain;
+    chain.add_module("GP", dpp::module_handle_type(gp_module));
+    chain.add_module("stopper", dpp::module_handle_type(stop_module));
+    chain.add_module("GP2", dpp::module_handle_type(gp2_module));
+    datatools::properties chain_config;
+    chain_config.store("name", "chain");
+    chain_config.store_flag("instrumentation.enabled");
+    chain.initialize_standalone(chain_config);
+    chain.tree_dump(std::clog, "Chain module: ");
+
+    const dpp::module_instrumentation & instr = chain.get_instrumentation();
+    DT_THROW_IF(!instr.is_enabled(), std::logic_error, "Instrumentation is not enabled!");
+    DT_THROW_IF(instr.get_number_of_entries() != 3, std::logic_error, "Invalid number of entries!");
+
+    const int nrecords = 100;
+    datatools::things record;
+    for (int irecord = 0; irecord < nrecords; irecord++) {
+      record.clear();
+      chain.process(record);
+    }
+
+    const dpp::module_instrumentation::entry & gp_stats = instr.get_entry(0);
+    const dpp::module_instrumentation::entry & stop_stats = instr.get_entry(1);
+    const dpp::module_instrumentation::entry & gp2_stats = instr.get_entry(2);
+    instr.print_report(std::clog, "Instrumentation report: ");
+
+    DT_THROW_IF(gp_stats.calls != (uint64_t) nrecords, std::logic_error, "Invalid number of calls for 'GP'!");
+    DT_THROW_IF(gp_stats.ok_count != (uint64_t) nrecords, std::logic_error, "Invalid OK count for 'GP'!");
+    DT_THROW_IF(gp_stats.bank_delta_sum != nrecords, std::logic_error, "Invalid bank delta for 'GP'!");
+    DT_THROW_IF(stop_stats.calls != (uint64_t) nrecords, std::logic_error, "Invalid number of calls for 'stopper'!");
+    DT_THROW_IF(stop_stats.stop_count != (uint64_t) nrecords / 2, std::logic_error, "Invalid STOP count for 'stopper'!");
+    DT_THROW_IF(stop_stats.bank_delta_sum != 0, std::logic_error, "Invalid bank delta for 'stopper'!");
+    DT_THROW_IF(gp2_stats.calls != (uint64_t) nrecords / 2, std::logic_error, "Invalid number of calls for 'GP2'!");
+
+    uint64_t histogram_sum = 0;
+    for (uint64_t count : gp_stats.wall_time_histogram) {
+      histogram_sum += count;
+    }
+    DT_THROW_IF(histogram_sum != gp_stats.calls, std::logic_error, "Invalid wall time histogram for 'GP'!");
+
+    std::ostringstream json;
+    instr.export_json(json);
+    std::clog << "JSON export: " << std::endl << json.str();
+    DT_THROW_IF(json.str().find("\"label\": \"stopper\"") == std::string::npos,
+                std::logic_error, "Missing module in JSON export!");
+
+    chain.reset();
+    DT_THROW_IF(chain.get_instrumentation().get_number_of_entries() != 0,
+                std::logic_error, "Instrumentation has not been cleared!");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -58,6 +58,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/dpp_config.h.in
   ${module_include_dir}/${module_name}/version.h.in
   ${module_include_dir}/${module_name}/dpp_driver.h
+  ${module_include_dir}/${module_name}/module_instrumentation.h
   )
 
 set(${module_name}_MODULE_SOURCES
@@ -86,6 +87,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/ocd_support.cc
   ${module_source_dir}/version.cc
   ${module_source_dir}/dpp_driver.cc
+  ${module_source_dir}/module_instrumentation.cc
   )
 
 # - Published headers
@@ -105,11 +107,13 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_module_chain.cxx #<- Requires program_options
   ${module_test_dir}/test_module_manager.cxx
   ${module_test_dir}/test_histogram_service.cxx
+  ${module_test_dir}/test_module_instrumentation.cxx
   )
 
 # - Applications
 set(${module_name}_MODULE_APPS
   ${module_app_dir}/dpp_processing.cxx
+  ${module_app_dir}/dpp_histogram_merge.cxx
   )
 
 # - Examples dir
@@ -15,6 +15,10 @@
 #pragma once
 
 #include <boost/lexical_cast.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/archive/basic_archive.hpp>
 #include <boost/archive/archive_exception.hpp>
 
@@ -33,6 +37,28 @@ namespace boost {
 		// flag for fp serialization
 		const unsigned no_infnan = 64;
 
+		// flag to store arrays of numbers element by element (format of version 6.0)
+		const unsigned no_array_blocks = 128;
+
+		// bit set in the archive version of the header if arrays of numbers are
+		// stored as contiguous blocks (an older reader rejects such an archive as
+		// an unsupported version)
+		const unsigned array_blocks_version_bit = 0x4000;
+
+		/**
+		 * \brief Check if arrays of a numeric type can be stored as contiguous blocks.
+		 *
+		 * Only arithmetic types (but bool) with a size up to 64 bits are eligible.
+		 * Blocks are stored with the little endian byte order and the IEEE 754 format
+		 * for floating point numbers.
+		 */
+		template <typename T>
+		struct is_portable_array_type
+			: boost::mpl::bool_<boost::is_arithmetic<T>::value
+				&& !boost::is_same<T, bool>::value
+				&& sizeof(T) <= 8>
+		{};
+
 		// integral type for the archive version
 		typedef library_version_type archive_version_type;
 
@@ -66,6 +92,16 @@ namespace boost {
 				msg += lexical_cast<std::string, int>(invalid_size);
 			}
 
+			//! tag of the archives with arrays stored as blocks
+			struct array_blocks_unsupported {};
+
+			//! arrays stored as blocks read through an archive which does not support them
+			portable_archive_exception(array_blocks_unsupported)
+				: archive_exception(unsupported_version)
+				, msg("arrays of numbers stored as blocks are not supported by this archive")
+			{
+			}
+
 			//! negative number in unsigned type
 			portable_archive_exception()
 				: archive_exception(other_exception)
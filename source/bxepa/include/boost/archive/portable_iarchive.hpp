@@ -3,7 +3,7 @@
  * \file portable_iarchive.hpp
  * \brief Provides an archive to read from portable binary files.
  * \author christian.pfligersdorffer@gmx.at
- * \version 6.0
+ * \version 6.1
  *
  * This pair of archives brings the advantages of binary streams to the cross
  * platform boost::serialization user. While being almost as fast as the native
@@ -23,6 +23,19 @@
  *       chance it will instantly work for your specific setup. If you encounter
  *       problems or have suggestions please contact the author.
  *
+ * \note Version 6.1 stores contiguous arrays of numbers (std::vector, C arrays,
+ *       boost::array... of arithmetic types but bool) as single blocks of
+ *       little endian bytes prefixed by the size of the elements. This is much
+ *       faster than storing the numbers one by one, at the price of larger
+ *       files for arrays of small integers. Such archives are tagged by a bit
+ *       of the version stored in the header so that older readers reject them.
+ *       Blocks are only written from little endian hosts and if the header is
+ *       enabled. The no_array_blocks flag forces the format of version 6.0
+ *       and all previous archives are still read unchanged. Note that the
+ *       polymorphic archives do not support blocks: the polymorphic oarchive
+ *       always writes the format of version 6.0 and the polymorphic iarchive
+ *       rejects archives with blocks.
+ *
  * \note Version 6.0 is prepared for submission to boost serialization library.
  *       Full backwards compatibility is maintained for all your archived data!
  *       Namespaces changed and some refactoring was necessary, that's all.
@@ -98,6 +111,9 @@
 
 // funny polymorphics
 #include <boost/archive/detail/polymorphic_iarchive_route.hpp>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/vector.hpp>
 
 // endian and fpclassify
 #include <boost/endian/conversion.hpp>
@@ -127,6 +143,10 @@ namespace fp = boost::math;
 #include <boost/type_traits/is_arithmetic.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
 #include "portable_archive_exception.hpp"
 
 namespace boost { namespace archive {
@@ -194,6 +214,14 @@ namespace boost { namespace archive {
                                 // extract version information
                                 operator>>(input_library_version);
 
+                                // check if arrays of numbers are stored as blocks
+                                unsigned int version = input_library_version;
+                                if (version & array_blocks_version_bit)
+                                {
+                                        m_array_blocks = true;
+                                        input_library_version = archive_version_type(version & ~array_blocks_version_bit);
+                                }
+
                                 // throw if file version is newer than we are
                                 if (input_library_version > archive_version)
                                         throw archive_exception(archive_exception::unsupported_version);
@@ -203,6 +231,34 @@ namespace boost { namespace archive {
                         }
                 }
 
+                // check the values of an array of floating point numbers
+                template <typename T>
+                typename boost::enable_if<boost::is_floating_point<T> >::type
+                        check_array(const T * p, std::size_t n)
+                {
+                        for (std::size_t i = 0; i < n; ++i)
+                        {
+                                // if the no_infnan flag is set we must throw here
+                                if (get_flags() & no_infnan && !fp::isfinite(p[i]))
+                                        throw portable_archive_exception(p[i]);
+
+                                // see the load function for floating point types
+                                if (std::numeric_limits<T>::has_denorm == std::denorm_absent
+                                        && fp::fpclassify(p[i]) == (int)FP_SUBNORMAL) // GCC4
+                                        throw portable_archive_exception(p[i]);
+                        }
+                }
+
+                // nothing to check in an array of integral numbers
+                template <typename T>
+                typename boost::disable_if<boost::is_floating_point<T> >::type
+                        check_array(const T *, std::size_t)
+                {
+                }
+
+                // arrays of numbers are stored as contiguous blocks
+                bool m_array_blocks;
+
         public:
                 /**
                  * \brief Constructor on a stream using ios::binary mode!
@@ -218,6 +274,7 @@ namespace boost { namespace archive {
                 portable_iarchive(std::istream& is, unsigned flags = 0)
                         : portable_iprimitive(*is.rdbuf(), flags & no_codecvt)
                         , basic_binary_iarchive<portable_iarchive>(flags)
+                        , m_array_blocks(false)
                 {
                         init(flags);
                 }
@@ -225,10 +282,60 @@ namespace boost { namespace archive {
                 portable_iarchive(std::streambuf& sb, unsigned flags = 0)
                         : portable_iprimitive(sb, flags & no_codecvt)
                         , basic_binary_iarchive<portable_iarchive>(flags)
+                        , m_array_blocks(false)
                 {
                         init(flags);
                 }
 
+                //! Check if arrays of numbers are stored as contiguous blocks.
+                bool has_array_blocks() const
+                {
+                        return m_array_blocks;
+                }
+
+                /**
+                 * \brief Types eligible to the array optimization.
+                 *
+                 * The optimization is selected at compile time for arrays of numbers,
+                 * the actual format of the arrays depends on the header of the archive.
+                 */
+                struct use_array_optimization
+                {
+                        template <class T>
+                        struct apply : public is_portable_array_type<T> {};
+                };
+
+                /**
+                 * \brief Load a contiguous array of numbers.
+                 *
+                 * The stored size of the elements must match the size of the type as
+                 * the bytes of the whole array are loaded at once and then converted
+                 * from little endian if needed.
+                 */
+                template <class ValueType>
+                void load_array(boost::serialization::array_wrapper<ValueType>& a, unsigned int)
+                {
+                        ValueType * p = a.address();
+                        const std::size_t n = a.count();
+                        if (!m_array_blocks)
+                        {
+                                for (std::size_t i = 0; i < n; ++i) load(p[i]);
+                                return;
+                        }
+                        signed char size = load_signed_char();
+                        if (size != (signed char)sizeof(ValueType))
+                                throw portable_archive_exception(size);
+                        load_binary(p, n * sizeof(ValueType));
+#if !BOOST_ENDIAN_LITTLE_BYTE
+                        for (std::size_t i = 0; i < n; ++i)
+                        {
+                                char * bytes = reinterpret_cast<char *>(p + i);
+                                std::reverse(bytes, bytes + sizeof(ValueType));
+                        }
+#endif
+                        check_array(p, n);
+                }
+
                 //! Load narrow strings.
                 void load(std::string& s)
                 {
@@ -385,12 +492,52 @@ namespace boost { namespace archive {
                 }
         };
 
-        // polymorphic portable binary iarchive typedef
-        typedef detail::polymorphic_iarchive_route<portable_iarchive> polymorphic_portable_iarchive;
+        /**
+         * \brief Polymorphic portable binary iarchive.
+         *
+         * The polymorphic interface loads arrays of numbers element by element,
+         * hence archives with arrays stored as blocks are rejected.
+         */
+        class polymorphic_portable_iarchive
+                : public detail::polymorphic_iarchive_route<portable_iarchive>
+        {
+        public:
+                polymorphic_portable_iarchive(std::istream& is, unsigned flags = 0)
+                        : detail::polymorphic_iarchive_route<portable_iarchive>(is, flags)
+                {
+                        if (has_array_blocks())
+                                throw portable_archive_exception(
+                                        portable_archive_exception::array_blocks_unsupported());
+                }
+        };
+
+        /**
+         * \brief Load a vector of numbers (found by argument dependent lookup).
+         *
+         * Counterpart of the save function of the portable_oarchive: archives
+         * without array blocks store the item version of the non optimized format.
+         */
+        template <class U, class Allocator>
+        inline void load(portable_iarchive& ar, std::vector<U, Allocator>& t,
+                const unsigned int file_version, boost::mpl::true_)
+        {
+                if (!ar.has_array_blocks())
+                {
+                        boost::serialization::load(ar, t, file_version, boost::mpl::false_());
+                        return;
+                }
+                boost::serialization::collection_size_type count(t.size());
+                ar >> BOOST_SERIALIZATION_NVP(count);
+                t.resize(count);
+                if (!t.empty())
+                        ar >> boost::serialization::make_array<U, boost::serialization::collection_size_type>(
+                                static_cast<U *>(&t[0]), count);
+        }
 
 } } // namespace boost::archive
 
 // this is required by export which registers all of your
 // classes with all the inbuilt archives plus our archive.
 BOOST_SERIALIZATION_REGISTER_ARCHIVE(boost::archive::portable_iarchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(boost::archive::portable_iarchive)
 BOOST_SERIALIZATION_REGISTER_ARCHIVE(boost::archive::polymorphic_portable_iarchive)
@@ -3,7 +3,7 @@
  * \file portable_oarchive.hpp
  * \brief Provides an archive to create portable binary files.
  * \author christian.pfligersdorffer@gmx.at
- * \version 6.0
+ * \version 6.1
  *
  * This pair of archives brings the advantages of binary streams to the cross
  * platform boost::serialization user. While being almost as fast as the native
@@ -23,6 +23,19 @@
  *       chance it will instantly work for your specific setup. If you encounter
  *       problems or have suggestions please contact the author.
  *
+ * \note Version 6.1 stores contiguous arrays of numbers (std::vector, C arrays,
+ *       boost::array... of arithmetic types but bool) as single blocks of
+ *       little endian bytes prefixed by the size of the elements. This is much
+ *       faster than storing the numbers one by one, at the price of larger
+ *       files for arrays of small integers. Such archives are tagged by a bit
+ *       of the version stored in the header so that older readers reject them.
+ *       Blocks are only written from little endian hosts and if the header is
+ *       enabled. The no_array_blocks flag forces the format of version 6.0
+ *       and all previous archives are still read unchanged. Note that the
+ *       polymorphic archives do not support blocks: the polymorphic oarchive
+ *       always writes the format of version 6.0 and the polymorphic iarchive
+ *       rejects archives with blocks.
+ *
  * \note Version 6.0 is prepared for submission to boost serialization library.
  *       Full backwards compatibility is maintained for all your archived data!
  *       Namespaces changed and some refactoring was necessary, that's all.
@@ -99,6 +112,9 @@
 #include <boost/archive/basic_binary_oprimitive.hpp>
 #include <boost/archive/basic_binary_oarchive.hpp>
 #include <boost/archive/detail/polymorphic_oarchive_route.hpp>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/vector.hpp>
 
 // endian and fpclassify
 #include <boost/endian/conversion.hpp>
@@ -136,6 +152,9 @@ namespace fp = boost::math;
 #include <boost/type_traits/is_arithmetic.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
 
+#include <cstddef>
+#include <vector>
+
 #include "portable_archive_exception.hpp"
 
 namespace boost { namespace archive {
@@ -193,12 +212,42 @@ namespace boost { namespace archive {
                                 // boost::archive::basic_binary_oarchive<derived_t>::init()
                                 save_signed_char(magic_byte);
 
+                                // arrays of numbers are stored as blocks only from little
+                                // endian hosts and this is recorded in the header
+#if BOOST_ENDIAN_LITTLE_BYTE
+                                m_array_blocks = !(flags & no_array_blocks);
+#endif
+                                unsigned int version = archive_version;
+                                if (m_array_blocks) version |= array_blocks_version_bit;
+
                                 // write current version
 //                              save<unsigned>(archive_version);
-                                operator<<(archive_version);
+                                operator<<(archive_version_type(version));
                         }
                 }
 
+                // check the values of an array of floating point numbers
+                template <typename T>
+                typename boost::enable_if<boost::is_floating_point<T> >::type
+                        check_array(const T * p, std::size_t n)
+                {
+                        // if the no_infnan flag is set we must throw here
+                        if (get_flags() & no_infnan)
+                                for (std::size_t i = 0; i < n; ++i)
+                                        if (!fp::isfinite(p[i]))
+                                                throw portable_archive_exception(p[i]);
+                }
+
+                // nothing to check in an array of integral numbers
+                template <typename T>
+                typename boost::disable_if<boost::is_floating_point<T> >::type
+                        check_array(const T *, std::size_t)
+                {
+                }
+
+                // arrays of numbers are stored as contiguous blocks
+                bool m_array_blocks;
+
         public:
                 /**
                  * \brief Constructor on a stream using ios::binary mode!
@@ -214,6 +263,7 @@ namespace boost { namespace archive {
                 portable_oarchive(std::ostream& os, unsigned flags = 0)
                         : portable_oprimitive(*os.rdbuf(), flags & no_codecvt)
                         , basic_binary_oarchive<portable_oarchive>(flags)
+                        , m_array_blocks(false)
                 {
                         init(flags);
                 }
@@ -221,10 +271,51 @@ namespace boost { namespace archive {
                 portable_oarchive(std::streambuf& sb, unsigned flags = 0)
                         : portable_oprimitive(sb, flags & no_codecvt)
                         , basic_binary_oarchive<portable_oarchive>(flags)
+                        , m_array_blocks(false)
                 {
                         init(flags);
                 }
 
+                //! Check if arrays of numbers are stored as contiguous blocks.
+                bool has_array_blocks() const
+                {
+                        return m_array_blocks;
+                }
+
+                /**
+                 * \brief Types eligible to the array optimization.
+                 *
+                 * The optimization is selected at compile time for arrays of numbers,
+                 * the actual format of the arrays is chosen at run time (see save_array).
+                 */
+                struct use_array_optimization
+                {
+                        template <class T>
+                        struct apply : public is_portable_array_type<T> {};
+                };
+
+                /**
+                 * \brief Save a contiguous array of numbers.
+                 *
+                 * The size of the elements is stored followed by the little endian bytes
+                 * of the whole array. Without array blocks, the numbers are stored one by
+                 * one exactly as done without the array optimization.
+                 */
+                template <class ValueType>
+                void save_array(boost::serialization::array_wrapper<ValueType> const& a, unsigned int)
+                {
+                        const ValueType * p = a.address();
+                        const std::size_t n = a.count();
+                        if (!m_array_blocks)
+                        {
+                                for (std::size_t i = 0; i < n; ++i) save(p[i]);
+                                return;
+                        }
+                        check_array(p, n);
+                        save_signed_char(sizeof(ValueType));
+                        save_binary(p, n * sizeof(ValueType));
+                }
+
                 //! Save narrow strings.
                 void save(const std::string& s)
                 {
@@ -393,11 +484,48 @@ namespace boost { namespace archive {
                 }
         };
 
-        // polymorphic portable binary oarchive typedef
-        typedef detail::polymorphic_oarchive_route<portable_oarchive> polymorphic_portable_oarchive;
+        /**
+         * \brief Polymorphic portable binary oarchive.
+         *
+         * The polymorphic interface saves arrays of numbers element by element,
+         * hence the archive always uses the format of version 6.0.
+         */
+        class polymorphic_portable_oarchive
+                : public detail::polymorphic_oarchive_route<portable_oarchive>
+        {
+        public:
+                polymorphic_portable_oarchive(std::ostream& os, unsigned flags = 0)
+                        : detail::polymorphic_oarchive_route<portable_oarchive>(os, flags | no_array_blocks)
+                {
+                }
+        };
+
+        /**
+         * \brief Save a vector of numbers (found by argument dependent lookup).
+         *
+         * Boost stores an optimized vector without the item version of the non
+         * optimized one. Without array blocks, we keep the latter format so that
+         * the archive remains readable by former versions.
+         */
+        template <class U, class Allocator>
+        inline void save(portable_oarchive& ar, const std::vector<U, Allocator>& t,
+                const unsigned int file_version, boost::mpl::true_)
+        {
+                if (!ar.has_array_blocks())
+                {
+                        boost::serialization::save(ar, t, file_version, boost::mpl::false_());
+                        return;
+                }
+                const boost::serialization::collection_size_type count(t.size());
+                ar << BOOST_SERIALIZATION_NVP(count);
+                if (!t.empty())
+                        ar << boost::serialization::make_array<const U, boost::serialization::collection_size_type>(
+                                static_cast<const U *>(&t[0]), count);
+        }
 
 } } // namespace boost::archive
 
 // required by export
 BOOST_SERIALIZATION_REGISTER_ARCHIVE(boost::archive::portable_oarchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(boost::archive::portable_oarchive)
 BOOST_SERIALIZATION_REGISTER_ARCHIVE(boost::archive::polymorphic_portable_oarchive)
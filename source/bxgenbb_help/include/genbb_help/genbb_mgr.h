@@ -46,6 +46,7 @@
 // This project:
 #include <genbb_help/i_genbb.h>
 #include <genbb_help/primary_event.h>
+#include <genbb_help/genbb_reader.h>
 
 // Implementation of serialization method for the 'primary_event'
 // class, implies also <genbb_help/primary_particle.ipp> :
@@ -81,6 +82,15 @@ namespace genbb {
 
     bool is_format_boost () const;
 
+    /// Check if GENBB text files are read through binary sidecar files
+    bool is_binary_sidecar () const;
+
+    /// Set the flag to read GENBB text files through binary sidecar files
+    ///
+    /// A missing or outdated binary sidecar file is created from
+    /// its GENBB text file (see genbb_reader::convert_to_binary).
+    void set_binary_sidecar (bool binary_sidecar_);
+
     /// Constructor
     genbb_mgr (int format_ = FORMAT_GENBB);
 
@@ -125,11 +135,10 @@ namespace genbb {
     std::list<std::string> _filenames_;    //!< List of input files' name
     std::string            _current_filename_; //!< Current file's name
     int                    _format_;       //!< Format of the input file
-    std::istream *         _in_;           //!< Handle to the current input stream
-    std::ifstream          _fin_;          //!< Current input file stream
-    datatools::data_reader _reader_;       //!< GENBB event reader
+    bool                   _binary_sidecar_; //!< Flag to read GENBB text files through binary sidecar files
+    genbb_reader           _genbb_reader_; //!< GENBB file reader
+    datatools::data_reader _reader_;       //!< Boost event reader
     primary_event          _current_;      //!< Current primary event
-    double                 _genbb_weight_; //!< GENBB event weight (for DBD energy range)
 
     GENBB_PG_REGISTRATION_INTERFACE(genbb_mgr)
 
@@ -0,0 +1,182 @@
+/// \file genbb_help/genbb_reader.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Streaming reader of GENBB event files
+ *
+ * History:
+ *
+ */
+
+#ifndef GENBB_HELP_GENBB_READER_H
+#define GENBB_HELP_GENBB_READER_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/noncopyable.hpp>
+
+namespace genbb {
+
+  class primary_event;
+
+  /// \brief Streaming reader of GENBB event files
+  ///
+  /// The reader maps the whole file in memory and parses the GENBB text
+  /// format with a dedicated numeric parser. Events are filled in place in
+  /// a recycled primary event (see primary_event::recycle), so that no
+  /// allocation is needed once the particle storage is warmed up.
+  ///
+  /// A GENBB text file can be converted in a compact binary file
+  /// (see convert_to_binary), which is read directly by later runs.
+  /// The format of the input file is automatically detected.
+  ///
+  /// Example of GENBB text file:
+  /// \code
+  /// #@toallevents=1.234
+  ///        0  0.00000       2
+  ///   3 -0.365426      0.802062E-01  0.462227      0.00000
+  ///   3 -0.127954      0.165289     -0.438456      0.00000
+  /// \endcode
+  class genbb_reader
+    : private boost::noncopyable
+  {
+  public:
+
+    /// \brief Format of the input file
+    enum format_type {
+      FORMAT_UNDEFINED = 0, //!< Undefined format
+      FORMAT_TEXT      = 1, //!< Native GENBB text format
+      FORMAT_BINARY    = 2  //!< Compact binary format
+    };
+
+    /// Return the default extension of binary sidecar files
+    static const std::string & binary_extension();
+
+    /// Return the name of the binary sidecar file associated to a GENBB text file
+    static std::string make_binary_filename(const std::string & filename_);
+
+    /// Check if a binary sidecar file exists and is up to date with respect to a GENBB text file
+    static bool has_valid_binary(const std::string & filename_,
+                                 const std::string & binary_filename_ = "");
+
+    /// Convert a GENBB text file in a binary file, returns the number of converted events
+    static std::size_t convert_to_binary(const std::string & filename_,
+                                         const std::string & binary_filename_ = "");
+
+    /// Default constructor
+    genbb_reader();
+
+    /// Destructor
+    ~genbb_reader();
+
+    /// Open a GENBB file (text or binary format)
+    void open(const std::string & filename_);
+
+    /// Check if a file is open
+    bool is_open() const;
+
+    /// Close the current file
+    void close();
+
+    /// Return the name of the current file
+    const std::string & get_filename() const;
+
+    /// Return the format of the current file
+    format_type get_format() const;
+
+    /// Return the current GENBB event weight (from the '#@toallevents' directive)
+    double get_genbb_weight() const;
+
+    /// Return the number of events loaded from the current file
+    std::size_t get_event_count() const;
+
+    /// Load the next event in place, returns false at end of file
+    bool load_next(primary_event & event_);
+
+  private:
+
+    /// \brief Particle record in GENBB units
+    struct particle_record
+    {
+      int32_t type;       //!< Geant3 particle type
+      double  px;         //!< Momentum X (MeV/c)
+      double  py;         //!< Momentum Y (MeV/c)
+      double  pz;         //!< Momentum Z (MeV/c)
+      double  time_shift; //!< Time shift with respect to the previous particle (s)
+    };
+
+    /// Parse the next event record, returns false at end of file
+    bool _parse_next_();
+
+    /// Parse the next event record from the text format
+    bool _parse_next_text_();
+
+    /// Parse the next event record from the binary format
+    bool _parse_next_binary_();
+
+    /// Parse a comment line at the current position
+    void _parse_comment_();
+
+    /// Skip white spaces
+    void _skip_spaces_();
+
+    /// Parse an integer
+    long _parse_integer_();
+
+    /// Parse a real number
+    double _parse_real_();
+
+    /// Return a description of the current position for error messages
+    std::string _where_() const;
+
+  private:
+
+    std::string _filename_;                         //!< Name of the current file
+    format_type _format_ = FORMAT_UNDEFINED;        //!< Format of the current file
+    int         _fd_ = -1;                          //!< File descriptor
+    void *      _map_ = nullptr;                    //!< Address of the memory mapped file
+    std::vector<char> _buffer_;                     //!< Buffer for files that cannot be mapped
+    const char * _begin_ = nullptr;                 //!< Beginning of the file contents
+    const char * _end_ = nullptr;                   //!< End of the file contents
+    const char * _cursor_ = nullptr;                //!< Current position in the file contents
+    std::size_t _size_ = 0;                         //!< Size of the file contents
+    double      _genbb_weight_ = 1.0;               //!< Current GENBB event weight
+    std::size_t _event_count_ = 0;                  //!< Number of loaded events
+    double      _event_time_ = 0.0;                 //!< Time of the current event record (s)
+    double      _event_weight_ = 1.0;               //!< Weight of the current event record
+    std::vector<particle_record> _particles_;       //!< Particles of the current event record
+
+  };
+
+} // end of namespace genbb
+
+#endif // GENBB_HELP_GENBB_READER_H
+
+// Local Variables: --
+// mode: c++ --
+// End: --
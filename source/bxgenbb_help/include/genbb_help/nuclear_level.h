@@ -104,11 +104,17 @@ namespace genbb {
       /// Return the cumulative probability
       double get_cumul_prob() const;
 
+      /// Return the level populated by the decay (null if it is stable)
+      const nuclear_level * get_next_level() const;
+
     private:
 
       const nuclear_decay * _decay_; //!< Handle to the nuclear decay
       double _branching_ratio_;      //!< Branching ratio
       double _cumul_prob_;           //!< Cumulative probability
+      const nuclear_level * _next_level_ = nullptr; //!< Handle to the unstable daughter level (precomputed)
+
+      friend class nuclear_level;
 
     };
 
@@ -260,6 +266,11 @@ namespace genbb {
     /// Return the decay channel table
     const decay_channels_col_type & get_decay_channels() const;
 
+    /// Pick a decay channel from a uniform random number in [0,1) (null if the level has no decay channel)
+    ///
+    /// The channel is chosen in constant time from the alias table built with the decay table.
+    const decay_channel * pick_decay_channel(double prob_) const;
+
   protected:
 
     /// Set defaults
@@ -268,6 +279,9 @@ namespace genbb {
     /// Compute the weights associated to the decay
     void _compute_decay_weights();
 
+    /// Build the alias table used to pick the decay channels
+    void _compute_alias_table();
+
   private:
 
     bool _initialized_;   //!< Initialization flag
@@ -280,6 +294,8 @@ namespace genbb {
     datatools::properties   _auxiliaries_;        //!< Auxiliary properties
     datatools::properties   _decay_table_config_; //!< Decay table configuration
     decay_channels_col_type _decay_channels_;     //!< The collection of decay channels
+    std::vector<double>     _alias_probs_;        //!< Acceptance probabilities of the alias table
+    std::vector<int>        _alias_indexes_;      //!< Alias channel indexes of the alias table
 
   };
 
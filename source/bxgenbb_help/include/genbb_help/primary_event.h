@@ -75,6 +75,12 @@ namespace genbb {
     /// Reset the primary event
     void reset();
 
+    /// Reset the primary event but recycle the storage of its particles
+    ///
+    /// The event is left with a given number of particles, all reset,
+    /// which can be filled in place with no allocation of new particles.
+    void recycle(std::size_t number_of_particles_);
+
     /// Check if time is defined
     bool has_time() const;
 
@@ -35,9 +35,6 @@
 #include <CLHEP/Units/SystemOfUnits.h>
 #include <CLHEP/Units/PhysicalConstants.h>
 #include <CLHEP/Vector/ThreeVector.h>
-// - Boost:
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/classification.hpp>
 // - Bayeux/datatools:
 #include <datatools/utils.h>
 #include <datatools/exception.h>
@@ -100,14 +97,25 @@ namespace genbb {
     return _format_ == FORMAT_BOOST;
   }
 
+  bool genbb_mgr::is_binary_sidecar () const
+  {
+    return _binary_sidecar_;
+  }
+
+  void genbb_mgr::set_binary_sidecar (bool binary_sidecar_)
+  {
+    DT_THROW_IF(_initialized_, logic_error, "Operation not allowed ! Manager is locked !");
+    _binary_sidecar_ = binary_sidecar_;
+    return;
+  }
+
   // ctor:
   genbb_mgr::genbb_mgr (int format_)
   {
     _debug_ = false;
     _initialized_ = false;
-    _in_ = 0;
     _format_ = FORMAT_GENBB;
-    _genbb_weight_ = 1.0;
+    _binary_sidecar_ = false;
     set_format (format_);
     return;
   }
@@ -214,11 +222,12 @@ namespace genbb {
 
   void genbb_mgr::_load_next_ ()
   {
-    _current_.reset();
     if (_format_ == FORMAT_GENBB) {
+      // The current event is recycled by the GENBB reader:
       _load_next_genbb_ ();
     }
     if (_format_ == FORMAT_BOOST) {
+      _current_.reset();
       _load_next_boost_ ();
     }
     return;
@@ -226,129 +235,49 @@ namespace genbb {
 
   void genbb_mgr::_load_next_genbb_ ()
   {
-    if (_in_ == 0) {
-      if (is_debug ()) clog << "genbb::genbb_mgr::_load_next_genbb_: No input stream!" << endl;
-      _genbb_weight_ = 1.0;
-      string filename;
-
-      if (_filenames_.size () == 0) {
-        if (is_debug ()) clog << "genbb::genbb_mgr::_load_next_genbb_: No more filenames!" << endl;
-        return;
-      }
-
-      filename = _filenames_.front ();
-      _filenames_.pop_front ();
-      if (filename.empty ()) {
-        if (is_debug ()) clog << "DEVEL: genbb_mgr::_load_next_genbb_: Input filename = '" << filename << "'" << endl;
-        return;
-      }
-      datatools::fetch_path_with_env (filename);
-      if (is_debug ()) clog << "DEVEL: genbb_mgr::_load_next_genbb_: Input filename = '" << filename << "'" << endl;
-      _fin_.close ();
-      _fin_.open (filename.c_str ());
-      DT_THROW_IF (! _fin_,runtime_error,
-                   "Cannot open file '" << filename << "' !");
-      _in_ = &_fin_;
-      _current_filename_ = filename;
-    }
-
-    std::string line;
     while (true) {
-      std::string token;
-      std::getline (*_in_, line);
-      {
-        std::istringstream line_iss (line);
-        line_iss >> token;
-      }
-      if (token.empty ()) {
-        // skip white lines :
-        continue;
-      }
-      if (token[0] != '#') {
-        break;
-      }
-      if (token.length () == 1) {
-        // skip empty comment lines :
-        continue;
-      }
-      // parse special comment :
-      if (token[1] != '@') {
-        // skip pure comment lines :
-        continue;
-      }
-      typedef vector<string> split_vector_type;
-      split_vector_type svec;
-      boost::algorithm::split(svec, line,
-                              boost::algorithm::is_any_of("="),
-                              boost::algorithm::token_compress_on );
-      DT_THROW_IF (svec.size () != 2,
-                   logic_error,
-                   "Invalid syntax (" << line << ") !");
-      if (svec[0] == "#@toallevents") {
-        std::istringstream iss (svec[1]);
-        double toallevents = 1.0;
-        iss >> toallevents;
-        DT_THROW_IF (! iss || toallevents < 0.0,
-                     logic_error,
-                     "Invalid value for 'toallevents' weight (" << line << ") !");
-        _genbb_weight_ = 1.0  / toallevents;
-        std::clog << "NOTICE: genbb::genbb_mgr::_load_next_genbb_: "
-                  << "Load GENBB event weight = " << _genbb_weight_ << std::endl;
+      if (! _genbb_reader_.is_open ()) {
+        if (_filenames_.size () == 0) {
+          if (is_debug ()) clog << "genbb::genbb_mgr::_load_next_genbb_: No more filenames!" << endl;
+          _current_.reset ();
+          return;
+        }
+        string filename = _filenames_.front ();
+        _filenames_.pop_front ();
+        if (filename.empty ()) {
+          if (is_debug ()) clog << "DEVEL: genbb_mgr::_load_next_genbb_: Input filename = '" << filename << "'" << endl;
+          _current_.reset ();
+          return;
+        }
+        datatools::fetch_path_with_env (filename);
+        if (is_debug ()) clog << "DEVEL: genbb_mgr::_load_next_genbb_: Input filename = '" << filename << "'" << endl;
+        string input_filename = filename;
+        if (_binary_sidecar_) {
+          const string binary_filename = genbb_reader::make_binary_filename (filename);
+          if (genbb_reader::has_valid_binary (filename, binary_filename)) {
+            input_filename = binary_filename;
+          } else {
+            try {
+              size_t nevents = genbb_reader::convert_to_binary (filename, binary_filename);
+              DT_LOG_NOTICE(get_logging_priority (),
+                            "Converted " << nevents << " events from GENBB file '" << filename
+                            << "' in binary file '" << binary_filename << "'.");
+              input_filename = binary_filename;
+            } catch (std::exception & error) {
+              DT_LOG_WARNING(get_logging_priority (),
+                             "Cannot create binary file '" << binary_filename << "': " << error.what ()
+                             << " Reading GENBB file '" << filename << "'...");
+            }
+          }
+        }
+        _genbb_reader_.open (input_filename);
+        _current_filename_ = filename;
       }
-    }
-
-    if (is_debug ()) clog << "DEVEL: genbb_mgr::_load_next_genbb_: _in_ = " << _in_ << endl;
-
-    DT_THROW_IF (! *_in_, logic_error, "Cannot load event !");
-    int evnum;
-    double time;
-    int npart;
-    {
-      std::istringstream line_iss (line);
-      line_iss >> ws >> evnum >> time >> npart >> ws;
-      // Only throw if stream is bad and NOT at eof. Some c++ libraries
-      // (Apple clang on Mavericks) will set bad/failbit at eof. Seems
-      // not to be C++11 standard compliant, but is still present!
-      DT_THROW_IF (! line_iss && !line_iss.eof(),
-                   logic_error,
-                   "Format error !");
-    }
-
-    /*
-     *_in_ >> ws >> evnum >> time >> npart;
-     if (! *_in_)
-     {
-     ostringstream message;
-     message << "genbb::genbb_mgr::_load_next_genbb_: format error!";
-     th row logic_error (message.str ());
-     }
-    */
-    _current_.set_time (time * CLHEP::second);
-    _current_.set_genbb_weight (_genbb_weight_);
-    double part_time = 0.0;
-    for (int i = 0; i < npart; i++) {
-      primary_particle pp;
-      int part_type;
-      double x, y ,z, time_shift;
-      // 2009-07-14 FM: Vladimir Tretyak email about particles' time shifts:
-      *_in_ >> ws >> part_type >> x >> y >> z >> time_shift;
-      part_time += time_shift;
-      pp.set_type (part_type);
-      pp.set_time (part_time * CLHEP::second); // GENBB unit is s
-      if (! *_in_) {
-        _fin_.close ();
-        _in_ = 0;
-        DT_THROW_IF(true, logic_error, "Format error !");
+      // Fill the current event in place:
+      if (_genbb_reader_.load_next (_current_)) {
+        return;
       }
-      geomtools::vector_3d p (x, y, z);
-      p *= CLHEP::MeV; // GENBB unit is MeV/c
-      pp.set_momentum (p);
-      _current_.add_particle (pp);
-    }
-    *_in_ >> ws;
-    if (_fin_.eof ()) {
-      _fin_.close ();
-      _in_ = 0;
+      _genbb_reader_.close ();
     }
     return;
   }
@@ -380,8 +309,19 @@ namespace genbb {
       }
     if (_format_ == FORMAT_GENBB)
       {
-        out_ << "|-- GENBB current file address : " << hex << _in_
-             << dec << endl;
+        out_ << "|-- Binary sidecar files : " << (_binary_sidecar_? "Yes": "No") << endl;
+        out_ << "|-- GENBB current file : ";
+        if (_genbb_reader_.is_open ())
+          {
+            out_ << "'" << _genbb_reader_.get_filename () << "' ("
+                 << (_genbb_reader_.get_format () == genbb_reader::FORMAT_BINARY? "binary": "text")
+                 << ")";
+          }
+        else
+          {
+            out_ << "<none>";
+          }
+        out_ << endl;
       }
     if (_format_ == FORMAT_BOOST)
       {
@@ -414,6 +354,10 @@ namespace genbb {
       string format = config_.fetch_string ("format");
       set_format (format);
     }
+
+    if (config_.has_key ("binary_sidecar")) {
+      set_binary_sidecar (config_.fetch_boolean ("binary_sidecar"));
+    }
     // else
     //   {
     //     th row logic_error ("genbb::genbb_mgr::initialize: Missing 'format' of input files !");
@@ -505,16 +449,14 @@ namespace genbb {
 
   void genbb_mgr::_at_reset_ ()
   {
-    _genbb_weight_ = 1.0;
     _current_filename_ = "";
     _filenames_.clear ();
 
     // "genbb"
     if (_format_ == FORMAT_GENBB) {
-      if (_in_ != 0)
+      if (_genbb_reader_.is_open ())
         {
-          _in_ = 0;
-          _fin_.close ();
+          _genbb_reader_.close ();
         }
     }
 
@@ -525,6 +467,7 @@ namespace genbb {
       }
     }
     _format_ = FORMAT_GENBB;
+    _binary_sidecar_ = false;
 
     return;
   }
@@ -0,0 +1,574 @@
+// genbb_reader.cc
+/*
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Ourselves:
+#include <genbb_help/genbb_reader.h>
+
+// Standard library:
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// Third party:
+// - CLHEP:
+#include <CLHEP/Units/SystemOfUnits.h>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/logger.h>
+// - Bayeux/geomtools:
+#include <geomtools/utils.h>
+
+// This project:
+#include <genbb_help/primary_event.h>
+
+namespace genbb {
+
+  namespace {
+
+    /// Magic string at the beginning of binary files
+    const char BINARY_MAGIC[8] = {'G', 'E', 'N', 'B', 'B', 'B', 'I', 'N'};
+
+    /// Version of the binary format
+    const uint32_t BINARY_VERSION = 1;
+
+    /// Byte order mark of the binary format
+    const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+    /// Size of the header of binary files
+    const std::size_t BINARY_HEADER_SIZE = sizeof(BINARY_MAGIC) + 2 * sizeof(uint32_t);
+
+    /// Size of an event record in binary files (time, weight, number of particles)
+    const std::size_t BINARY_EVENT_SIZE = 2 * sizeof(double) + sizeof(uint32_t);
+
+    /// Size of a particle record in binary files (type, momentum, time shift)
+    const std::size_t BINARY_PARTICLE_SIZE = sizeof(int32_t) + 4 * sizeof(double);
+
+    /// Exact powers of ten for the fast conversion of real numbers
+    const double EXACT_POWERS_OF_TEN[23] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    inline bool is_space(char c_)
+    {
+      return c_ == ' ' || c_ == '\t' || c_ == '\n' || c_ == '\r' || c_ == '\f' || c_ == '\v';
+    }
+
+    inline bool is_digit(char c_)
+    {
+      return c_ >= '0' && c_ <= '9';
+    }
+
+    template <typename T>
+    inline void read_binary(const char *& cursor_, T & value_)
+    {
+      std::memcpy(&value_, cursor_, sizeof(T));
+      cursor_ += sizeof(T);
+      return;
+    }
+
+    template <typename T>
+    inline void write_binary(std::ostream & out_, const T & value_)
+    {
+      out_.write(reinterpret_cast<const char *>(&value_), sizeof(T));
+      return;
+    }
+
+  } // end of anonymous namespace
+
+  // static
+  const std::string & genbb_reader::binary_extension()
+  {
+    static const std::string ext(".bin");
+    return ext;
+  }
+
+  // static
+  std::string genbb_reader::make_binary_filename(const std::string & filename_)
+  {
+    return filename_ + binary_extension();
+  }
+
+  // static
+  bool genbb_reader::has_valid_binary(const std::string & filename_,
+                                      const std::string & binary_filename_)
+  {
+    std::string binary_filename = binary_filename_;
+    if (binary_filename.empty()) {
+      binary_filename = make_binary_filename(filename_);
+    }
+    struct stat binary_stat;
+    if (::stat(binary_filename.c_str(), &binary_stat) != 0) {
+      return false;
+    }
+    struct stat text_stat;
+    if (::stat(filename_.c_str(), &text_stat) != 0) {
+      // The text file is not available anymore:
+      return true;
+    }
+    return binary_stat.st_mtime >= text_stat.st_mtime;
+  }
+
+  // static
+  std::size_t genbb_reader::convert_to_binary(const std::string & filename_,
+                                              const std::string & binary_filename_)
+  {
+    std::string binary_filename = binary_filename_;
+    if (binary_filename.empty()) {
+      binary_filename = make_binary_filename(filename_);
+    }
+    genbb_reader reader;
+    reader.open(filename_);
+    DT_THROW_IF(reader.get_format() != FORMAT_TEXT, std::logic_error,
+                "File '" << filename_ << "' is not a GENBB text file!");
+    // The binary file is written aside then renamed, so that concurrent runs never read a partial file:
+    std::ostringstream tmp_filename_oss;
+    tmp_filename_oss << binary_filename << ".tmp." << ::getpid();
+    const std::string tmp_filename = tmp_filename_oss.str();
+    std::size_t count = 0;
+    {
+      std::ofstream out(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+      DT_THROW_IF(!out, std::runtime_error, "Cannot create binary file '" << tmp_filename << "'!");
+      out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+      write_binary(out, BINARY_VERSION);
+      write_binary(out, BINARY_BYTE_ORDER);
+      try {
+        while (reader._parse_next_()) {
+          write_binary(out, reader._event_time_);
+          write_binary(out, reader._event_weight_);
+          write_binary(out, static_cast<uint32_t>(reader._particles_.size()));
+          for (const particle_record & rec : reader._particles_) {
+            write_binary(out, rec.type);
+            write_binary(out, rec.px);
+            write_binary(out, rec.py);
+            write_binary(out, rec.pz);
+            write_binary(out, rec.time_shift);
+          }
+          count++;
+        }
+      } catch (std::exception &) {
+        out.close();
+        std::remove(tmp_filename.c_str());
+        throw;
+      }
+      out.close();
+      if (!out) {
+        std::remove(tmp_filename.c_str());
+        DT_THROW(std::runtime_error, "Cannot write binary file '" << tmp_filename << "'!");
+      }
+    }
+    if (std::rename(tmp_filename.c_str(), binary_filename.c_str()) != 0) {
+      std::remove(tmp_filename.c_str());
+      DT_THROW(std::runtime_error, "Cannot create binary file '" << binary_filename << "'!");
+    }
+    return count;
+  }
+
+  genbb_reader::genbb_reader()
+  {
+    return;
+  }
+
+  genbb_reader::~genbb_reader()
+  {
+    close();
+    return;
+  }
+
+  bool genbb_reader::is_open() const
+  {
+    return _format_ != FORMAT_UNDEFINED;
+  }
+
+  const std::string & genbb_reader::get_filename() const
+  {
+    return _filename_;
+  }
+
+  genbb_reader::format_type genbb_reader::get_format() const
+  {
+    return _format_;
+  }
+
+  double genbb_reader::get_genbb_weight() const
+  {
+    return _genbb_weight_;
+  }
+
+  std::size_t genbb_reader::get_event_count() const
+  {
+    return _event_count_;
+  }
+
+  void genbb_reader::open(const std::string & filename_)
+  {
+    close();
+    _fd_ = ::open(filename_.c_str(), O_RDONLY);
+    DT_THROW_IF(_fd_ < 0, std::runtime_error, "Cannot open file '" << filename_ << "'!");
+    struct stat file_stat;
+    if (::fstat(_fd_, &file_stat) != 0) {
+      close();
+      DT_THROW(std::runtime_error, "Cannot stat file '" << filename_ << "'!");
+    }
+    _size_ = file_stat.st_size;
+    if (_size_ > 0) {
+      void * map = ::mmap(nullptr, _size_, PROT_READ, MAP_PRIVATE, _fd_, 0);
+      if (map != MAP_FAILED) {
+        _map_ = map;
+        ::madvise(_map_, _size_, MADV_SEQUENTIAL);
+        _begin_ = static_cast<const char *>(_map_);
+      } else {
+        // Fallback for files which cannot be mapped:
+        _buffer_.resize(_size_);
+        std::size_t nread = 0;
+        while (nread < _size_) {
+          ssize_t n = ::read(_fd_, _buffer_.data() + nread, _size_ - nread);
+          if (n < 0 && errno == EINTR) continue;
+          if (n <= 0) {
+            close();
+            DT_THROW(std::runtime_error, "Cannot read file '" << filename_ << "'!");
+          }
+          nread += n;
+        }
+        _begin_ = _buffer_.data();
+      }
+    }
+    _end_ = _begin_ + _size_;
+    _cursor_ = _begin_;
+    _filename_ = filename_;
+    _format_ = FORMAT_TEXT;
+    if (_size_ >= sizeof(BINARY_MAGIC) && std::memcmp(_begin_, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+      uint32_t version = 0;
+      uint32_t byte_order = 0;
+      if (_size_ >= BINARY_HEADER_SIZE) {
+        _cursor_ += sizeof(BINARY_MAGIC);
+        read_binary(_cursor_, version);
+        read_binary(_cursor_, byte_order);
+      }
+      if (version != BINARY_VERSION || byte_order != BINARY_BYTE_ORDER) {
+        close();
+        DT_THROW(std::runtime_error, "Unsupported format or byte order for binary GENBB file '" << filename_ << "'!");
+      }
+      _format_ = FORMAT_BINARY;
+    }
+    return;
+  }
+
+  void genbb_reader::close()
+  {
+    if (_map_ != nullptr) {
+      ::munmap(_map_, _size_);
+      _map_ = nullptr;
+    }
+    if (_fd_ >= 0) {
+      ::close(_fd_);
+      _fd_ = -1;
+    }
+    std::vector<char>().swap(_buffer_);
+    _begin_ = nullptr;
+    _end_ = nullptr;
+    _cursor_ = nullptr;
+    _size_ = 0;
+    _filename_.clear();
+    _format_ = FORMAT_UNDEFINED;
+    _genbb_weight_ = 1.0;
+    _event_count_ = 0;
+    return;
+  }
+
+  bool genbb_reader::load_next(primary_event & event_)
+  {
+    if (!_parse_next_()) {
+      return false;
+    }
+    event_.recycle(_particles_.size());
+    event_.set_time(_event_time_ * CLHEP::second);
+    event_.set_genbb_weight(_event_weight_);
+    double part_time = 0.0;
+    std::vector<particle_record>::const_iterator rec = _particles_.begin();
+    for (primary_event::particles_col_type::iterator i = event_.grab_particles().begin();
+         i != event_.grab_particles().end();
+         i++, rec++) {
+      primary_particle & pp = *i;
+      // 2009-07-14 FM: Vladimir Tretyak email about particles' time shifts:
+      part_time += rec->time_shift;
+      pp.set_type(rec->type);
+      pp.set_time(part_time * CLHEP::second); // GENBB unit is s
+      pp.set_momentum(geomtools::vector_3d(rec->px * CLHEP::MeV, // GENBB unit is MeV/c
+                                           rec->py * CLHEP::MeV,
+                                           rec->pz * CLHEP::MeV));
+    }
+    _event_count_++;
+    return true;
+  }
+
+  bool genbb_reader::_parse_next_()
+  {
+    DT_THROW_IF(!is_open(), std::logic_error, "No open GENBB file!");
+    if (_format_ == FORMAT_BINARY) {
+      return _parse_next_binary_();
+    }
+    return _parse_next_text_();
+  }
+
+  bool genbb_reader::_parse_next_binary_()
+  {
+    if (_cursor_ == _end_) {
+      return false;
+    }
+    DT_THROW_IF(static_cast<std::size_t>(_end_ - _cursor_) < BINARY_EVENT_SIZE,
+                std::runtime_error, "Truncated event record " << _where_() << "!");
+    uint32_t npart = 0;
+    read_binary(_cursor_, _event_time_);
+    read_binary(_cursor_, _event_weight_);
+    read_binary(_cursor_, npart);
+    DT_THROW_IF(static_cast<std::size_t>(_end_ - _cursor_) < npart * BINARY_PARTICLE_SIZE,
+                std::runtime_error, "Truncated particle records " << _where_() << "!");
+    _particles_.resize(npart);
+    for (particle_record & rec : _particles_) {
+      read_binary(_cursor_, rec.type);
+      read_binary(_cursor_, rec.px);
+      read_binary(_cursor_, rec.py);
+      read_binary(_cursor_, rec.pz);
+      read_binary(_cursor_, rec.time_shift);
+    }
+    _genbb_weight_ = _event_weight_;
+    return true;
+  }
+
+  bool genbb_reader::_parse_next_text_()
+  {
+    // Skip white and comment lines:
+    while (true) {
+      _skip_spaces_();
+      if (_cursor_ == _end_) {
+        return false;
+      }
+      if (*_cursor_ != '#') {
+        break;
+      }
+      _parse_comment_();
+    }
+    // Event record: event number, time and number of particles:
+    _parse_integer_();
+    _event_time_ = _parse_real_();
+    const long npart = _parse_integer_();
+    DT_THROW_IF(npart < 0, std::logic_error, "Invalid number of particles " << _where_() << "!");
+    _event_weight_ = _genbb_weight_;
+    _particles_.resize(npart);
+    for (particle_record & rec : _particles_) {
+      rec.type = _parse_integer_();
+      rec.px = _parse_real_();
+      rec.py = _parse_real_();
+      rec.pz = _parse_real_();
+      rec.time_shift = _parse_real_();
+    }
+    return true;
+  }
+
+  void genbb_reader::_parse_comment_()
+  {
+    const char * line = _cursor_;
+    const char * eol = static_cast<const char *>(std::memchr(line, '\n', _end_ - line));
+    if (eol == nullptr) {
+      eol = _end_;
+    }
+    _cursor_ = eol;
+    if (eol - line < 2 || line[1] != '@') {
+      // Skip empty and pure comment lines:
+      return;
+    }
+    // Parse special comment:
+    const char * eq = static_cast<const char *>(std::memchr(line, '=', eol - line));
+    const char * value = eq;
+    while (value != nullptr && value != eol && *value == '=') {
+      value++;
+    }
+    DT_THROW_IF(eq == nullptr || eq == line || std::memchr(value, '=', eol - value) != nullptr,
+                std::logic_error,
+                "Invalid syntax (" << std::string(line, eol) << ") " << _where_() << "!");
+    static const std::string toallevents_key = "#@toallevents";
+    if (static_cast<std::size_t>(eq - line) == toallevents_key.length()
+        && std::memcmp(line, toallevents_key.data(), toallevents_key.length()) == 0) {
+      _cursor_ = value;
+      double toallevents = 1.0;
+      try {
+        toallevents = _parse_real_();
+      } catch (std::exception &) {
+        DT_THROW(std::logic_error,
+                 "Invalid format for 'toallevents' weight (" << std::string(line, eol) << ")!");
+      }
+      DT_THROW_IF(_cursor_ > eol || toallevents <= 0.0, std::logic_error,
+                  "Invalid value for 'toallevents' weight (" << std::string(line, eol) << ")!");
+      _cursor_ = eol;
+      _genbb_weight_ = 1.0 / toallevents;
+      DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Load GENBB event weight = " << _genbb_weight_);
+    }
+    return;
+  }
+
+  void genbb_reader::_skip_spaces_()
+  {
+    while (_cursor_ != _end_ && is_space(*_cursor_)) {
+      _cursor_++;
+    }
+    return;
+  }
+
+  long genbb_reader::_parse_integer_()
+  {
+    _skip_spaces_();
+    const char * p = _cursor_;
+    bool negative = false;
+    if (p != _end_ && (*p == '+' || *p == '-')) {
+      negative = (*p == '-');
+      p++;
+    }
+    const char * digits = p;
+    long value = 0;
+    while (p != _end_ && is_digit(*p)) {
+      value = 10 * value + (*p - '0');
+      p++;
+    }
+    DT_THROW_IF(p == digits || p - digits > 18 || (p != _end_ && !is_space(*p)),
+                std::logic_error, "Format error: invalid integer " << _where_() << "!");
+    _cursor_ = p;
+    return negative ? -value : value;
+  }
+
+  double genbb_reader::_parse_real_()
+  {
+    _skip_spaces_();
+    const char * token = _cursor_;
+    const char * p = token;
+    bool negative = false;
+    if (p != _end_ && (*p == '+' || *p == '-')) {
+      negative = (*p == '-');
+      p++;
+    }
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    while (p != _end_ && is_digit(*p)) {
+      has_digits = true;
+      if (mantissa != 0 || *p != '0') {
+        if (significant_digits < 19) {
+          mantissa = 10 * mantissa + (*p - '0');
+        } else {
+          exponent++;
+        }
+        significant_digits++;
+      }
+      p++;
+    }
+    if (p != _end_ && *p == '.') {
+      p++;
+      while (p != _end_ && is_digit(*p)) {
+        has_digits = true;
+        if (mantissa != 0 || *p != '0') {
+          if (significant_digits < 19) {
+            mantissa = 10 * mantissa + (*p - '0');
+            exponent--;
+          }
+          significant_digits++;
+        } else {
+          exponent--;
+        }
+        p++;
+      }
+    }
+    bool valid = has_digits;
+    if (valid && p != _end_ && (*p == 'e' || *p == 'E')) {
+      p++;
+      bool negative_exponent = false;
+      if (p != _end_ && (*p == '+' || *p == '-')) {
+        negative_exponent = (*p == '-');
+        p++;
+      }
+      const char * exponent_digits = p;
+      int explicit_exponent = 0;
+      while (p != _end_ && is_digit(*p)) {
+        if (explicit_exponent < 10000) {
+          explicit_exponent = 10 * explicit_exponent + (*p - '0');
+        }
+        p++;
+      }
+      valid = (p != exponent_digits);
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+    if (valid && (p == _end_ || is_space(*p))
+        && significant_digits <= 15 && exponent >= -22 && exponent <= 22) {
+      // Fast path: both the mantissa and the power of ten are exact doubles,
+      // so the result is correctly rounded:
+      double value = static_cast<double>(mantissa);
+      if (exponent < 0) {
+        value /= EXACT_POWERS_OF_TEN[-exponent];
+      } else {
+        value *= EXACT_POWERS_OF_TEN[exponent];
+      }
+      _cursor_ = p;
+      return negative ? -value : value;
+    }
+    // Slow path for uncommon representations:
+    while (p != _end_ && !is_space(*p)) {
+      p++;
+    }
+    char buffer[64];
+    const std::size_t length = p - token;
+    DT_THROW_IF(length == 0 || length >= sizeof(buffer), std::logic_error,
+                "Format error: invalid real number " << _where_() << "!");
+    std::memcpy(buffer, token, length);
+    buffer[length] = '\0';
+    char * parse_end = nullptr;
+    const double value = std::strtod(buffer, &parse_end);
+    DT_THROW_IF(parse_end != buffer + length, std::logic_error,
+                "Format error: invalid real number '" << buffer << "' " << _where_() << "!");
+    _cursor_ = p;
+    return value;
+  }
+
+  std::string genbb_reader::_where_() const
+  {
+    std::ostringstream where_oss;
+    where_oss << "in file '" << _filename_ << "'";
+    if (_format_ == FORMAT_TEXT && _cursor_ != nullptr) {
+      std::size_t line = 1;
+      for (const char * p = _begin_; p != _cursor_; p++) {
+        if (*p == '\n') line++;
+      }
+      where_oss << " at line " << line;
+    } else if (_cursor_ != nullptr) {
+      where_oss << " at offset " << (_cursor_ - _begin_);
+    }
+    return where_oss.str();
+  }
+
+} // end of namespace genbb
@@ -186,20 +186,12 @@ namespace genbb {
       DT_LOG_TRACE(get_logging_priority(),
                    "Decaying the level '" << current_level->to_string() << "'");
 
+      // Constant time choice of the decay channel:
       double prob_level = grab_random().flat(0.0, 1.0);
-      const nuclear_decay * current_decay = 0;
-      for (size_t ichannel = 0;
-           ichannel < current_level->get_number_of_decay_channels();
-           ichannel++) {
-        const nuclear_level::decay_channel & channel
-          = current_level->get_decay_channel(ichannel);
-        if (prob_level <= channel.get_cumul_prob()) {
-          current_decay = &channel.get_decay();
-          break;
-        }
-      }
+      const nuclear_level::decay_channel * channel = current_level->pick_decay_channel(prob_level);
 
-      if (current_decay) {
+      if (channel) {
+        const nuclear_decay * current_decay = &channel->get_decay();
         DT_LOG_TRACE(get_logging_priority(),
                      "Processing the decay '" << current_decay->to_string() << "'");
         base_decay_driver & driver = const_cast<nuclear_decay*>(current_decay)->grab_decay_driver();
@@ -209,11 +201,11 @@ namespace genbb {
         int err = driver.fill(grab_random(), event_);
         DT_THROW_IF (err != 0, std::logic_error,"Decay failed!");
 
-        current_level = &current_decay->get_level_final();
-        if (current_level->is_stable()) {
+        // Precomputed link to the next unstable level of the cascade:
+        current_level = channel->get_next_level();
+        if (! current_level) {
           DT_LOG_TRACE(get_logging_priority(),
-                       "Final level '" << current_level->to_string() << "' is stable.");
-          current_level = 0;
+                       "Final level '" << current_decay->get_level_final().to_string() << "' is stable.");
         }
       } else {
         current_level = 0;
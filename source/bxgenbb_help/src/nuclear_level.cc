@@ -184,6 +184,7 @@ namespace genbb {
     _branching_ratio_ = 0.0;
     _cumul_prob_ = 1.0;
     _decay_ = 0;
+    _next_level_ = nullptr;
     return;
   }
 
@@ -203,6 +204,11 @@ namespace genbb {
     return _cumul_prob_;
   }
 
+  const nuclear_level * nuclear_level::decay_channel::get_next_level() const
+  {
+    return _next_level_;
+  }
+
   nuclear_level::nuclear_level()
   {
     _initialized_ = false;
@@ -370,6 +376,8 @@ namespace genbb {
   void nuclear_level::reset_decay_table()
   {
     _decay_channels_.clear();
+    _alias_probs_.clear();
+    _alias_indexes_.clear();
     return;
   }
 
@@ -608,10 +616,68 @@ namespace genbb {
       decay_channel & channel = _decay_channels_[i];
       // Now we store the normalized probability:
       channel.set_cumul_prob(weights[i] / wsum);
+      // Direct link to the next level of the cascade:
+      const nuclear_level & level_final = channel.get_decay().get_level_final();
+      channel._next_level_ = level_final.is_stable() ? nullptr : &level_final;
+    }
+    _compute_alias_table();
+    return;
+  }
+
+  void nuclear_level::_compute_alias_table()
+  {
+    // Vose's alias method:
+    const int nchannels = _decay_channels_.size();
+    _alias_probs_.assign(nchannels, 1.0);
+    _alias_indexes_.resize(nchannels);
+    if (nchannels == 0) return;
+    double wsum = 0.0;
+    for (int i = 0; i < nchannels; i++) {
+      wsum += _decay_channels_[i].get_branching_ratio();
+      _alias_indexes_[i] = i;
     }
+    std::vector<double> scaled(nchannels);
+    std::vector<int> small;
+    std::vector<int> large;
+    for (int i = 0; i < nchannels; i++) {
+      scaled[i] = _decay_channels_[i].get_branching_ratio() * nchannels / wsum;
+      if (scaled[i] < 1.0) {
+        small.push_back(i);
+      } else {
+        large.push_back(i);
+      }
+    }
+    while (!small.empty() && !large.empty()) {
+      const int s = small.back();
+      small.pop_back();
+      const int l = large.back();
+      _alias_probs_[s] = scaled[s];
+      _alias_indexes_[s] = l;
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      if (scaled[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // Remaining entries are only affected by rounding errors:
+    for (int i : large) _alias_probs_[i] = 1.0;
+    for (int i : small) _alias_probs_[i] = 1.0;
     return;
   }
 
+  const nuclear_level::decay_channel * nuclear_level::pick_decay_channel(double prob_) const
+  {
+    const int nchannels = _decay_channels_.size();
+    if (nchannels == 0) return nullptr;
+    const double x = prob_ * nchannels;
+    int index = (int) x;
+    if (index >= nchannels) index = nchannels - 1;
+    if (x - index >= _alias_probs_[index]) {
+      index = _alias_indexes_[index];
+    }
+    return &_decay_channels_[index];
+  }
+
   std::string nuclear_level::to_string(unsigned int) const
   {
     std::ostringstream oss;
@@ -91,6 +91,21 @@ namespace genbb {
     return;
   }
 
+  void primary_event::recycle(std::size_t number_of_particles_)
+  {
+    _auxiliaries_.clear();
+    reset_classification();
+    reset_label();
+    _particles_.resize(number_of_particles_);
+    for (particles_col_type::iterator i = _particles_.begin();
+         i != _particles_.end();
+         i++) {
+      i->reset();
+    }
+    _set_defaults();
+    return;
+  }
+
   double primary_event::get_total_kinetic_energy() const
   {
     double tke = 0.;
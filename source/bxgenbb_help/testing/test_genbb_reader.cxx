@@ -0,0 +1,279 @@
+// test_genbb_reader.cxx
+
+// Standard library:
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <exception>
+#include <stdexcept>
+#include <random>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/units.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/utils.h>
+#include <datatools/properties.h>
+
+// This project:
+#include <genbb_help/genbb_reader.h>
+#include <genbb_help/genbb_mgr.h>
+#include <genbb_help/primary_event.h>
+
+// Reference stream-based parser of GENBB text files (historical genbb_mgr implementation)
+bool legacy_load_next(std::istream & in_, double & weight_, genbb::primary_event & event_);
+
+// Check that two events are identical
+void check_events(const genbb::primary_event & event_, const genbb::primary_event & expected_);
+
+// Generate a sample GENBB text file
+void make_sample(const std::string & filename_, std::size_t nevents_);
+
+int main(int argc_, char ** argv_)
+{
+  using namespace std;
+  int error_code = EXIT_SUCCESS;
+  try {
+    clog << "Test program for class 'genbb::genbb_reader'!" << endl;
+    int many = 0;
+    int iarg = 1;
+    while (iarg < argc_) {
+      string arg = argv_[iarg];
+      if (arg == "-m" || arg == "--many") many++;
+      iarg++;
+    }
+
+    // Compare with the reference parser:
+    const char * data_files[] = {
+      "${GENBB_HELP_TESTING_DIR}/data/bipo212_1.genbb",
+      "${GENBB_HELP_TESTING_DIR}/data/se82_0nubb_mn.genbb",
+      "${GENBB_HELP_TESTING_DIR}/data/se82_2nubb.genbb",
+      0
+    };
+    for (int ifile = 0; data_files[ifile] != 0; ifile++) {
+      string filename = data_files[ifile];
+      datatools::fetch_path_with_env(filename);
+      const string binary_filename = "test_genbb_reader.genbb.bin";
+      const size_t nconverted = genbb::genbb_reader::convert_to_binary(filename, binary_filename);
+      ifstream legacy_in(filename.c_str());
+      double legacy_weight = 1.0;
+      genbb::genbb_reader text_reader;
+      text_reader.open(filename);
+      DT_THROW_IF(text_reader.get_format() != genbb::genbb_reader::FORMAT_TEXT, std::logic_error,
+                  "Unexpected format for file '" << filename << "'!");
+      genbb::genbb_reader binary_reader;
+      binary_reader.open(binary_filename);
+      DT_THROW_IF(binary_reader.get_format() != genbb::genbb_reader::FORMAT_BINARY, std::logic_error,
+                  "Unexpected format for file '" << binary_filename << "'!");
+      genbb::primary_event expected;
+      genbb::primary_event text_event;
+      genbb::primary_event binary_event;
+      size_t count = 0;
+      while (legacy_load_next(legacy_in, legacy_weight, expected)) {
+        DT_THROW_IF(!text_reader.load_next(text_event), std::logic_error, "Missing event in text file!");
+        DT_THROW_IF(!binary_reader.load_next(binary_event), std::logic_error, "Missing event in binary file!");
+        check_events(text_event, expected);
+        check_events(binary_event, expected);
+        count++;
+      }
+      DT_THROW_IF(text_reader.load_next(text_event), std::logic_error, "Unexpected event in text file!");
+      DT_THROW_IF(binary_reader.load_next(binary_event), std::logic_error, "Unexpected event in binary file!");
+      DT_THROW_IF(count != nconverted, std::logic_error, "Unexpected number of converted events!");
+      clog << "File '" << filename << "' : " << count << " identical events." << endl;
+      binary_reader.close();
+      std::remove(binary_filename.c_str());
+    }
+
+    // Manager with binary sidecar files:
+    {
+      const string sample_filename = "test_genbb_reader_sample.genbb";
+      make_sample(sample_filename, 1000);
+      datatools::properties config;
+      config.store("format", "genbb");
+      config.store_flag("binary_sidecar");
+      std::vector<std::string> input_files;
+      input_files.push_back(sample_filename);
+      config.store("input_files", input_files);
+      for (int run = 0; run < 2; run++) {
+        genbb::genbb_mgr mgr;
+        mgr.initialize_standalone(config);
+        genbb::primary_event pe;
+        size_t count = 0;
+        while (mgr.has_next()) {
+          mgr.load_next(pe);
+          count++;
+        }
+        mgr.reset();
+        DT_THROW_IF(count != 1000, std::logic_error, "Unexpected number of events from the manager!");
+        DT_THROW_IF(!genbb::genbb_reader::has_valid_binary(sample_filename), std::logic_error,
+                    "Missing binary sidecar file!");
+      }
+      std::remove(genbb::genbb_reader::make_binary_filename(sample_filename).c_str());
+      std::remove(sample_filename.c_str());
+    }
+
+    // Throughput:
+    {
+      size_t nevents = 100000;
+      for (int i = 0; i < many; i++) {
+        nevents *= 10;
+      }
+      const string sample_filename = "test_genbb_reader_sample.genbb";
+      const string binary_filename = genbb::genbb_reader::make_binary_filename(sample_filename);
+      make_sample(sample_filename, nevents);
+      genbb::primary_event pe;
+
+      datatools::computing_time legacy_ct;
+      legacy_ct.start();
+      {
+        ifstream legacy_in(sample_filename.c_str());
+        double legacy_weight = 1.0;
+        while (legacy_load_next(legacy_in, legacy_weight, pe)) {}
+      }
+      legacy_ct.stop();
+
+      datatools::computing_time text_ct;
+      text_ct.start();
+      {
+        genbb::genbb_reader reader;
+        reader.open(sample_filename);
+        while (reader.load_next(pe)) {}
+        DT_THROW_IF(reader.get_event_count() != nevents, std::logic_error, "Unexpected number of events!");
+      }
+      text_ct.stop();
+
+      datatools::computing_time convert_ct;
+      convert_ct.start();
+      genbb::genbb_reader::convert_to_binary(sample_filename, binary_filename);
+      convert_ct.stop();
+
+      datatools::computing_time binary_ct;
+      binary_ct.start();
+      {
+        genbb::genbb_reader reader;
+        reader.open(binary_filename);
+        while (reader.load_next(pe)) {}
+        DT_THROW_IF(reader.get_event_count() != nevents, std::logic_error, "Unexpected number of events!");
+      }
+      binary_ct.stop();
+
+      clog << "Throughput for " << nevents << " events:" << endl;
+      clog << "  Stream parser : "
+           << nevents / (legacy_ct.get_last_elapsed_time() / CLHEP::second) << " events/s" << endl;
+      clog << "  Text reader   : "
+           << nevents / (text_ct.get_last_elapsed_time() / CLHEP::second) << " events/s" << endl;
+      clog << "  Conversion    : "
+           << nevents / (convert_ct.get_last_elapsed_time() / CLHEP::second) << " events/s" << endl;
+      clog << "  Binary reader : "
+           << nevents / (binary_ct.get_last_elapsed_time() / CLHEP::second) << " events/s" << endl;
+      std::remove(binary_filename.c_str());
+      std::remove(sample_filename.c_str());
+    }
+
+    clog << "The end." << endl;
+  }
+  catch (std::exception & x) {
+    std::cerr << "error: " << x.what () << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
+
+bool legacy_load_next(std::istream & in_, double & weight_, genbb::primary_event & event_)
+{
+  event_.reset();
+  std::string line;
+  while (true) {
+    std::string token;
+    std::getline(in_, line);
+    if (!in_) {
+      return false;
+    }
+    {
+      std::istringstream line_iss(line);
+      line_iss >> token;
+    }
+    if (token.empty()) continue;
+    if (token[0] != '#') break;
+    if (token.length() > 1 && token[1] == '@' && line.find("#@toallevents=") == 0) {
+      std::istringstream iss(line.substr(14));
+      double toallevents = 1.0;
+      iss >> toallevents;
+      weight_ = 1.0 / toallevents;
+    }
+  }
+  int evnum;
+  double time;
+  int npart;
+  {
+    std::istringstream line_iss(line);
+    line_iss >> std::ws >> evnum >> time >> npart;
+    DT_THROW_IF(!line_iss, std::logic_error, "Format error !");
+  }
+  event_.set_time(time * CLHEP::second);
+  event_.set_genbb_weight(weight_);
+  double part_time = 0.0;
+  for (int i = 0; i < npart; i++) {
+    genbb::primary_particle pp;
+    int part_type;
+    double x, y, z, time_shift;
+    in_ >> std::ws >> part_type >> x >> y >> z >> time_shift;
+    DT_THROW_IF(!in_, std::logic_error, "Format error !");
+    part_time += time_shift;
+    pp.set_type(part_type);
+    pp.set_time(part_time * CLHEP::second);
+    geomtools::vector_3d p(x, y, z);
+    p *= CLHEP::MeV;
+    pp.set_momentum(p);
+    event_.add_particle(pp);
+  }
+  return true;
+}
+
+void check_events(const genbb::primary_event & event_, const genbb::primary_event & expected_)
+{
+  DT_THROW_IF(event_.get_time() != expected_.get_time(), std::logic_error, "Unmatching event time!");
+  DT_THROW_IF(event_.get_genbb_weight() != expected_.get_genbb_weight(), std::logic_error, "Unmatching event weight!");
+  DT_THROW_IF(event_.get_number_of_particles() != expected_.get_number_of_particles(), std::logic_error,
+              "Unmatching number of particles!");
+  genbb::primary_event::particles_col_type::const_iterator j = expected_.get_particles().begin();
+  for (genbb::primary_event::particles_col_type::const_iterator i = event_.get_particles().begin();
+       i != event_.get_particles().end();
+       i++, j++) {
+    DT_THROW_IF(i->get_type() != j->get_type(), std::logic_error, "Unmatching particle type!");
+    DT_THROW_IF(i->get_particle_label() != j->get_particle_label(), std::logic_error, "Unmatching particle label!");
+    DT_THROW_IF(i->get_time() != j->get_time(), std::logic_error, "Unmatching particle time!");
+    DT_THROW_IF(i->get_momentum() != j->get_momentum(), std::logic_error, "Unmatching particle momentum!");
+  }
+  return;
+}
+
+void make_sample(const std::string & filename_, std::size_t nevents_)
+{
+  std::mt19937 gen(314159);
+  std::uniform_real_distribution<double> momentum(-2.5, 2.5);
+  std::uniform_real_distribution<double> time(0.0, 1.0e4);
+  std::ofstream out(filename_.c_str());
+  out << "#@toallevents=1.234" << std::endl;
+  char buffer[256];
+  for (std::size_t i = 0; i < nevents_; i++) {
+    std::snprintf(buffer, sizeof(buffer), "%8d  %-12.5f %3d\n", 0, time(gen), 2);
+    out << buffer;
+    for (int j = 0; j < 2; j++) {
+      std::snprintf(buffer, sizeof(buffer), "%3d %13.6G %13.6G %13.6G %13.6G\n",
+                    j == 0 ? 3 : 1, momentum(gen), momentum(gen), momentum(gen), j == 0 ? 0.0 : 1.0e-7);
+      out << buffer;
+    }
+  }
+  DT_THROW_IF(!out, std::runtime_error, "Cannot write sample file '" << filename_ << "'!");
+  return;
+}
@@ -1,25 +1,35 @@
 // test_nuclear_decay_generator.cxx
 
 // Standard library:
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <string>
 #include <exception>
+#include <stdexcept>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/units.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/utils.h>
 // - Bayeux/geomtools:
 #include <geomtools/gnuplot_i.h>
 #include <geomtools/gnuplot_drawer.h>
 // - Bayeux/mygsl:
 #include <mygsl/histogram_1d.h>
+#include <mygsl/rng.h>
 
 // This project:
 #include <genbb_help/nuclear_decay_generator.h>
 #include <genbb_help/primary_event.h>
+#include <genbb_help/nuclear_decay_manager.h>
+#include <genbb_help/nuclear_level.h>
 
 void test1(bool draw_, int many_);
+void test2(int many_);
 
 int main(int argc_, char ** argv_)
 {
@@ -55,6 +65,8 @@ int main(int argc_, char ** argv_)
 
     test1(draw, many);
 
+    test2(many);
+
   }
   catch (exception & x) {
     cerr << "error: " << x.what() << endl;
@@ -161,3 +173,67 @@ void test1(bool draw_, int many_)
   std::cerr << "DEVEL: test1: Exiting." << std::endl;
   return;
 }
+
+void test2(int many_)
+{
+  std::clog << "\nTest 2: " << std::endl;
+  std::string mc = "${GENBB_HELP_TESTING_DIR}/config/test_nuclear_decay_manager_0.conf";
+  datatools::fetch_path_with_env(mc);
+  datatools::properties ndm_config;
+  ndm_config.read_configuration(mc);
+  genbb::nuclear_decay_manager ndm;
+  ndm.initialize(ndm_config);
+
+  mygsl::rng random;
+  random.init("taus2", 314159);
+  for (const auto & level_entry : ndm.get_levels()) {
+    const genbb::nuclear_level & level = level_entry.second.get();
+    if (! level.has_decay_table()) continue;
+
+    // The alias table reproduces the branching ratios:
+    const std::size_t nchannels = level.get_number_of_decay_channels();
+    const std::size_t nshoots = 100000;
+    std::vector<std::size_t> counts(nchannels, 0);
+    for (std::size_t i = 0; i < nshoots; i++) {
+      const genbb::nuclear_level::decay_channel * channel
+        = level.pick_decay_channel(random.flat(0.0, 1.0));
+      DT_THROW_IF(channel == nullptr, std::logic_error, "No decay channel!");
+      counts[channel - &level.get_decay_channel(0)]++;
+    }
+    double wsum = 0.0;
+    for (std::size_t i = 0; i < nchannels; i++) {
+      wsum += level.get_decay_channel(i).get_branching_ratio();
+    }
+    for (std::size_t i = 0; i < nchannels; i++) {
+      const double expected = level.get_decay_channel(i).get_branching_ratio() / wsum;
+      const double observed = counts[i] / (double) nshoots;
+      DT_THROW_IF(std::abs(observed - expected) > 5 * std::sqrt(expected * (1.0 - expected) / nshoots) + 1e-9,
+                  std::logic_error,
+                  "Channel #" << i << " of level '" << level_entry.first << "' is picked with probability "
+                  << observed << " instead of " << expected << "!");
+    }
+
+    // Generation throughput:
+    genbb::nuclear_decay_generator NDG;
+    datatools::properties config;
+    config.store("seed", 314159);
+    config.store("manager.configuration", mc);
+    config.store("decaying.level", level_entry.first);
+    NDG.initialize_standalone(config);
+    std::size_t nevents = 10000;
+    for (int i = 0; i < many_; i++) {
+      nevents *= 10;
+    }
+    genbb::primary_event pe;
+    datatools::computing_time ct;
+    ct.start();
+    for (std::size_t i = 0; i < nevents; i++) {
+      NDG.load_next(pe);
+    }
+    ct.stop();
+    std::clog << "Level '" << level_entry.first << "' : "
+              << nchannels << " channel(s), "
+              << nevents / (ct.get_last_elapsed_time() / CLHEP::second) << " events/s" << std::endl;
+  }
+  return;
+}
@@ -36,6 +36,7 @@ set(GENBB_HELP_WITH_REFLECTION 1)
 set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/genbb_macros.h
   ${module_include_dir}/${module_name}/genbb_mgr.h
+  ${module_include_dir}/${module_name}/genbb_reader.h
   ${module_include_dir}/${module_name}/genbb_utils.h
   ${module_include_dir}/${module_name}/genbb_writer.h
   ${module_include_dir}/${module_name}/i_genbb.h
@@ -88,6 +89,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/primary_event.cc
   ${module_source_dir}/primary_particle.cc
   ${module_source_dir}/wdecay0.cc
+  ${module_source_dir}/genbb_reader.cc
   ${module_source_dir}/genbb_mgr.cc
   ${module_source_dir}/single_particle_generator.cc
   ${module_source_dir}/combined_particle_generator.cc
@@ -136,6 +138,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_genbb_mgr_4.cxx
   ${module_test_dir}/test_genbb_mgr_5.cxx
   ${module_test_dir}/test_genbb_mgr.cxx
+  ${module_test_dir}/test_genbb_reader.cxx
   ${module_test_dir}/test_genbb_writer.cxx
   ${module_test_dir}/test_pdg_particle_tools.cxx
   ${module_test_dir}/test_primary_event.cxx
@@ -230,8 +230,8 @@ namespace genvtx {
     geomtools::vector_3d src_vtx;
     _sphere_vg_.shoot_vertex (random_, src_vtx);
 
-    const geomtools::placement & world_plct
-      = _entries_[index].ginfo->get_world_placement ();
+    const geomtools::affine_transform & world_transform
+      = _entries_[index].ginfo->get_world_transform ();
     // Special treatment for geomtools::rotated_sphereed_model :
     if (_entries_[index].ginfo->get_logical().has_effective_relative_placement()) {
       const geomtools::placement & eff_ref_placement = _entries_[index].ginfo->get_logical().get_effective_relative_placement();
@@ -239,7 +239,7 @@ namespace genvtx {
       eff_ref_placement.child_to_mother(src_vtx, rel_vtx);
       src_vtx = rel_vtx;
     }
-    world_plct.child_to_mother (src_vtx, vertex_);
+    world_transform.child_to_mother (src_vtx, vertex_);
 
     if (has_vertex_validation()) {
       // Setup the geometry context for the vertex validation system:
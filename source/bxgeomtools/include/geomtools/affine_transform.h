@@ -0,0 +1,159 @@
+/// \file geomtools/affine_transform.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * Description:
+ *
+ *  Compact precomputed affine transform associated to a placement.
+ *
+ */
+
+#ifndef GEOMTOOLS_AFFINE_TRANSFORM_H
+#define GEOMTOOLS_AFFINE_TRANSFORM_H 1
+
+// Standard library:
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// This project:
+#include <geomtools/clhep.h>
+
+namespace geomtools {
+
+  class placement;
+
+  /// \brief Precomputed mother/child frame transform of a placement
+  ///
+  /// The transform stores the rotation and inverse rotation matrices
+  /// of a placement as plain 3x4 arrays of doubles (rotation rows and
+  /// translation) and classifies them so that points and directions
+  /// are transformed with the minimum number of operations:
+  ///  - identity : no operation,
+  ///  - translation : rotation-free placement,
+  ///  - axis rotation : rotation around the X, Y or Z axis,
+  ///  - general : arbitrary rotation.
+  ///
+  /// Results are the same as the ones of the
+  /// geomtools::placement::mother_to_child and
+  /// geomtools::placement::child_to_mother methods.
+  ///
+  /// \code
+  /// geomtools::affine_transform t(world_placement);
+  /// geomtools::vector_3d local_pos;
+  /// t.mother_to_child(world_pos, local_pos);
+  /// \endcode
+  class affine_transform
+  {
+  public:
+
+    /// \brief Class of the transform
+    enum kind_type {
+      KIND_IDENTITY      = 0, //!< Identity transform
+      KIND_TRANSLATION   = 1, //!< Pure translation
+      KIND_AXIS_ROTATION = 2, //!< Rotation around the X, Y or Z axis with translation
+      KIND_GENERAL       = 3  //!< Arbitrary rotation with translation
+    };
+
+    /// Return the label associated to a class of transform
+    static std::string kind_to_label(kind_type);
+
+    /// Default constructor (identity)
+    affine_transform();
+
+    /// Constructor from a placement
+    explicit affine_transform(const placement &);
+
+    /// Set from a placement
+    void set(const placement &);
+
+    /// Set identity
+    void set_identity();
+
+    /// Return the class of the transform
+    kind_type get_kind() const;
+
+    /// Check if the transform is identity
+    bool is_identity() const;
+
+    /// Check if the transform has a rotation
+    bool has_rotation() const;
+
+    /// Return the rotation axis (AXIS_X, AXIS_Y or AXIS_Z) of an axis rotation (AXIS_INVALID otherwise)
+    int get_rotation_axis() const;
+
+    /// Return the translation
+    vector_3d get_translation() const;
+
+    /// Transform a position from the mother frame to the child frame
+    void mother_to_child(const vector_3d & mother_pos_, vector_3d & child_pos_) const;
+
+    /// Transform a position from the mother frame to the child frame
+    vector_3d mother_to_child(const vector_3d & mother_pos_) const;
+
+    /// Transform a position from the child frame to the mother frame
+    void child_to_mother(const vector_3d & child_pos_, vector_3d & mother_pos_) const;
+
+    /// Transform a position from the child frame to the mother frame
+    vector_3d child_to_mother(const vector_3d & child_pos_) const;
+
+    /// Transform a direction from the mother frame to the child frame
+    void mother_to_child_direction(const vector_3d & mother_dir_, vector_3d & child_dir_) const;
+
+    /// Transform a direction from the child frame to the mother frame
+    void child_to_mother_direction(const vector_3d & child_dir_, vector_3d & mother_dir_) const;
+
+    /// Transform a contiguous range of positions from the mother frame to the child frame
+    ///
+    /// The input and output ranges may be the same.
+    void mother_to_child(const vector_3d * mother_pos_,
+                         vector_3d * child_pos_,
+                         std::size_t npos_) const;
+
+    /// Transform a contiguous range of positions from the child frame to the mother frame
+    ///
+    /// The input and output ranges may be the same.
+    void child_to_mother(const vector_3d * child_pos_,
+                         vector_3d * mother_pos_,
+                         std::size_t npos_) const;
+
+    /// Transform a collection of positions from the mother frame to the child frame
+    void mother_to_child(const std::vector<vector_3d> & mother_pos_,
+                         std::vector<vector_3d> & child_pos_) const;
+
+    /// Transform a collection of positions from the child frame to the mother frame
+    void child_to_mother(const std::vector<vector_3d> & child_pos_,
+                         std::vector<vector_3d> & mother_pos_) const;
+
+    /// Smart print
+    void tree_dump(std::ostream & out_ = std::clog,
+                   const std::string & title_ = "",
+                   const std::string & indent_ = "",
+                   bool inherit_ = false) const;
+
+  private:
+
+    /// Classify the transform
+    void _classify_();
+
+  private:
+
+    kind_type _kind_;       //!< Class of the transform
+    int       _axis_;       //!< Rotation axis for an axis rotation
+    double    _direct_[12]; //!< Mother->child rotation (row-major 3x3) followed by the translation
+    double    _inverse_[9]; //!< Child->mother rotation (row-major 3x3)
+
+  };
+
+} // end of namespace geomtools
+
+#endif // GEOMTOOLS_AFFINE_TRANSFORM_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -0,0 +1,165 @@
+/// \file geomtools/batch_locator.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * Description:
+ *   A geometry locator for batches of positions based on a geom_map
+ *
+ * History:
+ *
+ */
+
+#ifndef GEOMTOOLS_BATCH_LOCATOR_H
+#define GEOMTOOLS_BATCH_LOCATOR_H 1
+
+// Standard library:
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+
+// This project:
+#include <geomtools/geomtools_config.h>
+#include <geomtools/utils.h>
+#include <geomtools/geom_id.h>
+
+namespace geomtools {
+
+  class geom_map;
+  class geom_info;
+
+  /// \brief Locator of batches of positions in the volumes of a given geometry type
+  ///
+  /// The world bounding boxes of the volumes with the requested type are
+  /// organized in a hierarchy of boxes. A batch of positions, sorted along
+  /// a Z-order curve, is pushed down this hierarchy once: each box only
+  /// forwards to its daughter boxes the positions it contains. The volumes
+  /// reached by a position are then checked in the order of the geometry
+  /// map, so that the result is the one of geom_map::get_geom_id for each
+  /// position.
+  ///
+  /// Volumes are checked concurrently when a batch is split between several
+  /// threads, so their shapes must support concurrent queries. Lazily computed
+  /// data of the shapes are built at initialization.
+  class batch_locator
+  {
+  public:
+
+    /// Number of consecutive sorted positions pushed down the hierarchy at once
+    static const std::size_t POSITIONS_PER_BLOCK = 1024;
+
+    /// Maximum number of volumes in a leaf box of the hierarchy
+    static const std::size_t MAX_VOLUMES_PER_LEAF = 4;
+
+    /// Default constructor
+    batch_locator();
+
+    /// Constructor
+    batch_locator(const geom_map & gmap_,
+                  uint32_t type_,
+                  double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE);
+
+    /// Destructor
+    ~batch_locator();
+
+    /// Check initialization flag
+    bool is_initialized() const;
+
+    /// Initialize the locator for the volumes of a given geometry type
+    void initialize(const geom_map & gmap_,
+                    uint32_t type_,
+                    double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE);
+
+    /// Reset the locator
+    void reset();
+
+    /// Return the geometry type
+    uint32_t get_type() const;
+
+    /// Return the tolerance
+    double get_tolerance() const;
+
+    /// Return the number of volumes
+    std::size_t get_number_of_volumes() const;
+
+    /// Return the number of volumes without bounding box, which are checked for all positions
+    std::size_t get_number_of_unbounded_volumes() const;
+
+    /// Locate a batch of positions (in the world frame)
+    ///
+    /// The geometry ID of a position is invalid if it is located in no
+    /// volume. Blocks of sorted positions are shared between several threads
+    /// (0: number of hardware threads).
+    void locate(const std::vector<vector_3d> & positions_,
+                std::vector<geom_id> & gids_,
+                unsigned int nthreads_ = 1) const;
+
+  private:
+
+    /// \brief Axis aligned box
+    struct box_type
+    {
+      double min[3]; //!< Lower corner
+      double max[3]; //!< Upper corner
+    };
+
+    /// \brief Node of the hierarchy of boxes
+    struct node_type
+    {
+      box_type    bounds;            //!< Bounding box of the volumes of the node
+      std::size_t first = 0;         //!< Index of the first volume of a leaf
+      std::size_t count = 0;         //!< Number of volumes of a leaf (0 for a branch)
+      std::size_t daughters[2] = {0, 0}; //!< Daughter nodes of a branch
+    };
+
+    /// Pair of indexes of a position and of a volume
+    typedef std::pair<std::size_t, std::size_t> hit_type;
+
+    /// Build a node of the hierarchy for a range of bounded volumes
+    std::size_t _build_node_(std::size_t first_, std::size_t last_);
+
+    /// Push positions down the hierarchy from a given node
+    void _traverse_(std::size_t node_,
+                    const std::vector<vector_3d> & positions_,
+                    const std::vector<std::size_t> & queries_,
+                    std::vector<hit_type> & hits_) const;
+
+    /// Locate a block of sorted positions
+    void _locate_block_(const std::vector<vector_3d> & positions_,
+                        const std::vector<std::size_t> & order_,
+                        std::size_t first_,
+                        std::size_t last_,
+                        std::vector<geom_id> & gids_) const;
+
+  private:
+
+    bool             _initialized_; //!< Initialization flag
+    const geom_map * _gmap_;        //!< Geometry map handle
+    uint32_t         _type_;        //!< Geometry type
+    double           _tolerance_;   //!< Tolerance
+
+    // Working data:
+    std::vector<const geom_info *> _ginfos_;    //!< Handles to the volumes (in the order of the geometry map)
+    std::vector<box_type>          _boxes_;     //!< World bounding boxes of the volumes
+    std::vector<std::size_t>       _bounded_;   //!< Volumes with a bounding box (in the order of the leaves)
+    std::vector<std::size_t>       _unbounded_; //!< Volumes without bounding box
+    std::vector<node_type>         _nodes_;     //!< Hierarchy of boxes (the first node is the root)
+
+  };
+
+} // end of namespace geomtools
+
+#endif // GEOMTOOLS_BATCH_LOCATOR_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
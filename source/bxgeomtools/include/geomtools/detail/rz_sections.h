@@ -0,0 +1,237 @@
+/// \file geomtools/detail/rz_sections.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description:
+ *   Precomputed table of the Z sections of a shape described by
+ *   a Z/Rmin/Rmax table (polycone, polyhedra)
+ *
+ */
+
+#ifndef GEOMTOOLS_DETAIL_RZ_SECTIONS_H
+#define GEOMTOOLS_DETAIL_RZ_SECTIONS_H 1
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace geomtools {
+
+  namespace detail {
+
+    /// \brief Compact table of the Z sections of a polycone or a polyhedra
+    /**
+     *  The table is built once (when the shape is computed/locked). The section
+     *  which contains a given Z is found by binary search and all tests are
+     *  performed in place, without building any intermediate shape nor placement.
+     *
+     *  The radial coordinate is either the distance to the Z axis (circular
+     *  sections) or, for sections with N sides, the distance to the Z axis
+     *  measured along the normal of the nearest side (then radii are apothems).
+     *  A skin (normal distance to a face) is converted in a radial distance
+     *  through the slope of the face.
+     */
+    class rz_sections
+    {
+    public:
+
+      /// \brief Data of a single section
+      struct section_type
+      {
+        double z1;          //!< Bottom Z
+        double z2;          //!< Top Z
+        double rmin1;       //!< Inner radius at bottom Z
+        double rmin_slope;  //!< Inner radius slope dR/dZ
+        double rmax1;       //!< Outer radius at bottom Z
+        double rmax_slope;  //!< Outer radius slope dR/dZ
+        double rmin_factor; //!< Conversion factor from normal to radial distance (inner face)
+        double rmax_factor; //!< Conversion factor from normal to radial distance (outer face)
+        bool   has_rmin;    //!< Flag for an inner face
+
+        double rmin(double z_) const { return rmin1 + rmin_slope * (z_ - z1); }
+        double rmax(double z_) const { return rmax1 + rmax_slope * (z_ - z1); }
+      };
+
+      /// Clear the table
+      void clear()
+      {
+        _sections_.clear();
+        _z2_.clear();
+        _side_cos_.clear();
+        _side_sin_.clear();
+        _bounding_radius_ = 0.0;
+        return;
+      }
+
+      /// Check if the table is empty
+      bool is_empty() const
+      {
+        return _sections_.empty();
+      }
+
+      /// Return the number of sections
+      std::size_t size() const
+      {
+        return _sections_.size();
+      }
+
+      /// Return a section
+      const section_type & get(std::size_t i_) const
+      {
+        return _sections_[i_];
+      }
+
+      /// Return the minimum Z
+      double get_zmin() const
+      {
+        return _sections_.front().z1;
+      }
+
+      /// Return the maximum Z
+      double get_zmax() const
+      {
+        return _sections_.back().z2;
+      }
+
+      /// Build the table from an ordered Z/(rmin, rmax) dictionary
+      /**
+       *  For polygonal sections (n_sides_ >= 3), radii are circumradii and are
+       *  converted to apothems.
+       */
+      template <class RZMap>
+      void build(const RZMap & points_, std::size_t n_sides_ = 0)
+      {
+        clear();
+        double radius_factor = 1.0;
+        if (n_sides_ >= 3) {
+          const double alpha = 2 * M_PI / n_sides_;
+          radius_factor = std::cos(0.5 * alpha);
+          for (std::size_t i = 0; i < n_sides_; i++) {
+            _side_cos_.push_back(std::cos((i + 0.5) * alpha));
+            _side_sin_.push_back(std::sin((i + 0.5) * alpha));
+          }
+        }
+        typename RZMap::const_iterator it = points_.begin();
+        if (it == points_.end()) return;
+        typename RZMap::const_iterator jt = it;
+        for (++jt; jt != points_.end(); ++it, ++jt) {
+          section_type s;
+          const double dz = jt->first - it->first;
+          s.z1 = it->first;
+          s.z2 = jt->first;
+          s.rmin1 = it->second.rmin * radius_factor;
+          s.rmin_slope = (jt->second.rmin - it->second.rmin) * radius_factor / dz;
+          s.rmax1 = it->second.rmax * radius_factor;
+          s.rmax_slope = (jt->second.rmax - it->second.rmax) * radius_factor / dz;
+          s.rmin_factor = std::sqrt(1.0 + s.rmin_slope * s.rmin_slope);
+          s.rmax_factor = std::sqrt(1.0 + s.rmax_slope * s.rmax_slope);
+          s.has_rmin = (it->second.rmin > 0.0 || jt->second.rmin > 0.0);
+          _sections_.push_back(s);
+          _z2_.push_back(s.z2);
+          _bounding_radius_ = std::max(_bounding_radius_, std::max(it->second.rmax, jt->second.rmax));
+        }
+        return;
+      }
+
+      /// Return the radial coordinate of a point
+      double radial_coordinate(double x_, double y_) const
+      {
+        if (_side_cos_.empty()) {
+          return std::hypot(x_, y_);
+        }
+        const std::size_t nsides = _side_cos_.size();
+        double theta = std::atan2(y_, x_);
+        if (theta < 0.0) theta += 2 * M_PI;
+        std::size_t side = (std::size_t) (theta * nsides / (2 * M_PI));
+        if (side >= nsides) side = nsides - 1;
+        return x_ * _side_cos_[side] + y_ * _side_sin_[side];
+      }
+
+      /// Return the index of the section which contains a given Z (clamped)
+      std::size_t find(double z_) const
+      {
+        std::size_t index = std::upper_bound(_z2_.begin(), _z2_.end(), z_) - _z2_.begin();
+        if (index >= _sections_.size()) index = _sections_.size() - 1;
+        return index;
+      }
+
+      /// Check if a point is inside the volume, at more than half the skin from any face
+      bool is_inside(double z_, double r_, double hskin_) const
+      {
+        if (z_ >= get_zmax() - hskin_) return false;
+        if (z_ <= get_zmin() + hskin_) return false;
+        const section_type & s = _sections_[find(z_)];
+        if (r_ >= s.rmax(z_) - hskin_ * s.rmax_factor) return false;
+        if (s.has_rmin && r_ <= s.rmin(z_) + hskin_ * s.rmin_factor) return false;
+        return true;
+      }
+
+      /// Check if a point is outside the volume, at more than half the skin from any face
+      bool is_outside(double z_, double r_, double hskin_) const
+      {
+        if (z_ > get_zmax() + hskin_) return true;
+        if (z_ < get_zmin() - hskin_) return true;
+        const std::size_t index = find(z_);
+        if (!_is_outside_section_(index, z_, r_, hskin_)) return false;
+        // Near the boundary between two sections, the point must also be outside the neighbour:
+        const section_type & s = _sections_[index];
+        if (index > 0 && z_ - s.z1 < hskin_) {
+          if (!_is_outside_section_(index - 1, z_, r_, hskin_)) return false;
+        }
+        if (index + 1 < _sections_.size() && s.z2 - z_ < hskin_) {
+          if (!_is_outside_section_(index + 1, z_, r_, hskin_)) return false;
+        }
+        return true;
+      }
+
+      /// Check if a ray may intercept the volume (test against its bounding box)
+      bool may_intercept(const double from_[3], const double direction_[3], double tolerance_) const
+      {
+        const double r = _bounding_radius_ + tolerance_;
+        const double lo[3] = {-r, -r, get_zmin() - tolerance_};
+        const double hi[3] = {+r, +r, get_zmax() + tolerance_};
+        double tmin = 0.0;
+        double tmax = std::numeric_limits<double>::infinity();
+        for (int i = 0; i < 3; i++) {
+          if (direction_[i] == 0.0) {
+            if (from_[i] < lo[i] || from_[i] > hi[i]) return false;
+            continue;
+          }
+          double t1 = (lo[i] - from_[i]) / direction_[i];
+          double t2 = (hi[i] - from_[i]) / direction_[i];
+          if (t1 > t2) std::swap(t1, t2);
+          tmin = std::max(tmin, t1);
+          tmax = std::min(tmax, t2);
+          if (tmin > tmax) return false;
+        }
+        return true;
+      }
+
+    private:
+
+      bool _is_outside_section_(std::size_t index_, double z_, double r_, double hskin_) const
+      {
+        const section_type & s = _sections_[index_];
+        const double z = std::min(std::max(z_, s.z1), s.z2);
+        if (r_ > s.rmax(z) + hskin_ * s.rmax_factor) return true;
+        if (s.has_rmin && r_ < s.rmin(z) - hskin_ * s.rmin_factor) return true;
+        return false;
+      }
+
+      std::vector<section_type> _sections_; //!< Sections ordered by Z
+      std::vector<double> _z2_;             //!< Top Z of the sections (binary search)
+      std::vector<double> _side_cos_;       //!< Cosine of the normals of the sides (polygonal sections)
+      std::vector<double> _side_sin_;       //!< Sine of the normals of the sides (polygonal sections)
+      double _bounding_radius_ = 0.0;       //!< Maximum outer (circum)radius
+
+    };
+
+  } // end of namespace detail
+
+} // end of namespace geomtools
+
+#endif // GEOMTOOLS_DETAIL_RZ_SECTIONS_H
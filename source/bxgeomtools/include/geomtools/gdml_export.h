@@ -21,6 +21,9 @@
 #include <sstream>
 #include <string>
 #include <set>
+#include <list>
+#include <map>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools :
@@ -87,17 +90,42 @@ namespace geomtools {
     //! Attach an external GDML stream fro materials
     void attach_external_materials (const std::ostringstream & oss_);
 
+    //! Return the number of threads used to generate the GDML description
+    unsigned int get_number_of_threads () const;
+
+    //! Set the number of threads used to generate the GDML description (0: number of hardware threads)
+    void set_number_of_threads (unsigned int);
+
+    //! Compute a hash of the inputs of the GDML export of a model
+    //!
+    //! The hash covers the version of the library, the export parameters,
+    //! the external materials, the definitions of the geometry models and
+    //! the logical volumes of the model factory. It also covers the contents
+    //! of the files named by the properties of the geometry models (mesh
+    //! files, polycone data files...), once their paths are resolved.
+    //! Nothing is rendered, so that the hash is cheap compared to the export.
+    std::string compute_hash (const model_factory & factory_,
+                              const std::string & model_name_ = "") const;
+
+    //! GDML export in a cache directory, returns the name of the GDML file
+    //!
+    //! The name of the GDML file is built from the hash of the inputs (see compute_hash).
+    //! The GDML file is generated only if it does not exist yet in the cache directory.
+    std::string export_gdml_cached (const std::string & cache_dir_,
+                                    const model_factory & factory_,
+                                    const std::string & model_name_ = "");
+
   protected:
 
-    //! GDML export of a solid
+    //! Plan the GDML export of a solid
     virtual void _export_gdml_solid (const i_shape_3d & shape_,
                                      const std::string & log_name_);
 
-    //! GDML export of a logical volume
+    //! Plan the GDML export of a logical volume
     virtual void _export_gdml_logical (const logical_volume & log_vol__);
 
 
-    //! GDML export of a geometry model
+    //! Plan the GDML export of a geometry model
     virtual void _export_gdml_model (const i_model & model_);
 
     //! GDML export of the model factory, given the name of the top level model
@@ -105,6 +133,49 @@ namespace geomtools {
                                const model_factory & factory_,
                                const std::string & model_name_);
 
+  private:
+
+    //! \brief Elementary task of the GDML export
+    //!
+    //! The export of a model is first planned as an ordered list of
+    //! elementary tasks. The tasks are then rendered by batches, in
+    //! parallel, each thread rendering a contiguous range of tasks in
+    //! its own GDML writer. The GDML sections are finally written in
+    //! the order of the tasks, so that the output does not depend on
+    //! the number of threads.
+    struct export_item
+    {
+      //! \brief Type of task
+      enum type_type {
+        SOLID_PLACEMENT = 0, //!< Placement of the second solid of a boolean solid (define section)
+        SOLID           = 1, //!< Solid (solids section)
+        PHYSICAL        = 2, //!< Placements of a daughter physical volume (define section)
+        VOLUME          = 3, //!< Logical volume (structure section)
+        REPLICA_VOLUME  = 4  //!< Logical volume with a replica daughter (structure section)
+      };
+      type_type type;                              //!< Type of task
+      std::string name;                            //!< Name of the solid or of the logical volume
+      const i_shape_3d * shape = nullptr;          //!< Handle to the solid
+      const logical_volume * logical = nullptr;    //!< Handle to the logical volume
+      const physical_volume * physical = nullptr;  //!< Handle to the daughter physical volume
+      std::string material_ref;                    //!< Material reference of the logical volume
+      std::list<gdml_writer::physvol> physvols;    //!< Daughter physical volumes of the logical volume
+      gdml_writer::replicavol replicavol = gdml_writer::replicavol (); //!< Replica daughter of the logical volume
+    };
+
+    //! Build the names of the positions and rotations of a daughter physical volume,
+    //! and optionally render them in a GDML writer
+    void _export_gdml_physical_ (const std::string & log_name_,
+                                 const physical_volume & phys_,
+                                 gdml_writer * writer_,
+                                 std::list<gdml_writer::physvol> * physvols_) const;
+
+    //! Render an elementary task in a GDML writer
+    void _render_item_ (const export_item & item_, gdml_writer & writer_) const;
+
+    //! Render a range of elementary tasks in a GDML writer
+    void _render_items_ (std::size_t first_, std::size_t last_, gdml_writer & writer_) const;
+
   private:
 
     datatools::logger::priority _logging_priority_; //!< Logging priority threshold
@@ -121,6 +192,8 @@ namespace geomtools {
 
     bool _support_replica_; //!< Flag to support native replica
     bool _support_auxiliary_; //!< Flag to support auxiliary properties
+    unsigned int _number_of_threads_; //!< Number of threads used to generate the GDML description
+    std::vector<export_item> _items_; //!< Planned elementary tasks
 
   };
 
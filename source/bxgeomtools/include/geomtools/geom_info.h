@@ -27,6 +27,7 @@
 // This project:
 #include <geomtools/geom_id.h>
 #include <geomtools/placement.h>
+#include <geomtools/affine_transform.h>
 #include <geomtools/logical_volume.h>
 
 namespace geomtools {
@@ -57,6 +58,12 @@ namespace geomtools {
     /// Return the placement of the physical volume in the world coordinate system
     const placement & get_world_placement () const;
 
+    /// Return the precomputed transform of the world placement
+    ///
+    /// The transform should be preferred to the world placement in order to
+    /// transform many positions from/to the world coordinate system.
+    const affine_transform & get_world_transform () const;
+
     /// Return the logical volume
     const logical_volume & get_logical () const;
 
@@ -83,6 +90,7 @@ namespace geomtools {
     datatools::properties  _properties_;      //!< Container of auxiliary properties
     geom_id                _gid_;             //!< Geometry Id
     placement              _world_placement_; //!< Placement of the physical volume in the world coordinate system
+    affine_transform       _world_transform_; //!< Precomputed transform of the world placement
     const logical_volume * _logical_;         //!< Handle to the logical volume
 
   };
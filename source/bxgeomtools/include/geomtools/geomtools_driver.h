@@ -178,6 +178,10 @@ namespace geomtools {
     int command_export_gdml(const std::vector<std::string> & argv_,
                             std::ostream & out_ = std::clog) const;
 
+    /// Check overlaps in the hierarchy of logical volumes
+    int command_check_overlaps(const std::vector<std::string> & argv_,
+                               std::ostream & out_ = std::clog) const;
+
 #if GEOMTOOLS_WITH_GNUPLOT_DISPLAY == 1
     /// Gnuplot 2D/3D display of the geometry setup
     int command_gnuplot_display(const std::vector<std::string> & argv_,
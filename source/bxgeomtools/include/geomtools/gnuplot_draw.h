@@ -1,7 +1,7 @@
 /// \file geomtools/gnuplot_draw.h
 /* Author(s):     F. Mauger <mauger@lpccaen.in2p3.fr>
  * Creation date: 2006-11-19
- * Last modified: 2015-03-21
+ * Last modified: 2026-10-18
  *
  * License:
  *
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <cmath>
 #include <list>
+#include <string>
 
 // Third party:
 // - Bayeux/mygsl:
@@ -35,6 +36,7 @@ namespace geomtools {
   class i_placement;
   class i_object_3d;
   class placement;
+  class compact_wires;
 
   // Curves:
   class line_3d;
@@ -230,6 +232,21 @@ namespace geomtools {
     basic_draw_polylines(std::ostream & out_,
                          const wires_type & wires_);
 
+    /// Basic draw a compact list of polylines at some placement
+    ///
+    /// The rendering data are appended to a character buffer, with the
+    /// same format than basic_draw_wires. Drawn points are recorded in the
+    /// given range (if activated) instead of the display bounding box, so
+    /// that several threads can render concurrently. Only one point every
+    /// 'stride_' points of each polyline is drawn (with its first and last
+    /// points always drawn) to reduce the level of detail.
+    static void
+    basic_draw_compact_wires(std::string & buffer_,
+                             const placement & p_,
+                             const compact_wires & wires_,
+                             xyz_range & range_,
+                             unsigned int stride_ = 1);
+
     /// Draw a list of polylines in some arbitrary reference frame
     static void
     draw_wires(std::ostream &,
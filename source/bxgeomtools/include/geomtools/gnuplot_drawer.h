@@ -1,7 +1,7 @@
 /// \file geomtools/gnuplot_drawer.h
 /* Author(s) :    Francois Mauger <mauger@lpccaen.in2p3.fr>
  * Creation date: 2010-02-20
- * Last modified: 2014-07-16
+ * Last modified: 2026-10-18
  *
  * Description:
  *
@@ -13,9 +13,11 @@
 #define GEOMTOOLS_GNUPLOT_DRAWER_H 1
 
 // Standard library:
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
@@ -106,6 +108,17 @@ namespace geomtools {
     /// Collection of display data handle
     typedef std::vector<dd_entry> dd_col_type;
 
+    /// \brief Rendering task for the envelope of a volume in wired mode
+    struct wires_task
+    {
+      const logical_volume * log = nullptr; //!< Handle to the logical volume
+      placement   plcmt;                    //!< Placement of the volume in the scene
+      std::string color_label;              //!< Label of the colored stream
+      uint32_t    options = 0;              //!< Shape rendering options
+      bool        prerendered = false;      //!< Flag for a shape without wires rendering
+      std::string rendered;                 //!< Rendering data for a shape without wires rendering
+    };
+
     /// \brief Visibility rules for 3D volume rendering
     struct visibility_rules {
       visibility_rules() = default;
@@ -260,6 +273,21 @@ namespace geomtools {
     /// Reset shape rendering options depth
     void reset_rendering_options_depth();
 
+    /// Return the number of threads used to generate the wires
+    unsigned int get_number_of_threads () const;
+
+    /// Set the number of threads used to generate the wires (0: number of hardware threads)
+    void set_number_of_threads (unsigned int);
+
+    /// Return the level of detail threshold
+    double get_lod_threshold () const;
+
+    /// Set the level of detail threshold (0: no decimation)
+    ///
+    /// The wires of a volume with a size smaller than this fraction
+    /// of the size of the largest drawn volume are decimated.
+    void set_lod_threshold (double);
+
   protected:
 
     void _draw_display_data(const model_factory & mf_,
@@ -275,6 +303,9 @@ namespace geomtools {
                 const placement & p_,
                 int max_display_level_ = 0);
 
+    /// Render the wires of the volumes planned by _draw_ in the colored streams
+    void _render_wires_tasks_();
+
     /*
     // Future : enrich the interface of the '_draw_' method...
     void _draw_ (const logical_volume & log_,
@@ -316,6 +347,9 @@ namespace geomtools {
     // int         _max_display_level_; 
     uint32_t    _rendering_options_current_ = 0;
     int32_t     _rendering_options_depth_ = 0;
+    unsigned int _number_of_threads_ = 1; //!< Number of threads used to generate the wires
+    double      _lod_threshold_ = 0.0;   //!< Level of detail threshold
+    std::vector<wires_task> _wires_tasks_; //!< Planned wires rendering tasks
 
   }; // class gnuplot_drawer
 
@@ -153,6 +153,9 @@ namespace geomtools {
     /// Return shape by index
     const shape_type & get_shape(int i_) const;
 
+    /// Build the data computed at first use, including the ones of the component shapes
+    void build_computed_data() const override;
+
     /// Smart print
     void tree_dump(std::ostream & out_         = std::clog,
                    const std::string & title_  = "",
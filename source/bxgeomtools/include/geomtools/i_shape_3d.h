@@ -237,6 +237,12 @@ namespace geomtools {
     /// Reset the computed faces
     void reset_computed_faces();
 
+    /// Build the data computed at first use (bounding data, faces)
+    ///
+    /// These data are built lazily by non mutable methods. A single thread
+    /// must build them before the shape is queried by several threads.
+    virtual void build_computed_data() const;
+
     /// Check the bounding data
     bool has_bounding_data() const;
 
@@ -1,7 +1,7 @@
 /// \file geomtools/i_wires_3d_rendering.h
 /* Author(s) :    Francois Mauger <mauger@lpccaen.in2p3.fr>
  * Creation date: 2012-10-22
- * Last modified: 2015-02-15
+ * Last modified: 2026-10-18
  *
  * License:
  *
@@ -17,7 +17,9 @@
 #define GEOMTOOLS_I_WIRES_3D_RENDERING_H 1
 
 // Standard library:
+#include <cstddef>
 #include <list>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -128,6 +130,61 @@ namespace geomtools {
   //! Save a collection of polylines in an ASCII stream
   void save_wires(std::ostream & out_, const wires_type & wires_, uint32_t flags_ = 0);
 
+  //! \brief A compact collection of polylines
+  //!
+  //! The points of all polylines are stored contiguously in a flat array
+  //! of coordinates, which is much lighter than a list of lists of vectors.
+  //! It is typically used to cache the wires of a shape in its own
+  //! reference frame and to render them at many placements.
+  class compact_wires
+  {
+  public:
+
+    //! Default constructor
+    compact_wires();
+
+    //! Construct from a collection of polylines
+    explicit compact_wires(const wires_type & wires_);
+
+    //! Check if there is no polyline
+    bool empty() const;
+
+    //! Return the number of polylines
+    std::size_t get_number_of_wires() const;
+
+    //! Return the total number of points
+    std::size_t get_number_of_points() const;
+
+    //! Return the number of points of a given polyline
+    std::size_t get_number_of_points(std::size_t wire_) const;
+
+    //! Return the coordinates (x, y, z) of a given point of a given polyline
+    const double * get_point(std::size_t wire_, std::size_t index_) const;
+
+    //! Return the largest dimension of the bounding box of the points
+    double get_extent() const;
+
+    //! Add a polyline
+    void add(const polyline_type & wire_);
+
+    //! Add a collection of polylines
+    void add(const wires_type & wires_);
+
+    //! Build a collection of polylines
+    void to_wires(wires_type & wires_) const;
+
+    //! Clear the polylines
+    void clear();
+
+  private:
+
+    std::vector<double>      _coordinates_;  //!< Coordinates of the points (x, y, z)
+    std::vector<std::size_t> _wire_offsets_; //!< Index of the first point of each polyline
+    double _min_[3]; //!< Lower corner of the bounding box of the points
+    double _max_[3]; //!< Upper corner of the bounding box of the points
+
+  };
+
   //! \brief A classified segment consists in a 3D segment with
   //!        a first and a last point in an arbitrary reference frame
   //!        and which is assigned a property that details if the segment
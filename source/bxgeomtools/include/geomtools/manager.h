@@ -36,6 +36,8 @@
 // Standard library:
 #include <string>
 #include <map>
+#include <mutex>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -55,6 +57,7 @@
 #include <geomtools/model_factory.h>
 #include <geomtools/id_mgr.h>
 #include <geomtools/mapping.h>
+#include <geomtools/utils.h>
 
 namespace datatools {
   // Forward declaration:
@@ -63,6 +66,9 @@ namespace datatools {
 
 namespace geomtools {
 
+  // Forward declaration:
+  class batch_locator;
+
   /// \brief Geometry manager for virtual geometry modelling.
   /// Main geometry manager for the modelisation of various
   /// experimental setups in the framework of the nuclear and particle
@@ -306,6 +312,19 @@ namespace geomtools {
     /// Return a reference to the non mutable mapping with explicit name
     const geomtools::mapping & get_mapping(const std::string & mapping_name_ = "") const;
 
+    /// Locate a batch of positions (in the world frame) in the volumes of a given geometry category
+    ///
+    /// The result for each position is the one of the default mapping's
+    /// geom_map::get_geom_id method (invalid if the position is located in
+    /// no volume). The positions are sorted and located block by block by
+    /// several threads (0: number of hardware threads). The locator built
+    /// for a given category and tolerance is kept for later batches.
+    void locate(const std::vector<vector_3d> & positions_,
+                const std::string & category_,
+                std::vector<geom_id> & gids_,
+                double tolerance_ = GEOMTOOLS_PROPER_TOLERANCE,
+                unsigned int nthreads_ = 0) const;
+
     /* Plugins management */
 
     bool can_drop_plugin(const std::string& plugin_name_);
@@ -450,6 +469,11 @@ namespace geomtools {
 
     std::string              _world_name_;        //!< the name of the 'world' model
 
+    /// Dictionary of batch locators addressed by geometry type and tolerance
+    typedef std::map<std::pair<uint32_t, double>, boost::shared_ptr<batch_locator> > batch_locator_dict_type;
+    mutable batch_locator_dict_type _batch_locators_;       //!< Batch locators for the default mapping
+    mutable std::mutex              _batch_locators_mutex_; //!< Protection of the batch locators
+
     bool                                _plugins_factory_preload_;  //!< Flag for preloading of plugins system factory
     bool                                _plugins_force_initialization_at_load_; //!< Flag to enforce initialization of plugins at load
     base_plugin::factory_register_type  _plugins_factory_register_; //!< Plugins registration
@@ -0,0 +1,161 @@
+// \file geomtools/overlap_checker.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License: GPL 3
+ *
+ * Description:
+ *
+ *  Hierarchy-wide volume overlapping detection
+ *
+ */
+
+#ifndef GEOMTOOLS_OVERLAP_CHECKER_H
+#define GEOMTOOLS_OVERLAP_CHECKER_H
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/logger.h>
+#include <datatools/i_tree_dump.h>
+
+// This project:
+#include <geomtools/overlapping.h>
+
+namespace geomtools {
+
+  class logical_volume;
+
+  /// \brief Overlapping detection in a whole hierarchy of logical volumes
+  /**
+   *  Each logical volume of the hierarchy is visited once. The placement
+   *  items of its daughter physical volumes are expanded in the frame of the
+   *  mother volume and their axis-aligned bounding boxes (AABB) are computed.
+   *
+   *  Broad phase: a sweep-and-prune along the X axis of the mother frame
+   *  selects the pairs of sibling items with intersecting AABBs. All other
+   *  pairs cannot overlap and are never tested.
+   *
+   *  Narrow phase: for each candidate pair, the surface vertexes of one
+   *  volume (sampled from its wires rendering) are tested against the other
+   *  volume, as in overlapping::check_two_volumes_overlap. Optionally, the
+   *  surface vertexes of each daughter item are tested against the mother
+   *  shape. Narrow phase checks are shared among a pool of threads.
+   *
+   *  The report does not depend on the number of threads: overlaps are
+   *  ordered by mother logical volume (depth-first traversal by name of
+   *  the daughter volumes), then by pair of items.
+   */
+  class overlap_checker
+  {
+  public:
+
+    /// \brief A detected overlap in a given mother logical volume
+    struct overlap_record
+    {
+      std::string mother;            ///< Name of the mother logical volume
+      overlapping::overlap_info info; ///< Overlap informations (names of daughter physical volumes)
+    };
+
+    /// \brief Overlapping search report
+    struct report
+      : public datatools::i_tree_dumpable
+    {
+      /// Default constructor
+      report();
+
+      /// Reset
+      void reset();
+
+      /// Check if some overlaps have been detected
+      bool has_overlaps() const;
+
+      /// Smart print
+      void tree_dump(std::ostream & out_         = std::clog,
+                     const std::string & title_  = "",
+                     const std::string & indent_ = "",
+                     bool inherit_               = false) const override;
+
+      std::string top;                    ///< Name of the top logical volume
+      std::size_t number_of_logicals;     ///< Number of visited logical volumes
+      std::size_t number_of_items;        ///< Number of daughter placement items
+      std::size_t number_of_pairs;        ///< Number of pairs of sibling items
+      std::size_t number_of_candidates;   ///< Number of pairs with intersecting bounding boxes
+      std::vector<overlap_record> overlaps; ///< Collection of detected overlaps
+    };
+
+    /// Default constructor
+    overlap_checker();
+
+    /// Destructor
+    ~overlap_checker();
+
+    /// Set the logging priority
+    void set_logging(datatools::logger::priority);
+
+    /// Return the logging priority
+    datatools::logger::priority get_logging() const;
+
+    /// Set the sampling density of surface vertexes (overlapping::FLAG_WIRES_XXX_SAMPLING)
+    void set_sampling(uint32_t sampling_flag_);
+
+    /// Set the sampling density of surface vertexes from a label
+    /**
+     *  Supported labels are: "low", "normal", "high", "very_high" and "huge".
+     */
+    void set_sampling(const std::string & label_);
+
+    /// Return the sampling density flag
+    uint32_t get_sampling() const;
+
+    /// Return the label of the sampling density
+    std::string get_sampling_label() const;
+
+    /// Set the number of threads of the narrow phase (0: hardware concurrency)
+    void set_number_of_threads(unsigned int);
+
+    /// Return the number of threads of the narrow phase (0: hardware concurrency)
+    unsigned int get_number_of_threads() const;
+
+    /// Set the flag to record all overlapping vertexes of a pair
+    void set_overlap_all(bool);
+
+    /// Check the flag to record all overlapping vertexes of a pair
+    bool is_overlap_all() const;
+
+    /// Set the flag to check daughters against their mother volume
+    void set_check_mother_daughter(bool);
+
+    /// Check the flag to check daughters against their mother volume
+    bool is_check_mother_daughter() const;
+
+    /// Check the hierarchy of logical volumes below a top volume
+    bool check(const logical_volume & top_, report & report_) const;
+
+  private:
+
+    datatools::logger::priority _logging_; //!< Logging priority
+    uint32_t     _sampling_;               //!< Sampling density flag
+    unsigned int _number_of_threads_;      //!< Number of threads
+    bool         _overlap_all_;            //!< Record all overlapping vertexes
+    bool         _check_mother_daughter_;  //!< Check daughters against their mother
+
+  };
+
+} // end of namespace geomtools
+
+#endif // GEOMTOOLS_OVERLAP_CHECKER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
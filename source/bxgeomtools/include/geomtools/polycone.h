@@ -21,6 +21,7 @@
 // This project:
 #include <geomtools/i_shape_3d.h>
 #include <geomtools/i_stackable.h>
+#include <geomtools/detail/rz_sections.h>
 #include <geomtools/right_circular_conical_frustrum.h>
 
 namespace geomtools {
@@ -372,6 +373,8 @@ namespace geomtools {
 
     void _compute_limits_();
 
+    void _compute_sections_();
+
     void _compute_misc_();
 
     void _compute_all_();
@@ -409,6 +412,7 @@ namespace geomtools {
     double  _z_max_;
     double  _r_max_;
     bool    _extruded_;
+    detail::rz_sections _sections_; //!< Precomputed sections for containment tests
 
     // Registration interface :
     GEOMTOOLS_OBJECT_3D_REGISTRATION_INTERFACE(polycone)
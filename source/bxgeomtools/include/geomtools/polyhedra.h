@@ -20,6 +20,7 @@
 // This project:
 #include <geomtools/i_shape_3d.h>
 #include <geomtools/i_stackable.h>
+#include <geomtools/detail/rz_sections.h>
 
 namespace geomtools {
 
@@ -316,6 +317,8 @@ namespace geomtools {
 
     void _compute_limits_();
 
+    void _compute_sections_();
+
     void _compute_misc_();
 
     void _compute_all_();
@@ -343,6 +346,7 @@ namespace geomtools {
     double  _r_max_;
     double  _xy_max_;
     bool    _extruded_;
+    detail::rz_sections _sections_; //!< Precomputed sections for containment tests
 
     // Registration interface :
     GEOMTOOLS_OBJECT_3D_REGISTRATION_INTERFACE(polyhedra)
@@ -393,6 +393,13 @@ int main(int argc_, char ** argv_)
           } else {
             DT_LOG_ERROR(datatools::logger::PRIO_ERROR, "A plain geometry model factory cannot export GDML file !");
           }
+        } else if (command == "O" || command == "check_overlaps") {
+          std::vector<std::string> argv;
+          app_build_argv(command_iss, argv);
+          int error = GD.command_check_overlaps(argv);
+          if (error > 0) {
+            DT_LOG_ERROR(datatools::logger::PRIO_ERROR, "Cannot check overlaps !");
+          }
 #if GEOMTOOLS_WITH_GNUPLOT_DISPLAY == 1
         } else if (command == "d" || command == "display") {
           std::vector<std::string> argv;
@@ -567,6 +574,9 @@ void app_print_shell_help(geomtools::geomtools_driver & gd_, std::ostream & out_
   out_ <<  "  x [ export_gdml ] [OPTIONS] [FILE] :                                            \n"
        <<  "                                     Export the geometry setup to a GDML file     \n";
   out_ <<  "                                     Use 'export_gdml --help' for the online help.\n";
+  out_ <<  "  O [ check_overlaps ] [OPTIONS] [NAME] :                                        \n"
+       <<  "                                     Check overlaps in the geometry hierarchy     \n";
+  out_ <<  "                                     Use 'check_overlaps --help' for the online help.\n";
   out_ <<  "  q [ quit ]                         : Quit                                       \n";
   return;
 }
@@ -0,0 +1,343 @@
+// affine_transform.cc
+
+// Ourselves:
+#include <geomtools/affine_transform.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/i_tree_dump.h>
+
+// This project:
+#include <geomtools/placement.h>
+#include <geomtools/utils.h>
+
+namespace geomtools {
+
+  // static
+  std::string affine_transform::kind_to_label(kind_type kind_)
+  {
+    switch (kind_) {
+    case KIND_IDENTITY: return std::string("identity");
+    case KIND_TRANSLATION: return std::string("translation");
+    case KIND_AXIS_ROTATION: return std::string("axis_rotation");
+    case KIND_GENERAL: return std::string("general");
+    }
+    return std::string("");
+  }
+
+  affine_transform::affine_transform()
+  {
+    set_identity();
+    return;
+  }
+
+  affine_transform::affine_transform(const placement & placement_)
+  {
+    set(placement_);
+    return;
+  }
+
+  void affine_transform::set_identity()
+  {
+    for (int i = 0; i < 12; i++) _direct_[i] = 0.0;
+    for (int i = 0; i < 9; i++) _inverse_[i] = 0.0;
+    _direct_[0] = _direct_[4] = _direct_[8] = 1.0;
+    _inverse_[0] = _inverse_[4] = _inverse_[8] = 1.0;
+    _kind_ = KIND_IDENTITY;
+    _axis_ = AXIS_INVALID;
+    return;
+  }
+
+  void affine_transform::set(const placement & placement_)
+  {
+    const rotation_3d & r = placement_.get_rotation();
+    const rotation_3d & ir = placement_.get_inverse_rotation();
+    const vector_3d & t = placement_.get_translation();
+    _direct_[0] = r.xx(); _direct_[1] = r.xy(); _direct_[2] = r.xz();
+    _direct_[3] = r.yx(); _direct_[4] = r.yy(); _direct_[5] = r.yz();
+    _direct_[6] = r.zx(); _direct_[7] = r.zy(); _direct_[8] = r.zz();
+    _direct_[9] = t.x(); _direct_[10] = t.y(); _direct_[11] = t.z();
+    _inverse_[0] = ir.xx(); _inverse_[1] = ir.xy(); _inverse_[2] = ir.xz();
+    _inverse_[3] = ir.yx(); _inverse_[4] = ir.yy(); _inverse_[5] = ir.yz();
+    _inverse_[6] = ir.zx(); _inverse_[7] = ir.zy(); _inverse_[8] = ir.zz();
+    _classify_();
+    return;
+  }
+
+  void affine_transform::_classify_()
+  {
+    const double * m = _direct_;
+    const double * im = _inverse_;
+    _axis_ = AXIS_INVALID;
+    // An axis is invariant if its row and column are exactly the unit vector
+    // in both the direct and inverse rotations:
+    bool invariant[3];
+    for (int a = 0; a < 3; a++) {
+      invariant[a] = true;
+      for (int b = 0; b < 3; b++) {
+        const double expected = (a == b) ? 1.0 : 0.0;
+        if (m[3 * a + b] != expected || m[3 * b + a] != expected
+            || im[3 * a + b] != expected || im[3 * b + a] != expected) {
+          invariant[a] = false;
+          break;
+        }
+      }
+    }
+    const int ninvariant = (invariant[0] ? 1 : 0) + (invariant[1] ? 1 : 0) + (invariant[2] ? 1 : 0);
+    if (ninvariant == 3) {
+      const bool translated = m[9] != 0.0 || m[10] != 0.0 || m[11] != 0.0;
+      _kind_ = translated ? KIND_TRANSLATION : KIND_IDENTITY;
+    } else if (ninvariant == 1) {
+      _kind_ = KIND_AXIS_ROTATION;
+      _axis_ = invariant[0] ? AXIS_X : (invariant[1] ? AXIS_Y : AXIS_Z);
+    } else {
+      _kind_ = KIND_GENERAL;
+    }
+    return;
+  }
+
+  affine_transform::kind_type affine_transform::get_kind() const
+  {
+    return _kind_;
+  }
+
+  bool affine_transform::is_identity() const
+  {
+    return _kind_ == KIND_IDENTITY;
+  }
+
+  bool affine_transform::has_rotation() const
+  {
+    return _kind_ == KIND_AXIS_ROTATION || _kind_ == KIND_GENERAL;
+  }
+
+  int affine_transform::get_rotation_axis() const
+  {
+    return _axis_;
+  }
+
+  vector_3d affine_transform::get_translation() const
+  {
+    return vector_3d(_direct_[9], _direct_[10], _direct_[11]);
+  }
+
+  namespace {
+
+    /// Rotate a vector with a row-major 3x3 matrix, the result may alias the input
+    inline void rotate_general(const double * m_, double x_, double y_, double z_, vector_3d & out_)
+    {
+      out_.set(m_[0] * x_ + m_[1] * y_ + m_[2] * z_,
+               m_[3] * x_ + m_[4] * y_ + m_[5] * z_,
+               m_[6] * x_ + m_[7] * y_ + m_[8] * z_);
+      return;
+    }
+
+    /// Rotate a vector around one axis with a row-major 3x3 matrix, the result may alias the input
+    inline void rotate_axis(const double * m_, int axis_, double x_, double y_, double z_, vector_3d & out_)
+    {
+      switch (axis_) {
+      case AXIS_X:
+        out_.set(x_,
+                 m_[4] * y_ + m_[5] * z_,
+                 m_[7] * y_ + m_[8] * z_);
+        break;
+      case AXIS_Y:
+        out_.set(m_[0] * x_ + m_[2] * z_,
+                 y_,
+                 m_[6] * x_ + m_[8] * z_);
+        break;
+      default:
+        out_.set(m_[0] * x_ + m_[1] * y_,
+                 m_[3] * x_ + m_[4] * y_,
+                 z_);
+      }
+      return;
+    }
+
+  }
+
+  void affine_transform::mother_to_child(const vector_3d & mother_pos_, vector_3d & child_pos_) const
+  {
+    const double x = mother_pos_.x() - _direct_[9];
+    const double y = mother_pos_.y() - _direct_[10];
+    const double z = mother_pos_.z() - _direct_[11];
+    switch (_kind_) {
+    case KIND_IDENTITY:
+      child_pos_ = mother_pos_;
+      break;
+    case KIND_TRANSLATION:
+      child_pos_.set(x, y, z);
+      break;
+    case KIND_AXIS_ROTATION:
+      rotate_axis(_direct_, _axis_, x, y, z, child_pos_);
+      break;
+    default:
+      rotate_general(_direct_, x, y, z, child_pos_);
+    }
+    return;
+  }
+
+  vector_3d affine_transform::mother_to_child(const vector_3d & mother_pos_) const
+  {
+    vector_3d v;
+    mother_to_child(mother_pos_, v);
+    return v;
+  }
+
+  void affine_transform::child_to_mother(const vector_3d & child_pos_, vector_3d & mother_pos_) const
+  {
+    switch (_kind_) {
+    case KIND_IDENTITY:
+      mother_pos_ = child_pos_;
+      return;
+    case KIND_TRANSLATION:
+      mother_pos_ = child_pos_;
+      break;
+    case KIND_AXIS_ROTATION:
+      rotate_axis(_inverse_, _axis_, child_pos_.x(), child_pos_.y(), child_pos_.z(), mother_pos_);
+      break;
+    default:
+      rotate_general(_inverse_, child_pos_.x(), child_pos_.y(), child_pos_.z(), mother_pos_);
+    }
+    mother_pos_.set(mother_pos_.x() + _direct_[9],
+                    mother_pos_.y() + _direct_[10],
+                    mother_pos_.z() + _direct_[11]);
+    return;
+  }
+
+  vector_3d affine_transform::child_to_mother(const vector_3d & child_pos_) const
+  {
+    vector_3d v;
+    child_to_mother(child_pos_, v);
+    return v;
+  }
+
+  void affine_transform::mother_to_child_direction(const vector_3d & mother_dir_, vector_3d & child_dir_) const
+  {
+    switch (_kind_) {
+    case KIND_IDENTITY:
+    case KIND_TRANSLATION:
+      child_dir_ = mother_dir_;
+      break;
+    case KIND_AXIS_ROTATION:
+      rotate_axis(_direct_, _axis_, mother_dir_.x(), mother_dir_.y(), mother_dir_.z(), child_dir_);
+      break;
+    default:
+      rotate_general(_direct_, mother_dir_.x(), mother_dir_.y(), mother_dir_.z(), child_dir_);
+    }
+    return;
+  }
+
+  void affine_transform::child_to_mother_direction(const vector_3d & child_dir_, vector_3d & mother_dir_) const
+  {
+    switch (_kind_) {
+    case KIND_IDENTITY:
+    case KIND_TRANSLATION:
+      mother_dir_ = child_dir_;
+      break;
+    case KIND_AXIS_ROTATION:
+      rotate_axis(_inverse_, _axis_, child_dir_.x(), child_dir_.y(), child_dir_.z(), mother_dir_);
+      break;
+    default:
+      rotate_general(_inverse_, child_dir_.x(), child_dir_.y(), child_dir_.z(), mother_dir_);
+    }
+    return;
+  }
+
+  void affine_transform::mother_to_child(const vector_3d * mother_pos_,
+                                         vector_3d * child_pos_,
+                                         std::size_t npos_) const
+  {
+    const double tx = _direct_[9];
+    const double ty = _direct_[10];
+    const double tz = _direct_[11];
+    // The class of the transform is tested once for the whole range:
+    switch (_kind_) {
+    case KIND_IDENTITY:
+      if (child_pos_ != mother_pos_) {
+        for (std::size_t i = 0; i < npos_; i++) child_pos_[i] = mother_pos_[i];
+      }
+      break;
+    case KIND_TRANSLATION:
+      for (std::size_t i = 0; i < npos_; i++) {
+        const vector_3d & p = mother_pos_[i];
+        child_pos_[i].set(p.x() - tx, p.y() - ty, p.z() - tz);
+      }
+      break;
+    case KIND_AXIS_ROTATION:
+      for (std::size_t i = 0; i < npos_; i++) {
+        const vector_3d & p = mother_pos_[i];
+        rotate_axis(_direct_, _axis_, p.x() - tx, p.y() - ty, p.z() - tz, child_pos_[i]);
+      }
+      break;
+    default:
+      for (std::size_t i = 0; i < npos_; i++) {
+        const vector_3d & p = mother_pos_[i];
+        rotate_general(_direct_, p.x() - tx, p.y() - ty, p.z() - tz, child_pos_[i]);
+      }
+    }
+    return;
+  }
+
+  void affine_transform::child_to_mother(const vector_3d * child_pos_,
+                                         vector_3d * mother_pos_,
+                                         std::size_t npos_) const
+  {
+    if (_kind_ == KIND_IDENTITY) {
+      if (child_pos_ != mother_pos_) {
+        for (std::size_t i = 0; i < npos_; i++) mother_pos_[i] = child_pos_[i];
+      }
+      return;
+    }
+    for (std::size_t i = 0; i < npos_; i++) {
+      child_to_mother(child_pos_[i], mother_pos_[i]);
+    }
+    return;
+  }
+
+  void affine_transform::mother_to_child(const std::vector<vector_3d> & mother_pos_,
+                                         std::vector<vector_3d> & child_pos_) const
+  {
+    child_pos_.resize(mother_pos_.size());
+    if (!mother_pos_.empty()) {
+      mother_to_child(mother_pos_.data(), child_pos_.data(), mother_pos_.size());
+    }
+    return;
+  }
+
+  void affine_transform::child_to_mother(const std::vector<vector_3d> & child_pos_,
+                                         std::vector<vector_3d> & mother_pos_) const
+  {
+    mother_pos_.resize(child_pos_.size());
+    if (!child_pos_.empty()) {
+      child_to_mother(child_pos_.data(), mother_pos_.data(), child_pos_.size());
+    }
+    return;
+  }
+
+  void affine_transform::tree_dump(std::ostream & out_,
+                                   const std::string & title_,
+                                   const std::string & indent_,
+                                   bool inherit_) const
+  {
+    if (! title_.empty()) {
+      out_ << indent_ << title_ << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "Kind : '" << kind_to_label(_kind_) << "'" << std::endl;
+    if (_kind_ == KIND_AXIS_ROTATION) {
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+           << "Rotation axis : " << _axis_ << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "Translation : " << get_translation() << std::endl;
+    out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+         << "Rotation : ";
+    for (int i = 0; i < 9; i++) {
+      out_ << (i == 0 ? "[" : (i % 3 == 0 ? "] [" : " ")) << _direct_[i];
+    }
+    out_ << "]" << std::endl;
+    return;
+  }
+
+} // end of namespace geomtools
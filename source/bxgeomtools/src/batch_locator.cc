@@ -0,0 +1,394 @@
+/** \file batch_locator.cc */
+
+// Ourselves:
+#include <geomtools/batch_locator.h>
+
+// Standard library:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <geomtools/geom_map.h>
+#include <geomtools/geom_info.h>
+#include <geomtools/logical_volume.h>
+#include <geomtools/i_shape_3d.h>
+#include <geomtools/bounding_data.h>
+
+namespace geomtools {
+
+  namespace {
+
+    //! Relative margin added to the bounding boxes against rounding errors
+    const double RELATIVE_BOX_MARGIN = 1.e-9;
+
+    //! Spread the 21 lower bits of an integer, inserting two zero bits between consecutive bits
+    uint64_t spread_bits(uint64_t v_)
+    {
+      v_ &= 0x1fffff;
+      v_ = (v_ | v_ << 32) & 0x1f00000000ffffULL;
+      v_ = (v_ | v_ << 16) & 0x1f0000ff0000ffULL;
+      v_ = (v_ | v_ << 8)  & 0x100f00f00f00f00fULL;
+      v_ = (v_ | v_ << 4)  & 0x10c30c30c30c30c3ULL;
+      v_ = (v_ | v_ << 2)  & 0x1249249249249249ULL;
+      return v_;
+    }
+
+  }
+
+  // static
+  const std::size_t batch_locator::POSITIONS_PER_BLOCK;
+  const std::size_t batch_locator::MAX_VOLUMES_PER_LEAF;
+
+  batch_locator::batch_locator()
+  {
+    _initialized_ = false;
+    _gmap_ = 0;
+    _type_ = geom_id::INVALID_TYPE;
+    _tolerance_ = GEOMTOOLS_PROPER_TOLERANCE;
+    return;
+  }
+
+  batch_locator::batch_locator(const geom_map & gmap_,
+                               uint32_t type_,
+                               double tolerance_)
+  {
+    _initialized_ = false;
+    _gmap_ = 0;
+    _type_ = geom_id::INVALID_TYPE;
+    _tolerance_ = GEOMTOOLS_PROPER_TOLERANCE;
+    initialize(gmap_, type_, tolerance_);
+    return;
+  }
+
+  batch_locator::~batch_locator()
+  {
+    if (is_initialized()) {
+      reset();
+    }
+    return;
+  }
+
+  bool batch_locator::is_initialized() const
+  {
+    return _initialized_;
+  }
+
+  uint32_t batch_locator::get_type() const
+  {
+    return _type_;
+  }
+
+  double batch_locator::get_tolerance() const
+  {
+    return _tolerance_;
+  }
+
+  std::size_t batch_locator::get_number_of_volumes() const
+  {
+    return _ginfos_.size();
+  }
+
+  std::size_t batch_locator::get_number_of_unbounded_volumes() const
+  {
+    return _unbounded_.size();
+  }
+
+  void batch_locator::initialize(const geom_map & gmap_,
+                                 uint32_t type_,
+                                 double tolerance_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Batch locator is already initialized !");
+    DT_THROW_IF(type_ == geom_id::INVALID_TYPE, std::logic_error, "Invalid geometry type !");
+    _gmap_ = &gmap_;
+    _type_ = type_;
+    _tolerance_ = tolerance_;
+
+    std::vector<vector_3d> vertexes;
+    std::set<const i_shape_3d *> prepared_shapes;
+    for (geom_info_dict_type::const_iterator i = gmap_.get_geom_infos().begin();
+         i != gmap_.get_geom_infos().end();
+         i++) {
+      const geom_info & ginfo = i->second;
+      if (ginfo.get_id().get_type() != _type_) continue;
+      const std::size_t ordinal = _ginfos_.size();
+      _ginfos_.push_back(&ginfo);
+      box_type bb;
+      const i_shape_3d & shape = ginfo.get_logical().get_shape();
+      // Data built at first use by the shape (and by the components of a
+      // composite shape) must exist before any concurrent query:
+      if (prepared_shapes.insert(&shape).second) {
+        shape.build_computed_data();
+      }
+      const bounding_data & bd = shape.get_bounding_data();
+      if (! bd.is_valid()) {
+        _unbounded_.push_back(ordinal);
+        _boxes_.push_back(bb);
+        continue;
+      }
+      bd.compute_bounding_box_vertexes(vertexes);
+      for (int k = 0; k < 3; k++) {
+        bb.min[k] = +std::numeric_limits<double>::infinity();
+        bb.max[k] = -std::numeric_limits<double>::infinity();
+      }
+      for (std::size_t ivtx = 0; ivtx < vertexes.size(); ivtx++) {
+        const vector_3d world_vtx = ginfo.get_world_transform().child_to_mother(vertexes[ivtx]);
+        for (int k = 0; k < 3; k++) {
+          bb.min[k] = std::min(bb.min[k], world_vtx[k]);
+          bb.max[k] = std::max(bb.max[k], world_vtx[k]);
+        }
+      }
+      // Positions within the skin of the shape are not outside:
+      double margin = std::max(shape.get_skin(_tolerance_), _tolerance_);
+      for (int k = 0; k < 3; k++) {
+        margin = std::max(margin, RELATIVE_BOX_MARGIN * std::max(std::abs(bb.min[k]), std::abs(bb.max[k])));
+      }
+      for (int k = 0; k < 3; k++) {
+        bb.min[k] -= margin;
+        bb.max[k] += margin;
+      }
+      _bounded_.push_back(ordinal);
+      _boxes_.push_back(bb);
+    }
+
+    if (_bounded_.size() > 0) {
+      _nodes_.reserve(2 * _bounded_.size());
+      _build_node_(0, _bounded_.size());
+    }
+    _initialized_ = true;
+    return;
+  }
+
+  void batch_locator::reset()
+  {
+    DT_THROW_IF(! is_initialized(), std::logic_error, "Batch locator is not initialized !");
+    _initialized_ = false;
+    _nodes_.clear();
+    _unbounded_.clear();
+    _bounded_.clear();
+    _boxes_.clear();
+    _ginfos_.clear();
+    _tolerance_ = GEOMTOOLS_PROPER_TOLERANCE;
+    _type_ = geom_id::INVALID_TYPE;
+    _gmap_ = 0;
+    return;
+  }
+
+  std::size_t batch_locator::_build_node_(std::size_t first_, std::size_t last_)
+  {
+    const std::size_t inode = _nodes_.size();
+    _nodes_.push_back(node_type());
+    box_type bounds;
+    box_type centers;
+    for (int k = 0; k < 3; k++) {
+      bounds.min[k] = centers.min[k] = +std::numeric_limits<double>::infinity();
+      bounds.max[k] = centers.max[k] = -std::numeric_limits<double>::infinity();
+    }
+    for (std::size_t i = first_; i < last_; i++) {
+      const box_type & bb = _boxes_[_bounded_[i]];
+      for (int k = 0; k < 3; k++) {
+        const double center = 0.5 * (bb.min[k] + bb.max[k]);
+        bounds.min[k] = std::min(bounds.min[k], bb.min[k]);
+        bounds.max[k] = std::max(bounds.max[k], bb.max[k]);
+        centers.min[k] = std::min(centers.min[k], center);
+        centers.max[k] = std::max(centers.max[k], center);
+      }
+    }
+    _nodes_[inode].bounds = bounds;
+    if (last_ - first_ <= MAX_VOLUMES_PER_LEAF) {
+      _nodes_[inode].first = first_;
+      _nodes_[inode].count = last_ - first_;
+      return inode;
+    }
+    // Median split along the axis with the largest spread of the box centers:
+    int axis = 0;
+    for (int k = 1; k < 3; k++) {
+      if (centers.max[k] - centers.min[k] > centers.max[axis] - centers.min[axis]) {
+        axis = k;
+      }
+    }
+    const std::size_t middle = first_ + (last_ - first_) / 2;
+    std::nth_element(_bounded_.begin() + first_,
+                     _bounded_.begin() + middle,
+                     _bounded_.begin() + last_,
+                     [this, axis] (std::size_t a_, std::size_t b_) {
+                       return _boxes_[a_].min[axis] + _boxes_[a_].max[axis]
+                         < _boxes_[b_].min[axis] + _boxes_[b_].max[axis];
+                     });
+    const std::size_t left = _build_node_(first_, middle);
+    const std::size_t right = _build_node_(middle, last_);
+    _nodes_[inode].daughters[0] = left;
+    _nodes_[inode].daughters[1] = right;
+    return inode;
+  }
+
+  void batch_locator::_traverse_(std::size_t node_,
+                                 const std::vector<vector_3d> & positions_,
+                                 const std::vector<std::size_t> & queries_,
+                                 std::vector<hit_type> & hits_) const
+  {
+    const node_type & node = _nodes_[node_];
+    std::vector<std::size_t> inside;
+    inside.reserve(queries_.size());
+    for (std::size_t iq = 0; iq < queries_.size(); iq++) {
+      const vector_3d & pos = positions_[queries_[iq]];
+      if (pos.x() < node.bounds.min[0] || pos.x() > node.bounds.max[0]) continue;
+      if (pos.y() < node.bounds.min[1] || pos.y() > node.bounds.max[1]) continue;
+      if (pos.z() < node.bounds.min[2] || pos.z() > node.bounds.max[2]) continue;
+      inside.push_back(queries_[iq]);
+    }
+    if (inside.empty()) {
+      return;
+    }
+    if (node.count == 0) {
+      _traverse_(node.daughters[0], positions_, inside, hits_);
+      _traverse_(node.daughters[1], positions_, inside, hits_);
+      return;
+    }
+    for (std::size_t iq = 0; iq < inside.size(); iq++) {
+      const vector_3d & pos = positions_[inside[iq]];
+      for (std::size_t i = node.first; i < node.first + node.count; i++) {
+        const std::size_t ordinal = _bounded_[i];
+        const box_type & bb = _boxes_[ordinal];
+        if (pos.x() < bb.min[0] || pos.x() > bb.max[0]) continue;
+        if (pos.y() < bb.min[1] || pos.y() > bb.max[1]) continue;
+        if (pos.z() < bb.min[2] || pos.z() > bb.max[2]) continue;
+        hits_.push_back(hit_type(inside[iq], ordinal));
+      }
+    }
+    return;
+  }
+
+  void batch_locator::_locate_block_(const std::vector<vector_3d> & positions_,
+                                     const std::vector<std::size_t> & order_,
+                                     std::size_t first_,
+                                     std::size_t last_,
+                                     std::vector<geom_id> & gids_) const
+  {
+    const std::vector<std::size_t> queries(order_.begin() + first_, order_.begin() + last_);
+    std::vector<hit_type> hits;
+    if (! _nodes_.empty()) {
+      _traverse_(0, positions_, queries, hits);
+    }
+    for (std::size_t iq = 0; iq < queries.size(); iq++) {
+      for (std::size_t iu = 0; iu < _unbounded_.size(); iu++) {
+        hits.push_back(hit_type(queries[iq], _unbounded_[iu]));
+      }
+    }
+    // Candidate volumes are checked in the order of the geometry map:
+    std::sort(hits.begin(), hits.end());
+    std::size_t ihit = 0;
+    while (ihit < hits.size()) {
+      const std::size_t query = hits[ihit].first;
+      const vector_3d & world_position = positions_[query];
+      for (; ihit < hits.size() && hits[ihit].first == query; ihit++) {
+        const geom_info & ginfo = *_ginfos_[hits[ihit].second];
+        // Same test as geom_map::check_inside (reverse mode):
+        vector_3d local_position;
+        ginfo.get_world_transform().mother_to_child(world_position, local_position);
+        if (! ginfo.get_logical().get_shape().is_outside(local_position, _tolerance_)) {
+          gids_[query] = ginfo.get_id();
+          break;
+        }
+      }
+      while (ihit < hits.size() && hits[ihit].first == query) {
+        ihit++;
+      }
+    }
+    return;
+  }
+
+  void batch_locator::locate(const std::vector<vector_3d> & positions_,
+                             std::vector<geom_id> & gids_,
+                             unsigned int nthreads_) const
+  {
+    DT_THROW_IF(! is_initialized(), std::logic_error, "Batch locator is not initialized !");
+    const std::size_t npositions = positions_.size();
+    gids_.assign(npositions, _gmap_->get_invalid_geom_id());
+    if (npositions == 0 || _ginfos_.empty()) {
+      return;
+    }
+
+    // Sort the positions along a Z-order curve so that blocks of positions are compact:
+    double pmin[3];
+    double pmax[3];
+    for (int k = 0; k < 3; k++) {
+      pmin[k] = +std::numeric_limits<double>::infinity();
+      pmax[k] = -std::numeric_limits<double>::infinity();
+    }
+    for (std::size_t i = 0; i < npositions; i++) {
+      for (int k = 0; k < 3; k++) {
+        const double v = positions_[i][k];
+        if (! std::isfinite(v)) continue;
+        pmin[k] = std::min(pmin[k], v);
+        pmax[k] = std::max(pmax[k], v);
+      }
+    }
+    std::vector<std::pair<uint64_t, std::size_t> > keys(npositions);
+    for (std::size_t i = 0; i < npositions; i++) {
+      uint64_t code = 0;
+      for (int k = 0; k < 3; k++) {
+        const double v = positions_[i][k];
+        uint64_t cell = 0;
+        if (std::isfinite(v) && pmax[k] > pmin[k]) {
+          cell = static_cast<uint64_t>((v - pmin[k]) / (pmax[k] - pmin[k]) * 2097151.0);
+        }
+        code |= spread_bits(cell) << k;
+      }
+      keys[i] = std::make_pair(code, i);
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::size_t> order(npositions);
+    for (std::size_t i = 0; i < npositions; i++) {
+      order[i] = keys[i].second;
+    }
+    keys.clear();
+
+    const std::size_t nblocks = (npositions + POSITIONS_PER_BLOCK - 1) / POSITIONS_PER_BLOCK;
+    unsigned int nthreads = nthreads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const std::size_t nworkers = std::min<std::size_t>(nthreads, nblocks);
+    if (nworkers <= 1) {
+      for (std::size_t iblock = 0; iblock < nblocks; iblock++) {
+        _locate_block_(positions_, order, iblock * POSITIONS_PER_BLOCK,
+                       std::min(npositions, (iblock + 1) * POSITIONS_PER_BLOCK), gids_);
+      }
+      return;
+    }
+    // Each thread picks the next unprocessed block and fills its own geometry IDs:
+    std::atomic<std::size_t> next_block(0);
+    std::vector<std::exception_ptr> errors(nworkers);
+    std::vector<std::thread> workers;
+    for (std::size_t iworker = 0; iworker < nworkers; iworker++) {
+      workers.push_back(std::thread([this, npositions, nblocks, iworker, &positions_, &order, &gids_, &next_block, &errors] () {
+            try {
+              for (std::size_t iblock = next_block++; iblock < nblocks; iblock = next_block++) {
+                _locate_block_(positions_, order, iblock * POSITIONS_PER_BLOCK,
+                               std::min(npositions, (iblock + 1) * POSITIONS_PER_BLOCK), gids_);
+              }
+            } catch (...) {
+              errors[iworker] = std::current_exception();
+            }
+          }));
+    }
+    for (std::size_t iworker = 0; iworker < workers.size(); iworker++) {
+      workers[iworker].join();
+    }
+    for (std::size_t iworker = 0; iworker < errors.size(); iworker++) {
+      if (errors[iworker]) std::rethrow_exception(errors[iworker]);
+    }
+    return;
+  }
+
+} // end of namespace geomtools
@@ -4,20 +4,31 @@
 #include <geomtools/gdml_export.h>
 
 // Standard library:
+#include <cstdio>
+#include <cstdint>
 #include <iomanip>
 #include <fstream>
 #include <stdexcept>
 #include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
 
 // Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string/erase.hpp>
 // - Bayeux/datatools:
 #include <datatools/exception.h>
 #include <datatools/logger.h>
+#include <datatools/multi_properties.h>
+#include <datatools/utils.h>
 // - Bayeux/materials:
 #include <materials/material.h>
 
 // This project:
 #include <geomtools/geomtools_config.h>
+#include <geomtools/version.h>
 #include <geomtools/detail/model_tools.h>
 #include <geomtools/model_factory.h>
 #include <geomtools/gdml_writer.h>
@@ -47,6 +58,134 @@
 
 namespace geomtools {
 
+  namespace {
+
+    //! Maximum number of elementary tasks rendered in memory before being written
+    const std::size_t max_items_per_batch = 4096;
+
+    //! Smart pointer to a temporary file
+    typedef std::unique_ptr<std::FILE, int (*)(std::FILE *)> tmp_file_handle;
+
+    //! Open an anonymous temporary file
+    tmp_file_handle open_tmp_file()
+    {
+      tmp_file_handle handle(std::tmpfile(), &std::fclose);
+      DT_THROW_IF(! handle, std::runtime_error, "Cannot open a temporary file !");
+      return handle;
+    }
+
+    //! Append a string to a temporary file
+    void append_to_tmp_file(std::FILE * file_, const std::string & data_)
+    {
+      if (data_.empty()) return;
+      DT_THROW_IF(std::fwrite(data_.data(), 1, data_.size(), file_) != data_.size(),
+                  std::runtime_error, "Cannot write in a temporary file !");
+      return;
+    }
+
+    //! Copy the contents of a temporary file in an output stream
+    void copy_tmp_file(std::FILE * file_, std::ostream & out_)
+    {
+      std::rewind(file_);
+      char buffer[65536];
+      std::size_t count = 0;
+      while ((count = std::fread(buffer, 1, sizeof(buffer), file_)) > 0) {
+        out_.write(buffer, count);
+      }
+      DT_THROW_IF(std::ferror(file_), std::runtime_error, "Cannot read a temporary file !");
+      return;
+    }
+
+    //! Build the references of the components of a boolean solid
+    void composite_refs(const i_composite_shape_3d & composite_,
+                        const std::string & solid_name_,
+                        std::string & shape_label_1_,
+                        std::string & shape_label_2_,
+                        std::string & pos_ref_,
+                        std::string & rot_ref_)
+    {
+      std::string operation = composite_.get_shape_name();
+      boost::algorithm::erase_last(operation, "_3d");
+      shape_label_1_ = composite_.get_shape1().get_shape_label();
+      if (shape_label_1_.empty()) {
+        shape_label_1_ = solid_name_ + "." + operation + ".first_ref" + i_model::solid_suffix();
+      }
+      shape_label_2_ = composite_.get_shape2().get_shape_label();
+      if (shape_label_2_.empty()) {
+        shape_label_2_ = solid_name_ + "." + operation + ".second_ref" + i_model::solid_suffix();
+      }
+      pos_ref_ = solid_name_ + "." + operation + ".pos_ref";
+      rot_ref_ = solid_name_ + "." + operation + ".rot_ref";
+      return;
+    }
+
+    //! Revision of the GDML output, to be incremented when the rendering changes
+    //! so that the files of the GDML cache generated by former versions are not reused
+    const int GDML_OUTPUT_REVISION = 1;
+
+    //! \brief Incremental 64-bit FNV-1a hash
+    class fnv1a_hash
+    {
+    public:
+
+      void update(const char * data_, std::size_t size_)
+      {
+        for (std::size_t i = 0; i < size_; i++) {
+          _value_ ^= static_cast<unsigned char>(data_[i]);
+          _value_ *= 1099511628211ULL;
+        }
+        return;
+      }
+
+      void update(const std::string & data_)
+      {
+        update(data_.data(), data_.size());
+        return;
+      }
+
+      //! Hash the contents of a file by chunks
+      void update_file(const std::string & filename_)
+      {
+        std::ifstream fin(filename_.c_str(), std::ios::binary);
+        DT_THROW_IF(! fin, std::runtime_error, "Cannot open file '" << filename_ << "' !");
+        char buffer[65536];
+        while (fin) {
+          fin.read(buffer, sizeof(buffer));
+          update(buffer, fin.gcount());
+        }
+        return;
+      }
+
+      uint64_t value() const
+      {
+        return _value_;
+      }
+
+    private:
+
+      uint64_t _value_ = 14695981039346656037ULL; //!< Current state
+    };
+
+    //! Hash the contents of the files named by the string properties of a configuration
+    void hash_referenced_files(const datatools::properties & config_, fnv1a_hash & hash_)
+    {
+      for (const std::string & key : config_.keys()) {
+        if (! config_.is_string(key)) continue;
+        for (int i = 0; i < config_.size(key); i++) {
+          std::string path = config_.is_vector(key) ? config_.fetch_string_vector(key, i) : config_.fetch_string(key);
+          std::string errmsg;
+          if (path.empty() || ! datatools::fetch_path_with_env(path, errmsg)) continue;
+          boost::system::error_code ec;
+          if (! boost::filesystem::is_regular_file(path, ec)) continue;
+          hash_.update("file " + path + '\n');
+          hash_.update_file(path);
+        }
+      }
+      return;
+    }
+
+  } // end of anonymous namespace
+
   const std::string & gdml_export::default_length_unit()
   {
     static std::string _lunit;
@@ -139,6 +278,7 @@ namespace geomtools {
     _support_auxiliary_         = true;
     _support_replica_           = false;
     _fake_materials_            = false;
+    _number_of_threads_         = 1;
     return;
   }
 
@@ -153,6 +293,92 @@ namespace geomtools {
     return;
   }
 
+  unsigned int gdml_export::get_number_of_threads () const
+  {
+    return _number_of_threads_;
+  }
+
+  void gdml_export::set_number_of_threads (unsigned int n_)
+  {
+    _number_of_threads_ = n_;
+    return;
+  }
+
+  std::string gdml_export::compute_hash (const model_factory & factory_,
+                                         const std::string & model_name_) const
+  {
+    DT_THROW_IF (! factory_.is_locked (), std::logic_error, "Factory is not locked !");
+    std::string model_name = model_name_;
+    if (model_name.empty() || model_name == "<default>") {
+      model_name = model_factory::default_world_label();
+    }
+    fnv1a_hash hash;
+    std::ostringstream inputs;
+    inputs << "geomtools::gdml_export " << GEOMTOOLS_LIB_VERSION << ' ' << GDML_OUTPUT_REVISION << '\n'
+           << model_name << '\n'
+           << _length_unit_ << ' ' << _angle_unit_ << ' ' << _density_unit_ << '\n'
+           << _support_auxiliary_ << _support_replica_ << _fake_materials_ << '\n';
+    _parameters_.tree_dump (inputs);
+    if (_external_materials_stream_ != 0) {
+      inputs << _external_materials_stream_->str ();
+    }
+    datatools::multi_properties::config mp_writer (datatools::multi_properties::config::WITHOUT_DECORATION);
+    mp_writer.write (inputs, factory_.get_mp ());
+    for (logical_volume::dict_type::const_iterator i = factory_.get_logicals ().begin ();
+         i != factory_.get_logicals ().end ();
+         i++) {
+      const logical_volume & logical = *(i->second);
+      inputs << i->first << ' '
+             << (logical.has_material_ref () ? logical.get_material_ref () : "") << ' '
+             << (logical.has_shape () ? logical.get_shape ().get_shape_name () : "") << ' '
+             << logical.get_physicals ().size () << '\n';
+    }
+    hash.update (inputs.str ());
+    // The contents of the external data files used by the models (polycone/polyhedra
+    // data files, tessellation meshes...) are hashed, whatever paths or environment
+    // variables locate these files:
+    for (const std::string & section : factory_.get_mp ().ordered_keys ()) {
+      hash_referenced_files (factory_.get_mp ().get_section (section), hash);
+    }
+    std::ostringstream hash_oss;
+    hash_oss << std::hex << std::setfill('0') << std::setw(16) << hash.value ();
+    return hash_oss.str ();
+  }
+
+  std::string gdml_export::export_gdml_cached (const std::string & cache_dir_,
+                                               const model_factory & factory_,
+                                               const std::string & model_name_)
+  {
+    std::string cache_dir = cache_dir_;
+    if (cache_dir.empty()) {
+      cache_dir = ".";
+    }
+    datatools::fetch_path_with_env(cache_dir);
+    if (! boost::filesystem::is_directory (cache_dir)) {
+      boost::filesystem::create_directories (cache_dir);
+    }
+    const std::string hash = compute_hash (factory_, model_name_);
+    const std::string gdml_filename = cache_dir + "/geomtools_" + hash + ".gdml";
+    if (boost::filesystem::exists (gdml_filename)) {
+      DT_LOG_NOTICE(_logging_priority_, "Reuse the cached GDML file '" << gdml_filename << "'.");
+      return gdml_filename;
+    }
+    // Generate the GDML file under a unique name and publish it atomically, so that
+    // concurrent jobs sharing the cache directory never read a partial file:
+    const std::string tmp_filename
+      = boost::filesystem::unique_path (gdml_filename + ".%%%%-%%%%.tmp").string ();
+    try {
+      export_gdml (tmp_filename, factory_, model_name_);
+      boost::filesystem::rename (tmp_filename, gdml_filename);
+    } catch (...) {
+      boost::system::error_code ec;
+      boost::filesystem::remove (tmp_filename, ec);
+      throw;
+    }
+    DT_LOG_NOTICE(_logging_priority_, "Generated the cached GDML file '" << gdml_filename << "'.");
+    return gdml_filename;
+  }
+
   void gdml_export::export_gdml (const std::string & filename_,
                                  const model_factory & factory_,
                                  const std::string & model_name_)
@@ -189,7 +415,6 @@ namespace geomtools {
       _writer_.attach_external_materials (*_external_materials_stream_);
     }
     _writer_.init ();
-    _export_gdml_model (top_model);
 
     std::string xml_version  = gdml_writer::default_xml_version();
     std::string xml_encoding = gdml_writer::default_xml_encoding();
@@ -240,6 +465,13 @@ namespace geomtools {
       _density_unit_ = _parameters_.fetch_string ("density_unit");
     }
 
+    // Plan the export of the model:
+    _items_.clear ();
+    _solid_refs_.clear ();
+    _volume_refs_.clear ();
+    _export_gdml_model (top_model);
+    DT_LOG_DEBUG (get_logging_priority (), "Number of planned GDML export tasks : " << _items_.size ());
+
     // add a fake material:
     if (has_fake_materials()) {
       _writer_.add_material (material::material_ref_default(),
@@ -261,9 +493,220 @@ namespace geomtools {
 
     _writer_.add_setup("Setup", top_model.get_logical().get_name());
 
-    _writer_.full_write(out_, xml_version, xml_encoding, gdml_schema, xsi);
+    // Render the planned tasks by batches. The define section is streamed
+    // directly to the output while the solids and structure sections, which
+    // come after the materials section, are spilled in temporary files:
+    DT_THROW_IF (! out_, std::logic_error, "Output stream is invalid !");
+    unsigned int nthreads = _number_of_threads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency ());
+    }
+    std::vector<std::unique_ptr<gdml_writer> > writers;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      writers.push_back (std::unique_ptr<gdml_writer> (new gdml_writer));
+    }
+    tmp_file_handle solids_file = open_tmp_file ();
+    tmp_file_handle structure_file = open_tmp_file ();
+
+    _writer_.xml_header (out_, xml_version, xml_encoding, false);
+    _writer_.gdml_begin (out_, gdml_schema, xsi);
+    out_ << std::endl;
+    _writer_.gdml_section_begin (out_, gdml_writer::define_section());
+    for (std::size_t first = 0; first < _items_.size (); first += max_items_per_batch) {
+      const std::size_t last = std::min(first + max_items_per_batch, _items_.size ());
+      const std::size_t nitems = last - first;
+      const std::size_t nchunks = std::min<std::size_t>(nthreads, nitems);
+      const std::size_t chunk_size = (nitems + nchunks - 1) / nchunks;
+      if (nchunks == 1) {
+        _render_items_ (first, last, *writers[0]);
+      } else {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors (nchunks);
+        for (std::size_t ichunk = 0; ichunk < nchunks; ichunk++) {
+          const std::size_t chunk_first = std::min(first + ichunk * chunk_size, last);
+          const std::size_t chunk_last = std::min(chunk_first + chunk_size, last);
+          threads.push_back (std::thread ([this, chunk_first, chunk_last, ichunk, &writers, &errors] () {
+                try {
+                  _render_items_ (chunk_first, chunk_last, *writers[ichunk]);
+                } catch (...) {
+                  errors[ichunk] = std::current_exception ();
+                }
+              }));
+        }
+        for (std::size_t ichunk = 0; ichunk < threads.size (); ichunk++) {
+          threads[ichunk].join ();
+        }
+        for (std::size_t ichunk = 0; ichunk < errors.size (); ichunk++) {
+          if (errors[ichunk]) std::rethrow_exception (errors[ichunk]);
+        }
+      }
+      for (std::size_t ichunk = 0; ichunk < nchunks; ichunk++) {
+        gdml_writer & writer = *writers[ichunk];
+        out_ << writer.get_stream (gdml_writer::define_section()).str ();
+        append_to_tmp_file (solids_file.get (), writer.get_stream (gdml_writer::solids_section()).str ());
+        append_to_tmp_file (structure_file.get (), writer.get_stream (gdml_writer::structure_section()).str ());
+        writer.reset ();
+        writer.init ();
+      }
+    }
+    _writer_.gdml_section_end (out_, gdml_writer::define_section());
+    out_ << std::endl;
+
+    _writer_.gdml_section_begin (out_, gdml_writer::materials_section());
+    if (_writer_.has_external_materials_stream ()) {
+      out_ << _external_materials_stream_->str ();
+    }
+    out_ << _writer_.get_stream (gdml_writer::materials_section()).str ();
+    _writer_.gdml_section_end (out_, gdml_writer::materials_section());
+    out_ << std::endl;
+
+    _writer_.gdml_section_begin (out_, gdml_writer::solids_section());
+    copy_tmp_file (solids_file.get (), out_);
+    _writer_.gdml_section_end (out_, gdml_writer::solids_section());
+    out_ << std::endl;
+
+    _writer_.gdml_section_begin (out_, gdml_writer::structure_section());
+    copy_tmp_file (structure_file.get (), out_);
+    _writer_.gdml_section_end (out_, gdml_writer::structure_section());
+    out_ << std::endl;
+
+    out_ << _writer_.get_stream (gdml_writer::setup_section()).str ();
+    out_ << std::endl;
+
+    _writer_.gdml_end (out_);
+    out_ << std::endl;
+    DT_THROW_IF (! out_, std::runtime_error, "Cannot write the GDML description !");
+
     _writer_.reset();
+    _items_.clear ();
+    return;
+  }
 
+  void gdml_export::_render_items_ (std::size_t first_,
+                                    std::size_t last_,
+                                    gdml_writer & writer_) const
+  {
+    for (std::size_t i = first_; i < last_; i++) {
+      _render_item_ (_items_[i], writer_);
+    }
+    return;
+  }
+
+  void gdml_export::_render_item_ (const export_item & item_,
+                                   gdml_writer & writer_) const
+  {
+    switch (item_.type) {
+    case export_item::SOLID_PLACEMENT:
+      {
+        // Only stores the solid #2 placement:
+        const i_composite_shape_3d & c = dynamic_cast<const i_composite_shape_3d &> (*item_.shape);
+        std::string shape_label_1, shape_label_2, pos_ref, rot_ref;
+        composite_refs (c, item_.name, shape_label_1, shape_label_2, pos_ref, rot_ref);
+        writer_.add_position (pos_ref,
+                              c.get_shape2 ().get_placement ().get_translation (),
+                              _length_unit_);
+        writer_.add_rotation (rot_ref,
+                              c.get_shape2 ().get_placement ().get_rotation (),
+                              _angle_unit_);
+      }
+      break;
+    case export_item::SOLID:
+      {
+        const i_shape_3d & shape = *item_.shape;
+        const std::string & solid_name = item_.name;
+        const std::string shape_name = shape.get_shape_name();
+        if (shape.is_composite ()) {
+          /* GDML constraints:
+           * One should check if placement of shape 1 in any composite
+           * solid is NULL (translation & rotation).
+           */
+          const i_composite_shape_3d & c = dynamic_cast<const i_composite_shape_3d &> (shape);
+          std::string shape_label_1, shape_label_2, pos_ref, rot_ref;
+          composite_refs (c, solid_name, shape_label_1, shape_label_2, pos_ref, rot_ref);
+          if (shape_name == "union_3d") {
+            writer_.add_gdml_union (solid_name, shape_label_1, shape_label_2, pos_ref, rot_ref);
+          } else if (shape_name == "subtraction_3d") {
+            writer_.add_gdml_subtraction (solid_name, shape_label_1, shape_label_2, pos_ref, rot_ref);
+          } else if (shape_name == "intersection_3d") {
+            writer_.add_gdml_intersection (solid_name, shape_label_1, shape_label_2, pos_ref, rot_ref);
+          }
+        } else if (shape_name == "box") {
+          const box & b = dynamic_cast<const box &> (shape);
+          writer_.add_box(solid_name, b, _length_unit_);
+        } else if (shape_name == "cylinder") {
+          const cylinder & c = dynamic_cast<const cylinder &> (shape);
+          writer_.add_cylinder(solid_name, c, _length_unit_, _angle_unit_);
+        } else if (shape_name == "tube") {
+          const tube & t = dynamic_cast<const tube &> (shape);
+          writer_.add_tube(solid_name, t, _length_unit_, _angle_unit_);
+        } else if (shape_name == "torus") {
+          const torus & t = dynamic_cast<const torus &> (shape);
+          writer_.add_torus(solid_name, t, _length_unit_, _angle_unit_);
+        } else if (shape_name == "sphere") {
+          const sphere & sp = dynamic_cast<const sphere &> (shape);
+          writer_.add_sphere(solid_name, sp, _length_unit_, _angle_unit_);
+        } else if (shape_name == "right_circular_conical_frustrum") {
+          const right_circular_conical_frustrum & cf= dynamic_cast<const right_circular_conical_frustrum &> (shape);
+          writer_.add_cone_segment(solid_name, cf, _length_unit_, _angle_unit_);
+        } else if (shape_name == "polycone") {
+          const polycone & pc = dynamic_cast<const polycone &> (shape);
+          writer_.add_polycone(solid_name, pc, _length_unit_, _angle_unit_);
+        } else if (shape_name == "polyhedra") {
+          const polyhedra & ph = dynamic_cast<const polyhedra &> (shape);
+          writer_.add_polyhedra(solid_name, ph, _length_unit_, _angle_unit_);
+        } else if (shape_name == "ellipsoid") {
+          const ellipsoid & e = dynamic_cast<const ellipsoid &> (shape);
+          writer_.add_ellipsoid(solid_name, e, _length_unit_, _angle_unit_);
+        } else if (shape_name == "elliptical_cylinder") {
+          const elliptical_cylinder & et = dynamic_cast<const elliptical_cylinder &> (shape);
+          writer_.add_elliptical_tube(solid_name, et, _length_unit_, _angle_unit_);
+        } else if (shape_name == "tessellated") {
+          const tessellated_solid & ts = dynamic_cast<const tessellated_solid &> (shape);
+          writer_.add_tessellated(solid_name, ts, _length_unit_);
+        } else if (shape_name == "wall_solid") {
+          const wall_solid & ws = dynamic_cast<const wall_solid &> (shape);
+          writer_.add_wall(solid_name, ws, _length_unit_);
+        } else {
+          DT_THROW(std::logic_error, "Simple solid type '" << shape_name << "' is not supported !");
+        }
+      }
+      break;
+    case export_item::PHYSICAL:
+      _export_gdml_physical_ (item_.name, *item_.physical, &writer_, 0);
+      break;
+    case export_item::VOLUME:
+    case export_item::REPLICA_VOLUME:
+      {
+        const logical_volume & logical = *item_.logical;
+        const std::string solid_ref = item_.name + i_model::solid_suffix();
+        // export a dictionary of auxiliary properties:
+        std::map<std::string, std::string> auxprops;
+        if (is_auxiliary_supported ()) {
+          logical.get_parameters ().export_to_string_based_dictionary (auxprops, false);
+        }
+        if (item_.type == export_item::REPLICA_VOLUME) {
+          writer_.add_replica_volume (item_.name,
+                                      item_.material_ref,
+                                      solid_ref,
+                                      item_.replicavol,
+                                      _length_unit_,
+                                      _angle_unit_,
+                                      auxprops);
+        } else if (logical.get_physicals ().size () == 0) {
+          writer_.add_volume (item_.name,
+                              item_.material_ref,
+                              solid_ref,
+                              auxprops);
+        } else {
+          writer_.add_volume (item_.name,
+                              item_.material_ref,
+                              solid_ref,
+                              item_.physvols,
+                              auxprops);
+        }
+      }
+      break;
+    }
     return;
   }
 
@@ -283,139 +726,100 @@ namespace geomtools {
                  "Solid type '" << shape_name << "' is not supported !");
 
     if (shape_.is_composite ()) {
-      /* GDML constraints:
-       * One should check if placement of shape 1 in any composite
-       * solid is NULL (translation & rotation).
-       */
-      if (shape_name == "union_3d") {
-        const union_3d & u = static_cast<const union_3d &>(shape_);
-        std::string shape_label_1 = u.get_shape1().get_shape_label();
-        if (shape_label_1.empty()) {
-          shape_label_1 = solid_name_ + ".union.first_ref" + i_model::solid_suffix();
-        }
-        std::string shape_label_2 = u.get_shape2().get_shape_label();
-        if (shape_label_2.empty()) {
-          shape_label_2 = solid_name_ + ".union.second_ref" + i_model::solid_suffix();
-        }
-        std::string pos_ref = solid_name_ + ".union.pos_ref";
-        std::string rot_ref = solid_name_ + ".union.rot_ref";
-        // only stores the solid #2 placement:
-        _writer_.add_position (pos_ref,
-                               u.get_shape2 ().get_placement ().get_translation (),
-                               _length_unit_);
-        _writer_.add_rotation (rot_ref,
-                               u.get_shape2 ().get_placement ().get_rotation (),
-                               _angle_unit_);
-        this->_export_gdml_solid (u.get_shape1 ().get_shape (), shape_label_1);
-        this->_export_gdml_solid (u.get_shape2 ().get_shape (), shape_label_2);
-
-        _writer_.add_gdml_union (solid_name_,
-                                 shape_label_1,
-                                 shape_label_2,
-                                 pos_ref,
-                                 rot_ref);
-      } else if (shape_name == "subtraction_3d") {
-        const subtraction_3d & s = static_cast<const subtraction_3d &>(shape_);
-        std::string shape_label_1 = s.get_shape1().get_shape_label();
-        if (shape_label_1.empty()) {
-          shape_label_1 = solid_name_ + ".subtraction.first_ref" + i_model::solid_suffix();
-        }
-        std::string shape_label_2 = s.get_shape2().get_shape_label();
-        if (shape_label_2.empty()) {
-          shape_label_2 = solid_name_ + ".subtraction.second_ref" + i_model::solid_suffix();
-        }
-        std::string pos_ref = solid_name_ + ".subtraction.pos_ref";
-        std::string rot_ref = solid_name_ + ".subtraction.rot_ref";
+      DT_THROW_IF(shape_name != "union_3d"
+                  && shape_name != "subtraction_3d"
+                  && shape_name != "intersection_3d",
+                  std::logic_error, "Boolean solid type '" << shape_name << "' is not supported yet !");
+      const i_composite_shape_3d & c = dynamic_cast<const i_composite_shape_3d &> (shape_);
+      std::string shape_label_1, shape_label_2, pos_ref, rot_ref;
+      composite_refs (c, solid_name_, shape_label_1, shape_label_2, pos_ref, rot_ref);
+      export_item placement_item;
+      placement_item.type = export_item::SOLID_PLACEMENT;
+      placement_item.name = solid_name_;
+      placement_item.shape = &shape_;
+      _items_.push_back (placement_item);
+      this->_export_gdml_solid (c.get_shape1 ().get_shape (), shape_label_1);
+      this->_export_gdml_solid (c.get_shape2 ().get_shape (), shape_label_2);
+    }
+    export_item item;
+    item.type = export_item::SOLID;
+    item.name = solid_name_;
+    item.shape = &shape_;
+    _items_.push_back (item);
+    _solid_refs_.insert(solid_name_);
 
-        // only stores the solid #2 placement:
-        _writer_.add_position (pos_ref,
-                               s.get_shape2 ().get_placement ().get_translation (),
-                               _length_unit_);
-        _writer_.add_rotation (rot_ref,
-                               s.get_shape2 ().get_placement ().get_rotation (),
-                               _angle_unit_);
-        this->_export_gdml_solid (s.get_shape1 ().get_shape (), shape_label_1);
-        this->_export_gdml_solid (s.get_shape2 ().get_shape (), shape_label_2);
-
-        _writer_.add_gdml_subtraction (solid_name_,
-                                       shape_label_1,
-                                       shape_label_2,
-                                       pos_ref,
-                                       rot_ref);
-      } else if (shape_name == "intersection_3d") {
-        const intersection_3d & i = static_cast<const intersection_3d &> (shape_);
-        std::string shape_label_1 = i.get_shape1().get_shape_label();
-        if (shape_label_1.empty()) {
-          shape_label_1 = solid_name_ + ".intersection.first_ref" + i_model::solid_suffix();
-        }
-        std::string shape_label_2 = i.get_shape2().get_shape_label();
-        if (shape_label_2.empty()) {
-          shape_label_2 = solid_name_ + ".intersection.second_ref" + i_model::solid_suffix();
-        }
-        std::string pos_ref = solid_name_ + ".intersection.pos_ref";
-        std::string rot_ref = solid_name_ + ".intersection.rot_ref";
+    return;
+  }
 
-        // Only stores the solid #2 placement:
-        _writer_.add_position (pos_ref,
-                               i.get_shape2 ().get_placement ().get_translation (),
+  void gdml_export::_export_gdml_physical_ (const std::string & log_name_,
+                                            const physical_volume & phys_,
+                                            gdml_writer * writer_,
+                                            std::list<gdml_writer::physvol> * physvols_) const
+  {
+    const logical_volume & log_child = phys_.get_logical ();
+    const i_placement * pp = &(phys_.get_placement ());
+    bool multiple = false;
+    size_t nitems = pp->get_number_of_items ();
+    bool only_one_rotation = pp->has_only_one_rotation ();
+    multiple = (nitems > 1);
+
+    rotation_3d ref_rot;
+    invalidate_rotation_3d (ref_rot);
+    std::ostringstream ref_rot_name_oss;
+    if (only_one_rotation) {
+      ref_rot_name_oss << log_name_ << '.' << phys_.get_name ();
+      if (multiple) ref_rot_name_oss << "__" << '0' << ".." << (nitems - 1) << "__";
+      ref_rot_name_oss << ".rot";
+    }
+    for (size_t i = 0; i < nitems; i++) {
+      // extract placement for item 'i':
+      placement p;
+      pp->get_placement (i, p);
+
+      // register the position of item 'i':
+      std::ostringstream pos_name_oss;
+      pos_name_oss << log_name_ << '.' << phys_.get_name ();
+      if (multiple) pos_name_oss << "__" << i << "__";
+      pos_name_oss << io::position_suffix();
+      if (writer_ != 0) {
+        writer_->add_position (pos_name_oss.str (),
+                               p.get_translation (),
                                _length_unit_);
-        _writer_.add_rotation (rot_ref,
-                               i.get_shape2 ().get_placement ().get_rotation (),
-                               _angle_unit_);
-        this->_export_gdml_solid (i.get_shape1 ().get_shape (), shape_label_1);
-        this->_export_gdml_solid (i.get_shape2 ().get_shape (), shape_label_2);
-
-        _writer_.add_gdml_intersection (solid_name_,
-                                        shape_label_1,
-                                        shape_label_2,
-                                        pos_ref,
-                                        rot_ref);
-      } else {
-        DT_THROW_IF(true, std::logic_error, "Boolean solid type '" << shape_name << "' is not supported yet !");
       }
-    } else {
-      if (shape_name == "box") {
-        const box & b = dynamic_cast<const box &> (shape_);
-        _writer_.add_box(solid_name_, b, _length_unit_);
-      } else if (shape_name == "cylinder") {
-        const cylinder & c = dynamic_cast<const cylinder &> (shape_);
-        _writer_.add_cylinder(solid_name_, c, _length_unit_, _angle_unit_);
-      } else if (shape_name == "tube") {
-        const tube & t = dynamic_cast<const tube &> (shape_);
-        _writer_.add_tube(solid_name_, t, _length_unit_, _angle_unit_);
-      } else if (shape_name == "torus") {
-        const torus & t = dynamic_cast<const torus &> (shape_);
-        _writer_.add_torus(solid_name_, t, _length_unit_, _angle_unit_);
-      } else if (shape_name == "sphere") {
-        const sphere & s = dynamic_cast<const sphere &> (shape_);
-        _writer_.add_sphere(solid_name_, s, _length_unit_, _angle_unit_);
-      } else if (shape_name == "right_circular_conical_frustrum") {
-        const right_circular_conical_frustrum & cf= dynamic_cast<const right_circular_conical_frustrum &> (shape_);
-        _writer_.add_cone_segment(solid_name_, cf, _length_unit_, _angle_unit_);
-      } else if (shape_name == "polycone") {
-        const polycone & pc = dynamic_cast<const polycone &> (shape_);
-        _writer_.add_polycone(solid_name_, pc, _length_unit_, _angle_unit_);
-      } else if (shape_name == "polyhedra") {
-        const polyhedra & ph = dynamic_cast<const polyhedra &> (shape_);
-        _writer_.add_polyhedra(solid_name_, ph, _length_unit_, _angle_unit_);
-      } else if (shape_name == "ellipsoid") {
-        const ellipsoid & e = dynamic_cast<const ellipsoid &> (shape_);
-        _writer_.add_ellipsoid(solid_name_, e, _length_unit_, _angle_unit_);
-      } else if (shape_name == "elliptical_cylinder") {
-        const elliptical_cylinder & et = dynamic_cast<const elliptical_cylinder &> (shape_);
-        _writer_.add_elliptical_tube(solid_name_, et, _length_unit_, _angle_unit_);
-      } else if (shape_name == "tessellated") {
-        const tessellated_solid & ts = dynamic_cast<const tessellated_solid &> (shape_);
-        _writer_.add_tessellated(solid_name_, ts, _length_unit_);
-      } else if (shape_name == "wall_solid") {
-        const wall_solid & ws = dynamic_cast<const wall_solid &> (shape_);
-        _writer_.add_wall(solid_name_, ws, _length_unit_);
+
+      // register the rotation of item 'i':
+      //   default rotation name:
+      std::ostringstream rot_name_oss;
+      rot_name_oss << log_name_ << '.' << phys_.get_name ();
+      if (multiple) rot_name_oss << "__" << i << "__";
+      rot_name_oss << io::rotation_suffix();
+      std::string rot_name = rot_name_oss.str ();
+      bool add_rot = false;
+      if (only_one_rotation) {
+        rot_name = ref_rot_name_oss.str ();
+        if (! is_valid_rotation_3d (ref_rot)) {
+          ref_rot = p.get_rotation ();
+          add_rot= true;
+        }
       } else {
-        DT_THROW(std::logic_error, "Simple solid type '" << shape_name << "' is not supported !");
+        // Force add_rot:
+        add_rot = true;
       }
-    }
-    _solid_refs_.insert(solid_name_);
-
+      const bool identity = is_identity (p.get_rotation ());
+      if (add_rot && ! identity && writer_ != 0) {
+        writer_->add_rotation (rot_name,
+                               p.get_rotation (),
+                               _angle_unit_);
+      }
+      if (identity) {
+        rot_name = "";
+      }
+      if (physvols_ != 0) {
+        physvols_->push_back (gdml_writer::physvol (log_child.get_name (),
+                                                    pos_name_oss.str (),
+                                                    rot_name));
+      }
+    } // for ... items
     return;
   }
 
@@ -437,35 +841,24 @@ namespace geomtools {
     _export_gdml_solid (log_solid, solid_name);
 
     // prepare volume export
-    std::string material_ref = material::material_ref_unknown();
-    std::string solid_ref = solid_name;
+    export_item volume_item;
+    volume_item.type = export_item::VOLUME;
+    volume_item.name = log_name;
+    volume_item.logical = &logical;
+    volume_item.material_ref = material::material_ref_unknown();
     DT_LOG_TRACE (get_logging_priority (), "Logical:");
     if (get_logging_priority () >= datatools::logger::PRIO_TRACE) logical.tree_dump (std::cerr);
     if (logical.has_material_ref ()) {
-      material_ref = logical.get_material_ref ();
+      volume_item.material_ref = logical.get_material_ref ();
     } else {
       DT_THROW_IF (! logical.is_abstract (), std::logic_error,
                    "Logical volume '" << log_name << "' has no material !");
     }
 
-    bool skip = false;
-
-    // export a dictionary of auxiliary properties:
-    std::map<std::string, std::string> auxprops;
-    if (is_auxiliary_supported ()) {
-      logical.get_parameters ().export_to_string_based_dictionary (auxprops, false);
-    }
-
-    if (! skip && logical.get_physicals ().size () == 0) {
-      _writer_.add_volume (log_name,
-                           material_ref,
-                           solid_ref,
-                           auxprops);
-      skip = true;
-    }
-
-    // there is a replica children:
-    if (! skip && (_support_replica_ && logical.is_replica ())) {
+    if (logical.get_physicals ().size () == 0) {
+      // no children:
+    } else if (_support_replica_ && logical.is_replica ()) {
+      // there is a replica children:
       DT_LOG_TRACE (get_logging_priority (), "************** REPLICA **************");
       const physical_volume & phys = *(logical.get_physicals ().begin ()->second);
       DT_LOG_TRACE (get_logging_priority (), "replica phys=" << phys.get_name ());
@@ -475,7 +868,7 @@ namespace geomtools {
       _export_gdml_logical (log_child);
       const i_placement * pp = &(phys.get_placement ());
 
-      gdml_writer::replicavol a_replicavol;
+      gdml_writer::replicavol & a_replicavol = volume_item.replicavol;
       // only support for 'regular_linear_placement':
       const regular_linear_placement * RLP = 0;
       RLP = dynamic_cast<const regular_linear_placement *> (pp);
@@ -495,33 +888,9 @@ namespace geomtools {
       }
       a_replicavol.offset = 0.0;
       DT_LOG_TRACE (get_logging_priority (), "Add volume '" << log_name << "' (replica)...");
-
-      _writer_.add_replica_volume (log_name,
-                                   material_ref,
-                                   solid_ref,
-                                   a_replicavol,
-                                   _length_unit_,
-                                   _angle_unit_,
-                                   auxprops);
-      skip = true;
-    }
-
-    // there are children:
-    if (! skip && (logical.get_physicals ().size () > 0)) {
-      DT_LOG_TRACE (get_logging_priority (), "Here we should export the daughter physicals...");
-      DT_LOG_TRACE (get_logging_priority (), "List of daughter physicals:");
-      if (get_logging_priority () >= datatools::logger::PRIO_TRACE) {
-        for (logical_volume::physicals_col_type::const_iterator i
-               = logical.get_physicals ().begin ();
-             i != logical.get_physicals ().end ();
-             i++) {
-          const std::string & name = (i->first);
-          const physical_volume & phys = *(i->second);
-          DT_LOG_TRACE (get_logging_priority (), "    name=" << name << "     " << "phys->name=" << phys.get_name ());
-        }
-      }
-
-      std::list<gdml_writer::physvol> physvols;
+      volume_item.type = export_item::REPLICA_VOLUME;
+    } else {
+      // there are children:
       for (logical_volume::physicals_col_type::const_iterator iter
              = logical.get_physicals ().begin ();
            iter != logical.get_physicals ().end ();
@@ -533,89 +902,25 @@ namespace geomtools {
 
         _export_gdml_logical (log_child);
 
-        const i_placement * pp = &(phys.get_placement ());
-        bool multiple = false;
-        size_t nitems = pp->get_number_of_items ();
-        bool only_one_rotation = pp->has_only_one_rotation ();
-        multiple = (nitems > 1);
-
-        DT_LOG_TRACE (get_logging_priority (), "No replica... for '" << log_name << "'...");
-        // XXX UUU
-        rotation_3d ref_rot;
-        invalidate_rotation_3d (ref_rot);
-        std::ostringstream ref_rot_name_oss;
-        if (only_one_rotation) {
-          ref_rot_name_oss << log_name << '.' << phys.get_name ();
-          if (multiple) ref_rot_name_oss << "__" << '0' << ".." << (nitems - 1) << "__";
-          ref_rot_name_oss << ".rot";
-        }
-        DT_LOG_TRACE (get_logging_priority (), "Add placements for " << nitems << " items...");
-        for (size_t i = 0; i < nitems; i++) {
-          // extract placement for item 'i':
-          placement p;
-          pp->get_placement (i, p);
-
-          // register the position of item 'i':
-          std::ostringstream pos_name_oss;
-          pos_name_oss << log_name << '.' << phys.get_name ();
-          if (multiple) pos_name_oss << "__" << i << "__";
-          pos_name_oss << io::position_suffix();
-          _writer_.add_position (pos_name_oss.str (),
-                                 p.get_translation (),
-                                 _length_unit_);
-
-          DT_LOG_TRACE (get_logging_priority (), "Add rotation...");
-          // register the rotation of item 'i':
-          //   default rotation name:
-          std::ostringstream rot_name_oss;
-          rot_name_oss << log_name << '.' << phys.get_name ();
-          if (multiple) rot_name_oss << "__" << i << "__";
-          rot_name_oss << io::rotation_suffix();
-          std::string rot_name = rot_name_oss.str ();
-          bool add_rot = false;
-          // XXX YYY ZZZ
-          if (only_one_rotation) {
-            rot_name = ref_rot_name_oss.str ();
-            if (! is_valid_rotation_3d (ref_rot)) {
-              ref_rot = p.get_rotation ();
-              add_rot= true;
-            }
-          } else {
-            // Force add_rot:
-            add_rot = true;
-          }
-          if (add_rot) {
-            if (! is_identity (p.get_rotation ())) {
-              _writer_.add_rotation (rot_name,
-                                     p.get_rotation (),
-                                     _angle_unit_);
-            }
-          }
-          if (is_identity (p.get_rotation ())) {
-            rot_name = "";
-          }
-          physvols.push_back (gdml_writer::physvol (log_child.get_name (),
-                                                    pos_name_oss.str (),
-                                                    rot_name));
-        } // for ... items
-        DT_LOG_TRACE (get_logging_priority (), "Add volume '" << log_name << "' with physvols=");
-        if (get_logging_priority () >= datatools::logger::PRIO_TRACE) {
-          std::ostringstream message;
-          for (std::list<gdml_writer::physvol>::const_iterator jj = physvols.begin ();
-               jj != physvols.end ();
-               jj++) {
-            message << '"' << jj->volumeref << '"' << ' ';
-          }
-          DT_LOG_TRACE (get_logging_priority (), message.str ());
+        export_item physical_item;
+        physical_item.type = export_item::PHYSICAL;
+        physical_item.name = log_name;
+        physical_item.logical = &logical;
+        physical_item.physical = &phys;
+        _items_.push_back (physical_item);
+        _export_gdml_physical_ (log_name, phys, 0, &volume_item.physvols);
+      }
+      if (get_logging_priority () >= datatools::logger::PRIO_TRACE) {
+        std::ostringstream message;
+        for (std::list<gdml_writer::physvol>::const_iterator jj = volume_item.physvols.begin ();
+             jj != volume_item.physvols.end ();
+             jj++) {
+          message << '"' << jj->volumeref << '"' << ' ';
         }
+        DT_LOG_TRACE (get_logging_priority (), "Add volume '" << log_name << "' with physvols=" << message.str ());
       }
-      _writer_.add_volume (log_name,
-                           material_ref,
-                           solid_ref,
-                           physvols,
-                           auxprops);
-      skip = true;
-    } // there are children:
+    }
+    _items_.push_back (volume_item);
 
     _volume_refs_.insert(log_name);
     return;
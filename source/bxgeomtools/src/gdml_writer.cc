@@ -41,91 +41,61 @@ namespace geomtools {
   // statics
   const std::string & gdml_writer::default_xml_version()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "1.0";
-    }
+    static const std::string label("1.0");
     return label;
   }
 
   const std::string & gdml_writer::default_xml_encoding()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "UTF-8";
-    }
+    static const std::string label("UTF-8");
     return label;
   }
 
   const std::string & gdml_writer::default_xsi()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "http://www.w3.org/2001/XMLSchema-instance";
-    }
+    static const std::string label("http://www.w3.org/2001/XMLSchema-instance");
     return label;
   }
 
   const std::string & gdml_writer::default_gdml_schema()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "gdml.xsd";
-    }
+    static const std::string label("gdml.xsd");
     return label;
   }
 
   const std::string & gdml_writer::default_remote_gdml_schema()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "http://service-spi.web.cern.ch/service-spi/app/releases/GDML/schema/gdml.xsd";
-    }
+    static const std::string label("http://service-spi.web.cern.ch/service-spi/app/releases/GDML/schema/gdml.xsd");
     return label;
   }
 
   const std::string & gdml_writer::define_section()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "define";
-    }
+    static const std::string label("define");
     return label;
   }
 
   const std::string & gdml_writer::materials_section()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "materials";
-    }
+    static const std::string label("materials");
     return label;
   }
 
   const std::string & gdml_writer::solids_section()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "solids";
-    }
+    static const std::string label("solids");
     return label;
   }
 
   const std::string & gdml_writer::structure_section()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "structure";
-    }
+    static const std::string label("structure");
     return label;
   }
 
   const std::string & gdml_writer::setup_section()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "setup";
-    }
+    static const std::string label("setup");
     return label;
   }
 
@@ -1834,10 +1804,7 @@ namespace geomtools {
   // static
   const std::string & gdml_writer::replicavol::replicated_along_axis()
   {
-    static std::string label;
-    if (label.empty()) {
-      label = "replicated_along_axis";
-    }
+    static const std::string label("replicated_along_axis");
     return label;
   }
 
@@ -29,6 +29,11 @@ namespace geomtools {
     return _world_placement_;
   }
 
+  const affine_transform & geom_info::get_world_transform () const
+  {
+    return _world_transform_;
+  }
+
   const logical_volume & geom_info::get_logical () const
   {
     return *_logical_;
@@ -76,6 +81,7 @@ namespace geomtools {
   {
     _gid_ = a_id;
     _world_placement_ = a_world_placement;
+    _world_transform_.set (_world_placement_);
     _logical_ = &a_logical_volume;
     return;
   }
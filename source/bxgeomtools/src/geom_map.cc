@@ -189,8 +189,7 @@ namespace geomtools {
     }
     const geom_info & ginfo = ginfo_;
     vector_3d local_position;
-    const placement & pl = ginfo.get_world_placement ();
-    pl.mother_to_child (world_position_, local_position);
+    ginfo.get_world_transform ().mother_to_child (world_position_, local_position);
     const logical_volume & log = ginfo.get_logical ();
     const i_shape_3d & shape = log.get_shape ();
     if (devel) {
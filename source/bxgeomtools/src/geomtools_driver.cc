@@ -4,6 +4,8 @@
 #include <geomtools/geomtools_driver.h>
 
 // Standard Library:
+#include <fstream>
+#include <sstream>
 
 // Third party:
 // - Boost:
@@ -23,6 +25,7 @@
 #include <geomtools/materials_plugin.h>
 #include <geomtools/materials_utils.h>
 #include <geomtools/gdml_export.h>
+#include <geomtools/overlap_checker.h>
 #include <geomtools/placement.h>
 #include <geomtools/i_composite_shape_3d.h>
 #include <geomtools/i_wires_3d_rendering.h>
@@ -1109,6 +1112,134 @@ namespace geomtools {
                        _params_.logging);
   }
 
+  int geomtools_driver::command_check_overlaps(const std::vector<std::string> & argv_,
+                                               std::ostream & out_) const
+  {
+    if (! is_initialized()) {
+      DT_LOG_ERROR(_params_.logging, "Driver is not initialized !");
+      return 1;
+    }
+    geomtools::overlap_checker checker;
+    checker.set_logging(_params_.logging);
+    std::string top_name;
+    std::string report_file;
+    size_t argcount = 0;
+    while (argcount < argv_.size()) {
+      const std::string & token = argv_[argcount++];
+      if (token.empty()) break;
+      if (token[0] == '-') {
+        std::string option = token;
+        if (option == "-h" || option == "--help") {
+          out_ << "  Usage: \n";
+          out_ << "    check_overlaps [OPTIONS...] [NAME] \n"
+               << "\n";
+          out_ << "  Options: \n";
+          out_ << "    -h [ --help ]             Print this help\n"
+               << "    -s [ --sampling ] LEVEL   Sampling density of the surfaces of the volumes\n"
+               << "                              (low, normal, high, very_high, huge)\n"
+               << "    -j [ --threads ] N        Number of threads (0: number of cores)\n"
+               << "    -a [ --all ]              Report all overlapping vertexes\n"
+               << "    --no-mother-daughter      Do not check daughters against their mother volume\n"
+               << "    -o [ --output ] FILE      Store the report in a file\n"
+               << "\n";
+          out_ << "  NAME : The name of the top geometry model or logical volume (optional)\n";
+          out_ << std::flush;
+          return -1;
+        } else if (option == "-s" || option == "--sampling") {
+          if (argcount == argv_.size()) {
+            DT_LOG_ERROR(_params_.logging, "Missing sampling level !");
+            return 1;
+          }
+          const std::string & sampling = argv_[argcount++];
+          try {
+            checker.set_sampling(sampling);
+          } catch (std::exception & error) {
+            DT_LOG_ERROR(_params_.logging, error.what());
+            return 1;
+          }
+        } else if (option == "-j" || option == "--threads") {
+          if (argcount == argv_.size()) {
+            DT_LOG_ERROR(_params_.logging, "Missing number of threads !");
+            return 1;
+          }
+          std::istringstream iss(argv_[argcount++]);
+          int nthreads = 0;
+          iss >> nthreads;
+          if (! iss || nthreads < 0) {
+            DT_LOG_ERROR(_params_.logging, "Invalid number of threads !");
+            return 1;
+          }
+          checker.set_number_of_threads((unsigned int) nthreads);
+        } else if (option == "-a" || option == "--all") {
+          checker.set_overlap_all(true);
+        } else if (option == "--no-mother-daughter") {
+          checker.set_check_mother_daughter(false);
+        } else if (option == "-o" || option == "--output") {
+          if (argcount == argv_.size()) {
+            DT_LOG_ERROR(_params_.logging, "Missing report file !");
+            return 1;
+          }
+          report_file = argv_[argcount++];
+        } else {
+          DT_LOG_ERROR(_params_.logging, "Invalid option '" << token << "' !");
+          return -1;
+        }
+      } else {
+        std::string argument = token;
+        if (top_name.empty()) {
+          top_name = argument;
+        } else {
+          DT_LOG_ERROR(_params_.logging, "Invalid argument '" << argument << "' !");
+          return -1;
+        }
+      }
+    } // while
+    if (top_name.empty()) {
+      top_name = _params_.top_mapping_model_name;
+    }
+    if (top_name.empty()) {
+      top_name = geomtools::model_factory::default_world_label();
+    }
+    // The top volume is searched first as a geometry model, then as a logical volume:
+    const geomtools::logical_volume * top_logical = nullptr;
+    geomtools::models_col_type::const_iterator found_model
+      = _geo_factory_ref_->get_models().find(top_name);
+    if (found_model != _geo_factory_ref_->get_models().end()) {
+      top_logical = &found_model->second->get_logical();
+    } else {
+      geomtools::logical_volume::dict_type::const_iterator found_logical
+        = _geo_factory_ref_->get_logicals().find(top_name);
+      if (found_logical != _geo_factory_ref_->get_logicals().end()) {
+        top_logical = found_logical->second;
+      }
+    }
+    if (top_logical == nullptr) {
+      DT_LOG_ERROR(_params_.logging,
+                   "No geometry model or logical volume named '" << top_name << "' !");
+      return 1;
+    }
+    geomtools::overlap_checker::report overlap_report;
+    checker.check(*top_logical, overlap_report);
+    std::ostringstream title_oss;
+    title_oss << "Overlaps in '" << top_name << "' (sampling: " << checker.get_sampling_label() << ") : ";
+    overlap_report.tree_dump(out_, title_oss.str());
+    if (! report_file.empty()) {
+      std::string report_path = report_file;
+      datatools::fetch_path_with_env(report_path);
+      std::ofstream report_out(report_path.c_str());
+      if (! report_out) {
+        DT_LOG_ERROR(_params_.logging, "Cannot open report file '" << report_path << "' !");
+        return 1;
+      }
+      overlap_report.tree_dump(report_out, title_oss.str());
+    }
+    if (overlap_report.has_overlaps()) {
+      DT_LOG_WARNING(_params_.logging, "Found " << overlap_report.overlaps.size()
+                     << " overlaps in '" << top_name << "' !");
+    }
+    return 0;
+  }
+
   /*
     int geomtools_driver::command_set_rendering_options(const std::vector<std::string> & argv_,
     std::ostream & out_)
@@ -1247,6 +1378,8 @@ namespace geomtools {
     uint32_t rendering_options_depth = 0;
     std::set<std::string> rendering_tags;
     int max_display_level = geomtools::gnuplot_drawer::DISPLAY_LEVEL_NO_LIMIT;
+    unsigned int nthreads = 1;
+    double lod_threshold = 0.0;
     size_t argcount = 0;
     while (argcount < argv_.size()) {
       const std::string & token = argv_[argcount++];
@@ -1294,6 +1427,11 @@ namespace geomtools {
                << "    -x  [ --max-display-level ] [depth]\n"
                << "                                Display daughter volume(s) down to\n"
                << "                                level 'depth'.\n"
+               << "    -j  [ --threads ] [n]       Use 'n' threads to generate the wires\n"
+               << "                                (0: number of hardware threads).\n"
+               << "    -lod [ --lod-threshold ] [fraction]\n"
+               << "                                Decimate the wires of volumes smaller\n"
+               << "                                than 'fraction' of the largest volume.\n"
                << "    -r  [ --terminal ] TERM     Use terminal 'TERM'\n"
                << "    -R  [ --terminal-options ] TERMOPT \n"
                << "                                Use terminal options 'TERMOPT'\n"
@@ -1359,6 +1497,28 @@ namespace geomtools {
             return -1;
           }
           max_display_level = level;
+        } else if (option == "-j" || option == "--threads") {
+          std::string threads_repr = argv_[argcount++];
+          std::istringstream threads_iss(threads_repr);
+          int threads = -1;
+          threads_iss >> threads;
+          if (! threads_iss || threads < 0) {
+            DT_LOG_ERROR(_params_.logging, "Invalid number of threads argument '"
+                         << threads_repr << "' !");
+            return -1;
+          }
+          nthreads = threads;
+        } else if (option == "-lod" || option == "--lod-threshold") {
+          std::string lod_repr = argv_[argcount++];
+          std::istringstream lod_iss(lod_repr);
+          double lod = -1.0;
+          lod_iss >> lod;
+          if (! lod_iss || lod < 0.0 || lod > 1.0) {
+            DT_LOG_ERROR(_params_.logging, "Invalid level of detail threshold argument '"
+                         << lod_repr << "' !");
+            return -1;
+          }
+          lod_threshold = lod;
         } else {
           _params_.visu_drawer_view = get_drawer_view(option);
         }
@@ -1452,6 +1612,8 @@ namespace geomtools {
     geomtools::gnuplot_drawer GPD;
     GPD.set_rendering_options_current(rendering_options);
     GPD.set_rendering_options_depth(rendering_options_depth);
+    GPD.set_number_of_threads(nthreads);
+    GPD.set_lod_threshold(lod_threshold);
     GPD.set_drawing_display_data(process_display_data);
     if (GPD.is_drawing_display_data()) {
       // Load display data:
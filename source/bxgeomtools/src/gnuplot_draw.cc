@@ -5,8 +5,10 @@
 
 // Standard library:
 #include <cmath>
+#include <cstdio>
 #include <stdexcept>
 #include <algorithm>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -378,6 +380,99 @@ namespace geomtools {
     return;
   }
 
+  namespace {
+
+    //! Append a real number to a buffer, formatted as by a stream with precision 15
+    void append_real(std::string & buffer_, double value_)
+    {
+      char digits[32];
+      int ndigits = 0;
+      if (value_ == std::floor(value_) && std::abs(value_) < 1.e15) {
+        // Integral values are frequent in geometry descriptions:
+        if (std::signbit(value_)) buffer_ += '-';
+        unsigned long long n = static_cast<unsigned long long>(std::abs(value_));
+        do {
+          digits[ndigits++] = static_cast<char>('0' + n % 10);
+          n /= 10;
+        } while (n > 0);
+        while (ndigits > 0) buffer_ += digits[--ndigits];
+        return;
+      }
+      ndigits = std::snprintf(digits, sizeof(digits), "%.15g", value_);
+      buffer_.append(digits, ndigits);
+      return;
+    }
+
+    //! Append a point to a buffer, formatted as by gnuplot_draw::basic_draw_point
+    void append_point(std::string & buffer_,
+                      const vector_3d & point_,
+                      const std::string & color_suffix_,
+                      gnuplot_draw::xyz_range & range_)
+    {
+      range_.add_point(point_);
+      append_real(buffer_, point_.x());
+      buffer_ += ' ';
+      append_real(buffer_, point_.y());
+      buffer_ += ' ';
+      append_real(buffer_, point_.z());
+      buffer_ += color_suffix_;
+      buffer_ += '\n';
+      return;
+    }
+
+  }
+
+  void
+  gnuplot_draw::basic_draw_compact_wires(std::string & buffer_,
+                                         const placement & p_,
+                                         const compact_wires & wires_,
+                                         xyz_range & range_,
+                                         unsigned int stride_)
+  {
+    std::string color_suffix;
+    if (color_context_const().is_activated()) {
+      color_suffix = ' ' + color_context_const().str();
+    }
+    const std::size_t stride = std::max(stride_, 1U);
+    std::vector<vector_3d> points;
+    bool gp_trick_done = false;
+    for (std::size_t iwire = 0; iwire < wires_.get_number_of_wires(); iwire++) {
+      const std::size_t npoints = wires_.get_number_of_points(iwire);
+      if (npoints < 2) {
+        continue;
+      }
+      points.clear();
+      for (std::size_t ipoint = 0; ipoint < npoints; ipoint++) {
+        if ((ipoint % stride) != 0 && (ipoint + 1) != npoints) {
+          continue;
+        }
+        const double * xyz = wires_.get_point(iwire, ipoint);
+        points.push_back(vector_3d());
+        p_.child_to_mother(vector_3d(xyz[0], xyz[1], xyz[2]), points.back());
+      }
+      std::size_t first = 0;
+      if (! gp_trick_done) {
+        // Same trick than in basic_draw_polyline:
+        const vector_3d mid1 = 0.5 * (points[0] + points[1]);
+        const vector_3d mid2 = 0.5 * (mid1 + points[1]);
+        append_point(buffer_, points[0], color_suffix, range_);
+        append_point(buffer_, mid1, color_suffix, range_);
+        buffer_ += '\n';
+        append_point(buffer_, mid1, color_suffix, range_);
+        append_point(buffer_, mid2, color_suffix, range_);
+        append_point(buffer_, points[1], color_suffix, range_);
+        buffer_ += '\n';
+        first = 1;
+        gp_trick_done = true;
+      }
+      for (std::size_t ipoint = first; ipoint < points.size(); ipoint++) {
+        append_point(buffer_, points[ipoint], color_suffix, range_);
+      }
+      buffer_ += '\n';
+    }
+    return;
+  }
+
   void
   gnuplot_draw::draw_wires(std::ostream & out_,
                            const wires_type & wires_)
@@ -6,6 +6,15 @@
 // Standard libraries:
 #include <stdexcept>
 #include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
+#include <set>
+#include <thread>
+#include <utility>
 
 // Third party:
 // - Boost:
@@ -30,9 +39,53 @@
 #include <geomtools/geom_info.h>
 #include <geomtools/mapping.h>
 #include <geomtools/manager.h>
+#include <geomtools/i_shape_3d.h>
+#include <geomtools/i_wires_3d_rendering.h>
 
 namespace geomtools {
 
+  namespace {
+
+    //! Maximum decimation stride of the polylines of small volumes
+    const unsigned int MAX_LOD_STRIDE = 16;
+
+    //! Process items with several threads, each thread picking the next unprocessed item
+    void process_items(std::size_t nitems_,
+                       unsigned int nthreads_,
+                       const std::function<void(std::size_t)> & process_)
+    {
+      const std::size_t nworkers = std::min<std::size_t>(nthreads_, nitems_);
+      if (nworkers <= 1) {
+        for (std::size_t item = 0; item < nitems_; item++) {
+          process_(item);
+        }
+        return;
+      }
+      std::atomic<std::size_t> next_item(0);
+      std::vector<std::exception_ptr> errors(nworkers);
+      std::vector<std::thread> workers;
+      for (std::size_t iworker = 0; iworker < nworkers; iworker++) {
+        workers.push_back(std::thread([nitems_, iworker, &process_, &next_item, &errors] () {
+              try {
+                for (std::size_t item = next_item++; item < nitems_; item = next_item++) {
+                  process_(item);
+                }
+              } catch (...) {
+                errors[iworker] = std::current_exception();
+              }
+            }));
+      }
+      for (std::size_t iworker = 0; iworker < workers.size(); iworker++) {
+        workers[iworker].join();
+      }
+      for (std::size_t iworker = 0; iworker < errors.size(); iworker++) {
+        if (errors[iworker]) std::rethrow_exception(errors[iworker]);
+      }
+      return;
+    }
+
+  }
+
   // static
   const int gnuplot_drawer::DISPLAY_LEVEL_NO_LIMIT;
 
@@ -437,6 +490,30 @@ namespace geomtools {
     return;
   }
 
+  unsigned int gnuplot_drawer::get_number_of_threads() const
+  {
+    return _number_of_threads_;
+  }
+
+  void gnuplot_drawer::set_number_of_threads(unsigned int n_)
+  {
+    _number_of_threads_ = n_;
+    return;
+  }
+
+  double gnuplot_drawer::get_lod_threshold() const
+  {
+    return _lod_threshold_;
+  }
+
+  void gnuplot_drawer::set_lod_threshold(double threshold_)
+  {
+    DT_THROW_IF(threshold_ < 0.0 || threshold_ > 1.0, std::domain_error,
+                "Invalid level of detail threshold (" << threshold_ << ") !");
+    _lod_threshold_ = threshold_;
+    return;
+  }
+
   gnuplot_drawer::gnuplot_drawer ()
   {
     _initialized_ = false;
@@ -493,6 +570,9 @@ namespace geomtools {
     _using_title_ = true;
     _mode_ = gnuplot_drawer::default_mode();
     _display_data_.clear();
+    _number_of_threads_ = 1;
+    _lod_threshold_ = 0.0;
+    _wires_tasks_.clear();
     return;
   }
 
@@ -526,6 +606,8 @@ namespace geomtools {
     out_<< std::endl;
     out_ << "|-- " << "Terminal         : " << _terminal_ << std::endl;
     out_ << "|-- " << "Terminal options : " << _terminal_options_ << std::endl;
+    out_ << "|-- " << "Threads          : " << _number_of_threads_ << std::endl;
+    out_ << "|-- " << "LOD threshold    : " << _lod_threshold_ << std::endl;
     out_ << "`-- " << "Output           : " << _output_ << std::endl;
     return;
   }
@@ -606,7 +688,7 @@ namespace geomtools {
                           << "' for logical '" << log.get_name() << "'...");
           }
           if (color_label != color::transparent()) {
-            std::ostringstream & colored_oss = _get_stream (color_label);
+            _get_stream (color_label);
             // unsigned long mode = gnuplot_draw::MODE_NULL;
             // if (visibility::is_wired_cylinder(log_visu_config)) {
             //   mode |= gnuplot_draw::MODE_WIRED_CYLINDER;
@@ -621,10 +703,21 @@ namespace geomtools {
             if ((_rendering_options_depth_ + 1) > 0) {
               options = _rendering_options_current_;
             }
-            gnuplot_draw::draw(colored_oss,
-                               p_,
-                               log.get_shape(),
-                               options);
+            // The wires are rendered later, once per logical volume:
+            wires_task task;
+            task.log = &log;
+            task.plcmt = p_;
+            task.color_label = color_label;
+            task.options = options;
+            const i_object_3d & shape = log.get_shape();
+            if (! shape.has_wires_drawer()
+                && dynamic_cast<const i_wires_3d_rendering *>(&shape) == nullptr) {
+              std::ostringstream rendered_oss;
+              gnuplot_draw::draw(rendered_oss, p_, shape, options);
+              task.prerendered = true;
+              task.rendered = rendered_oss.str();
+            }
+            _wires_tasks_.push_back(task);
           }
         } // if (is_wired())
         
@@ -757,6 +850,132 @@ namespace geomtools {
     return;
   }
 
+  void gnuplot_drawer::_render_wires_tasks_()
+  {
+    if (_wires_tasks_.empty()) {
+      return;
+    }
+    unsigned int nthreads = _number_of_threads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // Generate the wires of each shape once, in its own reference frame:
+    typedef std::pair<const i_object_3d *, uint32_t> wires_key_type;
+    std::map<wires_key_type, std::size_t> wires_indexes;
+    std::vector<wires_key_type> wires_keys;
+    std::vector<const logical_volume *> wires_logs;
+    std::vector<std::size_t> task_wires(_wires_tasks_.size(), 0);
+    for (std::size_t itask = 0; itask < _wires_tasks_.size(); itask++) {
+      const wires_task & task = _wires_tasks_[itask];
+      if (task.prerendered) continue;
+      const wires_key_type key(&task.log->get_shape(), task.options);
+      std::map<wires_key_type, std::size_t>::const_iterator found = wires_indexes.find(key);
+      if (found == wires_indexes.end()) {
+        found = wires_indexes.insert(std::make_pair(key, wires_keys.size())).first;
+        wires_keys.push_back(key);
+        wires_logs.push_back(task.log);
+      }
+      task_wires[itask] = found->second;
+    }
+    // Data built at first use by the shapes (and by the components of
+    // composite shapes) must exist before the threads query them:
+    {
+      std::set<const i_object_3d *> prepared;
+      for (std::size_t iwires = 0; iwires < wires_keys.size(); iwires++) {
+        if (! prepared.insert(wires_keys[iwires].first).second) continue;
+        const i_shape_3d * shape_3d = dynamic_cast<const i_shape_3d *>(wires_keys[iwires].first);
+        if (shape_3d != nullptr) {
+          shape_3d->build_computed_data();
+        }
+      }
+    }
+    std::vector<compact_wires> wires(wires_keys.size());
+    process_items(wires_keys.size(), nthreads, [&wires_keys, &wires_logs, &wires] (std::size_t iwires_) {
+        const i_object_3d & shape = *wires_keys[iwires_].first;
+        wires_type local_wires;
+        try {
+          if (shape.has_wires_drawer()) {
+            shape.get_wires_drawer().generate_wires_self(local_wires, wires_keys[iwires_].second);
+          } else {
+            dynamic_cast<const i_wires_3d_rendering &>(shape).generate_wires_self(local_wires, wires_keys[iwires_].second);
+          }
+        } catch (std::exception & x) {
+          DT_THROW(std::logic_error,
+                   "Logical '" << wires_logs[iwires_]->get_name() << "' : Cannot generate wires : " << x.what());
+        }
+        wires[iwires_].add(local_wires);
+      });
+
+    // Level of detail of the volumes relative to the largest one:
+    std::vector<unsigned int> strides(wires.size(), 1);
+    if (_lod_threshold_ > 0.0) {
+      double reference_extent = 0.0;
+      for (std::size_t iwires = 0; iwires < wires.size(); iwires++) {
+        reference_extent = std::max(reference_extent, wires[iwires].get_extent());
+      }
+      for (std::size_t iwires = 0; reference_extent > 0.0 && iwires < wires.size(); iwires++) {
+        const double fraction = wires[iwires].get_extent() / reference_extent;
+        if (fraction < _lod_threshold_) {
+          strides[iwires] = MAX_LOD_STRIDE;
+          if (fraction * MAX_LOD_STRIDE > _lod_threshold_) {
+            strides[iwires] = static_cast<unsigned int>(std::ceil(_lod_threshold_ / fraction));
+          }
+        }
+      }
+    }
+
+    // Render the placed volumes by chunks of contiguous tasks, each chunk in
+    // its own buffers which are then appended to the colored streams in the
+    // order of the tasks:
+    struct chunk_output_type
+    {
+      std::map<std::string, std::string> buffers;
+      gnuplot_draw::xyz_range range;
+    };
+    const std::size_t ntasks = _wires_tasks_.size();
+    const std::size_t nchunks = std::min<std::size_t>(ntasks, 4 * nthreads);
+    const std::size_t chunk_size = (ntasks + nchunks - 1) / nchunks;
+    std::vector<chunk_output_type> chunk_outputs(nchunks);
+    process_items(nchunks, nthreads, [this, ntasks, chunk_size, &task_wires, &wires, &strides, &chunk_outputs] (std::size_t ichunk_) {
+        chunk_output_type & output = chunk_outputs[ichunk_];
+        output.range.activate();
+        const std::size_t last = std::min(ntasks, (ichunk_ + 1) * chunk_size);
+        for (std::size_t itask = ichunk_ * chunk_size; itask < last; itask++) {
+          const wires_task & task = _wires_tasks_[itask];
+          std::string & buffer = output.buffers[task.color_label];
+          if (task.prerendered) {
+            buffer += task.rendered;
+          } else {
+            gnuplot_draw::basic_draw_compact_wires(buffer,
+                                                   task.plcmt,
+                                                   wires[task_wires[itask]],
+                                                   output.range,
+                                                   strides[task_wires[itask]]);
+          }
+        }
+      });
+    gnuplot_draw::xyz_range & BB = gnuplot_draw::bounding_box();
+    for (std::size_t ichunk = 0; ichunk < chunk_outputs.size(); ichunk++) {
+      const chunk_output_type & output = chunk_outputs[ichunk];
+      for (std::map<std::string, std::string>::const_iterator i = output.buffers.begin();
+           i != output.buffers.end();
+           i++) {
+        _get_stream(i->first) << i->second;
+      }
+      if (output.range.get_x_range().is_valid()) {
+        BB.add_point(output.range.get_x_range().get_min(),
+                     output.range.get_y_range().get_min(),
+                     output.range.get_z_range().get_min());
+        BB.add_point(output.range.get_x_range().get_max(),
+                     output.range.get_y_range().get_max(),
+                     output.range.get_z_range().get_max());
+      }
+    }
+    _wires_tasks_.clear();
+    return;
+  }
+
   void gnuplot_drawer::draw_logical(const logical_volume & log_,
                                     const placement & p_,
                                     int max_display_level_,
@@ -819,7 +1038,9 @@ namespace geomtools {
 
     if (shown) {
       DT_LOG_DEBUG(local_priority, "shown!");
+      _wires_tasks_.clear();
       gnuplot_drawer::_draw_(log_, p_, max_display_level);
+      _render_wires_tasks_();
     }
 
     try {
@@ -267,6 +267,18 @@ namespace geomtools {
     return _shape2_;
   }
 
+  void i_composite_shape_3d::build_computed_data() const
+  {
+    this->i_shape_3d::build_computed_data();
+    for (int i = 0; i < 2; i++) {
+      const shape_type & st = get_shape(i);
+      if (st.is_valid()) {
+        st.get_shape().build_computed_data();
+      }
+    }
+    return;
+  }
+
   void i_composite_shape_3d::tree_dump(std::ostream & out_,
                                        const std::string & title_,
                                        const std::string & indent_,
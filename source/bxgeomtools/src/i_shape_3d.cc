@@ -13,6 +13,7 @@
 #include <geomtools/utils.h>
 #include <geomtools/i_shape_2d.h>
 #include <geomtools/box.h>
+#include <geomtools/quadrangle.h>
 
 namespace geomtools {
 
@@ -794,6 +795,21 @@ namespace geomtools {
     return _computed_faces_.get();
   }
 
+  void i_shape_3d::build_computed_data() const
+  {
+    get_bounding_data();
+    const face_info_collection_type & faces = get_computed_faces();
+    for (const face_info & finfo : faces) {
+      if (! finfo.has_face()) continue;
+      // Quadrangular faces split themselves in triangles at first use:
+      const quadrangle * q = dynamic_cast<const quadrangle *>(&finfo.get_face_ref());
+      if (q != nullptr && q->is_valid()) {
+        q->get_triangle(quadrangle::IT_FIRST);
+      }
+    }
+    return;
+  }
+
   void i_shape_3d::reset_computed_faces()
   {
     _computed_faces_.reset();
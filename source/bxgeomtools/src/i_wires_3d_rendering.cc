@@ -3,13 +3,19 @@
 // Ourselves:
 #include <geomtools/i_wires_3d_rendering.h>
 
-// This project:
-#include <geomtools/box.h>
+// Standard library:
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 // Third party:
 // - Boost:
 #include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
 
 // This project:
+#include <geomtools/box.h>
 #include <geomtools/i_shape_3d.h>
 #include <geomtools/gnuplot_draw.h>
 #include <geomtools/placement.h>
@@ -180,6 +186,112 @@ namespace geomtools {
     return;
   }
 
+  compact_wires::compact_wires()
+  {
+    clear();
+    return;
+  }
+
+  compact_wires::compact_wires(const wires_type & wires_)
+  {
+    clear();
+    add(wires_);
+    return;
+  }
+
+  bool compact_wires::empty() const
+  {
+    return _wire_offsets_.empty();
+  }
+
+  std::size_t compact_wires::get_number_of_wires() const
+  {
+    return _wire_offsets_.size();
+  }
+
+  std::size_t compact_wires::get_number_of_points() const
+  {
+    return _coordinates_.size() / 3;
+  }
+
+  std::size_t compact_wires::get_number_of_points(std::size_t wire_) const
+  {
+    DT_THROW_IF(wire_ >= _wire_offsets_.size(), std::range_error,
+                "Invalid polyline index [" << wire_ << "] !");
+    const std::size_t last = (wire_ + 1 < _wire_offsets_.size()) ?
+      _wire_offsets_[wire_ + 1] : get_number_of_points();
+    return last - _wire_offsets_[wire_];
+  }
+
+  const double * compact_wires::get_point(std::size_t wire_, std::size_t index_) const
+  {
+    DT_THROW_IF(index_ >= get_number_of_points(wire_), std::range_error,
+                "Invalid point index [" << index_ << "] in polyline [" << wire_ << "] !");
+    return &_coordinates_[3 * (_wire_offsets_[wire_] + index_)];
+  }
+
+  double compact_wires::get_extent() const
+  {
+    double extent = 0.0;
+    if (! _coordinates_.empty()) {
+      for (int i = 0; i < 3; i++) {
+        extent = std::max(extent, _max_[i] - _min_[i]);
+      }
+    }
+    return extent;
+  }
+
+  void compact_wires::add(const polyline_type & wire_)
+  {
+    _wire_offsets_.push_back(get_number_of_points());
+    _coordinates_.reserve(_coordinates_.size() + 3 * wire_.size());
+    for (polyline_type::const_iterator i = wire_.begin();
+         i != wire_.end();
+         i++) {
+      const double xyz[3] = { i->x(), i->y(), i->z() };
+      for (int j = 0; j < 3; j++) {
+        _coordinates_.push_back(xyz[j]);
+        _min_[j] = std::min(_min_[j], xyz[j]);
+        _max_[j] = std::max(_max_[j], xyz[j]);
+      }
+    }
+    return;
+  }
+
+  void compact_wires::add(const wires_type & wires_)
+  {
+    for (wires_type::const_iterator i = wires_.begin();
+         i != wires_.end();
+         i++) {
+      add(*i);
+    }
+    return;
+  }
+
+  void compact_wires::to_wires(wires_type & wires_) const
+  {
+    for (std::size_t iwire = 0; iwire < get_number_of_wires(); iwire++) {
+      wires_.push_back(polyline_type());
+      polyline_type & wire = wires_.back();
+      for (std::size_t ipoint = 0; ipoint < get_number_of_points(iwire); ipoint++) {
+        const double * xyz = get_point(iwire, ipoint);
+        wire.push_back(vector_3d(xyz[0], xyz[1], xyz[2]));
+      }
+    }
+    return;
+  }
+
+  void compact_wires::clear()
+  {
+    _coordinates_.clear();
+    _wire_offsets_.clear();
+    for (int i = 0; i < 3; i++) {
+      _min_[i] = std::numeric_limits<double>::infinity();
+      _max_[i] = -std::numeric_limits<double>::infinity();
+    }
+    return;
+  }
+
   bool parse_wires(std::istream & in_, wires_type & wires_)
   {
     datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
@@ -32,6 +32,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <mutex>
 
 // Third party:
 // - Bayeux/datatools:
@@ -48,6 +49,7 @@
 #include <geomtools/material.h>
 #include <geomtools/mapping.h>
 #include <geomtools/mapping_plugin.h>
+#include <geomtools/batch_locator.h>
 
 namespace geomtools {
 
@@ -470,6 +472,32 @@ namespace geomtools {
     return _mapping_;
   }
 
+  void manager::locate(const std::vector<vector_3d> & positions_,
+                       const std::string & category_,
+                       std::vector<geom_id> & gids_,
+                       double tolerance_,
+                       unsigned int nthreads_) const
+  {
+    DT_THROW_IF(! _id_manager_.has_category_info(category_),
+                std::logic_error,
+                "No geometry category named '" << category_ << "' !");
+    const uint32_t type = _id_manager_.get_category_info(category_).get_type();
+    boost::shared_ptr<batch_locator> locator;
+    {
+      std::lock_guard<std::mutex> lock(_batch_locators_mutex_);
+      const std::pair<uint32_t, double> key(type, tolerance_);
+      batch_locator_dict_type::const_iterator found = _batch_locators_.find(key);
+      if (found == _batch_locators_.end()) {
+        locator.reset(new batch_locator(_mapping_, type, tolerance_));
+        _batch_locators_[key] = locator;
+      } else {
+        locator = found->second;
+      }
+    }
+    locator->locate(positions_, gids_, nthreads_);
+    return;
+  }
+
   void manager::set_mapping_requested (bool a_)
   {
     _mapping_requested_ = a_;
@@ -563,6 +591,10 @@ namespace geomtools {
     DT_THROW_IF (! _initialized_,
                  std::logic_error,
                  "Geometry manager is not initialized ! Cannot reset !");
+    {
+      std::lock_guard<std::mutex> lock(_batch_locators_mutex_);
+      _batch_locators_.clear();
+    }
     _factory_.reset();
     _shape_factory_.reset();
     _id_manager_.reset();
@@ -938,6 +970,8 @@ namespace geomtools {
       DT_LOG_NOTICE(_logging, "Building general mapping... please wait...");
       _mapping_.build_from(_factory_, _world_name_);
       DT_LOG_NOTICE(_logging, "General mapping has been built.");
+      std::lock_guard<std::mutex> lock(_batch_locators_mutex_);
+      _batch_locators_.clear();
     }
     return;
   }
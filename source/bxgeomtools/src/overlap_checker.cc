@@ -0,0 +1,604 @@
+/// \file geomtools/overlap_checker.cc
+
+// Ourselves:
+#include <geomtools/overlap_checker.h>
+
+// Standard library:
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+
+// This project:
+#include <geomtools/logical_volume.h>
+#include <geomtools/physical_volume.h>
+#include <geomtools/placement.h>
+#include <geomtools/i_shape_3d.h>
+#include <geomtools/i_wires_3d_rendering.h>
+
+namespace geomtools {
+
+  namespace {
+
+    /// Axis-aligned bounding box in the frame of a mother volume
+    struct aabb_type
+    {
+      aabb_type()
+        : lo(std::numeric_limits<double>::infinity(),
+             std::numeric_limits<double>::infinity(),
+             std::numeric_limits<double>::infinity()),
+          hi(-std::numeric_limits<double>::infinity(),
+             -std::numeric_limits<double>::infinity(),
+             -std::numeric_limits<double>::infinity())
+      {
+        return;
+      }
+
+      void add(const vector_3d & v_)
+      {
+        lo.setX(std::min(lo.x(), v_.x()));
+        lo.setY(std::min(lo.y(), v_.y()));
+        lo.setZ(std::min(lo.z(), v_.z()));
+        hi.setX(std::max(hi.x(), v_.x()));
+        hi.setY(std::max(hi.y(), v_.y()));
+        hi.setZ(std::max(hi.z(), v_.z()));
+        return;
+      }
+
+      void inflate(double skin_)
+      {
+        lo -= vector_3d(skin_, skin_, skin_);
+        hi += vector_3d(skin_, skin_, skin_);
+        return;
+      }
+
+      bool contains(const vector_3d & v_) const
+      {
+        return v_.x() >= lo.x() && v_.x() <= hi.x()
+          && v_.y() >= lo.y() && v_.y() <= hi.y()
+          && v_.z() >= lo.z() && v_.z() <= hi.z();
+      }
+
+      bool intersects_yz(const aabb_type & other_) const
+      {
+        return lo.y() <= other_.hi.y() && other_.lo.y() <= hi.y()
+          && lo.z() <= other_.hi.z() && other_.lo.z() <= hi.z();
+      }
+
+      vector_3d lo; //!< Lower corner
+      vector_3d hi; //!< Upper corner
+    };
+
+    /// A placement item of a daughter physical volume
+    struct daughter_item
+    {
+      std::string        name;    //!< Name of the physical volume
+      int                copy;    //!< Index of the placement item
+      const i_shape_3d * shape;   //!< Shape of the daughter logical volume
+      placement          plcmt;   //!< Placement of the item in the mother frame
+      aabb_type          box;     //!< Bounding box in the mother frame
+      std::size_t        surface; //!< Index of the sampled surface of the shape
+    };
+
+    /// The daughter items of a mother logical volume
+    struct frame_type
+    {
+      const logical_volume * mother;
+      std::vector<daughter_item> items;
+    };
+
+    /// A narrow phase check
+    struct task_type
+    {
+      static const std::size_t MOTHER = std::numeric_limits<std::size_t>::max();
+      std::size_t frame;  //!< Index of the frame
+      std::size_t first;  //!< Index of the first item
+      std::size_t second; //!< Index of the second item (MOTHER for a mother/daughter check)
+    };
+
+    const std::size_t task_type::MOTHER;
+
+    uint32_t wires_options_from_sampling(uint32_t sampling_)
+    {
+      switch (sampling_) {
+      case overlapping::FLAG_WIRES_HUGE_SAMPLING:
+        return i_wires_3d_rendering::WR_BASE_GRID_HUGE_DENSITY
+          | i_wires_3d_rendering::WR_BASE_HUGE_ANGLE_SAMPLING;
+      case overlapping::FLAG_WIRES_VERY_HIGH_SAMPLING:
+        return i_wires_3d_rendering::WR_BASE_GRID_VERY_HIGH_DENSITY
+          | i_wires_3d_rendering::WR_BASE_VERY_HIGH_ANGLE_SAMPLING;
+      case overlapping::FLAG_WIRES_HIGH_SAMPLING:
+        return i_wires_3d_rendering::WR_BASE_GRID_HIGH_DENSITY
+          | i_wires_3d_rendering::WR_BASE_HIGH_ANGLE_SAMPLING;
+      case overlapping::FLAG_WIRES_LOW_SAMPLING:
+        return i_wires_3d_rendering::WR_BASE_GRID_LOW_DENSITY
+          | i_wires_3d_rendering::WR_BASE_LOW_ANGLE_SAMPLING;
+      default:
+        break;
+      }
+      return i_wires_3d_rendering::WR_BASE_GRID;
+    }
+
+    /// Run independent jobs on a pool of threads, the first error is rethrown
+    template <typename Job>
+    void run_parallel(std::size_t njobs_, unsigned int nthreads_, Job job_)
+    {
+      if (nthreads_ > njobs_) nthreads_ = (unsigned int) njobs_;
+      if (nthreads_ <= 1) {
+        for (std::size_t i = 0; i < njobs_; i++) {
+          job_(i);
+        }
+        return;
+      }
+      std::atomic<std::size_t> next(0);
+      std::mutex error_mutex;
+      std::exception_ptr error;
+      auto worker = [&]() {
+        while (true) {
+          const std::size_t i = next++;
+          if (i >= njobs_) break;
+          try {
+            job_(i);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            next = njobs_;
+          }
+        }
+      };
+      std::vector<std::thread> threads;
+      for (unsigned int ithread = 1; ithread < nthreads_; ithread++) {
+        threads.push_back(std::thread(worker));
+      }
+      worker();
+      for (std::thread & t : threads) {
+        t.join();
+      }
+      if (error) std::rethrow_exception(error);
+      return;
+    }
+
+    /// Collect the daughter items of all logical volumes (depth-first)
+    void collect_frames(const logical_volume & log_,
+                        std::set<const logical_volume *> & visited_,
+                        std::vector<frame_type> & frames_)
+    {
+      if (!visited_.insert(&log_).second) return;
+      const logical_volume::physicals_col_type & physicals = log_.get_physicals();
+      frame_type frame;
+      frame.mother = &log_;
+      for (const auto & iphys : physicals) {
+        const physical_volume & phys = *iphys.second;
+        if (!phys.has_logical() || !phys.has_placement()) continue;
+        if (!phys.get_logical().has_shape()) continue;
+        const i_placement & plcmt = phys.get_placement();
+        for (std::size_t i = 0; i < plcmt.get_number_of_items(); i++) {
+          daughter_item item;
+          item.name = iphys.first;
+          item.copy = (int) i;
+          item.shape = &phys.get_logical().get_shape();
+          plcmt.compute_placement((int) i, item.plcmt);
+          item.surface = 0;
+          frame.items.push_back(item);
+        }
+      }
+      if (!frame.items.empty()) {
+        frames_.push_back(frame);
+      }
+      for (const auto & iphys : physicals) {
+        const physical_volume & phys = *iphys.second;
+        if (!phys.has_logical()) continue;
+        collect_frames(phys.get_logical(), visited_, frames_);
+      }
+      return;
+    }
+
+    /// Sweep-and-prune along X: pairs of items with intersecting bounding boxes
+    void sweep_and_prune(const std::vector<daughter_item> & items_,
+                         std::vector<std::pair<std::size_t, std::size_t> > & pairs_)
+    {
+      std::vector<std::size_t> order(items_.size());
+      for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+      }
+      std::sort(order.begin(), order.end(),
+                [&items_](std::size_t a_, std::size_t b_) {
+                  const double xa = items_[a_].box.lo.x();
+                  const double xb = items_[b_].box.lo.x();
+                  return xa < xb || (xa == xb && a_ < b_);
+                });
+      std::vector<std::size_t> active;
+      for (std::size_t index : order) {
+        const aabb_type & box = items_[index].box;
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&items_, &box](std::size_t j_) {
+                                      return items_[j_].box.hi.x() < box.lo.x();
+                                    }),
+                     active.end());
+        for (std::size_t j : active) {
+          if (box.intersects_yz(items_[j].box)) {
+            pairs_.push_back(std::make_pair(std::min(index, j), std::max(index, j)));
+          }
+        }
+        active.push_back(index);
+      }
+      std::sort(pairs_.begin(), pairs_.end());
+      return;
+    }
+
+    /// Test the surface vertexes of a source item against the volume of a target item
+    bool check_surface_inside(const std::string & mother_,
+                              const daughter_item & target_,
+                              const daughter_item & source_,
+                              const std::vector<vector_3d> & source_surface_,
+                              bool overlap_all_,
+                              std::vector<overlap_checker::overlap_record> & records_)
+    {
+      bool found = false;
+      for (const vector_3d & vtx : source_surface_) {
+        vector_3d vtx_in_mother;
+        source_.plcmt.child_to_mother(vtx, vtx_in_mother);
+        if (!target_.box.contains(vtx_in_mother)) continue;
+        vector_3d vtx_in_target;
+        target_.plcmt.mother_to_child(vtx_in_mother, vtx_in_target);
+        if (target_.shape->check_inside(vtx_in_target, 0.0)) {
+          overlap_checker::overlap_record record;
+          record.mother = mother_;
+          record.info.type = overlapping::OVERLAP_SIMPLE;
+          record.info.name_first = target_.name;
+          record.info.item_first = target_.copy;
+          record.info.name_second = source_.name;
+          record.info.item_second = source_.copy;
+          record.info.vertex = vtx_in_mother;
+          records_.push_back(record);
+          found = true;
+          if (!overlap_all_) break;
+        }
+      }
+      return found;
+    }
+
+  } // end of anonymous namespace
+
+  // Report:
+
+  overlap_checker::report::report()
+  {
+    reset();
+    return;
+  }
+
+  void overlap_checker::report::reset()
+  {
+    top.clear();
+    number_of_logicals = 0;
+    number_of_items = 0;
+    number_of_pairs = 0;
+    number_of_candidates = 0;
+    overlaps.clear();
+    return;
+  }
+
+  bool overlap_checker::report::has_overlaps() const
+  {
+    return !overlaps.empty();
+  }
+
+  void overlap_checker::report::tree_dump(std::ostream & out_,
+                                          const std::string & title_,
+                                          const std::string & indent_,
+                                          bool inherit_) const
+  {
+    if (!title_.empty()) {
+      out_ << indent_ << title_ << std::endl;
+    }
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Top logical volume : '" << top << "'" << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Logical volumes with daughters : " << number_of_logicals << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Daughter items : " << number_of_items << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Pairs of sibling items : " << number_of_pairs << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Candidate pairs (intersecting bounding boxes) : " << number_of_candidates << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::inherit_tag(inherit_)
+         << "Overlaps : " << overlaps.size() << std::endl;
+    for (std::size_t i = 0; i < overlaps.size(); i++) {
+      const overlap_record & record = overlaps[i];
+      out_ << indent_ << i_tree_dumpable::inherit_skip_tag(inherit_);
+      if (i + 1 == overlaps.size()) {
+        out_ << i_tree_dumpable::last_tag;
+      } else {
+        out_ << i_tree_dumpable::tag;
+      }
+      out_ << "In '" << record.mother << "' : ";
+      if (record.info.type == overlapping::OVERLAP_MOTHER_DAUGHTER) {
+        out_ << "'" << record.info.name_second << "'[#" << record.info.item_second << "]"
+             << " overflows its mother volume";
+      } else {
+        out_ << "'" << record.info.name_second << "'[#" << record.info.item_second << "]"
+             << " enters '" << record.info.name_first << "'[#" << record.info.item_first << "]";
+      }
+      out_ << " at (" << record.info.vertex.x() / CLHEP::mm
+           << ", " << record.info.vertex.y() / CLHEP::mm
+           << ", " << record.info.vertex.z() / CLHEP::mm << ") mm" << std::endl;
+    }
+
+    return;
+  }
+
+  // Checker:
+
+  overlap_checker::overlap_checker()
+  {
+    _logging_ = datatools::logger::PRIO_FATAL;
+    _sampling_ = overlapping::FLAG_NONE;
+    _number_of_threads_ = 0;
+    _overlap_all_ = false;
+    _check_mother_daughter_ = true;
+    return;
+  }
+
+  overlap_checker::~overlap_checker()
+  {
+    return;
+  }
+
+  void overlap_checker::set_logging(datatools::logger::priority lp_)
+  {
+    _logging_ = lp_;
+    return;
+  }
+
+  datatools::logger::priority overlap_checker::get_logging() const
+  {
+    return _logging_;
+  }
+
+  void overlap_checker::set_sampling(uint32_t sampling_flag_)
+  {
+    DT_THROW_IF(sampling_flag_ != overlapping::FLAG_NONE
+                && sampling_flag_ != overlapping::FLAG_WIRES_LOW_SAMPLING
+                && sampling_flag_ != overlapping::FLAG_WIRES_HIGH_SAMPLING
+                && sampling_flag_ != overlapping::FLAG_WIRES_VERY_HIGH_SAMPLING
+                && sampling_flag_ != overlapping::FLAG_WIRES_HUGE_SAMPLING,
+                std::logic_error,
+                "Invalid sampling flag [" << sampling_flag_ << "]!");
+    _sampling_ = sampling_flag_;
+    return;
+  }
+
+  void overlap_checker::set_sampling(const std::string & label_)
+  {
+    if (label_ == "normal" || label_ == "normal_sampling") {
+      set_sampling(overlapping::FLAG_NONE);
+      return;
+    }
+    std::string label = label_;
+    if (label.find("_sampling") == std::string::npos) {
+      label += "_sampling";
+    }
+    const uint32_t flag = overlapping::get_flag_from_label(label);
+    DT_THROW_IF(flag == overlapping::FLAG_NONE, std::logic_error,
+                "Invalid sampling label '" << label_ << "'!");
+    set_sampling(flag);
+    return;
+  }
+
+  uint32_t overlap_checker::get_sampling() const
+  {
+    return _sampling_;
+  }
+
+  std::string overlap_checker::get_sampling_label() const
+  {
+    switch (_sampling_) {
+    case overlapping::FLAG_WIRES_LOW_SAMPLING: return "low";
+    case overlapping::FLAG_WIRES_HIGH_SAMPLING: return "high";
+    case overlapping::FLAG_WIRES_VERY_HIGH_SAMPLING: return "very_high";
+    case overlapping::FLAG_WIRES_HUGE_SAMPLING: return "huge";
+    default: break;
+    }
+    return "normal";
+  }
+
+  void overlap_checker::set_number_of_threads(unsigned int nthreads_)
+  {
+    _number_of_threads_ = nthreads_;
+    return;
+  }
+
+  unsigned int overlap_checker::get_number_of_threads() const
+  {
+    return _number_of_threads_;
+  }
+
+  void overlap_checker::set_overlap_all(bool oa_)
+  {
+    _overlap_all_ = oa_;
+    return;
+  }
+
+  bool overlap_checker::is_overlap_all() const
+  {
+    return _overlap_all_;
+  }
+
+  void overlap_checker::set_check_mother_daughter(bool cmd_)
+  {
+    _check_mother_daughter_ = cmd_;
+    return;
+  }
+
+  bool overlap_checker::is_check_mother_daughter() const
+  {
+    return _check_mother_daughter_;
+  }
+
+  bool overlap_checker::check(const logical_volume & top_, report & report_) const
+  {
+    report_.reset();
+    report_.top = top_.get_name();
+    unsigned int nthreads = _number_of_threads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // Expand the daughter items of all logical volumes:
+    std::vector<frame_type> frames;
+    {
+      std::set<const logical_volume *> visited;
+      collect_frames(top_, visited, frames);
+    }
+
+    // Sample the surface of each distinct shape once:
+    std::vector<const i_shape_3d *> shapes;
+    {
+      std::map<const i_shape_3d *, std::size_t> shape_indexes;
+      for (frame_type & frame : frames) {
+        for (daughter_item & item : frame.items) {
+          auto found = shape_indexes.find(item.shape);
+          if (found == shape_indexes.end()) {
+            found = shape_indexes.insert(std::make_pair(item.shape, shapes.size())).first;
+            shapes.push_back(item.shape);
+          }
+          item.surface = found->second;
+        }
+      }
+    }
+    // Data built at first use by the shapes must exist before the threads query them:
+    {
+      std::set<const i_shape_3d *> prepared;
+      for (const frame_type & frame : frames) {
+        if (frame.mother->has_shape() && prepared.insert(&frame.mother->get_shape()).second) {
+          frame.mother->get_shape().build_computed_data();
+        }
+      }
+      for (const i_shape_3d * shape : shapes) {
+        if (prepared.insert(shape).second) {
+          shape->build_computed_data();
+        }
+      }
+    }
+    const uint32_t wires_options = wires_options_from_sampling(_sampling_);
+    std::vector<std::vector<vector_3d> > surfaces(shapes.size());
+    run_parallel(shapes.size(), nthreads,
+                 [&](std::size_t ishape_) {
+                   wires_type wires;
+                   shapes[ishape_]->generate_wires_self(wires, wires_options);
+                   std::set<vector_3d> vertice;
+                   overlapping::make_vertice_unique(wires, vertice);
+                   surfaces[ishape_].assign(vertice.begin(), vertice.end());
+                 });
+    DT_LOG_DEBUG(_logging_, "Sampled " << shapes.size() << " distinct shapes.");
+
+    // Broad phase:
+    std::vector<task_type> tasks;
+    for (std::size_t iframe = 0; iframe < frames.size(); iframe++) {
+      frame_type & frame = frames[iframe];
+      for (daughter_item & item : frame.items) {
+        const i_shape_3d & shape = *item.shape;
+        if (shape.has_bounding_data()) {
+          std::vector<vector_3d> corners;
+          shape.get_bounding_data().compute_bounding_box_vertexes(corners);
+          for (const vector_3d & corner : corners) {
+            item.box.add(item.plcmt.child_to_mother(corner));
+          }
+        } else {
+          for (const vector_3d & vtx : surfaces[item.surface]) {
+            item.box.add(item.plcmt.child_to_mother(vtx));
+          }
+        }
+        item.box.inflate(shape.get_tolerance());
+      }
+      const std::size_t nitems = frame.items.size();
+      report_.number_of_logicals++;
+      report_.number_of_items += nitems;
+      report_.number_of_pairs += nitems * (nitems - 1) / 2;
+      task_type task;
+      task.frame = iframe;
+      if (_check_mother_daughter_ && frame.mother->has_shape()) {
+        for (std::size_t i = 0; i < nitems; i++) {
+          task.first = i;
+          task.second = task_type::MOTHER;
+          tasks.push_back(task);
+        }
+      }
+      std::vector<std::pair<std::size_t, std::size_t> > pairs;
+      sweep_and_prune(frame.items, pairs);
+      report_.number_of_candidates += pairs.size();
+      for (const auto & pair : pairs) {
+        task.first = pair.first;
+        task.second = pair.second;
+        tasks.push_back(task);
+      }
+    }
+    DT_LOG_DEBUG(_logging_, "Broad phase: " << report_.number_of_candidates
+                 << " candidate pairs out of " << report_.number_of_pairs << ".");
+
+    // Narrow phase:
+    std::vector<std::vector<overlap_record> > results(tasks.size());
+    const bool overlap_all = _overlap_all_;
+    run_parallel(tasks.size(), nthreads,
+                 [&](std::size_t itask_) {
+                   const task_type & task = tasks[itask_];
+                   const frame_type & frame = frames[task.frame];
+                   const std::string & mother_name = frame.mother->get_name();
+                   std::vector<overlap_record> & records = results[itask_];
+                   const daughter_item & first = frame.items[task.first];
+                   if (task.second == task_type::MOTHER) {
+                     const i_shape_3d & mother_shape = frame.mother->get_shape();
+                     for (const vector_3d & vtx : surfaces[first.surface]) {
+                       vector_3d vtx_in_mother;
+                       first.plcmt.child_to_mother(vtx, vtx_in_mother);
+                       if (mother_shape.check_outside(vtx_in_mother, 0.0)) {
+                         overlap_record record;
+                         record.mother = mother_name;
+                         record.info.type = overlapping::OVERLAP_MOTHER_DAUGHTER;
+                         record.info.name_first = mother_name;
+                         record.info.item_first = -1;
+                         record.info.name_second = first.name;
+                         record.info.item_second = first.copy;
+                         record.info.vertex = vtx_in_mother;
+                         records.push_back(record);
+                         if (!overlap_all) break;
+                       }
+                     }
+                     return;
+                   }
+                   const daughter_item & second = frame.items[task.second];
+                   bool found = check_surface_inside(mother_name, first, second,
+                                                     surfaces[second.surface],
+                                                     overlap_all, records);
+                   if (!found || overlap_all) {
+                     check_surface_inside(mother_name, second, first,
+                                          surfaces[first.surface],
+                                          overlap_all, records);
+                   }
+                 });
+
+    for (const std::vector<overlap_record> & records : results) {
+      report_.overlaps.insert(report_.overlaps.end(), records.begin(), records.end());
+    }
+    DT_LOG_DEBUG(_logging_, "Found " << report_.overlaps.size() << " overlaps.");
+    return report_.has_overlaps();
+  }
+
+} // end of namespace geomtools
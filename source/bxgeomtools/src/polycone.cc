@@ -105,6 +105,7 @@ namespace geomtools {
     datatools::invalidate(_z_max_);
     datatools::invalidate(_r_max_);
     _extruded_ = false;
+    _sections_.clear();
     datatools::invalidate(_start_angle_);
     datatools::invalidate(_delta_angle_);
     return;
@@ -1414,10 +1415,19 @@ namespace geomtools {
     _compute_surfaces_();
     _compute_volume_();
     _compute_limits_();
+    _compute_sections_();
     _computed_ = true;
     return;
   }
 
+  void polycone::_compute_sections_()
+  {
+    _sections_.clear();
+    if (! is_valid()) return;
+    _sections_.build(_points_);
+    return;
+  }
+
   void polycone::add (double z_, double rmax_, bool compute_)
   {
     DT_THROW_IF (rmax_ < 0.0, std::domain_error, "Invalid negative 'rmax' !");
@@ -1738,68 +1748,40 @@ namespace geomtools {
   bool polycone::is_outside(const vector_3d & point_, double skin_) const
   {
     DT_THROW_IF(! is_valid(), std::logic_error, "Invalid polycone!");
-    unsigned int noutside = 0;
+    DT_THROW_IF(_sections_.is_empty(), std::logic_error, "Polycone sections are not computed!");
     double skin = get_skin(skin_);
-    // Scan the conical frustra:
-    for (unsigned int i = 0; i < number_of_frustra(); i++) {
-      right_circular_conical_frustrum rccf;
-      placement rccf_placement;
-      compute_frustrum(rccf, rccf_placement, i);
-      vector_3d pos_c;
-      rccf_placement.mother_to_child(point_, pos_c);
-      if (rccf.is_outside(pos_c, skin)) {
-        noutside++;
+    double hskin = 0.5 * skin;
+    const double r = _sections_.radial_coordinate(point_.x(), point_.y());
+    if (_sections_.is_outside(point_.z(), r, hskin)) {
+      return true;
+    }
+    if (has_partial_angle()) {
+      double angle = std::atan2(point_.y(), point_.x());
+      if (!angle_is_in(angle, get_start_angle(), get_delta_angle(), get_angular_tolerance(), false)) {
+        return true;
       }
     }
-    return noutside == number_of_frustra();
+    return false;
   }
 
   bool polycone::is_inside (const vector_3d & point_, double skin_) const
   {
     DT_THROW_IF(! is_valid(), std::logic_error, "Invalid polycone!");
+    DT_THROW_IF(_sections_.is_empty(), std::logic_error, "Polycone sections are not computed!");
     double skin = get_skin(skin_);
     double hskin = 0.5 * skin;
-
-    const double z = point_.z();
-    // Exclude points outside the bounding cylinder:
-    if (z > get_z_max() - hskin) return false;
-    if (z < get_z_min() + hskin) return false;
-    const double r = hypot(point_.x(), point_.y());
-    if (r > get_r_max() - hskin) return false;
-
-    bool inside = false;
-    // Scan the conical frustra:
-    for (unsigned int i = 0; i < number_of_frustra(); i++) {
-      right_circular_conical_frustrum rccf;
-      placement rccf_placement;
-      compute_frustrum(rccf, rccf_placement, i);
-      vector_3d pos_c;
-      rccf_placement.mother_to_child(point_, pos_c);
-      if (rccf.is_inside(pos_c, 0.0)) {
-        // std::cerr << "DEVEL: polyhedra::is_inside: " << "in frustrum #" << i << std::endl;
-        face_identifier mask_id;
-        uint32_t face_bits = 0;
-        face_bits |= right_circular_conical_frustrum::FACE_OUTER_SIDE;
-        if (rccf.has_inner_face()) {
-          face_bits |= right_circular_conical_frustrum::FACE_INNER_SIDE;
-        }
-        if (i == 0 && rccf.has_top_face()) {
-          face_bits |= right_circular_conical_frustrum::FACE_TOP;
-        }
-        if (i == number_of_frustra() - 1 && rccf.has_bottom_face()) {
-          face_bits |= right_circular_conical_frustrum::FACE_BOTTOM;
-        }
-        mask_id.set_face_bits(face_bits);
-        face_identifier surf_id = rccf.on_surface(point_, mask_id, skin);
-        if (! surf_id.is_valid()) {
-          inside = true;
-        }
-        break;
+    // Only the section which contains the Z coordinate is tested:
+    const double r = _sections_.radial_coordinate(point_.x(), point_.y());
+    if (! _sections_.is_inside(point_.z(), r, hskin)) {
+      return false;
+    }
+    if (has_partial_angle()) {
+      double angle = std::atan2(point_.y(), point_.x());
+      if (!angle_is_in(angle, get_start_angle(), get_delta_angle(), get_angular_tolerance(), true)) {
+        return false;
       }
     }
-
-    // std::cerr << "DEVEL: polycone::is_inside: " << "inside=" << inside << std::endl;
-    return inside;
+    return true;
   }
 
   vector_3d polycone::get_normal_on_surface (const vector_3d & position_,
@@ -1896,6 +1878,17 @@ namespace geomtools {
     DT_THROW_IF(! is_valid(), std::logic_error, "Invalid polycone!");
     double skin = get_skin(skin_);
 
+    // Fast rejection of the points far from any face:
+    if (! _sections_.is_empty()) {
+      const double r = _sections_.radial_coordinate(position_.x(), position_.y());
+      if (_sections_.is_outside(position_.z(), r, skin)) {
+        return face_identifier::face_invalid();
+      }
+      if (! has_partial_angle() && _sections_.is_inside(position_.z(), r, skin)) {
+        return face_identifier::face_invalid();
+      }
+    }
+
     face_identifier mask;
     if (surface_mask_.is_valid()) {
       DT_THROW_IF(! surface_mask_.is_face_bits_mode(), std::logic_error,
@@ -1932,6 +1925,15 @@ namespace geomtools {
 
     double skin = compute_tolerance(skin_);
 
+    // Fast rejection of the rays which miss the bounding box:
+    if (! _sections_.is_empty()) {
+      const double from[3] = {from_.x(), from_.y(), from_.z()};
+      const double direction[3] = {direction_.x(), direction_.y(), direction_.z()};
+      if (! _sections_.may_intercept(from, direction, skin)) {
+        return false;
+      }
+    }
+
     const unsigned int NFACES = 6;
     face_intercept_info intercepts[NFACES];
     unsigned int candidate_impact_counter = 0;
@@ -64,6 +64,7 @@ namespace geomtools {
     datatools::invalidate(_r_max_);
     datatools::invalidate(_xy_max_);
     _extruded_ = false;
+    _sections_.clear();
     return;
   }
 
@@ -768,10 +769,19 @@ namespace geomtools {
     _compute_surfaces_();
     _compute_volume_();
     _compute_limits_();
+    _compute_sections_();
     _computed_ = true;
     return;
   }
 
+  void polyhedra::_compute_sections_()
+  {
+    _sections_.clear();
+    if (! is_valid()) return;
+    _sections_.build(_points_, _n_sides_);
+    return;
+  }
+
   void polyhedra::add(double z_, double rmax_, bool compute_)
   {
     DT_THROW_IF(rmax_ < 0.0, std::domain_error, "Invalid negative 'rmax' !");
@@ -1352,67 +1362,22 @@ namespace geomtools {
   bool polyhedra::is_outside(const vector_3d & point_, double skin_) const
   {
     DT_THROW_IF(! is_valid(), std::logic_error, "Invalid polyhedra!");
-    unsigned int noutside = 0;
-    double skin =  get_skin(skin_);
-    // Scan the conical frustra:
-    for (unsigned int i = 0; i < number_of_frustra(); i++) {
-      right_polygonal_frustrum rpf;
-      placement rpf_placement;
-      compute_frustrum(rpf, rpf_placement, i);
-      vector_3d pos_c;
-      rpf_placement.mother_to_child(point_, pos_c);
-      if (rpf.is_outside(pos_c, skin)) {
-        noutside++;
-      }
-    }
-    return noutside == number_of_frustra();
+    DT_THROW_IF(_sections_.is_empty(), std::logic_error, "Polyhedra sections are not computed!");
+    double skin = get_skin(skin_);
+    double hskin = 0.5 * skin;
+    const double r = _sections_.radial_coordinate(point_.x(), point_.y());
+    return _sections_.is_outside(point_.z(), r, hskin);
   }
 
   bool polyhedra::is_inside (const vector_3d & point_, double skin_) const
   {
     DT_THROW_IF (! is_valid (), std::logic_error, "Polyhedra is not valid !");
+    DT_THROW_IF(_sections_.is_empty(), std::logic_error, "Polyhedra sections are not computed!");
     double skin = get_skin(skin_);
     double hskin = 0.5 * skin;
-
-    double z = point_.z();
-    // Exclude points outside the bounding cylinder:
-    if (z > get_z_max() - hskin) return false;
-    if (z < get_z_min() + hskin) return false;
-    const double r = hypot(point_.x(), point_.y());
-    if (r > get_r_max() - hskin) return false;
-
-    bool inside = false;
-    // Scan the conical frustra:
-    for (unsigned int i = 0; i < number_of_frustra(); i++) {
-      right_polygonal_frustrum rpf;
-      placement rpf_placement;
-      compute_frustrum(rpf, rpf_placement, i);
-      vector_3d pos_c;
-      rpf_placement.mother_to_child(point_, pos_c);
-      if (rpf.is_inside(pos_c, 0.0)) {
-        // std::cerr << "DEVEL: polyhedra::is_inside: " << "in frustrum #" << i << std::endl;
-        face_identifier mask_id;
-        uint32_t face_bits = 0;
-        face_bits |= right_polygonal_frustrum::FACE_OUTER_SIDE;
-        if (rpf.has_inner_face()) {
-          face_bits |= right_polygonal_frustrum::FACE_INNER_SIDE;
-        }
-        if (i == 0 && rpf.has_top_face()) {
-          face_bits |= right_polygonal_frustrum::FACE_TOP;
-        }
-        if (i == number_of_frustra() - 1 && rpf.has_bottom_face()) {
-          face_bits |= right_polygonal_frustrum::FACE_BOTTOM;
-        }
-        mask_id.set_face_bits(face_bits);
-        face_identifier surf_id = rpf.on_surface(point_, mask_id, skin);
-        if (! surf_id.is_valid()) {
-          inside = true;
-        }
-        break;
-      }
-    }
-
-    return inside;
+    // Only the section which contains the Z coordinate is tested:
+    const double r = _sections_.radial_coordinate(point_.x(), point_.y());
+    return _sections_.is_inside(point_.z(), r, hskin);
   }
 
   vector_3d polyhedra::get_normal_on_surface (const vector_3d & position_,
@@ -1475,6 +1440,15 @@ namespace geomtools {
     DT_THROW_IF(! is_valid(), std::logic_error, "Invalid polyhedra!");
     double skin = get_skin(skin_);
 
+    // Fast rejection of the points far from any face:
+    if (! _sections_.is_empty()) {
+      const double r = _sections_.radial_coordinate(position_.x(), position_.y());
+      if (_sections_.is_outside(position_.z(), r, skin)
+          || _sections_.is_inside(position_.z(), r, skin)) {
+        return face_identifier::face_invalid();
+      }
+    }
+
     face_identifier mask;
     if (surface_mask_.is_valid()) {
       DT_THROW_IF(! surface_mask_.is_face_bits_mode(), std::logic_error,
@@ -1516,6 +1490,15 @@ namespace geomtools {
 
     double skin = compute_tolerance(skin_);
 
+    // Fast rejection of the rays which miss the bounding box:
+    if (! _sections_.is_empty()) {
+      const double from[3] = {from_.x(), from_.y(), from_.z()};
+      const double direction[3] = {direction_.x(), direction_.y(), direction_.z()};
+      if (! _sections_.may_intercept(from, direction, skin)) {
+        return false;
+      }
+    }
+
     const unsigned int NFACES = 4;
     face_intercept_info intercepts[NFACES];
     unsigned int candidate_impact_counter = 0;
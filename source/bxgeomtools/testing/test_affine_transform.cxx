@@ -0,0 +1,139 @@
+// test_affine_transform.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/time_tools.h>
+
+// This project:
+#include <geomtools/affine_transform.h>
+#include <geomtools/placement.h>
+#include <geomtools/utils.h>
+
+namespace {
+
+  // Compare the transform of positions and directions with the ones of the placement:
+  void check_transform(const std::string & label_,
+                       const geomtools::placement & p_,
+                       geomtools::affine_transform::kind_type expected_kind_,
+                       const std::vector<geomtools::vector_3d> & points_)
+  {
+    const geomtools::affine_transform t(p_);
+    t.tree_dump(std::clog, "Transform '" + label_ + "' : ");
+    DT_THROW_IF(t.get_kind() != expected_kind_, std::logic_error,
+                "Unexpected kind of transform for '" << label_ << "'!");
+    const double tolerance = 1.e-12 * CLHEP::mm;
+    for (const geomtools::vector_3d & pt : points_) {
+      DT_THROW_IF((t.mother_to_child(pt) - p_.mother_to_child(pt)).mag() > tolerance, std::logic_error,
+                  "Unmatching mother to child transform for '" << label_ << "'!");
+      DT_THROW_IF((t.child_to_mother(pt) - p_.child_to_mother(pt)).mag() > tolerance, std::logic_error,
+                  "Unmatching child to mother transform for '" << label_ << "'!");
+      geomtools::vector_3d dir;
+      t.mother_to_child_direction(pt, dir);
+      DT_THROW_IF((dir - p_.mother_to_child_direction(pt)).mag() > tolerance, std::logic_error,
+                  "Unmatching mother to child direction transform for '" << label_ << "'!");
+      t.child_to_mother_direction(pt, dir);
+      DT_THROW_IF((dir - p_.child_to_mother_direction(pt)).mag() > tolerance, std::logic_error,
+                  "Unmatching child to mother direction transform for '" << label_ << "'!");
+    }
+
+    // Batch transforms:
+    datatools::computing_time placement_ct;
+    std::vector<geomtools::vector_3d> placement_child(points_.size());
+    placement_ct.start();
+    for (std::size_t i = 0; i < points_.size(); i++) {
+      p_.mother_to_child(points_[i], placement_child[i]);
+    }
+    placement_ct.stop();
+    datatools::computing_time transform_ct;
+    std::vector<geomtools::vector_3d> child;
+    transform_ct.start();
+    t.mother_to_child(points_, child);
+    transform_ct.stop();
+    std::vector<geomtools::vector_3d> mother;
+    t.child_to_mother(child, mother);
+    for (std::size_t i = 0; i < points_.size(); i++) {
+      DT_THROW_IF((child[i] - placement_child[i]).mag() > tolerance, std::logic_error,
+                  "Unmatching batch mother to child transform for '" << label_ << "'!");
+      DT_THROW_IF((mother[i] - points_[i]).mag() > 1.e-9 * CLHEP::mm, std::logic_error,
+                  "Unmatching batch child to mother transform for '" << label_ << "'!");
+    }
+    // In place:
+    std::vector<geomtools::vector_3d> inplace = points_;
+    t.mother_to_child(inplace.data(), inplace.data(), inplace.size());
+    DT_THROW_IF(inplace != child, std::logic_error,
+                "Unmatching in place mother to child transform for '" << label_ << "'!");
+    std::clog << "Transform '" << label_ << "' : placement: "
+              << placement_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms, "
+              << "transform: " << transform_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms"
+              << std::endl;
+    return;
+  }
+
+}
+
+int main (int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'geomtools::affine_transform' !" << std::endl;
+
+    srand48(314159);
+    std::vector<geomtools::vector_3d> points(100000);
+    for (geomtools::vector_3d & pt : points) {
+      pt.set((-1.0 + 2.0 * drand48()) * CLHEP::m,
+             (-1.0 + 2.0 * drand48()) * CLHEP::m,
+             (-1.0 + 2.0 * drand48()) * CLHEP::m);
+    }
+
+    {
+      geomtools::affine_transform t;
+      DT_THROW_IF(!t.is_identity(), std::logic_error, "Default transform is not identity!");
+    }
+
+    check_transform("identity",
+                    geomtools::placement(0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+                    geomtools::affine_transform::KIND_IDENTITY, points);
+
+    check_transform("translation",
+                    geomtools::placement(1.0 * CLHEP::cm, -2.0 * CLHEP::cm, 3.0 * CLHEP::cm, 0.0, 0.0, 0.0),
+                    geomtools::affine_transform::KIND_TRANSLATION, points);
+
+    check_transform("x rotation",
+                    geomtools::placement(1.0 * CLHEP::cm, 0.0, 0.0, geomtools::ROTATION_AXIS_X, 30.0 * CLHEP::degree),
+                    geomtools::affine_transform::KIND_AXIS_ROTATION, points);
+
+    check_transform("y rotation",
+                    geomtools::placement(0.0, 1.0 * CLHEP::cm, 0.0, geomtools::ROTATION_AXIS_Y, 90.0 * CLHEP::degree),
+                    geomtools::affine_transform::KIND_AXIS_ROTATION, points);
+
+    check_transform("z rotation",
+                    geomtools::placement(0.0, 0.0, 1.0 * CLHEP::cm, geomtools::ROTATION_AXIS_Z, -45.0 * CLHEP::degree),
+                    geomtools::affine_transform::KIND_AXIS_ROTATION, points);
+
+    check_transform("general",
+                    geomtools::placement(1.0 * CLHEP::cm, 2.0 * CLHEP::cm, 3.0 * CLHEP::cm,
+                                         30.0 * CLHEP::degree, 45.0 * CLHEP::degree, 60.0 * CLHEP::degree),
+                    geomtools::affine_transform::KIND_GENERAL, points);
+
+    std::clog << "The end." << std::endl;
+  }
+  catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <string>
 #include <exception>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -35,6 +36,7 @@
 #include <datatools/properties.h>
 #include <datatools/utils.h>
 #include <datatools/exception.h>
+#include <datatools/clhep_units.h>
 // - Bayeux/mygsl:
 #include <mygsl/rng.h>
 
@@ -317,6 +319,57 @@ int main (int argc_, char ** argv_)
         }
       geo_mgr.tree_dump (std::clog, "The geometry manager : ");
 
+      if (geo_mgr.is_mapping_available ())
+        {
+          // Batch location must give the same results as the location of single positions:
+          mygsl::rng prng("taus2", 271828);
+          std::vector<geomtools::vector_3d> positions;
+          const geomtools::geom_info_dict_type & ginfos = geo_mgr.get_mapping ().get_geom_infos ();
+          for (geomtools::geom_info_dict_type::const_iterator i = ginfos.begin ();
+               i != ginfos.end ();
+               i++)
+            {
+              const geomtools::vector_3d & center = i->second.get_world_placement ().get_translation ();
+              positions.push_back (center);
+              for (int j = 0; j < 3; j++)
+                {
+                  positions.push_back (center + geomtools::vector_3d (prng.flat(-5.0, 5.0) * CLHEP::cm,
+                                                                      prng.flat(-5.0, 5.0) * CLHEP::cm,
+                                                                      prng.flat(-5.0, 5.0) * CLHEP::cm));
+                }
+            }
+          for (int j = 0; j < 1000; j++)
+            {
+              positions.push_back (geomtools::vector_3d (prng.flat(-1.0, 1.0) * CLHEP::m,
+                                                         prng.flat(-1.0, 1.0) * CLHEP::m,
+                                                         prng.flat(-1.0, 1.0) * CLHEP::m));
+            }
+          const geomtools::id_mgr::categories_by_name_col_type & categories
+            = geo_mgr.get_id_mgr ().categories_by_name ();
+          for (geomtools::id_mgr::categories_by_name_col_type::const_iterator icat = categories.begin ();
+               icat != categories.end ();
+               icat++)
+            {
+              std::vector<geomtools::geom_id> gids;
+              geo_mgr.locate (positions, icat->first, gids, GEOMTOOLS_PROPER_TOLERANCE, 4);
+              size_t nlocated = 0;
+              for (size_t ipos = 0; ipos < positions.size (); ipos++)
+                {
+                  const geomtools::geom_id & gid
+                    = geo_mgr.get_mapping ().get_geom_id (positions[ipos], icat->first);
+                  DT_THROW_IF (gids[ipos] != gid, std::logic_error,
+                               "Batch location of position #" << ipos << " in category '" << icat->first
+                               << "' gives " << gids[ipos] << " instead of " << gid << " !");
+                  if (gid.is_valid ()) nlocated++;
+                }
+              std::clog << "NOTICE: " << "Batch location in category '" << icat->first << "' : "
+                        << nlocated << "/" << positions.size () << " located positions" << std::endl;
+              // The source holder has a composite shape (union):
+              DT_THROW_IF (icat->first == "source_holder.gc" && nlocated == 0, std::logic_error,
+                           "No position located in the source holder !");
+            }
+        }
+
       if (use_plugins)
         {
           std::clog << "NOTICE: " << "Accessing some plugins..." << std::endl;
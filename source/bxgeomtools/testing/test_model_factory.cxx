@@ -3,12 +3,15 @@
 // Standard library:
 #include <cstdlib>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <exception>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/utils.h>
+#include <datatools/exception.h>
 
 // This project:
 #include <geomtools/geomtools_config.h>
@@ -24,6 +27,34 @@
 #include <geomtools_test_model_2.cc>
 #include <geomtools_test_world_model.cc>
 
+// Hash of the GDML export of a polycone model built from a data file:
+std::string polycone_gdml_hash (const std::string & polycone_data_)
+{
+  {
+    std::ofstream data_file ("test_model_factory_polycone.data");
+    data_file << "#@length_unit mm" << std::endl;
+    data_file << polycone_data_;
+  }
+  {
+    std::ofstream geom_file ("test_model_factory_polycone.geom");
+    geom_file << "#@description A polycone model built from a data file" << std::endl;
+    geom_file << "#@key_label  \"name\"" << std::endl;
+    geom_file << "#@meta_label \"type\"" << std::endl;
+    geom_file << "[name=\"polycone.model\" type=\"geomtools::simple_shaped_model\"]" << std::endl;
+    geom_file << "shape_type   : string = \"polycone\"" << std::endl;
+    geom_file << "length_unit  : string = \"mm\"" << std::endl;
+    geom_file << "build_mode   : string = \"datafile\"" << std::endl;
+    geom_file << "datafile     : string = \"test_model_factory_polycone.data\"" << std::endl;
+    geom_file << "material.ref : string = \"vacuum\"" << std::endl;
+  }
+  geomtools::model_factory factory;
+  factory.add_property_prefix ("material.");
+  factory.load ("test_model_factory_polycone.geom");
+  factory.lock ();
+  geomtools::gdml_export GDML;
+  return GDML.compute_hash (factory, "polycone.model");
+}
+
 int main (int argc_, char ** argv_)
 {
   using namespace std;
@@ -232,6 +263,35 @@ int main (int argc_, char ** argv_)
         GDML.parameters ().store ("angle_unit",
                                   geomtools::gdml_export::default_angle_unit());
         GDML.export_gdml ("test_model_factory.gdml", factory, model_name);
+
+        // The GDML description does not depend on the number of threads:
+        GDML.set_number_of_threads (4);
+        GDML.export_gdml ("test_model_factory_mt.gdml", factory, model_name);
+        std::ifstream gdml_st ("test_model_factory.gdml");
+        std::ifstream gdml_mt ("test_model_factory_mt.gdml");
+        std::ostringstream gdml_st_oss;
+        std::ostringstream gdml_mt_oss;
+        gdml_st_oss << gdml_st.rdbuf ();
+        gdml_mt_oss << gdml_mt.rdbuf ();
+        DT_THROW_IF (gdml_st_oss.str () != gdml_mt_oss.str (), std::logic_error,
+                     "Multi-threaded GDML export differs from the single-threaded one !");
+        clog << "GDML export with 4 threads: identical output." << endl;
+
+        // Cached GDML export:
+        const std::string cached_1 = GDML.export_gdml_cached (".", factory, model_name);
+        const std::string cached_2 = GDML.export_gdml_cached (".", factory, model_name);
+        DT_THROW_IF (cached_1 != cached_2, std::logic_error, "Cached GDML file is not reused !");
+        clog << "Cached GDML file: '" << cached_1 << "'" << endl;
+
+        // The hash covers the contents of the data files of the models:
+        const std::string polycone_hash_1 = polycone_gdml_hash ("-10 0 20\n10 0 25\n");
+        const std::string polycone_hash_2 = polycone_gdml_hash ("-10 0 20\n10 0 30\n");
+        DT_THROW_IF (polycone_hash_1 == polycone_hash_2, std::logic_error,
+                     "GDML hash does not depend on the contents of the polycone data file !");
+        DT_THROW_IF (polycone_hash_1 != polycone_gdml_hash ("-10 0 20\n10 0 25\n"), std::logic_error,
+                     "GDML hash is not reproducible !");
+        clog << "GDML hash of the polycone data files: "
+             << polycone_hash_1 << " " << polycone_hash_2 << endl;
       }
     }
   catch (exception & x)
@@ -0,0 +1,200 @@
+// test_overlap_checker.cxx
+
+// Ourselves:
+#include <geomtools/overlap_checker.h>
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/time_tools.h>
+
+// This project:
+#include <geomtools/box.h>
+#include <geomtools/union_3d.h>
+#include <geomtools/polycone.h>
+#include <geomtools/logical_volume.h>
+#include <geomtools/physical_volume.h>
+#include <geomtools/placement.h>
+#include <geomtools/regular_grid_placement.h>
+#include <geomtools/overlapping.h>
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'geomtools::overlap_checker'!" << std::endl;
+
+    // World volume:
+    geomtools::box world_box(1000.0 * CLHEP::mm, 1000.0 * CLHEP::mm, 100.0 * CLHEP::mm);
+    world_box.lock();
+    geomtools::logical_volume world_log("world.log", world_box);
+
+    // A grid of 16x16 non-overlapping cells:
+    geomtools::box cell_box(40.0 * CLHEP::mm, 40.0 * CLHEP::mm, 40.0 * CLHEP::mm);
+    cell_box.lock();
+    geomtools::logical_volume cell_log("cell.log", cell_box);
+    geomtools::regular_grid_placement cells_placement(geomtools::placement(0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+                                                      50.0 * CLHEP::mm, 50.0 * CLHEP::mm,
+                                                      16, 16,
+                                                      geomtools::regular_grid_placement::MODE_XY);
+    geomtools::physical_volume cells_phys("cells", cell_log, world_log, cells_placement);
+
+    // A volume overlapping four cells:
+    geomtools::box intruder_box(40.0 * CLHEP::mm, 40.0 * CLHEP::mm, 30.0 * CLHEP::mm);
+    intruder_box.lock();
+    geomtools::logical_volume intruder_log("intruder.log", intruder_box);
+    geomtools::placement intruder_placement(-350.0 * CLHEP::mm, -350.0 * CLHEP::mm, 0.0,
+                                            0.0, 0.0, 0.0);
+    geomtools::physical_volume intruder_phys("intruder", intruder_log, world_log, intruder_placement);
+
+    // A volume partly outside the world volume:
+    geomtools::placement outlier_placement(490.0 * CLHEP::mm, 0.0, 0.0, 0.0, 0.0, 0.0);
+    geomtools::physical_volume outlier_phys("outlier", cell_log, world_log, outlier_placement);
+
+    const std::size_t nitems = 16 * 16 + 2;
+    std::string reference_dump;
+    for (unsigned int nthreads : {1U, 4U}) {
+      geomtools::overlap_checker checker;
+      checker.set_number_of_threads(nthreads);
+      checker.set_sampling("high");
+      DT_THROW_IF(checker.get_sampling() != geomtools::overlapping::FLAG_WIRES_HIGH_SAMPLING,
+                  std::logic_error, "Invalid sampling!");
+      geomtools::overlap_checker::report report;
+      datatools::computing_time ct;
+      ct.start();
+      checker.check(world_log, report);
+      ct.stop();
+      std::ostringstream dump;
+      report.tree_dump(dump, "Overlap check report: ");
+      std::clog << dump.str();
+      std::clog << "Number of threads : " << nthreads << std::endl;
+      std::clog << "Check time        : " << ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+
+      DT_THROW_IF(report.number_of_logicals != 1, std::logic_error, "Invalid number of logicals!");
+      DT_THROW_IF(report.number_of_items != nitems, std::logic_error, "Invalid number of items!");
+      DT_THROW_IF(report.number_of_pairs != nitems * (nitems - 1) / 2, std::logic_error,
+                  "Invalid number of pairs!");
+      // Only the intruder and the four cells below have intersecting bounding boxes:
+      DT_THROW_IF(report.number_of_candidates != 4, std::logic_error,
+                  "Invalid number of candidate pairs!");
+      std::size_t nsimple = 0;
+      std::size_t nmother = 0;
+      for (const geomtools::overlap_checker::overlap_record & record : report.overlaps) {
+        if (record.info.type == geomtools::overlapping::OVERLAP_MOTHER_DAUGHTER) {
+          DT_THROW_IF(record.info.name_second != "outlier", std::logic_error,
+                      "Unexpected mother/daughter overlap!");
+          nmother++;
+        } else {
+          DT_THROW_IF(record.info.name_first != "intruder" && record.info.name_second != "intruder",
+                      std::logic_error, "Unexpected overlap!");
+          nsimple++;
+        }
+      }
+      DT_THROW_IF(nsimple != 4, std::logic_error, "Invalid number of overlapping pairs!");
+      DT_THROW_IF(nmother != 1, std::logic_error, "Invalid number of mother/daughter overlaps!");
+
+      // The report does not depend on the number of threads:
+      if (reference_dump.empty()) {
+        reference_dump = dump.str();
+      } else {
+        DT_THROW_IF(dump.str() != reference_dump, std::logic_error, "Report is not deterministic!");
+      }
+    }
+
+    // Cross-check with the pairwise algorithm:
+    geomtools::overlapping OL;
+    std::size_t nbrute = 0;
+    for (std::size_t i = 0; i < cells_placement.get_number_of_items(); i++) {
+      geomtools::placement cell_placement;
+      cells_placement.compute_placement(i, cell_placement);
+      geomtools::overlapping::report brute_report;
+      if (OL.check_two_volumes_overlap(cell_box, cell_placement,
+                                       intruder_box, intruder_placement,
+                                       brute_report,
+                                       geomtools::overlapping::FLAG_WIRES_HIGH_SAMPLING)) {
+        nbrute++;
+      }
+    }
+    DT_THROW_IF(nbrute != 4, std::logic_error, "Pairwise algorithm disagrees!");
+
+    {
+      // Composite and polycone daughters, the faces of which are computed at first use:
+      geomtools::box mother_box(1000.0 * CLHEP::mm, 1000.0 * CLHEP::mm, 200.0 * CLHEP::mm);
+      mother_box.lock();
+      geomtools::logical_volume mother_log("mother.log", mother_box);
+
+      geomtools::box body_box(40.0 * CLHEP::mm, 40.0 * CLHEP::mm, 40.0 * CLHEP::mm);
+      body_box.lock();
+      geomtools::box ear_box(20.0 * CLHEP::mm, 20.0 * CLHEP::mm, 20.0 * CLHEP::mm);
+      ear_box.lock();
+      geomtools::union_3d union_shape;
+      union_shape.set_shape1(body_box, geomtools::placement(0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
+      union_shape.set_shape2(ear_box, geomtools::placement(25.0 * CLHEP::mm, 0.0, 0.0, 0.0, 0.0, 0.0));
+      union_shape.lock();
+      geomtools::logical_volume union_log("union.log", union_shape);
+      geomtools::regular_grid_placement unions_placement(geomtools::placement(0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+                                                         100.0 * CLHEP::mm, 100.0 * CLHEP::mm,
+                                                         8, 8,
+                                                         geomtools::regular_grid_placement::MODE_XY);
+      geomtools::physical_volume unions_phys("unions", union_log, mother_log, unions_placement);
+
+      geomtools::polycone polycone_shape;
+      polycone_shape.add(-30.0 * CLHEP::mm, 20.0 * CLHEP::mm, false);
+      polycone_shape.add(  0.0 * CLHEP::mm, 25.0 * CLHEP::mm, false);
+      polycone_shape.add( 30.0 * CLHEP::mm, 20.0 * CLHEP::mm, true);
+      polycone_shape.lock();
+      geomtools::logical_volume polycone_log("polycone.log", polycone_shape);
+      geomtools::regular_grid_placement polycones_placement(geomtools::placement(0.0, 450.0 * CLHEP::mm, 0.0, 0.0, 0.0, 0.0),
+                                                            100.0 * CLHEP::mm, 100.0 * CLHEP::mm,
+                                                            8, 1,
+                                                            geomtools::regular_grid_placement::MODE_XY);
+      geomtools::physical_volume polycones_phys("polycones", polycone_log, mother_log, polycones_placement);
+
+      // A polycone entering the first union volume:
+      geomtools::placement bad_placement(-320.0 * CLHEP::mm, -350.0 * CLHEP::mm, 0.0, 0.0, 0.0, 0.0);
+      geomtools::physical_volume bad_phys("bad_polycone", polycone_log, mother_log, bad_placement);
+
+      std::string composite_reference_dump;
+      for (unsigned int nthreads : {1U, 4U}) {
+        geomtools::overlap_checker checker;
+        checker.set_number_of_threads(nthreads);
+        geomtools::overlap_checker::report report;
+        checker.check(mother_log, report);
+        std::ostringstream dump;
+        report.tree_dump(dump, "Overlap check report (composite and polycone daughters): ");
+        std::clog << dump.str();
+        DT_THROW_IF(! body_box.has_computed_faces() || ! ear_box.has_computed_faces(),
+                    std::logic_error, "Faces of the components of the union are not computed!");
+        DT_THROW_IF(! report.has_overlaps(), std::logic_error, "Missing overlap!");
+        for (const geomtools::overlap_checker::overlap_record & record : report.overlaps) {
+          DT_THROW_IF(record.info.type != geomtools::overlapping::OVERLAP_SIMPLE,
+                      std::logic_error, "Unexpected mother/daughter overlap!");
+          DT_THROW_IF(record.info.name_first != "bad_polycone" && record.info.name_second != "bad_polycone",
+                      std::logic_error, "Unexpected overlap!");
+        }
+        if (composite_reference_dump.empty()) {
+          composite_reference_dump = dump.str();
+        } else {
+          DT_THROW_IF(dump.str() != composite_reference_dump, std::logic_error, "Report is not deterministic!");
+        }
+      }
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
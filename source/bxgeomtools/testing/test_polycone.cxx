@@ -7,7 +7,9 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <exception>
+#include <stdexcept>
 
 // Third party:
 // - GSL:
@@ -15,10 +17,13 @@
 // - Bayeux/datatools:
 #include <datatools/temporary_files.h>
 #include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
 
 // This project:
 #include <geomtools/geomtools_config.h>
 #include <geomtools/gnuplot_draw.h>
+#include <geomtools/right_circular_conical_frustrum.h>
 #if GEOMTOOLS_WITH_GNUPLOT_DISPLAY == 1
 #include <geomtools/gnuplot_i.h>
 #include <geomtools/gnuplot_drawer.h>
@@ -176,6 +181,55 @@ int main (int argc_, char ** argv_)
     const geomtools::face_info_collection_type & finfos = my_solid.get_computed_faces();
     geomtools::print_face_infos(finfos, std::clog, "Solid faces: ", "INFO: ");
 
+    // Check the section tables against the containment tests of the frustra:
+    {
+      std::vector<geomtools::right_circular_conical_frustrum> frustra(my_solid.number_of_frustra());
+      std::vector<geomtools::placement> frustra_placements(my_solid.number_of_frustra());
+      for (unsigned int ifrustrum = 0; ifrustrum < frustra.size(); ifrustrum++) {
+        my_solid.compute_frustrum(frustra[ifrustrum], frustra_placements[ifrustrum], ifrustrum);
+      }
+      const size_t nchecks = 100000;
+      const double dim3 = 0.7 * dim;
+      std::vector<geomtools::vector_3d> positions;
+      for (size_t i = 0; i < nchecks; i++) {
+        positions.push_back(geomtools::vector_3d(dim3 * ( -1.0 + 2.0 * drand48()),
+                                                 dim3 * ( -1.0 + 2.0 * drand48()),
+                                                 1.5 * dim3 * ( -1.0 + 2.0 * drand48())));
+      }
+      std::vector<bool> ref_inside(nchecks, false);
+      std::vector<bool> ref_outside(nchecks, true);
+      datatools::computing_time ref_ct;
+      ref_ct.start();
+      for (size_t i = 0; i < nchecks; i++) {
+        for (unsigned int ifrustrum = 0; ifrustrum < frustra.size(); ifrustrum++) {
+          geomtools::vector_3d position_f;
+          frustra_placements[ifrustrum].mother_to_child(positions[i], position_f);
+          if (frustra[ifrustrum].is_inside(position_f)) ref_inside[i] = true;
+          if (!frustra[ifrustrum].is_outside(position_f)) ref_outside[i] = false;
+        }
+      }
+      ref_ct.stop();
+      size_t ninside = 0;
+      size_t noutside = 0;
+      datatools::computing_time ct;
+      ct.start();
+      for (size_t i = 0; i < nchecks; i++) {
+        const bool inside = my_solid.is_inside(positions[i]);
+        const bool outside = my_solid.is_outside(positions[i]);
+        DT_THROW_IF(!my_solid.has_partial_angle() && inside != ref_inside[i], std::logic_error,
+                    "Inside test mismatch at " << positions[i] << "!");
+        DT_THROW_IF(!my_solid.has_partial_angle() && outside != ref_outside[i], std::logic_error,
+                    "Outside test mismatch at " << positions[i] << "!");
+        if (inside) ninside++;
+        if (outside) noutside++;
+      }
+      ct.stop();
+      std::clog << "INFO: Checked " << nchecks << " points ("
+                << ninside << " inside, " << noutside << " outside)." << std::endl;
+      std::clog << "INFO: Frustra tests  : " << ref_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+      std::clog << "INFO: Sections tests : " << ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+    }
+
     int gpindex = 0;
 
     // Draw the volume:
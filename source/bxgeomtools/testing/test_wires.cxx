@@ -6,10 +6,13 @@
 #include <string>
 #include <exception>
 #include <list>
+#include <sstream>
+#include <stdexcept>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/temporary_files.h>
+#include <datatools/exception.h>
 #include <datatools/utils.h>
 #include <datatools/clhep_units.h>
 
@@ -233,6 +236,40 @@ int main(int argc_, char ** argv_)
       }
     }
 
+    {
+      // Compact wires rendered at some placement:
+      geomtools::wires_type b1_wires;
+      b1.generate_wires_self(b1_wires);
+      b1_wires.push_back(p1);
+      const geomtools::compact_wires cwires(b1_wires);
+      DT_THROW_IF(cwires.get_number_of_wires() != b1_wires.size(), std::logic_error,
+                  "Unexpected number of compact wires!");
+      DT_THROW_IF(cwires.get_extent() != 2.5, std::logic_error,
+                  "Unexpected extent of compact wires!");
+      geomtools::wires_type b1_wires2;
+      cwires.to_wires(b1_wires2);
+      DT_THROW_IF(b1_wires2 != b1_wires, std::logic_error, "Unexpected wires!");
+      std::ostringstream expected;
+      geomtools::gnuplot_draw::draw_wires(expected, up2, b1_wires);
+      std::string rendered;
+      geomtools::gnuplot_draw::xyz_range range;
+      range.activate();
+      geomtools::gnuplot_draw::basic_draw_compact_wires(rendered, up2, cwires, range);
+      DT_THROW_IF(rendered != expected.str(), std::logic_error,
+                  "Compact wires are not rendered as wires!");
+      DT_THROW_IF(! range.get_x_range().is_valid(), std::logic_error, "Unexpected range!");
+      // Decimated polylines keep their first and last points:
+      std::string decimated;
+      geomtools::gnuplot_draw::basic_draw_compact_wires(decimated, up1, cwires, range, 4);
+      geomtools::wires_type decimated_wires;
+      std::istringstream decimated_iss(decimated);
+      geomtools::parse_wires(decimated_iss, decimated_wires);
+      DT_THROW_IF(decimated_wires.back().size() != 3
+                  || decimated_wires.back().front() != p1.front()
+                  || decimated_wires.back().back() != p1.back(),
+                  std::logic_error, "Unexpected decimated wire!");
+    }
+
     std::list<geomtools::classified_segment> csegments;
     geomtools::classify_in_out_segment(segment1, *comp1, up1, 0.05, 0.0, csegments);
     // geomtools::classify_in_out_segment(segment1, b1, up1, 0.05, 0.0, csegments);
@@ -44,6 +44,7 @@ endif()
 # - Raw Headers and Sources
 set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/address_set.h
+  ${module_include_dir}/${module_name}/affine_transform.h
   ${module_include_dir}/${module_name}/angular_range.h
   ${module_include_dir}/${module_name}/angular_range.ipp
   ${module_include_dir}/${module_name}/base_hit.h
@@ -68,6 +69,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/cylindric_extrusion_boxed_model.h
   ${module_include_dir}/${module_name}/detail/manager-inl.h
   ${module_include_dir}/${module_name}/detail/model_tools.h
+  ${module_include_dir}/${module_name}/detail/rz_sections.h
   ${module_include_dir}/${module_name}/disk.h
   ${module_include_dir}/${module_name}/composite_surface.h
   ${module_include_dir}/${module_name}/display_data.h
@@ -159,6 +161,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/simple_shaped_model.h
   ${module_include_dir}/${module_name}/simple_world_model.h
   ${module_include_dir}/${module_name}/smart_id_locator.h
+  ${module_include_dir}/${module_name}/batch_locator.h
   ${module_include_dir}/${module_name}/spherical_sector.h
   ${module_include_dir}/${module_name}/sphere.h
   ${module_include_dir}/${module_name}/spherical_extrusion_box_model.h
@@ -191,6 +194,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/utils-reflect.h
   ${module_include_dir}/${module_name}/resource.h
   ${module_include_dir}/${module_name}/overlapping.h
+  ${module_include_dir}/${module_name}/overlap_checker.h
   ${module_include_dir}/${module_name}/model_with_internal_mesh_tools.h
   ${module_include_dir}/${module_name}/simple_polygon.h
   ${module_include_dir}/${module_name}/wall_solid.h
@@ -209,6 +213,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/angular_range.cc
   ${module_source_dir}/blur_spot.cc
   ${module_source_dir}/address_set.cc
+  ${module_source_dir}/affine_transform.cc
   ${module_source_dir}/extruded_box.cc
   ${module_source_dir}/extruded_box_model.cc
   ${module_source_dir}/ellipsoid_sector.cc
@@ -248,6 +253,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/regular_polygon.cc
   ${module_source_dir}/sensitive.cc
   ${module_source_dir}/smart_id_locator.cc
+  ${module_source_dir}/batch_locator.cc
   ${module_source_dir}/helix_3d.cc
   ${module_source_dir}/line_3d.cc
   ${module_source_dir}/polyline_3d.cc
@@ -322,6 +328,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/geomtools_driver.cc
   ${module_source_dir}/version.cc
   ${module_source_dir}/overlapping.cc
+  ${module_source_dir}/overlap_checker.cc
   ${module_source_dir}/model_with_internal_mesh_tools.cc
   ${module_source_dir}/simple_polygon.cc
   ${module_source_dir}/wall_solid.cc
@@ -346,6 +353,7 @@ set(${module_name}_TEST_ENVIRONMENT "GEOMTOOLS_RESOURCE_DIR=${module_resource_di
 
 set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_address_set.cxx
+  ${module_test_dir}/test_affine_transform.cxx
   ${module_test_dir}/test_angular_range.cxx
   ${module_test_dir}/test_base_hit.cxx
   ${module_test_dir}/test_blur_spot.cxx
@@ -400,6 +408,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_regular_circular_placement.cxx
   ${module_test_dir}/test_regular_linear_placement.cxx
   ${module_test_dir}/test_regular_3d_mesh_placement.cxx
+  ${module_test_dir}/test_overlap_checker.cxx
   ${module_test_dir}/test_regular_polygon.cxx
   ${module_test_dir}/test_simple_polygon.cxx
   ${module_test_dir}/test_rotation_3d.cxx
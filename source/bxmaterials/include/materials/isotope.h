@@ -202,7 +202,28 @@ namespace materials {
     //! Load a dictionary of isotope records from the AME (2003/2012) data file
     static void load_ame_table(isotope::isotope_dict_type &, ame_release_type ame_release_ = AME_RELEASE_2012);
 
+    //! Load a dictionary of isotope records from an AME data file given its path
+    static void load_ame_file(const std::string & ame_filename_, isotope::isotope_dict_type &);
+
+    //! Compile an AME data file in a binary table
+    /**
+     *  The binary table is a memory-mappable array of fixed size records
+     *  sorted by (Z, A). When it is installed besides the AME data file of
+     *  the resource directory with the '.bin' extension, records are decoded
+     *  from it on first lookup. Otherwise, the AME data file is indexed and
+     *  records are parsed one by one on first lookup.
+     */
+    static void compile_ame_table(const std::string & ame_filename_,
+                                  const std::string & bin_filename_);
+
+    //! Load a dictionary of isotope records from a compiled AME table
+    static void load_compiled_ame_table(const std::string & bin_filename_, isotope::isotope_dict_type &);
+
     //! Return the isotope record from the table
+    /**
+     *  Only the requested record is decoded, the full table of isotopes is
+     *  not built.
+     */
     static const record_type & table_record_from_id(const id &);
 
     //! \brief Isomeric level
@@ -85,6 +85,26 @@ namespace materials {
     /// Set the alias overloading flag
     void set_alias_allow_overload(bool aao_);
 
+    /// Check if isotopes, elements and materials are built on first lookup
+    bool is_lazy_build() const;
+
+    /// Set the lazy build flag
+    /**
+     *  In lazy build mode, the isotopes, elements and materials loaded from
+     *  configuration are declared but only built, with their dependencies,
+     *  on first lookup by name. Accessing a whole dictionary, the ordered list
+     *  of materials or printing the manager builds all pending entries, in
+     *  their order of declaration. Lookups are not thread-safe as long as
+     *  some entries are pending.
+     */
+    void set_lazy_build(bool);
+
+    /// Return the number of declared isotopes, elements and materials not built yet
+    std::size_t get_number_of_pending_entries() const;
+
+    /// Build all pending isotopes, elements and materials
+    void build_pending_entries();
+
     /// Check if a given isotope is defined
     bool has_isotope(const std::string & entry_name_) const;
 
@@ -181,6 +201,39 @@ namespace materials {
     /// Set default values to attributes
     void _set_defaults();
 
+  private:
+
+    /// \brief Declaration of an isotope, element or material to be built on first lookup
+    struct pending_entry
+    {
+      std::string           type;   //!< Type of the entry
+      datatools::properties config; //!< Configuration of the entry
+      std::size_t           rank;   //!< Rank of declaration
+    };
+
+    /// Dictionary of pending entries
+    typedef std::map<std::string, pending_entry> pending_dict_type;
+
+    /// Build an isotope, element, material or material alias
+    void _build_entry_(const std::string & name_,
+                       const std::string & type_,
+                       const datatools::properties & config_,
+                       bool ordered_);
+
+    /// Declare an isotope, element, material or material alias to be built on first lookup
+    void _declare_entry_(const std::string & name_,
+                         const std::string & type_,
+                         const datatools::properties & config_);
+
+    /// Build a pending entry, if any, after its dependencies
+    void _build_pending_(pending_dict_type & pending_, const std::string & name_);
+
+    /// Build the pending isotope, element and material with a given name (lookup)
+    void _resolve_(const std::string & name_) const;
+
+    /// Build all pending entries (lookup of a dictionary)
+    void _resolve_all_() const;
+
   private:
 
     // Management:
@@ -192,12 +245,17 @@ namespace materials {
     std::set<std::string>  _material_exported_prefixes_; //!< List of property prefixes exported to materials
     bool                   _alias_allow_overload_;       //!< Flag to allow material alias overloading
     bool                   _alias_of_alias_allowed_;     //!< Flag to allow alias of material alias
+    bool                   _lazy_build_;                 //!< Flag to build entries on first lookup
     // Dynamic attributes:
     boost::scoped_ptr<factory> _creator_; //!< Embeded factory
     isotope_dict_type      _isotopes_; //!< Dictionary of isotopes
     element_dict_type      _elements_; //!< Dictionary of elements
     material_dict_type     _materials_; //!< Dictionary of materials
     std::list<std::string> _ordered_materials_; //!< Ordered list of materials by name
+    pending_dict_type      _pending_isotopes_;  //!< Isotopes to be built on first lookup
+    pending_dict_type      _pending_elements_;  //!< Elements to be built on first lookup
+    pending_dict_type      _pending_materials_; //!< Materials and material aliases to be built on first lookup
+    std::size_t            _pending_rank_;      //!< Rank of the next declaration
 
   };
 
@@ -0,0 +1,55 @@
+// -*- mode: c++ ; -*-
+// materials_compile_ame.cxx
+//
+// Compile an AME mass table in a binary table which can be memory mapped
+// by materials::isotope (see materials::isotope::compile_ame_table).
+//
+// Usage:
+//
+//   bxmaterials_compile_ame mass.mas12 mass.mas12.bin
+//
+
+// Standard Library
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+// Third Party
+// - Bayeux/datatools:
+#include <datatools/logger.h>
+
+// This project:
+#include <materials/isotope.h>
+
+/****************
+ * Main program *
+ ****************/
+int main (int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_ERROR;
+
+  try {
+    if (argc_ != 3) {
+      std::cerr << "Usage: bxmaterials_compile_ame AME_FILE BINARY_FILE" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const std::string ame_filename = argv_[1];
+    const std::string bin_filename = argv_[2];
+    materials::isotope::compile_ame_table(ame_filename, bin_filename);
+    materials::isotope::isotope_dict_type compiled;
+    materials::isotope::load_compiled_ame_table(bin_filename, compiled);
+    std::clog << "Compiled " << compiled.size() << " isotope records from '"
+              << ame_filename << "' in '" << bin_filename << "'." << std::endl;
+  }
+  catch (std::exception & x) {
+    DT_LOG_ERROR(logging, x.what());
+    error_code = EXIT_FAILURE;
+  }
+  catch (...) {
+    DT_LOG_ERROR(logging, "Unexpected error !");
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -4,12 +4,20 @@
 #include <materials/isotope.h>
 
 // Standard Library:
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 #include <sstream>
 #include <limits>
+#include <mutex>
 
 // Third Party:
+// - Boost:
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/scoped_ptr.hpp>
 // - Bayeux/datatools:
 #include <datatools/exception.h>
 #include <datatools/logger.h>
@@ -285,110 +293,316 @@ namespace materials {
     return;
   }
 
+  namespace {
+
+    //! Number of header lines of the AME data files
+    const int AME_HEADER_LINES = 39;
+
+    //! Return the name of the AME data file resource for a given release
+    std::string ame_resource_name(isotope::ame_release_type ame_release_)
+    {
+      switch (ame_release_) {
+      case isotope::AME_RELEASE_2003:
+        return "data/mass.mas03";
+      case isotope::AME_RELEASE_2012:
+        return "data/mass.mas12";
+      default:
+        break;
+      }
+      DT_THROW(std::logic_error, "Invalid AME release " << ame_release_ << "!");
+    }
+
+    //! Parse the Z and A columns of an AME line
+    isotope::id parse_ame_id(const std::string & ame_line_)
+    {
+      const int zMax = 118;
+      const int aMax = 295;
+      int z;
+      DT_THROW_IF (! token_to_int(ame_line_.substr(9, 5), 0, zMax, z), std::logic_error,
+                   "Invalid Z format !");
+      int a;
+      DT_THROW_IF (! token_to_int(ame_line_.substr(14, 5), 1, aMax, a), std::logic_error,
+                   "Invalid A format !");
+      return isotope::id(z, a);
+    }
+
+    //! Parse an AME line
+    void parse_ame_record(const std::string & ame_line_, isotope::record_type & r_)
+    {
+      const isotope::id iid = parse_ame_id(ame_line_);
+      std::string el_str      = ame_line_.substr(20, 3);
+      std::string mx_str      = ame_line_.substr(29, 13);
+      std::string mx_err_str  = ame_line_.substr(41, 11);
+      std::string bea_str     = ame_line_.substr(52, 11);
+      std::string bea_err_str = ame_line_.substr(63, 9);
+      std::string am_str      = ame_line_.substr(96, 3);
+      std::string am_def_str  = ame_line_.substr(100, 12);
+      std::string am_err_str  = ame_line_.substr(112, 11);
+      DT_THROW_IF (! token_to_string(el_str, r_.symbol), std::logic_error,
+                   "Invalid format for element symbol !");
+      r_.Z = iid.get_z();
+      r_.A = iid.get_a();
+      DT_THROW_IF (! token_to_double(mx_str, r_.mx), std::logic_error,
+                   "Invalid format for mass excess !");
+      r_.mx *= CLHEP::keV;
+      DT_THROW_IF (! token_to_double(mx_err_str, r_.mx_err), std::logic_error,
+                   "Invalid format for mass excess error !");
+      r_.mx_err *= CLHEP::keV;
+      DT_THROW_IF (! token_to_double(bea_str, r_.bea), std::logic_error,
+                   "Invalid format for binding energy per nucleon !");
+      r_.bea *= CLHEP::keV;
+      DT_THROW_IF (! token_to_double(bea_err_str, r_.bea_err), std::logic_error,
+                   "Invalid format for binding energy per nucleon error !");
+      r_.bea_err *= CLHEP::keV;
+      double am;
+      DT_THROW_IF (! token_to_double(am_str + am_def_str, am), std::logic_error,
+                   "Invalid format for atomic mass !");
+      r_.am = am * 1.e-6;
+      double am_err;
+      DT_THROW_IF (! token_to_double(am_err_str, am_err), std::logic_error,
+                   "Invalid format for atomic mass error !");
+      r_.am_err = (am_err * 1e-6);
+      return;
+    }
+
+    //! \brief Header of a compiled AME table
+    struct ame_bin_header
+    {
+      char     magic[8];    //!< Magic string
+      uint32_t version;     //!< Version of the format
+      uint32_t byte_order;  //!< Byte order mark
+      uint32_t nrecords;    //!< Number of records
+      uint32_t record_size; //!< Size of a record in bytes
+    };
+
+    //! \brief Record of a compiled AME table (CLHEP units)
+    struct ame_bin_record
+    {
+      int32_t z;
+      int32_t a;
+      char    symbol[8];
+      double  mx;
+      double  mx_err;
+      double  bea;
+      double  bea_err;
+      double  am;
+      double  am_err;
+    };
+
+    const char     AME_BIN_MAGIC[8]   = {'B', 'X', 'A', 'M', 'E', 'B', 'I', 'N'};
+    const uint32_t AME_BIN_VERSION    = 1;
+    const uint32_t AME_BIN_BYTE_ORDER = 0x01020304;
+
+    bool operator<(const ame_bin_record & r_, const isotope::id & id_)
+    {
+      return r_.z < id_.get_z() || (r_.z == id_.get_z() && r_.a < id_.get_a());
+    }
+
+    //! \brief Table of isotope records decoded on first lookup
+    //!
+    //! Records are decoded from the compiled (memory mapped) table if it is
+    //! installed, or parsed from the AME data file which is indexed once.
+    class lazy_ame_table
+    {
+    public:
+
+      explicit lazy_ame_table(isotope::ame_release_type ame_release_)
+        : _release_(ame_release_)
+      {
+        return;
+      }
+
+      //! Return the record associated to an isotope id or a null pointer
+      const isotope::record_type * find(const isotope::id & id_)
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _open_();
+        std::map<isotope::id, isotope::record_type>::const_iterator found = _decoded_.find(id_);
+        if (found != _decoded_.end()) {
+          return &found->second;
+        }
+        isotope::record_type r;
+        if (_records_ != nullptr) {
+          const ame_bin_record * last = _records_ + _nrecords_;
+          const ame_bin_record * bin = std::lower_bound(_records_, last, id_);
+          if (bin == last || bin->z != id_.get_z() || bin->a != id_.get_a()) {
+            return nullptr;
+          }
+          _decode_(*bin, r);
+        } else {
+          std::map<isotope::id, std::streamoff>::const_iterator offset = _text_offsets_.find(id_);
+          if (offset == _text_offsets_.end()) {
+            return nullptr;
+          }
+          _text_.clear();
+          _text_.seekg(offset->second);
+          std::string ame_line;
+          std::getline(_text_, ame_line);
+          parse_ame_record(ame_line, r);
+        }
+        return &(_decoded_[id_] = r);
+      }
+
+      //! Decode all records
+      void load_all(isotope::isotope_dict_type & db_)
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _open_();
+        if (_records_ == nullptr) {
+          isotope::load_ame_table(db_, _release_);
+          return;
+        }
+        for (std::size_t i = 0; i < _nrecords_; i++) {
+          isotope::record_type r;
+          _decode_(_records_[i], r);
+          db_[isotope::id(r.Z, r.A)] = r;
+        }
+        return;
+      }
+
+    private:
+
+      static void _decode_(const ame_bin_record & bin_, isotope::record_type & r_)
+      {
+        r_.symbol.assign(bin_.symbol, ::strnlen(bin_.symbol, sizeof(bin_.symbol)));
+        r_.Z = bin_.z;
+        r_.A = bin_.a;
+        r_.mx = bin_.mx;
+        r_.mx_err = bin_.mx_err;
+        r_.bea = bin_.bea;
+        r_.bea_err = bin_.bea_err;
+        r_.am = bin_.am;
+        r_.am_err = bin_.am_err;
+        return;
+      }
+
+      void _open_()
+      {
+        if (_opened_) return;
+        _opened_ = true;
+        const std::string ame_name = ame_resource_name(_release_);
+        const std::string bin_path = materials::get_resource_dir(true) + "/" + ame_name + ".bin";
+        if (boost::filesystem::exists(bin_path) && open_binary(bin_path)) {
+          return;
+        }
+        _index_text_(materials::get_resource(ame_name, true));
+        return;
+      }
+
+    public:
+
+      //! Use a compiled table
+      bool open_binary(const std::string & bin_path_)
+      {
+        try {
+          _map_.open(bin_path_);
+        } catch (std::exception & error) {
+          DT_LOG_WARNING(datatools::logger::PRIO_WARNING,
+                         "Cannot map the compiled AME table '" << bin_path_ << "': " << error.what());
+          return false;
+        }
+        bool valid = _map_.is_open() && _map_.size() >= sizeof(ame_bin_header);
+        const ame_bin_header * header = nullptr;
+        if (valid) {
+          header = reinterpret_cast<const ame_bin_header *>(_map_.data());
+          valid = std::equal(AME_BIN_MAGIC, AME_BIN_MAGIC + sizeof(AME_BIN_MAGIC), header->magic)
+            && header->version == AME_BIN_VERSION
+            && header->byte_order == AME_BIN_BYTE_ORDER
+            && header->record_size == sizeof(ame_bin_record)
+            && _map_.size() == sizeof(ame_bin_header) + header->nrecords * sizeof(ame_bin_record);
+        }
+        if (!valid) {
+          DT_LOG_WARNING(datatools::logger::PRIO_WARNING,
+                         "Ignoring invalid compiled AME table '" << bin_path_ << "'!");
+          if (_map_.is_open()) _map_.close();
+          return false;
+        }
+        _records_ = reinterpret_cast<const ame_bin_record *>(_map_.data() + sizeof(ame_bin_header));
+        _nrecords_ = header->nrecords;
+        _opened_ = true;
+        return true;
+      }
+
+    private:
+
+      void _index_text_(const std::string & tape_name_)
+      {
+        _text_.open(tape_name_.c_str());
+        DT_THROW_IF(! _text_.is_open(), std::runtime_error, "Cannot open '" << tape_name_ << "' !");
+        std::string ame_line;
+        for (int i = 0 ; i < AME_HEADER_LINES ; i++) {
+          std::getline(_text_, ame_line);
+        }
+        std::streamoff offset = _text_.tellg();
+        while (std::getline(_text_, ame_line)) {
+          const isotope::id iid = parse_ame_id(ame_line);
+          if (iid.is_valid()) {
+            _text_offsets_[iid] = offset;
+          }
+          offset = _text_.tellg();
+        }
+        return;
+      }
+
+    private:
+
+      std::mutex _mutex_;
+      isotope::ame_release_type _release_;
+      bool _opened_ = false;
+      // Compiled table:
+      boost::iostreams::mapped_file_source _map_;
+      const ame_bin_record * _records_ = nullptr;
+      std::size_t _nrecords_ = 0;
+      // AME data file:
+      std::ifstream _text_;
+      std::map<isotope::id, std::streamoff> _text_offsets_;
+      // Decoded records:
+      std::map<isotope::id, isotope::record_type> _decoded_;
+
+    };
+
+    lazy_ame_table & default_ame_table()
+    {
+      static lazy_ame_table _table(isotope::AME_RELEASE_2012);
+      return _table;
+    }
+
+  }
+
   // static
   void isotope::load_ame_table(isotope::isotope_dict_type & db_, ame_release_type ame_release_)
+  {
+    load_ame_file(materials::get_resource(ame_resource_name(ame_release_), true), db_);
+    return;
+  }
+
+  // static
+  void isotope::load_ame_file(const std::string & ame_filename_, isotope::isotope_dict_type & db_)
   {
     bool devel = false;
     //devel = true;
-    // int a_max = 0;
-    // a_max = 250;
-    int zMax = 118;
-    int aMax = 295;
-    std::string ame_mass_file;
-    switch (ame_release_) {
-    case AME_RELEASE_2003:
-      ame_mass_file = "data/mass.mas03";
-      break;
-    case AME_RELEASE_2012:
-      ame_mass_file = "data/mass.mas12";
-      break;
-    default:
-      DT_THROW_IF(true, std::logic_error, "Invalid AME release " << ame_release_ << "!");
-    }
-    std::string tape_name = materials::get_resource(ame_mass_file, true);
     // Open an ifstream from AME file:
     std::ifstream ifstr_tape;
-    ifstr_tape.open(tape_name.c_str());
-    DT_THROW_IF(! ifstr_tape.is_open(), std::runtime_error, "Cannot open '" << tape_name << "' !");
+    ifstr_tape.open(ame_filename_.c_str());
+    DT_THROW_IF(! ifstr_tape.is_open(), std::runtime_error, "Cannot open '" << ame_filename_ << "' !");
     std::string ame_line;
     // Skip header:
-    for (int i = 0 ; i < 39 ; i++) {
+    for (int i = 0 ; i < AME_HEADER_LINES ; i++) {
       std::getline(ifstr_tape, ame_line);
     }
     // Load records:
     while (std::getline(ifstr_tape, ame_line) ) {
       if (devel) {
-        std::cerr << "DEVEL: materials::isotope::load_ame_table: "
+        std::cerr << "DEVEL: materials::isotope::load_ame_file: "
                   << "line =\n'" <<  ame_line << "'"
                   << std::endl;
       }
       // Parse the line record:
-      std::string z_str       = ame_line.substr(9, 5);
-      std::string a_str       = ame_line.substr(14, 5);
-      std::string el_str      = ame_line.substr(20, 3);
-      std::string mx_str      = ame_line.substr(29, 13);
-      std::string mx_err_str  = ame_line.substr(41, 11);
-      std::string bea_str     = ame_line.substr(52, 11);
-      std::string bea_err_str = ame_line.substr(63, 9);
-      std::string am_str      = ame_line.substr(96, 3);
-      std::string am_def_str  = ame_line.substr(100, 12);
-      std::string am_err_str  = ame_line.substr(112, 11);
-      if (devel) {
-        std::cerr << "DEVEL: materials::isotope::load_ame2003_table: " << std::endl
-                  << "  z_str=" << z_str << " a_str=" << a_str << std::endl
-                  << "  mx_str=" << mx_str << " am_err_str=" << mx_err_str << std::endl
-                  << "  bea_str=" << bea_str << " bea_err_str=" << bea_err_str << std::endl
-                  << "  am_str=" << am_str << am_def_str << " am_err_str=" << am_err_str
-                  << std::endl;
-      }
-      isotope::id iid;
-      int z;
-      DT_THROW_IF (! token_to_int(z_str, 0, zMax, z), std::logic_error,
-                   "Invalid Z format !");
-      int a;
-      DT_THROW_IF (! token_to_int(a_str, 1, aMax, a), std::logic_error,
-                   "Invalid A format !");
-      if (devel) {
-        std::cerr << "DEVEL: materials::isotope::load_ame2003_table: "
-                  << "Z=" << z << " A=" << a
-                  << std::endl;
-      }
-      /*
-      if (a_max > 0 && a > a_max) {
-        break;
-      }
-      */
-      iid.set(z, a);
-
       isotope::record_type r;
-      DT_THROW_IF (! token_to_string(el_str, r.symbol), std::logic_error,
-                   "Invalid format for element symbol !");
-      r.Z = z;
-      r.A = a;
-      DT_THROW_IF (! token_to_double(mx_str, r.mx), std::logic_error,
-                   "Invalid format for mass excess !");
-      r.mx *= CLHEP::keV;
-      DT_THROW_IF (! token_to_double(mx_err_str, r.mx_err), std::logic_error,
-                   "Invalid format for mass excess error !");
-      r.mx_err *= CLHEP::keV;
-      DT_THROW_IF (! token_to_double(bea_str, r.bea), std::logic_error,
-                   "Invalid format for binding energy per nucleon !");
-      r.bea *= CLHEP::keV;
-      DT_THROW_IF (! token_to_double(bea_err_str, r.bea_err), std::logic_error,
-                   "Invalid format for binding energy per nucleon error !");
-      r.bea_err *= CLHEP::keV;
-      std::ostringstream am_oss;
-      am_oss << am_str << am_def_str;
-      double am;
-      DT_THROW_IF (! token_to_double(am_oss.str(), am), std::logic_error,
-                   "Invalid format for atomic mass !");
-      r.am = am * 1.e-6;
-      double am_err;
-      DT_THROW_IF (! token_to_double(am_err_str, am_err), std::logic_error,
-                   "Invalid format for atomic mass error !");
-      r.am_err = (am_err * 1e-6);
+      parse_ame_record(ame_line, r);
+      isotope::id iid(r.Z, r.A);
       if (devel) {
-        std::cerr << "DEVEL: materials::isotope::load_ame2003_table: "
+        std::cerr << "DEVEL: materials::isotope::load_ame_file: "
                   << "iid = '" << iid.to_string() << "' "
                   << " mx=" << r.mx / CLHEP::keV << "+/-" << r.mx_err / CLHEP::keV << " [keV]"
                   << " am=" << r.am << "+/-" << r.am_err << " [u]"
@@ -396,28 +610,7 @@ namespace materials {
       }
       if (iid.is_valid()) {
         db_[iid] = r;
-        /*
-          {
-          record_type dummy;
-          if (devel) {
-            std::cerr << "DEVEL: materials::isotope::load_ame2003_table: "
-                      << "TEST"
-                      << std::endl;
-          }
-          db_[iid] = dummy;
-        */
       }
-      /*
-        std::map<id, record_type>::iterator found = db_.find(iid);
-        if (found != db_.end()) {
-        record_type & rec = found->second;
-        rec = r;
-        if (devel) {
-        std::cerr << "Registered isotope ID = '" << iid.to_string() << "'" << std::endl;
-        rec.print(std::cerr);
-        }
-        }
-      */
     }
     if (devel) {
       std::cerr << "Registered isotopes: " << std::endl;
@@ -427,6 +620,53 @@ namespace materials {
     return;
   }
 
+  // static
+  void isotope::load_compiled_ame_table(const std::string & bin_filename_, isotope::isotope_dict_type & db_)
+  {
+    lazy_ame_table compiled(AME_RELEASE_2012);
+    DT_THROW_IF(!compiled.open_binary(bin_filename_), std::runtime_error,
+                "Cannot use the compiled AME table '" << bin_filename_ << "' !");
+    compiled.load_all(db_);
+    return;
+  }
+
+  // static
+  void isotope::compile_ame_table(const std::string & ame_filename_,
+                                  const std::string & bin_filename_)
+  {
+    isotope_dict_type db;
+    load_ame_file(ame_filename_, db);
+    ame_bin_header header;
+    std::copy(AME_BIN_MAGIC, AME_BIN_MAGIC + sizeof(AME_BIN_MAGIC), header.magic);
+    header.version = AME_BIN_VERSION;
+    header.byte_order = AME_BIN_BYTE_ORDER;
+    header.nrecords = db.size();
+    header.record_size = sizeof(ame_bin_record);
+    std::ofstream fout(bin_filename_.c_str(), std::ios::binary);
+    DT_THROW_IF(! fout, std::runtime_error, "Cannot open '" << bin_filename_ << "' !");
+    fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    // Records are stored in the (Z, A) order of the dictionary:
+    for (isotope_dict_type::const_iterator i = db.begin(); i != db.end(); i++) {
+      const record_type & r = i->second;
+      ame_bin_record bin;
+      std::fill(bin.symbol, bin.symbol + sizeof(bin.symbol), '\0');
+      DT_THROW_IF(r.symbol.size() > sizeof(bin.symbol), std::logic_error,
+                  "Invalid element symbol '" << r.symbol << "' !");
+      std::copy(r.symbol.begin(), r.symbol.end(), bin.symbol);
+      bin.z = r.Z;
+      bin.a = r.A;
+      bin.mx = r.mx;
+      bin.mx_err = r.mx_err;
+      bin.bea = r.bea;
+      bin.bea_err = r.bea_err;
+      bin.am = r.am;
+      bin.am_err = r.am_err;
+      fout.write(reinterpret_cast<const char *>(&bin), sizeof(bin));
+    }
+    DT_THROW_IF(! fout, std::runtime_error, "Cannot write '" << bin_filename_ << "' !");
+    return;
+  }
+
   // static
   void isotope::print_table_of_isotopes(const isotope_dict_type & toi_,
                                         std::ostream & out_,
@@ -486,42 +726,26 @@ namespace materials {
   // static
   const isotope::isotope_dict_type & isotope::table_of_isotopes()
   {
-    bool devel = false;
     static boost::scoped_ptr<isotope_dict_type> _TOI;
     if (! _TOI) {
-      if (devel) {
-        std::cerr << "DEVEL: materials::isotope::table_of_isotopes: "
-                  << "Instantiating the table of isotopes..."
-                  << std::endl;
-      }
       _TOI.reset(new isotope_dict_type);
       // For now we use the AME table.
-      if (devel) {
-        std::cerr << "DEVEL: materials::isotope::table_of_isotopes: "
-                  << "Loading the AME table..."
-                  << std::endl;
-      }
-      load_ame_table(*_TOI, AME_RELEASE_2012);
-      if (devel) {
-        std::cerr << "DEVEL: materials::isotope::table_of_isotopes: "
-                  << "Loaded : " << _TOI->size() << " records."
-                  << std::endl;
-      }
+      default_ame_table().load_all(*_TOI);
     }
     return *_TOI;
   }
 
   bool isotope::id_is_tabulated(const id & id_)
   {
-    return table_of_isotopes().find(id_) != table_of_isotopes().end();
+    return default_ame_table().find(id_) != nullptr;
   }
 
   const isotope::record_type & isotope::table_record_from_id(const id & id_)
   {
-    isotope_dict_type::const_iterator found = table_of_isotopes().find(id_);
-    DT_THROW_IF(found == table_of_isotopes().end(), std::logic_error,
+    const record_type * record = default_ame_table().find(id_);
+    DT_THROW_IF(record == nullptr, std::logic_error,
                 "Isotope (Z=" << id_.get_z() << ",A="<< id_.get_a() << ") is not tabulated !");
-    return found->second;
+    return *record;
   }
 
   // static
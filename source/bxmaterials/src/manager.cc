@@ -4,8 +4,10 @@
 #include <materials/manager.h>
 
 // Standard library:
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
@@ -65,6 +67,7 @@ namespace materials {
     _load_isotope_mass_data_ = true;
     _load_isotope_decay_data_ = false;
     _alias_of_alias_allowed_ = true;
+    _lazy_build_ = false;
     return;
   }
 
@@ -72,6 +75,7 @@ namespace materials {
   {
     _locked_ = false;
     _logging_priority_ = datatools::logger::PRIO_FATAL;
+    _pending_rank_ = 0;
     _set_defaults();
     return;
   }
@@ -140,6 +144,29 @@ namespace materials {
     return _alias_allow_overload_;
   }
 
+  bool manager::is_lazy_build() const
+  {
+    return _lazy_build_;
+  }
+
+  void manager::set_lazy_build(bool lb_)
+  {
+    DT_THROW_IF(is_locked(), std::logic_error, "Manager is locked !");
+    _lazy_build_ = lb_;
+    return;
+  }
+
+  std::size_t manager::get_number_of_pending_entries() const
+  {
+    return _pending_isotopes_.size() + _pending_elements_.size() + _pending_materials_.size();
+  }
+
+  void manager::build_pending_entries()
+  {
+    _resolve_all_();
+    return;
+  }
+
   bool manager::is_load_isotope_mass_data() const
   {
     return _load_isotope_mass_data_;
@@ -180,11 +207,13 @@ namespace materials {
 
   bool manager::has_isotope(const std::string & entry_name_) const
   {
-    return _isotopes_.find(entry_name_) != _isotopes_.end();
+    return _isotopes_.find(entry_name_) != _isotopes_.end()
+      || _pending_isotopes_.find(entry_name_) != _pending_isotopes_.end();
   }
 
   const isotope & manager::get_isotope(const std::string & entry_name_) const
   {
+    _resolve_(entry_name_);
     isotope_dict_type::const_iterator found = _isotopes_.find(entry_name_);
     DT_THROW_IF(found == _isotopes_.end(), std::logic_error,
                 "Cannot find isotope named '" << entry_name_ << "'!");
@@ -194,11 +223,13 @@ namespace materials {
 
   bool manager::has_element(const std::string & entry_name_) const
   {
-    return _elements_.find(entry_name_) != _elements_.end();
+    return _elements_.find(entry_name_) != _elements_.end()
+      || _pending_elements_.find(entry_name_) != _pending_elements_.end();
   }
 
   const element & manager::get_element(const std::string & entry_name_) const
   {
+    _resolve_(entry_name_);
     element_dict_type::const_iterator found = _elements_.find(entry_name_);
     DT_THROW_IF(found == _elements_.end(), std::logic_error,
                 "Cannot find element named '" << entry_name_ << "'!");
@@ -208,11 +239,13 @@ namespace materials {
 
   bool manager::has_material(const std::string & entry_name_) const
   {
-    return _materials_.find(entry_name_) != _materials_.end();
+    return _materials_.find(entry_name_) != _materials_.end()
+      || _pending_materials_.find(entry_name_) != _pending_materials_.end();
   }
 
   const material & manager::get_material(const std::string & entry_name_) const
   {
+    _resolve_(entry_name_);
     material_dict_type::const_iterator found = _materials_.find(entry_name_);
     DT_THROW_IF(found == _materials_.end(), std::logic_error,
                 "Cannot find material named '" << entry_name_ << "'!");
@@ -245,6 +278,7 @@ namespace materials {
 
   std::string manager::alias_of(const std::string & entry_name_) const
   {
+    _resolve_(entry_name_);
     material_dict_type::const_iterator found = _materials_.find(entry_name_);
     const ::materials::smart_ref<material> & sr = found->second;
     std::string mat_alias;
@@ -256,21 +290,25 @@ namespace materials {
 
   const isotope_dict_type & manager::get_isotopes() const
   {
+    _resolve_all_();
     return _isotopes_;
   }
 
   const element_dict_type & manager::get_elements() const
   {
+    _resolve_all_();
     return _elements_;
   }
 
   const material_dict_type & manager::get_materials() const
   {
+    _resolve_all_();
     return _materials_;
   }
 
   const std::list<std::string> & manager::get_ordered_materials() const
   {
+    _resolve_all_();
     return _ordered_materials_;
   }
 
@@ -310,6 +348,10 @@ namespace materials {
       set_alias_of_alias_allowed(setup_.fetch_boolean("alias_of_alias_allowed"));
     }
 
+    if (setup_.has_key("lazy_build")) {
+      set_lazy_build(setup_.fetch_boolean("lazy_build"));
+    }
+
     if (setup_.has_key("load_isotope_mass_data")) {
       set_load_isotope_mass_data(setup_.fetch_boolean("load_isotope_mass_data"));
     }
@@ -367,88 +409,246 @@ namespace materials {
       DT_THROW_IF(!manager::validate_name_for_gdml(name), std::logic_error,
                   "Proposed name '" << name << "' is not supported for GDML export !");
 
-      if (type == "isotope" || type == "materials::isotope") {
-        DT_THROW_IF(_isotopes_.find(name) != _isotopes_.end(),
-                    std::logic_error,
-                    "Isotope with name '" << name << "' already exists !");
-        isotope * iso = _creator_->create_isotope(name, props);
-        _isotopes_[iso->get_name()] = materials::smart_ref<isotope>();
-        _isotopes_[iso->get_name()].set_ref(iso);
-        DT_LOG_DEBUG(_logging_priority_, "Add new isotope = '" << iso->get_zai_name() << "'");
+      if (_lazy_build_) {
+        _declare_entry_(name, type, props);
+      } else {
+        _build_entry_(name, type, props, true);
       }
-      else if (type == "element" || type == "materials::element") {
-        DT_THROW_IF(_elements_.find(name) != _elements_.end(),
-                    std::logic_error,
-                    "Element with name '" << name << "' already exists !");
-        bool unique_element_material = false;
-        DT_THROW_IF(unique_element_material,
-                    std::logic_error,
-                    "Material with name '" << name << "' already exists !");
-        element * elmt = _creator_->create_element(name, props, _isotopes_);
-        _elements_[elmt->get_name()] = materials::smart_ref<element>();
-        _elements_[elmt->get_name()].set_ref(elmt);
-        DT_LOG_DEBUG(_logging_priority_, "Add new element = '" << elmt->get_name() << "'");
-      } else if (type == "material" || type == "materials::material") {
-        DT_THROW_IF(_materials_.find(name) != _materials_.end(),
+
+    } // for
+
+    return;
+  }
+
+  void manager::_build_entry_(const std::string & name_,
+                              const std::string & type_,
+                              const datatools::properties & config_,
+                              bool ordered_)
+  {
+    if (type_ == "isotope" || type_ == "materials::isotope") {
+      DT_THROW_IF(_isotopes_.find(name_) != _isotopes_.end(),
+                  std::logic_error,
+                  "Isotope with name '" << name_ << "' already exists !");
+      isotope * iso = _creator_->create_isotope(name_, config_);
+      _isotopes_[iso->get_name()] = materials::smart_ref<isotope>();
+      _isotopes_[iso->get_name()].set_ref(iso);
+      DT_LOG_DEBUG(_logging_priority_, "Add new isotope = '" << iso->get_zai_name() << "'");
+    }
+    else if (type_ == "element" || type_ == "materials::element") {
+      DT_THROW_IF(_elements_.find(name_) != _elements_.end(),
+                  std::logic_error,
+                  "Element with name '" << name_ << "' already exists !");
+      bool unique_element_material = false;
+      DT_THROW_IF(unique_element_material,
+                  std::logic_error,
+                  "Material with name '" << name_ << "' already exists !");
+      element * elmt = _creator_->create_element(name_, config_, _isotopes_);
+      _elements_[elmt->get_name()] = materials::smart_ref<element>();
+      _elements_[elmt->get_name()].set_ref(elmt);
+      DT_LOG_DEBUG(_logging_priority_, "Add new element = '" << elmt->get_name() << "'");
+    } else if (type_ == "material" || type_ == "materials::material") {
+      DT_THROW_IF(_materials_.find(name_) != _materials_.end(),
+                  std::logic_error,
+                  "Material with name '" << name_ << "' already exists !");
+      bool unique_element_material = false;
+      if (unique_element_material) {
+        DT_THROW_IF(_elements_.find(name_) != _elements_.end(),
                     std::logic_error,
-                    "Material with name '" << name << "' already exists !");
-        bool unique_element_material = false;
-        if (unique_element_material) {
-          DT_THROW_IF(_elements_.find(name) != _elements_.end(),
-                      std::logic_error,
-                      "Element with name '" << name << "' already exists !");
-        }
-        material * matl = _creator_->create_material(name,
-                                                     props,
-                                                     _elements_,
-                                                     _materials_);
-        _materials_[matl->get_name()] = materials::smart_ref<material>();
-        _materials_[matl->get_name()].set_ref(matl);
-        DT_LOG_DEBUG(_logging_priority_, "Add new material = '" << matl->get_name() << "'");
+                    "Element with name '" << name_ << "' already exists !");
+      }
+      material * matl = _creator_->create_material(name_,
+                                                   config_,
+                                                   _elements_,
+                                                   _materials_);
+      _materials_[matl->get_name()] = materials::smart_ref<material>();
+      _materials_[matl->get_name()].set_ref(matl);
+      DT_LOG_DEBUG(_logging_priority_, "Add new material = '" << matl->get_name() << "'");
+      if (ordered_) {
         _ordered_materials_.push_back(matl->get_name());
-      } else if (type == "alias" || type == "materials::material_alias") {
-        material_dict_type::const_iterator mat_found = _materials_.find(name);
-        if (mat_found != _materials_.end()) {
-          const smart_ref<material> & sref = mat_found->second;
-          DT_THROW_IF(! sref.is_alias(),
-                      std::logic_error,
-                      "Material with name '" << name
-                      << "' already exists ! It cannot be overloaded !");
-          // Already existing material alias:
-          DT_THROW_IF(! is_alias_allow_overload(),
-                      std::logic_error,
-                      "Alias with name '" << name << "' cannot be overloaded !");
-          DT_LOG_WARNING(_logging_priority_, "Redefinition of alias '" << name << "' !");
-        }
-        DT_THROW_IF(! props.has_key("material"),
-                    std::logic_error,
-                    "Missing property 'material' for a material alias with name '" << name << "'!");
-        std::string alias_material = props.fetch_string("material");
-        DT_THROW_IF(alias_material == name, std::logic_error,
-                    "Material alias named '" << alias_material << "' cannot reference itself !");
-        material_dict_type::iterator found = _materials_.find(alias_material);
-        DT_THROW_IF(found == _materials_.end(),
+      }
+    } else if (type_ == "alias" || type_ == "materials::material_alias") {
+      material_dict_type::const_iterator mat_found = _materials_.find(name_);
+      if (mat_found != _materials_.end()) {
+        const smart_ref<material> & sref = mat_found->second;
+        DT_THROW_IF(! sref.is_alias(),
                     std::logic_error,
-                    "Aliased material named '" << alias_material << "' does not exist !");
-        DT_THROW_IF(!_alias_of_alias_allowed_ && found->second.is_alias(),
+                    "Material with name '" << name_
+                    << "' already exists ! It cannot be overloaded !");
+        // Already existing material alias:
+        DT_THROW_IF(! is_alias_allow_overload(),
                     std::logic_error,
-                    "Material alias with name '" << name
-                    << "' cannot refer to another material alias '" << alias_material << "' !");
-        _materials_[name] = materials::smart_ref<material>();
-        _materials_[name].set_ref(found->second.grab_ref());
-        _materials_[name].set_alias_of(alias_material);
+                    "Alias with name '" << name_ << "' cannot be overloaded !");
+        DT_LOG_WARNING(_logging_priority_, "Redefinition of alias '" << name_ << "' !");
+      }
+      DT_THROW_IF(! config_.has_key("material"),
+                  std::logic_error,
+                  "Missing property 'material' for a material alias with name '" << name_ << "'!");
+      std::string alias_material = config_.fetch_string("material");
+      DT_THROW_IF(alias_material == name_, std::logic_error,
+                  "Material alias named '" << alias_material << "' cannot reference itself !");
+      material_dict_type::iterator found = _materials_.find(alias_material);
+      DT_THROW_IF(found == _materials_.end(),
+                  std::logic_error,
+                  "Aliased material named '" << alias_material << "' does not exist !");
+      DT_THROW_IF(!_alias_of_alias_allowed_ && found->second.is_alias(),
+                  std::logic_error,
+                  "Material alias with name '" << name_
+                  << "' cannot refer to another material alias '" << alias_material << "' !");
+      _materials_[name_] = materials::smart_ref<material>();
+      _materials_[name_].set_ref(found->second.grab_ref());
+      _materials_[name_].set_alias_of(alias_material);
+      if (ordered_) {
         std::list<std::string>::iterator ofound = std::find(_ordered_materials_.begin(),
                                                             _ordered_materials_.end(),
-                                                            name);
+                                                            name_);
         if (ofound != _ordered_materials_.end()) {
           _ordered_materials_.erase(ofound);
         }
-        _ordered_materials_.push_back(name);
-        DT_LOG_DEBUG(_logging_priority_, "Add new material alias = '" << name << "' for material '" << alias_material << "'");
+        _ordered_materials_.push_back(name_);
       }
+      DT_LOG_DEBUG(_logging_priority_, "Add new material alias = '" << name_ << "' for material '" << alias_material << "'");
+    }
+    return;
+  }
 
-    } // for
+  void manager::_declare_entry_(const std::string & name_,
+                                const std::string & type_,
+                                const datatools::properties & config_)
+  {
+    pending_dict_type * pending = 0;
+    if (type_ == "isotope" || type_ == "materials::isotope") {
+      DT_THROW_IF(has_isotope(name_), std::logic_error,
+                  "Isotope with name '" << name_ << "' already exists !");
+      pending = &_pending_isotopes_;
+    } else if (type_ == "element" || type_ == "materials::element") {
+      DT_THROW_IF(has_element(name_), std::logic_error,
+                  "Element with name '" << name_ << "' already exists !");
+      pending = &_pending_elements_;
+    } else if (type_ == "material" || type_ == "materials::material") {
+      DT_THROW_IF(has_material(name_), std::logic_error,
+                  "Material with name '" << name_ << "' already exists !");
+      pending = &_pending_materials_;
+      _ordered_materials_.push_back(name_);
+    } else if (type_ == "alias" || type_ == "materials::material_alias") {
+      if (has_material(name_)) {
+        bool overloaded_alias = false;
+        material_dict_type::iterator mat_found = _materials_.find(name_);
+        if (mat_found != _materials_.end()) {
+          overloaded_alias = mat_found->second.is_alias();
+        } else {
+          const std::string & ptype = _pending_materials_.find(name_)->second.type;
+          overloaded_alias = (ptype == "alias" || ptype == "materials::material_alias");
+        }
+        DT_THROW_IF(! overloaded_alias,
+                    std::logic_error,
+                    "Material with name '" << name_
+                    << "' already exists ! It cannot be overloaded !");
+        DT_THROW_IF(! is_alias_allow_overload(),
+                    std::logic_error,
+                    "Alias with name '" << name_ << "' cannot be overloaded !");
+        DT_LOG_WARNING(_logging_priority_, "Redefinition of alias '" << name_ << "' !");
+        if (mat_found != _materials_.end()) {
+          _materials_.erase(mat_found);
+        }
+        _pending_materials_.erase(name_);
+      }
+      DT_THROW_IF(! config_.has_key("material"),
+                  std::logic_error,
+                  "Missing property 'material' for a material alias with name '" << name_ << "'!");
+      const std::string alias_material = config_.fetch_string("material");
+      DT_THROW_IF(alias_material == name_, std::logic_error,
+                  "Material alias named '" << alias_material << "' cannot reference itself !");
+      DT_THROW_IF(! has_material(alias_material),
+                  std::logic_error,
+                  "Aliased material named '" << alias_material << "' does not exist !");
+      pending = &_pending_materials_;
+      std::list<std::string>::iterator ofound = std::find(_ordered_materials_.begin(),
+                                                          _ordered_materials_.end(),
+                                                          name_);
+      if (ofound != _ordered_materials_.end()) {
+        _ordered_materials_.erase(ofound);
+      }
+      _ordered_materials_.push_back(name_);
+    }
+    if (pending != 0) {
+      pending_entry & entry = (*pending)[name_];
+      entry.type = type_;
+      entry.config = config_;
+      entry.rank = _pending_rank_++;
+      DT_LOG_DEBUG(_logging_priority_, "Declare " << type_ << " '" << name_ << "'");
+    }
+    return;
+  }
+
+  void manager::_build_pending_(pending_dict_type & pending_, const std::string & name_)
+  {
+    pending_dict_type::iterator found = pending_.find(name_);
+    if (found == pending_.end()) return;
+    // Removing the entry first protects against circular references:
+    const pending_entry entry = found->second;
+    pending_.erase(found);
+    const std::string & type = entry.type;
+    const datatools::properties & config = entry.config;
+    std::vector<std::string> deps;
+    if (type == "element" || type == "materials::element") {
+      if (config.has_key("isotope.names")) {
+        config.fetch("isotope.names", deps);
+      }
+      for (const std::string & dep : deps) {
+        _build_pending_(_pending_isotopes_, dep);
+      }
+    } else if (type == "material" || type == "materials::material") {
+      if (config.has_key("composition.names")) {
+        config.fetch("composition.names", deps);
+      }
+      if (config.has_key("doping.doping_elements")) {
+        std::vector<std::string> doping_elements;
+        config.fetch("doping.doping_elements", doping_elements);
+        deps.insert(deps.end(), doping_elements.begin(), doping_elements.end());
+      }
+      if (config.has_key("doping.doped_material")) {
+        deps.push_back(config.fetch_string("doping.doped_material"));
+      }
+      // Compositions may refer to elements or materials:
+      for (const std::string & dep : deps) {
+        _build_pending_(_pending_elements_, dep);
+        _build_pending_(_pending_materials_, dep);
+      }
+    } else if (type == "alias" || type == "materials::material_alias") {
+      _build_pending_(_pending_materials_, config.fetch_string("material"));
+    }
+    DT_LOG_DEBUG(_logging_priority_, "Build pending " << type << " '" << name_ << "'");
+    _build_entry_(name_, type, config, false);
+    return;
+  }
+
+  void manager::_resolve_(const std::string & name_) const
+  {
+    if (get_number_of_pending_entries() == 0) return;
+    manager * mutable_this = const_cast<manager *>(this);
+    mutable_this->_build_pending_(mutable_this->_pending_isotopes_, name_);
+    mutable_this->_build_pending_(mutable_this->_pending_elements_, name_);
+    mutable_this->_build_pending_(mutable_this->_pending_materials_, name_);
+    return;
+  }
 
+  void manager::_resolve_all_() const
+  {
+    if (get_number_of_pending_entries() == 0) return;
+    manager * mutable_this = const_cast<manager *>(this);
+    // Collect the pending entries and build them in their order of declaration:
+    std::map<std::size_t, std::pair<pending_dict_type *, std::string> > ranked;
+    pending_dict_type * dicts[3] = { &mutable_this->_pending_isotopes_,
+                                     &mutable_this->_pending_elements_,
+                                     &mutable_this->_pending_materials_ };
+    for (pending_dict_type * dict : dicts) {
+      for (const auto & p : *dict) {
+        ranked[p.second.rank] = std::make_pair(dict, p.first);
+      }
+    }
+    for (const auto & r : ranked) {
+      mutable_this->_build_pending_(*r.second.first, r.second.second);
+    }
     return;
   }
 
@@ -459,6 +659,10 @@ namespace materials {
     _materials_.clear();
     _elements_.clear();
     _isotopes_.clear();
+    _pending_materials_.clear();
+    _pending_elements_.clear();
+    _pending_isotopes_.clear();
+    _pending_rank_ = 0;
     _creator_.reset();
     _material_exported_prefixes_.clear();
     _set_defaults();
@@ -491,6 +695,11 @@ namespace materials {
     out_ << indent << datatools::i_tree_dumpable::tag
          << "Alias of alias allowed : " << is_alias_of_alias_allowed() << std::endl;
 
+    out_ << indent << datatools::i_tree_dumpable::tag
+         << "Lazy build : " << is_lazy_build() << std::endl;
+
+    _resolve_all_();
+
     out_ << indent << datatools::i_tree_dumpable::tag
          << "Material exported property prefixes : " << std::endl;
     for (std::set<std::string>::const_iterator i = _material_exported_prefixes_.begin();
@@ -770,6 +979,30 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(::materials::manager,ocd_)
       ;
   }
 
+  {
+    configuration_property_description & cpd = ocd_.add_configuration_property_info();
+    cpd.set_name_pattern("lazy_build")
+      .set_terse_description("Flag to build isotopes, elements and materials on first lookup")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_default_value_boolean(false)
+      .set_long_description("When set, the isotopes, elements and materials loaded from  \n"
+                            "the configuration files are only declared at initialization\n"
+                            "and are built, with their dependencies, the first time they\n"
+                            "are looked up by name. Accessing the full dictionaries      \n"
+                            "builds all pending entries.                                 \n"
+                            "                                                            \n"
+                            "Superseded by a previous call of :                          \n"
+                            "``materials::manager::set_lazy_build(true)``                \n"
+                            )
+      .add_example("This example activates the lazy build mode::    \n"
+                   "                                                \n"
+                   "  lazy_build : boolean = 1                      \n"
+                   "                                                \n"
+                   )
+      ;
+  }
+
   {
     configuration_property_description & cpd = ocd_.add_configuration_property_info();
     cpd.set_name_pattern("material_exported_prefixes")
@@ -0,0 +1,91 @@
+// test_isotope_table.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+#include <stdexcept>
+
+// Third Party:
+// - Boost:
+#include <boost/filesystem.hpp>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+
+// This project:
+#include <materials/isotope.h>
+#include <materials/resource.h>
+
+namespace {
+
+  bool same_record(const materials::isotope::record_type & r1_,
+                   const materials::isotope::record_type & r2_)
+  {
+    return r1_.symbol == r2_.symbol
+      && r1_.Z == r2_.Z
+      && r1_.A == r2_.A
+      && r1_.mx == r2_.mx
+      && r1_.mx_err == r2_.mx_err
+      && r1_.bea == r2_.bea
+      && r1_.bea_err == r2_.bea_err
+      && r1_.am == r2_.am
+      && r1_.am_err == r2_.am_err;
+  }
+
+}
+
+int main (int /*argc_*/, char ** /*argv_*/)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the lazy table of isotopes!" << std::endl;
+
+    // Lookups decode only the requested records:
+    const materials::isotope::id he6(2, 6);
+    DT_THROW_IF(!materials::isotope::id_is_tabulated(he6), std::logic_error, "He-6 is not tabulated!");
+    DT_THROW_IF(materials::isotope::id_is_tabulated(materials::isotope::id(1, 250)),
+                std::logic_error, "H-250 is tabulated!");
+    const materials::isotope::record_type & he6_rec = materials::isotope::table_record_from_id(he6);
+    DT_THROW_IF(&he6_rec != &materials::isotope::table_record_from_id(he6), std::logic_error,
+                "Records are decoded twice!");
+    he6_rec.tree_dump(std::clog, "He-6: ");
+
+    // Reference table parsed from the AME data file:
+    materials::isotope::isotope_dict_type ame;
+    const std::string ame_filename = materials::get_resource("data/mass.mas12", true);
+    materials::isotope::load_ame_file(ame_filename, ame);
+    std::clog << "Number of isotopes : " << ame.size() << std::endl;
+    DT_THROW_IF(ame.size() < 3000, std::logic_error, "Missing isotopes!");
+    for (const auto & entry : ame) {
+      DT_THROW_IF(!same_record(materials::isotope::table_record_from_id(entry.first), entry.second),
+                  std::logic_error, "Unmatching record for isotope '" << entry.first.to_string() << "'!");
+    }
+
+    // Compiled table:
+    const std::string bin_filename = "test_isotope_table.bin";
+    materials::isotope::compile_ame_table(ame_filename, bin_filename);
+    DT_THROW_IF(boost::filesystem::file_size(bin_filename) >= boost::filesystem::file_size(ame_filename),
+                std::logic_error, "Compiled table is larger than the AME data file!");
+    materials::isotope::isotope_dict_type compiled;
+    materials::isotope::load_compiled_ame_table(bin_filename, compiled);
+    DT_THROW_IF(compiled.size() != ame.size(), std::logic_error, "Invalid number of compiled isotopes!");
+    for (const auto & entry : ame) {
+      DT_THROW_IF(!same_record(compiled[entry.first], entry.second),
+                  std::logic_error, "Unmatching compiled record for isotope '" << entry.first.to_string() << "'!");
+    }
+    boost::filesystem::remove(bin_filename);
+
+    std::clog << "The end." << std::endl;
+  }
+  catch (std::exception & x) {
+    std::cerr << "error: " << x.what () << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
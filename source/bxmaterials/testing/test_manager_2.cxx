@@ -13,6 +13,7 @@
 
 // Third party:
 // - Bayeux/datatools:
+#include <datatools/exception.h>
 #include <datatools/utils.h>
 #include <datatools/multi_properties.h>
 
@@ -56,6 +57,41 @@ int main (int /* argc_ */, char ** /* argv_ */)
     MatMgr.initialize (MatMgrSetup);
     MatMgr.tree_dump (std::clog, "Material manager: ");
 
+    {
+      // Lazy build of the same isotopes, elements and materials:
+      materials::manager LazyMatMgr;
+      datatools::properties LazyMatMgrSetup = MatMgrSetup;
+      LazyMatMgrSetup.store_flag("lazy_build");
+      LazyMatMgr.initialize (LazyMatMgrSetup);
+      std::clog << "Number of pending entries : " << LazyMatMgr.get_number_of_pending_entries() << std::endl;
+      DT_THROW_IF(LazyMatMgr.get_number_of_pending_entries() == 0, std::logic_error,
+                  "No pending entry in lazy build mode!");
+      // A single lookup builds a doped material with its dependencies only:
+      DT_THROW_IF(!LazyMatMgr.has_material("DopedSilicium"), std::logic_error, "Missing material!");
+      const materials::material & lazyMat = LazyMatMgr.get_material("DopedSilicium");
+      const materials::material & eagerMat = MatMgr.get_material("DopedSilicium");
+      DT_THROW_IF(lazyMat.get_density() != eagerMat.get_density(), std::logic_error,
+                  "Unmatching lazily built material!");
+      DT_THROW_IF(LazyMatMgr.get_number_of_pending_entries() == 0, std::logic_error,
+                  "Unexpected build of all pending entries!");
+      // Full dictionaries:
+      DT_THROW_IF(LazyMatMgr.get_ordered_materials() != MatMgr.get_ordered_materials(), std::logic_error,
+                  "Unmatching ordered lists of materials!");
+      DT_THROW_IF(LazyMatMgr.get_number_of_pending_entries() != 0, std::logic_error,
+                  "Remaining pending entries!");
+      DT_THROW_IF(LazyMatMgr.get_isotopes().size() != MatMgr.get_isotopes().size()
+                  || LazyMatMgr.get_elements().size() != MatMgr.get_elements().size()
+                  || LazyMatMgr.get_materials().size() != MatMgr.get_materials().size(),
+                  std::logic_error, "Unmatching dictionaries!");
+      for (const auto & m : MatMgr.get_materials()) {
+        DT_THROW_IF(LazyMatMgr.alias_of(m.first) != MatMgr.alias_of(m.first), std::logic_error,
+                    "Unmatching alias '" << m.first << "'!");
+        DT_THROW_IF(LazyMatMgr.get_material(m.first).get_density() != m.second.get_ref().get_density(),
+                    std::logic_error, "Unmatching material '" << m.first << "'!");
+      }
+      std::clog << "Lazy and eager builds match." << std::endl;
+    }
+
   }
   catch (std::exception & x) {
     std::cerr << "error: " << x.what () << std::endl;
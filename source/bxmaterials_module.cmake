@@ -77,6 +77,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_element.cxx
   ${module_test_dir}/test_factory.cxx
   ${module_test_dir}/test_isotope.cxx
+  ${module_test_dir}/test_isotope_table.cxx
   ${module_test_dir}/test_manager_2.cxx
   ${module_test_dir}/test_manager.cxx
   ${module_test_dir}/test_material.cxx
@@ -90,6 +91,13 @@ set(${module_name}_MODULE_TESTS
 set(${module_name}_MODULE_APPS
   ${module_app_dir}/materials_inspector.cxx
   ${module_app_dir}/materials_diagnose.cxx
+  ${module_app_dir}/materials_compile_ame.cxx
+  )
+
+# - Compiled resource files (built by the bxmaterials_compile_ame application)
+set(${module_name}_MODULE_COMPILED_RESOURCES
+  data/mass.mas03
+  data/mass.mas12
   )
 
 # - Resource files
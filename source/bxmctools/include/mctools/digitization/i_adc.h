@@ -29,7 +29,9 @@
 #ifndef MCTOOLS_DIGITIZATION_I_ADC_H
 #define MCTOOLS_DIGITIZATION_I_ADC_H
 
-// This project:
+// Standard library:
+#include <cstddef>
+#include <cstdint>
 
 namespace mctools {
 
@@ -49,6 +51,17 @@ namespace mctools {
       //! Quantize
       virtual int32_t quantize(const double vinput_) const = 0;
 
+      //! Quantize an array of input voltages: channels_[i] = quantize(vinputs_[i]), i in [0, n_)
+      virtual void quantize_many(const double * vinputs_,
+                                 const std::size_t n_,
+                                 int32_t * channels_) const
+      {
+        for (std::size_t i = 0; i < n_; i++) {
+          channels_[i] = quantize(vinputs_[i]);
+        }
+        return;
+      }
+
       //! Reflection interface
       DR_CLASS_RTTI()
 
@@ -171,6 +171,11 @@ namespace mctools {
       //! Return a const reference to the array of samples
       const std::vector<int32_t> & get_samples() const;
 
+      //! Return a mutable reference to the array of samples
+      //!
+      //! The update() method must be invoked once the samples have been modified.
+      std::vector<int32_t> & grab_samples();
+
       //! Set the sample value at given time index
       void set_sample(const uint32_t index_, const int32_t sample_, const bool update_ = false);
 
@@ -0,0 +1,171 @@
+/// \file mctools/digitization/sampled_signal_builder.h
+/* Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Description:
+ *
+ *   Builder of sampled signals from analog signal shapes and an ADC.
+ *
+ */
+
+#ifndef MCTOOLS_DIGITIZATION_SAMPLED_SIGNAL_BUILDER_H
+#define MCTOOLS_DIGITIZATION_SAMPLED_SIGNAL_BUILDER_H
+
+// Standard library:
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+#include <datatools/i_tree_dump.h>
+// - Bayeux/mygsl:
+#include <mygsl/i_unary_function.h>
+
+// This project:
+#include <mctools/digitization/i_adc.h>
+#include <mctools/digitization/sampled_signal.h>
+
+namespace mctools {
+
+  namespace digitization {
+
+    //! \brief Builder of sampled signals from analog signal shapes
+    /**
+     *  The analog signal shape is sampled in one batch on the regular time
+     *  grid t[i] = time_origin + i / sampling_frequency, then the voltages are
+     *  digitized in one batch by the ADC. Working buffers are reused from one
+     *  call to another so that the building of thousands of channels per event
+     *  does not allocate memory. A builder instance must not be shared by
+     *  several threads.
+     *
+     * @code
+     * mctools::digitization::simple_linear_adc adc;
+     * ...
+     * mctools::digitization::sampled_signal_builder builder;
+     * builder.set_adc(adc);
+     * builder.set_sampling_frequency(2.0 * CLHEP::gigahertz);
+     * builder.set_number_of_samples(1024);
+     * builder.initialize_simple();
+     * mctools::digitization::sampled_signal ssig;
+     * builder.build(shape, ssig);
+     * @endcode
+     */
+    class sampled_signal_builder
+      : public datatools::i_tree_dumpable
+    {
+    public:
+
+      //! Default constructor
+      sampled_signal_builder();
+
+      //! Destructor
+      ~sampled_signal_builder() override;
+
+      //! Set the ADC
+      void set_adc(const i_adc &);
+
+      //! Check if the ADC is set
+      bool has_adc() const;
+
+      //! Return the ADC
+      const i_adc & get_adc() const;
+
+      //! Set the sampling frequency
+      void set_sampling_frequency(const double);
+
+      //! Return the sampling frequency
+      double get_sampling_frequency() const;
+
+      //! Set the number of samples
+      void set_number_of_samples(const std::size_t);
+
+      //! Return the number of samples
+      std::size_t get_number_of_samples() const;
+
+      //! Set the time of the first sample
+      void set_time_origin(const double);
+
+      //! Return the time of the first sample
+      double get_time_origin() const;
+
+      //! Check the initialization flag
+      bool is_initialized() const;
+
+      //! Initialization
+      void initialize_simple();
+
+      //! Initialization
+      void initialize(const datatools::properties & config_);
+
+      //! Reset
+      void reset();
+
+      //! Sample the analog signal shape (voltage) on the builder's time grid
+      void sample(const mygsl::i_unary_function & shape_,
+                  std::vector<double> & voltages_) const;
+
+      //! Build the sampled signal associated to an analog signal shape
+      void build(const mygsl::i_unary_function & shape_,
+                 sampled_signal & target_);
+
+      //! Build the sampled signal associated to a list of superimposed analog signal shapes
+      void build(const std::vector<const mygsl::i_unary_function *> & shapes_,
+                 sampled_signal & target_);
+
+      //! Smart print
+      void tree_dump(std::ostream & out_         = std::clog,
+                     const std::string & title_  = "",
+                     const std::string & indent_ = "",
+                     bool inherit_               = false) const override;
+
+    protected:
+
+      //! Set default attributes values
+      void _set_defaults();
+
+      //! Digitize the working buffer of voltages into the target sampled signal
+      void _digitize(sampled_signal & target_);
+
+    private:
+
+      // Management:
+      bool _initialized_ = false; ///< Initialization flag
+
+      // Configuration:
+      const i_adc * _adc_ = nullptr; ///< Handle to the ADC
+      double _sampling_frequency_;   ///< Sampling frequency
+      std::size_t _number_of_samples_ = 0; ///< Number of samples
+      double _time_origin_;          ///< Time of the first sample
+
+      // Working data:
+      std::vector<double> _voltages_; ///< Working buffer of sampled voltages
+      std::vector<double> _buffer_;   ///< Working buffer for superimposed shapes
+
+    };
+
+  } // end of namespace digitization
+
+} // end of namespace mctools
+
+#endif // MCTOOLS_DIGITIZATION_SAMPLED_SIGNAL_BUILDER_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
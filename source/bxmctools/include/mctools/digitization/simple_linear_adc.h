@@ -125,6 +125,11 @@ namespace mctools {
       //! Quantize
       int32_t quantize(const double vinput_) const override;
 
+      //! Quantize an array of input voltages
+      void quantize_many(const double * vinputs_,
+                         const std::size_t n_,
+                         int32_t * channels_) const override;
+
       //! Return the minimum channel
       int32_t get_min_channel() const;
 
@@ -137,6 +137,14 @@ namespace mctools {
 
       void set_emfield_geom_plugin_name(const std::string & fpn_);
 
+      /// Print the usage statistics of the electromagnetic field caches
+      void print_em_field_statistics(std::ostream & out_ = std::clog,
+                                     std::size_t nevents_ = 0,
+                                     const std::string & indent_ = "") const;
+
+      /// Reset the usage statistics of the electromagnetic field caches
+      void reset_em_field_statistics();
+
       /// G4 interface
       G4VPhysicalVolume * Construct() override;
 
@@ -225,6 +233,8 @@ namespace mctools {
       std::string _gdml_schema_;
       bool        _gdml_validation_;
       std::string _gdml_filename_;
+      bool        _gdml_cache_ = false;          //!< Flag to reuse a cached GDML file if the geometry is unchanged
+      unsigned int _gdml_export_threads_ = 0;    //!< Number of threads used by the GDML export (0: number of hardware threads)
 
       // Visualization:
       bool   _using_vis_attributes_ = true;
@@ -30,6 +30,7 @@
 
 // This project:
 #include <mctools/g4/loggable_support.h>
+#include <mctools/g4/em_field_cache.h>
 
 // Forward class declarations:
 namespace datatools {
@@ -110,6 +111,12 @@ namespace mctools {
       /// Initialization
       void initialize();
 
+      /// Return the cache of field values
+      const em_field_cache & get_cache() const;
+
+      /// Return the mutable cache of field values
+      em_field_cache & grab_cache();
+
       /// Reset
       void reset();
 
@@ -137,6 +144,7 @@ namespace mctools {
       bool                                        _field_check_pos_time_; //!< Flag for checking position/time
       geomtools::vector_3d                        _standalone_constant_mag_field_; //!< Standalone uniform magnetic field
       geomtools::vector_3d                        _standalone_constant_electric_field_; //!< Standalone uniform electric field
+      em_field_cache                              _cache_; //!< Cache of field values
 
       friend class detector_construction;
 
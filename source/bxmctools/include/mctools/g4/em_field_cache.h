@@ -0,0 +1,191 @@
+/// \file mctools/g4/em_field_cache.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * Description:
+ *
+ *   Cache of electromagnetic field values for the Geant4 field interfaces
+ *
+ * History:
+ *
+ */
+
+#ifndef MCTOOLS_G4_EM_FIELD_CACHE_H
+#define MCTOOLS_G4_EM_FIELD_CACHE_H 1
+
+// Standard library:
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Forward class declarations:
+namespace datatools {
+  class properties;
+}
+
+namespace mctools {
+
+  namespace g4 {
+
+    /// \brief Cache of electromagnetic field values
+    ///
+    /// Geant4 Runge-Kutta steppers query the field at many nearly identical
+    /// points during each step. This cache keeps the last field values
+    /// computed by each thread and reuses them for any query located within
+    /// a spatial tolerance of an already computed point. The default tolerance
+    /// is zero, so that only exact repeated queries are served from the cache.
+    ///
+    /// Optionally, a static field can be sampled at initialization on a
+    /// regular grid covering a box (in global coordinates). Queries inside
+    /// the box are then computed by trilinear interpolation of the field
+    /// values at the grid nodes. This is intended for slowly varying fields.
+    ///
+    /// Configuration:
+    /// \code
+    /// cache.enabled          : boolean = true
+    /// cache.tolerance        : real as length = 0.01 um
+    /// cache.time_tolerance   : real as time = 0.0 ns
+    /// grid.length_unit       : string = "mm"
+    /// grid.min               : real[3] = -100.0 -100.0 -100.0
+    /// grid.max               : real[3] =  100.0  100.0  100.0
+    /// grid.step              : real as length = 5 mm
+    /// \endcode
+    class em_field_cache
+    {
+    public:
+
+      /// \brief Usage statistics
+      struct stats_type
+      {
+        std::size_t calls = 0;       //!< Number of field queries
+        std::size_t cache_hits = 0;  //!< Number of queries served from the cache
+        std::size_t grid_hits = 0;   //!< Number of queries served from the grid
+        std::size_t evaluations = 0; //!< Number of evaluations of the field
+
+        /// Return the fraction of queries served without evaluating the field
+        double hit_rate() const;
+      };
+
+      /// \brief Evaluation of the field at a given position/time, returns false for an invalid position/time
+      typedef std::function<bool(const double position_[4], double * field_)> evaluator_type;
+
+      /// Maximum number of field components
+      static const unsigned int MAX_COMPONENTS = 6;
+
+      /// Default constructor
+      em_field_cache();
+
+      /// Destructor
+      ~em_field_cache();
+
+      /// Return the number of field components
+      unsigned int get_number_of_components() const;
+
+      /// Set the number of field components (3: magnetic field, 6: electromagnetic field)
+      void set_number_of_components(unsigned int);
+
+      /// Check the flag for a time dependent field
+      bool is_time_dependent() const;
+
+      /// Set the flag for a time dependent field
+      void set_time_dependent(bool);
+
+      /// Check if the cache is enabled
+      bool is_enabled() const;
+
+      /// Set the flag to enable the cache
+      void set_enabled(bool);
+
+      /// Return the spatial tolerance
+      double get_tolerance() const;
+
+      /// Set the spatial tolerance
+      void set_tolerance(double);
+
+      /// Return the time tolerance
+      double get_time_tolerance() const;
+
+      /// Set the time tolerance
+      void set_time_tolerance(double);
+
+      /// Configure the cache from a set of properties
+      void configure(const datatools::properties & config_);
+
+      /// Check if a grid is requested
+      bool has_grid_box() const;
+
+      /// Check if the grid is built
+      bool has_grid() const;
+
+      /// Sample the field on the grid
+      void build_grid(const evaluator_type & evaluator_);
+
+      /// Search for the field at given position/time, returns false if the field must be evaluated
+      bool find(const double position_[4], double * field_) const;
+
+      /// Store the evaluated field at given position/time
+      void store(const double position_[4], const double * field_) const;
+
+      /// Return the usage statistics
+      stats_type get_stats() const;
+
+      /// Reset the usage statistics
+      void reset_stats();
+
+      /// Reset the cache
+      void reset();
+
+      /// Print the usage statistics (number of events is used to compute per event rates if not zero)
+      void print_stats(std::ostream & out_ = std::clog,
+                       std::size_t nevents_ = 0,
+                       const std::string & indent_ = "") const;
+
+    private:
+
+      /// Interpolate the field from the grid
+      bool _interpolate_(const double position_[4], double * field_) const;
+
+      /// Return the index of a grid node
+      std::size_t _node_index_(std::size_t i_, std::size_t j_, std::size_t k_) const;
+
+    private:
+
+      unsigned long _id_;                //!< Unique identifier of the cache
+      unsigned int  _ncomponents_;       //!< Number of field components
+      bool          _time_dependent_;    //!< Flag for a time dependent field
+      bool          _enabled_;           //!< Flag to enable the cache
+      double        _tolerance_;         //!< Spatial tolerance
+      double        _time_tolerance_;    //!< Time tolerance
+      double        _grid_min_[3];       //!< Lower corner of the grid box
+      double        _grid_max_[3];       //!< Upper corner of the grid box
+      double        _grid_step_[3];      //!< Grid steps
+      std::size_t   _grid_nodes_[3];     //!< Number of grid nodes per axis
+      std::vector<double> _grid_values_; //!< Field values at the grid nodes
+      std::vector<char>   _grid_valid_;  //!< Validity of the field at the grid nodes
+
+      // Statistics:
+      mutable std::atomic<std::size_t> _calls_;       //!< Number of field queries
+      mutable std::atomic<std::size_t> _cache_hits_;  //!< Number of queries served from the cache
+      mutable std::atomic<std::size_t> _grid_hits_;   //!< Number of queries served from the grid
+      mutable std::atomic<std::size_t> _evaluations_; //!< Number of evaluations of the field
+
+    };
+
+  } // end of namespace g4
+
+} // end of namespace mctools
+
+#endif // MCTOOLS_G4_EM_FIELD_CACHE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -42,6 +42,7 @@ namespace mctools {
     // Forward class declarations:
     class magnetic_field;
     class electromagnetic_field;
+    class em_field_cache;
 
     /// \brief Working data for G4 EM field handling
     class em_field_g4_stuff :
@@ -107,6 +108,12 @@ namespace mctools {
       /// Return the nale of the embedded G4 EM field
       std::string get_g4_field_name() const;
 
+      /// Return the cache of field values of the embedded G4 EM field
+      const em_field_cache & get_g4_field_cache() const;
+
+      /// Reset the usage statistics of the cache of field values
+      void reset_g4_field_cache_statistics();
+
       /// Return the stepper type
       stepper_type get_stepper_type() const;
 
@@ -29,6 +29,7 @@
 
 // This project:
 #include <mctools/g4/loggable_support.h>
+#include <mctools/g4/em_field_cache.h>
 
 namespace datatools {
   class properties;
@@ -108,6 +109,12 @@ namespace mctools {
       /// Initialization
       void initialize ();
 
+      /// Return the cache of field values
+      const em_field_cache & get_cache() const;
+
+      /// Return the mutable cache of field values
+      em_field_cache & grab_cache();
+
       /// Reset
       void reset();
 
@@ -130,6 +137,7 @@ namespace mctools {
       const emfield::base_electromagnetic_field    * _field_;
       bool                                           _field_check_pos_time_;
       geomtools::vector_3d                           _standalone_constant_field_;
+      em_field_cache                                 _cache_; //!< Cache of field values
 
       friend class detector_construction;
 
@@ -218,6 +218,9 @@ namespace mctools {
       /// Return a mutable event_action reference
       event_action& grab_user_event_action();
 
+      /// Return a mutable detector_construction reference
+      detector_construction& grab_user_detector_construction();
+
       // Run
       /// Return the number of events to be generated
       uint32_t get_number_of_events() const;
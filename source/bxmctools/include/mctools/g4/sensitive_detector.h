@@ -27,6 +27,7 @@
 #include <boost/cstdint.hpp>
 // - Bayeux/datatools :
 #include <datatools/properties.h>
+#include <datatools/time_tools.h>
 
 // For C++11 support, remove once Bayeux is c++11/Geant4 10.2 only
 #ifdef __clang__
@@ -63,6 +64,36 @@ namespace mctools {
       /// Dictionary of step hit processors' addresses
       typedef std::map<std::string, mctools::base_step_hit_processor *> hit_processor_dict_type;
 
+      /// \brief Table of names interned from the addresses of Geant4 objects
+      ///
+      /// Particle definitions, materials and processes are singletons in Geant4,
+      /// so their addresses identify them. The few distinct entries seen during
+      /// an event are given small integer IDs, so that no string is copied per step.
+      class name_table
+      {
+      public:
+
+        /// Return the ID associated to a Geant4 object (-1 if not interned yet)
+        int find(const void * key_) const;
+
+        /// Intern the name of a Geant4 object and return its ID
+        int add(const void * key_, const std::string & name_);
+
+        /// Return the name associated to an ID
+        const std::string & get_name(int id_) const;
+
+        /// Return the number of interned names
+        std::size_t size() const;
+
+        /// Clear the table
+        void clear();
+
+      private:
+
+        std::vector<const void *> _keys_;  //!< Addresses of the Geant4 objects
+        std::vector<std::string>  _names_; //!< Interned names
+      };
+
       /// Default capacity for buffer of hits
       static const size_t DEFAULT_HIT_BUFFER_CAPACITY = 1000;
 
@@ -103,6 +134,21 @@ namespace mctools {
       void set_record_boundaries(bool);
       void set_record_g4_volume_properties(bool);
 
+      /// Set the flag to record minimal hits (position, time, energy deposit and track IDs only)
+      void set_minimal_hit(bool);
+
+      /// Check if minimal hits are recorded
+      bool is_minimal_hit() const;
+
+      /// Return the table of particle names interned during the current event
+      const name_table & get_particle_table() const;
+
+      /// Return the table of material names interned during the current event
+      const name_table & get_material_table() const;
+
+      /// Return the table of creator process names interned during the current event
+      const name_table & get_creator_process_table() const;
+
       /// Return the capacity of the buffer of hits
       unsigned int get_hits_buffer_capacity() const;
 
@@ -192,6 +238,9 @@ namespace mctools {
 
     private:
 
+      /// Return the next available hit from the buffer
+      sensitive_hit & _grab_new_hit_();
+
       std::string            _sensitive_category_;             //!< The name of the sensitive hit catagory
       std::list<std::string> _attached_logical_volumes_;       //!< The list of geometry logical volumes attached to the sensitive category
       bool                   _drop_zero_energy_deposit_steps_; //!< Do not record steps with no energy deposit
@@ -213,6 +262,7 @@ namespace mctools {
       bool                   _record_delta_ray_from_alpha_; //!< Record boolean property "track.delta_ray_from_alpha" for secondary electrons generated as delta-rays along an alpha particle track
       bool                   _record_step_length_;          //!< Record the real property "track.step_length"
       unsigned int           _hits_buffer_capacity_;        //!< The capacity of the pre-allocated buffer of hits
+      bool                   _minimal_hit_;                 //!< Record only the position, time, energy deposit and track IDs of hits
 
       const track_history::track_info * _track_info_ptr_ = nullptr;   //!< Handle to the tracking information of the current track
       const track_history::track_info * _parent_track_info_ptr_ = nullptr; //!< Handle to the tracking information of the parent track of the current track
@@ -229,8 +279,15 @@ namespace mctools {
       // Dictionary to attach some processors for step hits:
       hit_processor_dict_type _hit_processors_;
 
+      // Interned names for the current event:
+      name_table _particle_table_;        //!< Table of particle names
+      name_table _material_table_;        //!< Table of material names
+      name_table _creator_process_table_; //!< Table of creator process names
+
       // Tools :
       uint32_t _number_of_sensitive_steps_; //!< Counter for processed hits
+      datatools::computing_time * _SD_timer_ = nullptr; //!< Handle to the sensitive detector timer (resolved once)
+      datatools::computing_time * _EA_timer_ = nullptr; //!< Handle to the event action timer (resolved once)
 
     };
 
@@ -16,6 +16,9 @@
 #ifndef MCTOOLS_G4_SENSITIVE_HIT_H
 #define MCTOOLS_G4_SENSITIVE_HIT_H 1
 
+// Standard library:
+#include <cstdint>
+
 // Third party:
 // - Geant4
 #include <G4VHit.hh>
@@ -59,9 +62,30 @@ namespace mctools {
       /// Reset to default values
       void reset ();
 
+      /// Return the interned ID of the particle (-1 if not set)
+      int get_particle_id() const;
+
+      /// Set the interned ID of the particle
+      void set_particle_id(int);
+
+      /// Return the interned ID of the material (-1 if not set)
+      int get_material_id() const;
+
+      /// Set the interned ID of the material
+      void set_material_id(int);
+
+      /// Return the interned ID of the creator process (-1 if not set)
+      int get_creator_process_id() const;
+
+      /// Set the interned ID of the creator process
+      void set_creator_process_id(int);
+
     private:
 
       mctools::base_step_hit _hit_data_; //!< Basic MC step hit data
+      int16_t _particle_id_ = -1;        //!< Interned ID of the particle
+      int16_t _material_id_ = -1;        //!< Interned ID of the material
+      int16_t _creator_process_id_ = -1; //!< Interned ID of the creator process
 
     };
 
@@ -35,13 +35,20 @@
 
 // Standard library:
 #include <string>
-#include <map>
+#include <vector>
+#include <unordered_map>
 
 namespace mctools {
 
   namespace g4 {
 
     /// \brief Recording of tracks history
+    ///
+    /// Track informations are stored in a dense array indexed by the Geant4
+    /// track Id, and particle/process/category names are interned in a table
+    /// of names shared by all tracks. The storage is kept from one event to
+    /// the other so that no allocation occurs once the largest event has
+    /// been processed.
     class track_history
     {
     public:
@@ -54,6 +61,9 @@ namespace mctools {
         /// Undefined Id for a track (parent track Id is 0 for a primary track)
         static const int TRACK_ID_UNSET = 0;
 
+        /// Undefined Id for an interned name
+        static const int NAME_ID_UNSET = -1;
+
       public:
 
         int get_id() const;
@@ -66,10 +76,16 @@ namespace mctools {
 
         bool is_primary() const;
 
+        /// Return the interned Id of the particle name
+        int get_particle_name_id() const;
+
         const std::string & get_particle_name() const;
 
         void set_particle_name(const std::string & name_);
 
+        /// Return the interned Id of the creator process name
+        int get_creator_process_name_id() const;
+
         const std::string & get_creator_process_name() const;
 
         void set_creator_process_name(const std::string & name_);
@@ -91,22 +107,31 @@ namespace mctools {
 
       private:
 
-        int         _id_;                   //!< G4 particle id
-        int         _parent_id_;            //!< G4 parent id (if any)
-        std::string _particle_name_;        //!< G4 particle name
-        std::string _creator_process_name_; //!< G4 creation process name
-        std::string _creator_sensitive_category_; //!< SNG4 sensitive category (obsolete)
+        int _id_;                            //!< G4 particle id
+        int _parent_id_;                     //!< G4 parent id (if any)
+        int _particle_name_id_;              //!< Interned G4 particle name
+        int _creator_process_name_id_;       //!< Interned G4 creation process name
+        int _creator_sensitive_category_id_; //!< Interned SNG4 sensitive category (obsolete)
+        track_history * _history_ = nullptr; //!< Handle to the history which owns the table of names
+
+        friend class track_history;
 
       };
 
     public:
 
-      /// Dictionary type of track info
-      typedef std::map<int, track_info> track_info_dict_type;
+      /// Array of track infos indexed by track Id
+      ///
+      /// This type was formerly a map keyed by track Id, with a mutable
+      /// accessor grab_track_infos(). Track infos are now only added through
+      /// add_track_info() and modified through grab_track_info().
+      typedef std::vector<track_info> track_info_dict_type;
 
+      /// Return the array of track infos indexed by track Id (unused slots have an unset Id)
       const track_info_dict_type & get_track_infos() const;
 
-      track_info_dict_type & grab_track_infos();
+      /// Return the number of tracks recorded in the current event
+      std::size_t get_number_of_tracks() const;
 
       bool has_track_info(const int id_) const;
 
@@ -116,18 +141,39 @@ namespace mctools {
 
       void add_track_info(const int id_, const track_info & tinfo_);
 
+      /// Return the Id of an interned name, interning it if needed
+      int intern_name(const std::string & name_);
+
+      /// Return the Id of an interned name (track_info::NAME_ID_UNSET if not interned)
+      int find_name_id(const std::string & name_) const;
+
+      /// Return an interned name from its Id
+      const std::string & get_name(const int name_id_) const;
+
+      /// Reserve storage for a given number of tracks
+      void reserve(const std::size_t ntracks_);
+
       /// Constructor
       track_history();
 
       /// Destructor
       ~track_history();
 
-      /// Reset the track history object
+      /// Copy constructor is disabled (track infos refer to their history)
+      track_history(const track_history &) = delete;
+
+      /// Copy assignment is disabled (track infos refer to their history)
+      track_history & operator=(const track_history &) = delete;
+
+      /// Reset the track history object (the storage and the table of names are kept)
       void reset();
 
     private:
 
-      track_info_dict_type _track_infos_; //!< Dictionary of track informations
+      track_info_dict_type _track_infos_;      //!< Track informations indexed by track Id
+      std::size_t _number_of_tracks_ = 0;      //!< Number of recorded tracks
+      std::vector<std::string> _names_;        //!< Interned names
+      std::unordered_map<std::string, int> _name_ids_; //!< Ids of interned names
 
     };
 
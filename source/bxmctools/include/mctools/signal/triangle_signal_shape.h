@@ -162,6 +162,11 @@ namespace mctools {
       //! Evaluation from parameters
       double _eval(double x_) const override;
 
+      //! Analytic batch sampling from parameters
+      void _sample_no_check(double x0_, double dx_,
+                            std::size_t first_, std::size_t last_,
+                            double * out_) const override;
+
     private:
 
       // Configuration:
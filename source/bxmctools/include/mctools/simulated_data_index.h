@@ -0,0 +1,170 @@
+/// \file mctools/simulated_data_index.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * License:
+ *
+ * Description:
+ *   Index of simulated data records stored in a set of data files.
+ *
+ */
+
+#ifndef MCTOOLS_SIMULATED_DATA_INDEX_H
+#define MCTOOLS_SIMULATED_DATA_INDEX_H 1
+
+// Standard library:
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools :
+#include <datatools/i_tree_dump.h>
+
+namespace mctools {
+
+  class simulated_data;
+
+  /// \brief Index of the simulated data records stored in a set of data files
+  ///
+  /// The index locates each simulated data record by its data file and
+  /// its rank in this file, so that a record can be addressed by its
+  /// global entry number. Optional event-level summary values, computed
+  /// by user functions, are recorded for each entry, together with their
+  /// range in each file, so that whole files can be skipped by a
+  /// predicate on these ranges.
+  ///
+  /// The index can be built from a first pass on the data files (build)
+  /// or filled at write time (begin_file/add_entry/end_file). It is stored
+  /// in a text sidecar file. The size and the last write time of each data
+  /// file are recorded when its indexing ends, so that an index does not
+  /// match data files which have been regenerated since.
+  ///
+  /// Example of a sidecar file (data files with their number of entries,
+  /// size and last write time):
+  /// \code
+  /// #@mctools::simulated_data_index 2
+  /// summaries 1 number_of_hits
+  /// files 2
+  /// file 1 3 20480 1792332000 sd_0.brio
+  /// 12
+  /// 0
+  /// 7
+  /// file 0 0 312 1792332010 sd_1.xml
+  /// \endcode
+  class simulated_data_index
+    : public datatools::i_tree_dumpable
+  {
+  public:
+
+    /// Function computing an event-level summary value from a simulated data record
+    typedef std::function<double(const simulated_data &)> summary_function_type;
+
+    /// \brief Indexed data file
+    struct file_record
+    {
+      std::string filename;              //!< Name of the data file
+      bool brio = false;                 //!< Flag for a BRIO data file (random access)
+      std::size_t first_entry = 0;       //!< Global entry number of the first record in this file
+      std::size_t number_of_entries = 0; //!< Number of simulated data records in this file
+      std::uintmax_t file_size = 0;      //!< Size of the data file when it was indexed
+      std::time_t last_write_time = 0;   //!< Last write time of the data file when it was indexed
+      std::vector<double> min_summaries; //!< Minimum of the summary values in this file
+      std::vector<double> max_summaries; //!< Maximum of the summary values in this file
+    };
+
+    /// Return the default extension of sidecar files
+    static const std::string & sidecar_extension();
+
+    /// Default constructor
+    simulated_data_index();
+
+    /// Destructor
+    ~simulated_data_index() override;
+
+    /// Add a summary value, must be called before any file is indexed
+    void add_summary(const std::string & name_, const summary_function_type & function_);
+
+    /// Return the number of summary values
+    std::size_t get_number_of_summaries() const;
+
+    /// Check if a summary value is defined
+    bool has_summary(const std::string & name_) const;
+
+    /// Return the rank of a summary value
+    std::size_t get_summary_index(const std::string & name_) const;
+
+    /// Return the names of the summary values
+    const std::vector<std::string> & get_summary_names() const;
+
+    /// Build the index from a first pass on a list of data files
+    void build(const std::vector<std::string> & filenames_);
+
+    /// Start the indexing of a new data file
+    void begin_file(const std::string & filename_);
+
+    /// Index a new simulated data record in the current data file
+    void add_entry(const simulated_data & sd_);
+
+    /// Terminate the indexing of the current data file
+    ///
+    /// The data file must be complete, its size and last write time are recorded.
+    void end_file();
+
+    /// Return the number of indexed data files
+    std::size_t get_number_of_files() const;
+
+    /// Return an indexed data file
+    const file_record & get_file(std::size_t file_index_) const;
+
+    /// Return the total number of indexed simulated data records
+    std::size_t get_number_of_entries() const;
+
+    /// Locate a simulated data record from its global entry number
+    void locate(std::size_t entry_, std::size_t & file_index_, std::size_t & file_entry_) const;
+
+    /// Return a summary value of a simulated data record from its global entry number
+    double get_summary(std::size_t entry_, std::size_t summary_index_) const;
+
+    /// Check if the indexed data files match a list of data files
+    ///
+    /// The data files must have the same names, sizes and last write times
+    /// as when they were indexed.
+    bool matches(const std::vector<std::string> & filenames_) const;
+
+    /// Store the index in a sidecar file
+    void store(const std::string & filename_) const;
+
+    /// Load the index from a sidecar file
+    void load(const std::string & filename_);
+
+    /// Reset the index (summary definitions are preserved)
+    void clear();
+
+    /// Smart print
+    void tree_dump(std::ostream & out_         = std::clog,
+                   const std::string & title_  = "",
+                   const std::string & indent_ = "",
+                   bool inherit_               = false) const override;
+
+  private:
+
+    std::vector<std::string> _summary_names_;                 //!< Names of the summary values
+    std::vector<summary_function_type> _summary_functions_;   //!< Functions computing the summary values
+    std::vector<file_record> _files_;                         //!< Indexed data files
+    std::vector<double> _summaries_;                          //!< Summary values of all entries (entry major)
+    bool _file_open_ = false;                                 //!< Flag for a data file being indexed
+
+  };
+
+} // end of namespace mctools
+
+#endif // MCTOOLS_SIMULATED_DATA_INDEX_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
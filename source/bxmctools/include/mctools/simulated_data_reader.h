@@ -14,6 +14,7 @@
 #define MCTOOLS_SIMULATED_DATA_READER_H 1
 
 // Standard library:
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,9 @@
 #include <datatools/smart_filename.h>
 #include <datatools/utils.h>
 
+// This project:
+#include <mctools/simulated_data_index.h>
+
 namespace datatools {
   class properties;
   class data_reader;
@@ -51,6 +55,17 @@ namespace mctools {
       LOAD_FATAL = 2
     };
 
+    /// Function invoked on a simulated data record, returns false to stop the reading
+    typedef std::function<bool(simulated_data &)> record_handler_type;
+
+    /// Function selecting the indexed data files to be read
+    typedef std::function<bool(const simulated_data_index::file_record &)> file_selector_type;
+
+    /// Scan the simulated data records stored in a data file, return the number of scanned records
+    static std::size_t scan_file(const std::string & filename_,
+                                 const record_handler_type & handler_,
+                                 datatools::logger::priority logging_ = datatools::logger::PRIO_FATAL);
+
     /// Set the maximum number of files to be used
     void set_max_files (int max_files_);
 
@@ -72,6 +87,21 @@ namespace mctools {
     /// Set the input filenames
     void set_filenames (const datatools::properties & setup_);
 
+    /// Check if an index of the input files is available
+    bool has_index() const;
+
+    /// Set the index of the input files
+    void set_index(const simulated_data_index & index_);
+
+    /// Return the index of the input files
+    const simulated_data_index & get_index() const;
+
+    /// Build the index of the input files from a first pass, store it in a sidecar file if a name is given
+    void build_index(const std::string & sidecar_filename_ = "");
+
+    /// Set the selector of the indexed input files to be read (requires an index)
+    void set_file_selector(const file_selector_type & selector_);
+
     /// Get logging priority threshold
     datatools::logger::priority get_logging_priority() const;
 
@@ -140,6 +170,25 @@ namespace mctools {
     /// Return the record counter
     int get_record_counter() const;
 
+    /// Return the number of indexed simulated data records (requires an index)
+    std::size_t get_number_of_entries() const;
+
+    /// Load a simulated data record from its global entry number (requires an index)
+    ///
+    /// Entries stored in BRIO files are directly accessed. Entries stored in
+    /// BIO files are reached by reading forward from the current position in
+    /// the file, or from the beginning of the file if needed.
+    /// This does not change the status of the sequential reading.
+    int load_entry(std::size_t entry_, simulated_data & sd_);
+
+    /// Read the selected input files with several threads, return the number of handled records
+    ///
+    /// Up to \a nthreads_ files are loaded concurrently. Records are passed to
+    /// the handler from the calling thread, in the order of the input files
+    /// and of the records in each file. Limits on the number of files and
+    /// records apply. This does not change the status of the sequential reading.
+    std::size_t read_concurrently(unsigned int nthreads_, const record_handler_type & handler_);
+
     /// Smart print
     void tree_dump(std::ostream & out_         = std::clog,
                            const std::string & title_  = "",
@@ -156,6 +205,15 @@ namespace mctools {
 
     void _set_defaults();
 
+    /// Check if an input file is selected
+    bool _is_selected_file(int file_index_) const;
+
+    /// Open an input file for random access
+    void _open_random_access(std::size_t file_index_);
+
+    /// Build the list of input filenames
+    void _build_filenames(std::vector<std::string> & filenames_) const;
+
   private:
 
     bool                        _initialized_; //!< Initialization flag
@@ -175,6 +233,14 @@ namespace mctools {
     boost::scoped_ptr<brio::reader>           _brio_reader_; //!< Brio reader
     boost::scoped_ptr<datatools::properties>  _run_header_;
     boost::scoped_ptr<datatools::properties>  _run_footer_;
+
+    // Indexed access:
+    boost::scoped_ptr<simulated_data_index>   _index_;         //!< Index of the input files
+    file_selector_type                        _file_selector_; //!< Selector of the indexed input files
+    int         _ra_file_index_ = -1;                             //!< Index of the data file open for random access
+    std::size_t _ra_file_entry_ = 0;                              //!< Next entry in the data file open for random access
+    boost::scoped_ptr<datatools::data_reader> _ra_bio_reader_;    //!< Datatools reader for random access
+    boost::scoped_ptr<brio::reader>           _ra_brio_reader_;   //!< Brio reader for random access
   };
 
 
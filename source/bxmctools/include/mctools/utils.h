@@ -43,6 +43,7 @@ namespace mctools {
     static const std::string SENSITIVE_G4_VOLUME_COPY_NUMBER_KEY;
     static const std::string SENSITIVE_RECORD_STEP_LENGTH;
     static const std::string SENSITIVE_RECORD_BOUNDARIES;
+    static const std::string SENSITIVE_MINIMAL_HIT;
   };
 
   class hit_utils
@@ -270,6 +270,11 @@ namespace mctools {
       return _samples_;
     }
 
+    std::vector<int32_t> & sampled_signal::grab_samples()
+    {
+      return _samples_;
+    }
+
     void sampled_signal::update()
     {
       _recompute_working_data();
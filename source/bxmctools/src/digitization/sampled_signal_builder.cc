@@ -0,0 +1,252 @@
+/// \file mctools/digitization/sampled_signal_builder.cc
+/* Creation date : 2026-10-18
+ * Last modified : 2026-10-18
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Ourselves:
+#include <mctools/digitization/sampled_signal_builder.h>
+
+// Standard library:
+#include <cmath>
+#include <limits>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+#include <datatools/clhep_units.h>
+
+namespace mctools {
+
+  namespace digitization {
+
+    void sampled_signal_builder::_set_defaults()
+    {
+      _adc_ = nullptr;
+      datatools::invalidate(_sampling_frequency_);
+      _number_of_samples_ = 0;
+      _time_origin_ = 0.0;
+      return;
+    }
+
+    sampled_signal_builder::sampled_signal_builder()
+    {
+      _set_defaults();
+      return;
+    }
+
+    sampled_signal_builder::~sampled_signal_builder()
+    {
+      return;
+    }
+
+    void sampled_signal_builder::set_adc(const i_adc & adc_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Builder is already initialized and locked!");
+      _adc_ = &adc_;
+      return;
+    }
+
+    bool sampled_signal_builder::has_adc() const
+    {
+      return _adc_ != nullptr;
+    }
+
+    const i_adc & sampled_signal_builder::get_adc() const
+    {
+      DT_THROW_IF(!has_adc(), std::logic_error, "No ADC is set!");
+      return *_adc_;
+    }
+
+    void sampled_signal_builder::set_sampling_frequency(const double fs_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Builder is already initialized and locked!");
+      DT_THROW_IF(!std::isfinite(fs_) || fs_ <= std::numeric_limits<double>::epsilon(),
+                  std::domain_error, "Invalid sampling frequency!");
+      _sampling_frequency_ = fs_;
+      return;
+    }
+
+    double sampled_signal_builder::get_sampling_frequency() const
+    {
+      return _sampling_frequency_;
+    }
+
+    void sampled_signal_builder::set_number_of_samples(const std::size_t ns_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Builder is already initialized and locked!");
+      _number_of_samples_ = ns_;
+      return;
+    }
+
+    std::size_t sampled_signal_builder::get_number_of_samples() const
+    {
+      return _number_of_samples_;
+    }
+
+    void sampled_signal_builder::set_time_origin(const double t0_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Builder is already initialized and locked!");
+      DT_THROW_IF(!std::isfinite(t0_), std::domain_error, "Invalid time origin!");
+      _time_origin_ = t0_;
+      return;
+    }
+
+    double sampled_signal_builder::get_time_origin() const
+    {
+      return _time_origin_;
+    }
+
+    bool sampled_signal_builder::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void sampled_signal_builder::initialize_simple()
+    {
+      datatools::properties dummy_config;
+      initialize(dummy_config);
+      return;
+    }
+
+    void sampled_signal_builder::initialize(const datatools::properties & config_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Builder is already initialized!");
+
+      if (!datatools::is_valid(_sampling_frequency_)) {
+        if (config_.has_key("sampling_frequency")) {
+          double fs = config_.fetch_real_with_explicit_dimension("sampling_frequency", "frequency");
+          set_sampling_frequency(fs);
+        }
+      }
+      DT_THROW_IF(!datatools::is_valid(_sampling_frequency_), std::logic_error,
+                  "Sampling frequency is not set!");
+
+      if (_number_of_samples_ == 0) {
+        if (config_.has_key("number_of_samples")) {
+          int ns = config_.fetch_integer("number_of_samples");
+          DT_THROW_IF(ns < 1, std::range_error, "Invalid number of samples!");
+          set_number_of_samples((std::size_t) ns);
+        }
+      }
+      DT_THROW_IF(_number_of_samples_ == 0, std::logic_error, "Number of samples is not set!");
+
+      if (config_.has_key("time_origin")) {
+        double t0 = config_.fetch_real_with_explicit_dimension("time_origin", "time");
+        set_time_origin(t0);
+      }
+
+      DT_THROW_IF(!has_adc(), std::logic_error, "ADC is not set!");
+
+      _voltages_.reserve(_number_of_samples_);
+      _buffer_.reserve(_number_of_samples_);
+      _initialized_ = true;
+      return;
+    }
+
+    void sampled_signal_builder::reset()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Builder is not initialized!");
+      _initialized_ = false;
+      _voltages_.clear();
+      _buffer_.clear();
+      _set_defaults();
+      return;
+    }
+
+    void sampled_signal_builder::sample(const mygsl::i_unary_function & shape_,
+                                        std::vector<double> & voltages_) const
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Builder is not initialized!");
+      shape_.sample(_time_origin_, 1.0 / _sampling_frequency_, _number_of_samples_, voltages_);
+      return;
+    }
+
+    void sampled_signal_builder::build(const mygsl::i_unary_function & shape_,
+                                       sampled_signal & target_)
+    {
+      sample(shape_, _voltages_);
+      _digitize(target_);
+      return;
+    }
+
+    void sampled_signal_builder::build(const std::vector<const mygsl::i_unary_function *> & shapes_,
+                                       sampled_signal & target_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Builder is not initialized!");
+      _voltages_.assign(_number_of_samples_, 0.0);
+      for (const mygsl::i_unary_function * shape : shapes_) {
+        DT_THROW_IF(shape == nullptr, std::logic_error, "Null signal shape!");
+        sample(*shape, _buffer_);
+        for (std::size_t i = 0; i < _number_of_samples_; i++) {
+          _voltages_[i] += _buffer_[i];
+        }
+      }
+      _digitize(target_);
+      return;
+    }
+
+    void sampled_signal_builder::_digitize(sampled_signal & target_)
+    {
+      target_.set_sampling_frequency(_sampling_frequency_);
+      if (target_.get_number_of_samples() != _number_of_samples_) {
+        target_.set_number_of_samples(_number_of_samples_);
+      }
+      std::vector<int32_t> & samples = target_.grab_samples();
+      _adc_->quantize_many(_voltages_.data(), _number_of_samples_, samples.data());
+      target_.update();
+      return;
+    }
+
+    void sampled_signal_builder::tree_dump(std::ostream & out_,
+                                           const std::string & title_,
+                                           const std::string & indent_,
+                                           bool inherit_) const
+    {
+      if (!title_.empty()) {
+        out_ << indent_ << title_ << std::endl;
+      }
+
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+           << "ADC : " << (has_adc() ? "<yes>" : "<none>") << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+           << "Sampling frequency : ";
+      if (datatools::is_valid(_sampling_frequency_)) {
+        out_ << _sampling_frequency_ / CLHEP::gigahertz << " GHz";
+      } else {
+        out_ << "<none>";
+      }
+      out_ << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+           << "Number of samples : " << _number_of_samples_ << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+           << "Time origin : " << _time_origin_ / CLHEP::ns << " ns" << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+           << "Initialized : " << std::boolalpha << is_initialized() << std::endl;
+
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace mctools
@@ -312,6 +312,29 @@ namespace mctools {
       return _min_channel_ + channel;
     }
 
+    void simple_linear_adc::quantize_many(const double * vinputs_,
+                                          const std::size_t n_,
+                                          int32_t * channels_) const
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "ADC is not initialized!");
+      const double vlow = _v_ref_low_ - std::numeric_limits<double>::epsilon();
+      const double vhigh = _v_ref_high_;
+      const double v0 = _v0_;
+      const double q = _q_;
+      const int32_t min_channel = _min_channel_;
+      for (std::size_t i = 0; i < n_; i++) {
+        const double vinput = vinputs_[i];
+        if (vinput < vlow) {
+          channels_[i] = _underflow_channel_;
+        } else if (vinput > vhigh) {
+          channels_[i] = _overflow_channel_;
+        } else {
+          channels_[i] = min_channel + (int32_t) ((vinput - v0) / q);
+        }
+      }
+      return;
+    }
+
     double simple_linear_adc::compute_sampled_voltage(int32_t channel_,
                                                       bool ignore_out_) const
     {
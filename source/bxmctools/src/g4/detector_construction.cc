@@ -247,6 +247,17 @@ namespace mctools {
         _gdml_validation_ = config_.fetch_boolean("gdml.validation");
       }
 
+      if (config_.has_key("gdml.cache")) {
+        _gdml_cache_ = config_.fetch_boolean("gdml.cache");
+      }
+
+      if (config_.has_key("gdml.export_threads")) {
+        const int gdml_export_threads = config_.fetch_integer("gdml.export_threads");
+        DT_THROW_IF(gdml_export_threads < 0, std::domain_error,
+                    "Invalid number of GDML export threads (" << gdml_export_threads << ") !");
+        _gdml_export_threads_ = gdml_export_threads;
+      }
+
       if (config_.has_key("gdml.schema_location")) {
         std::string gdml_schema_location = config_.fetch_string("gdml.schema_location") ;
         if (gdml_schema_location == "remote") {
@@ -645,6 +656,33 @@ namespace mctools {
       return;
     }
 
+    void detector_construction::print_em_field_statistics(std::ostream & out_,
+                                                          std::size_t nevents_,
+                                                          const std::string & indent_) const
+    {
+      for (em_field_g4_data_type::const_iterator i = _em_field_g4_data_.begin();
+           i != _em_field_g4_data_.end();
+           i++) {
+        const em_field_g4_stuff * emf_working = i->second;
+        if (emf_working == nullptr || ! emf_working->has_g4_field()) continue;
+        out_ << indent_ << "Electromagnetic field '" << i->first << "' :" << std::endl;
+        emf_working->get_g4_field_cache().print_stats(out_, nevents_, indent_);
+      }
+      return;
+    }
+
+    void detector_construction::reset_em_field_statistics()
+    {
+      for (em_field_g4_data_type::iterator i = _em_field_g4_data_.begin();
+           i != _em_field_g4_data_.end();
+           i++) {
+        em_field_g4_stuff * emf_working = i->second;
+        if (emf_working == nullptr || ! emf_working->has_g4_field()) continue;
+        emf_working->reset_g4_field_cache_statistics();
+      }
+      return;
+    }
+
     void detector_construction::_destroy_electromagnetic_field()
     {
       for (em_field_g4_data_type::iterator i = _em_field_g4_data_.begin();
@@ -1247,15 +1285,6 @@ namespace mctools {
         }
         tmp_file_template_oss << _gdml_file_dir_ << '/';
       }
-      tmp_file_template_oss << "mctools_g4_geometry.gdml." << "XXXXXX" << std::ends;
-      std::string tmp_file_template = tmp_file_template_oss.str();
-      char tmp_gdml_filename[1024];
-      copy(tmp_file_template.begin(), tmp_file_template.end(), tmp_gdml_filename);
-
-      int err = mkstemp(tmp_gdml_filename);
-      DT_THROW_IF (err == -1, std::runtime_error, "Cannot create GDML temporary file !");
-      _gdml_filename_ = tmp_gdml_filename;
-
 
       // The GDML export object :
       geomtools::gdml_export GDML;
@@ -1308,6 +1337,20 @@ namespace mctools {
 
       GDML.parameters().store("length_unit",  geomtools::gdml_export::default_length_unit());
       GDML.parameters().store("angle_unit",   geomtools::gdml_export::default_angle_unit());
+      GDML.set_number_of_threads(_gdml_export_threads_);
+      if (_gdml_cache_) {
+        // Reuse the GDML file generated by a former job from the same geometry:
+        _gdml_filename_ = GDML.export_gdml_cached(_gdml_file_dir_, _geom_manager_->get_factory(), "world");
+        return;
+      }
+      tmp_file_template_oss << "mctools_g4_geometry.gdml." << "XXXXXX" << std::ends;
+      std::string tmp_file_template = tmp_file_template_oss.str();
+      char tmp_gdml_filename[1024];
+      copy(tmp_file_template.begin(), tmp_file_template.end(), tmp_gdml_filename);
+
+      int err = mkstemp(tmp_gdml_filename);
+      DT_THROW_IF (err == -1, std::runtime_error, "Cannot create GDML temporary file !");
+      _gdml_filename_ = tmp_gdml_filename;
       GDML.export_gdml(_gdml_filename_, _geom_manager_->get_factory(), "world");
       return;
     }
@@ -1712,6 +1755,44 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(mctools::g4::detector_construction,ocd_)
       ;
   }
 
+  {
+    // Description of the 'gdml.cache' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("gdml.cache")
+      .set_terse_description("Flag to reuse the GDML file generated by a former job from the same geometry")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_long_description("Default value: 0                                              \n"
+                            "                                                              \n"
+                            "The GDML file is named after a hash of the geometry setup and \n"
+                            "is kept in the ``gdml.tmp_dir`` directory. It is generated    \n"
+                            "only if no GDML file with the same hash exists yet.           \n"
+                            "                                                              \n"
+                            "Example::                                                     \n"
+                            "                                                              \n"
+                            "  gdml.cache : boolean = 1                                    \n"
+                            "                                                              \n"
+                            )
+      ;
+  }
+
+  {
+    // Description of the 'gdml.export_threads' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("gdml.export_threads")
+      .set_terse_description("The number of threads used to generate the GDML file")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_long_description("Default value: 0 (number of hardware threads)                 \n"
+                            "                                                              \n"
+                            "Example::                                                     \n"
+                            "                                                              \n"
+                            "  gdml.export_threads : integer = 4                           \n"
+                            "                                                              \n"
+                            )
+      ;
+  }
+
   {
     // Description of the 'gdml.schema_location' configuration property :
     datatools::configuration_property_description & cpd
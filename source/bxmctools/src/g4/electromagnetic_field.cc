@@ -80,6 +80,16 @@ namespace mctools {
       return *_field_;
     }
 
+    const em_field_cache & electromagnetic_field::get_cache() const
+    {
+      return _cache_;
+    }
+
+    em_field_cache & electromagnetic_field::grab_cache()
+    {
+      return _cache_;
+    }
+
     bool electromagnetic_field::is_active() const
     {
       return has_field();
@@ -101,6 +111,7 @@ namespace mctools {
       _initialized_ = false;
       _name_.clear();
       _field_ = 0;
+      _cache_.reset();
       _set_defaults();
 
       return;
@@ -277,6 +288,36 @@ namespace mctools {
         _field_check_pos_time_ = true;
       }
 
+      if (has_field()) {
+        _cache_.set_number_of_components(6);
+        _cache_.set_time_dependent((_field_->is_magnetic_field() && _field_->magnetic_field_is_time_dependent())
+                                   || (_field_->is_electric_field() && _field_->electric_field_is_time_dependent()));
+        _cache_.configure(config_);
+        if (_cache_.has_grid_box()) {
+          DT_LOG_NOTICE(_logprio(), "Sampling Geant4 electromagnetic field '" << get_name() << "' on a grid...");
+          _cache_.build_grid([this] (const double position_[4], double * em_field_) {
+              geomtools::vector_3d pos(position_[POSTIME_X], position_[POSTIME_Y], position_[POSTIME_Z]);
+              double time = position_[POSTIME_T];
+              if (! _field_->position_and_time_are_valid(pos, time)) return false;
+              geomtools::vector_3d the_field;
+              for (int i = 0; i < 6; i++) em_field_[i] = 0.0;
+              if (_field_->is_magnetic_field()) {
+                if (_field_->compute_magnetic_field(pos, time, the_field) != 0) return false;
+                em_field_[EMFIELD_BX] = the_field.x();
+                em_field_[EMFIELD_BY] = the_field.y();
+                em_field_[EMFIELD_BZ] = the_field.z();
+              }
+              if (_field_->is_electric_field()) {
+                if (_field_->compute_electric_field(pos, time, the_field) != 0) return false;
+                em_field_[EMFIELD_EX] = the_field.x();
+                em_field_[EMFIELD_EY] = the_field.y();
+                em_field_[EMFIELD_EZ] = the_field.z();
+              }
+              return true;
+            });
+        }
+      }
+
       _initialized_ = true;
       return;
     }
@@ -313,7 +354,10 @@ namespace mctools {
       em_field_[EMFIELD_EX] = 0.0;
       em_field_[EMFIELD_EY] = 0.0;
       em_field_[EMFIELD_EZ] = 0.0;
-      if (_field_ != 0) {
+      if (_field_ != 0 && _cache_.find(position_, em_field_)) {
+        // Field value from the cache or the grid:
+        DT_LOG_TRACE(_logprio(), "Cached value for Geant4 electromagnetic field '" << get_name() << "'.");
+      } else if (_field_ != 0) {
         geomtools::vector_3d pos(position_[POSTIME_X], position_[POSTIME_Y], position_[POSTIME_Z]);
         double time = position_[POSTIME_T];
         DT_LOG_TRACE(_logprio(), "Compute electromagnetic field at position/time "
@@ -353,6 +397,7 @@ namespace mctools {
           em_field_[EMFIELD_EY] = the_electric_field.y();
           em_field_[EMFIELD_EZ] = the_electric_field.z();
         }
+        _cache_.store(position_, em_field_);
       } else if (geomtools::is_valid(_standalone_constant_mag_field_)) {
         em_field_[EMFIELD_BX] = _standalone_constant_mag_field_.x();
         em_field_[EMFIELD_BY] = _standalone_constant_mag_field_.y();
@@ -381,7 +426,10 @@ namespace mctools {
       } else {
         out_ << "|-- Electromagnetic field         : " << _field_ << std::endl;
       }
-      out_ << "`-- Check field pos/time   : " << _field_check_pos_time_ << std::endl;
+      out_ << "|-- Check field pos/time   : " << _field_check_pos_time_ << std::endl;
+      out_ << "`-- Field cache            : " << (_cache_.is_enabled() ? "enabled" : "disabled")
+           << (_cache_.has_grid() ? " (with grid)" : "") << std::endl;
+      _cache_.print_stats(out_, 0, "    ");
       return;
     }
 
@@ -0,0 +1,382 @@
+// em_field_cache.cc
+
+// Ourselves:
+#include <mctools/g4/em_field_cache.h>
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/units.h>
+#include <datatools/clhep_units.h>
+#include <datatools/properties.h>
+#include <datatools/exception.h>
+
+// This project:
+#include <mctools/g4/em_field_g4_utils.h>
+
+namespace mctools {
+
+  namespace g4 {
+
+    namespace {
+
+      //! Number of cached field values per thread
+      const std::size_t NUMBER_OF_SLOTS = 8;
+
+      //! Maximum number of grid nodes
+      const std::size_t MAX_GRID_NODES = 50000000;
+
+      //! \brief Cached field value
+      struct cache_slot
+      {
+        unsigned long id = 0; //!< Identifier of the owner cache
+        double position[4];   //!< Position/time
+        double field[em_field_cache::MAX_COMPONENTS]; //!< Field components
+      };
+
+      //! \brief Cached field values of a thread, shared by all the fields
+      struct thread_cache
+      {
+        cache_slot  slots[NUMBER_OF_SLOTS];
+        std::size_t next = 0;
+      };
+
+      thread_local thread_cache tl_cache;
+
+      //! Return a new unique cache identifier
+      unsigned long new_cache_id()
+      {
+        static std::atomic<unsigned long> _last_id(0);
+        return ++_last_id;
+      }
+
+    }
+
+    double em_field_cache::stats_type::hit_rate() const
+    {
+      if (calls == 0) return 0.0;
+      return (double) (cache_hits + grid_hits) / calls;
+    }
+
+    em_field_cache::em_field_cache()
+      : _calls_(0), _cache_hits_(0), _grid_hits_(0), _evaluations_(0)
+    {
+      _id_ = new_cache_id();
+      _ncomponents_ = 3;
+      _time_dependent_ = false;
+      _enabled_ = true;
+      _tolerance_ = 0.0;
+      _time_tolerance_ = 0.0;
+      for (int i = 0; i < 3; i++) {
+        _grid_min_[i] = 0.0;
+        _grid_max_[i] = 0.0;
+        _grid_step_[i] = 0.0;
+        _grid_nodes_[i] = 0;
+      }
+      return;
+    }
+
+    em_field_cache::~em_field_cache()
+    {
+      return;
+    }
+
+    unsigned int em_field_cache::get_number_of_components() const
+    {
+      return _ncomponents_;
+    }
+
+    void em_field_cache::set_number_of_components(unsigned int n_)
+    {
+      DT_THROW_IF(n_ == 0 || n_ > MAX_COMPONENTS, std::range_error,
+                  "Invalid number of field components (" << n_ << ") !");
+      DT_THROW_IF(has_grid(), std::logic_error, "Field grid is already built !");
+      _ncomponents_ = n_;
+      return;
+    }
+
+    bool em_field_cache::is_time_dependent() const
+    {
+      return _time_dependent_;
+    }
+
+    void em_field_cache::set_time_dependent(bool td_)
+    {
+      _time_dependent_ = td_;
+      return;
+    }
+
+    bool em_field_cache::is_enabled() const
+    {
+      return _enabled_;
+    }
+
+    void em_field_cache::set_enabled(bool e_)
+    {
+      _enabled_ = e_;
+      return;
+    }
+
+    double em_field_cache::get_tolerance() const
+    {
+      return _tolerance_;
+    }
+
+    void em_field_cache::set_tolerance(double t_)
+    {
+      DT_THROW_IF(! (t_ >= 0.0), std::domain_error, "Invalid field cache tolerance !");
+      _tolerance_ = t_;
+      return;
+    }
+
+    double em_field_cache::get_time_tolerance() const
+    {
+      return _time_tolerance_;
+    }
+
+    void em_field_cache::set_time_tolerance(double t_)
+    {
+      DT_THROW_IF(! (t_ >= 0.0), std::domain_error, "Invalid field cache time tolerance !");
+      _time_tolerance_ = t_;
+      return;
+    }
+
+    void em_field_cache::configure(const datatools::properties & config_)
+    {
+      if (config_.has_key("cache.enabled")) {
+        set_enabled(config_.fetch_boolean("cache.enabled"));
+      }
+
+      if (config_.has_key("cache.tolerance")) {
+        double tolerance = config_.fetch_real("cache.tolerance");
+        if (! config_.has_explicit_unit("cache.tolerance")) {
+          tolerance *= CLHEP::mm;
+        }
+        set_tolerance(tolerance);
+      }
+
+      if (config_.has_key("cache.time_tolerance")) {
+        double time_tolerance = config_.fetch_real("cache.time_tolerance");
+        if (! config_.has_explicit_unit("cache.time_tolerance")) {
+          time_tolerance *= CLHEP::ns;
+        }
+        set_time_tolerance(time_tolerance);
+      }
+
+      if (config_.has_key("grid.step")) {
+        double length_unit = CLHEP::mm;
+        if (config_.has_key("grid.length_unit")) {
+          length_unit = datatools::units::get_length_unit_from(config_.fetch_string("grid.length_unit"));
+        }
+        double step = config_.fetch_real("grid.step");
+        if (! config_.has_explicit_unit("grid.step")) {
+          step *= length_unit;
+        }
+        DT_THROW_IF(! (step > 0.0), std::domain_error, "Invalid field grid step !");
+        std::vector<double> grid_min;
+        std::vector<double> grid_max;
+        DT_THROW_IF(! config_.has_key("grid.min") || ! config_.has_key("grid.max"),
+                    std::logic_error, "Missing field grid box !");
+        config_.fetch("grid.min", grid_min);
+        config_.fetch("grid.max", grid_max);
+        DT_THROW_IF(grid_min.size() != 3 || grid_max.size() != 3, std::logic_error,
+                    "Invalid dimension for the field grid box !");
+        for (int i = 0; i < 3; i++) {
+          if (! config_.has_explicit_unit("grid.min")) grid_min[i] *= length_unit;
+          if (! config_.has_explicit_unit("grid.max")) grid_max[i] *= length_unit;
+          DT_THROW_IF(! (grid_min[i] < grid_max[i]), std::domain_error, "Invalid field grid box !");
+          _grid_min_[i] = grid_min[i];
+          _grid_max_[i] = grid_max[i];
+          _grid_step_[i] = step;
+        }
+      }
+      return;
+    }
+
+    bool em_field_cache::has_grid_box() const
+    {
+      return _grid_step_[0] > 0.0;
+    }
+
+    bool em_field_cache::has_grid() const
+    {
+      return ! _grid_values_.empty();
+    }
+
+    std::size_t em_field_cache::_node_index_(std::size_t i_, std::size_t j_, std::size_t k_) const
+    {
+      return (i_ * _grid_nodes_[1] + j_) * _grid_nodes_[2] + k_;
+    }
+
+    void em_field_cache::build_grid(const evaluator_type & evaluator_)
+    {
+      DT_THROW_IF(! has_grid_box(), std::logic_error, "No field grid box is defined !");
+      DT_THROW_IF(_time_dependent_, std::logic_error, "Time dependent fields cannot be sampled on a grid !");
+      std::size_t nnodes = 1;
+      for (int i = 0; i < 3; i++) {
+        const double length = _grid_max_[i] - _grid_min_[i];
+        _grid_nodes_[i] = std::max<std::size_t>(2, (std::size_t) std::ceil(length / _grid_step_[i] - 1.e-9) + 1);
+        _grid_step_[i] = length / (_grid_nodes_[i] - 1);
+        nnodes *= _grid_nodes_[i];
+        DT_THROW_IF(nnodes > MAX_GRID_NODES, std::logic_error,
+                    "Too many field grid nodes (maximum is " << MAX_GRID_NODES << ") !");
+      }
+      _grid_values_.assign(nnodes * _ncomponents_, 0.0);
+      _grid_valid_.assign(nnodes, 0);
+      double position[4];
+      position[POSTIME_T] = 0.0;
+      for (std::size_t i = 0; i < _grid_nodes_[0]; i++) {
+        position[POSTIME_X] = _grid_min_[0] + i * _grid_step_[0];
+        for (std::size_t j = 0; j < _grid_nodes_[1]; j++) {
+          position[POSTIME_Y] = _grid_min_[1] + j * _grid_step_[1];
+          for (std::size_t k = 0; k < _grid_nodes_[2]; k++) {
+            position[POSTIME_Z] = _grid_min_[2] + k * _grid_step_[2];
+            const std::size_t inode = _node_index_(i, j, k);
+            if (evaluator_(position, &_grid_values_[inode * _ncomponents_])) {
+              _grid_valid_[inode] = 1;
+            }
+          }
+        }
+      }
+      return;
+    }
+
+    bool em_field_cache::_interpolate_(const double position_[4], double * field_) const
+    {
+      std::size_t index[3];
+      double frac[3];
+      for (int i = 0; i < 3; i++) {
+        const double u = (position_[i] - _grid_min_[i]) / _grid_step_[i];
+        if (! (u >= 0.0 && u <= _grid_nodes_[i] - 1)) return false;
+        index[i] = std::min<std::size_t>((std::size_t) u, _grid_nodes_[i] - 2);
+        frac[i] = u - index[i];
+      }
+      std::size_t inodes[8];
+      for (int corner = 0; corner < 8; corner++) {
+        inodes[corner] = _node_index_(index[0] + (corner & 1),
+                                      index[1] + ((corner >> 1) & 1),
+                                      index[2] + ((corner >> 2) & 1));
+        if (! _grid_valid_[inodes[corner]]) return false;
+      }
+      for (unsigned int c = 0; c < _ncomponents_; c++) {
+        field_[c] = 0.0;
+      }
+      for (int corner = 0; corner < 8; corner++) {
+        const std::size_t di = corner & 1;
+        const std::size_t dj = (corner >> 1) & 1;
+        const std::size_t dk = (corner >> 2) & 1;
+        const std::size_t inode = inodes[corner];
+        const double weight = (di ? frac[0] : 1.0 - frac[0])
+          * (dj ? frac[1] : 1.0 - frac[1])
+          * (dk ? frac[2] : 1.0 - frac[2]);
+        const double * node_field = &_grid_values_[inode * _ncomponents_];
+        for (unsigned int c = 0; c < _ncomponents_; c++) {
+          field_[c] += weight * node_field[c];
+        }
+      }
+      return true;
+    }
+
+    bool em_field_cache::find(const double position_[4], double * field_) const
+    {
+      _calls_.fetch_add(1, std::memory_order_relaxed);
+      if (has_grid() && _interpolate_(position_, field_)) {
+        _grid_hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (! _enabled_) return false;
+      const thread_cache & tc = tl_cache;
+      const double tolerance2 = _tolerance_ * _tolerance_;
+      for (std::size_t islot = 0; islot < NUMBER_OF_SLOTS; islot++) {
+        const cache_slot & slot = tc.slots[islot];
+        if (slot.id != _id_) continue;
+        if (_time_dependent_
+            && ! (std::abs(position_[POSTIME_T] - slot.position[POSTIME_T]) <= _time_tolerance_)) continue;
+        const double dx = position_[POSTIME_X] - slot.position[POSTIME_X];
+        const double dy = position_[POSTIME_Y] - slot.position[POSTIME_Y];
+        const double dz = position_[POSTIME_Z] - slot.position[POSTIME_Z];
+        if (! (dx * dx + dy * dy + dz * dz <= tolerance2)) continue;
+        std::copy(slot.field, slot.field + _ncomponents_, field_);
+        _cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      return false;
+    }
+
+    void em_field_cache::store(const double position_[4], const double * field_) const
+    {
+      _evaluations_.fetch_add(1, std::memory_order_relaxed);
+      if (! _enabled_) return;
+      thread_cache & tc = tl_cache;
+      cache_slot & slot = tc.slots[tc.next];
+      slot.id = _id_;
+      std::copy(position_, position_ + 4, slot.position);
+      std::copy(field_, field_ + _ncomponents_, slot.field);
+      tc.next = (tc.next + 1) % NUMBER_OF_SLOTS;
+      return;
+    }
+
+    em_field_cache::stats_type em_field_cache::get_stats() const
+    {
+      stats_type stats;
+      stats.calls = _calls_.load(std::memory_order_relaxed);
+      stats.cache_hits = _cache_hits_.load(std::memory_order_relaxed);
+      stats.grid_hits = _grid_hits_.load(std::memory_order_relaxed);
+      stats.evaluations = _evaluations_.load(std::memory_order_relaxed);
+      return stats;
+    }
+
+    void em_field_cache::reset_stats()
+    {
+      _calls_ = 0;
+      _cache_hits_ = 0;
+      _grid_hits_ = 0;
+      _evaluations_ = 0;
+      return;
+    }
+
+    void em_field_cache::reset()
+    {
+      // A new identifier invalidates the values cached by all threads:
+      _id_ = new_cache_id();
+      _enabled_ = true;
+      _time_dependent_ = false;
+      _tolerance_ = 0.0;
+      _time_tolerance_ = 0.0;
+      for (int i = 0; i < 3; i++) {
+        _grid_min_[i] = 0.0;
+        _grid_max_[i] = 0.0;
+        _grid_step_[i] = 0.0;
+        _grid_nodes_[i] = 0;
+      }
+      _grid_values_.clear();
+      _grid_valid_.clear();
+      reset_stats();
+      return;
+    }
+
+    void em_field_cache::print_stats(std::ostream & out_,
+                                     std::size_t nevents_,
+                                     const std::string & indent_) const
+    {
+      const stats_type stats = get_stats();
+      out_ << indent_ << "|-- Field queries      : " << stats.calls << std::endl;
+      out_ << indent_ << "|-- Cache hits         : " << stats.cache_hits << std::endl;
+      out_ << indent_ << "|-- Grid hits          : " << stats.grid_hits << std::endl;
+      out_ << indent_ << "|-- Hit rate           : " << stats.hit_rate() << std::endl;
+      out_ << indent_ << (nevents_ > 0 ? "|-- " : "`-- ")
+           << "Field evaluations  : " << stats.evaluations << std::endl;
+      if (nevents_ > 0) {
+        out_ << indent_ << "`-- Evaluations/event  : "
+             << (double) stats.evaluations / nevents_ << std::endl;
+      }
+      return;
+    }
+
+  } // end of namespace g4
+
+} // end of namespace mctools
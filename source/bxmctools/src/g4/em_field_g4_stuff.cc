@@ -183,6 +183,21 @@ namespace mctools {
       return "";
     }
 
+    const em_field_cache & em_field_g4_stuff::get_g4_field_cache() const
+    {
+      DT_THROW_IF(!has_g4_field(), std::logic_error, "No G4 EM field is set!");
+      if (_b_field_) return _b_field_->get_cache();
+      return _eb_field_->get_cache();
+    }
+
+    void em_field_g4_stuff::reset_g4_field_cache_statistics()
+    {
+      DT_THROW_IF(!has_g4_field(), std::logic_error, "No G4 EM field is set!");
+      if (_b_field_) _b_field_->grab_cache().reset_stats();
+      if (_eb_field_) _eb_field_->grab_cache().reset_stats();
+      return;
+    }
+
     em_field_g4_stuff::em_field_g4_stuff()
     {
       _initialized_ = false;
@@ -100,6 +100,16 @@ namespace mctools {
       return *_field_;
     }
 
+    const em_field_cache & magnetic_field::get_cache() const
+    {
+      return _cache_;
+    }
+
+    em_field_cache & magnetic_field::grab_cache()
+    {
+      return _cache_;
+    }
+
     bool magnetic_field::is_active() const
     {
       return has_mag_field();
@@ -258,6 +268,26 @@ namespace mctools {
         _field_check_pos_time_ = true;
       }
 
+      if (has_field()) {
+        _cache_.set_number_of_components(3);
+        _cache_.set_time_dependent(_field_->magnetic_field_is_time_dependent());
+        _cache_.configure(config_);
+        if (_cache_.has_grid_box()) {
+          DT_LOG_NOTICE(_logprio(), "Sampling Geant4 magnetic field '" << get_name() << "' on a grid...");
+          _cache_.build_grid([this] (const double position_[4], double * b_field_) {
+              geomtools::vector_3d pos(position_[POSTIME_X], position_[POSTIME_Y], position_[POSTIME_Z]);
+              double time = position_[POSTIME_T];
+              if (! _field_->position_and_time_are_valid(pos, time)) return false;
+              geomtools::vector_3d the_b_field;
+              if (_field_->compute_magnetic_field(pos, time, the_b_field) != 0) return false;
+              b_field_[EMFIELD_BX] = the_b_field.x();
+              b_field_[EMFIELD_BY] = the_b_field.y();
+              b_field_[EMFIELD_BZ] = the_b_field.z();
+              return true;
+            });
+        }
+      }
+
       _initialized_ = true;
       return;
     }
@@ -270,6 +300,7 @@ namespace mctools {
       _initialized_ = false;
       _name_.clear();
       _field_ = 0;
+      _cache_.reset();
       _set_defaults();
 
       return;
@@ -286,7 +317,10 @@ namespace mctools {
       b_field_[EMFIELD_BX] = 0.0;
       b_field_[EMFIELD_BY] = 0.0;
       b_field_[EMFIELD_BZ] = 0.0;
-      if (_field_ != 0) {
+      if (_field_ != 0 && _cache_.find(position_, b_field_)) {
+        // Field value from the cache or the grid:
+        DT_LOG_TRACE(_logprio(), "Cached value for Geant4 magnetic field '" << get_name() << "'.");
+      } else if (_field_ != 0) {
         DT_LOG_TRACE(_logprio(), "Compute magnetic field for Geant4 magnetic field '" << get_name() << "'...");
         // DT_LOG_TRACE(datatools::logger::PRIO_ALWAYS, "Compute magnetic field for Geant4 magnetic field '" << get_name() << "'...");
         geomtools::vector_3d pos(position_[POSTIME_X], position_[POSTIME_Y], position_[POSTIME_Z]);
@@ -312,6 +346,7 @@ namespace mctools {
         b_field_[EMFIELD_BX] = the_b_field.x();
         b_field_[EMFIELD_BY] = the_b_field.y();
         b_field_[EMFIELD_BZ] = the_b_field.z();
+        _cache_.store(position_, b_field_);
       } else if (geomtools::is_valid(_standalone_constant_field_)) {
         b_field_[EMFIELD_BX] = _standalone_constant_field_.x();
         b_field_[EMFIELD_BY] = _standalone_constant_field_.y();
@@ -332,7 +367,10 @@ namespace mctools {
       } else {
         out_ << "|-- Magnetic field         : " << _field_ << std::endl;
       }
-      out_ << "`-- Check field pos/time   : " << _field_check_pos_time_ << std::endl;
+      out_ << "|-- Check field pos/time   : " << _field_check_pos_time_ << std::endl;
+      out_ << "`-- Field cache            : " << (_cache_.is_enabled() ? "enabled" : "disabled")
+           << (_cache_.has_grid() ? " (with grid)" : "") << std::endl;
+      _cache_.print_stats(out_, 0, "    ");
       return;
     }
 
@@ -320,6 +320,11 @@ namespace mctools {
       return *_user_event_action_;
     }
 
+    detector_construction& manager::grab_user_detector_construction() {
+      DT_THROW_IF(! _initialized_, std::logic_error, "Manager is not initialized !");
+      return *_user_detector_construction_;
+    }
+
 
     uint32_t manager::get_number_of_events() const {
       return _number_of_events_;
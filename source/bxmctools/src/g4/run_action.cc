@@ -65,6 +65,7 @@
 #include <mctools/utils.h>
 #include <mctools/g4/event_action.h>
 #include <mctools/g4/manager.h>
+#include <mctools/g4/detector_construction.h>
 #include <mctools/g4/simulation_ctrl.h>
 
 namespace mctools {
@@ -483,6 +484,11 @@ namespace mctools {
       DT_LOG_NOTICE(_logprio(),"# Run " << a_run->GetRunID() << " is starting...");
       _number_of_processed_events_ = 0;
       _number_of_saved_events_ = 0;
+      if (IsMaster()) {
+        // The field statistics are shared by all threads, they are reset and reported
+        // once per run by the master run action:
+        grab_manager().grab_user_detector_construction().reset_em_field_statistics();
+      }
 
       /*************************************************************/
       // External threaded run control :
@@ -713,6 +719,17 @@ namespace mctools {
         G4UImanager::GetUIpointer()->ApplyCommand("/vis/viewer/update");
       }
 
+      if (IsMaster() && _logprio() >= datatools::logger::PRIO_NOTICE) {
+        // Per event rates use the number of events processed by all threads:
+        std::ostringstream em_field_stats;
+        grab_manager().grab_user_detector_construction().print_em_field_statistics(em_field_stats,
+                                                                                  a_run->GetNumberOfEvent());
+        if (! em_field_stats.str().empty()) {
+          DT_LOG_NOTICE(_logprio(), "Electromagnetic field statistics for run #" << a_run->GetRunID()
+                        << " :" << std::endl << em_field_stats.str());
+        }
+      }
+
       DT_LOG_NOTICE(_logprio(),"Run #" << a_run->GetRunID() << " is stopped.");
       return;
     }
@@ -32,6 +32,7 @@
 #include <G4SDManager.hh>
 #include <G4Gamma.hh>
 #include <G4Neutron.hh>
+#include <G4Electron.hh>
 #include <G4VProcess.hh>
 
 namespace mctools {
@@ -42,6 +43,67 @@ namespace mctools {
     const size_t sensitive_detector::DEFAULT_HIT_BUFFER_CAPACITY;
     const double sensitive_detector::DEFAULT_MAJOR_TRACK_MINIMUM_ENERGY = 10. * CLHEP::keV;
 
+    int sensitive_detector::name_table::find(const void * key_) const
+    {
+      // Only a few distinct entries are expected, a linear scan is the fastest:
+      for (std::size_t i = 0; i < _keys_.size(); i++) {
+        if (_keys_[i] == key_) return (int) i;
+      }
+      return -1;
+    }
+
+    int sensitive_detector::name_table::add(const void * key_, const std::string & name_)
+    {
+      _keys_.push_back(key_);
+      _names_.push_back(name_);
+      return (int) _keys_.size() - 1;
+    }
+
+    const std::string & sensitive_detector::name_table::get_name(int id_) const
+    {
+      DT_THROW_IF(id_ < 0 || id_ >= (int) _names_.size(), std::range_error,
+                  "Invalid interned name ID [" << id_ << "]!");
+      return _names_[id_];
+    }
+
+    std::size_t sensitive_detector::name_table::size() const
+    {
+      return _names_.size();
+    }
+
+    void sensitive_detector::name_table::clear()
+    {
+      _keys_.clear();
+      _names_.clear();
+      return;
+    }
+
+    void sensitive_detector::set_minimal_hit(bool minimal_)
+    {
+      _minimal_hit_ = minimal_;
+      return;
+    }
+
+    bool sensitive_detector::is_minimal_hit() const
+    {
+      return _minimal_hit_;
+    }
+
+    const sensitive_detector::name_table & sensitive_detector::get_particle_table() const
+    {
+      return _particle_table_;
+    }
+
+    const sensitive_detector::name_table & sensitive_detector::get_material_table() const
+    {
+      return _material_table_;
+    }
+
+    const sensitive_detector::name_table & sensitive_detector::get_creator_process_table() const
+    {
+      return _creator_process_table_;
+    }
+
     bool sensitive_detector::is_drop_zero_energy_deposit_steps() const
     {
       return _drop_zero_energy_deposit_steps_;
@@ -445,6 +507,13 @@ namespace mctools {
         }
       }
 
+      // Record minimal hits
+      if (geomtools::sensitive::has_key(config_, sensitive_utils::SENSITIVE_MINIMAL_HIT)) {
+        const bool flag = geomtools::sensitive::has_flag(config_,
+                                                         sensitive_utils::SENSITIVE_MINIMAL_HIT);
+        set_minimal_hit(flag);
+      }
+
       // Drop steps with no energy deposit
       if (geomtools::sensitive::has_key(config_, sensitive_utils::SENSITIVE_DROP_ZERO_ENERGY_DEPOSIT)) {
         const bool flag = geomtools::sensitive::has_flag(config_,
@@ -504,6 +573,7 @@ namespace mctools {
       _record_step_length_             = false;
       _record_boundaries_              = false;
       _hits_buffer_capacity_           = DEFAULT_HIT_BUFFER_CAPACITY;
+      _minimal_hit_                    = false;
 
       // G4 Stuff:
       _HCID_ = -1; // Initialized with an invalid value
@@ -551,12 +621,17 @@ namespace mctools {
     {
       // Reset the internal ID if needed :
       for (int i = 0; i < _used_hits_count_; i++) {
-        _hits_buffer_[i].grab_hit_data().reset();
+        _hits_buffer_[i].reset();
       }
       _used_hits_count_ = 0;
       if (_hits_collection_ != nullptr) {
         _hits_collection_->grab_hits().clear();
       }
+      _particle_table_.clear();
+      _material_table_.clear();
+      _creator_process_table_.clear();
+      _SD_timer_ = nullptr;
+      _EA_timer_ = nullptr;
       return;
     }
 
@@ -581,7 +656,7 @@ namespace mctools {
 
       // Reset the hits in the buffer if needed :
       for (int i = 0; i < _used_hits_count_; i++) {
-        _hits_buffer_[i].grab_hit_data().reset();
+        _hits_buffer_[i].reset();
       }
       if (_hits_collection_ != nullptr) {
         _hits_collection_->grab_hits().clear();
@@ -590,9 +665,22 @@ namespace mctools {
       // Reset the hit counter :
       _used_hits_count_ = 0;
 
+      // Reset the tables of interned names:
+      _particle_table_.clear();
+      _material_table_.clear();
+      _creator_process_table_.clear();
+
+      // Resolve the timers once:
+      if (_manager_->using_time_stat() && _SD_timer_ == nullptr) {
+        _SD_timer_ = &_manager_->grab_CT_map()["SD"];
+        _EA_timer_ = &_manager_->grab_CT_map()["EA"];
+      }
+
       // Activates the track info mechanism if needed:
       bool track_history_request = false;
-      if (_record_delta_ray_from_alpha_
+      if (_minimal_hit_) {
+        // Minimal hits do not use the track history
+      } else if (_record_delta_ray_from_alpha_
           || _record_track_id_
           || _record_primary_particle_
           || _record_major_track_
@@ -617,6 +705,20 @@ namespace mctools {
       // Only if we have some hits :
       if (_used_hits_count_ > 0) {
 
+        // Resolve the interned names once per hit, out of the stepping loop:
+        for (int i = 0; i < _used_hits_count_; i++) {
+          sensitive_hit & a_hit = _hits_buffer_[i];
+          if (a_hit.get_particle_id() >= 0) {
+            a_hit.grab_hit_data().set_particle_name(_particle_table_.get_name(a_hit.get_particle_id()));
+          }
+          if (a_hit.get_material_id() >= 0) {
+            a_hit.grab_hit_data().set_material_name(_material_table_.get_name(a_hit.get_material_id()));
+          }
+          if (a_hit.get_creator_process_id() >= 0) {
+            a_hit.grab_hit_data().set_creator_process_name(_creator_process_table_.get_name(a_hit.get_creator_process_id()));
+          }
+        }
+
         // Set the hits collection pointer :
         if (_hits_collection_ == nullptr) {
           _hits_collection_ = new sensitive_hit_collection(SensitiveDetectorName,
@@ -693,14 +795,39 @@ namespace mctools {
         }
       }
 
-      if (_manager_->using_time_stat()) {
-        _manager_->grab_CT_map()["EA"].pause();
-        _manager_->grab_CT_map()["SD"].start();
+      if (_SD_timer_ != nullptr) {
+        _EA_timer_->pause();
+        _SD_timer_->start();
       }
 
-      const std::string track_particle_name = step_->GetTrack()->GetDefinition()->GetParticleName();
       const int track_id        = step_->GetTrack()->GetTrackID();
       const int parent_track_id = step_->GetTrack()->GetParentID();
+
+      if (_minimal_hit_) {
+        // Only record the position, time, energy deposit and track IDs:
+        sensitive_hit & a_hit = _grab_new_hit_();
+        base_step_hit & hit_data = a_hit.grab_hit_data();
+        hit_data.set_time_start(step_->GetPreStepPoint()->GetGlobalTime());
+        hit_data.set_time_stop(step_->GetPostStepPoint()->GetGlobalTime());
+        hit_data.set_position_start(step_->GetPreStepPoint()->GetPosition());
+        hit_data.set_position_stop(step_->GetPostStepPoint()->GetPosition());
+        hit_data.set_energy_deposit(energy_deposit);
+        hit_data.set_track_id(track_id);
+        hit_data.set_parent_track_id(parent_track_id);
+        if (_SD_timer_ != nullptr) {
+          _SD_timer_->stop();
+          _EA_timer_->resume();
+        }
+        DT_LOG_TRACE(_logprio(),"Exiting.");
+        return true;
+      }
+
+      // Intern the particle name:
+      const G4ParticleDefinition * track_particle = step_->GetTrack()->GetDefinition();
+      int particle_id = _particle_table_.find(track_particle);
+      if (particle_id < 0) {
+        particle_id = _particle_table_.add(track_particle, track_particle->GetParticleName());
+      }
       /*
       const double global_time  = step_->GetTrack()->GetGlobalTime();
       const double local_time   = step_->GetTrack()->GetLocalTime();
@@ -718,32 +845,28 @@ namespace mctools {
       // Grabbing the track history to fill G4 track info
       track_history & the_track_history = _manager_->grab_track_history();
       if (_manager_->has_track_history()) {
-        if ((_track_info_ptr_ == nullptr) || (_track_info_ptr_->get_id() != track_id)) {
-          // Here we don't have current track info at hand:
-          if (! the_track_history.has_track_info(track_id)) {
-            // infos about this track are not registered yet,
-            // we add a new record and link it :
-            track_history::track_info dummy;
-            the_track_history.add_track_info(track_id, dummy);
-            track_history::track_info & ti = the_track_history.grab_track_info(track_id);
-            ti.set_id(track_id);
-            ti.set_parent_id(parent_track_id);
-            ti.set_particle_name(track_particle_name);
-            if (step_->GetTrack()->GetCreatorProcess()) {
-              const std::string & process_name
-                = step_->GetTrack()->GetCreatorProcess()->GetProcessName();
-              ti.set_creator_process_name(process_name);
-            }
-            // const std::string & category = get_sensitive_category();
-            // ti.set_creator_sensitive_category(category);
-            _track_info_ptr_ = &ti;
-            _parent_track_info_ptr_ = nullptr;
-          } else {
-            // infos about this track have already been registered, we link it:
-            _track_info_ptr_ = &the_track_history.grab_track_info(track_id);
-            _parent_track_info_ptr_ = nullptr;
-         }
+        // The track history is a dense array indexed by track Id, so the lookup
+        // is done at each step (cached addresses would not survive the growth
+        // of the array when other tracks are added):
+        if (! the_track_history.has_track_info(track_id)) {
+          // infos about this track are not registered yet,
+          // we add a new record and link it :
+          track_history::track_info dummy;
+          the_track_history.add_track_info(track_id, dummy);
+          track_history::track_info & ti = the_track_history.grab_track_info(track_id);
+          ti.set_id(track_id);
+          ti.set_parent_id(parent_track_id);
+          ti.set_particle_name(_particle_table_.get_name(particle_id));
+          if (step_->GetTrack()->GetCreatorProcess()) {
+            const std::string & process_name
+              = step_->GetTrack()->GetCreatorProcess()->GetProcessName();
+            ti.set_creator_process_name(process_name);
+          }
+          // const std::string & category = get_sensitive_category();
+          // ti.set_creator_sensitive_category(category);
         }
+        _track_info_ptr_ = &the_track_history.get_track_info(track_id);
+        _parent_track_info_ptr_ = nullptr;
         primary_track = _track_info_ptr_->is_primary();
 
         // Set the 'major_track' flag :
@@ -763,16 +886,11 @@ namespace mctools {
           /* Identify a delta-ray generated along
            * the track of an alpha particle:
            */
-          if (track_particle_name == "e-" && ! primary_track) {
-            // this is a secondary electron from a parent track:
-            if ((_parent_track_info_ptr_ == nullptr) ||
-               (_parent_track_info_ptr_->get_id() != parent_track_id)) {
-              // we don't have current parent track info at hand
-              // so we try to find it in the track info dictionnary:
-              if (the_track_history.has_track_info(parent_track_id)) {
-                // if found, make it the current link:
-                _parent_track_info_ptr_ = &the_track_history.grab_track_info(parent_track_id);
-              }
+          if (track_particle == G4Electron::ElectronDefinition() && ! primary_track) {
+            // this is a secondary electron from a parent track,
+            // we try to find it in the track history:
+            if (the_track_history.has_track_info(parent_track_id)) {
+              _parent_track_info_ptr_ = &the_track_history.get_track_info(parent_track_id);
             }
 
             // if the parent track has been identified and it is an alpha particle:
@@ -786,31 +904,8 @@ namespace mctools {
 
       } // if (_using_track_infos)
 
-      if (_used_hits_count_ == (int) _hits_buffer_.size()) {
-        //unsigned int osize = _hits_buffer.size();
-        sensitive_hit a_hit;
-        _hits_buffer_.push_back(a_hit);
-        //unsigned int nsize = _hits_buffer.size();
-        // cerr << datatools::io::devel
-        //      << "snemo::g4::sensitive_detector::ProcessHits: "
-        //      << "Increase the size of the buffer of sensitive hits for detector '"
-        //      << _sensitive_category_ << "' from " << osize
-        //      << " to " << nsize << "(capacity=" << _hits_buffer.capacity() << ")!"
-        //      << endl;
-      }
-      // Increment the hit counter :
-      _used_hits_count_++;
-
-      sensitive_hit * new_hit = &_hits_buffer_[_used_hits_count_ - 1];
+      sensitive_hit * new_hit = &_grab_new_hit_();
 
-      DT_LOG_TRACE(_logprio(), "Buffer size = " << _hits_buffer_.size());
-      DT_LOG_TRACE(_logprio(), "Hit count = " << _used_hits_count_);
-      DT_LOG_TRACE(_logprio(), "New hit @ " << new_hit << " : ");
-      if (_logprio() == datatools::logger::PRIO_TRACE){
-        new_hit->get_hit_data().tree_dump(std::cerr);
-      }
-
-      _number_of_sensitive_steps_++;
       // 2011-05-26 FM : was using "step_->GetTrack()->GetGlobalTime()";
       const double time_start = step_->GetPreStepPoint()->GetGlobalTime();
       const double time_stop = step_->GetPostStepPoint()->GetGlobalTime();
@@ -819,7 +914,7 @@ namespace mctools {
       new_hit->grab_hit_data().set_position_start(step_->GetPreStepPoint()->GetPosition());
       new_hit->grab_hit_data().set_position_stop(step_->GetPostStepPoint()->GetPosition());
       new_hit->grab_hit_data().set_energy_deposit(energy_deposit);
-      new_hit->grab_hit_data().set_particle_name(track_particle_name);
+      new_hit->set_particle_id(particle_id);
 
       // Add optional data :
       if (_record_momentum_) {
@@ -862,8 +957,13 @@ namespace mctools {
       const bool use_track_info = _manager_->has_track_history();
       if (use_track_info) {
         // special features:
-        if (_record_creator_process_ && ! _track_info_ptr_->get_creator_process_name().empty()) {
-          new_hit->grab_hit_data().set_creator_process_name(_track_info_ptr_->get_creator_process_name());
+        const G4VProcess * creator_process = step_->GetTrack()->GetCreatorProcess();
+        if (_record_creator_process_ && creator_process != nullptr) {
+          int process_id = _creator_process_table_.find(creator_process);
+          if (process_id < 0) {
+            process_id = _creator_process_table_.add(creator_process, creator_process->GetProcessName());
+          }
+          new_hit->set_creator_process_id(process_id);
           // hit_aux.store_string(mctools::track_utils::CREATOR_PROCESS_KEY,
           //                   _track_info_ptr_->get_creator_process_name());
         }
@@ -901,9 +1001,13 @@ namespace mctools {
         static std::string material_ref_key =
           geomtools::material::make_key(geomtools::material::material_ref_property());
         const G4Material * the_g4_material = step_->GetTrack()->GetMaterial();
-        std::string material_ref = the_g4_material->GetName().data();
-        boost::replace_all(material_ref, "__" , "::");
-        new_hit->grab_hit_data().set_material_name(material_ref);
+        int material_id = _material_table_.find(the_g4_material);
+        if (material_id < 0) {
+          std::string material_ref = the_g4_material->GetName().data();
+          boost::replace_all(material_ref, "__" , "::");
+          material_id = _material_table_.add(the_g4_material, material_ref);
+        }
+        new_hit->set_material_id(material_id);
         // hit_aux.store_string(material_ref_key, material_ref);
       }
 
@@ -922,15 +1026,37 @@ namespace mctools {
         // hit_aux.store_integer(sensitive_utils::SENSITIVE_G4_VOLUME_COPY_NUMBER_KEY, volume->GetCopyNo());
       }
 
-      if (_manager_->using_time_stat()) {
-        _manager_->grab_CT_map()["SD"].stop();
-        _manager_->grab_CT_map()["EA"].resume();
+      if (_SD_timer_ != nullptr) {
+        _SD_timer_->stop();
+        _EA_timer_->resume();
       }
 
       DT_LOG_TRACE(_logprio(),"Exiting.");
       return true;
     }
 
+    sensitive_hit & sensitive_detector::_grab_new_hit_()
+    {
+      if (_used_hits_count_ == (int) _hits_buffer_.size()) {
+        sensitive_hit a_hit;
+        _hits_buffer_.push_back(a_hit);
+      }
+      // Increment the hit counter :
+      _used_hits_count_++;
+
+      sensitive_hit & new_hit = _hits_buffer_[_used_hits_count_ - 1];
+
+      DT_LOG_TRACE(_logprio(), "Buffer size = " << _hits_buffer_.size());
+      DT_LOG_TRACE(_logprio(), "Hit count = " << _used_hits_count_);
+      DT_LOG_TRACE(_logprio(), "New hit @ " << &new_hit << " : ");
+      if (_logprio() == datatools::logger::PRIO_TRACE){
+        new_hit.get_hit_data().tree_dump(std::cerr);
+      }
+
+      _number_of_sensitive_steps_++;
+      return new_hit;
+    }
+
     void sensitive_detector::tree_dump(std::ostream & out_,
                                        const std::string & title_,
                                        const std::string & indent_,
@@ -1042,6 +1168,10 @@ namespace mctools {
         out_ << indent << datatools::i_tree_dumpable::tag
              << "Hits buffer capacity        : "
              << _hits_buffer_capacity_ << std::endl;
+
+        out_ << indent << datatools::i_tree_dumpable::tag
+             << "Minimal hit                 : "
+             << (_minimal_hit_ ? "Yes" : "No") << std::endl;
       }
 
       // {
@@ -1496,6 +1626,27 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(mctools::g4::sensitive_detector,ocd_)
       ;
   }
 
+  {
+    // Description of the 'minimal_hit' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("sensitive.minimal_hit")
+      .set_terse_description("Record only the position, time, energy deposit and track IDs of hits")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_default_value_boolean(false)
+      .set_long_description("All other 'record_XXX' options are ignored and the  \n"
+                            "track history is not used. This is the cheapest mode\n"
+                            "for high statistics runs.                           \n"
+                            "                                                    \n"
+                            "Example::                                           \n"
+                            "                                                    \n"
+                            "  sensitive.minimal_hit : boolean = 1               \n"
+                            "                                                    \n"
+                            )
+      ;
+  }
+
   // Additionnal configuration hints :
   ocd_.set_configuration_hints("Typical configuration is::                                             \n"
                                "                                                                       \n"
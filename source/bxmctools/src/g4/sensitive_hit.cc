@@ -25,6 +25,42 @@ namespace mctools {
     void sensitive_hit::reset()
     {
       _hit_data_.reset();
+      _particle_id_ = -1;
+      _material_id_ = -1;
+      _creator_process_id_ = -1;
+      return;
+    }
+
+    int sensitive_hit::get_particle_id() const
+    {
+      return _particle_id_;
+    }
+
+    void sensitive_hit::set_particle_id(int id_)
+    {
+      _particle_id_ = id_;
+      return;
+    }
+
+    int sensitive_hit::get_material_id() const
+    {
+      return _material_id_;
+    }
+
+    void sensitive_hit::set_material_id(int id_)
+    {
+      _material_id_ = id_;
+      return;
+    }
+
+    int sensitive_hit::get_creator_process_id() const
+    {
+      return _creator_process_id_;
+    }
+
+    void sensitive_hit::set_creator_process_id(int id_)
+    {
+      _creator_process_id_ = id_;
       return;
     }
 
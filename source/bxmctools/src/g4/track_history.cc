@@ -17,6 +17,15 @@ namespace mctools {
 
     // static
     const int track_history::track_info::TRACK_ID_UNSET;
+    const int track_history::track_info::NAME_ID_UNSET;
+
+    namespace {
+      const std::string & _empty_name_()
+      {
+        static const std::string _empty;
+        return _empty;
+      }
+    }
 
     int track_history::track_info::get_id () const
     {
@@ -45,40 +54,66 @@ namespace mctools {
       return _parent_id_ == TRACK_ID_UNSET;
     }
 
+    int track_history::track_info::get_particle_name_id () const
+    {
+      return _particle_name_id_;
+    }
+
     const std::string & track_history::track_info::get_particle_name () const
     {
-      return _particle_name_;
+      if (_particle_name_id_ == NAME_ID_UNSET) return _empty_name_();
+      return _history_->get_name(_particle_name_id_);
     }
 
     void track_history::track_info::set_particle_name (const std::string & name_)
     {
-      _particle_name_ = name_;
+      DT_THROW_IF (_history_ == nullptr, std::logic_error,
+                   "Track info is not attached to a track history!");
+      _particle_name_id_ = _history_->intern_name(name_);
+      return;
+    }
+
+    int track_history::track_info::get_creator_process_name_id () const
+    {
+      return _creator_process_name_id_;
     }
 
     const std::string & track_history::track_info::get_creator_process_name () const
     {
-      return _creator_process_name_;
+      if (_creator_process_name_id_ == NAME_ID_UNSET) return _empty_name_();
+      return _history_->get_name(_creator_process_name_id_);
     }
 
     void track_history::track_info::set_creator_process_name (const std::string & name_)
     {
-      _creator_process_name_ = name_;
+      DT_THROW_IF (_history_ == nullptr, std::logic_error,
+                   "Track info is not attached to a track history!");
+      _creator_process_name_id_ = _history_->intern_name(name_);
+      return;
     }
 
     const std::string & track_history::track_info::get_creator_sensitive_category () const
     {
-      return _creator_sensitive_category_;
+      if (_creator_sensitive_category_id_ == NAME_ID_UNSET) return _empty_name_();
+      return _history_->get_name(_creator_sensitive_category_id_);
     }
 
     void track_history::track_info::set_creator_sensitive_category (const std::string & category_)
     {
-      _creator_sensitive_category_ = category_;
+      DT_THROW_IF (_history_ == nullptr, std::logic_error,
+                   "Track info is not attached to a track history!");
+      _creator_sensitive_category_id_ = _history_->intern_name(category_);
+      return;
     }
 
     void track_history::track_info::reset ()
     {
       _id_        = TRACK_ID_UNSET;
       _parent_id_ = TRACK_ID_UNSET;
+      _particle_name_id_ = NAME_ID_UNSET;
+      _creator_process_name_id_ = NAME_ID_UNSET;
+      _creator_sensitive_category_id_ = NAME_ID_UNSET;
+      return;
     }
 
     track_history::track_info::track_info ()
@@ -89,7 +124,6 @@ namespace mctools {
 
     track_history::track_info::~track_info ()
     {
-      reset ();
       return;
     }
 
@@ -98,21 +132,22 @@ namespace mctools {
       return _track_infos_;
     }
 
-    track_history::track_info_dict_type & track_history::grab_track_infos ()
+    std::size_t track_history::get_number_of_tracks () const
     {
-      return _track_infos_;
+      return _number_of_tracks_;
     }
 
     bool track_history::has_track_info (const int id_) const
     {
-      return _track_infos_.find (id_) != _track_infos_.end ();
+      if (id_ <= track_info::TRACK_ID_UNSET || id_ >= (int) _track_infos_.size()) return false;
+      return _track_infos_[id_]._id_ == id_;
     }
 
     const track_history::track_info & track_history::get_track_info (const int id_) const
     {
       DT_THROW_IF (! has_track_info(id_), std::logic_error,
                    "No track with id " << id_ << " has been stored!");
-      return _track_infos_.at (id_);
+      return _track_infos_[id_];
     }
 
     track_history::track_info & track_history::grab_track_info (const int id_)
@@ -124,9 +159,61 @@ namespace mctools {
 
     void track_history::add_track_info (const int id_, const track_info & tinfo_)
     {
+      DT_THROW_IF (id_ <= track_info::TRACK_ID_UNSET, std::logic_error,
+                   "Invalid track id '" << id_ << "'!");
       DT_THROW_IF (has_track_info(id_), std::logic_error,
                    "A track with id '" << id_ << "' already exist!");
-      _track_infos_[id_] = tinfo_;
+      if (id_ >= (int) _track_infos_.size()) {
+        _track_infos_.resize(id_ + 1);
+      }
+      track_info & ti = _track_infos_[id_];
+      ti = tinfo_;
+      if (tinfo_._history_ != this) {
+        // Names interned by another history must be interned again:
+        ti._particle_name_id_ = track_info::NAME_ID_UNSET;
+        ti._creator_process_name_id_ = track_info::NAME_ID_UNSET;
+        ti._creator_sensitive_category_id_ = track_info::NAME_ID_UNSET;
+        ti._history_ = this;
+        if (tinfo_._history_ != nullptr) {
+          ti.set_particle_name(tinfo_.get_particle_name());
+          ti.set_creator_process_name(tinfo_.get_creator_process_name());
+          ti.set_creator_sensitive_category(tinfo_.get_creator_sensitive_category());
+        }
+      }
+      ti._id_ = id_;
+      _number_of_tracks_++;
+      return;
+    }
+
+    int track_history::intern_name (const std::string & name_)
+    {
+      if (name_.empty()) return track_info::NAME_ID_UNSET;
+      std::unordered_map<std::string, int>::const_iterator found = _name_ids_.find(name_);
+      if (found != _name_ids_.end()) return found->second;
+      const int name_id = (int) _names_.size();
+      _names_.push_back(name_);
+      _name_ids_[name_] = name_id;
+      return name_id;
+    }
+
+    int track_history::find_name_id (const std::string & name_) const
+    {
+      std::unordered_map<std::string, int>::const_iterator found = _name_ids_.find(name_);
+      if (found == _name_ids_.end()) return track_info::NAME_ID_UNSET;
+      return found->second;
+    }
+
+    const std::string & track_history::get_name (const int name_id_) const
+    {
+      DT_THROW_IF (name_id_ < 0 || name_id_ >= (int) _names_.size(), std::range_error,
+                   "Invalid name id [" << name_id_ << "]!");
+      return _names_[name_id_];
+    }
+
+    void track_history::reserve (const std::size_t ntracks_)
+    {
+      _track_infos_.reserve(ntracks_ + 1);
+      return;
     }
 
     track_history::track_history ()
@@ -136,13 +223,14 @@ namespace mctools {
 
     track_history::~track_history ()
     {
-      reset();
       return;
     }
 
     void track_history::reset()
     {
+      // The capacity of the array is kept for the next event:
       _track_infos_.clear();
+      _number_of_tracks_ = 0;
       return;
     }
 
@@ -25,6 +25,9 @@
 // Ourselves:
 #include <mctools/signal/multi_signal_shape.h>
 
+// Standard library:
+#include <algorithm>
+
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/exception.h>
@@ -154,7 +157,24 @@ namespace mctools {
       DT_THROW_IF(key_.empty(), std::logic_error, "Invalid functor key!");
       DT_THROW_IF(!shape_.get().is_initialized(), std::logic_error, "Component functor is not initialized!");
       DT_THROW_IF(!std::isfinite(time_shift_), std::logic_error, "Invalid component timeshift!");
-      DT_THROW_IF(!std::isfinite(scaling_), std::logic_error, "Invalid component timeshift!");
+      DT_THROW_IF(!std::isfinite(scaling_), std::logic_error, "Invalid component scaling!");
+      component_record cr(key_, shape_, time_shift_, scaling_);
+      std::size_t pos = _components_.size();
+      _components_.push_back(cr);
+      _recompute_();
+      return pos;
+    }
+
+    std::size_t multi_signal_shape::add(const std::string & key_,
+                                        const mygsl::i_unary_function & shape_,
+                                        double time_shift_,
+                                        double scaling_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Signal shape is already initialized!");
+      DT_THROW_IF(key_.empty(), std::logic_error, "Invalid functor key!");
+      DT_THROW_IF(!shape_.is_initialized(), std::logic_error, "Component functor is not initialized!");
+      DT_THROW_IF(!std::isfinite(time_shift_), std::logic_error, "Invalid component timeshift!");
+      DT_THROW_IF(!std::isfinite(scaling_), std::logic_error, "Invalid component scaling!");
       component_record cr(key_, shape_, time_shift_, scaling_);
       std::size_t pos = _components_.size();
       _components_.push_back(cr);
@@ -316,6 +336,39 @@ namespace mctools {
       return res;
     }
 
+    void multi_signal_shape::_sample_no_check(double x0_, double dx_,
+                                              std::size_t first_, std::size_t last_,
+                                              double * out_) const
+    {
+      std::fill(out_ + first_, out_ + last_, 0.0);
+      // Components are sampled by chunks in a stack buffer:
+      static const std::size_t CHUNK_SIZE = 256;
+      double buffer[CHUNK_SIZE];
+      for (const auto & fcomp : _components_) {
+        const double scaling = fcomp.get_scaling();
+        if (scaling == 0.0) continue;
+        const mygsl::i_unary_function & func = fcomp.sh();
+        const double xc0 = x0_ - fcomp.get_time_shift();
+        // Only the samples lying in the non-zero domain of the component are computed:
+        std::size_t cfirst = first_;
+        std::size_t clast = last_;
+        if (!func.has_explicit_domain_of_definition()) {
+          func.compute_non_zero_sample_range(xc0, dx_, last_, cfirst, clast);
+          if (cfirst < first_) cfirst = first_;
+          if (clast <= cfirst) continue;
+        }
+        for (std::size_t ic = cfirst; ic < clast; ic += CHUNK_SIZE) {
+          const std::size_t nc = std::min(CHUNK_SIZE, clast - ic);
+          func.sample(xc0 + ic * dx_, dx_, nc, buffer);
+          double * out = out_ + ic;
+          for (std::size_t i = 0; i < nc; i++) {
+            out[i] += scaling * buffer[i];
+          }
+        }
+      }
+      return;
+    }
+
     void multi_signal_shape::tree_dump(std::ostream & out_,
                                        const std::string & title_,
                                        const std::string & indent_,
@@ -320,6 +320,41 @@ namespace mctools {
       return res;
     }
 
+    void triangle_gate_signal_shape::_sample_no_check(double x0_, double dx_,
+                                                      std::size_t first_, std::size_t last_,
+                                                      double * out_) const
+    {
+      // The sampling range is split in the successive linear pieces of the
+      // signal so that no branch is needed in the inner loops:
+      const double sign = (_polarity_ == POLARITY_NEGATIVE) ? -1.0 : 1.0;
+      std::size_t i = first_;
+      for (; i < last_; i++) {
+        const double t = x0_ + i * dx_;
+        if (t > _t0_) break;
+        out_[i] = 0.0;
+      }
+      for (; i < last_; i++) {
+        const double t = x0_ + i * dx_;
+        if (!(t < _t1_)) break;
+        out_[i] = sign * (_a_rise_ * t + _b_rise_);
+      }
+      const double plateau = sign * _amplitude_;
+      for (; i < last_; i++) {
+        const double t = x0_ + i * dx_;
+        if (!(t < _t2_)) break;
+        out_[i] = plateau;
+      }
+      for (; i < last_; i++) {
+        const double t = x0_ + i * dx_;
+        if (!(t < _t3_)) break;
+        out_[i] = sign * (_a_fall_ * t + _b_fall_);
+      }
+      for (; i < last_; i++) {
+        out_[i] = 0.0;
+      }
+      return;
+    }
+
     void triangle_gate_signal_shape::tree_dump(std::ostream & out_,
                                                const std::string & title_,
                                                const std::string & indent_,
@@ -288,6 +288,31 @@ namespace mctools {
       return res;
     }
 
+    void triangle_signal_shape::_sample_no_check(double x0_, double dx_,
+                                                 std::size_t first_, std::size_t last_,
+                                                 double * out_) const
+    {
+      // Same arithmetic as the embedded triangle function, without the
+      // per-sample virtual calls and domain checks:
+      const double sign = (_polarity_ == POLARITY_NEGATIVE) ? -1.0 : 1.0;
+      const double amplitude = _amplitude_;
+      const double head_width = _t1_ - _t0_;
+      const double tail_width = _t2_ - _t1_;
+      std::size_t i = first_;
+      // Rising edge:
+      for (; i < last_; i++) {
+        const double x = (x0_ + i * dx_) - _t1_;
+        if (!(x < 0.0)) break;
+        out_[i] = sign * (amplitude + x * amplitude / head_width);
+      }
+      // Falling edge:
+      for (; i < last_; i++) {
+        const double x = (x0_ + i * dx_) - _t1_;
+        out_[i] = sign * (amplitude - x * amplitude / tail_width);
+      }
+      return;
+    }
+
     void triangle_signal_shape::tree_dump(std::ostream & out_,
                                           const std::string & title_,
                                           const std::string & indent_,
@@ -0,0 +1,403 @@
+// simulated_data_index.cc
+
+// Ourselves:
+#include <mctools/simulated_data_index.h>
+
+// Standard library:
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+// Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+// - Bayeux/brio:
+#include <brio/utils.h>
+
+// This project:
+#include <mctools/simulated_data.h>
+#include <mctools/simulated_data_reader.h>
+
+namespace mctools {
+
+  namespace {
+
+    /// Header of the sidecar files
+    const std::string & sidecar_header()
+    {
+      static const std::string _h("#@mctools::simulated_data_index");
+      return _h;
+    }
+
+    /// Format version of the sidecar files
+    const int SIDECAR_VERSION = 2;
+
+    /// Return the resolved path of a data file
+    std::string resolve_filename(const std::string & filename_)
+    {
+      std::string filename = filename_;
+      datatools::fetch_path_with_env(filename);
+      return filename;
+    }
+
+    /// Fetch the size and the last write time of a data file (false if not available)
+    bool fetch_file_stamp(const std::string & filename_, std::uintmax_t & size_, std::time_t & time_)
+    {
+      boost::system::error_code ec;
+      size_ = boost::filesystem::file_size(filename_, ec);
+      if (ec) return false;
+      time_ = boost::filesystem::last_write_time(filename_, ec);
+      if (ec) return false;
+      return true;
+    }
+
+  }
+
+  // static
+  const std::string & simulated_data_index::sidecar_extension()
+  {
+    static const std::string _ext(".sdidx");
+    return _ext;
+  }
+
+  simulated_data_index::simulated_data_index()
+  {
+    return;
+  }
+
+  simulated_data_index::~simulated_data_index()
+  {
+    return;
+  }
+
+  void simulated_data_index::add_summary(const std::string & name_, const summary_function_type & function_)
+  {
+    DT_THROW_IF(name_.empty() || name_.find_first_of(" \t\n") != std::string::npos,
+                std::logic_error, "Invalid summary name '" << name_ << "'!");
+    DT_THROW_IF(!function_, std::logic_error, "Missing function for summary '" << name_ << "'!");
+    if (has_summary(name_)) {
+      // Summary loaded from a sidecar file:
+      std::size_t isum = get_summary_index(name_);
+      DT_THROW_IF(_summary_functions_[isum], std::logic_error,
+                  "Summary '" << name_ << "' is already defined!");
+      _summary_functions_[isum] = function_;
+      return;
+    }
+    DT_THROW_IF(!_files_.empty() || _file_open_, std::logic_error,
+                "Cannot add summary '" << name_ << "' to a non empty index!");
+    _summary_names_.push_back(name_);
+    _summary_functions_.push_back(function_);
+    return;
+  }
+
+  std::size_t simulated_data_index::get_number_of_summaries() const
+  {
+    return _summary_names_.size();
+  }
+
+  bool simulated_data_index::has_summary(const std::string & name_) const
+  {
+    return std::find(_summary_names_.begin(), _summary_names_.end(), name_) != _summary_names_.end();
+  }
+
+  std::size_t simulated_data_index::get_summary_index(const std::string & name_) const
+  {
+    std::vector<std::string>::const_iterator found
+      = std::find(_summary_names_.begin(), _summary_names_.end(), name_);
+    DT_THROW_IF(found == _summary_names_.end(), std::logic_error,
+                "No summary named '" << name_ << "'!");
+    return found - _summary_names_.begin();
+  }
+
+  const std::vector<std::string> & simulated_data_index::get_summary_names() const
+  {
+    return _summary_names_;
+  }
+
+  void simulated_data_index::build(const std::vector<std::string> & filenames_)
+  {
+    clear();
+    for (const std::string & filename : filenames_) {
+      begin_file(filename);
+      simulated_data_reader::scan_file(_files_.back().filename,
+                                       [this](simulated_data & sd_) {
+                                         add_entry(sd_);
+                                         return true;
+                                       });
+      end_file();
+    }
+    return;
+  }
+
+  void simulated_data_index::begin_file(const std::string & filename_)
+  {
+    DT_THROW_IF(_file_open_, std::logic_error, "A data file is already being indexed!");
+    for (std::size_t isum = 0; isum < _summary_functions_.size(); isum++) {
+      DT_THROW_IF(!_summary_functions_[isum], std::logic_error,
+                  "Missing function for summary '" << _summary_names_[isum] << "'!");
+    }
+    file_record frec;
+    frec.filename = resolve_filename(filename_);
+    int mode = 0;
+    frec.brio = (brio::store_info::guess_mode_from_filename(frec.filename, mode) == brio::store_info::SUCCESS);
+    frec.first_entry = get_number_of_entries();
+    frec.number_of_entries = 0;
+    frec.min_summaries.assign(_summary_names_.size(), std::numeric_limits<double>::quiet_NaN());
+    frec.max_summaries.assign(_summary_names_.size(), std::numeric_limits<double>::quiet_NaN());
+    _files_.push_back(frec);
+    _file_open_ = true;
+    return;
+  }
+
+  void simulated_data_index::add_entry(const simulated_data & sd_)
+  {
+    DT_THROW_IF(!_file_open_, std::logic_error, "No data file is being indexed!");
+    file_record & frec = _files_.back();
+    for (std::size_t isum = 0; isum < _summary_functions_.size(); isum++) {
+      const double value = _summary_functions_[isum](sd_);
+      _summaries_.push_back(value);
+      if (frec.number_of_entries == 0 || value < frec.min_summaries[isum]) {
+        frec.min_summaries[isum] = value;
+      }
+      if (frec.number_of_entries == 0 || value > frec.max_summaries[isum]) {
+        frec.max_summaries[isum] = value;
+      }
+    }
+    frec.number_of_entries++;
+    return;
+  }
+
+  void simulated_data_index::end_file()
+  {
+    DT_THROW_IF(!_file_open_, std::logic_error, "No data file is being indexed!");
+    file_record & frec = _files_.back();
+    DT_THROW_IF(!fetch_file_stamp(frec.filename, frec.file_size, frec.last_write_time),
+                std::runtime_error, "Cannot access data file '" << frec.filename << "'!");
+    _file_open_ = false;
+    return;
+  }
+
+  std::size_t simulated_data_index::get_number_of_files() const
+  {
+    return _files_.size();
+  }
+
+  const simulated_data_index::file_record &
+  simulated_data_index::get_file(std::size_t file_index_) const
+  {
+    DT_THROW_IF(file_index_ >= _files_.size(), std::range_error,
+                "Invalid data file index [" << file_index_ << "]!");
+    return _files_[file_index_];
+  }
+
+  std::size_t simulated_data_index::get_number_of_entries() const
+  {
+    if (_files_.empty()) return 0;
+    return _files_.back().first_entry + _files_.back().number_of_entries;
+  }
+
+  void simulated_data_index::locate(std::size_t entry_,
+                                    std::size_t & file_index_,
+                                    std::size_t & file_entry_) const
+  {
+    DT_THROW_IF(entry_ >= get_number_of_entries(), std::range_error,
+                "Invalid entry [" << entry_ << "]!");
+    // Last file whose first entry is not after the requested one, skipping empty files:
+    std::vector<file_record>::const_iterator found
+      = std::upper_bound(_files_.begin(), _files_.end(), entry_,
+                         [](std::size_t entry_value_, const file_record & frec_) {
+                           return entry_value_ < frec_.first_entry;
+                         });
+    --found;
+    while (found->number_of_entries == 0) --found;
+    file_index_ = found - _files_.begin();
+    file_entry_ = entry_ - found->first_entry;
+    return;
+  }
+
+  double simulated_data_index::get_summary(std::size_t entry_, std::size_t summary_index_) const
+  {
+    DT_THROW_IF(entry_ >= get_number_of_entries(), std::range_error,
+                "Invalid entry [" << entry_ << "]!");
+    DT_THROW_IF(summary_index_ >= _summary_names_.size(), std::range_error,
+                "Invalid summary index [" << summary_index_ << "]!");
+    return _summaries_[entry_ * _summary_names_.size() + summary_index_];
+  }
+
+  bool simulated_data_index::matches(const std::vector<std::string> & filenames_) const
+  {
+    if (filenames_.size() != _files_.size()) return false;
+    for (std::size_t i = 0; i < filenames_.size(); i++) {
+      const file_record & frec = _files_[i];
+      if (resolve_filename(filenames_[i]) != frec.filename) return false;
+      // The data file must not have been modified since its indexing:
+      std::uintmax_t size = 0;
+      std::time_t time = 0;
+      if (!fetch_file_stamp(frec.filename, size, time)) return false;
+      if (size != frec.file_size || time != frec.last_write_time) return false;
+    }
+    return true;
+  }
+
+  void simulated_data_index::store(const std::string & filename_) const
+  {
+    DT_THROW_IF(_file_open_, std::logic_error, "A data file is still being indexed!");
+    const std::string filename = resolve_filename(filename_);
+    std::ofstream fout(filename.c_str());
+    DT_THROW_IF(!fout, std::runtime_error, "Cannot open index file '" << filename << "'!");
+    fout.precision(17);
+    fout << sidecar_header() << ' ' << SIDECAR_VERSION << '\n';
+    fout << "summaries " << _summary_names_.size();
+    for (const std::string & name : _summary_names_) {
+      fout << ' ' << name;
+    }
+    fout << '\n';
+    fout << "files " << _files_.size() << '\n';
+    for (const file_record & frec : _files_) {
+      fout << "file " << (frec.brio ? 1 : 0) << ' ' << frec.number_of_entries
+           << ' ' << frec.file_size << ' ' << (long long) frec.last_write_time
+           << ' ' << frec.filename << '\n';
+      if (_summary_names_.empty()) continue;
+      for (std::size_t ientry = 0; ientry < frec.number_of_entries; ientry++) {
+        const double * values = &_summaries_[(frec.first_entry + ientry) * _summary_names_.size()];
+        for (std::size_t isum = 0; isum < _summary_names_.size(); isum++) {
+          if (isum > 0) fout << ' ';
+          fout << values[isum];
+        }
+        fout << '\n';
+      }
+    }
+    DT_THROW_IF(!fout, std::runtime_error, "Cannot write index file '" << filename << "'!");
+    return;
+  }
+
+  void simulated_data_index::load(const std::string & filename_)
+  {
+    const std::string filename = resolve_filename(filename_);
+    std::ifstream fin(filename.c_str());
+    DT_THROW_IF(!fin, std::runtime_error, "Cannot open index file '" << filename << "'!");
+    std::string line;
+    {
+      std::getline(fin, line);
+      std::istringstream iss(line);
+      std::string header;
+      int version = 0;
+      iss >> header >> version;
+      DT_THROW_IF(header != sidecar_header() || version != SIDECAR_VERSION,
+                  std::logic_error, "Invalid header in index file '" << filename << "'!");
+    }
+    std::vector<std::string> names;
+    {
+      std::getline(fin, line);
+      std::istringstream iss(line);
+      std::string key;
+      std::size_t nsummaries = 0;
+      iss >> key >> nsummaries;
+      DT_THROW_IF(!iss || key != "summaries", std::logic_error,
+                  "Missing list of summaries in index file '" << filename << "'!");
+      names.assign(nsummaries, "");
+      for (std::size_t isum = 0; isum < nsummaries; isum++) {
+        iss >> names[isum];
+      }
+      DT_THROW_IF(!iss, std::logic_error, "Invalid list of summaries in index file '" << filename << "'!");
+    }
+    // Preserve the functions of the summaries already defined:
+    std::vector<summary_function_type> functions(names.size());
+    for (std::size_t isum = 0; isum < names.size(); isum++) {
+      if (has_summary(names[isum])) {
+        functions[isum] = _summary_functions_[get_summary_index(names[isum])];
+      }
+    }
+    _summary_names_ = names;
+    _summary_functions_ = functions;
+    clear();
+    std::size_t nfiles = 0;
+    {
+      std::getline(fin, line);
+      std::istringstream iss(line);
+      std::string key;
+      iss >> key >> nfiles;
+      DT_THROW_IF(!iss || key != "files", std::logic_error,
+                  "Missing number of files in index file '" << filename << "'!");
+    }
+    for (std::size_t ifile = 0; ifile < nfiles; ifile++) {
+      file_record frec;
+      {
+        std::getline(fin, line);
+        std::istringstream iss(line);
+        std::string key;
+        int brio_flag = 0;
+        long long last_write_time = 0;
+        iss >> key >> brio_flag >> frec.number_of_entries >> frec.file_size >> last_write_time;
+        DT_THROW_IF(!iss || key != "file", std::logic_error,
+                    "Invalid file record in index file '" << filename << "'!");
+        iss >> std::ws;
+        std::getline(iss, frec.filename);
+        DT_THROW_IF(frec.filename.empty(), std::logic_error,
+                    "Missing data filename in index file '" << filename << "'!");
+        frec.brio = (brio_flag != 0);
+        frec.last_write_time = (std::time_t) last_write_time;
+      }
+      frec.first_entry = get_number_of_entries();
+      frec.min_summaries.assign(names.size(), std::numeric_limits<double>::quiet_NaN());
+      frec.max_summaries.assign(names.size(), std::numeric_limits<double>::quiet_NaN());
+      if (!names.empty()) {
+        for (std::size_t ientry = 0; ientry < frec.number_of_entries; ientry++) {
+          for (std::size_t isum = 0; isum < names.size(); isum++) {
+            double value;
+            fin >> value;
+            DT_THROW_IF(!fin, std::logic_error, "Invalid summary values in index file '" << filename << "'!");
+            _summaries_.push_back(value);
+            if (ientry == 0 || value < frec.min_summaries[isum]) frec.min_summaries[isum] = value;
+            if (ientry == 0 || value > frec.max_summaries[isum]) frec.max_summaries[isum] = value;
+          }
+        }
+        fin >> std::ws;
+      }
+      _files_.push_back(frec);
+    }
+    return;
+  }
+
+  void simulated_data_index::clear()
+  {
+    _files_.clear();
+    _summaries_.clear();
+    _file_open_ = false;
+    return;
+  }
+
+  void simulated_data_index::tree_dump(std::ostream & out_,
+                                       const std::string & title_,
+                                       const std::string & indent_,
+                                       bool inherit_) const
+  {
+    if (!title_.empty()) {
+      out_ << indent_ << title_ << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "Summaries : " << _summary_names_.size() << std::endl;
+    for (std::size_t isum = 0; isum < _summary_names_.size(); isum++) {
+      out_ << indent_ << datatools::i_tree_dumpable::skip_tag
+           << (isum + 1 == _summary_names_.size() ? datatools::i_tree_dumpable::last_tag : datatools::i_tree_dumpable::tag)
+           << "'" << _summary_names_[isum] << "'" << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::tag
+         << "Files : " << _files_.size() << std::endl;
+    for (std::size_t ifile = 0; ifile < _files_.size(); ifile++) {
+      const file_record & frec = _files_[ifile];
+      out_ << indent_ << datatools::i_tree_dumpable::skip_tag
+           << (ifile + 1 == _files_.size() ? datatools::i_tree_dumpable::last_tag : datatools::i_tree_dumpable::tag)
+           << "'" << frec.filename << "' : " << frec.number_of_entries << " entries from ["
+           << frec.first_entry << "]" << (frec.brio ? " (BRIO)" : "") << std::endl;
+    }
+    out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+         << "Entries : " << get_number_of_entries() << std::endl;
+    return;
+  }
+
+} // end of namespace mctools
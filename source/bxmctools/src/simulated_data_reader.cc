@@ -4,16 +4,26 @@
 #include <mctools/simulated_data_reader.h>
 
 // Standard library:
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 #include <datatools/exception.h>
 #include <datatools/io_factory.h>
 #include <datatools/properties.h>
 
 // Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
 // - Bayeux/datatools:
 #include <datatools/archives_instantiation.h>
 #include <datatools/properties.ipp>
 // - Bayeux/brio:
 #include <brio/reader.h>
+#include <brio/utils.h>
 
 // This project:
 #include <mctools/simulated_data.h>
@@ -22,6 +32,73 @@
 
 namespace mctools {
 
+  namespace {
+
+    /// Scan the simulated data records stored in a data file
+    ///
+    /// Records are loaded in the objects provided by 'acquire_' and passed to 'handler_'.
+    std::size_t scan_records(const std::string & filename_,
+                             const std::function<simulated_data & ()> & acquire_,
+                             const simulated_data_reader::record_handler_type & handler_,
+                             datatools::logger::priority logging_)
+    {
+      std::size_t count = 0;
+      int mode_guess = 0;
+      if (brio::store_info::guess_mode_from_filename(filename_, mode_guess) == brio::store_info::SUCCESS) {
+        brio::reader brio_reader(filename_, logging_);
+        if (! brio_reader.has_store_with_serial_tag(io_utils::PLAIN_SIMULATED_DATA_STORE,
+                                                    simulated_data::SERIAL_TAG)) {
+          DT_THROW(std::logic_error, "Missing '" << io_utils::PLAIN_SIMULATED_DATA_STORE
+                   << "' store from input BRIO file '" << filename_ << "' !");
+        }
+        brio_reader.select_store(io_utils::PLAIN_SIMULATED_DATA_STORE);
+        while (brio_reader.has_next()) {
+          simulated_data & sd = acquire_();
+          sd.clear();
+          brio_reader.load_next(sd);
+          count++;
+          if (! handler_(sd)) break;
+        }
+      } else if (datatools::io_factory::guess_mode_from_filename(filename_, mode_guess)
+                 == datatools::io_factory::SUCCESS) {
+        datatools::data_reader bio_reader(filename_, datatools::using_multi_archives);
+        while (bio_reader.has_record_tag()) {
+          if (bio_reader.record_tag_is(datatools::properties::SERIAL_TAG)) {
+            // Skip run header/footer:
+            datatools::properties run_info;
+            bio_reader.load(run_info);
+          } else if (bio_reader.record_tag_is(simulated_data::SERIAL_TAG)) {
+            simulated_data & sd = acquire_();
+            sd.clear();
+            bio_reader.load(sd);
+            count++;
+            if (! handler_(sd)) break;
+          } else {
+            DT_THROW(std::logic_error, "Unrecognized serial tag '" << bio_reader.get_record_tag()
+                     << "' from input BIO file '" << filename_ << "' !");
+          }
+        }
+      } else {
+        DT_THROW(std::logic_error, "Cannot guess mode for input data file '" << filename_ << "' !");
+      }
+      DT_LOG_DEBUG(logging_, "Scanned " << count << " simulated data records from file '" << filename_ << "'.");
+      return count;
+    }
+
+  }
+
+  // static
+  std::size_t simulated_data_reader::scan_file(const std::string & filename_,
+                                               const record_handler_type & handler_,
+                                               datatools::logger::priority logging_)
+  {
+    simulated_data sd;
+    return scan_records(filename_,
+                        [&sd]() -> simulated_data & { return sd; },
+                        handler_,
+                        logging_);
+  }
+
   void simulated_data_reader::set_max_files (int a_max_files)
   {
     DT_THROW_IF(is_initialized (),
@@ -73,6 +150,77 @@ namespace mctools {
     return;
   }
 
+  bool simulated_data_reader::has_index() const
+  {
+    return _index_.get() != 0;
+  }
+
+  void simulated_data_reader::set_index(const simulated_data_index & index_)
+  {
+    if (is_initialized()) {
+      std::vector<std::string> filenames;
+      _build_filenames(filenames);
+      DT_THROW_IF(! index_.matches(filenames), std::logic_error,
+                  "Index does not match the input files !");
+    }
+    _index_.reset(new simulated_data_index(index_));
+    _ra_file_index_ = -1;
+    if (_ra_bio_reader_) _ra_bio_reader_.reset(0);
+    if (_ra_brio_reader_) _ra_brio_reader_.reset(0);
+    return;
+  }
+
+  const simulated_data_index & simulated_data_reader::get_index() const
+  {
+    DT_THROW_IF(! has_index(), std::logic_error, "No available index !");
+    return *_index_.get();
+  }
+
+  void simulated_data_reader::build_index(const std::string & sidecar_filename_)
+  {
+    DT_THROW_IF(! _filenames_.is_valid (), std::logic_error, "Invalid list of filenames !");
+    std::vector<std::string> filenames;
+    _build_filenames(filenames);
+    simulated_data_index index;
+    if (has_index()) {
+      // Preserve the definitions of summaries:
+      index = *_index_.get();
+      index.clear();
+    }
+    DT_LOG_NOTICE(_logging_, "Building the index of " << filenames.size() << " input file(s)...");
+    index.build(filenames);
+    if (! sidecar_filename_.empty()) {
+      index.store(sidecar_filename_);
+      DT_LOG_NOTICE(_logging_, "Index has been stored in file '" << sidecar_filename_ << "'.");
+    }
+    set_index(index);
+    return;
+  }
+
+  void simulated_data_reader::set_file_selector(const file_selector_type & selector_)
+  {
+    DT_THROW_IF(is_initialized (),
+                std::logic_error,
+                "Reader is already initialized !");
+    _file_selector_ = selector_;
+    return;
+  }
+
+  void simulated_data_reader::_build_filenames(std::vector<std::string> & filenames_) const
+  {
+    filenames_.clear();
+    for (std::size_t i = 0; i < _filenames_.size(); i++) {
+      filenames_.push_back(_filenames_[i]);
+    }
+    return;
+  }
+
+  bool simulated_data_reader::_is_selected_file(int file_index_) const
+  {
+    if (! has_index() || ! _file_selector_) return true;
+    return _file_selector_(_index_.get()->get_file(file_index_));
+  }
+
   bool simulated_data_reader::is_terminated () const
   {
     return _terminated_;
@@ -125,6 +273,10 @@ namespace mctools {
     _file_has_changed_ = false;
     if (_bio_reader_) _bio_reader_.reset(0);
     if (_brio_reader_) _brio_reader_.reset(0);
+    _ra_file_index_ = -1;
+    _ra_file_entry_ = 0;
+    if (_ra_bio_reader_) _ra_bio_reader_.reset(0);
+    if (_ra_brio_reader_) _ra_brio_reader_.reset(0);
     return;
   }
 
@@ -279,6 +431,32 @@ namespace mctools {
                   "Invalid maximum number of data records per file !");
       set_max_record_per_file (the_max_record_per_file);
     }
+
+    if (setup_.has_key ("index.file")) {
+      std::string index_filename = setup_.fetch_path ("index.file");
+      bool rebuild = true;
+      if (boost::filesystem::exists(index_filename)) {
+        simulated_data_index index;
+        if (has_index()) index = get_index();
+        try {
+          index.load(index_filename);
+          std::vector<std::string> filenames;
+          _build_filenames(filenames);
+          if (index.matches(filenames)) {
+            set_index(index);
+            rebuild = false;
+          } else {
+            DT_LOG_NOTICE(_logging_, "Index file '" << index_filename << "' does not match the input files !");
+          }
+        } catch (std::exception & error) {
+          DT_LOG_WARNING(_logging_, "Cannot load index file '" << index_filename << "': " << error.what());
+        }
+      }
+      if (rebuild) {
+        // Missing or obsolete index:
+        build_index(index_filename);
+      }
+    }
     _initialize();
     DT_LOG_TRACE(_logging_, "Exiting.");
     return;
@@ -287,6 +465,12 @@ namespace mctools {
   void simulated_data_reader::_initialize()
   {
     DT_LOG_TRACE(_logging_, "Entering...");
+    if (has_index()) {
+      std::vector<std::string> filenames;
+      _build_filenames(filenames);
+      DT_THROW_IF(! _index_.get()->matches(filenames), std::logic_error,
+                  "Index does not match the input files !");
+    }
     _check_input();
     _initialized_ = true;
     if (_logging_ >= datatools::logger::PRIO_TRACE) {
@@ -308,6 +492,8 @@ namespace mctools {
     if (_bio_reader_) _bio_reader_.reset(0);
     if (_brio_reader_) _brio_reader_.reset(0);
     _filenames_.reset();
+    _index_.reset(0);
+    _file_selector_ = file_selector_type();
     _set_defaults ();
     return;
   }
@@ -350,6 +536,10 @@ namespace mctools {
         _terminated_ = true;
         break;
       }
+      if (! _is_selected_file(_file_index_)) {
+        DT_LOG_DEBUG(_logging_, "Skipping unselected input data file '" << _filenames_[_file_index_] << "'.");
+        continue;
+      }
       std::string source_label = _filenames_[_file_index_];
       int mode_guess = 0;
       bool brio_format = false;
@@ -570,6 +760,209 @@ namespace mctools {
     return LOAD_OK;
   }
 
+  std::size_t simulated_data_reader::get_number_of_entries() const
+  {
+    return get_index().get_number_of_entries();
+  }
+
+  void simulated_data_reader::_open_random_access(std::size_t file_index_)
+  {
+    if (_ra_bio_reader_) _ra_bio_reader_.reset(0);
+    if (_ra_brio_reader_) _ra_brio_reader_.reset(0);
+    _ra_file_index_ = -1;
+    _ra_file_entry_ = 0;
+    const simulated_data_index::file_record & frec = get_index().get_file(file_index_);
+    DT_LOG_DEBUG(_logging_, "Opening input data file '" << frec.filename << "' for random access...");
+    if (frec.brio) {
+      _ra_brio_reader_.reset(new brio::reader(frec.filename, _logging_));
+      DT_THROW_IF(! _ra_brio_reader_.get()->has_store_with_serial_tag(io_utils::PLAIN_SIMULATED_DATA_STORE,
+                                                                      simulated_data::SERIAL_TAG),
+                  std::logic_error,
+                  "Missing '" << io_utils::PLAIN_SIMULATED_DATA_STORE
+                  << "' store from input BRIO file '" << frec.filename << "' !");
+      _ra_brio_reader_.get()->select_store(io_utils::PLAIN_SIMULATED_DATA_STORE);
+    } else {
+      _ra_bio_reader_.reset(new datatools::data_reader(frec.filename, datatools::using_multi_archives));
+    }
+    _ra_file_index_ = file_index_;
+    return;
+  }
+
+  int simulated_data_reader::load_entry(std::size_t entry_, simulated_data & sd_)
+  {
+    DT_THROW_IF(!is_initialized(),
+                std::logic_error,
+                "Reader is not initialized !");
+    std::size_t file_index = 0;
+    std::size_t file_entry = 0;
+    get_index().locate(entry_, file_index, file_entry);
+    const simulated_data_index::file_record & frec = get_index().get_file(file_index);
+    if (_ra_file_index_ != (int) file_index
+        || (! frec.brio && file_entry < _ra_file_entry_)) {
+      _open_random_access(file_index);
+    }
+    sd_.clear();
+    if (_ra_brio_reader_) {
+      // Direct access:
+      _ra_brio_reader_.get()->load(sd_, io_utils::PLAIN_SIMULATED_DATA_STORE, (int64_t) file_entry);
+      _ra_file_entry_ = file_entry + 1;
+      return LOAD_OK;
+    }
+    // Sequential access from the current position in the file:
+    datatools::data_reader & bio_reader = *_ra_bio_reader_.get();
+    while (true) {
+      DT_THROW_IF(! bio_reader.has_record_tag(), std::logic_error,
+                  "Missing simulated data record [" << file_entry << "] from BIO input file '"
+                  << frec.filename << "' ! Probable obsolete index !");
+      if (bio_reader.record_tag_is(datatools::properties::SERIAL_TAG)) {
+        datatools::properties run_info;
+        bio_reader.load(run_info);
+      } else if (bio_reader.record_tag_is(simulated_data::SERIAL_TAG)) {
+        sd_.clear();
+        bio_reader.load(sd_);
+        if (_ra_file_entry_++ == file_entry) break;
+      } else {
+        DT_THROW(std::logic_error, "Unrecognized serial tag '" << bio_reader.get_record_tag()
+                 << "' from input BIO file '" << frec.filename << "' !");
+      }
+    }
+    return LOAD_OK;
+  }
+
+  std::size_t simulated_data_reader::read_concurrently(unsigned int nthreads_,
+                                                       const record_handler_type & handler_)
+  {
+    DT_THROW_IF(!is_initialized(),
+                std::logic_error,
+                "Reader is not initialized !");
+    std::vector<std::string> filenames;
+    _build_filenames(filenames);
+    std::size_t max_files = filenames.size();
+    if (_max_files_ > 0) {
+      max_files = std::min(max_files, (std::size_t) _max_files_);
+    }
+    std::vector<std::size_t> file_indexes;
+    bool use_brio = false;
+    for (std::size_t ifile = 0; ifile < max_files; ifile++) {
+      if (! _is_selected_file(ifile)) continue;
+      file_indexes.push_back(ifile);
+      int mode_guess = 0;
+      if (brio::store_info::guess_mode_from_filename(filenames[ifile], mode_guess) == brio::store_info::SUCCESS) {
+        use_brio = true;
+      }
+    }
+    unsigned int nthreads = nthreads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    nthreads = std::max(1U, std::min(nthreads, (unsigned int) file_indexes.size()));
+    if (use_brio && nthreads > 1) {
+      brio::enable_thread_safety();
+    }
+    DT_LOG_DEBUG(_logging_, "Reading " << file_indexes.size() << " input file(s) with " << nthreads << " thread(s)...");
+
+    // Records loaded from each file, waiting to be handled in order:
+    struct slot_type {
+      bool done = false;
+      std::deque<simulated_data> records;
+      std::exception_ptr error;
+    };
+    std::vector<slot_type> slots(file_indexes.size());
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::size_t next_task = 0;   // Next file to be loaded
+    std::size_t next_output = 0; // Next file to be handled
+    bool stopping = false;
+    const std::size_t max_record_per_file = _max_record_per_file_;
+    const datatools::logger::priority logging = _logging_;
+
+    auto worker = [&]() {
+      while (true) {
+        std::size_t itask = 0;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          // Bound the number of files loaded ahead of the handled one:
+          cond.wait(lock, [&] {
+              return stopping || next_task >= slots.size() || next_task < next_output + nthreads;
+            });
+          if (stopping || next_task >= slots.size()) break;
+          itask = next_task++;
+        }
+        std::deque<simulated_data> records;
+        std::exception_ptr error;
+        try {
+          scan_records(filenames[file_indexes[itask]],
+                       [&records]() -> simulated_data & {
+                         records.emplace_back();
+                         return records.back();
+                       },
+                       [&records, max_record_per_file](simulated_data &) {
+                         return max_record_per_file == 0 || records.size() < max_record_per_file;
+                       },
+                       logging);
+        } catch (...) {
+          error = std::current_exception();
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          slots[itask].records.swap(records);
+          slots[itask].error = error;
+          slots[itask].done = true;
+        }
+        cond.notify_all();
+      }
+      return;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      threads.push_back(std::thread(worker));
+    }
+    std::size_t handled = 0;
+    std::exception_ptr error;
+    try {
+      bool stop_input = false;
+      for (std::size_t islot = 0; islot < slots.size() && ! stop_input; islot++) {
+        std::deque<simulated_data> records;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cond.wait(lock, [&] { return slots[islot].done; });
+          records.swap(slots[islot].records);
+          error = slots[islot].error;
+          next_output = islot + 1;
+        }
+        cond.notify_all();
+        if (error) break;
+        for (simulated_data & sd : records) {
+          if (_max_record_total_ > 0 && handled >= (std::size_t) _max_record_total_) {
+            stop_input = true;
+            break;
+          }
+          handled++;
+          if (! handler_(sd)) {
+            stop_input = true;
+            break;
+          }
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    for (std::thread & t : threads) {
+      t.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    DT_LOG_DEBUG(_logging_, "Handled " << handled << " simulated data records.");
+    return handled;
+  }
+
   void simulated_data_reader::tree_dump (std::ostream & a_out ,
                                          const std::string & a_title,
                                          const std::string & a_indent,
@@ -599,6 +992,16 @@ namespace mctools {
       a_out << indent << datatools::i_tree_dumpable::tag
             << "Number of filenames   : " << _filenames_.size () << std::endl;
     }
+    a_out << indent << datatools::i_tree_dumpable::tag
+          << "Index                 : ";
+    if (has_index()) {
+      a_out << _index_.get()->get_number_of_entries() << " entries in "
+            << _index_.get()->get_number_of_files() << " file(s)";
+    } else {
+      a_out << "<none>";
+    }
+    a_out << std::endl;
+
     a_out << indent << datatools::i_tree_dumpable::tag
           << "Terminated            : " << _terminated_ << std::endl;
 
@@ -673,6 +1076,9 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(::mctools::simulated_data_reader,ocd_)
                                 "  #@description List of input files                                  \n"
                                 "  files.list.filenames : string[2] = \"sd0.xml\" \"sd1.xml\"         \n"
                                 "                                                                     \n"
+                                "  #@description Index of the input files (rebuilt if obsolete)       \n"
+                                "  index.file : string as path = \"sd.sdidx\"                         \n"
+                                "                                                                     \n"
                                 );
 
   ocd_.set_validation_support(false);
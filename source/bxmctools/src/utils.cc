@@ -28,6 +28,7 @@ namespace mctools {
   const std::string sensitive_utils::SENSITIVE_RECORD_PRIMARY_PARTICLE    = "record_primary_particle";
   const std::string sensitive_utils::SENSITIVE_RECORD_STEP_LENGTH         = "record_step_length";
   const std::string sensitive_utils::SENSITIVE_RECORD_BOUNDARIES          = "record_boundaries";
+  const std::string sensitive_utils::SENSITIVE_MINIMAL_HIT                = "minimal_hit";
 
   // Specific to hits :
   const std::string hit_utils::HIT_MC_BUGGY_KEY            = "hit.mc_buggy";
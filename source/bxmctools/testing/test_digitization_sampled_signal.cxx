@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 #include <exception>
+#include <stdexcept>
 
 // Third party:
 // - Bayeux/datatools:
@@ -14,6 +15,8 @@
 #include <datatools/units.h>
 #include <datatools/clhep_units.h>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
 // - Bayeux/mygsl:
 #include <mygsl/parameter_store.h>
 // - Bayeux/geomtools:
@@ -28,6 +31,7 @@
 #include <mctools/digitization/sampled_signal.h>
 
 void test_ss_1(bool draw_ = false);
+void test_ss_2();
 
 int main (int argc_, char ** argv_)
 {
@@ -46,6 +50,7 @@ int main (int argc_, char ** argv_)
 
     srand48(314159);
     test_ss_1(draw);
+    test_ss_2();
 
     std::clog << "The end." << std::endl;
   } catch (std::exception & x) {
@@ -143,3 +148,38 @@ void test_ss_1(bool /*draw_*/)
 
   return;
 }
+
+void test_ss_2()
+{
+  // Binary serialization of a long signal:
+  mctools::digitization::sampled_signal digi_sig;
+  digi_sig.set_hit_id(43);
+  digi_sig.set_sampling_frequency(2.0 * datatools::units::get_frequency_unit_from("GHz"));
+  std::vector<int32_t> samples(1000000);
+  for (std::size_t isample = 0; isample < samples.size(); isample++) {
+    samples[isample] = 2048 + (int32_t) (1024 * drand48());
+  }
+  digi_sig.set_samples(samples);
+  const std::string filename = "test_digitization_sampled_signal.data";
+  datatools::computing_time store_ct;
+  {
+    datatools::data_writer writer(filename);
+    store_ct.start();
+    writer.store(digi_sig);
+    store_ct.stop();
+  }
+  mctools::digitization::sampled_signal loaded_sig;
+  datatools::computing_time load_ct;
+  {
+    datatools::data_reader reader(filename);
+    load_ct.start();
+    reader.load(loaded_sig);
+    load_ct.stop();
+  }
+  DT_THROW_IF(loaded_sig.get_samples() != digi_sig.get_samples(), std::logic_error,
+              "Unmatching loaded samples!");
+  std::clog << "Signal with " << digi_sig.get_number_of_samples() << " samples: store: "
+            << store_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms, load: "
+            << load_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms" << std::endl;
+  return;
+}
@@ -0,0 +1,153 @@
+// test_digitization_sampled_signal_builder.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <exception>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+
+// This project:
+#include <mctools/signal/triangle_signal_shape.h>
+#include <mctools/signal/triangle_gate_signal_shape.h>
+#include <mctools/signal/multi_signal_shape.h>
+#include <mctools/digitization/simple_linear_adc.h>
+#include <mctools/digitization/sampled_signal.h>
+#include <mctools/digitization/sampled_signal_builder.h>
+
+void test_sampling(const mygsl::i_unary_function & shape_, const std::string & label_);
+
+int main (int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'mctools::digitization::sampled_signal_builder'!" << std::endl;
+
+    std::size_t nchannels = 2000;
+    int iarg = 1;
+    while (iarg < argc_) {
+      std::string arg = argv_[iarg];
+      if (arg == "-n" || arg == "--number-of-channels") {
+        nchannels = std::stoul(argv_[++iarg]);
+      }
+      iarg++;
+    }
+
+    static const double mV = 1e-3 * CLHEP::volt;
+    static const double ns = CLHEP::nanosecond;
+
+    mctools::signal::triangle_signal_shape tss;
+    tss.set_polarity(mctools::signal::POLARITY_NEGATIVE);
+    tss.set_amplitude(350.0 * mV);
+    tss.set_t0(10.0 * ns);
+    tss.set_t1(13.0 * ns);
+    tss.set_t2(39.0 * ns);
+    tss.initialize_simple();
+    test_sampling(tss, "triangle");
+
+    mctools::signal::triangle_gate_signal_shape tgss;
+    tgss.set_polarity(mctools::signal::POLARITY_NEGATIVE);
+    tgss.set_amplitude(550.0 * mV);
+    tgss.set_t0(13.0 * ns);
+    tgss.set_t1(17.0 * ns);
+    tgss.set_t2(28.0 * ns);
+    tgss.set_t3(45.0 * ns);
+    tgss.initialize_simple();
+    test_sampling(tgss, "triangle gate");
+
+    mctools::signal::multi_signal_shape mss;
+    mss.add("tss", tss, 5.0 * ns, 0.5);
+    mss.add("tgss", tgss, 20.0 * ns, 1.0);
+    mss.initialize_simple();
+    test_sampling(mss, "multi");
+
+    mctools::digitization::simple_linear_adc adc;
+    adc.set_nbits(12);
+    adc.set_v_ref_low(-1.0 * CLHEP::volt);
+    adc.set_v_ref_high(+0.1 * CLHEP::volt);
+    adc.initialize_simple();
+
+    mctools::digitization::sampled_signal_builder builder;
+    builder.set_adc(adc);
+    builder.set_sampling_frequency(2.56 * CLHEP::gigahertz);
+    builder.set_number_of_samples(1024);
+    builder.initialize_simple();
+    builder.tree_dump(std::clog, "Sampled signal builder: ");
+
+    // Reference: scalar evaluation and quantization of each sample:
+    mctools::digitization::sampled_signal ref_sig(builder.get_sampling_frequency(),
+                                                  builder.get_number_of_samples());
+    datatools::computing_time scalar_ct;
+    for (std::size_t ich = 0; ich < nchannels; ich++) {
+      scalar_ct.start();
+      for (std::size_t isample = 0; isample < ref_sig.get_number_of_samples(); isample++) {
+        double t = builder.get_time_origin() + isample * (1.0 / builder.get_sampling_frequency());
+        ref_sig.set_sample(isample, adc.quantize(mss(t)));
+      }
+      ref_sig.update();
+      scalar_ct.stop();
+    }
+
+    // Batch pipeline:
+    mctools::digitization::sampled_signal batch_sig;
+    datatools::computing_time batch_ct;
+    for (std::size_t ich = 0; ich < nchannels; ich++) {
+      batch_ct.start();
+      builder.build(mss, batch_sig);
+      batch_ct.stop();
+    }
+
+    std::size_t nmismatches = 0;
+    for (std::size_t isample = 0; isample < ref_sig.get_number_of_samples(); isample++) {
+      if (ref_sig.get_samples()[isample] != batch_sig.get_samples()[isample]) {
+        nmismatches++;
+      }
+    }
+    std::clog << "Number of mismatching samples : " << nmismatches << std::endl;
+    DT_THROW_IF(nmismatches > 0, std::logic_error, "Batch and scalar digitizations differ!");
+
+    std::clog << "Number of channels : " << nchannels << std::endl;
+    std::clog << "Scalar digitization : " << scalar_ct.get_mean_time() / CLHEP::microsecond
+              << " us/channel" << std::endl;
+    std::clog << "Batch digitization  : " << batch_ct.get_mean_time() / CLHEP::microsecond
+              << " us/channel" << std::endl;
+    if (batch_ct.get_mean_time() > 0.0) {
+      std::clog << "Speedup : " << scalar_ct.get_mean_time() / batch_ct.get_mean_time() << std::endl;
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what () << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
+
+void test_sampling(const mygsl::i_unary_function & shape_, const std::string & label_)
+{
+  const double t0 = 0.0;
+  const double dt = 0.1 * CLHEP::nanosecond;
+  const std::size_t n = 1000;
+  std::vector<double> samples;
+  shape_.sample(t0, dt, n, samples);
+  double max_delta = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    double delta = std::abs(samples[i] - shape_(t0 + i * dt));
+    if (delta > max_delta) max_delta = delta;
+  }
+  std::clog << "Sampling of the '" << label_ << "' shape: max deviation = "
+            << max_delta / CLHEP::volt << " V" << std::endl;
+  DT_THROW_IF(max_delta > 1e-12 * CLHEP::volt, std::logic_error,
+              "Batch sampling of the '" << label_ << "' shape differs from point-wise evaluation!");
+  return;
+}
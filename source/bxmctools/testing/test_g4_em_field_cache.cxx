@@ -0,0 +1,125 @@
+// test_g4_em_field_cache.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+
+// This project:
+#include <mctools/g4/em_field_cache.h>
+#include <mctools/g4/em_field_g4_utils.h>
+
+// A slowly varying magnetic field, valid for z >= -50 mm
+bool linear_field(const double position_[4], double * b_field_)
+{
+  if (position_[mctools::g4::POSTIME_Z] < -50.0 * CLHEP::mm) return false;
+  b_field_[mctools::g4::EMFIELD_BX] = 1.0e-3 * position_[mctools::g4::POSTIME_Y];
+  b_field_[mctools::g4::EMFIELD_BY] = 2.0e-3 * position_[mctools::g4::POSTIME_X];
+  b_field_[mctools::g4::EMFIELD_BZ] = 0.5 + 1.0e-4 * position_[mctools::g4::POSTIME_Z];
+  return true;
+}
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'mctools::g4::em_field_cache'!" << std::endl;
+
+    {
+      // Cache with a spatial tolerance:
+      datatools::properties config;
+      config.store_boolean("cache.enabled", true);
+      config.store_real("cache.tolerance", 0.001); // mm
+      mctools::g4::em_field_cache cache;
+      cache.configure(config);
+      double position[4] = { 10.0, 20.0, 30.0, 0.0 };
+      double b_field[3];
+      DT_THROW_IF(cache.find(position, b_field), std::logic_error, "Unexpected cache hit!");
+      linear_field(position, b_field);
+      cache.store(position, b_field);
+      double near_position[4] = { 10.0005, 20.0, 30.0, 5.0 };
+      double cached_field[3];
+      DT_THROW_IF(! cache.find(near_position, cached_field), std::logic_error, "Missing cache hit!");
+      DT_THROW_IF(cached_field[mctools::g4::EMFIELD_BY] != b_field[mctools::g4::EMFIELD_BY],
+                  std::logic_error, "Unexpected cached field!");
+      double far_position[4] = { 10.01, 20.0, 30.0, 0.0 };
+      DT_THROW_IF(cache.find(far_position, cached_field), std::logic_error, "Unexpected cache hit!");
+
+      // Cached values are private to each thread:
+      bool other_thread_hit = true;
+      std::thread other([&cache, &position, &other_thread_hit] () {
+          double field[3];
+          other_thread_hit = cache.find(position, field);
+        });
+      other.join();
+      DT_THROW_IF(other_thread_hit, std::logic_error, "Unexpected cache hit from another thread!");
+
+      // Time dependent field:
+      cache.set_time_dependent(true);
+      DT_THROW_IF(cache.find(near_position, cached_field), std::logic_error, "Unexpected cache hit!");
+      cache.set_time_dependent(false);
+
+      const mctools::g4::em_field_cache::stats_type stats = cache.get_stats();
+      DT_THROW_IF(stats.calls != 5 || stats.cache_hits != 1 || stats.evaluations != 1,
+                  std::logic_error, "Unexpected statistics!");
+      cache.print_stats(std::clog, 2);
+
+      // A reset invalidates the cached values:
+      cache.reset();
+      DT_THROW_IF(cache.find(position, cached_field), std::logic_error, "Unexpected cache hit after reset!");
+    }
+
+    {
+      // Field sampled on a grid:
+      datatools::properties config;
+      std::vector<double> grid_min = { -100.0, -100.0, -100.0 };
+      std::vector<double> grid_max = {  100.0,  100.0,  100.0 };
+      config.store("grid.min", grid_min);
+      config.store("grid.max", grid_max);
+      config.store_real("grid.step", 10.0);
+      mctools::g4::em_field_cache cache;
+      cache.configure(config);
+      DT_THROW_IF(! cache.has_grid_box(), std::logic_error, "Missing grid box!");
+      cache.build_grid(linear_field);
+      DT_THROW_IF(! cache.has_grid(), std::logic_error, "Missing grid!");
+
+      // The interpolation of a linear field is exact:
+      double position[4] = { 12.3, -45.6, 78.9, 0.0 };
+      double b_field[3];
+      double expected_field[3];
+      DT_THROW_IF(! cache.find(position, b_field), std::logic_error, "Missing grid hit!");
+      linear_field(position, expected_field);
+      for (int i = 0; i < 3; i++) {
+        DT_THROW_IF(std::abs(b_field[i] - expected_field[i]) > 1.e-12, std::logic_error,
+                    "Unexpected interpolated field!");
+      }
+
+      // Outside the grid box or close to invalid nodes:
+      double outside_position[4] = { 12.3, -45.6, 178.9, 0.0 };
+      DT_THROW_IF(cache.find(outside_position, b_field), std::logic_error, "Unexpected grid hit!");
+      double invalid_position[4] = { 12.3, -45.6, -55.0, 0.0 };
+      DT_THROW_IF(cache.find(invalid_position, b_field), std::logic_error, "Unexpected grid hit!");
+      cache.print_stats(std::clog);
+    }
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,89 @@
+// test_g4_track_history.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <mctools/g4/track_history.h>
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'mctools::g4::track_history'!" << std::endl;
+
+    mctools::g4::track_history th;
+    th.reserve(100);
+    const std::size_t ncapacity = th.get_track_infos().capacity();
+
+    for (int ievent = 0; ievent < 3; ievent++) {
+      th.reset();
+      DT_THROW_IF(th.get_number_of_tracks() != 0, std::logic_error, "History is not empty!");
+      DT_THROW_IF(th.has_track_info(1), std::logic_error, "Unexpected track #1!");
+
+      // A primary alpha and its delta rays, added out of order:
+      for (int track_id : {1, 5, 3, 2, 4}) {
+        mctools::g4::track_history::track_info dummy;
+        th.add_track_info(track_id, dummy);
+        mctools::g4::track_history::track_info & ti = th.grab_track_info(track_id);
+        ti.set_id(track_id);
+        if (track_id == 1) {
+          ti.set_parent_id(0);
+          ti.set_particle_name("alpha");
+        } else {
+          ti.set_parent_id(1);
+          ti.set_particle_name("e-");
+          ti.set_creator_process_name("alphaIoni");
+        }
+      }
+      DT_THROW_IF(th.get_number_of_tracks() != 5, std::logic_error, "Invalid number of tracks!");
+      DT_THROW_IF(th.has_track_info(0), std::logic_error, "Unexpected track #0!");
+      DT_THROW_IF(th.has_track_info(6), std::logic_error, "Unexpected track #6!");
+      const mctools::g4::track_history::track_info & primary = th.get_track_info(1);
+      DT_THROW_IF(!primary.is_primary(), std::logic_error, "Track #1 is not primary!");
+      DT_THROW_IF(primary.get_particle_name() != "alpha", std::logic_error, "Invalid particle name!");
+      DT_THROW_IF(!primary.get_creator_process_name().empty(), std::logic_error, "Invalid creator process!");
+      for (int track_id = 2; track_id <= 5; track_id++) {
+        const mctools::g4::track_history::track_info & ti = th.get_track_info(track_id);
+        DT_THROW_IF(ti.get_id() != track_id, std::logic_error, "Invalid track Id!");
+        DT_THROW_IF(ti.is_primary(), std::logic_error, "Unexpected primary track!");
+        DT_THROW_IF(th.get_track_info(ti.get_parent_id()).get_particle_name() != "alpha",
+                    std::logic_error, "Invalid parent track!");
+        DT_THROW_IF(ti.get_creator_process_name() != "alphaIoni", std::logic_error, "Invalid creator process!");
+      }
+      // Names are interned once:
+      DT_THROW_IF(th.find_name_id("e-") != th.get_track_info(2).get_particle_name_id(),
+                  std::logic_error, "Invalid interned name!");
+      DT_THROW_IF(th.find_name_id("gamma") != mctools::g4::track_history::track_info::NAME_ID_UNSET,
+                  std::logic_error, "Unexpected interned name!");
+      bool duplicate = false;
+      try {
+        mctools::g4::track_history::track_info dummy;
+        th.add_track_info(3, dummy);
+      } catch (std::exception &) {
+        duplicate = true;
+      }
+      DT_THROW_IF(!duplicate, std::logic_error, "Duplicate track was accepted!");
+    }
+    // The storage is kept from one event to the other:
+    DT_THROW_IF(th.get_track_infos().capacity() != ncapacity, std::logic_error,
+                "Storage was reallocated!");
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return (error_code);
+}
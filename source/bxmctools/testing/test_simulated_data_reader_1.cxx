@@ -8,6 +8,10 @@
 #include <vector>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/filesystem.hpp>
+
+#include <datatools/exception.h>
+#include <datatools/utils.h>
 
 // Utilities :
 #include <datatools/units.h>
@@ -18,6 +22,7 @@
 // Simulated data model :
 #include <mctools/simulated_data.h>
 #include <mctools/simulated_data_reader.h>
+#include <mctools/simulated_data_index.h>
 
 // Serialization :
 #include <datatools/io_factory.h>
@@ -90,6 +95,103 @@ int main (int argc_, char ** argv_)
       if (debug) reader.tree_dump(std::cerr, "Reader status: ");
     }
 
+    clog << "*******************************************************************************" << endl;
+    clog << "Step 2: Indexed and concurrent reading of simulated data objects" << endl;
+    clog << "*******************************************************************************" << endl;
+    {
+      std::vector<std::string> files;
+      files.push_back("${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_0.brio");
+      files.push_back("${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_0.xml");
+      files.push_back("${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_1.xml");
+      files.push_back("${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_1.brio");
+      files.push_back("${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_2.xml");
+
+      // Event-level summary value:
+      auto number_of_hits = [](const mctools::simulated_data & sd_) {
+        std::size_t nhits = 0;
+        for (const auto & hits : sd_.get_step_hits_dict()) nhits += hits.second.size();
+        for (const auto & hits : sd_.get_plain_step_hits_dict()) nhits += hits.second.size();
+        return (double) nhits;
+      };
+      mctools::simulated_data_index index;
+      index.add_summary("number_of_hits", number_of_hits);
+      index.build(files);
+      index.tree_dump(std::clog, "Index: ");
+      index.store("test_simulated_data_reader_1.sdidx");
+      {
+        mctools::simulated_data_index index2;
+        index2.load("test_simulated_data_reader_1.sdidx");
+        DT_THROW_IF(index2.get_number_of_entries() != index.get_number_of_entries()
+                    || !index2.matches(files), std::logic_error, "Unmatching reloaded index!");
+        for (std::size_t i = 0; i < index.get_number_of_entries(); i++) {
+          DT_THROW_IF(index2.get_summary(i, 0) != index.get_summary(i, 0), std::logic_error,
+                      "Unmatching reloaded summary for entry [" << i << "]!");
+        }
+      }
+      {
+        // An index does not match a data file regenerated with the same name:
+        std::string sample = "${MCTOOLS_TESTING_DIR}/samples/test_simulated_data_0.xml";
+        datatools::fetch_path_with_env(sample);
+        const std::string copy = "test_simulated_data_reader_1_copy.xml";
+        boost::filesystem::copy_file(sample, copy, boost::filesystem::copy_option::overwrite_if_exists);
+        const std::vector<std::string> copies(1, copy);
+        mctools::simulated_data_index copy_index;
+        copy_index.build(copies);
+        DT_THROW_IF(!copy_index.matches(copies), std::logic_error, "Unmatching index of an unchanged file!");
+        boost::filesystem::last_write_time(copy, boost::filesystem::last_write_time(copy) - 3600);
+        DT_THROW_IF(copy_index.matches(copies), std::logic_error, "Matching index of a regenerated file!");
+      }
+
+      mctools::simulated_data_reader reader;
+      if (debug) reader.set_logging_priority(datatools::logger::PRIO_TRACE);
+      reader.set_index(index);
+      reader.initialize(files);
+
+      // Concurrent reading, in order:
+      std::vector<double> nhits;
+      std::size_t nread = reader.read_concurrently(3, [&](mctools::simulated_data & sd_) {
+          nhits.push_back(number_of_hits(sd_));
+          return true;
+        });
+      std::clog << "Number of concurrently loaded simulated data records: " << nread << std::endl;
+      DT_THROW_IF(nread != index.get_number_of_entries(), std::logic_error,
+                  "Unexpected number of concurrently loaded records!");
+      for (std::size_t i = 0; i < nhits.size(); i++) {
+        DT_THROW_IF(nhits[i] != index.get_summary(i, 0), std::logic_error,
+                    "Unordered concurrently loaded record [" << i << "]!");
+      }
+
+      // Random access:
+      for (std::size_t i = reader.get_number_of_entries(); i-- > 0; ) {
+        mctools::simulated_data SD;
+        reader.load_entry(i, SD);
+        DT_THROW_IF(number_of_hits(SD) != index.get_summary(i, 0), std::logic_error,
+                    "Unmatching record loaded from entry [" << i << "]!");
+      }
+      std::clog << "Random access to " << reader.get_number_of_entries() << " entries: ok" << std::endl;
+      reader.reset();
+
+      // Only read the BRIO files:
+      reader.set_index(index);
+      reader.set_file_selector([](const mctools::simulated_data_index::file_record & file_) {
+          return file_.brio;
+        });
+      reader.initialize(files);
+      int count = 0;
+      while (reader.has_next()) {
+        mctools::simulated_data SD;
+        reader.load_next(SD);
+        count++;
+      }
+      std::size_t expected = 0;
+      for (std::size_t ifile = 0; ifile < index.get_number_of_files(); ifile++) {
+        if (index.get_file(ifile).brio) expected += index.get_file(ifile).number_of_entries;
+      }
+      std::clog << "Number of simulated data records loaded from BRIO files: " << count << std::endl;
+      DT_THROW_IF(count != (int) expected, std::logic_error,
+                  "Unexpected number of records from selected files!");
+    }
+
 
   } catch (exception & x) {
     cerr << "error: " << x.what () << endl;
@@ -48,6 +48,7 @@ if(Bayeux_WITH_GEANT4_MODULE)
     ${module_include_dir}/${module_name}/g4/em_field_equation_of_motion.h
     ${module_include_dir}/${module_name}/g4/em_field_g4_utils.h
     ${module_include_dir}/${module_name}/g4/em_field_g4_stuff.h
+    ${module_include_dir}/${module_name}/g4/em_field_cache.h
     ${module_include_dir}/${module_name}/g4/particles_physics_constructor.h
     ${module_include_dir}/${module_name}/g4/physics_list_utils.h
     ${module_include_dir}/${module_name}/g4/tracking_action.h
@@ -97,6 +98,7 @@ if(Bayeux_WITH_GEANT4_MODULE)
     ${module_source_dir}/g4/electromagnetic_field.cc
     ${module_source_dir}/g4/em_field_equation_of_motion.cc
     ${module_source_dir}/g4/em_field_g4_stuff.cc
+    ${module_source_dir}/g4/em_field_cache.cc
     ${module_source_dir}/g4/neutrons_physics_constructor.cc
     ${module_source_dir}/g4/biasing_manager.cc
     ${module_source_dir}/g4/manager.cc
@@ -105,6 +107,8 @@ if(Bayeux_WITH_GEANT4_MODULE)
 
   list(APPEND ${module_name}_MODULE_TESTS
     ${module_test_dir}/test_g4_prng.cxx
+    ${module_test_dir}/test_g4_em_field_cache.cxx
+    ${module_test_dir}/test_g4_track_history.cxx
     ${module_test_dir}/test_g4_processes_em_model_factory.cxx
     ${module_test_dir}/test_g4_detector_construction.cxx
     ${module_test_dir}/test_g4_manager.cxx
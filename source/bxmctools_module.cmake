@@ -64,6 +64,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/calorimeter_step_hit_processor.h
   ${module_include_dir}/${module_name}/fluence_step_hit_processor.h
   ${module_include_dir}/${module_name}/simulated_data_reader.h
+  ${module_include_dir}/${module_name}/simulated_data_index.h
   ${module_include_dir}/${module_name}/simulated_data_input_module.h
   ${module_include_dir}/${module_name}/base_step_hit.ipp
   ${module_include_dir}/${module_name}/simulated_data.ipp
@@ -87,6 +88,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/digitization/simple_linear_adc.h
   ${module_include_dir}/${module_name}/digitization/sampled_signal.h
   ${module_include_dir}/${module_name}/digitization/sampled_signal.ipp
+  ${module_include_dir}/${module_name}/digitization/sampled_signal_builder.h
   )
 
 set(${module_name}_MODULE_SOURCES
@@ -98,6 +100,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/utils.cc
   ${module_source_dir}/simulated_data.cc
   ${module_source_dir}/simulated_data_reader.cc
+  ${module_source_dir}/simulated_data_index.cc
   ${module_source_dir}/simulated_data_input_module.cc
   ${module_source_dir}/version.cc
   ${module_source_dir}/the_serializable.cc
@@ -112,6 +115,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/signal/signal_data.cc
   ${module_source_dir}/digitization/simple_linear_adc.cc
   ${module_source_dir}/digitization/sampled_signal.cc
+  ${module_source_dir}/digitization/sampled_signal_builder.cc
   )
 
 # - Published headers
@@ -141,6 +145,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_signal_signal_data.cxx
   ${module_test_dir}/test_digitization_simple_linear_adc.cxx
   ${module_test_dir}/test_digitization_sampled_signal.cxx
+  ${module_test_dir}/test_digitization_sampled_signal_builder.cxx
   )
 
 #-----------------------------------------------------------------------
@@ -96,6 +96,9 @@ namespace mygsl {
     //! Evaluation
     double _eval(double x_) const override;
 
+    //! Batch evaluation
+    void _eval_many_no_check(const double * x_, std::size_t n_, double * y_) const override;
+
   private:
 
     //! Private initialization
@@ -184,6 +184,9 @@ namespace mygsl {
 
     void add (const histogram &);
 
+    /// Add the contents and the counters of an histogram with the same binning
+    void merge (const histogram &);
+
     void sub (const histogram &);
 
     void mul (const histogram &);
@@ -13,6 +13,8 @@
 // - Boost:
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/array_optimization.hpp>
+#include <boost/serialization/array_wrapper.hpp>
 // - Bayeux/datatools :
 #include <datatools/i_serializable.ipp>
 #include <datatools/utils.h>
@@ -46,7 +48,16 @@ namespace mygsl {
         ar & boost::serialization::make_nvp ("nbins", nbins);
         _h_ = gsl_histogram_alloc (nbins);
       }
-    if (_h_->n > 0)
+    static const bool array_optimization
+      = boost::serialization::use_array_optimization<Archive>::template apply<double>::type::value;
+    if (_h_->n > 0 && array_optimization)
+      {
+        // Contiguous arrays, only for the archives which optimize them (their
+        // bytes are the same as element by element, or the archive is tagged):
+        ar & boost::serialization::make_nvp("range", boost::serialization::make_array(_h_->range, _h_->n + 1));
+        ar & boost::serialization::make_nvp("bin", boost::serialization::make_array(_h_->bin, _h_->n));
+      }
+    else if (_h_->n > 0)
       {
         for (size_t ii = 0 ; ii < _h_->n + 1; ii ++ )
           {
@@ -228,6 +228,9 @@ namespace mygsl {
 
     void add (const histogram_2d &);
 
+    /// Add the contents and the counters of an histogram with the same binning
+    void merge (const histogram_2d &);
+
     void sub (const histogram_2d &);
 
     void mul (const histogram_2d &);
@@ -13,6 +13,8 @@
 // - Boost:
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/array_optimization.hpp>
+#include <boost/serialization/array_wrapper.hpp>
 // - Bayeux/datatools :
 #include <datatools/i_serializable.ipp>
 #include <datatools/utils.h>
@@ -53,7 +55,17 @@ namespace mygsl {
         ar & boost::serialization::make_nvp ("ny", ny);
         _h_ = gsl_histogram2d_alloc (nx, ny);
       }
-    if (_h_->nx > 0 && _h_->ny > 0)
+    static const bool array_optimization
+      = boost::serialization::use_array_optimization<Archive>::template apply<double>::type::value;
+    if (_h_->nx > 0 && _h_->ny > 0 && array_optimization)
+      {
+        // Contiguous arrays, only for the archives which optimize them (their
+        // bytes are the same as element by element, or the archive is tagged):
+        ar & boost::serialization::make_nvp("xrange", boost::serialization::make_array(_h_->xrange, _h_->nx + 1));
+        ar & boost::serialization::make_nvp("yrange", boost::serialization::make_array(_h_->yrange, _h_->ny + 1));
+        ar & boost::serialization::make_nvp("bin", boost::serialization::make_array(_h_->bin, _h_->nx * _h_->ny));
+      }
+    else if (_h_->nx > 0 && _h_->ny > 0)
       {
         for (size_t ii = 0 ; ii < _h_->nx + 1; ii ++ )
           {
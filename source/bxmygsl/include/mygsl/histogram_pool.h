@@ -4,6 +4,7 @@
 #define MYGSL_HISTOGRAM_POOL_H 1
 
 // Standard library:
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <map>
@@ -73,6 +74,22 @@ namespace mygsl {
     /// Alias to histogram dictionnary
     typedef std::map<std::string, histogram_entry_type> dict_type;
 
+    /// \brief Entry of the index of a binary histogram pool file
+    ///
+    /// A binary histogram pool file starts with an index of the stored
+    /// histograms, followed by the histograms serialized in independent
+    /// portable binary archives, so that a single histogram can be loaded
+    /// without decoding the others.
+    struct binary_index_entry
+    {
+      std::string name;                            //!< Name of the histogram
+      std::string title;                           //!< Title of the histogram
+      std::string group;                           //!< Group of the histogram
+      int32_t     dimension = HISTOGRAM_DIM_UNDEFINED; //!< Dimension of the histogram
+      uint64_t    offset = 0;                      //!< Offset of the serialized histogram after the index
+      uint64_t    size = 0;                        //!< Size of the serialized histogram
+    };
+
     /// Return histogram pool description
     const std::string & get_description() const;
 
@@ -189,6 +206,42 @@ namespace mygsl {
                            const std::string & indent = "",
                            bool inherit               = false) const override;
 
+    /// Return the default extension of binary histogram pool files
+    static const std::string & binary_file_extension();
+
+    /// Check if a file is a binary histogram pool file
+    static bool is_binary_file(const std::string & filename_);
+
+    /// Read the index of a binary histogram pool file
+    static void read_binary_index(const std::string & filename_,
+                                  std::vector<binary_index_entry> & index_);
+
+    /// Store the histograms in a binary histogram pool file
+    void store_binary(const std::string & filename_) const;
+
+    /// Load all histograms from a binary histogram pool file
+    void load_binary(const std::string & filename_);
+
+    /// Load some histograms from a binary histogram pool file
+    void load_binary(const std::string & filename_,
+                     const std::vector<std::string> & names_);
+
+    /// Merge the histograms of another pool
+    ///
+    /// Histograms with the same name are summed and must have the same
+    /// dimension and binning. Other histograms are copied.
+    void merge(const histogram_pool & other_);
+
+    /// Merge the histograms stored in a list of files using a pool of threads
+    ///
+    /// Files are either binary histogram pool files or Boost archives
+    /// of histogram pools. The files are split in contiguous chunks, one per
+    /// thread, and the partial sums are merged in order, so that the result
+    /// does not depend on the scheduling of the threads. The default number
+    /// of threads is the number of hardware threads.
+    void merge_files(const std::vector<std::string> & filenames_,
+                     unsigned int nthreads_ = 0);
+
     /// Set logging priority
     void set_logging_priority(datatools::logger::priority);
 
@@ -110,6 +110,31 @@ namespace mygsl {
     //! Standard C++ functor interface
     double operator() (double x_) const;
 
+    //! Evaluate the function for an array of values: y_[i] = f(x_[i]), i in [0, n_)
+    //!
+    //! The domain of definition and the non-zero domain are fetched once
+    //! per batch. Contiguous runs of values lying in the non-zero domain
+    //! are processed by the _eval_many_no_check method. The output buffer
+    //! may be the input buffer (in place evaluation).
+    void eval_many(const double * x_, std::size_t n_, double * y_) const;
+
+    //! Evaluate the function for an array of values stored in a vector
+    void eval_many(const std::vector<double> & x_, std::vector<double> & y_) const;
+
+    //! Sample the function on a regular grid: out_[i] = f(x0_ + i * dx_), i in [0, n_)
+    //!
+    //! The domain checks are performed once per batch: samples lying out of the
+    //! non-zero domain are set to zero without any call to the evaluation method,
+    //! and the remaining range is processed by the _sample_no_check method.
+    void sample(double x0_, double dx_, std::size_t n_, double * out_) const;
+
+    //! Sample the function on a regular grid and store the results in a vector
+    void sample(double x0_, double dx_, std::size_t n_, std::vector<double> & out_) const;
+
+    //! Compute the range [first_, last_) of the indexes of a regular grid of samples which lie in the non-zero domain
+    void compute_non_zero_sample_range(double x0_, double dx_, std::size_t n_,
+                                       std::size_t & first_, std::size_t & last_) const;
+
     //! Write the (x,y=f(x)) value pairs in an ASCII stream :
     void write_ascii(std::ostream & fout_,
                      double min_, double max_, unsigned int nsamples_,
@@ -181,6 +206,24 @@ namespace mygsl {
     //! The function evaluation abstract method
     virtual double _eval(double x_) const = 0;
 
+    //! Evaluate the function for an array of values without any domain check (default: loop on eval_no_check)
+    //!
+    //! All values are guaranteed to lie in the non-zero domain of the function.
+    //! Subclasses may override this method to provide a faster batch evaluation.
+    //! Overrides must support in place evaluation (x_ == y_): y_[i] is only
+    //! written once x_[i] has been read.
+    virtual void _eval_many_no_check(const double * x_, std::size_t n_, double * y_) const;
+
+    //! Sample the function on a regular grid without any domain check (default: loop on eval_no_check)
+    //!
+    //! Only the samples of index i in [first_, last_) are computed with
+    //! out_[i] = f(x0_ + i * dx_). All these samples are guaranteed to lie in
+    //! the non-zero domain of the function. Subclasses with analytic expressions
+    //! may override this method to provide a faster batch evaluation.
+    virtual void _sample_no_check(double x0_, double dx_,
+                                  std::size_t first_, std::size_t last_,
+                                  double * out_) const;
+
     void _base_initialize(const datatools::properties & config_,
                           const unary_function_dict_type & functors_);
 
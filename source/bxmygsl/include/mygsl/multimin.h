@@ -4,7 +4,10 @@
 #define MYGSL_MULTIMIN_H 1
 
 // Standard library:
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -263,6 +266,136 @@ namespace mygsl {
 
   };
 
+  /// \brief Multimin system with an objective function written as a sum over data chunks
+  ///
+  /// The objective function is the sum of the contributions of independent
+  /// data chunks (for example the terms of a likelihood over a large
+  /// dataset) plus an optional constraint term. The contributions of the
+  /// chunks are evaluated in parallel by a pool of worker threads.
+  ///
+  /// The gradient is computed from analytic chunk gradients if the system
+  /// provides them, otherwise by central finite differences. In the latter
+  /// case, the shifted points of all free parameters are evaluated
+  /// concurrently, chunk by chunk. Partial sums are always combined in the
+  /// order of the chunks, so that the results do not depend on the number
+  /// of threads.
+  ///
+  /// The contributions are computed from an explicit vector of parameter
+  /// values (see _eval_chunk), so the chunk evaluation must not modify the
+  /// system.
+  class multimin_chunked_system : public multimin_system
+  {
+  public:
+
+    /// \brief Evaluation statistics of a fit
+    struct fit_stats
+    {
+      std::size_t f_calls = 0;        //!< Number of objective function evaluations
+      std::size_t df_calls = 0;       //!< Number of gradient evaluations
+      std::size_t fdf_calls = 0;      //!< Number of combined objective function and gradient evaluations
+      std::size_t points = 0;         //!< Number of evaluated parameter points
+      std::size_t chunk_evals = 0;    //!< Number of chunk evaluations
+      double      f_time = 0.0;       //!< Time spent in objective function evaluations (s)
+      double      df_time = 0.0;      //!< Time spent in gradient evaluations (s)
+      double      fdf_time = 0.0;     //!< Time spent in combined evaluations (s)
+
+      /// Reset the statistics
+      void reset ();
+
+      /// Print the statistics
+      void print (std::ostream & out_, const std::string & indent_ = "") const;
+    };
+
+    /// Default constructor
+    multimin_chunked_system ();
+
+    /// Destructor
+    ~multimin_chunked_system () override;
+
+    /// Return the number of threads (0: number of hardware threads)
+    unsigned int get_number_of_threads () const;
+
+    /// Set the number of threads (0: number of hardware threads)
+    void set_number_of_threads (unsigned int);
+
+    /// Return the step of numerical derivatives, relative to the steps of the parameters
+    double get_derivative_step_factor () const;
+
+    /// Set the step of numerical derivatives, relative to the steps of the parameters
+    void set_derivative_step_factor (double);
+
+    /// Return the evaluation statistics
+    const fit_stats & get_stats () const;
+
+    /// Reset the evaluation statistics
+    void reset_stats ();
+
+    int eval_fdf (const double * x_ ,
+                  double & f_ ,
+                  double * gradient_) override;
+
+  protected:
+
+    /// Return the number of data chunks
+    virtual std::size_t _get_number_of_chunks () const = 0;
+
+    /// Return the contribution of a data chunk for given values of all the parameters
+    ///
+    /// This method is called concurrently from several threads.
+    virtual double _eval_chunk (std::size_t chunk_,
+                                const std::vector<double> & values_) const = 0;
+
+    /// Check if the system provides analytic chunk gradients (see _eval_chunk_fdf)
+    virtual bool _has_chunk_gradient () const;
+
+    /// Compute the contribution of a data chunk and its gradient with respect to all the parameters
+    ///
+    /// This method is called concurrently from several threads.
+    virtual void _eval_chunk_fdf (std::size_t chunk_,
+                                  const std::vector<double> & values_,
+                                  double & f_,
+                                  std::vector<double> & gradient_) const;
+
+    /// Return the constraint term for given values of all the parameters (default: 0)
+    virtual double _eval_constraints (const std::vector<double> & values_) const;
+
+    /// No derived values by default
+    int _prepare_values () override;
+
+    int _eval_f (double & f_) override;
+
+    int _eval_df (double * gradient_) override;
+
+  private:
+
+    /// Return the current values of all the parameters
+    void _current_values_ (std::vector<double> & values_) const;
+
+    /// Build the parameter points for the numerical gradient at the current parameters
+    void _gradient_points_ (std::vector<std::vector<double> > & points_,
+                            std::vector<double> & steps_);
+
+    /// Evaluate the objective function at several parameter points
+    void _eval_points_ (const std::vector<std::vector<double> > & points_,
+                        std::vector<double> & results_);
+
+    /// Evaluate the objective function and the analytic gradient at the current parameters
+    void _eval_analytic_fdf_ (double & f_, double * gradient_);
+
+    /// Run tasks in the worker pool
+    void _run_ (std::size_t ntasks_, const std::function<void(std::size_t)> & task_);
+
+  private:
+
+    struct worker_pool;
+
+    unsigned int _number_of_threads_;       //!< Number of threads
+    double       _derivative_step_factor_;  //!< Relative step of numerical derivatives
+    fit_stats    _stats_;                   //!< Evaluation statistics
+    std::unique_ptr<worker_pool> _pool_;    //!< Pool of worker threads
+
+  };
+
   class multimin
   {
   public:
@@ -340,6 +473,7 @@ namespace mygsl {
     double                      _fdf_tol_;
     size_t                      _max_iter_;
     size_t                      _n_iter_;
+    double                      _elapsed_time_; //!< Duration of the last minimization (s)
 
     double                      _fval_;
     int                         _stopping_;
@@ -360,6 +494,9 @@ namespace mygsl {
 
     double get_fval () const;
 
+    /// Return the duration of the last minimization (s)
+    double get_elapsed_time () const;
+
     void unset_step_action ();
 
     void set_default_step_action ();
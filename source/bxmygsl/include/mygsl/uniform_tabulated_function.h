@@ -0,0 +1,189 @@
+//! \file  mygsl/uniform_tabulated_function.h
+//! \brief A function tabulated on a uniform grid from another unary functor
+//
+// This file is part of Bayeux.
+//
+// Bayeux is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Bayeux is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Bayeux. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef MYGSL_UNIFORM_TABULATED_FUNCTION_H
+#define MYGSL_UNIFORM_TABULATED_FUNCTION_H
+
+// Standard library:
+#include <vector>
+
+// This project:
+#include <mygsl/i_unary_function.h>
+
+namespace mygsl {
+
+  //! \brief Tabulate-and-cache adaptor for expensive unary functions
+  /**
+   *  The target function f is sampled once, at initialization, on a uniform
+   *  grid of [x_min, x_max]. Evaluation then uses a linear interpolation with
+   *  a direct computation of the grid cell index, without any search, any
+   *  GSL call nor any mutable state (thread safe).
+   *
+   *  The number of grid cells is doubled until the interpolation error,
+   *  checked against f at the midpoint and at the quarter points of every
+   *  cell, does not exceed the requested absolute tolerance. Initialization
+   *  fails if the tolerance cannot be reached with the maximum number of
+   *  grid nodes, or if f has non finite values.
+   *
+   *  Configuration example:
+   *  @code
+   *  function  : string = "spectrum"
+   *  x_min     : real   = 0.0
+   *  x_max     : real   = 3.0
+   *  tolerance : real   = 1e-6
+   *  max_nodes : integer = 1000000
+   *  @endcode
+   */
+  class uniform_tabulated_function
+    : public i_unary_function
+  {
+  public:
+
+    //! Default minimum number of grid cells
+    static const std::size_t DEFAULT_MIN_INTERVALS = 16;
+
+    //! Default maximum number of grid nodes
+    static const std::size_t DEFAULT_MAX_NODES = 1000000;
+
+    //! Default constructor
+    uniform_tabulated_function();
+
+    //! Constructor
+    uniform_tabulated_function(const i_unary_function & f_,
+                               double x_min_,
+                               double x_max_,
+                               double tolerance_);
+
+    //! Destructor
+    ~uniform_tabulated_function() override;
+
+    //! Check initialization status
+    bool is_initialized() const override;
+
+    //! Initialization from a container of parameters and a dictionary of functors
+    void initialize(const datatools::properties & config_,
+                    const unary_function_dict_type & functors_) override;
+
+    //! Reset the function
+    void reset() override;
+
+    //! Set the tabulated functor
+    void set_function(const i_unary_function &);
+
+    //! Check the tabulated functor
+    bool has_function() const;
+
+    //! Set the tabulation domain
+    void set_domain(double x_min_, double x_max_);
+
+    //! Return the minimum bound of the tabulation domain
+    double get_x_min() const;
+
+    //! Return the maximum bound of the tabulation domain
+    double get_x_max() const;
+
+    //! Set the requested absolute tolerance on the interpolated values
+    void set_tolerance(double);
+
+    //! Return the requested absolute tolerance on the interpolated values
+    double get_tolerance() const;
+
+    //! Set the maximum number of grid nodes
+    void set_max_number_of_nodes(std::size_t);
+
+    //! Return the maximum number of grid nodes
+    std::size_t get_max_number_of_nodes() const;
+
+    //! Return the number of grid nodes
+    std::size_t get_number_of_nodes() const;
+
+    //! Return the grid step
+    double get_step() const;
+
+    //! Return the maximum interpolation error measured at initialization
+    double get_max_error() const;
+
+    //! Check if the function has an explicit domain of definition (always true)
+    bool has_explicit_domain_of_definition() const override;
+
+    //! Check if a value is in the tabulation domain
+    bool is_in_domain_of_definition(double x_) const override;
+
+    //! The minimum bound of the non-zero domain
+    double get_non_zero_domain_min() const override;
+
+    //! The maximum bound of the non-zero domain
+    double get_non_zero_domain_max() const override;
+
+    //! Smart printing
+    void tree_dump(std::ostream & out_ = std::clog,
+                   const std::string & title_  = "",
+                   const std::string & indent_ = "",
+                   bool inherit_ = false) const override;
+
+  protected:
+
+    //! Evaluation
+    double _eval(double x_) const override;
+
+    //! Batch evaluation
+    void _eval_many_no_check(const double * x_, std::size_t n_, double * y_) const override;
+
+    //! Set default attributes
+    void _set_defaults();
+
+  private:
+
+    //! Linear interpolation in the table
+    double _interpolate_(double x_) const;
+
+    //! Build the table
+    void _build_();
+
+  private:
+
+    // Management:
+    bool _initialized_ = false; //!< Initialization flag
+
+    // Configuration:
+    unary_function_handle _f_; //!< Tabulated functor
+    double _x_min_;            //!< Minimum bound of the tabulation domain
+    double _x_max_;            //!< Maximum bound of the tabulation domain
+    double _tolerance_;        //!< Requested absolute tolerance
+    std::size_t _max_nodes_;   //!< Maximum number of grid nodes
+
+    // Working data:
+    std::vector<double> _values_; //!< Tabulated values at grid nodes
+    double _step_;                //!< Grid step
+    double _inv_step_;            //!< Inverse of the grid step
+    double _max_error_;           //!< Measured interpolation error
+
+    //! Registration of the functor class
+    MYGSL_UNARY_FUNCTOR_REGISTRATION_INTERFACE(uniform_tabulated_function)
+
+  };
+
+} // end of namespace mygsl
+
+#endif // MYGSL_UNIFORM_TABULATED_FUNCTION_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -138,6 +138,15 @@ namespace mygsl {
     return _f_.func().eval(tmp);
   }
 
+  void composite_function::_eval_many_no_check(const double * x_, std::size_t n_, double * y_) const
+  {
+    // The intermediate values are computed in the output buffer, where
+    // the outer function is then evaluated in place:
+    _g_.func().eval_many(x_, n_, y_);
+    _f_.func().eval_many(y_, n_, y_);
+    return;
+  }
+
   bool composite_function::has_explicit_domain_of_definition() const
   {
     DT_THROW_IF(!is_initialized(), std::logic_error,
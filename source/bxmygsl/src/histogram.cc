@@ -911,6 +911,27 @@ void histogram::add (const histogram & h_)
   return;
 }
 
+void histogram::merge (const histogram & h_)
+{
+  DT_THROW_IF(!is_initialized(), std::logic_error, " Histogram 1D is not initialized !");
+  DT_THROW_IF(!h_.is_initialized(), std::logic_error, " Histogram 1D is not initialized !");
+  DT_THROW_IF(!same (h_) || _binning_info_ != h_._binning_info_,
+              std::logic_error, " Histograms 1D have incompatible binnings !");
+  gsl_histogram_add (_h_,h_._h_);
+  if (is_counts_available () && h_.is_counts_available ()) {
+    _counts_ += h_._counts_;
+  } else {
+    invalidate_counts ();
+  }
+  if (are_underflow_overflow_available () && h_.are_underflow_overflow_available ()) {
+    _underflow_ += h_._underflow_;
+    _overflow_  += h_._overflow_;
+  } else {
+    invalidate_underflow_overflow ();
+  }
+  return;
+}
+
 void histogram::sub (const histogram & h_)
 {
   DT_THROW_IF(!is_initialized(), std::logic_error, " Histogram 1D is not initialized !");
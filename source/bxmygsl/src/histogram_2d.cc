@@ -936,6 +936,31 @@ namespace mygsl {
     return;
   }
 
+  void histogram_2d::merge (const histogram_2d & h_)
+  {
+    DT_THROW_IF (!is_initialized (), std::logic_error, "Histogram 2D is not initialized !");
+    DT_THROW_IF (!h_.is_initialized (), std::logic_error, "Histogram 2D is not initialized !");
+    DT_THROW_IF (!same (h_)
+                 || _x_binning_info_ != h_._x_binning_info_
+                 || _y_binning_info_ != h_._y_binning_info_,
+                 std::logic_error, "Histograms 2D have incompatible binnings !");
+    gsl_histogram2d_add (_h_,h_._h_);
+    if (is_counts_available () && h_.is_counts_available ()) {
+      _counts_ += h_._counts_;
+    } else {
+      invalidate_counts ();
+    }
+    if (are_underflow_overflow_available () && h_.are_underflow_overflow_available ()) {
+      _x_underflow_ += h_._x_underflow_;
+      _x_overflow_  += h_._x_overflow_;
+      _y_underflow_ += h_._y_underflow_;
+      _y_overflow_  += h_._y_overflow_;
+    } else {
+      invalidate_underflow_overflow ();
+    }
+    return;
+  }
+
   void histogram_2d::sub (const histogram_2d & h_)
   {
     DT_THROW_IF (!is_initialized (), std::logic_error, "Histogram 2D is not initialized !");
@@ -2,17 +2,169 @@
 
 #include <mygsl/histogram_pool.h>
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <fstream>
+#include <cstring>
+#include <thread>
 
 #include <datatools/utils.h>
 #include <datatools/units.h>
 #include <datatools/exception.h>
+#include <datatools/io_factory.h>
+#include <datatools/archives_list.h>
 
 namespace mygsl {
 
+  namespace {
+
+    /// Magic string at the beginning of binary histogram pool files
+    const char BINARY_MAGIC[8] = {'M', 'Y', 'G', 'S', 'L', 'H', 'P', 'B'};
+
+    /// Version of the binary histogram pool file format
+    const uint32_t BINARY_VERSION = 1;
+
+    // Integers are stored in little endian order:
+    void write_uint(std::ostream & out_, uint64_t value_, std::size_t nbytes_)
+    {
+      char bytes[8];
+      for (std::size_t i = 0; i < nbytes_; i++) {
+        bytes[i] = static_cast<char>((value_ >> (8 * i)) & 0xFF);
+      }
+      out_.write(bytes, nbytes_);
+      return;
+    }
+
+    uint64_t read_uint(std::istream & in_, std::size_t nbytes_)
+    {
+      unsigned char bytes[8];
+      in_.read(reinterpret_cast<char *>(bytes), nbytes_);
+      DT_THROW_IF(!in_, std::logic_error, "Truncated binary histogram pool file !");
+      uint64_t value = 0;
+      for (std::size_t i = 0; i < nbytes_; i++) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+      }
+      return value;
+    }
+
+    void write_string(std::ostream & out_, const std::string & value_)
+    {
+      write_uint(out_, value_.size(), 4);
+      out_.write(value_.data(), value_.size());
+      return;
+    }
+
+    void read_string(std::istream & in_, std::string & value_)
+    {
+      const std::size_t size = read_uint(in_, 4);
+      value_.resize(size);
+      if (size > 0) {
+        in_.read(&value_[0], size);
+        DT_THROW_IF(!in_, std::logic_error, "Truncated binary histogram pool file !");
+      }
+      return;
+    }
+
+    template <class T>
+    void to_binary_archive(const T & object_, std::string & buffer_)
+    {
+      std::ostringstream oss;
+      {
+        datatools::portable_oarchive oa(oss);
+        oa << object_;
+      }
+      buffer_ = oss.str();
+      return;
+    }
+
+    template <class T>
+    void from_binary_archive(const std::string & buffer_, T & object_)
+    {
+      std::istringstream iss(buffer_);
+      datatools::portable_iarchive ia(iss);
+      ia >> object_;
+      return;
+    }
+
+    /// \brief Header of a binary histogram pool file
+    struct binary_header
+    {
+      std::string description;
+      std::string auxiliaries;
+      std::vector<histogram_pool::binary_index_entry> index;
+      uint64_t payload_position = 0;
+    };
+
+    void read_binary_header(std::istream & in_, const std::string & filename_, binary_header & header_)
+    {
+      char magic[sizeof(BINARY_MAGIC)];
+      in_.read(magic, sizeof(magic));
+      DT_THROW_IF(!in_ || std::memcmp(magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0,
+                  std::logic_error, "File '" << filename_ << "' is not a binary histogram pool file !");
+      const uint32_t version = read_uint(in_, 4);
+      DT_THROW_IF(version != BINARY_VERSION, std::logic_error,
+                  "Unsupported version " << version << " of binary histogram pool file '" << filename_ << "' !");
+      const uint64_t index_size = read_uint(in_, 8);
+      header_.payload_position = sizeof(BINARY_MAGIC) + 4 + 8 + index_size;
+      read_string(in_, header_.description);
+      read_string(in_, header_.auxiliaries);
+      const std::size_t nentries = read_uint(in_, 4);
+      header_.index.assign(nentries, histogram_pool::binary_index_entry());
+      for (histogram_pool::binary_index_entry & entry : header_.index) {
+        read_string(in_, entry.name);
+        read_string(in_, entry.title);
+        read_string(in_, entry.group);
+        entry.dimension = static_cast<int32_t>(read_uint(in_, 4));
+        entry.offset = read_uint(in_, 8);
+        entry.size = read_uint(in_, 8);
+      }
+      return;
+    }
+
+    void load_binary_entry(std::istream & in_,
+                           const binary_header & header_,
+                           const histogram_pool::binary_index_entry & entry_,
+                           histogram_pool & pool_)
+    {
+      std::string buffer(entry_.size, '\0');
+      in_.seekg(header_.payload_position + entry_.offset);
+      in_.read(&buffer[0], entry_.size);
+      DT_THROW_IF(!in_, std::logic_error, "Truncated binary histogram pool file !");
+      if (pool_.has(entry_.name)) {
+        pool_.remove(entry_.name);
+      }
+      if (entry_.dimension == histogram_pool::HISTOGRAM_DIM_1D) {
+        histogram_1d & h1 = pool_.add_1d(entry_.name, entry_.title, entry_.group);
+        from_binary_archive(buffer, h1);
+      } else if (entry_.dimension == histogram_pool::HISTOGRAM_DIM_2D) {
+        histogram_2d & h2 = pool_.add_2d(entry_.name, entry_.title, entry_.group);
+        from_binary_archive(buffer, h2);
+      } else {
+        DT_THROW(std::logic_error, "Invalid dimension of histogram '" << entry_.name << "' !");
+      }
+      return;
+    }
+
+    /// Load a file (binary histogram pool file or Boost archive) in a pool
+    void load_pool_file(const std::string & filename_, histogram_pool & pool_)
+    {
+      std::string filename = filename_;
+      datatools::fetch_path_with_env(filename);
+      if (histogram_pool::is_binary_file(filename)) {
+        pool_.load_binary(filename);
+      } else {
+        datatools::data_reader reader(filename, datatools::using_multi_archives);
+        DT_THROW_IF(!reader.has_record_tag() || !reader.record_tag_is(histogram_pool::SERIAL_TAG),
+                    std::logic_error, "File '" << filename << "' does not contain an histogram pool !");
+        reader.load(pool_);
+      }
+      return;
+    }
+
+  } // end of anonymous namespace
+
   DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(histogram_pool::histogram_entry_type,"mygsl::histogram_pool::histogram_entry_type")
 
   DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(histogram_pool,"mygsl::histogram_pool")
@@ -1077,6 +1229,226 @@ namespace mygsl {
     return;
   }
 
+  // static
+  const std::string & histogram_pool::binary_file_extension()
+  {
+    static const std::string ext(".hpool");
+    return ext;
+  }
+
+  // static
+  bool histogram_pool::is_binary_file(const std::string & filename_)
+  {
+    std::ifstream in(filename_.c_str(), std::ios::binary);
+    char magic[sizeof(BINARY_MAGIC)];
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+  }
+
+  // static
+  void histogram_pool::read_binary_index(const std::string & filename_,
+                                         std::vector<binary_index_entry> & index_)
+  {
+    std::ifstream in(filename_.c_str(), std::ios::binary);
+    DT_THROW_IF(!in, std::runtime_error, "Cannot open file '" << filename_ << "' !");
+    binary_header header;
+    read_binary_header(in, filename_, header);
+    index_ = header.index;
+    return;
+  }
+
+  void histogram_pool::store_binary(const std::string & filename_) const
+  {
+    // Serialize the histograms and build the index:
+    std::vector<binary_index_entry> index;
+    std::vector<std::string> payloads;
+    index.reserve(_dict_.size());
+    payloads.reserve(_dict_.size());
+    uint64_t offset = 0;
+    for (dict_type::const_iterator i = _dict_.begin(); i != _dict_.end(); i++) {
+      const histogram_entry_type & he = i->second;
+      binary_index_entry entry;
+      entry.name = he.name;
+      entry.title = he.title;
+      entry.group = he.group;
+      entry.dimension = he.dimension;
+      payloads.push_back(std::string());
+      if (he.dimension == HISTOGRAM_DIM_1D) {
+        to_binary_archive(he.hh1d.get(), payloads.back());
+      } else if (he.dimension == HISTOGRAM_DIM_2D) {
+        to_binary_archive(he.hh2d.get(), payloads.back());
+      } else {
+        DT_THROW(std::logic_error, "Invalid dimension of histogram '" << he.name << "' !");
+      }
+      entry.offset = offset;
+      entry.size = payloads.back().size();
+      offset += entry.size;
+      index.push_back(entry);
+    }
+    std::ostringstream index_oss;
+    write_string(index_oss, _description_);
+    std::string auxiliaries;
+    to_binary_archive(_auxiliaries_, auxiliaries);
+    write_string(index_oss, auxiliaries);
+    write_uint(index_oss, index.size(), 4);
+    for (const binary_index_entry & entry : index) {
+      write_string(index_oss, entry.name);
+      write_string(index_oss, entry.title);
+      write_string(index_oss, entry.group);
+      write_uint(index_oss, static_cast<uint32_t>(entry.dimension), 4);
+      write_uint(index_oss, entry.offset, 8);
+      write_uint(index_oss, entry.size, 8);
+    }
+    const std::string index_buffer = index_oss.str();
+
+    std::string filename = filename_;
+    datatools::fetch_path_with_env(filename);
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    DT_THROW_IF(!out, std::runtime_error, "Cannot create file '" << filename << "' !");
+    out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    write_uint(out, BINARY_VERSION, 4);
+    write_uint(out, index_buffer.size(), 8);
+    out.write(index_buffer.data(), index_buffer.size());
+    for (const std::string & payload : payloads) {
+      out.write(payload.data(), payload.size());
+    }
+    out.close();
+    DT_THROW_IF(!out, std::runtime_error, "Cannot write file '" << filename << "' !");
+    return;
+  }
+
+  void histogram_pool::load_binary(const std::string & filename_)
+  {
+    std::string filename = filename_;
+    datatools::fetch_path_with_env(filename);
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    DT_THROW_IF(!in, std::runtime_error, "Cannot open file '" << filename << "' !");
+    binary_header header;
+    read_binary_header(in, filename, header);
+    _description_ = header.description;
+    from_binary_archive(header.auxiliaries, _auxiliaries_);
+    remove_all();
+    for (const binary_index_entry & entry : header.index) {
+      load_binary_entry(in, header, entry, *this);
+    }
+    return;
+  }
+
+  void histogram_pool::load_binary(const std::string & filename_,
+                                   const std::vector<std::string> & names_)
+  {
+    std::string filename = filename_;
+    datatools::fetch_path_with_env(filename);
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    DT_THROW_IF(!in, std::runtime_error, "Cannot open file '" << filename << "' !");
+    binary_header header;
+    read_binary_header(in, filename, header);
+    for (const std::string & name : names_) {
+      const binary_index_entry * entry = nullptr;
+      for (const binary_index_entry & e : header.index) {
+        if (e.name == name) {
+          entry = &e;
+          break;
+        }
+      }
+      DT_THROW_IF(entry == nullptr, std::logic_error,
+                  "No histogram named '" << name << "' is stored in file '" << filename << "' !");
+      load_binary_entry(in, header, *entry, *this);
+    }
+    return;
+  }
+
+  void histogram_pool::merge(const histogram_pool & other_)
+  {
+    if (&other_ == this) {
+      return;
+    }
+    if (_description_.empty()) {
+      _description_ = other_._description_;
+    }
+    if (_auxiliaries_.empty()) {
+      _auxiliaries_ = other_._auxiliaries_;
+    }
+    for (dict_type::const_iterator i = other_._dict_.begin(); i != other_._dict_.end(); i++) {
+      const histogram_entry_type & ohe = i->second;
+      dict_type::iterator found = _dict_.find(i->first);
+      if (found == _dict_.end()) {
+        if (ohe.dimension == HISTOGRAM_DIM_1D) {
+          add_1d(ohe.name, ohe.title, ohe.group) = ohe.hh1d.get();
+        } else if (ohe.dimension == HISTOGRAM_DIM_2D) {
+          add_2d(ohe.name, ohe.title, ohe.group) = ohe.hh2d.get();
+        }
+        continue;
+      }
+      histogram_entry_type & he = found->second;
+      DT_THROW_IF(he.dimension != ohe.dimension, std::logic_error,
+                  "Histograms named '" << i->first << "' have different dimensions !");
+      try {
+        if (he.dimension == HISTOGRAM_DIM_1D) {
+          he.hh1d.grab().merge(ohe.hh1d.get());
+        } else if (he.dimension == HISTOGRAM_DIM_2D) {
+          he.hh2d.grab().merge(ohe.hh2d.get());
+        }
+      } catch (std::exception & error) {
+        DT_THROW(std::logic_error, "Cannot merge histograms named '" << i->first << "': " << error.what());
+      }
+    }
+    return;
+  }
+
+  void histogram_pool::merge_files(const std::vector<std::string> & filenames_,
+                                   unsigned int nthreads_)
+  {
+    if (filenames_.empty()) {
+      return;
+    }
+    unsigned int nthreads = nthreads_;
+    if (nthreads == 0) {
+      nthreads = std::thread::hardware_concurrency();
+    }
+    if (nthreads == 0) {
+      nthreads = 1;
+    }
+    if (nthreads > filenames_.size()) {
+      nthreads = filenames_.size();
+    }
+    // Each worker sums a contiguous chunk of files in its own partial pool:
+    std::vector<histogram_pool> partials(nthreads);
+    std::vector<std::string> errors(nthreads);
+    std::vector<std::thread> workers;
+    const std::size_t chunk = (filenames_.size() + nthreads - 1) / nthreads;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      workers.push_back(std::thread([&, ithread]() {
+            const std::size_t first = ithread * chunk;
+            const std::size_t last = std::min(first + chunk, filenames_.size());
+            try {
+              for (std::size_t ifile = first; ifile < last; ifile++) {
+                DT_LOG_DEBUG(_logging_priority_, "Merging file '" << filenames_[ifile] << "'...");
+                histogram_pool file_pool;
+                load_pool_file(filenames_[ifile], file_pool);
+                try {
+                  partials[ithread].merge(file_pool);
+                } catch (std::exception & error) {
+                  DT_THROW(std::logic_error, "In file '" << filenames_[ifile] << "': " << error.what());
+                }
+              }
+            } catch (std::exception & error) {
+              errors[ithread] = error.what();
+            }
+          }));
+    }
+    for (std::thread & worker : workers) {
+      worker.join();
+    }
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      DT_THROW_IF(!errors[ithread].empty(), std::logic_error, errors[ithread]);
+    }
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+      merge(partials[ithread]);
+    }
+    return;
+  }
+
   void histogram_pool::tree_dump(std::ostream& out_,
                                  const std::string& title_,
                                  const std::string& indent_,
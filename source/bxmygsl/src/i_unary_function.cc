@@ -4,6 +4,7 @@
 #include <mygsl/i_unary_function.h>
 
 // Standard library:
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <fstream>
@@ -224,6 +225,132 @@ namespace mygsl {
     return this->eval(x_);
   }
 
+  void i_unary_function::eval_many(const double * x_, std::size_t n_, double * y_) const
+  {
+    if (n_ == 0) return;
+    DT_THROW_IF(x_ == nullptr || y_ == nullptr, std::logic_error, "Missing input or output buffer!");
+    if (has_explicit_domain_of_definition()) {
+      for (std::size_t i = 0; i < n_; i++) {
+        DT_THROW_IF(! is_in_domain_of_definition(x_[i]), std::logic_error,
+                    "Argument '" << x_[i] << "' is not in the function's domain of defintiion!");
+      }
+    }
+    if (! has_zero_domain()) {
+      _eval_many_no_check(x_, n_, y_);
+      return;
+    }
+    const bool has_min = has_non_zero_domain_min();
+    const bool has_max = has_non_zero_domain_max();
+    const double nzdmin = has_min ? get_non_zero_domain_min() : 0.0;
+    const double nzdmax = has_max ? get_non_zero_domain_max() : 0.0;
+    std::size_t i = 0;
+    while (i < n_) {
+      // Values out of the non-zero domain:
+      while (i < n_ && ((has_min && x_[i] < nzdmin) || (has_max && x_[i] > nzdmax))) {
+        y_[i] = 0.0;
+        i++;
+      }
+      // Run of values in the non-zero domain:
+      std::size_t j = i;
+      while (j < n_ && !((has_min && x_[j] < nzdmin) || (has_max && x_[j] > nzdmax))) {
+        j++;
+      }
+      if (j > i) {
+        _eval_many_no_check(x_ + i, j - i, y_ + i);
+      }
+      i = j;
+    }
+    return;
+  }
+
+  void i_unary_function::eval_many(const std::vector<double> & x_, std::vector<double> & y_) const
+  {
+    y_.resize(x_.size());
+    eval_many(x_.data(), x_.size(), y_.data());
+    return;
+  }
+
+  void i_unary_function::_eval_many_no_check(const double * x_, std::size_t n_, double * y_) const
+  {
+    for (std::size_t i = 0; i < n_; i++) {
+      y_[i] = this->eval_no_check(x_[i]);
+    }
+    return;
+  }
+
+  void i_unary_function::compute_non_zero_sample_range(double x0_, double dx_, std::size_t n_,
+                                                       std::size_t & first_, std::size_t & last_) const
+  {
+    DT_THROW_IF(!(dx_ > 0.0), std::domain_error, "Invalid sampling step '" << dx_ << "'!");
+    first_ = 0;
+    last_ = n_;
+    if (n_ == 0) return;
+    if (has_non_zero_domain_min()) {
+      double nzdmin = get_non_zero_domain_min();
+      double fi = std::ceil((nzdmin - x0_) / dx_);
+      if (fi >= (double) n_) {
+        first_ = n_;
+      } else if (fi > 0.0) {
+        first_ = (std::size_t) fi;
+      }
+      // Fix rounding effects so that the bound matches the one used by the eval method:
+      while (first_ > 0 && !(x0_ + (first_ - 1) * dx_ < nzdmin)) first_--;
+      while (first_ < n_ && x0_ + first_ * dx_ < nzdmin) first_++;
+    }
+    if (has_non_zero_domain_max()) {
+      double nzdmax = get_non_zero_domain_max();
+      double li = std::floor((nzdmax - x0_) / dx_) + 1.0;
+      if (li <= 0.0) {
+        last_ = 0;
+      } else if (li < (double) n_) {
+        last_ = (std::size_t) li;
+      }
+      while (last_ < n_ && !(x0_ + last_ * dx_ > nzdmax)) last_++;
+      while (last_ > 0 && x0_ + (last_ - 1) * dx_ > nzdmax) last_--;
+    }
+    if (last_ < first_) last_ = first_;
+    return;
+  }
+
+  void i_unary_function::sample(double x0_, double dx_, std::size_t n_, double * out_) const
+  {
+    if (n_ == 0) return;
+    DT_THROW_IF(out_ == nullptr, std::logic_error, "Missing output buffer!");
+    if (has_explicit_domain_of_definition()) {
+      // No shortcut: each sample must be checked individually:
+      for (std::size_t i = 0; i < n_; i++) {
+        out_[i] = this->eval(x0_ + i * dx_);
+      }
+      return;
+    }
+    std::size_t first = 0;
+    std::size_t last = n_;
+    compute_non_zero_sample_range(x0_, dx_, n_, first, last);
+    std::fill(out_, out_ + first, 0.0);
+    if (last > first) {
+      _sample_no_check(x0_, dx_, first, last, out_);
+    }
+    std::fill(out_ + last, out_ + n_, 0.0);
+    return;
+  }
+
+  void i_unary_function::sample(double x0_, double dx_, std::size_t n_, std::vector<double> & out_) const
+  {
+    out_.resize(n_);
+    sample(x0_, dx_, n_, out_.data());
+    return;
+  }
+
+  void i_unary_function::_sample_no_check(double x0_, double dx_,
+                                          std::size_t first_, std::size_t last_,
+                                          double * out_) const
+  {
+    for (std::size_t i = first_; i < last_; i++) {
+      out_[i] = this->eval_no_check(x0_ + i * dx_);
+    }
+    return;
+  }
+
   void i_unary_function::write_ascii_with_units(std::ostream & out_,
                                                 double min_, double max_, unsigned int nsamples_,
                                                 double x_unit_,
@@ -3,9 +3,15 @@
 #include <mygsl/multimin.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <cmath>
 
 #include <datatools/exception.h>
@@ -410,6 +416,403 @@ namespace mygsl {
 
   /**************************************************************************/
 
+  namespace {
+
+    //! Return the time elapsed since a given time point (s)
+    double seconds_since(const std::chrono::steady_clock::time_point & start_)
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+  }
+
+  /// \brief Pool of worker threads running indexed tasks
+  ///
+  /// The calling thread takes part in the processing of the tasks.
+  struct multimin_chunked_system::worker_pool
+  {
+    explicit worker_pool( unsigned int nworkers_ )
+    {
+      for (unsigned int i = 0; i < nworkers_; i++) {
+        _threads_.push_back(std::thread(&worker_pool::_work_, this));
+      }
+      return;
+    }
+
+    ~worker_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _stop_ = true;
+      }
+      _start_cv_.notify_all();
+      for (size_t i = 0; i < _threads_.size(); i++) {
+        _threads_[i].join();
+      }
+      return;
+    }
+
+    unsigned int get_number_of_threads() const
+    {
+      return _threads_.size() + 1;
+    }
+
+    void run( std::size_t ntasks_, const std::function<void(std::size_t)> & task_ )
+    {
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _task_ = &task_;
+        _ntasks_ = ntasks_;
+        _next_ = 0;
+        _nactive_ = _threads_.size();
+        _error_ = nullptr;
+        _error_task_ = 0;
+        _generation_++;
+      }
+      _start_cv_.notify_all();
+      _process_();
+      std::exception_ptr error;
+      {
+        std::unique_lock<std::mutex> lock(_mutex_);
+        _done_cv_.wait(lock, [this] { return _nactive_ == 0; });
+        _task_ = nullptr;
+        error = _error_;
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      return;
+    }
+
+  private:
+
+    void _work_()
+    {
+      unsigned long seen_generation = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(_mutex_);
+          _start_cv_.wait(lock, [this, seen_generation] {
+              return _stop_ || _generation_ != seen_generation;
+            });
+          if (_stop_) return;
+          seen_generation = _generation_;
+        }
+        _process_();
+        {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          if (--_nactive_ == 0) {
+            _done_cv_.notify_one();
+          }
+        }
+      }
+    }
+
+    void _process_()
+    {
+      while (true) {
+        const std::size_t itask = _next_.fetch_add(1);
+        if (itask >= _ntasks_) break;
+        try {
+          (*_task_)(itask);
+        } catch (...) {
+          // Keep the error of the first task for a reproducible report:
+          std::lock_guard<std::mutex> lock(_mutex_);
+          if (! _error_ || itask < _error_task_) {
+            _error_ = std::current_exception();
+            _error_task_ = itask;
+          }
+        }
+      }
+      return;
+    }
+
+    std::vector<std::thread> _threads_;
+    std::mutex _mutex_;
+    std::condition_variable _start_cv_;
+    std::condition_variable _done_cv_;
+    const std::function<void(std::size_t)> * _task_ = nullptr;
+    std::size_t _ntasks_ = 0;
+    std::atomic<std::size_t> _next_{0};
+    std::size_t _nactive_ = 0;
+    unsigned long _generation_ = 0;
+    bool _stop_ = false;
+    std::exception_ptr _error_;
+    std::size_t _error_task_ = 0;
+  };
+
+  void multimin_chunked_system::fit_stats::reset()
+  {
+    *this = fit_stats();
+    return;
+  }
+
+  void multimin_chunked_system::fit_stats::print( std::ostream & out_,
+                                                  const std::string & indent_ ) const
+  {
+    out_ << indent_ << "|-- f calls      : " << f_calls << " (" << f_time << " s)" << std::endl;
+    out_ << indent_ << "|-- df calls     : " << df_calls << " (" << df_time << " s)" << std::endl;
+    out_ << indent_ << "|-- fdf calls    : " << fdf_calls << " (" << fdf_time << " s)" << std::endl;
+    out_ << indent_ << "|-- points       : " << points << std::endl;
+    out_ << indent_ << "`-- chunk evals  : " << chunk_evals << std::endl;
+    return;
+  }
+
+  multimin_chunked_system::multimin_chunked_system()
+  {
+    _number_of_threads_ = 0;
+    _derivative_step_factor_ = 0.01;
+    return;
+  }
+
+  multimin_chunked_system::~multimin_chunked_system()
+  {
+    return;
+  }
+
+  unsigned int multimin_chunked_system::get_number_of_threads() const
+  {
+    return _number_of_threads_;
+  }
+
+  void multimin_chunked_system::set_number_of_threads( unsigned int n_ )
+  {
+    _number_of_threads_ = n_;
+    _pool_.reset();
+    return;
+  }
+
+  double multimin_chunked_system::get_derivative_step_factor() const
+  {
+    return _derivative_step_factor_;
+  }
+
+  void multimin_chunked_system::set_derivative_step_factor( double f_ )
+  {
+    DT_THROW_IF(! (f_ > 0.0), std::domain_error, "Invalid derivative step factor (" << f_ << ") !");
+    _derivative_step_factor_ = f_;
+    return;
+  }
+
+  const multimin_chunked_system::fit_stats & multimin_chunked_system::get_stats() const
+  {
+    return _stats_;
+  }
+
+  void multimin_chunked_system::reset_stats()
+  {
+    _stats_.reset();
+    return;
+  }
+
+  bool multimin_chunked_system::_has_chunk_gradient() const
+  {
+    return false;
+  }
+
+  void multimin_chunked_system::_eval_chunk_fdf( std::size_t /* chunk_ */,
+                                                 const std::vector<double> & /* values_ */,
+                                                 double & /* f_ */,
+                                                 std::vector<double> & /* gradient_ */) const
+  {
+    DT_THROW(std::logic_error, "You should provide an inherited '_eval_chunk_fdf' method in your 'multimin_chunked_system' class !");
+  }
+
+  double multimin_chunked_system::_eval_constraints( const std::vector<double> & /* values_ */) const
+  {
+    return 0.0;
+  }
+
+  int multimin_chunked_system::_prepare_values()
+  {
+    return 0;
+  }
+
+  void multimin_chunked_system::_current_values_( std::vector<double> & values_ ) const
+  {
+    values_.resize(get_dimension());
+    for (size_t i = 0; i < get_dimension(); i++) {
+      values_[i] = get_param_value(i);
+    }
+    return;
+  }
+
+  void multimin_chunked_system::_run_( std::size_t ntasks_,
+                                       const std::function<void(std::size_t)> & task_ )
+  {
+    unsigned int nthreads = _number_of_threads_;
+    if (nthreads == 0) {
+      nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    if (nthreads == 1 || ntasks_ < 2) {
+      for (std::size_t i = 0; i < ntasks_; i++) {
+        task_(i);
+      }
+      return;
+    }
+    if (! _pool_ || _pool_->get_number_of_threads() != nthreads) {
+      _pool_.reset(new worker_pool(nthreads - 1));
+    }
+    _pool_->run(ntasks_, task_);
+    return;
+  }
+
+  void multimin_chunked_system::_gradient_points_( std::vector<std::vector<double> > & points_,
+                                                   std::vector<double> & steps_ )
+  {
+    steps_.clear();
+    std::vector<double> values;
+    for (size_t i = 0; i < get_dimension(); i++) {
+      if (! is_param_free(i)) continue;
+      const double x0 = get_param_value(i);
+      const double h = _derivative_step_factor_ * get_param_step(i);
+      DT_THROW_IF(! (h > 0.0), std::logic_error,
+                  "Invalid derivative step for parameter '" << get_param_name(i) << "' !");
+      steps_.push_back(h);
+      set_param_value_no_check(i, x0 + h);
+      prepare_values();
+      _current_values_(values);
+      points_.push_back(values);
+      set_param_value_no_check(i, x0 - h);
+      prepare_values();
+      _current_values_(values);
+      points_.push_back(values);
+      set_param_value_no_check(i, x0);
+    }
+    prepare_values();
+    return;
+  }
+
+  void multimin_chunked_system::_eval_points_( const std::vector<std::vector<double> > & points_,
+                                               std::vector<double> & results_ )
+  {
+    const std::size_t nchunks = _get_number_of_chunks();
+    const std::size_t npoints = points_.size();
+    std::vector<double> partials(npoints * nchunks, 0.0);
+    _run_(npoints * nchunks, [this, &points_, &partials, nchunks] (std::size_t itask_) {
+        const std::size_t ipoint = itask_ / nchunks;
+        const std::size_t ichunk = itask_ % nchunks;
+        partials[itask_] = _eval_chunk(ichunk, points_[ipoint]);
+      });
+    // Sums are always done in the order of the chunks:
+    results_.assign(npoints, 0.0);
+    for (std::size_t ipoint = 0; ipoint < npoints; ipoint++) {
+      double sum = 0.0;
+      for (std::size_t ichunk = 0; ichunk < nchunks; ichunk++) {
+        sum += partials[ipoint * nchunks + ichunk];
+      }
+      results_[ipoint] = sum + _eval_constraints(points_[ipoint]);
+    }
+    _stats_.points += npoints;
+    _stats_.chunk_evals += npoints * nchunks;
+    return;
+  }
+
+  void multimin_chunked_system::_eval_analytic_fdf_( double & f_, double * gradient_ )
+  {
+    DT_THROW_IF(get_auto_dimension() > 0, std::logic_error,
+                "Analytic chunk gradients are not supported with AUTO parameters !");
+    const std::size_t nchunks = _get_number_of_chunks();
+    const std::size_t dim = get_dimension();
+    std::vector<double> values;
+    _current_values_(values);
+    std::vector<double> partial_f(nchunks, 0.0);
+    std::vector<std::vector<double> > partial_gradients(nchunks);
+    _run_(nchunks, [this, &values, &partial_f, &partial_gradients, dim] (std::size_t ichunk_) {
+        std::vector<double> & gradient = partial_gradients[ichunk_];
+        gradient.assign(dim, 0.0);
+        _eval_chunk_fdf(ichunk_, values, partial_f[ichunk_], gradient);
+      });
+    double f = 0.0;
+    std::vector<double> gradient(dim, 0.0);
+    for (std::size_t ichunk = 0; ichunk < nchunks; ichunk++) {
+      f += partial_f[ichunk];
+      for (std::size_t i = 0; i < dim; i++) {
+        gradient[i] += partial_gradients[ichunk][i];
+      }
+    }
+    f += _eval_constraints(values);
+    // Constraint term differentiated numerically:
+    size_t i_free = 0;
+    for (size_t i = 0; i < dim; i++) {
+      if (! is_param_free(i)) continue;
+      const double h = _derivative_step_factor_ * get_param_step(i);
+      std::vector<double> shifted = values;
+      shifted[i] = values[i] + h;
+      const double c_plus = _eval_constraints(shifted);
+      shifted[i] = values[i] - h;
+      const double c_minus = _eval_constraints(shifted);
+      gradient_[i_free] = gradient[i] + (c_plus - c_minus) / (2 * h);
+      i_free++;
+    }
+    f_ = f;
+    _stats_.points++;
+    _stats_.chunk_evals += nchunks;
+    return;
+  }
+
+  int multimin_chunked_system::_eval_f( double & f_ )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::vector<double> > points(1);
+    _current_values_(points[0]);
+    std::vector<double> results;
+    _eval_points_(points, results);
+    f_ = results[0];
+    _stats_.f_calls++;
+    _stats_.f_time += seconds_since(start);
+    return 0;
+  }
+
+  int multimin_chunked_system::_eval_df( double * gradient_ )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (_has_chunk_gradient()) {
+      double f;
+      _eval_analytic_fdf_(f, gradient_);
+    } else {
+      std::vector<std::vector<double> > points;
+      std::vector<double> steps;
+      _gradient_points_(points, steps);
+      std::vector<double> results;
+      _eval_points_(points, results);
+      for (size_t i = 0; i < steps.size(); i++) {
+        gradient_[i] = (results[2 * i] - results[2 * i + 1]) / (2 * steps[i]);
+      }
+    }
+    _stats_.df_calls++;
+    _stats_.df_time += seconds_since(start);
+    return 0;
+  }
+
+  int multimin_chunked_system::eval_fdf( const double * x_ ,
+                                         double & f_ ,
+                                         double * gradient_ )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    from_double_star(x_, get_free_dimension());
+    if (_has_chunk_gradient()) {
+      _eval_analytic_fdf_(f_, gradient_);
+    } else {
+      // The central point and the shifted points are evaluated in a single batch:
+      std::vector<std::vector<double> > points(1);
+      _current_values_(points[0]);
+      std::vector<double> steps;
+      _gradient_points_(points, steps);
+      std::vector<double> results;
+      _eval_points_(points, results);
+      f_ = results[0];
+      for (size_t i = 0; i < steps.size(); i++) {
+        gradient_[i] = (results[1 + 2 * i] - results[2 + 2 * i]) / (2 * steps[i]);
+      }
+    }
+    _stats_.fdf_calls++;
+    _stats_.fdf_time += seconds_since(start);
+    return 0;
+  }
+
+  /**************************************************************************/
+
   double multimin::multimin_f( const gsl_vector * v_ ,
                                void * params_ )
   {
@@ -724,6 +1127,7 @@ namespace mygsl {
     }
     _n_iter_ = 0;
     _fval_   = 0.0;
+    _elapsed_time_ = 0.0;
     //std::cerr << "multimin::reset: done." << std::endl;
     return;
   }
@@ -738,6 +1142,11 @@ namespace mygsl {
     return _fval_;
   }
 
+  double multimin::get_elapsed_time() const
+  {
+    return _elapsed_time_;
+  }
+
   multimin::multimin()
   {
     _algo_fdf_ = 0;
@@ -766,6 +1175,7 @@ namespace mygsl {
     _at_step_action_ = 0;
 
     _n_iter_ = 0;
+    _elapsed_time_ = 0.0;
 
     return;
   }
@@ -794,6 +1204,7 @@ namespace mygsl {
 
   int multimin::minimize( double /*epsabs_*/ )
   {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     size_t iter   = 0;
     int    status = 0;
     size_t dim    = 0;
@@ -872,6 +1283,7 @@ namespace mygsl {
       // if ( multimin::g_debug ) std::clog << "multimin::minimize: END" << std::endl;
       _sys_->from_double_star(x,dim);
     }
+    _elapsed_time_ = seconds_since(start);
 
     return status;
   }
@@ -4,6 +4,7 @@
 #include <mygsl/polynomial.h>
 
 // Standard library:
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 #include <cmath> // for std::abs
@@ -192,6 +193,26 @@ namespace mygsl {
     return gsl_poly_eval(first_arg, sz, x_);
   }
 
+  void polynomial::_eval_many_no_check(const double * x_, std::size_t n_, double * y_) const
+  {
+    const std::size_t sz = _c_.size();
+    if (sz == 0) {
+      std::fill(y_, y_ + n_, 0.0);
+      return;
+    }
+    const double * c = _c_.data();
+    // Horner scheme (same arithmetic as gsl_poly_eval):
+    for (std::size_t i = 0; i < n_; i++) {
+      const double x = x_[i];
+      double ans = c[sz - 1];
+      for (std::size_t k = sz - 1; k > 0; k--) {
+        ans = c[k - 1] + x * ans;
+      }
+      y_[i] = ans;
+    }
+    return;
+  }
+
   void polynomial::tree_dump(std::ostream & out_,
                              const std::string & title_,
                              const std::string & indent_,
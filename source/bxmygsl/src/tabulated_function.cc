@@ -87,8 +87,7 @@ namespace mygsl {
     bool             _table_locked_;
     std::string      _interpolator_name_;
     tabulated_function::points_map_type _points_;
-    gsl_spline       *_gs_;
-    gsl_interp_accel *_giacc_;
+    gsl_spline       *_gs_; ///< Interpolation data (read-only once the table is locked)
     double           _x_min_;
     double           _x_max_;
   };
@@ -99,12 +98,7 @@ namespace mygsl {
       gsl_spline_free(_gs_);
       _gs_    = 0;
     }
-    if (_giacc_ != 0) {
-      gsl_interp_accel_free(_giacc_);
-      _giacc_ = 0;
-    }
     _gs_    = 0;
-    _giacc_ = 0;
     _x_min_ = 0.0;
     _x_max_ = -1.0;
     _interpolator_name_.clear();
@@ -118,7 +112,6 @@ namespace mygsl {
     _verbose_ = false;
     _table_locked_ = false;
     _gs_    = 0;
-    _giacc_ = 0;
     _x_min_ = 0.0;
     _x_max_ = -1.0;
     return;
@@ -147,7 +140,6 @@ namespace mygsl {
     pImpl = new tabfunc_impl;
     pImpl->_table_locked_ = false;
     pImpl->_gs_     = 0;
-    pImpl->_giacc_  = 0;
     pImpl->_x_min_  = 0.0;
     pImpl->_x_max_  = -1.0;
     pImpl->_interpolator_name_ = interp_name_;
@@ -162,7 +154,6 @@ namespace mygsl {
     pImpl = new tabfunc_impl;
     pImpl->_table_locked_ = false;
     pImpl->_gs_     = 0;
-    pImpl->_giacc_  = 0;
     pImpl->_x_min_  = 0.0;
     pImpl->_x_max_  = -1.0;
     pImpl->_interpolator_name_ = tab_func_.interpolator_name();
@@ -326,8 +317,6 @@ namespace mygsl {
       }
     }
 
-    pImpl->_giacc_ = gsl_interp_accel_alloc();
-
     double *x_tmp = new double[npoints];
     double *y_tmp = new double[npoints];
 
@@ -364,12 +353,8 @@ namespace mygsl {
     if (!is_table_locked()) return;
 
     if (pImpl->_gs_ != 0) {
-      if (pImpl->_giacc_ != 0) {
-        gsl_interp_accel_free(pImpl->_giacc_);
-      }
       gsl_spline_free(pImpl->_gs_);
       pImpl->_gs_    = 0;
-      pImpl->_giacc_ = 0;
       pImpl->_x_min_ = 0.0;
       pImpl->_x_max_ = -1.0;
     }
@@ -504,10 +489,27 @@ namespace mygsl {
   double tabulated_function::_eval(double x_) const
   {
     DT_THROW_IF (!is_table_locked(), std::logic_error, "Object not locked !");
-    double y = gsl_spline_eval(pImpl->_gs_, x_, pImpl->_giacc_);
+    // The interpolation accelerator is local to the call so that concurrent
+    // evaluations from several threads do not share any mutable state:
+    gsl_interp_accel giacc;
+    gsl_interp_accel_reset(&giacc);
+    double y = gsl_spline_eval(pImpl->_gs_, x_, &giacc);
     return y;
   }
 
+  void tabulated_function::_eval_many_no_check(const double * x_, std::size_t n_, double * y_) const
+  {
+    DT_THROW_IF (!is_table_locked(), std::logic_error, "Object not locked !");
+    // One accelerator for the whole batch: the cached interval is reused
+    // from one value to the next, which is efficient for sorted inputs.
+    gsl_interp_accel giacc;
+    gsl_interp_accel_reset(&giacc);
+    for (std::size_t i = 0; i < n_; i++) {
+      y_[i] = gsl_spline_eval(pImpl->_gs_, x_[i], &giacc);
+    }
+    return;
+  }
+
   void tabulated_function::load_from_file(const std::string & filename_,
                                           uint32_t /* options_ */)
   {
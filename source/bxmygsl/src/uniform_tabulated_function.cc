@@ -0,0 +1,350 @@
+//! \file mygsl/uniform_tabulated_function.cc
+//
+// This file is part of Bayeux.
+//
+// Bayeux is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Bayeux is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Bayeux. If not, see <http://www.gnu.org/licenses/>.
+
+// Ourselves:
+#include <mygsl/uniform_tabulated_function.h>
+
+// Standard library:
+#include <cmath>
+#include <algorithm>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+#include <datatools/properties.h>
+
+namespace mygsl {
+
+  namespace {
+
+    //! Linear interpolation in a table of values sampled on a uniform grid
+    double interpolate_uniform(const std::vector<double> & values_,
+                               double x_min_,
+                               double inv_step_,
+                               double x_)
+    {
+      const std::size_t nintervals = values_.size() - 1;
+      const double u = (x_ - x_min_) * inv_step_;
+      std::size_t i = (u > 0.0) ? (std::size_t) u : 0;
+      if (i >= nintervals) i = nintervals - 1;
+      const double t = u - i;
+      return values_[i] + t * (values_[i + 1] - values_[i]);
+    }
+
+  }
+
+  MYGSL_UNARY_FUNCTOR_REGISTRATION_IMPLEMENT(uniform_tabulated_function,
+                                             "mygsl::uniform_tabulated_function")
+
+  const std::size_t uniform_tabulated_function::DEFAULT_MIN_INTERVALS;
+  const std::size_t uniform_tabulated_function::DEFAULT_MAX_NODES;
+
+  void uniform_tabulated_function::_set_defaults()
+  {
+    datatools::invalidate(_x_min_);
+    datatools::invalidate(_x_max_);
+    datatools::invalidate(_tolerance_);
+    _max_nodes_ = DEFAULT_MAX_NODES;
+    datatools::invalidate(_step_);
+    datatools::invalidate(_inv_step_);
+    datatools::invalidate(_max_error_);
+    return;
+  }
+
+  uniform_tabulated_function::uniform_tabulated_function()
+  {
+    _set_defaults();
+    return;
+  }
+
+  uniform_tabulated_function::uniform_tabulated_function(const i_unary_function & f_,
+                                                         double x_min_,
+                                                         double x_max_,
+                                                         double tolerance_)
+  {
+    _set_defaults();
+    set_function(f_);
+    set_domain(x_min_, x_max_);
+    set_tolerance(tolerance_);
+    initialize_simple();
+    return;
+  }
+
+  uniform_tabulated_function::~uniform_tabulated_function()
+  {
+    return;
+  }
+
+  bool uniform_tabulated_function::is_initialized() const
+  {
+    return _initialized_;
+  }
+
+  void uniform_tabulated_function::set_function(const i_unary_function & f_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Function is already initialized!");
+    DT_THROW_IF(!f_.is_initialized(), std::logic_error, "Tabulated functor is not initialized!");
+    _f_.reset(f_);
+    return;
+  }
+
+  bool uniform_tabulated_function::has_function() const
+  {
+    return !_f_.is_null();
+  }
+
+  void uniform_tabulated_function::set_domain(double x_min_, double x_max_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Function is already initialized!");
+    DT_THROW_IF(!std::isfinite(x_min_) || !std::isfinite(x_max_) || !(x_min_ < x_max_),
+                std::domain_error, "Invalid tabulation domain [" << x_min_ << ";" << x_max_ << "]!");
+    _x_min_ = x_min_;
+    _x_max_ = x_max_;
+    return;
+  }
+
+  double uniform_tabulated_function::get_x_min() const
+  {
+    return _x_min_;
+  }
+
+  double uniform_tabulated_function::get_x_max() const
+  {
+    return _x_max_;
+  }
+
+  void uniform_tabulated_function::set_tolerance(double tolerance_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Function is already initialized!");
+    DT_THROW_IF(!(tolerance_ > 0.0), std::domain_error, "Invalid tolerance '" << tolerance_ << "'!");
+    _tolerance_ = tolerance_;
+    return;
+  }
+
+  double uniform_tabulated_function::get_tolerance() const
+  {
+    return _tolerance_;
+  }
+
+  void uniform_tabulated_function::set_max_number_of_nodes(std::size_t max_nodes_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Function is already initialized!");
+    DT_THROW_IF(max_nodes_ < DEFAULT_MIN_INTERVALS + 1, std::domain_error,
+                "Invalid maximum number of nodes [" << max_nodes_ << "]!");
+    _max_nodes_ = max_nodes_;
+    return;
+  }
+
+  std::size_t uniform_tabulated_function::get_max_number_of_nodes() const
+  {
+    return _max_nodes_;
+  }
+
+  std::size_t uniform_tabulated_function::get_number_of_nodes() const
+  {
+    return _values_.size();
+  }
+
+  double uniform_tabulated_function::get_step() const
+  {
+    return _step_;
+  }
+
+  double uniform_tabulated_function::get_max_error() const
+  {
+    return _max_error_;
+  }
+
+  void uniform_tabulated_function::initialize(const datatools::properties & config_,
+                                              const unary_function_dict_type & functors_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error, "Function is already initialized!");
+    this->i_unary_function::_base_initialize(config_, functors_);
+
+    if (_f_.is_null()) {
+      if (config_.has_key("function")) {
+        const std::string & functor_name = config_.fetch_string("function");
+        unary_function_dict_type::const_iterator found = functors_.find(functor_name);
+        DT_THROW_IF(found == functors_.end(), std::logic_error,
+                    "No functor with name '" << functor_name << "'!");
+        _f_.reset(found->second.to_const());
+      }
+    }
+    DT_THROW_IF(_f_.is_null(), std::logic_error, "Missing tabulated functor!");
+
+    if (!datatools::is_valid(_x_min_)) {
+      if (config_.has_key("x_min") && config_.has_key("x_max")) {
+        set_domain(config_.fetch_real("x_min"), config_.fetch_real("x_max"));
+      }
+    }
+    DT_THROW_IF(!datatools::is_valid(_x_min_), std::logic_error, "Missing tabulation domain!");
+
+    if (!datatools::is_valid(_tolerance_)) {
+      if (config_.has_key("tolerance")) {
+        set_tolerance(config_.fetch_real("tolerance"));
+      }
+    }
+    DT_THROW_IF(!datatools::is_valid(_tolerance_), std::logic_error, "Missing tolerance!");
+
+    if (config_.has_key("max_nodes")) {
+      int max_nodes = config_.fetch_integer("max_nodes");
+      DT_THROW_IF(max_nodes < 1, std::domain_error, "Invalid maximum number of nodes!");
+      set_max_number_of_nodes((std::size_t) max_nodes);
+    }
+
+    _build_();
+    _initialized_ = true;
+    return;
+  }
+
+  void uniform_tabulated_function::reset()
+  {
+    _initialized_ = false;
+    _f_.reset();
+    _values_.clear();
+    _set_defaults();
+    this->i_unary_function::_base_reset();
+    return;
+  }
+
+  void uniform_tabulated_function::_build_()
+  {
+    const i_unary_function & f = _f_.func();
+    const double span = _x_max_ - _x_min_;
+    std::size_t nintervals = DEFAULT_MIN_INTERVALS;
+    std::vector<double> values;
+    while (true) {
+      const double step = span / nintervals;
+      const double inv_step = nintervals / span;
+      values.resize(nintervals + 1);
+      for (std::size_t i = 0; i < nintervals; i++) {
+        values[i] = f.eval(_x_min_ + i * step);
+      }
+      values[nintervals] = f.eval(_x_max_);
+      for (std::size_t i = 0; i <= nintervals; i++) {
+        DT_THROW_IF(!std::isfinite(values[i]), std::domain_error,
+                    "Tabulated functor has a non finite value at x=" << _x_min_ + i * step << "!");
+      }
+      // Check the interpolation error against the tabulated functor inside each
+      // cell, using the lookup performed at evaluation:
+      double max_error = 0.0;
+      static const double test_points[3] = {0.25, 0.5, 0.75};
+      for (std::size_t i = 0; i < nintervals && max_error <= _tolerance_; i++) {
+        for (double t : test_points) {
+          const double x = _x_min_ + (i + t) * step;
+          const double expected = f.eval(x);
+          DT_THROW_IF(!std::isfinite(expected), std::domain_error,
+                      "Tabulated functor has a non finite value at x=" << x << "!");
+          const double error = std::abs(expected - interpolate_uniform(values, _x_min_, inv_step, x));
+          if (error > max_error) max_error = error;
+        }
+      }
+      if (max_error <= _tolerance_) {
+        _values_.swap(values);
+        _step_ = step;
+        _inv_step_ = inv_step;
+        _max_error_ = max_error;
+        break;
+      }
+      // Refine the grid:
+      DT_THROW_IF(2 * nintervals + 1 > _max_nodes_, std::logic_error,
+                  "Cannot reach the requested tolerance " << _tolerance_
+                  << " with at most " << _max_nodes_ << " nodes (interpolation error "
+                  << max_error << " with " << nintervals + 1 << " nodes)!");
+      nintervals *= 2;
+    }
+    return;
+  }
+
+  double uniform_tabulated_function::_interpolate_(double x_) const
+  {
+    return interpolate_uniform(_values_, _x_min_, _inv_step_, x_);
+  }
+
+  double uniform_tabulated_function::_eval(double x_) const
+  {
+    return _interpolate_(x_);
+  }
+
+  void uniform_tabulated_function::_eval_many_no_check(const double * x_, std::size_t n_, double * y_) const
+  {
+    for (std::size_t i = 0; i < n_; i++) {
+      y_[i] = _interpolate_(x_[i]);
+    }
+    return;
+  }
+
+  bool uniform_tabulated_function::has_explicit_domain_of_definition() const
+  {
+    return true;
+  }
+
+  bool uniform_tabulated_function::is_in_domain_of_definition(double x_) const
+  {
+    return x_ >= _x_min_ && x_ <= _x_max_;
+  }
+
+  double uniform_tabulated_function::get_non_zero_domain_min() const
+  {
+    if (has_function() && _f_.func().has_non_zero_domain_min()) {
+      return std::max(_x_min_, _f_.func().get_non_zero_domain_min());
+    }
+    return _x_min_;
+  }
+
+  double uniform_tabulated_function::get_non_zero_domain_max() const
+  {
+    if (has_function() && _f_.func().has_non_zero_domain_max()) {
+      return std::min(_x_max_, _f_.func().get_non_zero_domain_max());
+    }
+    return _x_max_;
+  }
+
+  void uniform_tabulated_function::tree_dump(std::ostream & out_,
+                                             const std::string & title_,
+                                             const std::string & indent_,
+                                             bool inherit_) const
+  {
+    this->i_unary_function::tree_dump(out_, title_, indent_, true);
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Tabulated functor : ";
+    if (has_function()) {
+      out_ << "@[" << &_f_.func() << "]";
+    } else {
+      out_ << "<none>";
+    }
+    out_ << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Domain : [" << _x_min_ << ";" << _x_max_ << "]" << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Tolerance : " << _tolerance_ << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::tag
+         << "Number of nodes : " << _values_.size()
+         << " (max=" << _max_nodes_ << ")" << std::endl;
+
+    out_ << indent_ << i_tree_dumpable::inherit_tag(inherit_)
+         << "Measured max error : " << _max_error_ << std::endl;
+
+    return;
+  }
+
+} // end of namespace mygsl
@@ -10,9 +10,13 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <stdexcept>
 
 #include <boost/filesystem.hpp>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
+#include <datatools/time_tools.h>
+#include <datatools/clhep_units.h>
 
 
 #include <mygsl/histogram.h>
@@ -250,6 +254,44 @@ int main(int /* argc_ */, char ** /* argv_ */)
         }
 
       }
+      {
+        std::clog << "INFO: "
+                  << "Test binary serialization of a large histogram..."
+                  << std::endl;
+        mygsl::histogram hbig(1000000, 0.0, 1.0);
+        for (size_t i = 0; i < 10 * hbig.bins(); i++)
+          {
+            hbig.fill(drand48(), drand48());
+          }
+        std::string filename = "test_histogram_big.data";
+        datatools::computing_time store_ct;
+        {
+          datatools::data_writer writer(filename);
+          store_ct.start();
+          writer.store(hbig);
+          store_ct.stop();
+        }
+        mygsl::histogram hbigbis;
+        datatools::computing_time load_ct;
+        {
+          datatools::data_reader reader(filename);
+          load_ct.start();
+          reader.load(hbigbis);
+          load_ct.stop();
+        }
+        DT_THROW_IF(hbigbis.bins() != hbig.bins(), std::logic_error,
+                    "Unmatching number of bins!");
+        for (size_t i = 0; i < hbig.bins(); i++)
+          {
+            DT_THROW_IF(hbigbis.get(i) != hbig.get(i), std::logic_error,
+                        "Unmatching bin #" << i << "!");
+          }
+        std::clog << "INFO: Histogram with " << hbig.bins() << " bins: store: "
+                  << store_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms, load: "
+                  << load_ct.get_last_elapsed_time() / CLHEP::millisecond << " ms"
+                  << std::endl;
+      }
+
      try
         {
           mygsl::histogram local_h;
@@ -10,6 +10,7 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include <boost/filesystem.hpp>
 // - Bayeux/datatools:
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
 #include <mygsl/histogram_pool.h>
 #include <mygsl/rng.h>
 
@@ -305,6 +307,101 @@ void test_5 ()
 }
 
 
+void test_6 ()
+{
+  std::clog << "==============> test_6" << std::endl;
+
+  // Outputs of several jobs :
+  std::vector<std::string> filenames;
+  mygsl::histogram_pool expected ("Expected merged histograms");
+  for (int ijob = 0; ijob < 5; ijob++)
+    {
+      mygsl::histogram_pool HP ("Job histograms");
+      mygsl::histogram_1d & h1 = HP.add_1d ("h1", "The h1 1D-histogram", "grp1");
+      mygsl::histogram_2d & h2 = HP.add_2d ("h2", "The h2 2D-histogram", "grp1");
+      h1.initialize (20, 0.0, 10.0);
+      h2.initialize (20, 0.0, 10.0, 10, 1.e-5, 1.e5,
+                     mygsl::BIN_MODE_LINEAR,
+                     mygsl::BIN_MODE_LOG);
+      h1.grab_auxiliaries ().set_flag ("F1");
+      mygsl::rng random (mygsl::rng::DEFAULT_RNG_TYPE, 12345 + ijob);
+      for (int i = 0; i < 10000; i++)
+        {
+          double x1 = random.exponential (3.3);
+          double x2 = std::exp (std::log (10.) * random.flat (-2.5, 2.5));
+          h1.fill (x1);
+          h2.fill (x1, x2);
+        }
+      if (ijob == 2)
+        {
+          // Only some jobs produce this histogram :
+          HP.add_1d ("h3", "The h3 1D-histogram").initialize (10, 0.0, 1.0);
+          HP.grab_1d ("h3").fill (0.5);
+        }
+      std::ostringstream filename_oss;
+      filename_oss << "test_histogram_pool_" << ijob << mygsl::histogram_pool::binary_file_extension ();
+      HP.store_binary (filename_oss.str ());
+      filenames.push_back (filename_oss.str ());
+      expected.merge (HP);
+    }
+
+  // Index and partial loading :
+  std::vector<mygsl::histogram_pool::binary_index_entry> index;
+  mygsl::histogram_pool::read_binary_index (filenames[2], index);
+  for (const mygsl::histogram_pool::binary_index_entry & entry : index)
+    {
+      std::clog << "Histogram '" << entry.name << "' (" << entry.dimension << "D) : "
+                << entry.size << " bytes" << std::endl;
+    }
+  DT_THROW_IF (index.size () != 3, std::logic_error, "Unexpected number of indexed histograms !");
+  {
+    mygsl::histogram_pool HP;
+    HP.load_binary (filenames[0], std::vector<std::string> (1, "h2"));
+    DT_THROW_IF (HP.size () != 1 || !HP.has_2d ("h2"), std::logic_error, "Partial loading failed !");
+    mygsl::histogram_pool HP2;
+    HP2.load_binary (filenames[0]);
+    DT_THROW_IF (HP2.get_description () != "Job histograms", std::logic_error, "Unexpected description !");
+    DT_THROW_IF (!HP2.get_1d ("h1").get_auxiliaries ().has_flag ("F1"), std::logic_error, "Missing auxiliaries !");
+    DT_THROW_IF (HP2.get_1d ("h1").counts () != 10000, std::logic_error, "Unexpected counts !");
+  }
+
+  // Parallel merge :
+  mygsl::histogram_pool merged;
+  merged.merge_files (filenames, 3);
+  merged.tree_dump (std::clog, "Merged histograms : ", "INFO: ");
+  DT_THROW_IF (merged.size () != 3, std::logic_error, "Unexpected number of merged histograms !");
+  DT_THROW_IF (merged.get_1d ("h1").counts () != 50000, std::logic_error, "Unexpected merged counts !");
+  DT_THROW_IF (merged.get_1d ("h3").counts () != 1, std::logic_error, "Unexpected merged counts !");
+  for (size_t i = 0; i < merged.get_1d ("h1").bins (); i++)
+    {
+      DT_THROW_IF (merged.get_1d ("h1").get (i) != expected.get_1d ("h1").get (i),
+                   std::logic_error, "Unexpected merged bin content !");
+    }
+  DT_THROW_IF (std::abs (merged.get_2d ("h2").sum () - expected.get_2d ("h2").sum ()) > 1e-9,
+               std::logic_error, "Unexpected merged 2D histogram !");
+
+  // Incompatible binnings are rejected :
+  {
+    mygsl::histogram_pool HP;
+    HP.add_1d ("h1").initialize (10, 0.0, 10.0);
+    HP.store_binary ("test_histogram_pool_bad" + mygsl::histogram_pool::binary_file_extension ());
+    filenames.push_back ("test_histogram_pool_bad" + mygsl::histogram_pool::binary_file_extension ());
+    mygsl::histogram_pool merged2;
+    bool rejected = false;
+    try
+      {
+        merged2.merge_files (filenames, 2);
+      }
+    catch (std::exception & error)
+      {
+        std::clog << "As expected: " << error.what () << std::endl;
+        rejected = true;
+      }
+    DT_THROW_IF (!rejected, std::logic_error, "Incompatible binnings were not rejected !");
+  }
+  return;
+}
+
 
 int main (int /* argc_ */, char ** /* argv_ */)
 {
@@ -330,6 +427,9 @@ int main (int /* argc_ */, char ** /* argv_ */)
       std::clog << "NOTICE: Running test #5..." << std::endl;
       test_5 ();
 
+      std::clog << "NOTICE: Running test #6..." << std::endl;
+      test_6 ();
+
       std::clog << "NOTICE: The end." << std::endl;
 
     }
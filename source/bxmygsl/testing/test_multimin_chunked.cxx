@@ -0,0 +1,187 @@
+// test_multimin_chunked.cxx
+
+// Standard library:
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <mygsl/multimin.h>
+
+/// Unbinned gaussian likelihood fit with data split in chunks
+class gauss_fit_system : public mygsl::multimin_chunked_system
+{
+public:
+
+  gauss_fit_system(const std::vector<double> & data_, std::size_t chunk_size_, bool analytic_)
+    : _data_(data_), _chunk_size_(chunk_size_), _analytic_(analytic_)
+  {
+    return;
+  }
+
+protected:
+
+  std::size_t _get_number_of_chunks() const override
+  {
+    return (_data_.size() + _chunk_size_ - 1) / _chunk_size_;
+  }
+
+  double _eval_chunk(std::size_t chunk_, const std::vector<double> & values_) const override
+  {
+    const double mu = values_[0];
+    const double sigma = values_[1];
+    double nll = 0.0;
+    const std::size_t last = std::min(_data_.size(), (chunk_ + 1) * _chunk_size_);
+    for (std::size_t i = chunk_ * _chunk_size_; i < last; i++) {
+      const double t = (_data_[i] - mu) / sigma;
+      nll += 0.5 * t * t + std::log(sigma);
+    }
+    return nll;
+  }
+
+  bool _has_chunk_gradient() const override
+  {
+    return _analytic_;
+  }
+
+  void _eval_chunk_fdf(std::size_t chunk_,
+                       const std::vector<double> & values_,
+                       double & f_,
+                       std::vector<double> & gradient_) const override
+  {
+    const double mu = values_[0];
+    const double sigma = values_[1];
+    f_ = 0.0;
+    const std::size_t last = std::min(_data_.size(), (chunk_ + 1) * _chunk_size_);
+    for (std::size_t i = chunk_ * _chunk_size_; i < last; i++) {
+      const double t = (_data_[i] - mu) / sigma;
+      f_ += 0.5 * t * t + std::log(sigma);
+      gradient_[0] -= t / sigma;
+      gradient_[1] += (1.0 - t * t) / sigma;
+    }
+    return;
+  }
+
+  double _eval_constraints(const std::vector<double> & values_) const override
+  {
+    // Keep the width away from zero:
+    const double sigma_min = 0.1;
+    if (values_[1] < sigma_min) {
+      const double d = sigma_min - values_[1];
+      return 1.e6 * d * d;
+    }
+    return 0.0;
+  }
+
+private:
+
+  const std::vector<double> & _data_;
+  std::size_t _chunk_size_;
+  bool _analytic_;
+
+};
+
+struct fit_result
+{
+  int status;
+  double mu;
+  double sigma;
+  double fval;
+};
+
+fit_result run_fit(const std::string & algo_,
+                   const std::vector<double> & data_,
+                   unsigned int nthreads_,
+                   bool analytic_)
+{
+  gauss_fit_system sys(data_, 1000, analytic_);
+  sys.set_number_of_threads(nthreads_);
+  typedef mygsl::multimin_system::param_entry pe;
+  sys.add_param(pe::make_param_entry_ranged("mu", 0.5, -10.0, 10.0, 0.01));
+  sys.add_param(pe::make_param_entry_ranged("sigma", 1.5, 0.1, 10.0, 0.01));
+  sys.lock_params();
+  mygsl::multimin mm;
+  mm.init(algo_, sys);
+  fit_result result;
+  result.status = mm.minimize(1.e-2);
+  result.mu = sys.get_param_value(0);
+  result.sigma = sys.get_param_value(1);
+  result.fval = mm.get_fval();
+  std::clog << "Fit '" << algo_ << "' with " << nthreads_ << " thread(s)"
+            << (analytic_ ? " (analytic gradient)" : "") << " : "
+            << "status=" << result.status
+            << " mu=" << result.mu
+            << " sigma=" << result.sigma
+            << " iterations=" << mm.get_n_iter()
+            << " time=" << mm.get_elapsed_time() << " s" << std::endl;
+  sys.get_stats().print(std::clog, "  ");
+  return result;
+}
+
+void check_same(const fit_result & r1_, const fit_result & r2_)
+{
+  DT_THROW_IF(r1_.status != r2_.status
+              || r1_.mu != r2_.mu
+              || r1_.sigma != r2_.sigma
+              || r1_.fval != r2_.fval,
+              std::logic_error, "Results depend on the number of threads !");
+  return;
+}
+
+void check_solution(const fit_result & r_, double tolerance_)
+{
+  DT_THROW_IF(r_.status != 0, std::logic_error, "Fit did not converge !");
+  DT_THROW_IF(std::abs(r_.mu - 1.0) > tolerance_, std::logic_error, "Unexpected mean " << r_.mu << " !");
+  DT_THROW_IF(std::abs(r_.sigma - 2.0) > tolerance_, std::logic_error, "Unexpected width " << r_.sigma << " !");
+  return;
+}
+
+int main(int /* argc_ */, char ** /* argv_ */)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for class 'mygsl::multimin_chunked_system'!" << std::endl;
+
+    std::mt19937 gen(314159);
+    std::normal_distribution<double> gauss(1.0, 2.0);
+    std::vector<double> data(50000);
+    for (std::size_t i = 0; i < data.size(); i++) {
+      data[i] = gauss(gen);
+    }
+
+    // Numerical gradient:
+    const fit_result bfgs1 = run_fit("vector_bfgs", data, 1, false);
+    const fit_result bfgs4 = run_fit("vector_bfgs", data, 4, false);
+    check_solution(bfgs1, 0.05);
+    check_same(bfgs1, bfgs4);
+
+    // Analytic gradient:
+    const fit_result agrad1 = run_fit("conjugate_fr", data, 1, true);
+    const fit_result agrad4 = run_fit("conjugate_fr", data, 4, true);
+    check_solution(agrad1, 0.05);
+    check_same(agrad1, agrad4);
+
+    // Simplex:
+    const fit_result simplex1 = run_fit("nmsimplex", data, 1, false);
+    const fit_result simplex4 = run_fit("nmsimplex", data, 4, false);
+    check_same(simplex1, simplex4);
+
+    std::clog << "The end." << std::endl;
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error!" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
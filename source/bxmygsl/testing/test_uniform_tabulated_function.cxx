@@ -0,0 +1,163 @@
+// test_uniform_tabulated_function.cxx
+
+// Ourselves:
+#include <mygsl/uniform_tabulated_function.h>
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <mygsl/polynomial.h>
+#include <mygsl/gaussian_function.h>
+#include <mygsl/tabulated_function.h>
+#include <mygsl/composite_function.h>
+#include <mygsl/plain_function_wrapper.h>
+
+void check_eval_many(const mygsl::i_unary_function & f_,
+                     const std::vector<double> & xs_,
+                     const std::string & label_);
+
+void check_concurrent_eval(const mygsl::i_unary_function & f_,
+                           const std::vector<double> & xs_,
+                           const std::string & label_);
+
+int main(/*int argc_ , char ** argv_*/)
+{
+  try {
+
+    std::vector<double> xs;
+    for (int i = 0; i <= 1000; i++) {
+      xs.push_back(-1.0 + 6.0 * i / 1000);
+    }
+
+    mygsl::polynomial p(1.0, -2.0, 0.5);
+    check_eval_many(p, xs, "polynomial");
+
+    mygsl::gaussian_function g(0.7, 2.0);
+    check_eval_many(g, xs, "gaussian");
+
+    mygsl::plain_function_wrapper pfw0("pow2");
+    mygsl::composite_function cf(pfw0, g);
+    check_eval_many(cf, xs, "composite");
+    // In place batch evaluation:
+    std::vector<double> ys_in_place(xs);
+    cf.eval_many(ys_in_place.data(), ys_in_place.size(), ys_in_place.data());
+    for (std::size_t i = 0; i < xs.size(); i++) {
+      DT_THROW_IF(std::abs(ys_in_place[i] - cf(xs[i])) > 1e-14, std::logic_error,
+                  "In place batch evaluation of the composite function differs from point-wise evaluation!");
+    }
+
+    mygsl::tabulated_function tf("cspline");
+    for (int i = 0; i <= 60; i++) {
+      double x = -1.0 + 0.1 * i;
+      tf.add_point(x, std::sin(x), i == 60);
+    }
+    check_eval_many(tf, xs, "tabulated");
+
+    // Tabulate-and-cache adaptor:
+    double tolerance = 1e-7;
+    mygsl::uniform_tabulated_function utf(g, -1.0, 5.0, tolerance);
+    utf.tree_dump(std::clog, "Uniform tabulated function: ");
+    check_eval_many(utf, xs, "uniform tabulated");
+    double max_delta = 0.0;
+    srand48(314159);
+    for (int i = 0; i <= 100000; i++) {
+      double x = -1.0 + 6.0 * drand48();
+      double delta = std::abs(utf(x) - g(x));
+      if (delta > max_delta) max_delta = delta;
+    }
+    std::clog << "Max deviation from the tabulated function : " << max_delta << std::endl;
+    DT_THROW_IF(max_delta > tolerance, std::logic_error,
+                "Tabulated values are out of the requested tolerance!");
+
+    // The requested tolerance cannot be reached with too few nodes:
+    mygsl::uniform_tabulated_function utf_coarse;
+    utf_coarse.set_function(g);
+    utf_coarse.set_domain(-1.0, 5.0);
+    utf_coarse.set_tolerance(tolerance);
+    utf_coarse.set_max_number_of_nodes(100);
+    bool coarse_failed = false;
+    try {
+      utf_coarse.initialize_simple();
+    } catch (std::exception & x) {
+      std::clog << "As expected: " << x.what() << std::endl;
+      coarse_failed = true;
+    }
+    DT_THROW_IF(!coarse_failed, std::logic_error,
+                "Tabulation with too few nodes did not fail!");
+
+    // Concurrent evaluation:
+    check_concurrent_eval(tf, xs, "tabulated");
+    check_concurrent_eval(cf, xs, "composite");
+    check_concurrent_eval(utf, xs, "uniform tabulated");
+
+  }
+  catch (std::exception & x) {
+    std::cerr << "ERROR: " << x.what () << std::endl;
+    return (EXIT_FAILURE);
+  }
+  return (EXIT_SUCCESS);
+}
+
+void check_eval_many(const mygsl::i_unary_function & f_,
+                     const std::vector<double> & xs_,
+                     const std::string & label_)
+{
+  std::vector<double> ys;
+  f_.eval_many(xs_, ys);
+  double max_delta = 0.0;
+  for (std::size_t i = 0; i < xs_.size(); i++) {
+    double delta = std::abs(ys[i] - f_(xs_[i]));
+    if (delta > max_delta) max_delta = delta;
+  }
+  std::clog << "Batch evaluation of the '" << label_ << "' function: max deviation = "
+            << max_delta << std::endl;
+  DT_THROW_IF(max_delta > 1e-14, std::logic_error,
+              "Batch evaluation of the '" << label_ << "' function differs from point-wise evaluation!");
+  return;
+}
+
+void check_concurrent_eval(const mygsl::i_unary_function & f_,
+                           const std::vector<double> & xs_,
+                           const std::string & label_)
+{
+  std::vector<double> expected;
+  f_.eval_many(xs_, expected);
+  const unsigned int nthreads = 4;
+  std::vector<std::vector<double> > ys(nthreads);
+  std::vector<std::vector<double> > ys_scalar(nthreads);
+  std::vector<std::thread> threads;
+  for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+    threads.push_back(std::thread([&f_, &xs_, &ys, &ys_scalar, ithread] () {
+          for (int iloop = 0; iloop < 20; iloop++) {
+            f_.eval_many(xs_, ys[ithread]);
+            ys_scalar[ithread].resize(xs_.size());
+            for (std::size_t i = 0; i < xs_.size(); i++) {
+              ys_scalar[ithread][i] = f_(xs_[i]);
+            }
+          }
+        }));
+  }
+  for (std::thread & t : threads) {
+    t.join();
+  }
+  for (unsigned int ithread = 0; ithread < nthreads; ithread++) {
+    for (std::size_t i = 0; i < xs_.size(); i++) {
+      DT_THROW_IF(ys[ithread][i] != expected[i] || std::abs(ys_scalar[ithread][i] - expected[i]) > 1e-14,
+                  std::logic_error,
+                  "Concurrent evaluation of the '" << label_ << "' function differs at x=" << xs_[i] << "!");
+    }
+  }
+  std::clog << "Concurrent evaluation of the '" << label_ << "' function with "
+            << nthreads << " threads: identical values." << std::endl;
+  return;
+}
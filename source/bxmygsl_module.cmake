@@ -91,6 +91,7 @@ set(${module_name}_MODULE_HEADERS
   ${module_include_dir}/${module_name}/seed_manager.h
   ${module_include_dir}/${module_name}/tabulated_function.h
   ${module_include_dir}/${module_name}/tabulated_function.ipp
+  ${module_include_dir}/${module_name}/uniform_tabulated_function.h
   ${module_include_dir}/${module_name}/convolution_function.h
   ${module_include_dir}/${module_name}/zero_function.h
   ${module_include_dir}/${module_name}/identity_function.h
@@ -157,6 +158,7 @@ set(${module_name}_MODULE_SOURCES
   ${module_source_dir}/rng.cc
   ${module_source_dir}/seed_manager.cc
   ${module_source_dir}/tabulated_function.cc
+  ${module_source_dir}/uniform_tabulated_function.cc
   ${module_source_dir}/convolution_function.cc
   ${module_source_dir}/identity_function.cc
   ${module_source_dir}/zero_function.cc
@@ -211,6 +213,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_multidimensional_minimization.cxx
   ${module_test_dir}/test_multi_eval.cxx
   ${module_test_dir}/test_multimin.cxx
+  ${module_test_dir}/test_multimin_chunked.cxx
   ${module_test_dir}/test_multiparameter_system.cxx
   ${module_test_dir}/test_mygsl.cxx
   ${module_test_dir}/test_numerical_differentiation.cxx
@@ -227,6 +230,7 @@ set(${module_name}_MODULE_TESTS
   ${module_test_dir}/test_tabulated_function_3.cxx
   ${module_test_dir}/test_tabulated_function_4.cxx
   ${module_test_dir}/test_tabulated_function.cxx
+  ${module_test_dir}/test_uniform_tabulated_function.cxx
   ${module_test_dir}/test_von_neumann.cxx
   ${module_test_dir}/test_parameter_store.cxx
   ${module_test_dir}/test_rectangular_function.cxx